@@ -30,6 +30,7 @@
 #include <chrono>
 #include <ratio>
 #include <functional>
+#include <tuple>
 
 #include <boost/format.hpp>
 #include <boost/algorithm/string.hpp>
@@ -45,6 +46,7 @@
 #include "CDPL/Chem/SubstructureSearch.hpp"
 #include "CDPL/Chem/CommonConnectedSubstructureSearch.hpp"
 #include "CDPL/Chem/ComponentSet.hpp"
+#include "CDPL/Chem/DataFormat.hpp"
 #include "CDPL/ConfGen/ConformerGenerator.hpp"
 #include "CDPL/ConfGen/MoleculeFunctions.hpp"
 #include "CDPL/ConfGen/MolecularGraphFunctions.hpp"
@@ -52,7 +54,11 @@
 #include "CDPL/ConfGen/ForceFieldType.hpp"
 #include "CDPL/ConfGen/ConformerSamplingMode.hpp"
 #include "CDPL/ConfGen/NitrogenEnumerationMode.hpp"
+#include "CDPL/ConfGen/FragmentConformerCache.hpp"
 #include "CDPL/Util/FileFunctions.hpp"
+#include "CDPL/Util/FileRemover.hpp"
+#include "CDPL/Util/ControlParameterFunctions.hpp"
+#include "CDPL/Util/CompressionStreams.hpp"
 #include "CDPL/Base/DataIOManager.hpp"
 #include "CDPL/Base/Exceptions.hpp"
 #include "CDPL/Internal/StringUtilities.hpp"
@@ -66,6 +72,153 @@
 using namespace ConfGen;
 
 
+namespace
+{
+
+    const std::size_t MAX_NUM_QUEUED_MOLS_PER_THREAD     = 4;
+    const std::size_t MAX_NUM_PENDING_RECORDS_PER_THREAD = 32;
+
+    enum RecordCompression
+    {
+
+        NO_COMPRESSION,
+        GZIP_COMPRESSION,
+        BZIP2_COMPRESSION
+    };
+
+    /*
+     * Returns the uncompressed format of the output records if the records of the given output format can
+     * be serialized independently of each other, and nullptr otherwise.
+     */
+    const CDPL::Base::DataFormat* getRecordDataFormat(const CDPL::Base::DataFormat& fmt, RecordCompression& comp)
+    {
+        using namespace CDPL;
+        
+        typedef std::tuple<const Base::DataFormat*, const Base::DataFormat*, RecordCompression> FormatMapping;
+
+        static const FormatMapping FORMAT_MAPPINGS[] = {
+            FormatMapping(&Chem::DataFormat::SDF, &Chem::DataFormat::SDF, NO_COMPRESSION),
+            FormatMapping(&Chem::DataFormat::SDF_GZ, &Chem::DataFormat::SDF, GZIP_COMPRESSION),
+            FormatMapping(&Chem::DataFormat::SDF_BZ2, &Chem::DataFormat::SDF, BZIP2_COMPRESSION),
+            FormatMapping(&Chem::DataFormat::MOL2, &Chem::DataFormat::MOL2, NO_COMPRESSION),
+            FormatMapping(&Chem::DataFormat::MOL2_GZ, &Chem::DataFormat::MOL2, GZIP_COMPRESSION),
+            FormatMapping(&Chem::DataFormat::MOL2_BZ2, &Chem::DataFormat::MOL2, BZIP2_COMPRESSION),
+            FormatMapping(&Chem::DataFormat::SMILES, &Chem::DataFormat::SMILES, NO_COMPRESSION),
+            FormatMapping(&Chem::DataFormat::SMILES_GZ, &Chem::DataFormat::SMILES, GZIP_COMPRESSION),
+            FormatMapping(&Chem::DataFormat::SMILES_BZ2, &Chem::DataFormat::SMILES, BZIP2_COMPRESSION),
+            FormatMapping(&Chem::DataFormat::XYZ, &Chem::DataFormat::XYZ, NO_COMPRESSION),
+            FormatMapping(&Chem::DataFormat::XYZ_GZ, &Chem::DataFormat::XYZ, GZIP_COMPRESSION),
+            FormatMapping(&Chem::DataFormat::XYZ_BZ2, &Chem::DataFormat::XYZ, BZIP2_COMPRESSION),
+            FormatMapping(&Chem::DataFormat::CDF, &Chem::DataFormat::CDF, NO_COMPRESSION),
+            FormatMapping(&Chem::DataFormat::CDF_GZ, &Chem::DataFormat::CDF, GZIP_COMPRESSION),
+            FormatMapping(&Chem::DataFormat::CDF_BZ2, &Chem::DataFormat::CDF, BZIP2_COMPRESSION)
+        };
+
+        for (const auto& mapping : FORMAT_MAPPINGS) {
+            if (*std::get<0>(mapping) == fmt) {
+                comp = std::get<2>(mapping);
+                return std::get<1>(mapping);
+            }
+        }
+
+        return nullptr;
+    }
+}
+
+
+struct ConfGenImpl::InputRecord
+{
+
+    std::size_t               recIndex;
+    std::size_t               seqNumber;
+    CDPL::Chem::BasicMolecule molecule;
+};
+
+
+struct ConfGenImpl::OutputRecord
+{
+
+    void clear() {
+        outputData.clear();
+        failedOutputData.clear();
+        outputMolecule.reset();
+        failedOutputMolecule.reset();
+    }
+
+    std::size_t seqNumber;
+    std::string outputData;
+    std::string failedOutputData;
+    MoleculePtr outputMolecule;
+    MoleculePtr failedOutputMolecule;
+};
+
+
+class ConfGenImpl::RecordOutputFile
+{
+
+public:
+    RecordOutputFile(const std::string& file_name, const CDPL::Base::DataFormat& rec_fmt, RecordCompression comp):
+        recordFormat(rec_fmt), fileStream(file_name.c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary),
+        stream(&fileStream) {
+
+        if (!fileStream)
+            throw CDPL::Base::IOError("could not open output file '" + file_name + '\'');
+
+        switch (comp) {
+
+            case GZIP_COMPRESSION:
+                gzipStream.reset(new CDPL::Util::GZipOStream(fileStream));
+                stream = gzipStream.get();
+                break;
+
+            case BZIP2_COMPRESSION:
+                bzip2Stream.reset(new CDPL::Util::BZip2OStream(fileStream));
+                stream = bzip2Stream.get();
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    const CDPL::Base::DataFormat& getRecordFormat() const {
+        return recordFormat;
+    }
+
+    void write(const std::string& data) {
+        if (!stream->write(data.data(), data.size()))
+            throw CDPL::Base::IOError("could not write output record");
+    }
+
+    void close() {
+        if (gzipStream) {
+            gzipStream->close();
+
+            if (!gzipStream->good())
+                throw CDPL::Base::IOError("could not compress output data");
+
+        } else if (bzip2Stream) {
+            bzip2Stream->close();
+
+            if (!bzip2Stream->good())
+                throw CDPL::Base::IOError("could not compress output data");
+        }
+
+        fileStream.close();
+    }
+
+private:
+    typedef std::unique_ptr<CDPL::Util::GZipOStream>  GZipOStreamPtr;
+    typedef std::unique_ptr<CDPL::Util::BZip2OStream> BZip2OStreamPtr;
+
+    const CDPL::Base::DataFormat& recordFormat;
+    std::ofstream                 fileStream;
+    GZipOStreamPtr                gzipStream;
+    BZip2OStreamPtr               bzip2Stream;
+    std::ostream*                 stream;
+};
+
+
 class ConfGenImpl::InputScanProgressCallback
 {
 
@@ -101,6 +254,7 @@ public:
         
         confGen.setAbortCallback(std::bind(&ConformerGenerationWorker::abort, this));
         confGen.getSettings() = parent->settings;
+        confGen.setThreadPool(parent->threadPool);
 
         if (parent->getVerbosityLevel() >= DEBUG)  
             confGen.setLogMessageCallback(std::bind(&ConformerGenerationWorker::appendToLogRecord, this, _1));
@@ -119,6 +273,16 @@ public:
             confGen.addFragmentLibrary(parent->fragmentLib);
         }
 
+        if (parent->outputRecordFile) {
+            recordWriter.reset(new CDPL::Chem::MolecularGraphWriter(recordStream, parent->outputRecordFile->getRecordFormat()));
+            parent->setOutputWriterParameters(*recordWriter, false);
+        }
+
+        if (parent->failedOutputRecordFile) {
+            failedRecordWriter.reset(new CDPL::Chem::MolecularGraphWriter(recordStream, parent->failedOutputRecordFile->getRecordFormat()));
+            parent->setOutputWriterParameters(*failedRecordWriter, true);
+        }
+
         if (parent->fixedSubstruct) {
             if (parent->fixedSubstructUseMCSS){
                 maxCommonSubSearch.reset(new CDPL::Chem::CommonConnectedSubstructureSearch(*parent->fixedSubstruct));
@@ -166,7 +330,8 @@ private:
 
         timer.reset();
 
-        std::size_t rec_idx = parent->readNextMolecule(molecule);
+        std::size_t rec_idx = (parent->numThreads > 0 ? parent->fetchNextMolecule(molecule, outputRecord) :
+                               parent->readNextMolecule(molecule));
 
         if (!rec_idx)
             return false;
@@ -178,7 +343,7 @@ private:
                 logRecordStream << std::endl << "- Molecule " << 
                     parent->createMoleculeIdentifier(rec_idx, molecule) << ':' << std::endl;    
 
-            if (parent->failedOutputWriter)
+            if (!parent->failedFile.empty())
                 origMolecule = molecule;
 
             prepareForConformerGeneration(molecule, parent->canonicalize);
@@ -204,6 +369,9 @@ private:
                 switch (ret_code) {
 
                     case ReturnCode::ABORTED:
+                        if (outputRecord)
+                            parent->stopPipeline();
+
                         return false;
 
                     case ReturnCode::SUCCESS:
@@ -221,6 +389,9 @@ private:
             if (!log_rec.empty()) 
                 parent->printMessage(verbLevel, log_rec, false);
 
+            if (outputRecord)
+                parent->submitOutputRecord(outputRecord);
+
             numProcMols++;
 
             return true;
@@ -291,7 +462,7 @@ private:
         if (fixedSubstruct.getNumAtoms() > 0 && parent->fixedSubstructAlign)
             alignOnFixedSubstruct();
 
-        parent->writeMolecule(molecule, false);
+        outputMolecule(molecule, false);
 
         numGenConfs += num_confs;
     }
@@ -301,13 +472,13 @@ private:
 
         numFailedMols++;
 
-        if (parent->failedOutputWriter) {
+        if (!parent->failedFile.empty()) {
             calcImplicitHydrogenCounts(origMolecule, true);
             perceiveComponents(origMolecule, true);
             perceiveSSSR(origMolecule, true);
 
             try {
-                parent->writeMolecule(origMolecule, true);
+                outputMolecule(origMolecule, true);
 
             } catch (const std::exception& e) {
                 if (verbLevel >= ERROR)
@@ -395,6 +566,30 @@ private:
             alignConformations(molecule, *largest_comp);
     }
     
+    void outputMolecule(const CDPL::Chem::MolecularGraph& mol, bool failed) {
+        if (!outputRecord) {
+            parent->writeMolecule(mol, failed);
+            return;
+        }
+
+        const MoleculeWriterPtr& writer = (failed ? failedRecordWriter : recordWriter);
+
+        if (!writer) {
+            // output format does not allow a separate serialization of the records: let the writer stage
+            // output a copy of the molecule
+
+            (failed ? outputRecord->failedOutputMolecule : outputRecord->outputMolecule).reset(new CDPL::Chem::BasicMolecule(mol));
+            return;
+        }
+
+        recordStream.str(std::string());
+
+        if (!writer->write(mol))
+            throw CDPL::Base::IOError(failed ? "could not output molecule" : "could not write generated conformers");
+
+        (failed ? outputRecord->failedOutputData : outputRecord->outputData) = recordStream.str();
+    }
+
     void appendToLogRecord(const std::string& msg) {
         logRecordStream << msg;
     }
@@ -419,6 +614,10 @@ private:
     CDPL::Math::Vector3DArray         fixedSubstructCoords;
     CDPL::Chem::ComponentSet          fixedSubstructComps;
     std::stringstream                 logRecordStream;
+    std::stringstream                 recordStream;
+    MoleculeWriterPtr                 recordWriter;
+    MoleculeWriterPtr                 failedRecordWriter;
+    OutputRecordPtr                   outputRecord;
     VerbosityLevel                    verbLevel;
     CDPL::Internal::Timer             timer;
     std::size_t                       numProcMols;
@@ -428,11 +627,13 @@ private:
 
 
 ConfGenImpl::ConfGenImpl(): 
-    numThreads(0), settings(ConformerGeneratorSettings::MEDIUM_SET_DIVERSE), 
+    numThreads(0), numReaderThreads(0), settings(ConformerGeneratorSettings::MEDIUM_SET_DIVERSE), 
     confGenPreset("MEDIUM_SET_DIVERSE"), fragBuildPreset("FAST"), canonicalize(false), energySDEntry(false), 
-    energyComment(false), confIndexSuffix(false), torsionLib(), fragmentLib(), fixedSubstructUseMCSS(false),
+    energyComment(false), confIndexSuffix(false), useRecordIndexFiles(false), torsionLib(), fragmentLib(), fragCacheFile(),
+    fragCacheSize(CDPL::ConfGen::FragmentConformerCache::DEF_MEMORY_BUDGET / (1024 * 1024)), fixedSubstructUseMCSS(false),
     fixedSubstructAlign(false), fixedSubstructDelH(false), fixedSubstructMCSSMinNumAtoms(2), fixedSubstructMaxNumMatches(0),
-    haveFixedSubstruct3DCoords(false), inputFormat(), outputFormat(), outputWriter(), failedOutputFormat(), failedOutputWriter()
+    haveFixedSubstruct3DCoords(false), inputFormat(), outputFormat(), outputWriter(), failedOutputFormat(), failedOutputWriter(),
+    numQueuedMolecules(0), numWrittenRecords(0), inputDone(false), workersDone(false), pipelineStopped(false)
 {
     using namespace std::placeholders;
     
@@ -446,6 +647,15 @@ ConfGenImpl::ConfGenImpl():
               std::to_string(std::thread::hardware_concurrency()) + 
               " threads, must be >= 0, 0 disables multithreading).", 
               value<std::size_t>(&numThreads)->implicit_value(std::thread::hardware_concurrency()));
+    addOption("reader-threads", "Number of threads used for reading and parsing uncompressed SD-file and SMILES input files (threads are "
+              "used in addition to the conformer generation threads, default: sequential reading, implicit value: 2 threads, "
+              "must be >= 0, 0 disables multithreaded reading).",
+              value<std::size_t>(&numReaderThreads)->implicit_value(2));
+    addOption("mol-threads", "Maximum number of threads used for the conformer generation of a single molecule (stochastic "
+              "sampling trials, torsion fragments and fragment tree branches; in multithreaded mode, idle worker threads are used and the total number of conformer "
+              "generation threads is limited to the larger of this value and the number of worker threads; default: no multithreading, "
+              "implicit value: " + std::to_string(std::thread::hardware_concurrency()) + " threads, must be >= 0, 0 or 1 disables multithreading).", 
+              value<std::size_t>()->implicit_value(std::thread::hardware_concurrency())->notifier(std::bind(&ConfGenImpl::setNumMoleculeThreads, this, _1)));
     addOption("conf-gen-preset,C", "Conformer generation preset to use (SMALL_SET_DIVERSE, MEDIUM_SET_DIVERSE, " 
               "LARGE_SET_DIVERSE, SMALL_SET_DENSE, MEDIUM_SET_DENSE, LARGE_SET_DENSE, default: MEDIUM_SET_DIVERSE).", 
               value<std::string>()->notifier(std::bind(&ConfGenImpl::applyConfGenPreset, this, _1)));
@@ -545,6 +755,13 @@ ConfGenImpl::ConfGenImpl():
               value<std::string>()->notifier(std::bind(&ConfGenImpl::addFragmentLib, this, _1)));
     addOption("set-frag-lib,G", "Fragment library used as a replacement for the built-in library (only effective in systematic sampling mode).",
               value<std::string>()->notifier(std::bind(&ConfGenImpl::setFragmentLib, this, _1)));
+    addOption("frag-cache-file", "Fragment conformer cache file. If the file exists, its contents are used to prepopulate the cache of "
+              "generated fragment conformers. Files created with different fragment build settings are ignored. After successful "
+              "processing, the final cache contents are written to the file (only effective in systematic sampling mode).",
+              value<std::string>(&fragCacheFile));
+    addOption("frag-cache-size", "Maximum amount of memory in MB that may be occupied by the fragment conformer cache (default: " +
+              std::to_string(fragCacheSize) + ", 0 disables caching).",
+              value<std::size_t>(&fragCacheSize));
     addOption("canonicalize,z", "Canonicalize input molecules (default: false).", 
               value<bool>(&canonicalize)->implicit_value(true));
     addOption("energy-sd-entry,Y", "Output conformer energy in the structure data section of SD-files (default: false).", 
@@ -583,6 +800,9 @@ ConfGenImpl::ConfGenImpl():
     addOption("fixed-substr-ignore-h,^", "Ignore hydrogens that are present in the specified fixed substructure template "
               "molecule file (default: false).", 
               value<bool>(&fixedSubstructDelH)->implicit_value(true));
+    addOption("use-rec-index-files", "Store the record offsets of scanned input files in index files (<input file>.ridx) and reuse them "
+              "on subsequent runs to avoid rescanning unchanged input files (default: false).", 
+              value<bool>(&useRecordIndexFiles)->implicit_value(true));
     
     addOptionLongDescriptions();
 }
@@ -745,6 +965,11 @@ void ConfGenImpl::setMaxPoolSize(std::size_t max_confs)
     settings.setMaxPoolSize(max_confs);
 }
 
+void ConfGenImpl::setNumMoleculeThreads(std::size_t num_threads)
+{
+    settings.setNumThreads(num_threads);
+}
+
 void ConfGenImpl::setMaxRotBondCount(long max_count)
 {
     settings.setMaxRotatableBondCount(max_count);
@@ -1025,6 +1250,11 @@ int ConfGenImpl::process()
 
     loadFragmentLibrary();
 
+    if (termSignalCaught())
+        return EXIT_FAILURE;
+
+    loadFragmentConformerCache();
+
     if (termSignalCaught())
         return EXIT_FAILURE;
   
@@ -1054,6 +1284,8 @@ int ConfGenImpl::process()
     if (termSignalCaught())
         return EXIT_FAILURE;
 
+    saveFragmentConformerCache();
+
     return EXIT_SUCCESS;
 }
 
@@ -1061,6 +1293,11 @@ void ConfGenImpl::processSingleThreaded()
 {
     using namespace CDPL;
 
+    // the threads assisting in the conformer generation of a molecule are kept alive for all molecules
+
+    if (settings.getNumThreads() > 1)
+        threadPool.reset(new Util::ThreadPool(settings.getNumThreads() - 1));
+
     ConformerGenerationWorker worker(this);
 
     worker();
@@ -1082,22 +1319,38 @@ void ConfGenImpl::processMultiThreaded()
 
     typedef std::shared_ptr<ConformerGenerationWorker> ConformerGenerationWorkerPtr;
     typedef std::vector<ConformerGenerationWorkerPtr> ConformerGenerationWorkerList;
-    typedef std::vector<std::thread> ThreadGroup;
     
-    ThreadGroup thread_grp;
     ConformerGenerationWorkerList worker_list;
+    std::thread reader_thread;
+    std::thread writer_thread;
 
     try {
+        // the worker threads and the threads assisting in the conformer generation of a molecule (--mol-threads)
+        // are taken from a common pool so that the overall number of conformer generation threads does not exceed
+        // the larger of the two thread counts - molecules thus get processed multithreaded only if there are idle
+        // pool threads (e.g. at the end of the input)
+
+        threadPool.reset(new Util::ThreadPool(std::max(numThreads, settings.getNumThreads())));
+
+        writer_thread = std::thread(&ConfGenImpl::writeOutputRecords, this);
+
         for (std::size_t i = 0; i < numThreads; i++) {
             if (termSignalCaught())
                 break;
 
             ConformerGenerationWorkerPtr worker_ptr(new ConformerGenerationWorker(this));
 
-            thread_grp.emplace_back(std::bind(&ConformerGenerationWorker::operator(), worker_ptr));
             worker_list.push_back(worker_ptr);
+
+            if (!threadPool->tryExecute(std::bind(&ConformerGenerationWorker::operator(), worker_ptr)))
+                throw std::runtime_error("no idle pool thread");
         }
 
+        // input molecules get read not before all workers are running - otherwise, the threads assisting
+        // in the processing of the first molecules could occupy the pool threads reserved for the workers
+
+        reader_thread = std::thread(&ConfGenImpl::readInputMolecules, this);
+
     } catch (const std::exception& e) {
         setErrorMessage(std::string("error while creating worker-threads: ") + e.what());
 
@@ -1106,8 +1359,23 @@ void ConfGenImpl::processMultiThreaded()
     }
 
     try {
-        for (auto& thread : thread_grp)
-            thread.join();
+        if (threadPool)
+            threadPool->wait();
+
+        {
+            std::lock_guard<std::mutex> lock(pipelineMutex);
+
+            workersDone = true;
+        }
+
+        spaceCondition.notify_all();
+        outputCondition.notify_all();
+
+        if (reader_thread.joinable())
+            reader_thread.join();
+
+        if (writer_thread.joinable())
+            writer_thread.join();
 
     } catch (const std::exception& e) {
         setErrorMessage(std::string("error while waiting for worker-threads to finish: ") + e.what());
@@ -1115,7 +1383,18 @@ void ConfGenImpl::processMultiThreaded()
     } catch (...) {
         setErrorMessage("unspecified error while waiting for worker-threads to finish");
     }
-    
+
+    try {
+        if (outputRecordFile)
+            outputRecordFile->close();
+
+        if (failedOutputRecordFile)
+            failedOutputRecordFile->close();
+
+    } catch (const std::exception& e) {
+        setErrorMessage(std::string("error while closing output file: ") + e.what());
+    }
+
     printMessage(INFO, "");
 
     if (haveErrorMessage())
@@ -1142,10 +1421,14 @@ void ConfGenImpl::processMultiThreaded()
 void ConfGenImpl::setErrorMessage(const std::string& msg)
 {
     if (numThreads > 0) {
-        std::lock_guard<std::mutex> lock(mutex);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
 
-        if (errorMessage.empty())
-            errorMessage = msg;
+            if (errorMessage.empty())
+                errorMessage = msg;
+        }
+
+        stopPipeline();
         return;
     }
 
@@ -1184,6 +1467,16 @@ void ConfGenImpl::printStatistics(std::size_t num_proc_mols, std::size_t num_fai
         printMessage(INFO, " Processing Time:      " + CmdLineLib::formatTimeDuration(proc_time));
 
     printMessage(INFO, "");
+
+    CDPL::ConfGen::FragmentConformerCache::Statistics cache_stats = CDPL::ConfGen::FragmentConformerCache::getStatistics();
+
+    printMessage(VERBOSE, "Fragment Conformer Cache:");
+    printMessage(VERBOSE, " Entries:              " + std::to_string(cache_stats.numEntries) + 
+                 " (" + (boost::format("%.1f") % (cache_stats.memoryUsage / (1024.0 * 1024.0))).str() + " MB)");
+    printMessage(VERBOSE, " Hits:                 " + std::to_string(cache_stats.numHits));
+    printMessage(VERBOSE, " Misses:               " + std::to_string(cache_stats.numMisses));
+    printMessage(VERBOSE, " Evictions:            " + std::to_string(cache_stats.numEvictions));
+    printMessage(VERBOSE, "");
 }
 
 std::size_t ConfGenImpl::readNextMolecule(CDPL::Chem::Molecule& mol)
@@ -1194,17 +1487,6 @@ std::size_t ConfGenImpl::readNextMolecule(CDPL::Chem::Molecule& mol)
     if (haveErrorMessage())
         return 0;
 
-    if (numThreads > 0) {
-        std::lock_guard<std::mutex> lock(readMolMutex);
-
-        return doReadNextMolecule(mol);
-    }
-
-    return doReadNextMolecule(mol);
-}
-
-std::size_t ConfGenImpl::doReadNextMolecule(CDPL::Chem::Molecule& mol)
-{
     while (true) {
         try {
             printProgress("Generating Conformers...  ", double(inputReader.getRecordIndex()) / inputReader.getNumRecords());
@@ -1234,18 +1516,48 @@ std::size_t ConfGenImpl::doReadNextMolecule(CDPL::Chem::Molecule& mol)
     return 0;
 }
 
-void ConfGenImpl::writeMolecule(const CDPL::Chem::MolecularGraph& mol, bool failed)
+std::size_t ConfGenImpl::fetchNextMolecule(CDPL::Chem::Molecule& mol, OutputRecordPtr& out_rec)
 {
-    if (numThreads > 0) {
-        std::lock_guard<std::mutex> lock(writeMolMutex);
+    if (termSignalCaught())
+        return 0;
 
-        doWriteMolecule(mol, failed);
+    InputRecordPtr in_rec;
 
-    } else
-        doWriteMolecule(mol, failed);
+    {
+        std::unique_lock<std::mutex> lock(pipelineMutex);
+
+        inputCondition.wait(lock, [this]() { return (pipelineStopped || inputDone || !inputQueue.empty()); });
+
+        if (pipelineStopped || inputQueue.empty())
+            return 0;
+
+        in_rec = inputQueue.front();
+        inputQueue.pop_front();
+
+        if (freeOutputRecords.empty())
+            out_rec.reset(new OutputRecord());
+
+        else {
+            out_rec = freeOutputRecords.back();
+            freeOutputRecords.pop_back();
+        }
+
+        out_rec->seqNumber = in_rec->seqNumber;
+    }
+
+    spaceCondition.notify_one();
+
+    mol.copy(in_rec->molecule);
+
+    std::size_t rec_idx = in_rec->recIndex;
+    std::lock_guard<std::mutex> lock(pipelineMutex);
+
+    freeInputRecords.push_back(in_rec);
+
+    return rec_idx;
 }
 
-void ConfGenImpl::doWriteMolecule(const CDPL::Chem::MolecularGraph& mol, bool failed)
+void ConfGenImpl::writeMolecule(const CDPL::Chem::MolecularGraph& mol, bool failed)
 {
     if (failed) {
         if (!failedOutputWriter->write(mol))
@@ -1258,6 +1570,162 @@ void ConfGenImpl::doWriteMolecule(const CDPL::Chem::MolecularGraph& mol, bool fa
         throw CDPL::Base::IOError("could not write generated conformers");
 }
 
+void ConfGenImpl::submitOutputRecord(OutputRecordPtr& out_rec)
+{
+    std::lock_guard<std::mutex> lock(pipelineMutex);
+
+    pendingOutputRecords.emplace(out_rec->seqNumber, out_rec);
+
+    if (out_rec->seqNumber == numWrittenRecords)
+        outputCondition.notify_one();
+
+    out_rec.reset();
+}
+
+void ConfGenImpl::readInputMolecules()
+{
+    try {
+        const std::size_t max_num_queued_mols = numThreads * MAX_NUM_QUEUED_MOLS_PER_THREAD;
+        const std::size_t max_num_pending_recs = numThreads * MAX_NUM_PENDING_RECORDS_PER_THREAD;
+
+        while (true) {
+            InputRecordPtr in_rec;
+
+            {
+                std::unique_lock<std::mutex> lock(pipelineMutex);
+
+                // limit the number of prefetched molecules as well as the number of records that are waiting
+                // for the completion of a preceding record before they can be written
+
+                spaceCondition.wait(lock, [&]() {
+                    return (pipelineStopped || workersDone ||
+                            (inputQueue.size() < max_num_queued_mols && (numQueuedMolecules - numWrittenRecords) < max_num_pending_recs));
+                });
+
+                if (pipelineStopped || workersDone)
+                    break;
+
+                if (freeInputRecords.empty())
+                    in_rec.reset(new InputRecord());
+
+                else {
+                    in_rec = freeInputRecords.back();
+                    freeInputRecords.pop_back();
+                }
+            }
+
+            std::size_t rec_idx = readNextMolecule(in_rec->molecule);
+
+            if (!rec_idx)
+                break;
+
+            {
+                std::lock_guard<std::mutex> lock(pipelineMutex);
+
+                in_rec->recIndex = rec_idx;
+                in_rec->seqNumber = numQueuedMolecules++;
+
+                inputQueue.push_back(in_rec);
+            }
+
+            inputCondition.notify_one();
+        }
+
+    } catch (const std::exception& e) {
+        setErrorMessage(std::string("unexpected exception while reading input molecules: ") + e.what());
+
+    } catch (...) {
+        setErrorMessage("unexpected exception while reading input molecules");
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(pipelineMutex);
+
+        inputDone = true;
+    }
+
+    inputCondition.notify_all();
+}
+
+void ConfGenImpl::writeOutputRecords()
+{
+    try {
+        OutputRecordList out_recs;
+        std::unique_lock<std::mutex> lock(pipelineMutex);
+
+        while (true) {
+            outputCondition.wait(lock, [this]() {
+                return (pipelineStopped || workersDone ||
+                        (!pendingOutputRecords.empty() && pendingOutputRecords.begin()->first == numWrittenRecords));
+            });
+
+            if (pipelineStopped)
+                break;
+
+            // collect all records that directly follow the last written one
+
+            for (auto it = pendingOutputRecords.begin(); it != pendingOutputRecords.end() && it->first == numWrittenRecords + out_recs.size(); ) {
+                out_recs.push_back(it->second);
+                it = pendingOutputRecords.erase(it);
+            }
+
+            if (out_recs.empty()) // all workers finished
+                break;
+
+            lock.unlock();
+
+            for (const auto& out_rec : out_recs)
+                writeOutputRecord(*out_rec);
+
+            lock.lock();
+
+            numWrittenRecords += out_recs.size();
+
+            for (auto& out_rec : out_recs) {
+                out_rec->clear();
+                freeOutputRecords.push_back(out_rec);
+            }
+
+            out_recs.clear();
+            spaceCondition.notify_one();
+        }
+
+    } catch (const std::exception& e) {
+        setErrorMessage(std::string("error while writing output: ") + e.what());
+
+    } catch (...) {
+        setErrorMessage("unspecified error while writing output");
+    }
+}
+
+void ConfGenImpl::writeOutputRecord(const OutputRecord& out_rec)
+{
+    if (!out_rec.outputData.empty())
+        outputRecordFile->write(out_rec.outputData);
+
+    else if (out_rec.outputMolecule)
+        writeMolecule(*out_rec.outputMolecule, false);
+
+    if (!out_rec.failedOutputData.empty())
+        failedOutputRecordFile->write(out_rec.failedOutputData);
+
+    else if (out_rec.failedOutputMolecule)
+        writeMolecule(*out_rec.failedOutputMolecule, true);
+}
+
+void ConfGenImpl::stopPipeline()
+{
+    {
+        std::lock_guard<std::mutex> lock(pipelineMutex);
+
+        pipelineStopped = true;
+    }
+
+    inputCondition.notify_all();
+    spaceCondition.notify_all();
+    outputCondition.notify_all();
+}
+
 void ConfGenImpl::checkInputFiles() const
 {
     using namespace CDPL;
@@ -1424,10 +1892,17 @@ void ConfGenImpl::printOptionSummary()
     if (numThreads > 0)
         printMessage(VERBOSE, " Number of Threads:                   " + std::to_string(numThreads));
 
+    if (numReaderThreads > 0)
+        printMessage(VERBOSE, " Number of Input Reader Threads:      " + std::to_string(numReaderThreads));
+
+    printMessage(VERBOSE, " Max. Num. Threads per Molecule:      " + (settings.getNumThreads() > 1 ? std::to_string(settings.getNumThreads()) : std::string("1")));
+
     printMessage(VERBOSE, " Torsion Library:                     " + (torsionLibName.empty() ? std::string("Built-in") :
                                                                       replaceBuiltinTorLib   ? torsionLibName : torsionLibName + " + Built-in"));
     printMessage(VERBOSE, " Fragment Library:                    " + (fragmentLibName.empty() ? std::string("Built-in") :
                                                                       replaceBuiltinFragLib   ? fragmentLibName : fragmentLibName + " + Built-in"));
+    printMessage(VERBOSE, " Fragment Conformer Cache File:       " + (fragCacheFile.empty() ? std::string("None") : fragCacheFile));
+    printMessage(VERBOSE, " Fragment Conformer Cache Size:       " + (fragCacheSize == 0 ? std::string("Disabled") : std::to_string(fragCacheSize) + " MB"));
     printMessage(VERBOSE, " Fixed Substructure (FSS) Mol. File:  " + (fixedSubstructFile.empty() ? std::string("None") : fixedSubstructFile));
     printMessage(VERBOSE, " FSS SMARTS pattern:                  " + (fixedSubstructPtn.empty() ? std::string("None") : fixedSubstructPtn));
     printMessage(VERBOSE, " Ignore FSS Hydrogens:                " + std::string(fixedSubstructDelH ? "Yes" : "No"));
@@ -1443,6 +1918,7 @@ void ConfGenImpl::printOptionSummary()
     printMessage(VERBOSE, " Output Conf. Energy SD-Entry:        " + std::string(energySDEntry ? "Yes" : "No"));
     printMessage(VERBOSE, " Output Conf. Energy Comment:         " + std::string(energyComment ? "Yes" : "No"));
     printMessage(VERBOSE, " Append Conf. Index to Mol. Title:    " + std::string(confIndexSuffix ? "Yes" : "No"));
+    printMessage(VERBOSE, " Use Record Index Files:              " + std::string(useRecordIndexFiles ? "Yes" : "No"));
     printMessage(VERBOSE, "");
 }
 
@@ -1483,26 +1959,123 @@ void ConfGenImpl::loadFragmentLibrary()
     if (fragmentLibName.empty())
         return;
 
-    std::ifstream is(fragmentLibName);
+    printMessage(INFO, "Loading Fragment Library '" + fragmentLibName + "'...");
+
+    // entries get decoded on demand from the memory-mapped file
+
+    fragmentLib.reset(new FragmentLibrary());
+    fragmentLib->mapFile(fragmentLibName);
+
+    printMessage(INFO, " - Loaded " + std::to_string(fragmentLib->getNumEntries()) + " fragments");
+    printMessage(INFO, "");
+}
+
+void ConfGenImpl::loadFragmentConformerCache()
+{
+    using namespace CDPL;
+    using namespace CDPL::ConfGen;
+
+    FragmentConformerCache::setMemoryBudget(fragCacheSize * 1024 * 1024);
+
+    if (fragCacheFile.empty() || fragCacheSize == 0 || !Util::fileExists(fragCacheFile))
+        return;
+
+    std::ifstream is(fragCacheFile, std::ios_base::in | std::ios_base::binary);
 
     if (!is) 
-        throw Base::IOError("opening fragment library '" + fragmentLibName + "' failed");
+        throw Base::IOError("opening fragment conformer cache file '" + fragCacheFile + "' failed");
 
-    printMessage(INFO, "Loading Fragment Library '" + fragmentLibName + "'...");
+    printMessage(INFO, "Loading Fragment Conformer Cache '" + fragCacheFile + "'...");
 
-    fragmentLib.reset(new FragmentLibrary());
-    fragmentLib->load(is);
+    // cached fragment conformers are only valid for the fragment build settings they were generated with
 
-    if (termSignalCaught())
+    std::string header;
+
+    if (!std::getline(is, header) || header != getFragmentConformerCacheHeader()) {
+        printMessage(INFO, " - Ignored cache file created with different fragment build settings or by an incompatible version");
+        printMessage(INFO, "");
         return;
+    }
 
-    if (!is)
-        throw Base::IOError("loading fragment library '" + fragmentLibName + "' failed");
+    std::size_t num_entries = FragmentConformerCache::load(is);
 
-    printMessage(INFO, " - Loaded " + std::to_string(fragmentLib->getNumEntries()) + " fragments");
+    printMessage(INFO, " - Loaded " + std::to_string(num_entries) + " fragments");
     printMessage(INFO, "");
 }
 
+void ConfGenImpl::saveFragmentConformerCache()
+{
+    using namespace CDPL;
+    using namespace CDPL::ConfGen;
+
+    if (fragCacheFile.empty() || fragCacheSize == 0)
+        return;
+
+    // the data get written to a temporary file first that replaces the cache file only after having been written
+    // completely so that an interrupted or failed save does not destroy the previous cache contents
+
+    std::string::size_type sep_pos = fragCacheFile.find_last_of("/\\");
+    Util::FileRemover tmp_file_rem(Util::genCheckedTempFilePath(sep_pos == std::string::npos ? std::string(".") : fragCacheFile.substr(0, sep_pos + 1),
+                                                                "%%%%-%%%%-%%%%-%%%%.tmp"));
+    std::ofstream os(tmp_file_rem.getPath(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+
+    if (!os) 
+        throw Base::IOError("opening temporary file for fragment conformer cache file '" + fragCacheFile + "' failed");
+
+    printMessage(INFO, "Saving Fragment Conformer Cache '" + fragCacheFile + "'...");
+
+    os << getFragmentConformerCacheHeader() << '\n';
+
+    std::size_t num_entries = FragmentConformerCache::save(os);
+
+    os.close();
+
+    if (!os || !Util::renameFile(tmp_file_rem.getPath(), fragCacheFile))
+        throw Base::IOError("saving fragment conformer cache file '" + fragCacheFile + "' failed");
+
+    tmp_file_rem.release();
+
+    printMessage(INFO, " - Saved " + std::to_string(num_entries) + " fragments");
+    printMessage(INFO, "");
+}
+
+std::string ConfGenImpl::getFragmentConformerCacheHeader() const
+{
+    using namespace CDPL;
+    using namespace CDPL::ConfGen;
+
+    const FragmentConformerGeneratorSettings& frag_settings = settings.getFragmentBuildSettings();
+    std::ostringstream oss;
+
+    oss.imbue(std::locale::classic());
+    oss.precision(17);
+
+    oss << "CDPKit Fragment Conformer Cache 1; Build Preset: " << fragBuildPreset
+        << "; Force Field: " << getForceFieldTypeString(frag_settings.getForceFieldType())
+        << ' ' << frag_settings.strictForceFieldParameterization()
+        << ' ' << frag_settings.getDielectricConstant()
+        << ' ' << frag_settings.getDistanceExponent()
+        << "; Refinement: " << frag_settings.getMaxNumRefinementIterations()
+        << ' ' << frag_settings.getRefinementStopGradient()
+        << "; Geometry: " << frag_settings.preserveInputBondingGeometries()
+        << ' ' << frag_settings.getMacrocycleRotorBondCountThreshold()
+        << ' ' << frag_settings.getSmallRingSystemSamplingFactor();
+
+    const FragmentConformerGeneratorSettings::FragmentSettings* frag_type_settings[] = {
+        &frag_settings.getChainSettings(), &frag_settings.getMacrocycleSettings(), &frag_settings.getSmallRingSystemSettings()
+    };
+
+    for (const auto ft_settings : frag_type_settings)
+        oss << "; Sampling: " << ft_settings->getMaxNumSampledConformers()
+            << ' ' << ft_settings->getMinNumSampledConformers()
+            << ' ' << ft_settings->getTimeout()
+            << ' ' << ft_settings->getEnergyWindow()
+            << ' ' << ft_settings->getMaxNumOutputConformers()
+            << ' ' << ft_settings->getMinRMSD();
+
+    return oss.str();
+}
+
 void ConfGenImpl::initInputReader()
 {
     using namespace CDPL;
@@ -1534,6 +2107,12 @@ void ConfGenImpl::initInputReader()
         }
         
         setMultiConfImportParameter(*reader_ptr, false);
+        Util::setUseRecordIndexFilesParameter(*reader_ptr, useRecordIndexFiles);
+        Util::setNumReaderThreadsParameter(*reader_ptr, numReaderThreads);
+
+        if (numReaderThreads > 0 && reader_ptr->getDataFormat() != Chem::DataFormat::SDF && reader_ptr->getDataFormat() != Chem::DataFormat::SMILES)
+            printMessage(INFO, "Warning: option --reader-threads has no effect for input file '" + file_path + 
+                         "' (only uncompressed SD-files and SMILES files can be read in parallel)");
 
         std::size_t cb_id = reader_ptr->registerIOCallback(InputScanProgressCallback(this, i * 1.0 / num_in_files, 1.0 / num_in_files));
 
@@ -1559,34 +2138,74 @@ void ConfGenImpl::initOutputWriters()
 {
     using namespace CDPL;
 
+    if (numThreads == 0 || !initRecordOutputFile(outputFile, outputFormat, outputRecordFile)) {
+        try {
+            outputWriter.reset(outputFormat.empty() ? new Chem::MolecularGraphWriter(outputFile) :
+                               new Chem::MolecularGraphWriter(outputFile, outputFormat));
+
+        } catch (const Base::IOError& e) {
+            throw Base::IOError("no output handler found for file '" + outputFile + '\'');
+        }
+
+        setOutputWriterParameters(*outputWriter, false);
+    }
+
+    if (failedFile.empty())
+        return;
+
+    if (numThreads > 0 && initRecordOutputFile(failedFile, failedOutputFormat, failedOutputRecordFile))
+        return;
+
     try {
-        outputWriter.reset(outputFormat.empty() ? new Chem::MolecularGraphWriter(outputFile) :
-                           new Chem::MolecularGraphWriter(outputFile, outputFormat));
+        failedOutputWriter.reset(failedOutputFormat.empty() ? new Chem::MolecularGraphWriter(failedFile) :
+                                 new Chem::MolecularGraphWriter(failedFile, failedOutputFormat));
 
     } catch (const Base::IOError& e) {
         throw Base::IOError("no output handler found for file '" + outputFile + '\'');
     }
 
-    setMultiConfExportParameter(*outputWriter, true);
-    setMDLOutputConfEnergyAsSDEntryParameter(*outputWriter, energySDEntry);
-    setOutputConfEnergyAsCommentParameter(*outputWriter, energyComment);
-    setSMILESRecordFormatParameter(*outputWriter, "SN");
+    setOutputWriterParameters(*failedOutputWriter, true);
+}
 
-    if (confIndexSuffix)
-        setConfIndexNameSuffixPatternParameter(*outputWriter,"_%I%");
+bool ConfGenImpl::initRecordOutputFile(const std::string& file_name, const std::string& fmt, RecordOutputFilePtr& file_ptr)
+{
+    using namespace CDPL;
 
-    if (!failedFile.empty()) {
-        try {
-            failedOutputWriter.reset(failedOutputFormat.empty() ? new Chem::MolecularGraphWriter(failedFile) :
-                                     new Chem::MolecularGraphWriter(failedFile, failedOutputFormat));
+    auto handler = (fmt.empty() ? Base::DataIOManager<Chem::MolecularGraph>::getOutputHandlerByFileName(file_name) :
+                    Base::DataIOManager<Chem::MolecularGraph>::getOutputHandlerByFileExtension(fmt));
 
-        } catch (const Base::IOError& e) {
-            throw Base::IOError("no output handler found for file '" + outputFile + '\'');
-        }
+    if (!handler)
+        return false;
+
+    RecordCompression comp = NO_COMPRESSION;
+    const Base::DataFormat* rec_fmt = getRecordDataFormat(handler->getDataFormat(), comp);
+
+    if (!rec_fmt)
+        return false;
+
+    file_ptr.reset(new RecordOutputFile(file_name, *rec_fmt, comp));
+
+    return true;
+}
 
-        setMultiConfExportParameter(*failedOutputWriter, false);
-        setSMILESRecordFormatParameter(*failedOutputWriter, "SN");
+void ConfGenImpl::setOutputWriterParameters(CDPL::Base::ControlParameterContainer& writer, bool failed) const
+{
+    using namespace CDPL;
+    using namespace Chem;
+
+    if (failed) {
+        setMultiConfExportParameter(writer, false);
+        setSMILESRecordFormatParameter(writer, "SN");
+        return;
     }
+
+    setMultiConfExportParameter(writer, true);
+    setMDLOutputConfEnergyAsSDEntryParameter(writer, energySDEntry);
+    setOutputConfEnergyAsCommentParameter(writer, energyComment);
+    setSMILESRecordFormatParameter(writer, "SN");
+
+    if (confIndexSuffix)
+        setConfIndexNameSuffixPatternParameter(writer, "_%I%");
 }
 
 std::string ConfGenImpl::getSamplingModeString() const
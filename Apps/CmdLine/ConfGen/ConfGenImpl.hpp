@@ -27,8 +27,12 @@
 
 #include <cstddef>
 #include <vector>
+#include <deque>
+#include <map>
 #include <string>
+#include <memory>
 #include <mutex>
+#include <condition_variable>
 
 #include "CDPL/Util/CompoundDataReader.hpp"
 #include "CDPL/Chem/MolecularGraphWriter.hpp"
@@ -36,6 +40,7 @@
 #include "CDPL/ConfGen/ConformerGeneratorSettings.hpp"
 #include "CDPL/ConfGen/TorsionLibrary.hpp"
 #include "CDPL/ConfGen/FragmentLibrary.hpp"
+#include "CDPL/Util/ThreadPool.hpp"
 #include "CDPL/Internal/Timer.hpp"
 
 #include "CmdLine/Lib/CmdLineBase.hpp"
@@ -44,6 +49,12 @@
 namespace CDPL
 {
 
+    namespace Base
+    {
+
+        class ControlParameterContainer;
+    } // namespace Base
+
     namespace Chem
     {
 
@@ -95,6 +106,7 @@ namespace ConfGen
         void setGenerateFromScratch(bool from_scratch);
         void setMaxNumConfs(const StringList& args);
         void setMaxPoolSize(std::size_t max_confs);
+        void setNumMoleculeThreads(std::size_t num_threads);
         void setMaxRotBondCount(long max_count);
         void setInputFormat(const std::string& file_ext);
         void setOutputFormat(const std::string& file_ext);
@@ -109,11 +121,28 @@ namespace ConfGen
         void processSingleThreaded();
         void processMultiThreaded();
 
+        struct InputRecord;
+        struct OutputRecord;
+        class RecordOutputFile;
+
+        typedef std::shared_ptr<InputRecord>            InputRecordPtr;
+        typedef std::shared_ptr<OutputRecord>           OutputRecordPtr;
+        typedef std::unique_ptr<RecordOutputFile>       RecordOutputFilePtr;
+        typedef std::deque<InputRecordPtr>              InputRecordQueue;
+        typedef std::vector<InputRecordPtr>             InputRecordList;
+        typedef std::map<std::size_t, OutputRecordPtr>  OutputRecordMap;
+        typedef std::vector<OutputRecordPtr>            OutputRecordList;
+
         std::size_t readNextMolecule(CDPL::Chem::Molecule& mol);
-        std::size_t doReadNextMolecule(CDPL::Chem::Molecule& mol);
+        std::size_t fetchNextMolecule(CDPL::Chem::Molecule& mol, OutputRecordPtr& out_rec);
 
         void writeMolecule(const CDPL::Chem::MolecularGraph& mol, bool failed);
-        void doWriteMolecule(const CDPL::Chem::MolecularGraph& mol, bool failed);
+        void submitOutputRecord(OutputRecordPtr& out_rec);
+
+        void readInputMolecules();
+        void writeOutputRecords();
+        void writeOutputRecord(const OutputRecord& out_rec);
+        void stopPipeline();
 
         void setErrorMessage(const std::string& msg);
         bool haveErrorMessage();
@@ -127,8 +156,13 @@ namespace ConfGen
         void printOptionSummary();
         void loadTorsionLibrary();
         void loadFragmentLibrary();
+        void loadFragmentConformerCache();
+        void saveFragmentConformerCache();
+        std::string getFragmentConformerCacheHeader() const;
         void initInputReader();
         void initOutputWriters();
+        bool initRecordOutputFile(const std::string& file_name, const std::string& fmt, RecordOutputFilePtr& file_ptr);
+        void setOutputWriterParameters(CDPL::Base::ControlParameterContainer& writer, bool failed) const;
 
         std::string getSamplingModeString() const;
         std::string getNitrogenEnumModeString() const;
@@ -152,11 +186,14 @@ namespace ConfGen
         typedef CDPL::ConfGen::FragmentConformerGeneratorSettings    FragmentConformerGeneratorSettings;
         typedef CDPL::ConfGen::TorsionLibrary::SharedPointer         TorsionLibraryPtr;
         typedef CDPL::ConfGen::FragmentLibrary::SharedPointer        FragmentLibraryPtr;
+        typedef CDPL::Util::ThreadPool::SharedPointer                ThreadPoolPtr;
 
         StringList                 inputFiles;
         std::string                outputFile;
         std::string                failedFile;
         std::size_t                numThreads;
+        std::size_t                numReaderThreads;
+        ThreadPoolPtr              threadPool;
         ConformerGeneratorSettings settings;
         StringList                 maxNumConfsOptArgs;
         StringList                 minRMSDOptArgs;
@@ -167,12 +204,15 @@ namespace ConfGen
         bool                       energySDEntry;
         bool                       energyComment;
         bool                       confIndexSuffix;
+        bool                       useRecordIndexFiles;
         std::string                torsionLibName;
         TorsionLibraryPtr          torsionLib;
         bool                       replaceBuiltinTorLib;
         std::string                fragmentLibName;
         FragmentLibraryPtr         fragmentLib;
         bool                       replaceBuiltinFragLib;
+        std::string                fragCacheFile;
+        std::size_t                fragCacheSize;
         std::string                fixedSubstructFile;
         std::string                fixedSubstructPtn;
         bool                       fixedSubstructUseMCSS;
@@ -188,9 +228,22 @@ namespace ConfGen
         MoleculeWriterPtr          outputWriter;
         std::string                failedOutputFormat;
         MoleculeWriterPtr          failedOutputWriter;
+        RecordOutputFilePtr        outputRecordFile;
+        RecordOutputFilePtr        failedOutputRecordFile;
         std::mutex                 mutex;
-        std::mutex                 readMolMutex;
-        std::mutex                 writeMolMutex;
+        std::mutex                 pipelineMutex;
+        std::condition_variable    inputCondition;
+        std::condition_variable    spaceCondition;
+        std::condition_variable    outputCondition;
+        InputRecordQueue           inputQueue;
+        InputRecordList            freeInputRecords;
+        OutputRecordMap            pendingOutputRecords;
+        OutputRecordList           freeOutputRecords;
+        std::size_t                numQueuedMolecules;
+        std::size_t                numWrittenRecords;
+        bool                       inputDone;
+        bool                       workersDone;
+        bool                       pipelineStopped;
         std::string                errorMessage;
         Timer                      timer;
     };
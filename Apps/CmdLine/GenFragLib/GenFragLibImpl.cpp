@@ -680,7 +680,7 @@ int GenFragLibImpl::saveFragmentLibrary()
     using namespace CDPL;
     using namespace std::placeholders;
     
-    std::ofstream os(outputFile, std::ios_base::out | std::ios_base::trunc);
+    std::ofstream os(outputFile, std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
 
     if (!os)
         throw Base::IOError("opening output fragment library '" + outputFile + "' failed");
@@ -703,7 +703,7 @@ int GenFragLibImpl::saveFragmentLibrary()
             fragmentLibPtr->removeEntry(it->first);
     }
 
-    fragmentLibPtr->save(os);
+    fragmentLibPtr->saveIndexed(os);
 
     if (!os)
         throw Base::IOError("saving fragments to library '" + outputFile + "' failed");
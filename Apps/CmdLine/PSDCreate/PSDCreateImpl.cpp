@@ -42,10 +42,9 @@
 #include "CDPL/Chem/ControlParameterFunctions.hpp"
 #include "CDPL/Chem/MoleculeReader.hpp"
 #include "CDPL/Pharm/PSDScreeningDBCreator.hpp"
-#include "CDPL/Pharm/PSDScreeningDBAccessor.hpp"
 #include "CDPL/MolProp/MolecularGraphFunctions.hpp"
 #include "CDPL/Util/FileFunctions.hpp"
-#include "CDPL/Util/FileRemover.hpp"
+#include "CDPL/Util/ControlParameterFunctions.hpp"
 #include "CDPL/Base/DataIOManager.hpp"
 #include "CDPL/Base/Exceptions.hpp"
 #include "CDPL/Internal/StringUtilities.hpp"
@@ -80,25 +79,6 @@ private:
     double         scale;
 };
 
-struct PSDCreateImpl::MergeDBsProgressCallback
-{
-
-    MergeDBsProgressCallback(PSDCreateImpl* parent, double offset, double scale): 
-        parent(parent), offset(offset), scale(scale) {}
-
-    bool operator()(double progress) const {
-        if (PSDCreateImpl::termSignalCaught())
-            return false;
-
-        parent->printProgress("Merging Temporary Databases...  ", offset + scale * progress);
-        return true;
-    }
-
-    PSDCreateImpl* parent;
-    double         offset;
-    double         scale;
-};
-
 struct PSDCreateImpl::DBCreationWorker
 {
 
@@ -157,7 +137,7 @@ private:
 PSDCreateImpl::PSDCreateImpl(): 
     dropDuplicates(false), startMolIndex(0), endMolIndex(0), numThreads(0),
     creationMode(CDPL::Pharm::ScreeningDBCreator::CREATE), 
-    inputFormat(), addSourceFileProp(false)
+    inputFormat(), addSourceFileProp(false), useRecordIndexFiles(false), create2PtPharmIndex(false)
 {
     using namespace std::placeholders;
 
@@ -184,6 +164,12 @@ PSDCreateImpl::PSDCreateImpl():
               value<std::string>()->notifier(std::bind(&PSDCreateImpl::setTmpFileDirectory, this, _1)));
     addOption("add-src-file-prop,S", "Add a source-file property to output molecules (default: false).", 
               value<bool>(&addSourceFileProp)->implicit_value(true));
+    addOption("use-rec-index-files", "Store the record offsets of scanned input files in index files (<input file>.ridx) and reuse them "
+              "on subsequent runs to avoid rescanning unchanged input files (default: false).", 
+              value<bool>(&useRecordIndexFiles)->implicit_value(true));
+    addOption("create-2pt-pharm-index", "Store an index of the binned feature pair distances of the generated pharmacophores "
+              "that allows PSDScreen to skip non-matching database pharmacophores without loading them (default: false).", 
+              value<bool>(&create2PtPharmIndex)->implicit_value(true));
 
     addOptionLongDescriptions();
 }
@@ -307,8 +293,7 @@ void PSDCreateImpl::processSingleThreaded()
 {
     using namespace CDPL;
 
-    Pharm::ScreeningDBCreator::SharedPointer db_creator(
-        new Pharm::PSDScreeningDBCreator(outputDatabase, creationMode, !dropDuplicates));
+    Pharm::ScreeningDBCreator::SharedPointer db_creator = createOutputDBCreator();
 
     DBCreationWorker(this, db_creator)();
 
@@ -330,32 +315,17 @@ void PSDCreateImpl::processMultiThreaded()
 {
     using namespace CDPL;
 
-    typedef Pharm::ScreeningDBCreator::SharedPointer DBCreatorPtr;
-    typedef std::vector<Util::FileRemover> DBFileList;
-    typedef std::vector<DBCreatorPtr> DBCreatorList;
     typedef std::vector<std::thread> ThreadGroup;
     
     ThreadGroup thread_grp;
-    DBCreatorList tmp_db_creators;
-    DBFileList tmp_db_files(numThreads - 1, Util::FileRemover(""));
-
-    DBCreatorPtr main_db_creator(new Pharm::PSDScreeningDBCreator(outputDatabase, creationMode, !dropDuplicates));
+    Pharm::PSDScreeningDBCreator::SharedPointer db_creator = createOutputDBCreator();
     
     try {
-        thread_grp.emplace_back(DBCreationWorker(this, main_db_creator));
-
-        for (std::size_t i = 0; i < numThreads - 1; i++) {
+        for (std::size_t i = 0; i < numThreads; i++) {
             if (termSignalCaught())
                 break;
 
-            std::string tmp_db_name = Util::genCheckedTempFilePath();
-
-            tmp_db_files[i].reset(tmp_db_name);
-
-            DBCreatorPtr tmp_db_creator(new Pharm::PSDScreeningDBCreator(tmp_db_name, creationMode, !dropDuplicates));
-
-            thread_grp.emplace_back(DBCreationWorker(this, tmp_db_creator));
-            tmp_db_creators.push_back(tmp_db_creator);
+            thread_grp.emplace_back(DBCreationWorker(this, db_creator));
         }
 
     } catch (const std::exception& e) {
@@ -375,7 +345,14 @@ void PSDCreateImpl::processMultiThreaded()
     } catch (...) {
         setErrorMessage("unspecified error while waiting for worker-threads to finish");
     }
-    
+
+    try {
+        db_creator->flush();
+
+    } catch (const std::exception& e) {
+        setErrorMessage(std::string("error while writing database: ") + e.what());
+    }
+
     printMessage(INFO, "");
 
     if (haveErrorMessage())
@@ -383,43 +360,24 @@ void PSDCreateImpl::processMultiThreaded()
 
     if (termSignalCaught())
         return;
-    
-    std::size_t num_proc = main_db_creator->getNumProcessed();
-    std::size_t num_rej = 0;
 
-    if (progressEnabled()) {
-        initProgress();
-        printMessage(INFO, "Merging Temporary Databases...", true, true);
-    } else
-        printMessage(INFO, "Merging Temporary Databases...");
-
-    for (std::size_t i = 0; i < numThreads - 1; i++) {
-        if (termSignalCaught())
-            return;
-
-        num_proc += tmp_db_creators[i]->getNumProcessed();
-        num_rej  += tmp_db_creators[i]->getNumRejected();
-
-        tmp_db_creators[i]->close();
-
-        Pharm::PSDScreeningDBAccessor db_acc(tmp_db_files[i].getPath());
-
-        main_db_creator->merge(db_acc, MergeDBsProgressCallback(this, i * 1.0 / (numThreads - 1), 1.0 / (numThreads - 1)));
-    }
-
-    printMessage(INFO, "");
+    printStatistics(db_creator->getNumProcessed(), db_creator->getNumRejected(),
+                    db_creator->getNumDeleted(), db_creator->getNumInserted());
 
-    if (termSignalCaught())
-        return;
+    db_creator->close();
+}
 
-    std::size_t num_del = main_db_creator->getNumDeleted();
-    std::size_t num_ins = main_db_creator->getNumInserted();
+CDPL::Pharm::PSDScreeningDBCreator::SharedPointer PSDCreateImpl::createOutputDBCreator() const
+{
+    using namespace CDPL;
 
-    num_rej += main_db_creator->getNumRejected();
+    Pharm::PSDScreeningDBCreator::SharedPointer db_creator(new Pharm::PSDScreeningDBCreator());
 
-    printStatistics(num_proc, num_rej, num_del, num_ins);
+    db_creator->createTwoPointPharmacophoreIndex(create2PtPharmIndex);
+    db_creator->enableMultiThreading(numThreads > 0);
+    db_creator->open(outputDatabase, creationMode, !dropDuplicates);
 
-    main_db_creator->close();
+    return db_creator;
 }
 
 void PSDCreateImpl::setErrorMessage(const std::string& msg)
@@ -480,14 +438,7 @@ std::size_t PSDCreateImpl::doReadNextMolecule(CDPL::Chem::Molecule& mol)
 {
     while (true) {
         try {
-            std::string msg;
-
-            if (numThreads == 0)
-                msg = "Creating Database...            ";
-            else
-                msg = "Creating Temporary Databases... ";
-            
-            printProgress(msg, double(inputReader.getRecordIndex() - startMolIndex) / (endMolIndex - startMolIndex));
+            printProgress("Creating Database...            ", double(inputReader.getRecordIndex() - startMolIndex) / (endMolIndex - startMolIndex));
 
             if (inputReader.getRecordIndex() >= endMolIndex) 
                 return 0;
@@ -562,6 +513,8 @@ void PSDCreateImpl::printOptionSummary()
 
     printMessage(VERBOSE, " Input File Format:        " + (!inputFormat.empty() ? inputFormat : std::string("Auto-detect")));
     printMessage(VERBOSE, " Add Source-File Property: " + std::string(addSourceFileProp ? "Yes" : "No"));
+    printMessage(VERBOSE, " Use Record Index Files:   " + std::string(useRecordIndexFiles ? "Yes" : "No"));
+    printMessage(VERBOSE, " Create 2-Point Index:     " + std::string(create2PtPharmIndex ? "Yes" : "No"));
 
     if (wasOptionSet("tmp-file-dir"))
         printMessage(VERBOSE, " Temp. File Directory:     " + getOptionValue<std::string>("tmp-file-dir"));
@@ -582,6 +535,7 @@ void PSDCreateImpl::initInputReader()
         printMessage(INFO, "Scanning Input File(s)...");
 
     setMultiConfImportParameter(inputReader, true);
+    Util::setUseRecordIndexFilesParameter(inputReader, useRecordIndexFiles);
 
     for (std::size_t i = 0; i < num_in_files; i++) {
         if (termSignalCaught())
@@ -30,7 +30,7 @@
 #include <string>
 #include <mutex>
 
-#include "CDPL/Pharm/ScreeningDBCreator.hpp"
+#include "CDPL/Pharm/PSDScreeningDBCreator.hpp"
 #include "CDPL/Util/CompoundDataReader.hpp"
 #include "CDPL/Base/DataInputHandler.hpp"
 #include "CDPL/Internal/Timer.hpp"
@@ -71,6 +71,8 @@ namespace PSDCreate
         void processSingleThreaded();
         void processMultiThreaded();
 
+        CDPL::Pharm::PSDScreeningDBCreator::SharedPointer createOutputDBCreator() const;
+
         std::size_t readNextMolecule(CDPL::Chem::Molecule& mol);
         std::size_t doReadNextMolecule(CDPL::Chem::Molecule& mol);
 
@@ -92,7 +94,6 @@ namespace PSDCreate
         void addOptionLongDescriptions();
 
         struct InputScanProgressCallback;
-        struct MergeDBsProgressCallback;
         struct DBCreationWorker;
 
         typedef std::vector<std::string>                             StringList;
@@ -113,6 +114,8 @@ namespace PSDCreate
         std::mutex         molReadMutex;
         std::string        errorMessage;
         bool               addSourceFileProp;
+        bool               useRecordIndexFiles;
+        bool               create2PtPharmIndex;
         Timer              timer;
     };
 } // namespace PSDCreate
@@ -30,10 +30,12 @@
 #include <iomanip>
 
 #include "CDPL/Pharm/PSDScreeningDBAccessor.hpp"
+#include "CDPL/Pharm/MappedPSDScreeningDBAccessor.hpp"
 #include "CDPL/Pharm/FeatureTypeHistogram.hpp"
 #include "CDPL/Pharm/FeatureType.hpp"
 #include "CDPL/Util/FileFunctions.hpp"
 #include "CDPL/Base/Exceptions.hpp"
+#include "CDPL/Internal/StringUtilities.hpp"
 
 #include "PSDInfoImpl.hpp"
 
@@ -41,9 +43,24 @@
 using namespace PSDInfo;
 
 
+namespace
+{
+
+    CDPL::Pharm::ScreeningDBAccessor::SharedPointer createDBAccessor(const std::string& db_name)
+    {
+        using namespace CDPL;
+
+        if (db_name.size() > 5 && Internal::isEqualCI(db_name.substr(db_name.size() - 5), ".mpsd"))
+            return Pharm::ScreeningDBAccessor::SharedPointer(new Pharm::MappedPSDScreeningDBAccessor(db_name));
+
+        return Pharm::ScreeningDBAccessor::SharedPointer(new Pharm::PSDScreeningDBAccessor(db_name));
+    }
+}
+
+
 PSDInfoImpl::PSDInfoImpl(): printConfStats(false), printPharmStats(false), printFeatureStats(false)
 {
-    addOption("input,i", "Database(s) to analyze.", 
+    addOption("input,i", "Database(s) to analyze (*.psd, or *.mpsd for memory-mapped PSD files).", 
               value<StringList>(&inputDatabases)->multitoken()->required());
     addOption("conf-stats,C", "Print molecule conformation count statistics (default: false).", 
               value<bool>(&printConfStats)->implicit_value(true));
@@ -93,7 +110,8 @@ void PSDInfoImpl::printStatistics(const std::string& db_name)
 {
     using namespace CDPL;
 
-    Pharm::PSDScreeningDBAccessor db_acc(db_name);
+    Pharm::ScreeningDBAccessor::SharedPointer db_acc_ptr = createDBAccessor(db_name);
+    const Pharm::ScreeningDBAccessor& db_acc = *db_acc_ptr;
 
     std::size_t num_mols = db_acc.getNumMolecules();
     std::size_t num_pharms = db_acc.getNumPharmacophores();
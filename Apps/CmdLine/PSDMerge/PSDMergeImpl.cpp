@@ -29,6 +29,8 @@
 
 #include "CDPL/Pharm/PSDScreeningDBCreator.hpp"
 #include "CDPL/Pharm/PSDScreeningDBAccessor.hpp"
+#include "CDPL/Pharm/MappedPSDScreeningDBAccessor.hpp"
+#include "CDPL/Pharm/MappedPSDScreeningDBWriter.hpp"
 #include "CDPL/Util/FileFunctions.hpp"
 #include "CDPL/Base/Exceptions.hpp"
 #include "CDPL/Internal/StringUtilities.hpp"
@@ -41,6 +43,26 @@
 using namespace PSDMerge;
 
 
+namespace
+{
+
+    bool isMappedDBFile(const std::string& db_name)
+    {
+        return (db_name.size() > 5 && CDPL::Internal::isEqualCI(db_name.substr(db_name.size() - 5), ".mpsd"));
+    }
+
+    CDPL::Pharm::ScreeningDBAccessor::SharedPointer createDBAccessor(const std::string& db_name)
+    {
+        using namespace CDPL;
+
+        if (isMappedDBFile(db_name))
+            return Pharm::ScreeningDBAccessor::SharedPointer(new Pharm::MappedPSDScreeningDBAccessor(db_name));
+
+        return Pharm::ScreeningDBAccessor::SharedPointer(new Pharm::PSDScreeningDBAccessor(db_name));
+    }
+}
+
+
 struct PSDMergeImpl::MergeDBsProgressCallback
 {
 
@@ -62,18 +84,22 @@ struct PSDMergeImpl::MergeDBsProgressCallback
 
 
 PSDMergeImpl::PSDMergeImpl(): 
-    dropDuplicates(false), creationMode(CDPL::Pharm::ScreeningDBCreator::APPEND)
+    dropDuplicates(false), create2PtPharmIndex(false), creationMode(CDPL::Pharm::ScreeningDBCreator::APPEND)
 {
     using namespace std::placeholders;
     
     addOption("input,i", "Input database file(s).", 
               value<StringList>(&inputDatabases)->multitoken()->required());
-    addOption("output,o", "Output database file.", 
+    addOption("output,o", "Output database file (*.psd, or *.mpsd for memory-mapped PSD files).", 
               value<std::string>(&outputDatabase)->required());
     addOption("mode,m", "Database merge mode (CREATE, APPEND, UPDATE, default: APPEND).", 
               value<std::string>()->notifier(std::bind(&PSDMergeImpl::setCreationMode, this, _1)));
     addOption("drop-duplicates,d", "Drop duplicate molecules (default: false).", 
               value<bool>(&dropDuplicates)->implicit_value(true));
+    addOption("create-2pt-pharm-index", "Store an index of the binned feature pair distances of the output database pharmacophores "
+              "that allows PSDScreen to skip non-matching database pharmacophores without loading them (not supported for "
+              "memory-mapped output databases, default: false).", 
+              value<bool>(&create2PtPharmIndex)->implicit_value(true));
 }
 
 const char* PSDMergeImpl::getProgName() const
@@ -118,8 +144,6 @@ int PSDMergeImpl::mergeDatabases()
 {
     using namespace CDPL;
 
-    typedef std::vector<Pharm::ScreeningDBAccessor::SharedPointer> DBAccessorList;
-
     std::size_t num_mols = 0;
     std::size_t num_pharms = 0;
     DBAccessorList db_accessors;
@@ -130,7 +154,7 @@ int PSDMergeImpl::mergeDatabases()
         if (termSignalCaught())
             return EXIT_FAILURE;
 
-        Pharm::ScreeningDBAccessor::SharedPointer db_acc(new Pharm::PSDScreeningDBAccessor(inputDatabases[i]));
+        Pharm::ScreeningDBAccessor::SharedPointer db_acc = createDBAccessor(inputDatabases[i]);
 
         num_pharms += db_acc->getNumPharmacophores();
         num_mols += db_acc->getNumMolecules();
@@ -145,7 +169,13 @@ int PSDMergeImpl::mergeDatabases()
                  std::to_string(num_pharms) + " pharmacophores");
     printMessage(INFO, "");
 
-    Pharm::PSDScreeningDBCreator db_creator(outputDatabase, creationMode, !dropDuplicates);
+    if (isMappedDBFile(outputDatabase))
+        return writeMappedDatabase(db_accessors);
+
+    Pharm::PSDScreeningDBCreator db_creator;
+
+    db_creator.createTwoPointPharmacophoreIndex(create2PtPharmIndex);
+    db_creator.open(outputDatabase, creationMode, !dropDuplicates);
 
     if (progressEnabled()) {
         initProgress();
@@ -173,6 +203,51 @@ int PSDMergeImpl::mergeDatabases()
     return EXIT_SUCCESS;
 }
 
+int PSDMergeImpl::writeMappedDatabase(DBAccessorList& db_accessors)
+{
+    using namespace CDPL;
+
+    // memory-mapped databases get written from scratch - in APPEND mode the records of
+    // an already existing output database become the first input
+
+    std::size_t num_old_mols = 0;
+
+    if (creationMode == Pharm::ScreeningDBCreator::APPEND && Util::fileExists(outputDatabase)) {
+        Pharm::ScreeningDBAccessor::SharedPointer db_acc(new Pharm::MappedPSDScreeningDBAccessor(outputDatabase));
+
+        num_old_mols = db_acc->getNumMolecules();
+        db_accessors.insert(db_accessors.begin(), db_acc);
+    }
+
+    Pharm::MappedPSDScreeningDBWriter db_writer(outputDatabase);
+
+    if (progressEnabled()) {
+        initProgress();
+        printMessage(INFO, "Merging Databases...", true, true); 
+    } else
+        printMessage(INFO, "Merging Databases..."); 
+
+    for (std::size_t i = 0; i < db_accessors.size(); i++) {
+        if (termSignalCaught())
+            return EXIT_FAILURE;
+
+        if (!db_writer.append(*db_accessors[i], 
+                              MergeDBsProgressCallback(this, i * 1.0 / db_accessors.size(), 
+                                                       1.0 / db_accessors.size())))
+            return EXIT_FAILURE;
+    }
+
+    std::size_t num_new_mols = db_writer.getNumMolecules() - num_old_mols;
+
+    db_writer.close();
+
+    printMessage(INFO, "");
+
+    printStatistics(num_new_mols, 0, 0, num_new_mols);
+
+    return EXIT_SUCCESS;
+}
+
 void PSDMergeImpl::printStatistics(std::size_t num_proc, std::size_t num_rej, 
                                    std::size_t num_del, std::size_t num_ins)
 {
@@ -202,6 +277,12 @@ void PSDMergeImpl::checkInputFiles() const
                      std::bind(Util::checkIfSameFile, boost::ref(outputDatabase),
                                _1)) != inputDatabases.end())
         throw Base::ValueError("output file must not occur in list of input files");
+
+    if (isMappedDBFile(outputDatabase) && (dropDuplicates || creationMode == Pharm::ScreeningDBCreator::UPDATE))
+        throw Base::ValueError("duplicate dropping and UPDATE mode are not supported for memory-mapped output databases");
+
+    if (isMappedDBFile(outputDatabase) && create2PtPharmIndex)
+        throw Base::ValueError("two-point pharmacophore indices are not supported for memory-mapped output databases");
 }
 
 void PSDMergeImpl::printOptionSummary()
@@ -215,6 +296,7 @@ void PSDMergeImpl::printOptionSummary()
     printMessage(VERBOSE, " Output Database:          " + outputDatabase);
      printMessage(VERBOSE, " Creation Mode:            " + getModeString());
      printMessage(VERBOSE, " Drop Duplicates:          " + std::string(dropDuplicates ? "Yes" : "No"));
+     printMessage(VERBOSE, " Create 2-Point Index:     " + std::string(create2PtPharmIndex ? "Yes" : "No"));
     printMessage(VERBOSE, "");
 }
 
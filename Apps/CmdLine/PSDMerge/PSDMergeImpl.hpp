@@ -30,6 +30,7 @@
 #include <string>
 
 #include "CDPL/Pharm/ScreeningDBCreator.hpp"
+#include "CDPL/Pharm/ScreeningDBAccessor.hpp"
 #include "CDPL/Internal/Timer.hpp"
 
 #include "CmdLine/Lib/CmdLineBase.hpp"
@@ -53,6 +54,10 @@ namespace PSDMerge
         int process();
         int mergeDatabases();
 
+        typedef std::vector<CDPL::Pharm::ScreeningDBAccessor::SharedPointer> DBAccessorList;
+
+        int writeMappedDatabase(DBAccessorList& db_accessors);
+
         void checkInputFiles() const;
         void printOptionSummary();
 
@@ -70,6 +75,7 @@ namespace PSDMerge
         StringList   inputDatabases;
         std::string  outputDatabase;
         bool         dropDuplicates;
+        bool         create2PtPharmIndex;
         CreationMode creationMode;
         Timer        timer;
     };
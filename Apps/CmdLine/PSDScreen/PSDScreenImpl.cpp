@@ -34,6 +34,7 @@
 #include <cmath>
 
 #include "CDPL/Pharm/PSDScreeningDBAccessor.hpp"
+#include "CDPL/Pharm/MappedPSDScreeningDBAccessor.hpp"
 #include "CDPL/Pharm/FileScreeningHitCollector.hpp"
 #include "CDPL/Pharm/BasicPharmacophore.hpp"
 #include "CDPL/Pharm/FeatureContainerFunctions.hpp"
@@ -67,8 +68,9 @@ struct PSDScreenImpl::ScreeningWorker
 {
 
     ScreeningWorker(PSDScreenImpl* parent, std::size_t worker_idx, std::size_t start_mol_idx, 
-                    std::size_t end_mol_idx): 
-        parent(parent), workerIndex(worker_idx), startMolIndex(start_mol_idx), endMolIndex(end_mol_idx) {}
+                    std::size_t end_mol_idx, std::size_t num_threads): 
+        parent(parent), workerIndex(worker_idx), startMolIndex(start_mol_idx), endMolIndex(end_mol_idx),
+        numThreads(num_threads) {}
 
     void operator()() {
         using namespace CDPL;
@@ -76,14 +78,15 @@ struct PSDScreenImpl::ScreeningWorker
         using namespace std::placeholders;
         
         try {
-            PSDScreeningDBAccessor db_acc(parent->screeningDB);
-            ScreeningProcessor scr_proc(db_acc);
+            ScreeningDBAccessor::SharedPointer db_acc = parent->createDBAccessor();
+            ScreeningProcessor scr_proc(*db_acc);
             BasicPharmacophore query_pharm;
         
             scr_proc.setHitReportMode(parent->matchingMode);
             scr_proc.setMaxNumOmittedFeatures(parent->maxOmittedFtrs);
             scr_proc.checkXVolumeClashes(parent->checkXVols);
             scr_proc.seekBestAlignments(parent->bestAlignments);
+            scr_proc.setNumThreads(numThreads);
             scr_proc.setHitCallback(std::bind(&ScreeningWorker::reportHit, this, _1, _2));
             scr_proc.setProgressCallback(std::bind(&ScreeningWorker::reportProgress, this, _1, _2));
 
@@ -128,6 +131,7 @@ struct PSDScreenImpl::ScreeningWorker
             setStructureData(hitMol, struc_data);
 
             return parent->collectHit(Pharm::ScreeningProcessor::SearchHit(hit.getHitProvider(),
+                                                                           hit.getDBAccessor(),
                                                                            hit.getQueryPharmacophore(),
                                                                            hit.getHitPharmacophore(),
                                                                            hitMol,
@@ -154,6 +158,7 @@ struct PSDScreenImpl::ScreeningWorker
     std::size_t               workerIndex;
     std::size_t               startMolIndex;
     std::size_t               endMolIndex;
+    std::size_t               numThreads;
     std::size_t               queryIndex;
     CDPL::Chem::BasicMolecule hitMol;
 };
@@ -168,7 +173,7 @@ PSDScreenImpl::PSDScreenImpl():
 {
     using namespace std::placeholders;
     
-    addOption("database,d", "Screening database file.", 
+    addOption("database,d", "Screening database file (*.psd, or *.mpsd for memory-mapped PSD files).", 
               value<std::string>(&screeningDB)->required());
     addOption("query,q", "Query pharmacophore(s).", 
               value<std::string>(&queryPharmFile)->required());
@@ -355,63 +360,18 @@ void PSDScreenImpl::processSingleThreaded()
 
     workerProgArray.resize(1, 0.0);
 
-    ScreeningWorker(this, 0, startMolIndex, endMolIndex)();
+    ScreeningWorker(this, 0, startMolIndex, endMolIndex, 0)();
 }
 
 void PSDScreenImpl::processMultiThreaded()
 {
     using namespace CDPL;
 
-    workerProgArray.resize(numThreads, 0.0);
+    // the screening processor distributes the molecules dynamically among the threads
 
-    typedef std::vector<std::thread> ThreadGroup;
-    
-    ThreadGroup thread_grp;
-
-    try {
-        std::size_t num_mols_per_thread = (endMolIndex - startMolIndex) / numThreads;
-        std::size_t num_rem_mols = (endMolIndex - startMolIndex) % numThreads;
-        
-        for (std::size_t i = 0, start_mol_idx = startMolIndex; i < numThreads; i++) {
-            if (termSignalCaught())
-                break;
-
-            std::size_t chunk_size = num_mols_per_thread;
-
-            if (num_rem_mols > 0) {
-                chunk_size++;
-                num_rem_mols--;
-            }
-            
-            if (chunk_size == 0)
-                break;
-            
-            thread_grp.emplace_back(ScreeningWorker(this, i, start_mol_idx, start_mol_idx + chunk_size));
-
-            start_mol_idx += chunk_size;
-        }
-
-        std::lock_guard<std::mutex> lock(mutex);
-
-        workerProgArray.resize(thread_grp.size());
-        
-    } catch (const std::exception& e) {
-        setErrorMessage(std::string("error while creating worker-threads: ") + e.what());
-
-    } catch (...) {
-        setErrorMessage("unspecified error while creating worker-threads");
-    }
-
-    try {
-        for (auto& thread : thread_grp)
-            thread.join();
-
-    } catch (const std::exception& e) {
-        setErrorMessage(std::string("error while waiting for worker-threads to finish: ") + e.what());
+    workerProgArray.resize(1, 0.0);
 
-    } catch (...) {
-        setErrorMessage("unspecified error while waiting for worker-threads to finish");
-    }
+    ScreeningWorker(this, 0, startMolIndex, endMolIndex, numThreads)();
 }
 
 bool PSDScreenImpl::collectHit(const SearchHit& hit, double score, std::size_t query_idx)
@@ -438,7 +398,7 @@ bool PSDScreenImpl::doCollectHit(const SearchHit& hit, double score, std::size_t
             return false;
 
         printMessage(VERBOSE, "Found matching molecule '" + getName(hit.getHitMolecule()) + 
-                     "' - DB: '" + hit.getHitProvider().getDBAccessor().getDatabaseName() + 
+                     "' - DB: '" + hit.getDBAccessor().getDatabaseName() + 
                      "', Mol. Index: " + std::to_string(hit.getHitMoleculeIndex() + 1) + 
                      ", Conf. Index: " + std::to_string(hit.getHitConformationIndex() + 1) +
                      ", Score: " + std::to_string(score));
@@ -736,10 +696,10 @@ void PSDScreenImpl::analyzeInputFiles()
 
     printMessage(INFO, "Scanning Input Files...  ");
 
-    Pharm::PSDScreeningDBAccessor db_acc(screeningDB);
+    Pharm::ScreeningDBAccessor::SharedPointer db_acc = createDBAccessor();
 
-    numDBMolecules = db_acc.getNumMolecules();
-    numDBPharms = db_acc.getNumPharmacophores();
+    numDBMolecules = db_acc->getNumMolecules();
+    numDBPharms = db_acc->getNumPharmacophores();
     numQueryPharms = queryPharmReader->getNumRecords();
 
     if (endMolIndex == 0)
@@ -759,6 +719,16 @@ void PSDScreenImpl::analyzeInputFiles()
     printMessage(INFO, "");
 }
 
+CDPL::Pharm::ScreeningDBAccessor::SharedPointer PSDScreenImpl::createDBAccessor() const
+{
+    using namespace CDPL;
+
+    if (screeningDB.size() > 5 && Internal::isEqualCI(screeningDB.substr(screeningDB.size() - 5), ".mpsd"))
+        return Pharm::ScreeningDBAccessor::SharedPointer(new Pharm::MappedPSDScreeningDBAccessor(screeningDB));
+
+    return Pharm::ScreeningDBAccessor::SharedPointer(new Pharm::PSDScreeningDBAccessor(screeningDB));
+}
+
 std::string PSDScreenImpl::getMatchingModeString() const
 {
     using namespace CDPL;
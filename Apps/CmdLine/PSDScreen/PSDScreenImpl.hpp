@@ -34,6 +34,7 @@
 #include <fstream>
 
 #include "CDPL/Pharm/ScreeningProcessor.hpp"
+#include "CDPL/Pharm/ScreeningDBAccessor.hpp"
 #include "CDPL/Pharm/PharmacophoreReader.hpp"
 #include "CDPL/Chem/MolecularGraphWriter.hpp"
 #include "CDPL/Internal/Timer.hpp"
@@ -98,6 +99,8 @@ namespace PSDScreen
         void initHitCollector();
         void analyzeInputFiles();
 
+        CDPL::Pharm::ScreeningDBAccessor::SharedPointer createDBAccessor() const;
+
         bool getQueryPharmacophore(std::size_t idx, CDPL::Pharm::Pharmacophore& pharm);
         bool doGetQueryPharmacophore(std::size_t idx, CDPL::Pharm::Pharmacophore& pharm);
 
@@ -24,9 +24,11 @@
 
 #include <iterator>
 #include <fstream>
+#include <sstream>
 #include <thread>
 #include <chrono>
 #include <functional>
+#include <limits>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
@@ -41,6 +43,7 @@
 #include "CDPL/Shape/ScoringFunctors.hpp"
 #include "CDPL/Shape/ScoringFunctions.hpp"
 #include "CDPL/Util/FileFunctions.hpp"
+#include "CDPL/Util/FileRemover.hpp"
 #include "CDPL/Base/DataIOManager.hpp"
 #include "CDPL/Base/Exceptions.hpp"
 #include "CDPL/Internal/StringUtilities.hpp"
@@ -53,6 +56,50 @@
 using namespace ShapeScreen;
 
 
+namespace
+{
+
+    const std::string CHECKPOINT_FILE_ID = "ShapeScreen Checkpoint 1";
+
+    bool getCheckpointFieldValue(std::istream& is, const char* key, std::string& value)
+    {
+        std::string line;
+
+        if (!std::getline(is, line))
+            return false;
+
+        std::string::size_type sep_pos = line.find('\t');
+
+        if (sep_pos == std::string::npos || line.compare(0, sep_pos, key) != 0)
+            return false;
+
+        value = line.substr(sep_pos + 1);
+        return true;
+    }
+
+    template <typename T>
+    void readCheckpointField(std::istream& is, const char* key, T& value, const std::string& file_name)
+    {
+        std::string str_value;
+
+        if (getCheckpointFieldValue(is, key, str_value)) {
+            std::istringstream iss(str_value);
+
+            if (iss >> value)
+                return;
+        }
+
+        throw CDPL::Base::IOError("reading checkpoint file '" + file_name + "' failed: missing or invalid '" + key + "' entry");
+    }
+
+    void readCheckpointField(std::istream& is, const char* key, std::string& value, const std::string& file_name)
+    {
+        if (!getCheckpointFieldValue(is, key, value))
+            throw CDPL::Base::IOError("reading checkpoint file '" + file_name + "' failed: missing '" + key + "' entry");
+    }
+} // namespace
+
+
 class ShapeScreenImpl::ScreeningWorker
 {
 
@@ -63,6 +110,7 @@ public:
         
         screeningProc.getSettings() = parent->settings;
         screeningProc.setHitCallback(std::bind(&ScreeningWorker::hitCallback, this, _1, _2, _3));
+        screeningProc.setDatabaseHitCallback(std::bind(&ScreeningWorker::databaseHitCallback, this, _1, _2, _3));
 
         for (QueryMoleculeList::const_iterator it = parent->queryMolecules.begin(), end = parent->queryMolecules.end(); it != end; ++it)
             screeningProc.addQuery(**it);
@@ -71,6 +119,11 @@ public:
     void operator()() {
         using namespace CDPL;
 
+        if (parent->shapeDatabase.isOpen()) {
+            processShapeDatabase();
+            return;
+        }
+
         while (!terminate) {
             if (!molecule.unique())
                 molecule.reset(new CDPL::Chem::BasicMolecule());
@@ -84,6 +137,10 @@ public:
                 if (!screeningProc.process(*molecule))
                     parent->printMessage(ERROR, "Processing of database molecule " + parent->createMoleculeIdentifier(dbMolIndex, *molecule) + " failed");
 
+                if (parent->shapeDatabaseWriter.isOpen())
+                    parent->addShapeDatabaseRecord(dbMolIndex - 1, getName(*molecule), screeningProc.getDatabaseMoleculeShapes());
+
+                parent->moleculeProcessed();
                 continue;
                 
             } catch (const std::exception& e) {
@@ -93,11 +150,56 @@ public:
                 parent->setErrorMessage("unexpected exception while processing database molecule " + parent->createMoleculeIdentifier(dbMolIndex, *molecule));
             }
 
+            parent->moleculeProcessed();
             return;
         }
     }
 
+    std::size_t getNumPerformedAlignments() const {
+        return screeningProc.getNumPerformedAlignments();
+    }
+
+    std::size_t getNumPrunedAlignments() const {
+        return screeningProc.getNumPrunedAlignments();
+    }
+
 private:
+    void processShapeDatabase() {
+        while (!terminate) {
+            std::size_t rec_idx = parent->getNextShapeDatabaseRecord();
+
+            if (!rec_idx)
+                return;
+
+            try {
+                if (!screeningProc.process(parent->shapeDatabase, rec_idx - 1))
+                    parent->printMessage(ERROR, "Processing of database molecule " + 
+                                         parent->createMoleculeIdentifier(parent->shapeDatabase.getRecordIndex(rec_idx - 1) + 1) + " failed");
+
+                parent->moleculeProcessed();
+                continue;
+
+            } catch (const std::exception& e) {
+                parent->setErrorMessage("unexpected exception while processing shape database record " + std::to_string(rec_idx) + ": " + e.what());
+
+            } catch (...) {
+                parent->setErrorMessage("unexpected exception while processing shape database record " + std::to_string(rec_idx));
+            }
+
+            parent->moleculeProcessed();
+            return;
+        }
+    }
+
+    void databaseHitCallback(const CDPL::Chem::MolecularGraph& query_mol, std::size_t rec_idx, const CDPL::Shape::AlignmentResult& res) {
+        if (terminate)
+            return;
+
+        // database molecules get read on output
+
+        terminate = !parent->processHit(parent->shapeDatabase.getRecordIndex(rec_idx), parent->shapeDatabase.getName(rec_idx), MoleculePtr(), res);
+    }
+
     void hitCallback(const CDPL::Chem::MolecularGraph& query_mol, const CDPL::Chem::MolecularGraph& db_mol, const CDPL::Shape::AlignmentResult& res) {
         if (terminate)
             return;
@@ -117,9 +219,11 @@ ShapeScreenImpl::ShapeScreenImpl():
     scoringFunc("TANIMOTO_COMBO"), numThreads(0), settings(), scoringOnly(false), mergeHitLists(false), 
     splitOutFiles(true), outputQuery(true), scoreSDTags(true), queryNameSDTags(false), 
     queryMolIdxSDTags(false), queryConfIdxSDTags(true), dbMolIdxSDTags(false), dbConfIdxSDTags(true),
-    colorCenterStarts(false), atomCenterStarts(false), shapeCenterStarts(true),
+    colorCenterStarts(false), atomCenterStarts(false), shapeCenterStarts(true), useShapeDatabaseFiles(false),
     hitNamePattern("@D@_@c@_@Q@_@C@"), numBestHits(1000), maxNumHits(0), shapeScoreCutoff(0.0), 
-    numProcMols(0), numHits(0), numSavedHits(0)
+    shapeDatabaseStamp(0), nextShapeDatabaseRecord(0), databaseReadComplete(false), numProcMols(0), numHits(0), numSavedHits(0),
+    numPerfAlignments(0), numPrunedAlignments(0), shardIndex(0), numShards(1), shardEndRecord(std::numeric_limits<std::size_t>::max()),
+    checkpointInterval(300), numPendingMols(0)
 {
     using namespace std::placeholders;
     
@@ -210,8 +314,30 @@ ShapeScreenImpl::ShapeScreenImpl():
               value<std::string>()->notifier(std::bind(&ShapeScreenImpl::setDatabaseFormat, this, _1)));
     addOption("output-format,O", "Hit molecule output file format (default: auto-detect from file extension).", 
               value<std::string>()->notifier(std::bind(&ShapeScreenImpl::setHitOutputFormat, this, _1)));
+    addOption("prune-alignments", "If true, alignments of query and database conformers that provably cannot yield a hit "
+              "will be skipped. Since overlaps are approximated, the score bound includes a small tolerance and the results are "
+              "unaffected only up to the accuracy of the approximation (default: true).",
+              value<bool>()->implicit_value(true)->notifier(std::bind(&ShapeScreenImpl::enableAlignmentPruning, this, _1)));
+    addOption("use-shape-db-files", "Store the Gaussian shapes of the database molecules in a shape database file (<database file>.gsdb) "
+              "and screen the memory-mapped file on subsequent runs instead of reading the database molecules (default: false).", 
+              value<bool>(&useShapeDatabaseFiles)->implicit_value(true));
+    addOption("shard", "Screen only the specified part of the database given in the form <shard index>/<number of shards> (e.g. 2/8) "
+              "where the database records get split into consecutive ranges of equal size (default: 1/1 - screen the whole database).",
+              value<std::string>()->notifier(std::bind(&ShapeScreenImpl::setShard, this, _1)));
+    addOption("checkpoint-file", "File that periodically receives the current state of the screening run. If the file already exists, "
+              "screening resumes at the saved state (default: no checkpointing).",
+              value<std::string>(&checkpointFile));
+    addOption("checkpoint-interval", "Time in seconds between two updates of the checkpoint file (default: " + std::to_string(checkpointInterval) + 
+              ", 0 - update only at the end of the screening run).",
+              value<std::size_t>(&checkpointInterval));
+    addOption("merge-checkpoints", "Merges the hit lists stored in the specified checkpoint files of completed shard screening runs and writes "
+              "the combined hits to the report and hit output files (no screening is performed).",
+              value<StringList>(&mergedCheckpointFiles)->multitoken());
  
     addOptionLongDescriptions();
+
+    // all scoring functions selectable via --score-type are monotone in the overlap
+    settings.pruneAlignments(true);
 }
 
 const char* ShapeScreenImpl::getProgName() const
@@ -276,6 +402,23 @@ void ShapeScreenImpl::addOptionLongDescriptions()
 
     addOptionLongDescription("output", 
                              "Hit molecule output file.\n\n" + formats_str);
+
+    addOptionLongDescription("use-shape-db-files",
+                             "If enabled, the Gaussian shapes generated for the conformers of the database molecules are stored in a "
+                             "binary shape database file next to the database file (<database file>.gsdb) after the database has been "
+                             "screened completely. On subsequent runs with the same color feature type and all-carbon mode settings "
+                             "the file gets memory-mapped and screened instead of reading the database molecules and regenerating "
+                             "their shapes. Only hit molecules are read from the database file on output. The file is automatically "
+                             "rebuilt when the database file or the shape generation settings have changed.");
+
+    addOptionLongDescription("merge-checkpoints",
+                             "Large screening jobs can be spread across several processes or cluster nodes by means of the --shard option. "
+                             "If every shard run is started with its own checkpoint file (--checkpoint-file), the checkpoint files of the "
+                             "completed runs contain the hit lists of the shards. This option reads the hit lists of all specified "
+                             "checkpoint files, combines them into the final ranking and writes the report and hit output files as a "
+                             "single screening run over the whole database would do. Query and database file as well as the screening mode, "
+                             "scoring function, hit list merging and shape database options have to be the same as for the shard runs. "
+                             "A checkpoint file has to be specified for each shard.");
 }
 
 void ShapeScreenImpl::setNumRandomStarts(std::size_t num_starts)
@@ -372,11 +515,31 @@ void ShapeScreenImpl::performSingleConformerSearch(bool single_conf)
     settings.singleConformerSearch(single_conf);
 }
 
+void ShapeScreenImpl::enableAlignmentPruning(bool prune)
+{
+    settings.pruneAlignments(prune);
+}
+
 void ShapeScreenImpl::setScoreCutoff(double cutoff)
 {
     settings.setScoreCutoff(cutoff);
 }
 
+void ShapeScreenImpl::setShard(const std::string& shard_spec)
+{
+    std::istringstream iss(shard_spec);
+    std::size_t shard_idx = 0;
+    std::size_t num_shards = 0;
+    char sep = 0;
+
+    if (!(iss >> shard_idx >> sep >> num_shards) || sep != '/' || !(iss >> std::ws).eof() || 
+        shard_idx < 1 || num_shards < 1 || shard_idx > num_shards)
+        throwValidationError("shard");
+
+    shardIndex = shard_idx - 1;
+    numShards = num_shards;
+}
+
 void ShapeScreenImpl::setQueryFormat(const std::string& file_ext)
 {
     using namespace CDPL;
@@ -439,6 +602,7 @@ int ShapeScreenImpl::process()
     printMessage(INFO, "");
 
     checkOutputFileOptions();
+    checkCheckpointOptions();
     checkInputFiles();
     printOptionSummary();
 
@@ -451,21 +615,50 @@ int ShapeScreenImpl::process()
         return EXIT_FAILURE;
 
     readQueryMolecules();
+
+    if (!mergedCheckpointFiles.empty()) {
+        initReportFileStreams();
+        initHitMoleculeWriters();
+        initHitLists();
+        mergeCheckpointFiles();
+
+        if (termSignalCaught())
+            return EXIT_FAILURE;
+
+        outputHitLists();
+
+        if (termSignalCaught())
+            return EXIT_FAILURE;
+
+        printStatistics();
+
+        return EXIT_SUCCESS;
+    }
+
+    initShapeDatabase();
+    initShard();
     initReportFileStreams();
     initHitMoleculeWriters();
     initHitLists();
-    
-    if (progressEnabled()) {
-        initInfiniteProgress();
-        printMessage(INFO, "Screening Molecules...", true, true);
 
-    } else
-        printMessage(INFO, "Screening Molecules...");
+    if (!resumeFromCheckpoint() && !termSignalCaught()) {
+        if (progressEnabled()) {
+            initInfiniteProgress();
+            printMessage(INFO, "Screening Molecules...", true, true);
 
-    if (numThreads > 0)
-        processMultiThreaded();
-    else
-        processSingleThreaded();
+        } else
+            printMessage(INFO, "Screening Molecules...");
+
+        checkpointTimer.reset();
+
+        if (numThreads > 0)
+            processMultiThreaded();
+        else
+            processSingleThreaded();
+
+        if (!checkpointFile.empty() && !haveErrorMessage() && !writeCheckpoint(!termSignalCaught()))
+            throw CDPL::Base::IOError("writing checkpoint file '" + checkpointFile + "' failed");
+    }
 
     if (haveErrorMessage()) {
         printMessage(ERROR, "Error: " + errorMessage); 
@@ -475,6 +668,7 @@ int ShapeScreenImpl::process()
     if (termSignalCaught())
         return EXIT_FAILURE;
 
+    writeShapeDatabase();
     outputHitLists();
 
     if (termSignalCaught())
@@ -489,21 +683,25 @@ void ShapeScreenImpl::processSingleThreaded()
 {
     using namespace CDPL;
 
-    ScreeningWorker worker(this);
+    ScreeningWorkerPtr worker_ptr(new ScreeningWorker(this));
+
+    workers.push_back(worker_ptr);
+
+    (*worker_ptr)();
+
+    numPerfAlignments += worker_ptr->getNumPerformedAlignments();
+    numPrunedAlignments += worker_ptr->getNumPrunedAlignments();
 
-    worker();
+    workers.clear();
 }
 
 void ShapeScreenImpl::processMultiThreaded()
 {
     using namespace CDPL;
 
-    typedef std::shared_ptr<ScreeningWorker> ScreeningWorkerPtr;
-    typedef std::vector<ScreeningWorkerPtr> ScreeningWorkerList;
     typedef std::vector<std::thread> ThreadGroup;
     
     ThreadGroup thread_grp;
-    ScreeningWorkerList worker_list;
 
     try {
         for (std::size_t i = 0; i < numThreads; i++) {
@@ -512,8 +710,13 @@ void ShapeScreenImpl::processMultiThreaded()
 
             ScreeningWorkerPtr worker_ptr(new ScreeningWorker(this));
 
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+
+                workers.push_back(worker_ptr);
+            }
+
             thread_grp.emplace_back(std::bind(&ScreeningWorker::operator(), worker_ptr));
-            worker_list.push_back(worker_ptr);
         }
 
     } catch (const std::exception& e) {
@@ -533,6 +736,70 @@ void ShapeScreenImpl::processMultiThreaded()
     } catch (...) {
         setErrorMessage("unspecified error while waiting for worker-threads to finish");
     }
+
+    for (auto& worker_ptr : workers) {
+        numPerfAlignments += worker_ptr->getNumPerformedAlignments();
+        numPrunedAlignments += worker_ptr->getNumPrunedAlignments();
+    }
+
+    workers.clear();
+}
+
+bool ShapeScreenImpl::resumeFromCheckpoint()
+{
+    using namespace CDPL;
+
+    if (checkpointFile.empty() || termSignalCaught() || !Util::fileExists(checkpointFile))
+        return false;
+
+    std::size_t shard_idx = 0;
+    std::size_t num_shards = 0;
+    bool complete = readCheckpoint(checkpointFile, false, shard_idx, num_shards);
+
+    printMessage(INFO, "Resuming from checkpoint file '" + checkpointFile + "' (" + std::to_string(numProcMols) + " molecule(s) processed" +
+                 (complete ? ", screening complete)" : ")"));
+    printMessage(INFO, "");
+
+    return complete;
+}
+
+void ShapeScreenImpl::mergeCheckpointFiles()
+{
+    using namespace CDPL;
+
+    printMessage(INFO, "Merging Checkpoint Files...");
+
+    std::vector<bool> merged_shards;
+
+    for (StringList::const_iterator it = mergedCheckpointFiles.begin(), end = mergedCheckpointFiles.end(); it != end && !termSignalCaught(); ++it) {
+        const std::string& file_name = *it;
+        std::size_t shard_idx = 0;
+        std::size_t num_shards = 0;
+
+        readCheckpoint(file_name, true, shard_idx, num_shards);
+
+        if (merged_shards.empty())
+            merged_shards.resize(num_shards, false);
+
+        else if (merged_shards.size() != num_shards)
+            throw Base::ValueError("checkpoint file '" + file_name + "' belongs to a screening run with a different number of shards");
+
+        if (merged_shards[shard_idx])
+            throw Base::ValueError("checkpoint file '" + file_name + "' contains the results of an already merged shard");
+
+        merged_shards[shard_idx] = true;
+
+        printMessage(VERBOSE, " - Merged shard " + std::to_string(shard_idx + 1) + '/' + std::to_string(num_shards) + " results from file '" + file_name + '\'');
+    }
+
+    if (termSignalCaught())
+        return;
+
+    for (std::size_t i = 0; i < merged_shards.size(); i++)
+        if (!merged_shards[i])
+            throw Base::ValueError("checkpoint file for the results of shard " + std::to_string(i + 1) + '/' + std::to_string(merged_shards.size()) + " is missing");
+
+    printMessage(INFO, " - Merged " + std::to_string(mergedCheckpointFiles.size()) + " checkpoint file(s)");
 }
 
 bool ShapeScreenImpl::processHit(std::size_t db_mol_idx, const std::string& db_mol_name, 
@@ -570,19 +837,20 @@ bool ShapeScreenImpl::doProcessHit(std::size_t db_mol_idx, const std::string& db
         return true;
     }
 
-    HitList& hit_list = (mergeHitLists ? hitLists[0] : hitLists[res.getReferenceShapeSetIndex()]);
-        
-    if (numBestHits > 0) {
-        if (hit_list.size() >= numBestHits) {
-            if (hit_list.rbegin()->almntResult.getScore() >= res.getScore())
-                return true;
+    insertHit(mergeHitLists ? hitLists[0] : hitLists[res.getReferenceShapeSetIndex()], HitMoleculeData(db_mol_idx, db_mol_name, res, db_mol));
+    return true;
+}
 
-            hit_list.erase(--hit_list.end());
-        }
+void ShapeScreenImpl::insertHit(HitList& hit_list, const HitMoleculeData& hit_data)
+{
+    if (hit_list.size() >= numBestHits) {
+        if (hit_list.rbegin()->almntResult.getScore() >= hit_data.almntResult.getScore())
+            return;
+
+        hit_list.erase(--hit_list.end());
     }
 
-    hit_list.insert(HitMoleculeData(db_mol_idx, db_mol_name, res, db_mol));
-    return true;
+    hit_list.insert(hit_data);
 }
 
 void ShapeScreenImpl::setupMolecule(CDPL::Chem::Molecule& mol) const
@@ -590,6 +858,89 @@ void ShapeScreenImpl::setupMolecule(CDPL::Chem::Molecule& mol) const
     CDPL::Pharm::prepareForPharmacophoreGeneration(mol);
 }
 
+std::size_t ShapeScreenImpl::getNextShapeDatabaseRecord()
+{
+    if (termSignalCaught())
+        return 0;
+
+    if (haveErrorMessage())
+        return 0;
+
+    std::unique_lock<std::mutex> lock(molReadMutex, std::defer_lock);
+
+    if (numThreads > 0)
+        lock.lock();
+
+    checkpointIfDue();
+
+    if (nextShapeDatabaseRecord >= std::min(shardEndRecord, shapeDatabase.getNumRecords())) {
+        printInfiniteProgress("Screening Molecules (" + std::to_string(numProcMols) + " passed)", true);
+        return 0;
+    }
+
+    numProcMols++;
+    printInfiniteProgress("Screening Molecules (" + std::to_string(numProcMols) + " passed)", numProcMols == 1);
+
+    if (numThreads > 0 && !checkpointFile.empty()) {
+        std::lock_guard<std::mutex> cp_lock(checkpointMutex);
+
+        numPendingMols++;
+    }
+
+    return ++nextShapeDatabaseRecord;
+}
+
+void ShapeScreenImpl::addShapeDatabaseRecord(std::size_t rec_idx, const std::string& name, const CDPL::Shape::GaussianShapeSet& shapes)
+{
+    std::unique_lock<std::mutex> lock(shapeDatabaseMutex, std::defer_lock);
+
+    if (numThreads > 0)
+        lock.lock();
+
+    if (!shapeDatabaseWriter.isOpen())
+        return;
+
+    if (!shapeDatabaseWriter.addRecord(rec_idx, name, shapes))
+        printMessage(ERROR, "Shape database file will not be written: writing shape data failed");
+}
+
+void ShapeScreenImpl::writeShapeDatabase()
+{
+    if (!shapeDatabaseWriter.isOpen())
+        return;
+
+    if (!databaseReadComplete || shapeDatabaseWriter.getNumRecords() == 0) {
+        shapeDatabaseWriter.discard();
+        return;
+    }
+
+    printMessage(VERBOSE, "");
+
+    if (!shapeDatabaseWriter.close())
+        printMessage(ERROR, "Writing shape database file '" + shapeDatabasePath + "' failed");
+    else
+        printMessage(VERBOSE, "Wrote shape database file '" + shapeDatabasePath + '\'');
+}
+
+ShapeScreenImpl::MoleculePtr ShapeScreenImpl::readDatabaseMolecule(std::size_t rec_idx)
+{
+    using namespace CDPL;
+
+    MoleculePtr mol(new Chem::BasicMolecule());
+
+    try {
+        if (databaseReader->read(rec_idx, *mol)) {
+            setupMolecule(*mol);
+            return mol;
+        }
+
+    } catch (const std::exception& e) {
+        throw Base::IOError("reading database molecule " + createMoleculeIdentifier(rec_idx + 1) + " failed: " + e.what());
+    }
+
+    throw Base::IOError("reading database molecule " + createMoleculeIdentifier(rec_idx + 1) + " failed");
+}
+
 void ShapeScreenImpl::readQueryMolecules()
 {
     using namespace CDPL;
@@ -614,6 +965,57 @@ void ShapeScreenImpl::readQueryMolecules()
     printMessage(INFO, "");
 }
 
+void ShapeScreenImpl::initShapeDatabase()
+{
+    using namespace CDPL;
+
+    if (!useShapeDatabaseFiles || termSignalCaught())
+        return;
+
+    shapeDatabasePath  = databaseFile + ".gsdb";
+    shapeDatabaseStamp = Util::calcFileStamp(databaseFile);
+
+    if (shapeDatabase.open(shapeDatabasePath, shapeDatabaseStamp)) {
+        if (shapeDatabase.getColorFeatureType() == settings.getColorFeatureType() && shapeDatabase.allCarbonMode() == settings.allCarbonMode()) {
+            printMessage(INFO, "Using shape database file '" + shapeDatabasePath + "' (" + std::to_string(shapeDatabase.getNumRecords()) + " molecule(s))");
+            printMessage(INFO, "");
+            return;
+        }
+
+        shapeDatabase.close();
+    }
+
+    // the shape database file can only be created by a single pass over the whole database
+
+    if (numShards > 1 || (!checkpointFile.empty() && Util::fileExists(checkpointFile)))
+        return;
+
+    if (!shapeDatabaseWriter.open(shapeDatabasePath, shapeDatabaseStamp, settings.getColorFeatureType(), settings.allCarbonMode())) {
+        printMessage(ERROR, "Creating shape database file '" + shapeDatabasePath + "' failed");
+        printMessage(INFO, "");
+    }
+}
+
+void ShapeScreenImpl::initShard()
+{
+    if (numShards == 1 || termSignalCaught())
+        return;
+
+    std::size_t num_recs = (shapeDatabase.isOpen() ? shapeDatabase.getNumRecords() : databaseReader->getNumRecords());
+    std::size_t first_rec = num_recs * shardIndex / numShards;
+
+    shardEndRecord = num_recs * (shardIndex + 1) / numShards;
+
+    if (shapeDatabase.isOpen())
+        nextShapeDatabaseRecord = first_rec;
+    else
+        databaseReader->setRecordIndex(first_rec);
+
+    printMessage(INFO, "Screening shard " + std::to_string(shardIndex + 1) + '/' + std::to_string(numShards) + " (database records " +
+                 std::to_string(first_rec + 1) + '-' + std::to_string(shardEndRecord) + " of " + std::to_string(num_recs) + ')');
+    printMessage(INFO, "");
+}
+
 void ShapeScreenImpl::initHitLists()
 {
     hitLists.resize(mergeHitLists ? 1 : queryMolecules.size());
@@ -889,6 +1291,8 @@ void ShapeScreenImpl::outputHitMolecule(const MoleculeWriterPtr& writer, const H
     if (reportFile.empty())
         numSavedHits++;
 
+    MoleculePtr db_mol = (hit_data.dbMolecule ? hit_data.dbMolecule : readDatabaseMolecule(hit_data.dbMolIndex));
+
     try {
         std::string name = hitNamePattern;
 
@@ -899,9 +1303,9 @@ void ShapeScreenImpl::outputHitMolecule(const MoleculeWriterPtr& writer, const H
         boost::replace_all(name, "@I@", std::to_string(hit_data.almntResult.getReferenceShapeSetIndex() + 1));
         boost::replace_all(name, "@i@", std::to_string(hit_data.dbMolIndex + 1));
 
-        setName(*hit_data.dbMolecule, name);
-        applyConformation(*hit_data.dbMolecule, hit_data.almntResult.getAlignedShapeIndex());
-        transform3DCoordinates(*hit_data.dbMolecule, hit_data.almntResult.getTransform());
+        setName(*db_mol, name);
+        applyConformation(*db_mol, hit_data.almntResult.getAlignedShapeIndex());
+        transform3DCoordinates(*db_mol, hit_data.almntResult.getTransform());
 
         setMultiConfExportParameter(*writer, false);
 
@@ -909,8 +1313,8 @@ void ShapeScreenImpl::outputHitMolecule(const MoleculeWriterPtr& writer, const H
             Chem::StringDataBlock::SharedPointer old_sd_block;
             Chem::StringDataBlock::SharedPointer new_sd_block;
 
-            if (hasStructureData(*hit_data.dbMolecule)) {
-                old_sd_block = getStructureData(*hit_data.dbMolecule);
+            if (hasStructureData(*db_mol)) {
+                old_sd_block = getStructureData(*db_mol);
                 new_sd_block.reset(new Chem::StringDataBlock(*old_sd_block));
 
             } else
@@ -953,26 +1357,26 @@ void ShapeScreenImpl::outputHitMolecule(const MoleculeWriterPtr& writer, const H
                 new_sd_block->addEntry("<DB Tversky Combo>", (boost::format("%.3f") % calcAlignedTverskyComboScore(hit_data.almntResult)).str());
             }
 
-            setStructureData(*hit_data.dbMolecule, new_sd_block);
+            setStructureData(*db_mol, new_sd_block);
 
-            if (writer->write(*hit_data.dbMolecule)) {
+            if (writer->write(*db_mol)) {
                 if (old_sd_block)
-                    setStructureData(*hit_data.dbMolecule, old_sd_block);
+                    setStructureData(*db_mol, old_sd_block);
                 else
-                    clearStructureData(*hit_data.dbMolecule);
+                    clearStructureData(*db_mol);
 
                 return;
             }
 
-        } else if (writer->write(*hit_data.dbMolecule))
+        } else if (writer->write(*db_mol))
             return;
 
     } catch (const std::exception& e) {
-        throw CDPL::Base::IOError("writing hit molecule " + createMoleculeIdentifier(hit_data.dbMolIndex + 1, *hit_data.dbMolecule) + " failed: " + e.what());
+        throw CDPL::Base::IOError("writing hit molecule " + createMoleculeIdentifier(hit_data.dbMolIndex + 1, *db_mol) + " failed: " + e.what());
 
     } catch (...) {}
 
-    throw CDPL::Base::IOError("unspecified error while writing hit molecule " + createMoleculeIdentifier(hit_data.dbMolIndex + 1, *hit_data.dbMolecule));
+    throw CDPL::Base::IOError("unspecified error while writing hit molecule " + createMoleculeIdentifier(hit_data.dbMolIndex + 1, *db_mol));
 }
 
 void ShapeScreenImpl::setErrorMessage(const std::string& msg)
@@ -1000,17 +1404,35 @@ std::size_t ShapeScreenImpl::readNextMolecule(CDPL::Chem::Molecule& mol)
     if (numThreads > 0) {
         std::lock_guard<std::mutex> lock(molReadMutex);
 
-        return doReadNextMolecule(mol);
+        checkpointIfDue();
+
+        std::size_t rec_idx = doReadNextMolecule(mol);
+
+        if (rec_idx && !checkpointFile.empty()) {
+            std::lock_guard<std::mutex> cp_lock(checkpointMutex);
+
+            numPendingMols++;
+        }
+
+        return rec_idx;
     }
 
+    checkpointIfDue();
+
     return doReadNextMolecule(mol);
 }
 
 std::size_t ShapeScreenImpl::doReadNextMolecule(CDPL::Chem::Molecule& mol)
 {
     while (true) {
+        if (databaseReader->getRecordIndex() >= shardEndRecord) {
+            printInfiniteProgress("Screening Molecules (" + std::to_string(numProcMols) + " passed)", true);
+            return 0;
+        }
+
         try {
             if (!databaseReader->read(mol)) {
+                databaseReadComplete = true;
                 printInfiniteProgress("Screening Molecules (" + std::to_string(numProcMols) + " passed)", true);
                 return 0;
             }
@@ -1035,6 +1457,264 @@ std::size_t ShapeScreenImpl::doReadNextMolecule(CDPL::Chem::Molecule& mol)
     return 0;
 }
 
+void ShapeScreenImpl::moleculeProcessed()
+{
+    if (numThreads == 0 || checkpointFile.empty())
+        return;
+
+    std::lock_guard<std::mutex> lock(checkpointMutex);
+
+    if (--numPendingMols == 0)
+        checkpointCondition.notify_all();
+}
+
+void ShapeScreenImpl::checkpointIfDue()
+{
+    if (checkpointFile.empty() || checkpointInterval == 0)
+        return;
+
+    if (std::chrono::duration_cast<std::chrono::seconds>(checkpointTimer.elapsed()).count() < std::chrono::seconds::rep(checkpointInterval))
+        return;
+
+    // called with the molecule read mutex being locked: no further molecules get dispatched and the checkpoint
+    // is written as soon as all molecules in flight have been processed
+
+    if (numThreads > 0) {
+        std::unique_lock<std::mutex> lock(checkpointMutex);
+
+        checkpointCondition.wait(lock, [this]() { return (numPendingMols == 0); });
+    }
+
+    if (haveErrorMessage() || termSignalCaught())
+        return;
+
+    if (!writeCheckpoint(false))
+        printMessage(ERROR, "Writing checkpoint file '" + checkpointFile + "' failed");
+
+    checkpointTimer.reset();
+}
+
+bool ShapeScreenImpl::writeCheckpoint(bool complete)
+{
+    using namespace CDPL;
+
+    try {
+        std::string::size_type sep_pos = checkpointFile.find_last_of("/\\");
+        Util::FileRemover tmp_file_rem(Util::genCheckedTempFilePath(sep_pos == std::string::npos ? std::string(".") : checkpointFile.substr(0, sep_pos + 1),
+                                                                    "%%%%-%%%%-%%%%-%%%%.tmp"));
+        std::ofstream os(tmp_file_rem.getPath().c_str(), std::ios_base::out | std::ios_base::trunc);
+        std::size_t num_perf_almnts = 0;
+        std::size_t num_pruned_almnts = 0;
+        std::size_t num_saved_hits = 0;
+
+        getAlignmentStatistics(num_perf_almnts, num_pruned_almnts);
+
+        for (HitListArray::const_iterator it = hitLists.begin(), end = hitLists.end(); it != end; ++it)
+            num_saved_hits += it->size();
+
+        os << CHECKPOINT_FILE_ID << '\n'
+           << "complete\t" << complete << '\n'
+           << "shard-index\t" << shardIndex << '\n'
+           << "num-shards\t" << numShards << '\n'
+           << "source\t" << (shapeDatabase.isOpen() ? "SHAPE_DB" : "MOL_DB") << '\n'
+           << "position\t" << (shapeDatabase.isOpen() ? nextShapeDatabaseRecord : databaseReader->getRecordIndex()) << '\n'
+           << "num-queries\t" << queryMolecules.size() << '\n'
+           << "scoring-func\t" << scoringFunc << '\n'
+           << "screening-mode\t" << screeningModeToString(settings.getScreeningMode()) << '\n'
+           << "merge-hit-lists\t" << mergeHitLists << '\n'
+           << "num-proc-mols\t" << numProcMols << '\n'
+           << "num-hits\t" << numHits << '\n'
+           << "num-perf-alignments\t" << num_perf_almnts << '\n'
+           << "num-pruned-alignments\t" << num_pruned_almnts << '\n'
+           << "num-saved-hits\t" << num_saved_hits << '\n';
+
+        os.precision(17);
+
+        for (HitListArray::const_iterator it1 = hitLists.begin(), end1 = hitLists.end(); it1 != end1; ++it1) {
+            for (HitList::const_iterator it2 = it1->begin(), end2 = it1->end(); it2 != end2; ++it2) {
+                const HitMoleculeData& hit_data = *it2;
+                const Shape::AlignmentResult& res = hit_data.almntResult;
+
+                os << hit_data.dbMolIndex << '\t' << res.getReferenceShapeSetIndex() << '\t' << res.getReferenceShapeIndex() << '\t'
+                   << res.getAlignedShapeIndex() << '\t' << res.getScore() << '\t' << res.getOverlap() << '\t' << res.getColorOverlap() << '\t'
+                   << res.getReferenceSelfOverlap() << '\t' << res.getReferenceColorSelfOverlap() << '\t' << res.getAlignedSelfOverlap() << '\t'
+                   << res.getAlignedColorSelfOverlap();
+
+                for (std::size_t i = 0; i < 4; i++)
+                    for (std::size_t j = 0; j < 4; j++)
+                        os << '\t' << res.getTransform()(i, j);
+
+                os << '\t' << hit_data.dbMolName << '\n';
+            }
+        }
+
+        os << "end\n";
+        os.close();
+
+        if (!os || !Util::renameFile(tmp_file_rem.getPath(), checkpointFile))
+            return false;
+
+        tmp_file_rem.release();
+        return true;
+
+    } catch (const std::exception& e) {
+        printMessage(ERROR, std::string("Error while writing checkpoint file: ") + e.what());
+    }
+
+    return false;
+}
+
+bool ShapeScreenImpl::readCheckpoint(const std::string& file_name, bool merge, std::size_t& shard_idx, std::size_t& num_shards)
+{
+    using namespace CDPL;
+
+    std::ifstream is(file_name);
+    std::string line;
+
+    if (!std::getline(is, line) || line != CHECKPOINT_FILE_ID)
+        throw Base::IOError("file '" + file_name + "' is not a valid checkpoint file");
+
+    bool complete = false;
+    std::string source;
+    std::size_t pos = 0;
+    std::size_t num_queries = 0;
+    std::string scoring_func;
+    std::string screening_mode;
+    bool merge_hit_lists = false;
+    std::size_t num_proc_mols = 0;
+    std::size_t num_hits = 0;
+    std::size_t num_perf_almnts = 0;
+    std::size_t num_pruned_almnts = 0;
+    std::size_t num_saved_hits = 0;
+
+    readCheckpointField(is, "complete", complete, file_name);
+    readCheckpointField(is, "shard-index", shard_idx, file_name);
+    readCheckpointField(is, "num-shards", num_shards, file_name);
+    readCheckpointField(is, "source", source, file_name);
+    readCheckpointField(is, "position", pos, file_name);
+    readCheckpointField(is, "num-queries", num_queries, file_name);
+    readCheckpointField(is, "scoring-func", scoring_func, file_name);
+    readCheckpointField(is, "screening-mode", screening_mode, file_name);
+    readCheckpointField(is, "merge-hit-lists", merge_hit_lists, file_name);
+    readCheckpointField(is, "num-proc-mols", num_proc_mols, file_name);
+    readCheckpointField(is, "num-hits", num_hits, file_name);
+    readCheckpointField(is, "num-perf-alignments", num_perf_almnts, file_name);
+    readCheckpointField(is, "num-pruned-alignments", num_pruned_almnts, file_name);
+    readCheckpointField(is, "num-saved-hits", num_saved_hits, file_name);
+
+    if (shard_idx >= num_shards)
+        throw Base::IOError("reading checkpoint file '" + file_name + "' failed: invalid shard specification");
+
+    if (num_queries != queryMolecules.size())
+        throw Base::ValueError("checkpoint file '" + file_name + "' was written for a different number of query molecules");
+
+    if (scoring_func != scoringFunc || screening_mode != screeningModeToString(settings.getScreeningMode()) || merge_hit_lists != mergeHitLists)
+        throw Base::ValueError("checkpoint file '" + file_name + "' was written with different scoring function, screening mode or hit list merging settings");
+
+    if (merge) {
+        if (!complete)
+            throw Base::ValueError("checkpoint file '" + file_name + "' belongs to an unfinished screening run");
+
+        if (mergedCheckpointSource.empty())
+            mergedCheckpointSource = source;
+
+        else if (source != mergedCheckpointSource)
+            throw Base::ValueError("checkpoint file '" + file_name + "' was written with different shape database file usage");
+
+    } else {
+        if (shard_idx != shardIndex || num_shards != numShards)
+            throw Base::ValueError("checkpoint file '" + file_name + "' was written for a different database shard");
+
+        if (source != (shapeDatabase.isOpen() ? "SHAPE_DB" : "MOL_DB"))
+            throw Base::ValueError("checkpoint file '" + file_name + "' was written with different shape database file usage");
+    }
+
+    for (std::size_t i = 0; i < num_saved_hits; i++) {
+        if (!std::getline(is, line))
+            throw Base::IOError("reading checkpoint file '" + file_name + "' failed: unexpected end of file");
+
+        std::istringstream iss(line);
+        Shape::AlignmentResult res;
+        Math::Matrix4D xform;
+        std::size_t db_mol_idx = 0;
+        std::size_t ref_set_idx = 0;
+        std::size_t ref_idx = 0;
+        std::size_t al_idx = 0;
+        double values[7];
+        std::string db_mol_name;
+
+        iss >> db_mol_idx >> ref_set_idx >> ref_idx >> al_idx;
+
+        for (std::size_t j = 0; j < 7; j++)
+            iss >> values[j];
+
+        for (std::size_t j = 0; j < 4; j++)
+            for (std::size_t k = 0; k < 4; k++)
+                iss >> xform(j, k);
+
+        if (!iss || iss.get() != '\t' || ref_set_idx >= queryMolecules.size())
+            throw Base::IOError("reading checkpoint file '" + file_name + "' failed: invalid hit data in line " + std::to_string(i + 16));
+
+        std::getline(iss, db_mol_name);
+
+        res.setReferenceShapeSetIndex(ref_set_idx);
+        res.setReferenceShapeIndex(ref_idx);
+        res.setAlignedShapeIndex(al_idx);
+        res.setScore(values[0]);
+        res.setOverlap(values[1]);
+        res.setColorOverlap(values[2]);
+        res.setReferenceSelfOverlap(values[3]);
+        res.setReferenceColorSelfOverlap(values[4]);
+        res.setAlignedSelfOverlap(values[5]);
+        res.setAlignedColorSelfOverlap(values[6]);
+        res.setTransform(xform);
+
+        // database molecules get read on output
+
+        insertHit(mergeHitLists ? hitLists[0] : hitLists[ref_set_idx], HitMoleculeData(db_mol_idx, db_mol_name, res));
+    }
+
+    if (!std::getline(is, line) || line != "end")
+        throw Base::IOError("reading checkpoint file '" + file_name + "' failed: unexpected end of file");
+
+    if (merge) {
+        numProcMols += num_proc_mols;
+        numHits += num_hits;
+        numPerfAlignments += num_perf_almnts;
+        numPrunedAlignments += num_pruned_almnts;
+
+        return complete;
+    }
+
+    numProcMols = num_proc_mols;
+    numHits = num_hits;
+    numPerfAlignments = num_perf_almnts;
+    numPrunedAlignments = num_pruned_almnts;
+
+    if (shapeDatabase.isOpen())
+        nextShapeDatabaseRecord = pos;
+    else
+        databaseReader->setRecordIndex(pos);
+
+    return complete;
+}
+
+void ShapeScreenImpl::getAlignmentStatistics(std::size_t& num_perf, std::size_t& num_pruned)
+{
+    std::unique_lock<std::mutex> lock(mutex, std::defer_lock);
+
+    if (numThreads > 0)
+        lock.lock();
+
+    num_perf = numPerfAlignments;
+    num_pruned = numPrunedAlignments;
+
+    for (auto& worker_ptr : workers) {
+        num_perf += worker_ptr->getNumPerformedAlignments();
+        num_pruned += worker_ptr->getNumPrunedAlignments();
+    }
+}
+
 bool ShapeScreenImpl::haveErrorMessage()
 {
     if (numThreads > 0) {
@@ -1054,6 +1734,8 @@ void ShapeScreenImpl::printStatistics()
     printMessage(INFO, " Num. processed Molecules: " + std::to_string(numProcMols));
     printMessage(INFO, " Num. Hit Molecules:       " + std::to_string(numHits));
     printMessage(INFO, " Num. saved Hits:          " + std::to_string(numSavedHits));
+    printMessage(INFO, " Num. aligned Conf. Pairs: " + std::to_string(numPerfAlignments));
+    printMessage(INFO, " Num. pruned Conf. Pairs:  " + std::to_string(numPrunedAlignments));
     printMessage(INFO, " Processing Time:          " + CmdLineLib::formatTimeDuration(proc_time));
 }
 
@@ -1063,6 +1745,15 @@ void ShapeScreenImpl::checkOutputFileOptions() const
         throw CDPL::Base::ValueError("A hit output and/or report file has to be specified");
 }
 
+void ShapeScreenImpl::checkCheckpointOptions() const
+{
+    if ((!checkpointFile.empty() || !mergedCheckpointFiles.empty()) && numBestHits == 0)
+        throw CDPL::Base::ValueError("checkpointing requires a limited number of best hits to output (option --best-hits)");
+
+    if (!mergedCheckpointFiles.empty() && (numShards > 1 || !checkpointFile.empty()))
+        throw CDPL::Base::ValueError("checkpoint files cannot be merged in a shard or checkpointed screening run");
+}
+
 void ShapeScreenImpl::checkInputFiles() const
 {
     using namespace CDPL;
@@ -1119,6 +1810,7 @@ void ShapeScreenImpl::printOptionSummary()
     printMessage(VERBOSE, " Shape Alignment:                     " + std::string(scoringOnly ? "No" : "Yes"));
     printMessage(VERBOSE, " Overlay Optimization:                " + std::string(settings.optimizeOverlap() ? "Yes" : "No"));
     printMessage(VERBOSE, " Thorough Overlay Optimization:       " + std::string(settings.greedyOptimization() ? "No" : "Yes"));
+    printMessage(VERBOSE, " Alignment Pruning:                   " + std::string(settings.pruneAlignments() ? "Yes" : "No"));
     printMessage(VERBOSE, " Output Query Molecules:              " + std::string(outputQuery ? "Yes" : "No"));
     printMessage(VERBOSE, " Single Conformer DB-Mode:            " + std::string(settings.singleConformerSearch() ? "Yes" : "No"));
     printMessage(VERBOSE, " Color Feature Type:                  " + colorFeatureTypeToString(settings.getColorFeatureType()));
@@ -1133,6 +1825,16 @@ void ShapeScreenImpl::printOptionSummary()
     printMessage(VERBOSE, " Output Query Conf. Index SD-Tags:    " + std::string(queryConfIdxSDTags ? "Yes" : "No"));
     printMessage(VERBOSE, " Output Database Mol. Index SD-Tags:  " + std::string(dbMolIdxSDTags ? "Yes" : "No"));
     printMessage(VERBOSE, " Output Database Conf. Index SD-Tags: " + std::string(dbConfIdxSDTags ? "Yes" : "No"));
+    printMessage(VERBOSE, " Use Shape Database Files:            " + std::string(useShapeDatabaseFiles ? "Yes" : "No"));
+    printMessage(VERBOSE, " Database Shard:                      " + (numShards > 1 ? std::to_string(shardIndex + 1) + '/' + std::to_string(numShards) : std::string("None")));
+    printMessage(VERBOSE, " Checkpoint File:                     " + (checkpointFile.empty() ? std::string("None") : checkpointFile));
+
+    if (!checkpointFile.empty())
+        printMessage(VERBOSE, " Checkpoint Interval:                 " + (checkpointInterval > 0 ? std::to_string(checkpointInterval) + "s" : std::string("End of Run")));
+
+    if (!mergedCheckpointFiles.empty())
+        printMessage(VERBOSE, " Num. merged Checkpoint Files:        " + std::to_string(mergedCheckpointFiles.size()));
+
     printMessage(VERBOSE, " Hit Output Mol. Name Pattern:        " + hitNamePattern);
     printMessage(VERBOSE, " Multithreading:                      " + std::string(numThreads > 0 ? "Yes" : "No"));
 
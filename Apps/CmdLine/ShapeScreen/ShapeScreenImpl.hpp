@@ -31,13 +31,17 @@
 #include <set>
 #include <iosfwd>
 #include <mutex>
+#include <condition_variable>
 #include <memory>
+#include <cstdint>
 
 #include "CDPL/Chem/Molecule.hpp"
 #include "CDPL/Chem/MoleculeReader.hpp"
 #include "CDPL/Chem/MolecularGraphWriter.hpp"
 #include "CDPL/Shape/ScreeningSettings.hpp"
 #include "CDPL/Shape/AlignmentResult.hpp"
+#include "CDPL/Shape/GaussianShapeDatabase.hpp"
+#include "CDPL/Shape/GaussianShapeDatabaseWriter.hpp"
 #include "CDPL/Internal/Timer.hpp"
 
 #include "CmdLine/Lib/CmdLineBase.hpp"
@@ -56,9 +60,13 @@ namespace ShapeScreen
         typedef CDPL::Shape::ScreeningSettings                  ScreeningSettings;
         typedef CDPL::Chem::Molecule::SharedPointer             MoleculePtr;
         typedef CDPL::Chem::MolecularGraphWriter::SharedPointer MoleculeWriterPtr;
+        typedef std::vector<std::string>                        StringList;
 
         class ScreeningWorker;
 
+        typedef std::shared_ptr<ScreeningWorker> ScreeningWorkerPtr;
+        typedef std::vector<ScreeningWorkerPtr>  ScreeningWorkerList;
+
         struct HitMoleculeData
         {
 
@@ -81,6 +89,8 @@ namespace ShapeScreen
             MoleculePtr                  dbMolecule;
         };
 
+        typedef std::multiset<HitMoleculeData> HitList;
+
         const char* getProgName() const;
         const char* getProgAboutText() const;
 
@@ -96,9 +106,12 @@ namespace ShapeScreen
         void performOverlayOptimization(bool opt);
         void performThoroughOverlayOptimization(bool thorough);
         void performSingleConformerSearch(bool single_conf);
+        void enableAlignmentPruning(bool prune);
 
         void setScoreCutoff(double cutoff);
 
+        void setShard(const std::string& shard_spec);
+
         void setQueryFormat(const std::string& file_ext);
         void setDatabaseFormat(const std::string& file_ext);
         void setHitOutputFormat(const std::string& file_ext);
@@ -106,27 +119,41 @@ namespace ShapeScreen
         void setAlignmentMode();
         void checkInputFiles() const;
         void checkOutputFileOptions() const;
+        void checkCheckpointOptions() const;
 
         void initQueryReader();
         void initDatabaseReader();
         void initHitLists();
         void initReportFileStreams();
         void initHitMoleculeWriters();
+        void initShapeDatabase();
+        void initShard();
 
         int process();
 
         void processSingleThreaded();
         void processMultiThreaded();
 
+        bool resumeFromCheckpoint();
+        void mergeCheckpointFiles();
+
         bool processHit(std::size_t db_mol_idx, const std::string& db_mol_name,
                         const MoleculePtr& db_mol, const CDPL::Shape::AlignmentResult& res);
         bool doProcessHit(std::size_t db_mol_idx, const std::string& db_mol_name,
                           const MoleculePtr& db_mol, const CDPL::Shape::AlignmentResult& res);
 
+        void insertHit(HitList& hit_list, const HitMoleculeData& hit_data);
+
         void readQueryMolecules();
 
         void setupMolecule(CDPL::Chem::Molecule& mol) const;
 
+        std::size_t getNextShapeDatabaseRecord();
+        void addShapeDatabaseRecord(std::size_t rec_idx, const std::string& name, const CDPL::Shape::GaussianShapeSet& shapes);
+        void writeShapeDatabase();
+
+        MoleculePtr readDatabaseMolecule(std::size_t rec_idx);
+
         void outputHitLists();
         void outputReportFiles();
         void outputHitMoleculeFiles();
@@ -140,6 +167,14 @@ namespace ShapeScreen
         std::size_t readNextMolecule(CDPL::Chem::Molecule& mol);
         std::size_t doReadNextMolecule(CDPL::Chem::Molecule& mol);
 
+        void moleculeProcessed();
+
+        void checkpointIfDue();
+        bool writeCheckpoint(bool complete);
+        bool readCheckpoint(const std::string& file_name, bool merge, std::size_t& shard_idx, std::size_t& num_shards);
+
+        void getAlignmentStatistics(std::size_t& num_perf, std::size_t& num_pruned);
+
         void setErrorMessage(const std::string& msg);
         bool haveErrorMessage();
 
@@ -163,11 +198,13 @@ namespace ShapeScreen
         typedef std::shared_ptr<std::ostream>             OStreamPtr;
         typedef CDPL::Chem::MoleculeReader::SharedPointer MoleculeReaderPtr;
         typedef std::vector<MoleculePtr>                  QueryMoleculeList;
-        typedef std::multiset<HitMoleculeData>            HitList;
         typedef std::vector<HitList>                      HitListArray;
         typedef std::vector<OStreamPtr>                   OStreamArray;
         typedef std::vector<MoleculeWriterPtr>            MoleculeWriterArray;
         typedef CDPL::Internal::Timer                     Timer;
+        typedef CDPL::Shape::GaussianShapeDatabase        ShapeDatabase;
+        typedef CDPL::Shape::GaussianShapeDatabaseWriter  ShapeDatabaseWriter;
+        typedef std::condition_variable                   ConditionVariable;
 
         std::string         queryFile;
         std::string         databaseFile;
@@ -189,6 +226,7 @@ namespace ShapeScreen
         bool                colorCenterStarts;
         bool                atomCenterStarts;
         bool                shapeCenterStarts;
+        bool                useShapeDatabaseFiles;
         std::string         hitNamePattern;
         std::size_t         numBestHits;
         std::size_t         maxNumHits;
@@ -198,6 +236,12 @@ namespace ShapeScreen
         std::string         databaseFormat;
         MoleculeReaderPtr   databaseReader;
         std::string         hitOutputFormat;
+        ShapeDatabase       shapeDatabase;
+        ShapeDatabaseWriter shapeDatabaseWriter;
+        std::string         shapeDatabasePath;
+        std::uint64_t       shapeDatabaseStamp;
+        std::size_t         nextShapeDatabaseRecord;
+        bool                databaseReadComplete;
         QueryMoleculeList   queryMolecules;
         HitListArray        hitLists;
         OStreamArray        reportOStreams;
@@ -206,9 +250,24 @@ namespace ShapeScreen
         std::size_t         numProcMols;
         std::size_t         numHits;
         std::size_t         numSavedHits;
+        std::size_t         numPerfAlignments;
+        std::size_t         numPrunedAlignments;
+        std::size_t         shardIndex;
+        std::size_t         numShards;
+        std::size_t         shardEndRecord;
+        std::string         checkpointFile;
+        std::size_t         checkpointInterval;
+        StringList          mergedCheckpointFiles;
+        std::string         mergedCheckpointSource;
+        Timer               checkpointTimer;
+        std::size_t         numPendingMols;
+        ScreeningWorkerList workers;
         std::mutex          mutex;
         std::mutex          molReadMutex;
         std::mutex          hitProcMutex;
+        std::mutex          shapeDatabaseMutex;
+        std::mutex          checkpointMutex;
+        ConditionVariable   checkpointCondition;
         std::string         errorMessage;
     };
 } // namespace ShapeScreen
@@ -22,6 +22,8 @@
  */
 
 
+#include <cmath>
+
 #include "CDPL/Descr/SimilarityFunctions.hpp"
 
 #include "CosineSimilarity.hpp"
@@ -41,3 +43,9 @@ double CosineSimilarity::calculate(const CDPL::Math::DVector& query_descr, const
 {
     return CDPL::Descr::calcCosineSimilarity(query_descr, db_mol_descr);
 }
+
+double CosineSimilarity::calculate(std::size_t query_fp_bit_count, std::size_t db_mol_fp_bit_count, std::size_t common_bit_count,
+                                   std::size_t fp_size) const
+{
+    return (double(common_bit_count) / std::sqrt(double(query_fp_bit_count * db_mol_fp_bit_count)));
+}
@@ -41,3 +41,9 @@ double DiceSimilarity::calculate(const CDPL::Math::DVector& query_descr, const C
 {
     return -1.0;
 }
+
+double DiceSimilarity::calculate(std::size_t query_fp_bit_count, std::size_t db_mol_fp_bit_count, std::size_t common_bit_count,
+                                 std::size_t fp_size) const
+{
+    return (double(2 * common_bit_count) / double(query_fp_bit_count + db_mol_fp_bit_count));
+}
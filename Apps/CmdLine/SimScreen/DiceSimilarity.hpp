@@ -40,6 +40,9 @@ namespace SimScreen
         double calculate(const CDPL::Util::BitSet& query_fp, const CDPL::Util::BitSet& db_mol_fp) const;
 
         double calculate(const CDPL::Math::DVector& query_descr, const CDPL::Math::DVector& db_mol_descr) const;
+
+        double calculate(std::size_t query_fp_bit_count, std::size_t db_mol_fp_bit_count, std::size_t common_bit_count,
+                         std::size_t fp_size) const;
     };
 } // namespace SimScreen
 
@@ -22,6 +22,8 @@
  */
 
 
+#include <cmath>
+
 #include "CDPL/Descr/SimilarityFunctions.hpp"
 
 #include "EuclideanDistance.hpp"
@@ -41,3 +43,9 @@ double EuclideanDistance::calculate(const CDPL::Math::DVector& query_descr, cons
 {
     return CDPL::Descr::calcEuclideanDistance(query_descr, db_mol_descr);
 }
+
+double EuclideanDistance::calculate(std::size_t query_fp_bit_count, std::size_t db_mol_fp_bit_count, std::size_t common_bit_count,
+                                    std::size_t fp_size) const
+{
+    return std::sqrt(double(query_fp_bit_count + db_mol_fp_bit_count - 2 * common_bit_count));
+}
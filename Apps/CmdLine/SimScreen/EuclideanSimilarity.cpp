@@ -22,6 +22,8 @@
  */
 
 
+#include <cmath>
+
 #include "CDPL/Descr/SimilarityFunctions.hpp"
 
 #include "EuclideanSimilarity.hpp"
@@ -41,3 +43,11 @@ double EuclideanSimilarity::calculate(const CDPL::Math::DVector& query_descr, co
 {
     return -1.0;
 }
+
+double EuclideanSimilarity::calculate(std::size_t query_fp_bit_count, std::size_t db_mol_fp_bit_count, std::size_t common_bit_count,
+                                      std::size_t fp_size) const
+{
+    std::size_t nab = fp_size - (query_fp_bit_count + db_mol_fp_bit_count - common_bit_count);
+
+    return std::sqrt(double(common_bit_count + nab) / double(fp_size));
+}
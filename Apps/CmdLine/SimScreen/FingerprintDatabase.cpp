@@ -0,0 +1,213 @@
+/* 
+ * FingerprintDatabase.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstring>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include "CDPL/Util/FileFunctions.hpp"
+
+#include "FingerprintDatabase.hpp"
+
+
+using namespace SimScreen;
+
+
+namespace
+{
+
+    const char          FILE_ID[8]      = { 'C', 'D', 'P', 'L', 'S', 'S', 'F', 'P' };
+    const std::uint32_t FORMAT_VERSION  = 1;
+    const std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+}
+
+
+FingerprintDatabase::FingerprintDatabase():
+    numBits(0), numWords(0), numMolecules(0), numRows(0), numSegments(0), molecules(0), segments(0),
+    bucketStarts(0), rowIndices(0), rowWords(0), names(0)
+{}
+
+FingerprintDatabase::~FingerprintDatabase()
+{}
+
+bool FingerprintDatabase::open(const std::string& path, std::uint64_t src_stamp, const std::string& descr_spec)
+{
+    using namespace CDPL;
+
+    close();
+
+    if (!Util::fileExists(path))
+        return false;
+
+    try {
+        MappedFilePtr file(new MappedFile(path));
+
+        if (!file->is_open() || file->size() < sizeof(Header))
+            return false;
+
+        Header header;
+
+        std::memcpy(&header, file->data(), sizeof(Header));
+
+        if (std::memcmp(header.fileID, FILE_ID, sizeof(FILE_ID)) != 0 || header.formatVersion != FORMAT_VERSION ||
+            header.byteOrderMark != BYTE_ORDER_MARK || header.sourceStamp != src_stamp || header.fileSize != file->size())
+            return false;
+
+        if (header.descrSpecLength != descr_spec.size() || sizeof(Header) + header.descrSpecLength > file->size() ||
+            descr_spec.compare(0, std::string::npos, file->data() + sizeof(Header), header.descrSpecLength) != 0)
+            return false;
+
+        std::size_t num_words = getNumWords(header.numBits);
+
+        // sanity checks of the table layout
+
+        if (header.moleculeTableOffset != align(sizeof(Header) + header.descrSpecLength) ||
+            header.segmentTableOffset != align(header.moleculeTableOffset + header.numMolecules * sizeof(Molecule)) ||
+            header.bucketTableOffset != align(header.segmentTableOffset + header.numSegments * sizeof(Segment)) ||
+            header.rowIndexTableOffset != align(header.bucketTableOffset + header.numSegments * (header.numBits + 2) * sizeof(std::uint32_t)) ||
+            header.rowDataOffset != align(header.rowIndexTableOffset + header.numRows * sizeof(std::uint32_t)) ||
+            header.nameDataOffset != header.rowDataOffset + header.numRows * num_words * sizeof(std::uint64_t) ||
+            header.nameDataOffset > header.fileSize)
+            return false;
+
+        mappedFile.swap(file);
+
+        const char* data = mappedFile->data();
+
+        numBits      = header.numBits;
+        numWords     = num_words;
+        numMolecules = header.numMolecules;
+        numRows      = header.numRows;
+        numSegments  = header.numSegments;
+        molecules    = reinterpret_cast<const Molecule*>(data + header.moleculeTableOffset);
+        segments     = reinterpret_cast<const Segment*>(data + header.segmentTableOffset);
+        bucketStarts = reinterpret_cast<const std::uint32_t*>(data + header.bucketTableOffset);
+        rowIndices   = reinterpret_cast<const std::uint32_t*>(data + header.rowIndexTableOffset);
+        rowWords     = reinterpret_cast<const std::uint64_t*>(data + header.rowDataOffset);
+        names        = data + header.nameDataOffset;
+
+        return true;
+
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+void FingerprintDatabase::close()
+{
+    mappedFile.reset();
+
+    numBits      = 0;
+    numWords     = 0;
+    numMolecules = 0;
+    numRows      = 0;
+    numSegments  = 0;
+    molecules    = 0;
+    segments     = 0;
+    bucketStarts = 0;
+    rowIndices   = 0;
+    rowWords     = 0;
+    names        = 0;
+}
+
+bool FingerprintDatabase::isOpen() const
+{
+    return mappedFile.get();
+}
+
+std::size_t FingerprintDatabase::getNumBits() const
+{
+    return numBits;
+}
+
+std::size_t FingerprintDatabase::getNumWords() const
+{
+    return numWords;
+}
+
+std::size_t FingerprintDatabase::getNumMolecules() const
+{
+    return numMolecules;
+}
+
+std::size_t FingerprintDatabase::getNumRows() const
+{
+    return numRows;
+}
+
+std::size_t FingerprintDatabase::getNumSegments() const
+{
+    return numSegments;
+}
+
+const FingerprintDatabase::Molecule& FingerprintDatabase::getMolecule(std::size_t idx) const
+{
+    return molecules[idx];
+}
+
+std::string FingerprintDatabase::getMoleculeName(std::size_t idx) const
+{
+    const Molecule& mol = molecules[idx];
+
+    return std::string(names + mol.nameOffset, mol.nameLength);
+}
+
+const FingerprintDatabase::Segment& FingerprintDatabase::getSegment(std::size_t idx) const
+{
+    return segments[idx];
+}
+
+const std::uint32_t* FingerprintDatabase::getBucketStarts(std::size_t seg_idx) const
+{
+    return (bucketStarts + seg_idx * (numBits + 2));
+}
+
+const std::uint32_t* FingerprintDatabase::getRowIndices(std::size_t seg_idx) const
+{
+    return (rowIndices + segments[seg_idx].firstRow);
+}
+
+const std::uint64_t* FingerprintDatabase::getRowWords(std::size_t seg_idx) const
+{
+    return (rowWords + segments[seg_idx].firstRow * numWords);
+}
+
+std::size_t FingerprintDatabase::getNumWords(std::size_t num_bits)
+{
+    return ((num_bits + 63) / 64);
+}
+
+void FingerprintDatabase::initHeader(Header& header)
+{
+    std::memset(&header, 0, sizeof(Header));
+    std::memcpy(header.fileID, FILE_ID, sizeof(FILE_ID));
+
+    header.formatVersion = FORMAT_VERSION;
+    header.byteOrderMark = BYTE_ORDER_MARK;
+}
+
+std::size_t FingerprintDatabase::align(std::size_t offs)
+{
+    return ((offs + 7) & ~std::size_t(7));
+}
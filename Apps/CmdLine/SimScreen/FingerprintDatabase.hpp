@@ -0,0 +1,163 @@
+/* 
+ * FingerprintDatabase.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef SIMSCREEN_FINGERPRINTDATABASE_HPP
+#define SIMSCREEN_FINGERPRINTDATABASE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <memory>
+
+
+namespace boost
+{
+
+    namespace iostreams
+    {
+
+        class mapped_file_source;
+    }
+} // namespace boost
+
+
+namespace SimScreen
+{
+
+    // Provides read access to memory-mapped fingerprint database files (see FingerprintDatabaseBuilder).
+    // The fingerprint rows of the database molecules are grouped into segments of consecutive molecules. Within a
+    // segment the rows are ordered by their number of set bits, and for each possible bit count the segment
+    // stores the index of the first row (bucket) with this count. Rows whose bit count does not allow to reach
+    // a given score threshold can thus be skipped bucket-wise.
+    class FingerprintDatabase
+    {
+
+      public:
+        struct Molecule
+        {
+
+            std::uint64_t recordIndex;
+            std::uint64_t firstRow;
+            std::uint64_t nameOffset;
+            std::uint32_t nameLength;
+            std::uint32_t numRows;
+        };
+
+        struct Segment
+        {
+
+            std::uint64_t firstMolecule;
+            std::uint64_t numMolecules;
+            std::uint64_t firstRow;
+            std::uint64_t numRows;
+        };
+
+        FingerprintDatabase();
+
+        ~FingerprintDatabase();
+
+        bool open(const std::string& path, std::uint64_t src_stamp, const std::string& descr_spec);
+
+        void close();
+
+        bool isOpen() const;
+
+        std::size_t getNumBits() const;
+
+        std::size_t getNumWords() const;
+
+        std::size_t getNumMolecules() const;
+
+        std::size_t getNumRows() const;
+
+        std::size_t getNumSegments() const;
+
+        const Molecule& getMolecule(std::size_t idx) const;
+
+        std::string getMoleculeName(std::size_t idx) const;
+
+        const Segment& getSegment(std::size_t idx) const;
+
+        // returns numBits + 2 bucket start offsets (relative to the first row of the segment)
+        const std::uint32_t* getBucketStarts(std::size_t seg_idx) const;
+
+        // returns for each row of the segment (in bucket order) the index of the row in molecule order
+        // (relative to the first row of the segment)
+        const std::uint32_t* getRowIndices(std::size_t seg_idx) const;
+
+        const std::uint64_t* getRowWords(std::size_t seg_idx) const;
+
+        static std::size_t getNumWords(std::size_t num_bits);
+
+      private:
+        friend class FingerprintDatabaseBuilder;
+
+        struct Header
+        {
+
+            char          fileID[8];
+            std::uint32_t formatVersion;
+            std::uint32_t byteOrderMark;
+            std::uint64_t sourceStamp;
+            std::uint64_t descrSpecLength;
+            std::uint64_t numBits;
+            std::uint64_t numMolecules;
+            std::uint64_t numRows;
+            std::uint64_t numSegments;
+            std::uint64_t moleculeTableOffset;
+            std::uint64_t segmentTableOffset;
+            std::uint64_t bucketTableOffset;
+            std::uint64_t rowIndexTableOffset;
+            std::uint64_t rowDataOffset;
+            std::uint64_t nameDataOffset;
+            std::uint64_t fileSize;
+        };
+
+        FingerprintDatabase(const FingerprintDatabase&);
+
+        FingerprintDatabase& operator=(const FingerprintDatabase&);
+
+        static void initHeader(Header& header);
+
+        static std::size_t align(std::size_t offs);
+
+        typedef boost::iostreams::mapped_file_source MappedFile;
+        typedef std::unique_ptr<MappedFile>          MappedFilePtr;
+
+        MappedFilePtr        mappedFile;
+        std::size_t          numBits;
+        std::size_t          numWords;
+        std::size_t          numMolecules;
+        std::size_t          numRows;
+        std::size_t          numSegments;
+        const Molecule*      molecules;
+        const Segment*       segments;
+        const std::uint32_t* bucketStarts;
+        const std::uint32_t* rowIndices;
+        const std::uint64_t* rowWords;
+        const char*          names;
+    };
+} // namespace SimScreen
+
+#endif // SIMSCREEN_FINGERPRINTDATABASE_HPP
@@ -0,0 +1,233 @@
+/* 
+ * FingerprintDatabaseBuilder.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <algorithm>
+#include <fstream>
+
+#include "CDPL/Util/FileFunctions.hpp"
+#include "CDPL/Util/FileRemover.hpp"
+#include "CDPL/Internal/PopCount.hpp"
+
+#include "FingerprintDatabaseBuilder.hpp"
+#include "FingerprintDatabase.hpp"
+
+
+using namespace SimScreen;
+
+
+namespace
+{
+
+    constexpr std::size_t MAX_SEGMENT_SIZE = 4096;
+
+    void writePadding(std::ostream& os, std::size_t offs, std::size_t aligned_offs)
+    {
+        static const char PADDING[8] = { 0 };
+
+        os.write(PADDING, std::streamsize(aligned_offs - offs));
+    }
+
+    template <typename T>
+    void writeArray(std::ostream& os, const std::vector<T>& array)
+    {
+        os.write(reinterpret_cast<const char*>(array.data()), std::streamsize(array.size() * sizeof(T)));
+    }
+}
+
+
+FingerprintDatabaseBuilder::FingerprintDatabaseBuilder():
+    numBits(0)
+{}
+
+void FingerprintDatabaseBuilder::clear()
+{
+    numBits = 0;
+
+    molecules.clear();
+    words.clear();
+}
+
+std::size_t FingerprintDatabaseBuilder::getNumMolecules() const
+{
+    return molecules.size();
+}
+
+bool FingerprintDatabaseBuilder::addMolecule(std::size_t rec_idx, const std::string& name, const BitSetArray& fps, std::size_t num_fps)
+{
+    using namespace CDPL;
+
+    if (num_fps == 0)
+        return true;
+
+    if (molecules.empty())
+        numBits = fps[0].size();
+
+    for (std::size_t i = 0; i < num_fps; i++)
+        if (fps[i].size() != numBits)
+            return false;
+
+    std::size_t num_words = FingerprintDatabase::getNumWords(numBits);
+
+    molecules.push_back(MoleculeData{rec_idx, words.size(), num_fps, name});
+    words.resize(words.size() + num_fps * num_words, 0);
+
+    std::uint64_t* mol_words = &words[molecules.back().firstWord];
+
+    for (std::size_t i = 0; i < num_fps; i++, mol_words += num_words)
+        for (Util::BitSet::size_type j = fps[i].find_first(); j != Util::BitSet::npos; j = fps[i].find_next(j))
+            mol_words[j / 64] |= std::uint64_t(1) << (j % 64);
+
+    return true;
+}
+
+bool FingerprintDatabaseBuilder::write(const std::string& path, std::uint64_t src_stamp, const std::string& descr_spec)
+{
+    using namespace CDPL;
+
+    typedef FingerprintDatabase::Header   Header;
+    typedef FingerprintDatabase::Molecule Molecule;
+    typedef FingerprintDatabase::Segment  Segment;
+
+    // molecules may have been added by multiple threads in arbitrary order
+
+    std::sort(molecules.begin(), molecules.end(),
+              [](const MoleculeData& md1, const MoleculeData& md2) { return (md1.recordIndex < md2.recordIndex); });
+
+    std::size_t num_words = FingerprintDatabase::getNumWords(numBits);
+    std::vector<Molecule> mol_table;
+    std::vector<Segment> seg_table;
+    std::string names;
+
+    mol_table.reserve(molecules.size());
+
+    for (std::size_t i = 0, num_rows = 0; i < molecules.size(); i++) {
+        const MoleculeData& md = molecules[i];
+
+        if (seg_table.empty() || (seg_table.back().numRows + md.numRows) > MAX_SEGMENT_SIZE)
+            seg_table.push_back(Segment{i, 0, num_rows, 0});
+
+        seg_table.back().numMolecules++;
+        seg_table.back().numRows += md.numRows;
+
+        mol_table.push_back(Molecule{md.recordIndex, num_rows, names.size(), std::uint32_t(md.name.size()), std::uint32_t(md.numRows)});
+
+        names.append(md.name);
+        num_rows += md.numRows;
+    }
+
+    std::size_t num_rows = (seg_table.empty() ? std::size_t(0) : std::size_t(seg_table.back().firstRow + seg_table.back().numRows));
+    std::vector<std::uint32_t> bucket_starts(seg_table.size() * (numBits + 2), 0);
+    std::vector<std::uint32_t> row_indices;
+    std::vector<std::uint64_t> row_words;
+
+    row_indices.reserve(num_rows);
+    row_words.reserve(num_rows * num_words);
+
+    for (std::size_t i = 0; i < seg_table.size(); i++) {
+        const Segment& seg = seg_table[i];
+
+        segmentRows.clear();
+
+        for (std::size_t j = 0; j < seg.numMolecules; j++) {
+            const MoleculeData& md = molecules[seg.firstMolecule + j];
+
+            for (std::size_t k = 0; k < md.numRows; k++)
+                segmentRows.push_back(RowData{std::uint32_t(Internal::popCount(&words[md.firstWord + k * num_words], num_words)),
+                                              std::uint32_t(segmentRows.size()), md.firstWord + k * num_words});
+        }
+
+        // within a bucket the rows keep their molecule order
+
+        std::stable_sort(segmentRows.begin(), segmentRows.end(),
+                         [](const RowData& rd1, const RowData& rd2) { return (rd1.bitCount < rd2.bitCount); });
+
+        std::uint32_t* seg_bucket_starts = &bucket_starts[i * (numBits + 2)];
+
+        for (const RowData& rd : segmentRows) {
+            seg_bucket_starts[rd.bitCount + 1]++;
+
+            row_indices.push_back(rd.rowIndex);
+            row_words.insert(row_words.end(), words.begin() + rd.firstWord, words.begin() + rd.firstWord + num_words);
+        }
+
+        for (std::size_t j = 1; j < numBits + 2; j++)
+            seg_bucket_starts[j] += seg_bucket_starts[j - 1];
+    }
+
+    Header header;
+
+    FingerprintDatabase::initHeader(header);
+
+    header.sourceStamp         = src_stamp;
+    header.descrSpecLength     = descr_spec.size();
+    header.numBits             = numBits;
+    header.numMolecules        = mol_table.size();
+    header.numRows             = num_rows;
+    header.numSegments         = seg_table.size();
+    header.moleculeTableOffset = FingerprintDatabase::align(sizeof(Header) + descr_spec.size());
+    header.segmentTableOffset  = FingerprintDatabase::align(header.moleculeTableOffset + mol_table.size() * sizeof(Molecule));
+    header.bucketTableOffset   = FingerprintDatabase::align(header.segmentTableOffset + seg_table.size() * sizeof(Segment));
+    header.rowIndexTableOffset = FingerprintDatabase::align(header.bucketTableOffset + bucket_starts.size() * sizeof(std::uint32_t));
+    header.rowDataOffset       = FingerprintDatabase::align(header.rowIndexTableOffset + row_indices.size() * sizeof(std::uint32_t));
+    header.nameDataOffset      = header.rowDataOffset + row_words.size() * sizeof(std::uint64_t);
+    header.fileSize            = header.nameDataOffset + names.size();
+
+    try {
+        std::string::size_type sep_pos = path.find_last_of("/\\");
+        Util::FileRemover tmp_file_rem(Util::genCheckedTempFilePath(sep_pos == std::string::npos ? std::string(".") : path.substr(0, sep_pos + 1),
+                                                                    "%%%%-%%%%-%%%%-%%%%.tmp"));
+
+        std::ofstream os(tmp_file_rem.getPath().c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+
+        if (!os)
+            return false;
+
+        os.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        os.write(descr_spec.data(), std::streamsize(descr_spec.size()));
+
+        writePadding(os, sizeof(Header) + descr_spec.size(), header.moleculeTableOffset);
+        writeArray(os, mol_table);
+        writePadding(os, header.moleculeTableOffset + mol_table.size() * sizeof(Molecule), header.segmentTableOffset);
+        writeArray(os, seg_table);
+        writePadding(os, header.segmentTableOffset + seg_table.size() * sizeof(Segment), header.bucketTableOffset);
+        writeArray(os, bucket_starts);
+        writePadding(os, header.bucketTableOffset + bucket_starts.size() * sizeof(std::uint32_t), header.rowIndexTableOffset);
+        writeArray(os, row_indices);
+        writePadding(os, header.rowIndexTableOffset + row_indices.size() * sizeof(std::uint32_t), header.rowDataOffset);
+        writeArray(os, row_words);
+
+        os.write(names.data(), std::streamsize(names.size()));
+        os.close();
+
+        if (!os || !Util::renameFile(tmp_file_rem.getPath(), path))
+            return false;
+
+        tmp_file_rem.release();
+
+        return true;
+
+    } catch (const std::exception&) {
+        return false;
+    }
+}
@@ -0,0 +1,84 @@
+/* 
+ * FingerprintDatabaseBuilder.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef SIMSCREEN_FINGERPRINTDATABASEBUILDER_HPP
+#define SIMSCREEN_FINGERPRINTDATABASEBUILDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "CDPL/Util/BitSet.hpp"
+
+
+namespace SimScreen
+{
+
+    class FingerprintDatabaseBuilder
+    {
+
+      public:
+        typedef std::vector<CDPL::Util::BitSet> BitSetArray;
+
+        FingerprintDatabaseBuilder();
+
+        void clear();
+
+        std::size_t getNumMolecules() const;
+
+        bool addMolecule(std::size_t rec_idx, const std::string& name, const BitSetArray& fps, std::size_t num_fps);
+
+        bool write(const std::string& path, std::uint64_t src_stamp, const std::string& descr_spec);
+
+      private:
+        struct MoleculeData
+        {
+
+            std::size_t recordIndex;
+            std::size_t firstWord;
+            std::size_t numRows;
+            std::string name;
+        };
+
+        struct RowData
+        {
+
+            std::uint32_t bitCount;
+            std::uint32_t rowIndex;
+            std::size_t   firstWord;
+        };
+
+        typedef std::vector<MoleculeData>  MoleculeDataArray;
+        typedef std::vector<std::uint64_t> WordArray;
+        typedef std::vector<RowData>       RowDataArray;
+
+        std::size_t       numBits;
+        MoleculeDataArray molecules;
+        WordArray         words;
+        RowDataArray      segmentRows;
+    };
+} // namespace SimScreen
+
+#endif // SIMSCREEN_FINGERPRINTDATABASEBUILDER_HPP
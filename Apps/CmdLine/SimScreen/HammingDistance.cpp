@@ -41,3 +41,9 @@ double HammingDistance::calculate(const CDPL::Math::DVector& query_descr, const
 {
     return -1.0;
 }
+
+double HammingDistance::calculate(std::size_t query_fp_bit_count, std::size_t db_mol_fp_bit_count, std::size_t common_bit_count,
+                                  std::size_t fp_size) const
+{
+    return double(query_fp_bit_count + db_mol_fp_bit_count - 2 * common_bit_count);
+}
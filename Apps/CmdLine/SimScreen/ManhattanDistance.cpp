@@ -41,3 +41,9 @@ double ManhattanDistance::calculate(const CDPL::Math::DVector& query_descr, cons
 {
     return CDPL::Descr::calcManhattanDistance(query_descr, db_mol_descr);
 }
+
+double ManhattanDistance::calculate(std::size_t query_fp_bit_count, std::size_t db_mol_fp_bit_count, std::size_t common_bit_count,
+                                    std::size_t fp_size) const
+{
+    return double(query_fp_bit_count + db_mol_fp_bit_count - 2 * common_bit_count);
+}
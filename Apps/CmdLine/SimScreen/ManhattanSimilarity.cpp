@@ -41,3 +41,12 @@ double ManhattanSimilarity::calculate(const CDPL::Math::DVector& query_descr, co
 {
     return -1.0;
 }
+
+double ManhattanSimilarity::calculate(std::size_t query_fp_bit_count, std::size_t db_mol_fp_bit_count, std::size_t common_bit_count,
+                                      std::size_t fp_size) const
+{
+    std::size_t oa = query_fp_bit_count - common_bit_count;
+    std::size_t ob = db_mol_fp_bit_count - common_bit_count;
+
+    return (1.0 - double(oa + ob) / double(fp_size));
+}
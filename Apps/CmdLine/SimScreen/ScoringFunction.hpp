@@ -26,6 +26,7 @@
 #define SIMSCREEN_SCORINGFUNCTION_HPP
 
 #include <string>
+#include <cstddef>
 
 #include "CDPL/Util/BitSet.hpp"
 #include "CDPL/Math/Vector.hpp"
@@ -65,6 +66,18 @@ namespace SimScreen
         virtual double calculate(const CDPL::Util::BitSet& query_fp, const CDPL::Util::BitSet& db_mol_fp) const = 0;
 
         virtual double calculate(const CDPL::Math::DVector& query_descr, const CDPL::Math::DVector& db_mol_descr) const = 0;
+
+        // calculates the score for two equally sized fingerprints from their bit counts (the result is identical to
+        // the one for the corresponding bitsets)
+        virtual double calculate(std::size_t query_fp_bit_count, std::size_t db_mol_fp_bit_count, std::size_t common_bit_count,
+                                 std::size_t fp_size) const = 0;
+
+        // tells whether the score improves monotonically with the number of common bits and thus is bounded
+        // by the score for common_bit_count = min(query_fp_bit_count, db_mol_fp_bit_count)
+        virtual bool isMonotonicInCommonBitCount() const
+        {
+            return true;
+        }
  
         bool compare(double score1, double score2) const
         {
@@ -22,25 +22,30 @@
  */
 
 
+#include <algorithm>
+
 #include "CDPL/Chem/Molecule.hpp"
 #include "CDPL/Chem/AtomContainerFunctions.hpp"
 #include "CDPL/Chem/Entity3DContainerFunctions.hpp"
+#include "CDPL/Internal/PopCount.hpp"
 
 #include "ScreeningProcessor.hpp"
 #include "ScoringFunction.hpp"
 #include "DescriptorCalculator.hpp"
+#include "FingerprintDatabase.hpp"
 
 
 using namespace SimScreen;
 
 
 ScreeningProcessor::ScreeningProcessor(const ScoringFunction& scr_func, const DescriptorCalculator& calc):
-    scoringFunc(scr_func), descrCalculator(calc.clone()) {}
+    scoringFunc(scr_func), descrCalculator(calc.clone()), numDBMolDescrs(0), dbMolBSDescrsUsed(false) {}
 
 ScreeningProcessor::ScreeningProcessor(const ScreeningProcessor& proc, const ScoringFunction& scr_func,
                                        const DescriptorCalculator& calc, const ResultCallbackFunc& cb_func):
     scoringFunc(scr_func), descrCalculator(calc.clone()), callbackFunc(cb_func), queryMolBSDescrs(proc.queryMolBSDescrs),
-    queryMolDVDescrs(proc.queryMolDVDescrs) {}
+    queryMolDVDescrs(proc.queryMolDVDescrs), numDBMolDescrs(0), dbMolBSDescrsUsed(false), dbQueryWords(proc.dbQueryWords),
+    dbQueryBitCounts(proc.dbQueryBitCounts), dbQueryOffsets(proc.dbQueryOffsets) {}
 
 ScreeningProcessor::~ScreeningProcessor() {}
 
@@ -163,6 +168,9 @@ bool ScreeningProcessor::process(CDPL::Chem::Molecule& db_mol, ScreeningMode mod
 
     std::size_t num_db_mol_descrs = (num_db_mol_confs == 0 ? 1 : num_db_mol_confs);
 
+    numDBMolDescrs    = num_db_mol_descrs;
+    dbMolBSDescrsUsed = bs_descr;
+
     if (bs_descr) {
         if (dbMolBSDescrs.size() < num_db_mol_descrs)
             dbMolBSDescrs.resize(num_db_mol_descrs);
@@ -195,27 +203,163 @@ bool ScreeningProcessor::process(CDPL::Chem::Molecule& db_mol, ScreeningMode mod
     }
 
     if (bs_descr)
-        getResults(queryMolBSDescrs, dbMolBSDescrs, mode, single_conf_srch);
+        getResults(queryMolBSDescrs.size(),
+                   [this](std::size_t i) { return queryMolBSDescrs[i].size(); },
+                   num_db_mol_descrs,
+                   [this](std::size_t i, std::size_t j, std::size_t k) { return scoringFunc.calculate(queryMolBSDescrs[i][j], dbMolBSDescrs[k]); },
+                   mode, single_conf_srch, 0);
     else
-        getResults(queryMolDVDescrs, dbMolDVDescrs, mode, single_conf_srch);
+        getResults(queryMolDVDescrs.size(),
+                   [this](std::size_t i) { return queryMolDVDescrs[i].size(); },
+                   num_db_mol_descrs,
+                   [this](std::size_t i, std::size_t j, std::size_t k) { return scoringFunc.calculate(queryMolDVDescrs[i][j], dbMolDVDescrs[k]); },
+                   mode, single_conf_srch, 0);
     
     return true;
 }
 
-template <typename QueryMolDescrLists, typename DBMolDescrList>
-void ScreeningProcessor::getResults(const QueryMolDescrLists& query_mol_descr_lists, const DBMolDescrList& db_mol_descr_list,
-                                    ScreeningMode mode, bool single_conf_srch) const
+const ScreeningProcessor::BitSetArray& ScreeningProcessor::getDatabaseMoleculeFingerprints()
+{
+    if (!dbMolBSDescrsUsed) {
+        if (dbMolBSDescrs.size() < numDBMolDescrs)
+            dbMolBSDescrs.resize(numDBMolDescrs);
+
+        for (std::size_t i = 0; i < numDBMolDescrs; i++)
+            convert(dbMolDVDescrs[i], dbMolBSDescrs[i]);
+    }
+
+    return dbMolBSDescrs;
+}
+
+std::size_t ScreeningProcessor::getNumDatabaseMoleculeFingerprints() const
+{
+    return numDBMolDescrs;
+}
+
+bool ScreeningProcessor::initDatabaseQueries(std::size_t num_bits)
+{
+    auto bs_descr = !queryMolBSDescrs.empty();
+    auto num_query_mols = (bs_descr ? queryMolBSDescrs.size() : queryMolDVDescrs.size());
+    auto num_words = FingerprintDatabase::getNumWords(num_bits);
+    
+    dbQueryWords.clear();
+    dbQueryBitCounts.clear();
+    dbQueryOffsets.assign(1, 0);
+
+    for (std::size_t i = 0; i < num_query_mols; i++) {
+        auto num_query_mol_descrs = (bs_descr ? queryMolBSDescrs[i].size() : queryMolDVDescrs[i].size());
+
+        for (std::size_t j = 0; j < num_query_mol_descrs; j++) {
+            if (!bs_descr)
+                convert(queryMolDVDescrs[i][j], tmpBitSet);
+
+            auto& query_fp = (bs_descr ? queryMolBSDescrs[i][j] : tmpBitSet);
+
+            if (query_fp.size() != num_bits) {
+                error = "query molecule fingerprint size does not match the fingerprint size of the database";
+                return false;
+            }
+
+            dbQueryWords.resize(dbQueryWords.size() + num_words, 0);
+            dbQueryBitCounts.push_back(query_fp.count());
+
+            auto words = &dbQueryWords[dbQueryWords.size() - num_words];
+
+            for (auto k = query_fp.find_first(); k != CDPL::Util::BitSet::npos; k = query_fp.find_next(k))
+                words[k / 64] |= std::uint64_t(1) << (k % 64);
+        }
+
+        dbQueryOffsets.push_back(dbQueryBitCounts.size());
+    }
+
+    return true;
+}
+
+bool ScreeningProcessor::process(const FingerprintDatabase& db, std::size_t seg_idx, ScreeningMode mode, bool single_conf_srch, double score_cutoff)
+{
+    using namespace CDPL;
+
+    if (!callbackFunc) {
+        error = "result callback function not set";
+        return false;
+    }
+
+    auto& seg = db.getSegment(seg_idx);
+    auto num_rows = std::size_t(seg.numRows);
+    auto num_bits = db.getNumBits();
+    auto num_words = db.getNumWords();
+    auto num_query_descrs = dbQueryBitCounts.size();
+    auto bucket_starts = db.getBucketStarts(seg_idx);
+    auto row_indices = db.getRowIndices(seg_idx);
+    auto row_words = db.getRowWords(seg_idx);
+    auto prune = (score_cutoff >= 0.0 && scoringFunc.isMonotonicInCommonBitCount());
+
+    segmentScores.resize(num_query_descrs * num_rows);
+    commonBitCounts.resize(num_rows);
+
+    // the score table gets filled bucket-wise, rows of buckets that cannot reach the score cutoff get
+    // assigned the (insufficient) best possible score of the bucket
+
+    for (std::size_t i = 0; i < num_query_descrs; i++) {
+        auto query_bit_count = dbQueryBitCounts[i];
+        auto query_words = &dbQueryWords[i * num_words];
+        auto scores = &segmentScores[i * num_rows];
+
+        for (std::size_t j = 0; j <= num_bits; j++) {
+            std::size_t bucket_start = bucket_starts[j];
+            std::size_t bucket_end = bucket_starts[j + 1];
+
+            if (bucket_start == bucket_end)
+                continue;
+
+            if (prune) {
+                auto max_score = scoringFunc.calculate(query_bit_count, j, std::min(query_bit_count, j), num_bits);
+
+                if (scoringFunc.compare(max_score, score_cutoff)) {
+                    for (auto k = bucket_start; k < bucket_end; k++)
+                        scores[row_indices[k]] = max_score;
+
+                    continue;
+                }
+            }
+
+            Internal::popCountAnd(query_words, row_words + bucket_start * num_words, num_words, bucket_end - bucket_start, commonBitCounts.data());
+
+            for (auto k = bucket_start; k < bucket_end; k++)
+                scores[row_indices[k]] = scoringFunc.calculate(query_bit_count, j, commonBitCounts[k - bucket_start], num_bits);
+        }
+    }
+
+    for (std::size_t m = 0; m < seg.numMolecules; m++) {
+        auto& mol = db.getMolecule(seg.firstMolecule + m);
+        auto row_offs = std::size_t(mol.firstRow - seg.firstRow);
+
+        getResults(dbQueryOffsets.size() - 1,
+                   [this](std::size_t i) { return (dbQueryOffsets[i + 1] - dbQueryOffsets[i]); },
+                   mol.numRows,
+                   [this, num_rows, row_offs](std::size_t i, std::size_t j, std::size_t k) {
+                       return segmentScores[(dbQueryOffsets[i] + j) * num_rows + row_offs + k];
+                   },
+                   mode, single_conf_srch, seg.firstMolecule + m);
+    }
+
+    return true;
+}
+
+template <typename NumQueryMolDescrsFunc, typename ScoreFunc>
+void ScreeningProcessor::getResults(std::size_t num_query_mols, const NumQueryMolDescrsFunc& num_query_mol_descrs, std::size_t num_db_mol_descrs,
+                                    const ScoreFunc& score_func, ScreeningMode mode, bool single_conf_srch, std::size_t db_mol_idx) const
 {
     Result best_result;
     auto have_res = false;
 
-    if (single_conf_srch) {
-        for (std::size_t k = 0, num_db_mol_descrs = db_mol_descr_list.size(); k < num_db_mol_descrs; k++) {
-            for (std::size_t i = 0, num_qery_mols = query_mol_descr_lists.size(); i < num_qery_mols; i++) {
-                auto& query_descr_list = query_mol_descr_lists[i];
+    best_result.dbMolIdx = db_mol_idx;
 
-                for (std::size_t j = 0, num_query_mol_descrs = query_descr_list.size(); j < num_query_mol_descrs; j++) {
-                    auto score = scoringFunc.calculate(query_descr_list[j], db_mol_descr_list[k]);
+    if (single_conf_srch) {
+        for (std::size_t k = 0; k < num_db_mol_descrs; k++) {
+            for (std::size_t i = 0; i < num_query_mols; i++) {
+                for (std::size_t j = 0, num_descrs = num_query_mol_descrs(i); j < num_descrs; j++) {
+                    auto score = score_func(i, j, k);
 
                     if (!have_res || scoringFunc.compare(best_result.score, score)) {
                         best_result.score           = score;
@@ -244,12 +388,10 @@ void ScreeningProcessor::getResults(const QueryMolDescrLists& query_mol_descr_li
         return;
     }
 
-    for (std::size_t i = 0, num_qery_mols = query_mol_descr_lists.size(); i < num_qery_mols; i++) {
-        auto& query_descr_list = query_mol_descr_lists[i];
-
-        for (std::size_t j = 0, num_query_mol_descrs = query_descr_list.size(); j < num_query_mol_descrs; j++) {
-            for (std::size_t k = 0, num_db_mol_descrs = db_mol_descr_list.size(); k < num_db_mol_descrs; k++) {
-                auto score = scoringFunc.calculate(query_descr_list[j], db_mol_descr_list[k]);
+    for (std::size_t i = 0; i < num_query_mols; i++) {
+        for (std::size_t j = 0, num_descrs = num_query_mol_descrs(i); j < num_descrs; j++) {
+            for (std::size_t k = 0; k < num_db_mol_descrs; k++) {
+                auto score = score_func(i, j, k);
 
                 if (!have_res || scoringFunc.compare(best_result.score, score)) {
                     best_result.score           = score;
@@ -26,6 +26,7 @@
 #define SIMSCREEN_SCREENINGPROCESSOR_HPP
 
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <vector>
@@ -50,6 +51,7 @@ namespace SimScreen
 
     class ScoringFunction;
     class DescriptorCalculator;
+    class FingerprintDatabase;
     
     class ScreeningProcessor
     {
@@ -62,6 +64,7 @@ namespace SimScreen
             std::size_t queryMolIdx{0};
             std::size_t queryMolConfIdx{0};
             std::size_t dbMolConfIdx{0};
+            std::size_t dbMolIdx{0};
         };
 
         enum ScreeningMode
@@ -73,6 +76,7 @@ namespace SimScreen
         };
 
         typedef std::function<void(const Result& res)> ResultCallbackFunc;
+        typedef std::vector<CDPL::Util::BitSet>       BitSetArray;
 
         ScreeningProcessor(const ScoringFunction& scr_func, const DescriptorCalculator& calc);
         
@@ -87,19 +91,30 @@ namespace SimScreen
 
         bool process(CDPL::Chem::Molecule& db_mol, ScreeningMode mode, bool single_conf_srch);
 
+        const BitSetArray& getDatabaseMoleculeFingerprints();
+
+        std::size_t getNumDatabaseMoleculeFingerprints() const;
+
+        bool initDatabaseQueries(std::size_t num_bits);
+
+        bool process(const FingerprintDatabase& db, std::size_t seg_idx, ScreeningMode mode, bool single_conf_srch, double score_cutoff);
+
       private:
-        template <typename QueryMolDescrLists, typename DBMolDescrList>
-        void getResults(const QueryMolDescrLists& query_mol_descr_lists, const DBMolDescrList& db_mol_descr_list,
-                        ScreeningMode mode, bool single_conf_srch) const;
+        template <typename NumQueryMolDescrsFunc, typename ScoreFunc>
+        void getResults(std::size_t num_query_mols, const NumQueryMolDescrsFunc& num_query_mol_descrs, std::size_t num_db_mol_descrs,
+                        const ScoreFunc& score_func, ScreeningMode mode, bool single_conf_srch, std::size_t db_mol_idx) const;
         
         static void convert(const CDPL::Util::BitSet& bset, CDPL::Math::DVector& vec);
         static void convert(const CDPL::Math::DVector& vec, CDPL::Util::BitSet& bset);
         
         typedef std::unique_ptr<DescriptorCalculator> DescriptorCalculatorPtr;
-        typedef std::vector<CDPL::Util::BitSet>       BitSetArray;
         typedef std::vector<CDPL::Math::DVector>      DVectorArray;
         typedef std::vector<BitSetArray>              BitSetArrayArray;
         typedef std::vector<DVectorArray>             DVectorArrayArray;
+        typedef std::vector<std::uint64_t>            WordArray;
+        typedef std::vector<std::uint32_t>            UInt32Array;
+        typedef std::vector<std::size_t>              SizeArray;
+        typedef std::vector<double>                   DoubleArray;
 
         const ScoringFunction&  scoringFunc;
         DescriptorCalculatorPtr descrCalculator;
@@ -109,8 +124,15 @@ namespace SimScreen
         DVectorArrayArray       queryMolDVDescrs;
         BitSetArray             dbMolBSDescrs;
         DVectorArray            dbMolDVDescrs;
+        std::size_t             numDBMolDescrs;
+        bool                    dbMolBSDescrsUsed;
         CDPL::Util::BitSet      tmpBitSet;
         CDPL::Math::DVector     tmpDVector;
+        WordArray               dbQueryWords;
+        SizeArray               dbQueryBitCounts;
+        SizeArray               dbQueryOffsets;
+        UInt32Array             commonBitCounts;
+        DoubleArray             segmentScores;
     };
 } // namespace SimScreen
 
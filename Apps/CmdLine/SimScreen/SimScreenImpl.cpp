@@ -35,6 +35,7 @@
 #include "CDPL/Chem/MolecularGraphFunctions.hpp"
 #include "CDPL/Chem/AtomContainerFunctions.hpp"
 #include "CDPL/Util/FileFunctions.hpp"
+#include "CDPL/Util/ControlParameterFunctions.hpp"
 #include "CDPL/Base/DataIOManager.hpp"
 #include "CDPL/Base/Exceptions.hpp"
 #include "CDPL/Internal/StringUtilities.hpp"
@@ -76,6 +77,11 @@ class SimScreenImpl::ScreeningWorker
     void operator()()
     {
         using namespace CDPL;
+
+        if (parent->fpDatabase.isOpen()) {
+            processFingerprintDatabase();
+            return;
+        }
         
         while (!terminate) {
             if (!molecule.unique())
@@ -84,9 +90,15 @@ class SimScreenImpl::ScreeningWorker
             if (!(dbMolIndex = parent->readNextMolecule(*molecule)))
                 return;
 
+            // hit output may rename the molecule, so its original name has to be saved
+
+            molName = getName(*molecule);
+
             try {
                 if (!screeningProc.process(*molecule, parent->screeningMode, parent->singleConfSearch))
                     parent->printMessage(ERROR, "Processing of database molecule " + parent->createMoleculeIdentifier(dbMolIndex, *molecule) + " failed: " + screeningProc.getError());
+                else if (parent->useFPDatabaseFiles)
+                    parent->addFingerprintDatabaseMolecule(dbMolIndex - 1, molName, screeningProc);
 
                 continue;
 
@@ -102,17 +114,56 @@ class SimScreenImpl::ScreeningWorker
     }
 
   private:
+    void processFingerprintDatabase()
+    {
+        while (!terminate) {
+            auto seg_idx = parent->getNextFingerprintDatabaseSegment();
+
+            if (!seg_idx)
+                return;
+
+            try {
+                if (!screeningProc.process(parent->fpDatabase, seg_idx - 1, parent->screeningMode, parent->singleConfSearch, parent->scoreCutoff))
+                    parent->printMessage(ERROR, "Processing of fingerprint database segment " + std::to_string(seg_idx) + " failed: " + screeningProc.getError());
+
+                continue;
+
+            } catch (const std::exception& e) {
+                parent->setErrorMessage("unexpected exception while processing fingerprint database segment " + std::to_string(seg_idx) + ": " + e.what());
+
+            } catch (...) {
+                parent->setErrorMessage("unexpected exception while processing fingerprint database segment " + std::to_string(seg_idx));
+            }
+
+            return;
+        }
+    }
+
     void processResult(const ScreeningProcessor::Result& res)
     {
         if (terminate)
             return;
 
-        terminate = !parent->processHit(dbMolIndex - 1, getName(*molecule), molecule, res);
+        if (!parent->fpDatabase.isOpen()) {
+            terminate = !parent->processHit(dbMolIndex - 1, molName, molecule, res);
+            return;
+        }
+
+        // avoid the construction of molecule names for results that will be rejected anyway
+        
+        if (parent->scoreCutoff >= 0.0 && parent->scoringFunc->compare(res.score, parent->scoreCutoff))
+            return;
+
+        // database molecules get read on output
+
+        terminate = !parent->processHit(parent->fpDatabase.getMolecule(res.dbMolIdx).recordIndex,
+                                        parent->fpDatabase.getMoleculeName(res.dbMolIdx), MoleculePtr(), res);
     }
 
     SimScreenImpl*     parent;
     ScreeningProcessor screeningProc;
     MoleculePtr        molecule;
+    std::string        molName;
     std::size_t        dbMolIndex;
     bool               terminate;
 };
@@ -121,9 +172,10 @@ class SimScreenImpl::ScreeningWorker
 SimScreenImpl::SimScreenImpl(): 
     numThreads(0), singleConfSearch(false), mergeHitLists(false), 
     splitOutFiles(true), outputQuery(true), scoreSDTags(true), queryNameSDTags(false), 
-    queryMolIdxSDTags(false), queryConfIdxSDTags(true), dbMolIdxSDTags(false), dbConfIdxSDTags(true),
-    hitNamePattern("@D@_@c@_@Q@_@C@"), numBestHits(1000), maxNumHits(0), scoreCutoff(-1.0), 
-    screeningMode(ScreeningProcessor::BEST_MATCH_PER_QUERY), numProcMols(0), numHits(0), numSavedHits(0)
+    queryMolIdxSDTags(false), queryConfIdxSDTags(true), dbMolIdxSDTags(false), dbConfIdxSDTags(true), useRecordIndexFiles(false),
+    useFPDatabaseFiles(false), hitNamePattern("@D@_@c@_@Q@_@C@"), numBestHits(1000), maxNumHits(0), scoreCutoff(-1.0), 
+    screeningMode(ScreeningProcessor::BEST_MATCH_PER_QUERY), fpDatabaseStamp(0), nextFPDatabaseSegment(0), databaseReadComplete(false),
+    numProcMols(0), numHits(0), numSavedHits(0)
 {
     initScoringFunctions();
     initDescriptorCalculators();
@@ -187,6 +239,12 @@ SimScreenImpl::SimScreenImpl():
               value<std::string>()->notifier([this](const std::string& fmt) { this->setDatabaseFormat(fmt); }));
     addOption("output-format,O", "Hit molecule output file format (default: auto-detect from file extension).", 
               value<std::string>()->notifier([this](const std::string& fmt) { this->setHitOutputFormat(fmt); }));
+    addOption("use-rec-index-files", "Store the record offsets of the scanned database file in an index file (<database file>.ridx) and reuse "
+              "them on subsequent runs to avoid rescanning an unchanged database file (default: false).", 
+              value<bool>(&useRecordIndexFiles)->implicit_value(true));
+    addOption("use-fp-db-files", "Store the fingerprints of the database molecules in a fingerprint database file (<database file>.<descriptor type>.fpdb) "
+              "and screen the memory-mapped file on subsequent runs instead of reading the database molecules (default: false).", 
+              value<bool>(&useFPDatabaseFiles)->implicit_value(true));
  
     addOptionLongDescriptions();
 
@@ -257,6 +315,16 @@ void SimScreenImpl::addOptionLongDescriptions()
 
     addOptionLongDescription("output", 
                              "Hit molecule output file.\n\n" + formats_str);
+
+    addOptionLongDescription("use-fp-db-files",
+                             "If enabled, the fingerprints calculated for the database molecules are stored in a binary fingerprint "
+                             "database file next to the database file (<database file>.<descriptor type>.fpdb) after the database "
+                             "has been screened completely. On subsequent runs with the same descriptor settings the file gets "
+                             "memory-mapped and screened instead of reading the database molecules and recalculating their "
+                             "fingerprints. Only hit molecules are read from the database file on output. Within the file, "
+                             "fingerprints are ordered by their number of set bits so that, when a score cutoff is specified, whole "
+                             "groups of fingerprints that cannot reach the cutoff are skipped. The file is automatically rebuilt "
+                             "when the database file or the descriptor settings have changed.");
 }
 
 void SimScreenImpl::setScoringFunction(const std::string& id)
@@ -336,6 +404,7 @@ int SimScreenImpl::process()
         return EXIT_FAILURE;
 
     readQueryMolecules();
+    initFingerprintDatabase();
     initReportFileStreams();
     initHitMoleculeWriters();
     initHitLists();
@@ -359,6 +428,7 @@ int SimScreenImpl::process()
     if (termSignalCaught())
         return EXIT_FAILURE;
 
+    writeFingerprintDatabase();
     outputHitLists();
 
     if (termSignalCaught())
@@ -504,6 +574,120 @@ void SimScreenImpl::readQueryMolecules()
     printMessage(INFO, "");
 }
 
+void SimScreenImpl::initFingerprintDatabase()
+{
+    using namespace CDPL;
+
+    if (!useFPDatabaseFiles || termSignalCaught())
+        return;
+
+    if (descrCalculator->getDescriptorType() != DescriptorCalculator::BITSET) {
+        printMessage(ERROR, "Fingerprint database files are not supported for descriptor type " + descrCalculator->getID());
+        printMessage(INFO, "");
+        return;
+    }
+
+    fpDatabasePath  = databaseFile + '.' + boost::to_lower_copy(descrCalculator->getID()) + ".fpdb";
+    fpDatabaseStamp = Util::calcFileStamp(databaseFile);
+    fpDatabaseSpec  = descrCalculator->getID() + ';';
+
+    descrCalculator->getOptionSummary(fpDatabaseSpec);
+
+    if (!fpDatabase.open(fpDatabasePath, fpDatabaseStamp, fpDatabaseSpec)) {
+        fpDatabaseBuilder.reset(new FingerprintDatabaseBuilder());
+        return;
+    }
+
+    if (!screeningProc->initDatabaseQueries(fpDatabase.getNumBits())) {
+        printMessage(ERROR, "Fingerprint database file '" + fpDatabasePath + "' cannot be used: " + screeningProc->getError());
+        printMessage(INFO, "");
+
+        fpDatabase.close();
+        return;
+    }
+
+    printMessage(INFO, "Using fingerprint database file '" + fpDatabasePath + "' (" + std::to_string(fpDatabase.getNumMolecules()) + " molecule(s))");
+    printMessage(INFO, "");
+}
+
+std::size_t SimScreenImpl::getNextFingerprintDatabaseSegment()
+{
+    if (termSignalCaught())
+        return 0;
+
+    if (haveErrorMessage())
+        return 0;
+
+    std::unique_lock<std::mutex> lock(molReadMutex, std::defer_lock);
+
+    if (numThreads > 0)
+        lock.lock();
+
+    if (nextFPDatabaseSegment >= fpDatabase.getNumSegments()) {
+        printInfiniteProgress("Screening Molecules (" + std::to_string(numProcMols) + " passed)", true);
+        return 0;
+    }
+
+    numProcMols += fpDatabase.getSegment(nextFPDatabaseSegment).numMolecules;
+
+    printInfiniteProgress("Screening Molecules (" + std::to_string(numProcMols) + " passed)", nextFPDatabaseSegment == 0);
+
+    return ++nextFPDatabaseSegment;
+}
+
+void SimScreenImpl::addFingerprintDatabaseMolecule(std::size_t rec_idx, const std::string& name, ScreeningProcessor& proc)
+{
+    auto& fps = proc.getDatabaseMoleculeFingerprints();
+    std::unique_lock<std::mutex> lock(fpDatabaseMutex, std::defer_lock);
+
+    if (numThreads > 0)
+        lock.lock();
+
+    if (!fpDatabaseBuilder)
+        return;
+
+    if (fpDatabaseBuilder->addMolecule(rec_idx, name, fps, proc.getNumDatabaseMoleculeFingerprints()))
+        return;
+
+    printMessage(ERROR, "Fingerprint database file will not be written: database molecule fingerprints differ in size");
+
+    fpDatabaseBuilder.reset();
+}
+
+void SimScreenImpl::writeFingerprintDatabase()
+{
+    if (!fpDatabaseBuilder || !databaseReadComplete || fpDatabaseBuilder->getNumMolecules() == 0)
+        return;
+
+    printMessage(VERBOSE, "");
+
+    if (!fpDatabaseBuilder->write(fpDatabasePath, fpDatabaseStamp, fpDatabaseSpec))
+        printMessage(ERROR, "Writing fingerprint database file '" + fpDatabasePath + "' failed");
+    else
+        printMessage(VERBOSE, "Wrote fingerprint database file '" + fpDatabasePath + '\'');
+
+    fpDatabaseBuilder.reset();
+}
+
+SimScreenImpl::MoleculePtr SimScreenImpl::readDatabaseMolecule(std::size_t rec_idx)
+{
+    using namespace CDPL;
+
+    MoleculePtr mol(new Chem::BasicMolecule());
+
+    try {
+        if (databaseReader->read(rec_idx, *mol)) {
+            descrCalculator->prepare(*mol);
+            return mol;
+        }
+
+    } catch (const std::exception& e) {
+        throw Base::IOError("reading database molecule " + createMoleculeIdentifier(rec_idx + 1) + " failed: " + e.what());
+    }
+
+    throw Base::IOError("reading database molecule " + createMoleculeIdentifier(rec_idx + 1) + " failed");
+}
+
 void SimScreenImpl::initHitLists()
 {
     hitLists.resize(mergeHitLists ? 1 : queryMolecules.size(),
@@ -723,6 +907,8 @@ void SimScreenImpl::outputHitMolecule(CDPL::Chem::MolecularGraphWriter& writer,
     if (reportFile.empty())
         numSavedHits++;
 
+    auto db_mol = (hit_data.dbMolecule ? hit_data.dbMolecule : readDatabaseMolecule(hit_data.dbMolIndex));
+
     try {
         auto name = hitNamePattern;
 
@@ -733,10 +919,10 @@ void SimScreenImpl::outputHitMolecule(CDPL::Chem::MolecularGraphWriter& writer,
         boost::replace_all(name, "@I@", std::to_string(hit_data.screeningResult.queryMolIdx + 1));
         boost::replace_all(name, "@i@", std::to_string(hit_data.dbMolIndex + 1));
 
-        setName(*hit_data.dbMolecule, name);
+        setName(*db_mol, name);
 
         if (descrCalculator->requires3DCoordinates())
-            applyConformation(*hit_data.dbMolecule, hit_data.screeningResult.dbMolConfIdx);
+            applyConformation(*db_mol, hit_data.screeningResult.dbMolConfIdx);
 
         setMultiConfExportParameter(writer, false);
 
@@ -744,8 +930,8 @@ void SimScreenImpl::outputHitMolecule(CDPL::Chem::MolecularGraphWriter& writer,
             Chem::StringDataBlock::SharedPointer old_sd_block;
             Chem::StringDataBlock::SharedPointer new_sd_block;
 
-            if (hasStructureData(*hit_data.dbMolecule)) {
-                old_sd_block = getStructureData(*hit_data.dbMolecule);
+            if (hasStructureData(*db_mol)) {
+                old_sd_block = getStructureData(*db_mol);
                 new_sd_block.reset(new Chem::StringDataBlock(*old_sd_block));
 
             } else
@@ -769,27 +955,27 @@ void SimScreenImpl::outputHitMolecule(CDPL::Chem::MolecularGraphWriter& writer,
             if (scoreSDTags)
                 new_sd_block->addEntry('<' + scoringFunc->getDisplayName() + '>', (boost::format("%.3f") % hit_data.screeningResult.score).str());
 
-            setStructureData(*hit_data.dbMolecule, new_sd_block);
-            perceiveComponents(*hit_data.dbMolecule, false);
+            setStructureData(*db_mol, new_sd_block);
+            perceiveComponents(*db_mol, false);
             
-            if (writer.write(*hit_data.dbMolecule)) {
+            if (writer.write(*db_mol)) {
                 if (old_sd_block)
-                    setStructureData(*hit_data.dbMolecule, old_sd_block);
+                    setStructureData(*db_mol, old_sd_block);
                 else
-                    clearStructureData(*hit_data.dbMolecule);
+                    clearStructureData(*db_mol);
 
                 return;
             }
 
-        } else if (writer.write(*hit_data.dbMolecule))
+        } else if (writer.write(*db_mol))
             return;
 
     } catch (const std::exception& e) {
-        throw CDPL::Base::IOError("writing hit molecule " + createMoleculeIdentifier(hit_data.dbMolIndex + 1, *hit_data.dbMolecule) + " failed: " + e.what());
+        throw CDPL::Base::IOError("writing hit molecule " + createMoleculeIdentifier(hit_data.dbMolIndex + 1, *db_mol) + " failed: " + e.what());
 
     } catch (...) {}
 
-    throw CDPL::Base::IOError("unspecified error while writing hit molecule " + createMoleculeIdentifier(hit_data.dbMolIndex + 1, *hit_data.dbMolecule));
+    throw CDPL::Base::IOError("unspecified error while writing hit molecule " + createMoleculeIdentifier(hit_data.dbMolIndex + 1, *db_mol));
 }
 
 void SimScreenImpl::setErrorMessage(const std::string& msg)
@@ -830,6 +1016,7 @@ std::size_t SimScreenImpl::doReadNextMolecule(CDPL::Chem::Molecule& mol)
         try {
             if (!databaseReader->read(mol)) {
                 printInfiniteProgress("Screening Molecules (" + std::to_string(numProcMols) + " passed)", true);
+                databaseReadComplete = true;
                 return 0;
             }
 
@@ -955,6 +1142,8 @@ void SimScreenImpl::printOptionSummary()
     printMessage(VERBOSE, " Output Query Conf. Index SD-Tags:    " + std::string(queryConfIdxSDTags ? "Yes" : "No"));
     printMessage(VERBOSE, " Output Database Mol. Index SD-Tags:  " + std::string(dbMolIdxSDTags ? "Yes" : "No"));
     printMessage(VERBOSE, " Output Database Conf. Index SD-Tags: " + std::string(dbConfIdxSDTags ? "Yes" : "No"));
+    printMessage(VERBOSE, " Use Record Index Files:              " + std::string(useRecordIndexFiles ? "Yes" : "No"));
+    printMessage(VERBOSE, " Use Fingerprint Database Files:      " + std::string(useFPDatabaseFiles ? "Yes" : "No"));
     printMessage(VERBOSE, " Hit Output Mol. Name Pattern:        " + hitNamePattern);
     printMessage(VERBOSE, " Multithreading:                      " + std::string(numThreads > 0 ? "Yes" : "No"));
 
@@ -1021,6 +1210,7 @@ void SimScreenImpl::initDatabaseReader()
     }
    
     setMultiConfImportParameter(*databaseReader, true);
+    Util::setUseRecordIndexFilesParameter(*databaseReader, useRecordIndexFiles);
 }
 
 void SimScreenImpl::initScoringFunctions()
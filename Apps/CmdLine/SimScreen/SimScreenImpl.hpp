@@ -26,6 +26,7 @@
 #define SIMSCREEN_SIMSCREENIMPL_HPP
 
 #include <cstddef>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include <set>
@@ -43,6 +44,8 @@
 #include "CmdLine/Lib/CmdLineBase.hpp"
 
 #include "ScreeningProcessor.hpp"
+#include "FingerprintDatabase.hpp"
+#include "FingerprintDatabaseBuilder.hpp"
 
 
 namespace SimScreen
@@ -103,6 +106,7 @@ namespace SimScreen
         void initHitMoleculeWriters();
         void initScoringFunctions();
         void initDescriptorCalculators();
+        void initFingerprintDatabase();
 
         int process();
 
@@ -116,6 +120,12 @@ namespace SimScreen
 
         void readQueryMolecules();
 
+        std::size_t getNextFingerprintDatabaseSegment();
+        void addFingerprintDatabaseMolecule(std::size_t rec_idx, const std::string& name, ScreeningProcessor& proc);
+        void writeFingerprintDatabase();
+
+        MoleculePtr readDatabaseMolecule(std::size_t rec_idx);
+
         void outputHitLists();
         void outputReportFiles();
         void outputHitMoleculeFiles();
@@ -162,6 +172,7 @@ namespace SimScreen
         typedef boost::ptr_vector<DescriptorCalculator>                                                              DescriptorCalculatorList;
         typedef CDPL::Internal::Timer                                                                                Timer;
         typedef std::unique_ptr<ScreeningProcessor>                                                                  ScreeningProcessorPtr;
+        typedef std::unique_ptr<FingerprintDatabaseBuilder>                                                          FingerprintDatabaseBuilderPtr;
         
         std::string                       queryFile;
         std::string                       databaseFile;
@@ -181,6 +192,8 @@ namespace SimScreen
         bool                              queryConfIdxSDTags;
         bool                              dbMolIdxSDTags;
         bool                              dbConfIdxSDTags;
+        bool                              useRecordIndexFiles;
+        bool                              useFPDatabaseFiles;
         std::string                       hitNamePattern;
         std::size_t                       numBestHits;
         std::size_t                       maxNumHits;
@@ -197,6 +210,13 @@ namespace SimScreen
         MoleculeWriterArray               hitMolWriters;
         ScoringFunctionList               scoringFuncs;
         DescriptorCalculatorList          descrCalculators;
+        FingerprintDatabase               fpDatabase;
+        FingerprintDatabaseBuilderPtr     fpDatabaseBuilder;
+        std::string                       fpDatabasePath;
+        std::string                       fpDatabaseSpec;
+        std::uint64_t                     fpDatabaseStamp;
+        std::size_t                       nextFPDatabaseSegment;
+        bool                              databaseReadComplete;
         Timer                             timer;
         std::size_t                       numProcMols;
         std::size_t                       numHits;
@@ -204,6 +224,7 @@ namespace SimScreen
         std::mutex                        mutex;
         std::mutex                        molReadMutex;
         std::mutex                        hitProcMutex;
+        std::mutex                        fpDatabaseMutex;
         std::string                       errorMessage;
     };
 } // namespace SimScreen
@@ -41,3 +41,9 @@ double TanimotoSimilarity::calculate(const CDPL::Math::DVector& query_descr, con
 {
     return CDPL::Descr::calcTanimotoSimilarity(query_descr, db_mol_descr);
 }
+
+double TanimotoSimilarity::calculate(std::size_t query_fp_bit_count, std::size_t db_mol_fp_bit_count, std::size_t common_bit_count,
+                                     std::size_t fp_size) const
+{
+    return (double(common_bit_count) / (query_fp_bit_count + db_mol_fp_bit_count - common_bit_count));
+}
@@ -65,3 +65,17 @@ double TverskySimilarity::calculate(const CDPL::Math::DVector& query_descr, cons
 {
     return -1.0;
 }
+
+double TverskySimilarity::calculate(std::size_t query_fp_bit_count, std::size_t db_mol_fp_bit_count, std::size_t common_bit_count,
+                                    std::size_t fp_size) const
+{
+    std::size_t oa = query_fp_bit_count - common_bit_count;
+    std::size_t ob = db_mol_fp_bit_count - common_bit_count;
+
+    return (double(common_bit_count) / (weightA * oa + weightB * ob + common_bit_count));
+}
+
+bool TverskySimilarity::isMonotonicInCommonBitCount() const
+{
+    return (weightA >= 0.0 && weightB >= 0.0);
+}
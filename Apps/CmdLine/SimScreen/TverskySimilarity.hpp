@@ -45,6 +45,11 @@ namespace SimScreen
 
         double calculate(const CDPL::Math::DVector& query_descr, const CDPL::Math::DVector& db_mol_descr) const;
 
+        double calculate(std::size_t query_fp_bit_count, std::size_t db_mol_fp_bit_count, std::size_t common_bit_count,
+                         std::size_t fp_size) const;
+
+        bool isMonotonicInCommonBitCount() const;
+
       private:
         double weightA{1.0};
         double weightB{0.0};
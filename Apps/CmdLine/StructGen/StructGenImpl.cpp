@@ -1193,21 +1193,12 @@ void StructGenImpl::loadFragmentLibrary()
     if (fragmentLibName.empty())
         return;
 
-    std::ifstream is(fragmentLibName);
-
-    if (!is) 
-        throw Base::IOError("opening fragment library '" + fragmentLibName + "' failed");
-
     printMessage(INFO, "Loading Fragment Library '" + fragmentLibName + "'...");
 
-    fragmentLib.reset(new FragmentLibrary());
-    fragmentLib->load(is);
+    // entries get decoded on demand from the memory-mapped file
 
-    if (StructGenImpl::termSignalCaught())
-        return;
-
-    if (!is)
-        throw Base::IOError("loading fragment library '" + fragmentLibName + "' failed");
+    fragmentLib.reset(new FragmentLibrary());
+    fragmentLib->mapFile(fragmentLibName);
 
     printMessage(INFO, " - Loaded " + std::to_string(fragmentLib->getNumEntries()) + " fragments");
     printMessage(INFO, "");
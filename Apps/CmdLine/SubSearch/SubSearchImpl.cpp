@@ -25,12 +25,15 @@
 #include <algorithm>
 #include <chrono>
 #include <iterator>
+#include <thread>
+#include <functional>
 
 #include "CDPL/Chem/BasicMolecule.hpp"
 #include "CDPL/Chem/ControlParameterFunctions.hpp"
 #include "CDPL/Chem/MolecularGraphFunctions.hpp"
 #include "CDPL/Chem/UtilityFunctions.hpp"
 #include "CDPL/Chem/MultiSubstructureSearch.hpp"
+#include "CDPL/Chem/SubstructureScreeningKeyGenerator.hpp"
 #include "CDPL/Chem/MoleculeReader.hpp"
 #include "CDPL/Util/FileFunctions.hpp"
 #include "CDPL/Base/DataIOManager.hpp"
@@ -44,6 +47,14 @@
 using namespace SubSearch;
 
 
+namespace
+{
+
+    constexpr std::size_t MOLECULE_CHUNK_SIZE               = 8;
+    constexpr std::size_t MAX_NUM_PENDING_CHUNKS_PER_THREAD = 4;
+}
+
+
 class SubSearchImpl::InputScanProgressCallback
 {
 
@@ -78,7 +89,7 @@ public:
         try {
             init();
     
-            while (processNextMolecule());
+            while (processNextChunk());
     
         } catch (const std::exception& e) {
             parent->setErrorMessage(std::string("unexpected exception while performing substructure matching: ") + e.what());
@@ -95,52 +106,72 @@ private:
 
         subSearch.setup(parent->matchExpression);
     }
-    
-    bool processNextMolecule() {
-        using namespace CDPL;
-        
-        auto rec_idx = parent->readNextMolecule(molecule);
 
-        if (!rec_idx)
+    bool processNextChunk() {
+        auto chunk = parent->readNextChunk(subSearch);
+
+        if (!chunk)
             return false;
 
-        auto orig_mol_name = getName(molecule);
+        for (std::size_t i = 0; i < chunk->numRecords; i++)
+            if (!processMolecule(chunk->records[i]))
+                return false;
+
+        try {
+            parent->outputChunk(chunk);
+            return true;
+
+        } catch (const std::exception& e) {
+            parent->setErrorMessage(std::string("unexpected exception while writing output molecules: ") + e.what());
+
+        } catch (...) {
+            parent->setErrorMessage("unexpected exception while writing output molecules");
+        }
+
+        return false;
+    }
+
+    bool processMolecule(MoleculeRecord& rec) {
+        using namespace CDPL;
+
+        auto& molecule = *rec.molecule;
+
+        rec.molName = getName(molecule);
 
         try {
             Chem::initSubstructureSearchTarget(molecule, false);
 
-            if (subSearch.matches(molecule)) {
-                parent->writeMolecule(molecule, true);
-                parent->printMessage(VERBOSE, "Molecule " + parent->createMoleculeIdentifier(rec_idx, orig_mol_name) + ": match");
-                
-            } else {
-                parent->writeMolecule(molecule, false);
-                parent->printMessage(VERBOSE, "Molecule " + parent->createMoleculeIdentifier(rec_idx, orig_mol_name) + ": no match");
+            if (!rec.haveKeys) {
+                keyGenerator.generate(molecule, rec.screeningKeys);
+
+                if (parent->useScreeningIndex)
+                    parent->storeScreeningKeys(rec.recordIndex - 1, rec.screeningKeys);
             }
-            
-            parent->numProcMols++;
+
+            rec.match = subSearch.matches(molecule, rec.screeningKeys);
             return true;
 
         } catch (const std::exception& e) {
-            parent->setErrorMessage("unexpected exception while processing molecule " + parent->createMoleculeIdentifier(rec_idx, orig_mol_name) + ": " + e.what());
+            parent->setErrorMessage("unexpected exception while processing molecule " + parent->createMoleculeIdentifier(rec.recordIndex, rec.molName) + ": " + e.what());
 
         } catch (...) {
-            parent->setErrorMessage("unexpected exception while processing molecule " + parent->createMoleculeIdentifier(rec_idx, orig_mol_name));
+            parent->setErrorMessage("unexpected exception while processing molecule " + parent->createMoleculeIdentifier(rec.recordIndex, rec.molName));
         }
 
         return false;
     }
 
-    SubSearchImpl*                      parent;
-    CDPL::Chem::MultiSubstructureSearch subSearch;
-    CDPL::Chem::BasicMolecule           molecule;
+    SubSearchImpl*                                parent;
+    CDPL::Chem::MultiSubstructureSearch           subSearch;
+    CDPL::Chem::SubstructureScreeningKeyGenerator keyGenerator;
 };
 
 
 SubSearchImpl::SubSearchImpl(): 
     nonMatchingOutFile(), matchExpression(), inputFormat(), matchingOutFormat(),
-    nonMatchingOutFormat(), matchingWriter(), nonMatchingWriter(), numProcMols(0),
-    numMatches(0)
+    nonMatchingOutFormat(), useScreeningIndex(false), numThreads(0), unorderedOutput(false), matchingWriter(),
+    nonMatchingWriter(), chunkSize(1), nextChunkIndex(0), nextOutputChunkIndex(0), numProcMols(0), numMatches(0),
+    numScreenedOut(0)
 {
     addOption("input,i", "Molecule input file(s).", 
               value<StringList>(&inputFiles)->multitoken()->required());
@@ -158,6 +189,16 @@ SubSearchImpl::SubSearchImpl():
               value<StringList>(&substrSMARTSPatterns)->multitoken()->required());
     addOption("match-expr,e", "Substructure matching expression (default: one of the spec. patterns has to match).", 
               value<std::string>(&matchExpression));
+    addOption("use-screening-index,x", "Store substructure screening keys of the input molecules in index files (<input file>.ssidx) "
+              "and use them on subsequent runs to skip molecules that cannot match (default: false).", 
+              value<bool>(&useScreeningIndex)->implicit_value(true));
+    addOption("num-threads,t", "Number of parallel execution threads (default: no multithreading, implicit value: " +
+              std::to_string(std::thread::hardware_concurrency()) + 
+              " threads, must be >= 0, 0 disables multithreading).", 
+              value<std::size_t>(&numThreads)->implicit_value(std::thread::hardware_concurrency()));
+    addOption("unordered-output,u", "Write output molecules as soon as they have been processed instead of preserving "
+              "the order of the input molecules (only effective in multithreaded mode, default: false).", 
+              value<bool>(&unorderedOutput)->implicit_value(true));
     addOptionLongDescriptions();
 }
 
@@ -189,6 +230,22 @@ void SubSearchImpl::addOptionLongDescriptions()
                              "The numeric id of a pattern corresponds to its position in the argument list of option -s.\n\n"
                              "Example: -e '!(1&(2^3)) | 4'");
 
+    addOptionLongDescription("use-screening-index",
+                             "If enabled, a compact set of substructure screening keys (encoding atom types, bonded atom type pairs and "
+                             "atom type paths of length two) gets calculated for each input molecule and stored in an index file "
+                             "next to the input file (<input file>.ssidx) after the file has been processed completely. "
+                             "On subsequent runs the index file gets memory-mapped and molecules whose keys prove that the match "
+                             "expression cannot be satisfied are skipped without being read (unless a non-matching molecule output "
+                             "file was specified). For all other molecules the keys are used to avoid substructure searches for "
+                             "patterns that cannot match. Index files are automatically rebuilt when the input file has changed.");
+
+    addOptionLongDescription("num-threads",
+                             "Number of parallel execution threads (default: no multithreading, implicit value: number of CPUs, "
+                             "must be >= 0, 0 disables multithreading). Each thread owns its own "
+                             "set of initialized substructure search objects and fetches the input molecules in chunks of " +
+                             std::to_string(MOLECULE_CHUNK_SIZE) + " molecules. Unless option --unordered-output is specified, "
+                             "processed chunks are buffered and written in the order of the input molecules.");
+
     StringList formats;
     std::string formats_str = "Supported Input Formats:";
 
@@ -308,9 +365,12 @@ int SubSearchImpl::process()
 
 void SubSearchImpl::findMatches()
 {
-    using namespace CDPL;
+    if (numThreads > 0) {
+        chunkSize = MOLECULE_CHUNK_SIZE;
+        processMultiThreaded();
 
-    SubSearchWorker(this)();
+    } else
+        processSingleThreaded();
 
     printMessage(INFO, "");
 
@@ -320,17 +380,76 @@ void SubSearchImpl::findMatches()
     if (termSignalCaught())
         return;
 
+    if (useScreeningIndex) {
+        writeScreeningIndices();
+        printMessage(VERBOSE, "");
+    }
+
     printStatistics();
 }
 
+void SubSearchImpl::processSingleThreaded()
+{
+    SubSearchWorker(this)();
+}
+
+void SubSearchImpl::processMultiThreaded()
+{
+    typedef std::shared_ptr<SubSearchWorker> SubSearchWorkerPtr;
+    typedef std::vector<std::thread> ThreadGroup;
+    
+    ThreadGroup thread_grp;
+
+    try {
+        for (std::size_t i = 0; i < numThreads; i++) {
+            if (termSignalCaught())
+                break;
+
+            SubSearchWorkerPtr worker_ptr(new SubSearchWorker(this));
+
+            thread_grp.emplace_back(std::bind(&SubSearchWorker::operator(), worker_ptr));
+        }
+
+    } catch (const std::exception& e) {
+        setErrorMessage(std::string("error while creating worker-threads: ") + e.what());
+
+    } catch (...) {
+        setErrorMessage("unspecified error while creating worker-threads");
+    }
+
+    try {
+        for (auto& thread : thread_grp)
+            thread.join();
+
+    } catch (const std::exception& e) {
+        setErrorMessage(std::string("error while waiting for worker-threads to finish: ") + e.what());
+
+    } catch (...) {
+        setErrorMessage("unspecified error while waiting for worker-threads to finish");
+    }
+}
+
 void SubSearchImpl::setErrorMessage(const std::string& msg)
 {
+    if (numThreads > 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (errorMessage.empty())
+            errorMessage = msg;
+        return;
+    }
+
     if (errorMessage.empty())
         errorMessage = msg;
 }
 
 bool SubSearchImpl::haveErrorMessage()
 {
+    if (numThreads > 0) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return !errorMessage.empty();
+    }
+
     return !errorMessage.empty();
 }
 
@@ -339,13 +458,55 @@ void SubSearchImpl::printStatistics()
     std::size_t proc_time = std::chrono::duration_cast<std::chrono::seconds>(timer.elapsed()).count();
     
     printMessage(INFO, "Statistics:");
-    printMessage(INFO, " Processed Molecules: " + std::to_string(numProcMols));
+    printMessage(INFO, " Processed Molecules: " + std::to_string(numProcMols + numScreenedOut));
     printMessage(INFO, " Matching Molecules:  " + std::to_string(numMatches));
+
+    if (useScreeningIndex)
+        printMessage(INFO, " Screened Out:        " + std::to_string(numScreenedOut));
+
     printMessage(INFO, " Processing Time:     " + CmdLineLib::formatTimeDuration(proc_time));
     printMessage(INFO, "");
 }
 
-std::size_t SubSearchImpl::readNextMolecule(CDPL::Chem::Molecule& mol)
+SubSearchImpl::MoleculeChunkPtr SubSearchImpl::readNextChunk(CDPL::Chem::MultiSubstructureSearch& sub_search)
+{
+    using namespace CDPL;
+
+    auto chunk = allocChunk();
+
+    if (!chunk)
+        return chunk;
+
+    std::unique_lock<std::mutex> lock(readMolMutex, std::defer_lock);
+
+    if (numThreads > 0)
+        lock.lock();
+
+    for (chunk->numRecords = 0; chunk->numRecords < chunkSize; chunk->numRecords++) {
+        if (chunk->records.size() == chunk->numRecords)
+            chunk->records.emplace_back();
+
+        auto& rec = chunk->records[chunk->numRecords];
+
+        if (!rec.molecule)
+            rec.molecule.reset(new Chem::BasicMolecule());
+
+        rec.recordIndex = readNextMolecule(*rec.molecule, sub_search, rec.screeningKeys, rec.haveKeys);
+
+        if (!rec.recordIndex)
+            break;
+    }
+
+    if (chunk->numRecords == 0)
+        return MoleculeChunkPtr();
+
+    chunk->index = nextChunkIndex++;
+
+    return chunk;
+}
+
+std::size_t SubSearchImpl::readNextMolecule(CDPL::Chem::Molecule& mol, CDPL::Chem::MultiSubstructureSearch& sub_search,
+                                            CDPL::Util::BitSet& keys, bool& have_keys)
 {
     if (termSignalCaught())
         return 0;
@@ -357,9 +518,22 @@ std::size_t SubSearchImpl::readNextMolecule(CDPL::Chem::Molecule& mol)
         try {
             printProgress("Searching for Matches... ", double(inputReader.getRecordIndex()) / inputReader.getNumRecords());
 
-            if (inputReader.getRecordIndex() >= inputReader.getNumRecords()) 
+            auto rec_idx = inputReader.getRecordIndex();
+
+            if (rec_idx >= inputReader.getNumRecords()) 
                 return 0;
 
+            have_keys = (useScreeningIndex && getScreeningKeys(rec_idx, keys));
+
+            if (have_keys && !nonMatchingWriter && !sub_search.screen(keys)) {
+                printMessage(VERBOSE, "Molecule " + createMoleculeIdentifier(rec_idx + 1) + ": no match (screened out)");
+
+                numScreenedOut++;
+
+                inputReader.setRecordIndex(rec_idx + 1);
+                continue;
+            }
+
             if (!inputReader.read(mol)) {
                 printMessage(ERROR, "Reading molecule " + createMoleculeIdentifier(inputReader.getRecordIndex() + 1) + " failed");            
                 
@@ -382,6 +556,130 @@ std::size_t SubSearchImpl::readNextMolecule(CDPL::Chem::Molecule& mol)
     return 0;
 }
 
+bool SubSearchImpl::getScreeningKeys(std::size_t rec_idx, CDPL::Util::BitSet& keys)
+{
+    auto it = std::upper_bound(screeningIndices.begin(), screeningIndices.end(), rec_idx,
+                               [](std::size_t idx, const ScreeningIndexDataPtr& data) {
+                                   return (idx < data->startRecordIndex);
+                               });
+
+    if (it == screeningIndices.begin())
+        return false;
+
+    auto& data = **(--it);
+
+    if (!data.index.isOpen() || (rec_idx - data.startRecordIndex) >= data.numRecords)
+        return false;
+
+    data.index.getKeys(rec_idx - data.startRecordIndex, keys);
+    return true;
+}
+
+void SubSearchImpl::storeScreeningKeys(std::size_t rec_idx, const CDPL::Util::BitSet& keys)
+{
+    using namespace CDPL;
+
+    auto it = std::upper_bound(screeningIndices.begin(), screeningIndices.end(), rec_idx,
+                               [](std::size_t idx, const ScreeningIndexDataPtr& data) {
+                                   return (idx < data->startRecordIndex);
+                               });
+
+    if (it == screeningIndices.begin())
+        return;
+
+    auto& data = **(--it);
+
+    if (data.index.isOpen() || (rec_idx - data.startRecordIndex) >= data.numRecords)
+        return;
+
+    Chem::SubstructureScreeningIndex::packKeys(keys, &data.keyWords[(rec_idx - data.startRecordIndex) *
+                                                                     Chem::SubstructureScreeningIndex::getNumWords(keys.size())]);
+}
+
+void SubSearchImpl::writeScreeningIndices()
+{
+    using namespace CDPL;
+
+    for (auto& data_ptr : screeningIndices) {
+        if (data_ptr->index.isOpen() || data_ptr->numRecords == 0)
+            continue;
+
+        if (!Chem::SubstructureScreeningIndex::write(data_ptr->path, data_ptr->sourceStamp,
+                                                     Chem::SubstructureScreeningKeyGenerator::DEF_NUM_BITS,
+                                                     data_ptr->keyWords.data(), data_ptr->numRecords))
+            printMessage(ERROR, "Writing screening index file '" + data_ptr->path + "' failed");
+        else
+            printMessage(VERBOSE, "Wrote screening index file '" + data_ptr->path + '\'');
+    }
+}
+
+SubSearchImpl::MoleculeChunkPtr SubSearchImpl::allocChunk()
+{
+    std::unique_lock<std::mutex> lock(writeMolMutex, std::defer_lock);
+
+    if (numThreads > 0) {
+        lock.lock();
+
+        // bound the number of buffered chunks waiting for a preceding chunk that is still in progress
+
+        while (!unorderedOutput && pendingChunks.size() >= MAX_NUM_PENDING_CHUNKS_PER_THREAD * numThreads) {
+            if (termSignalCaught() || haveErrorMessage())
+                return MoleculeChunkPtr();
+
+            chunkWrittenCondition.wait_for(lock, std::chrono::milliseconds(100));
+        }
+    }
+
+    if (freeChunks.empty())
+        return MoleculeChunkPtr(new MoleculeChunk());
+
+    auto chunk = freeChunks.back();
+
+    freeChunks.pop_back();
+
+    return chunk;
+}
+
+void SubSearchImpl::outputChunk(const MoleculeChunkPtr& chunk)
+{
+    std::unique_lock<std::mutex> lock(writeMolMutex, std::defer_lock);
+
+    if (numThreads == 0 || unorderedOutput) {
+        if (numThreads > 0)
+            lock.lock();
+
+        writeChunk(*chunk);
+        freeChunks.push_back(chunk);
+        return;
+    }
+
+    lock.lock();
+
+    pendingChunks.emplace(chunk->index, chunk);
+
+    for (auto it = pendingChunks.begin(); it != pendingChunks.end() && it->first == nextOutputChunkIndex; nextOutputChunkIndex++) {
+        writeChunk(*it->second);
+
+        freeChunks.push_back(it->second);
+        it = pendingChunks.erase(it);
+    }
+
+    lock.unlock();
+    chunkWrittenCondition.notify_all();
+}
+
+void SubSearchImpl::writeChunk(MoleculeChunk& chunk)
+{
+    for (std::size_t i = 0; i < chunk.numRecords; i++) {
+        auto& rec = chunk.records[i];
+
+        writeMolecule(*rec.molecule, rec.match);
+        printMessage(VERBOSE, "Molecule " + createMoleculeIdentifier(rec.recordIndex, rec.molName) + (rec.match ? ": match" : ": no match"));
+
+        numProcMols++;
+    }
+}
+
 void SubSearchImpl::writeMolecule(const CDPL::Chem::MolecularGraph& mol, bool match)
 {
     if (match) {
@@ -453,6 +751,13 @@ void SubSearchImpl::checkMatchExpression() const
 
 void SubSearchImpl::printMessage(VerbosityLevel level, const std::string& msg, bool nl, bool file_only)
 {
+    if (numThreads == 0) {
+        CmdLineBase::printMessage(level, msg, nl, file_only);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+
     CmdLineBase::printMessage(level, msg, nl, file_only);
 }
 
@@ -475,6 +780,13 @@ void SubSearchImpl::printOptionSummary()
     printMessage(VERBOSE, " Input File Format:                        " + (!inputFormat.empty() ? inputFormat : std::string("Auto-detect")));
     printMessage(VERBOSE, " Matching Molecule Output File Format:     " + (!matchingOutFormat.empty() ? matchingOutFormat : std::string("Auto-detect")));
     printMessage(VERBOSE, " Non-Matching Molecule Output File Format: " + (!nonMatchingOutFormat.empty() ? nonMatchingOutFormat : std::string("Auto-detect")));
+    printMessage(VERBOSE, " Use Screening Index Files:                " + std::string(useScreeningIndex ? "Yes" : "No"));
+    printMessage(VERBOSE, " Multithreading:                           " + std::string(numThreads > 0 ? "Yes" : "No"));
+
+    if (numThreads > 0) {
+        printMessage(VERBOSE, " Number of Threads:                        " + std::to_string(numThreads));
+        printMessage(VERBOSE, " Output Order:                             " + std::string(unorderedOutput ? "Unordered" : "Input Order"));
+    }
     
     printMessage(VERBOSE, "");
 }
@@ -513,6 +825,8 @@ void SubSearchImpl::initInputReader()
 
         auto cb_id = reader_ptr->registerIOCallback(InputScanProgressCallback(this, i * 1.0 / num_in_files, 1.0 / num_in_files));
 
+        auto start_rec_idx = inputReader.getNumRecords();
+
         try {
             inputReader.addReader(reader_ptr);
 
@@ -522,6 +836,9 @@ void SubSearchImpl::initInputReader()
         }
        
         reader_ptr->unregisterIOCallback(cb_id);
+
+        if (useScreeningIndex)
+            initScreeningIndex(file_path, start_rec_idx);
     }
 
     if (SubSearchImpl::termSignalCaught())
@@ -531,6 +848,33 @@ void SubSearchImpl::initInputReader()
     printMessage(INFO, "");
 }
 
+void SubSearchImpl::initScreeningIndex(const std::string& file_path, std::size_t start_rec_idx)
+{
+    using namespace CDPL;
+
+    ScreeningIndexDataPtr data_ptr(new ScreeningIndexData());
+
+    data_ptr->path             = file_path + ".ssidx";
+    data_ptr->sourceStamp      = Util::calcFileStamp(file_path);
+    data_ptr->startRecordIndex = start_rec_idx;
+    data_ptr->numRecords       = inputReader.getNumRecords() - start_rec_idx;
+
+    if (data_ptr->index.open(data_ptr->path, data_ptr->sourceStamp, Chem::SubstructureScreeningKeyGenerator::DEF_NUM_BITS) &&
+        data_ptr->index.getNumRecords() == data_ptr->numRecords) {
+
+        printMessage(VERBOSE, " - Using screening index file '" + data_ptr->path + '\'');
+
+    } else {
+        data_ptr->index.close();
+
+        // records that cannot be read keep all bits set and thus are never screened out
+        data_ptr->keyWords.assign(data_ptr->numRecords * Chem::SubstructureScreeningIndex::getNumWords(Chem::SubstructureScreeningKeyGenerator::DEF_NUM_BITS),
+                                  ~std::uint64_t(0));
+    }
+
+    screeningIndices.push_back(std::move(data_ptr));
+}
+
 void SubSearchImpl::initOutputWriters()
 {
     using namespace CDPL;
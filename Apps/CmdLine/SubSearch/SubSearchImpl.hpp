@@ -26,12 +26,20 @@
 #define SUBSEARCH_SUBSEARCHIMPL_HPP
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 #include <string>
+#include <memory>
+#include <map>
+#include <mutex>
+#include <condition_variable>
 
 #include "CDPL/Util/CompoundDataReader.hpp"
 #include "CDPL/Chem/MolecularGraphWriter.hpp"
 #include "CDPL/Chem/Molecule.hpp"
+#include "CDPL/Chem/MultiSubstructureSearch.hpp"
+#include "CDPL/Chem/SubstructureScreeningIndex.hpp"
+#include "CDPL/Util/BitSet.hpp"
 #include "CDPL/Internal/Timer.hpp"
 
 #include "CmdLine/Lib/CmdLineBase.hpp"
@@ -59,7 +67,25 @@ namespace SubSearch
         int process();
         void findMatches();
 
-        std::size_t readNextMolecule(CDPL::Chem::Molecule& mol);
+        void processSingleThreaded();
+        void processMultiThreaded();
+
+        struct MoleculeRecord;
+        struct MoleculeChunk;
+
+        typedef std::shared_ptr<MoleculeChunk> MoleculeChunkPtr;
+
+        MoleculeChunkPtr readNextChunk(CDPL::Chem::MultiSubstructureSearch& sub_search);
+        std::size_t readNextMolecule(CDPL::Chem::Molecule& mol, CDPL::Chem::MultiSubstructureSearch& sub_search,
+                                     CDPL::Util::BitSet& keys, bool& have_keys);
+
+        MoleculeChunkPtr allocChunk();
+        void outputChunk(const MoleculeChunkPtr& chunk);
+        void writeChunk(MoleculeChunk& chunk);
+
+        bool getScreeningKeys(std::size_t rec_idx, CDPL::Util::BitSet& keys);
+        void storeScreeningKeys(std::size_t rec_idx, const CDPL::Util::BitSet& keys);
+        void writeScreeningIndices();
 
         void writeMolecule(const CDPL::Chem::MolecularGraph& mol, bool match);
 
@@ -77,6 +103,7 @@ namespace SubSearch
         
         void printOptionSummary();
         void initInputReader();
+        void initScreeningIndex(const std::string& file_path, std::size_t start_rec_idx);
         void initOutputWriters();
 
         std::string createMoleculeIdentifier(std::size_t rec_idx, const std::string& mol_name);
@@ -92,22 +119,72 @@ namespace SubSearch
         typedef CDPL::Chem::MolecularGraphWriter::SharedPointer      MoleculeWriterPtr;
         typedef CDPL::Internal::Timer                                Timer;
 
-        StringList         inputFiles;
-        std::string        matchingOutFile;
-        std::string        nonMatchingOutFile;
-        StringList         substrSMARTSPatterns;
-        MoleculeList       substrPatterns;
-        std::string        matchExpression;
-        std::string        inputFormat;
-        std::string        matchingOutFormat;
-        std::string        nonMatchingOutFormat;
-        CompMoleculeReader inputReader;
-        MoleculeWriterPtr  matchingWriter;
-        MoleculeWriterPtr  nonMatchingWriter;
-        std::string        errorMessage;
-        Timer              timer;
-        std::size_t        numProcMols;
-        std::size_t        numMatches;
+        struct MoleculeRecord
+        {
+
+            CDPL::Chem::Molecule::SharedPointer molecule;
+            std::size_t                         recordIndex;
+            std::string                         molName;
+            CDPL::Util::BitSet                  screeningKeys;
+            bool                                haveKeys;
+            bool                                match;
+        };
+
+        struct MoleculeChunk
+        {
+
+            std::size_t                 index;
+            std::size_t                 numRecords;
+            std::vector<MoleculeRecord> records;
+        };
+
+        typedef std::vector<MoleculeChunkPtr>           MoleculeChunkList;
+        typedef std::map<std::size_t, MoleculeChunkPtr> MoleculeChunkMap;
+
+        struct ScreeningIndexData
+        {
+
+            std::string                            path;
+            std::uint64_t                          sourceStamp;
+            std::size_t                            startRecordIndex;
+            std::size_t                            numRecords;
+            CDPL::Chem::SubstructureScreeningIndex index;
+            std::vector<std::uint64_t>             keyWords;
+        };
+
+        typedef std::unique_ptr<ScreeningIndexData> ScreeningIndexDataPtr;
+        typedef std::vector<ScreeningIndexDataPtr>  ScreeningIndexDataList;
+
+        StringList              inputFiles;
+        std::string             matchingOutFile;
+        std::string             nonMatchingOutFile;
+        StringList              substrSMARTSPatterns;
+        MoleculeList            substrPatterns;
+        std::string             matchExpression;
+        std::string             inputFormat;
+        std::string             matchingOutFormat;
+        std::string             nonMatchingOutFormat;
+        bool                    useScreeningIndex;
+        std::size_t             numThreads;
+        bool                    unorderedOutput;
+        CompMoleculeReader      inputReader;
+        MoleculeWriterPtr       matchingWriter;
+        MoleculeWriterPtr       nonMatchingWriter;
+        std::string             errorMessage;
+        Timer                   timer;
+        std::mutex              mutex;
+        std::mutex              readMolMutex;
+        std::mutex              writeMolMutex;
+        std::condition_variable chunkWrittenCondition;
+        std::size_t             chunkSize;
+        std::size_t             nextChunkIndex;
+        std::size_t             nextOutputChunkIndex;
+        MoleculeChunkMap        pendingChunks;
+        MoleculeChunkList       freeChunks;
+        std::size_t             numProcMols;
+        std::size_t             numMatches;
+        std::size_t             numScreenedOut;
+        ScreeningIndexDataList  screeningIndices;
     };
 } // namespace SubSearch
 
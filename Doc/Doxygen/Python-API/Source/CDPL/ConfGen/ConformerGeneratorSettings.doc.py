@@ -319,6 +319,26 @@ class ConformerGeneratorSettings(Boost.Python.instance):
     # 
     def strictForceFieldParameterization() -> bool: pass
 
+    ##
+    # \brief Specifies whether the MMFF94 energy and gradient calculations shall be performed by the packed force field calculators.
+    # 
+    # If enabled, the energy minimizations of stochastic sampling and input coordinate processing use ForceField.MMFF94PackedGradientCalculator instead of ForceField.MMFF94GradientCalculator, and the torsion driving of systematic sampling uses ForceField.MMFF94PackedEnergyCalculator instead of ForceField.MMFF94EnergyCalculator. The packed calculators evaluate most interactions by vectorized kernels and are thus faster on CPUs supporting the AVX2 instruction set, but their results may deviate from the ones of the generic calculators within floating point rounding errors. These deviations may propagate into differing sets of generated conformers. By default, the generic calculators are used. The calculators used for the generation of ring system conformers are selected via the fragment build settings (see getFragmentBuildSettings()).
+    # 
+    # \param packed If <tt>True</tt>, the packed force field calculators are used, and the generic ones otherwise.
+    # 
+    # \since 1.4
+    # 
+    def packedForceFieldEvaluation(packed: bool) -> None: pass
+
+    ##
+    # \brief Tells whether the MMFF94 energy and gradient calculations are performed by the packed force field calculators.
+    # 
+    # \return <tt>True</tt> if the packed force field calculators are used, and <tt>False</tt> otherwise.
+    # 
+    # \since 1.4
+    # 
+    def packedForceFieldEvaluation() -> bool: pass
+
     ##
     # \brief Sets the dielectric constant used by the MMFF94 electrostatic interactions.
     # 
@@ -501,6 +521,27 @@ class ConformerGeneratorSettings(Boost.Python.instance):
     # 
     def getMacrocycleRotorBondCountThreshold() -> int: pass
 
+    ##
+    # \brief Specifies the maximum number of threads that may be used to generate the conformers of a single molecule.
+    # 
+    # If <em>num_threads</em> is greater than <em>1</em>, the structure generation trials of stochastic conformer sampling (and distance geometry based structure generation) get distributed among the calling thread and <em>num_threads - 1</em> additional threads. Since the order in which the threads deliver their results is not deterministic, the generated conformer ensembles may differ slightly between runs. In systematic sampling mode, the conformers of different torsion fragments (including the conformers of the contained ring systems) and of independent branches of the torsion driving fragment trees get generated concurrently. The generated conformers are the same as in single-threaded mode.
+    # 
+    # \param num_threads The maximum number of threads (<em>0</em> or <em>1</em> disables multithreading).
+    # 
+    # \note The default is <em>0</em>.
+    # \since 1.4
+    # 
+    def setNumThreads(num_threads: int) -> None: pass
+
+    ##
+    # \brief Returns the maximum number of threads that may be used to generate the conformers of a single molecule.
+    # 
+    # \return The maximum number of threads.
+    # 
+    # \since 1.4
+    # 
+    def getNumThreads() -> int: pass
+
     ##
     # \brief Returns a reference to the nested fragment conformer build settings.
     # 
@@ -538,6 +579,8 @@ class ConformerGeneratorSettings(Boost.Python.instance):
 
     strictForceFieldParam = property(strictForceFieldParameterization, strictForceFieldParameterization)
 
+    packedForceFieldEval = property(packedForceFieldEvaluation, packedForceFieldEvaluation)
+
     dielectricConstant = property(getDielectricConstant, setDielectricConstant)
 
     distanceExponent = property(getDistanceExponent, setDistanceExponent)
@@ -556,4 +599,6 @@ class ConformerGeneratorSettings(Boost.Python.instance):
 
     macrocycleRotorBondCountThresh = property(getMacrocycleRotorBondCountThreshold, setMacrocycleRotorBondCountThreshold)
 
+    numThreads = property(getNumThreads, setNumThreads)
+
     fragmentBuildSettings = property(getFragmentBuildSettings)
@@ -63,6 +63,26 @@ class DGStructureGenerator(Boost.Python.instance):
     # 
     def getExcludedHydrogenMask() -> Util.BitSet: pass
 
+    ##
+    # \brief Sets the seed of the random number generators used for the generation of initial coordinates.
+    # 
+    # The random number generators get reseeded with the current seed whenever setup() is called.
+    # 
+    # \param seed The new random seed.
+    # 
+    # \since 1.4
+    # 
+    def setRandomSeed(seed: int) -> None: pass
+
+    ##
+    # \brief Returns the seed of the random number generators used for the generation of initial coordinates.
+    # 
+    # \return The current random seed.
+    # 
+    # \since 1.4
+    # 
+    def getRandomSeed() -> int: pass
+
     ##
     # \brief Sets up the generator for <em>molgraph</em> using geometry defaults derived from each atom's element number and hybridization state.
     # 
@@ -141,6 +161,8 @@ class DGStructureGenerator(Boost.Python.instance):
 
     numBondStereoCenters = property(getNumBondStereoCenters)
 
+    randomSeed = property(getRandomSeed, setRandomSeed)
+
     settings = property(getSettings)
 
     constraintGenerator = property(getConstraintGenerator)
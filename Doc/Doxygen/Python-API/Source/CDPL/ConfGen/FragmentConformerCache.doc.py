@@ -0,0 +1,142 @@
+#
+# This file is part of the Chemical Data Processing Toolkit
+#
+# Copyright (C) Thomas Seidel <thomas.seidel@univie.ac.at>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2 of the License, or (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program; see the file COPYING. If not, write to
+# the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+# Boston, MA 02111-1307, USA.
+#
+
+##
+# \brief Provides access to the process-wide cache of generated fragment conformer ensembles.
+# 
+# Fragment conformer ensembles that had to be generated from scratch are cached under the hash code of the corresponding ConfGen.CanonicalFragment. The entries are distributed over a fixed number of independently locked shards and the least recently used entries of a shard get evicted when the shard exceeds its share of the memory budget. The cache contents can be saved to and restored from a stream in the fragment library format. Saved cache contents should only be restored by jobs that employ the same fragment conformer generation settings.
+# 
+# \since 1.4
+# 
+class FragmentConformerCache(Boost.Python.instance):
+
+    ##
+    # \brief Usage statistics of the cache or one of its shards.
+    # 
+    class Statistics(Boost.Python.instance):
+
+        ##
+        # \brief The number of stored fragment conformer ensembles.
+        # 
+        numEntries = _HIDDEN_VALUE_
+
+        ##
+        # \brief The estimated amount of memory (in bytes) consumed by the stored entries.
+        # 
+        memoryUsage = _HIDDEN_VALUE_
+
+        ##
+        # \brief The number of successful entry lookups.
+        # 
+        numHits = _HIDDEN_VALUE_
+
+        ##
+        # \brief The number of failed entry lookups.
+        # 
+        numMisses = _HIDDEN_VALUE_
+
+        ##
+        # \brief The number of entries that were evicted to stay within the memory budget.
+        # 
+        numEvictions = _HIDDEN_VALUE_
+
+    ##
+    # \brief The default memory budget (in bytes).
+    # 
+    DEF_MEMORY_BUDGET = 268435456
+
+    ##
+    # \brief Specifies the maximum amount of memory (in bytes) that may be consumed by the cache entries.
+    # 
+    # Entries exceeding the new budget get evicted immediately. A budget of zero disables caching.
+    # 
+    # \param num_bytes The memory budget in bytes.
+    # 
+    @staticmethod
+    def setMemoryBudget(num_bytes: int) -> None: pass
+
+    ##
+    # \brief Returns the maximum amount of memory (in bytes) that may be consumed by the cache entries.
+    # 
+    # \return The memory budget in bytes.
+    # 
+    @staticmethod
+    def getMemoryBudget() -> int: pass
+
+    ##
+    # \brief Returns the number of shards the cache entries are distributed over.
+    # 
+    # \return The number of shards.
+    # 
+    @staticmethod
+    def getNumShards() -> int: pass
+
+    ##
+    # \brief Returns the usage statistics of the shard with index <em>idx</em>.
+    # 
+    # \param idx The zero-based index of the shard.
+    # 
+    # \return The usage statistics of the shard.
+    # 
+    # \throw Base.IndexError if <em>idx</em> is not in the range [0, getNumShards() - 1].
+    # 
+    @staticmethod
+    def getStatistics(idx: int) -> Statistics: pass
+
+    ##
+    # \brief Returns the accumulated usage statistics of all shards.
+    # 
+    # \return The usage statistics of the cache.
+    # 
+    @staticmethod
+    def getStatistics() -> Statistics: pass
+
+    ##
+    # \brief Removes all entries and resets the usage statistics.
+    # 
+    @staticmethod
+    def clear() -> None: pass
+
+    ##
+    # \brief Adds the fragment conformer ensembles read from the input stream <em>is</em> to the cache.
+    # 
+    # Entries that are already present in the cache are left unchanged.
+    # 
+    # \param is The input stream to read from.
+    # 
+    # \return The number of added entries.
+    # 
+    # \throw Base.IOError if an error occurred while reading the data.
+    # 
+    @staticmethod
+    def load(is: Base.IStream) -> int: pass
+
+    ##
+    # \brief Writes the cached fragment conformer ensembles to the output stream <em>os</em> in the fragment library format.
+    # 
+    # \param os The output stream to write to.
+    # 
+    # \return The number of written entries.
+    # 
+    # \throw Base.IOError if an error occurred while writing the data.
+    # 
+    @staticmethod
+    def save(os: Base.OStream) -> int: pass
@@ -239,6 +239,26 @@ class FragmentConformerGeneratorSettings(Boost.Python.instance):
     # 
     def strictForceFieldParameterization() -> bool: pass
 
+    ##
+    # \brief Specifies whether the MMFF94 energy minimizations shall be performed by the packed force field calculator.
+    # 
+    # If enabled, ForceField.MMFF94PackedGradientCalculator is used instead of ForceField.MMFF94GradientCalculator. The packed calculator evaluates most interactions by vectorized kernels and is thus faster on CPUs supporting the AVX2 instruction set, but its results may deviate from the ones of the generic calculator within floating point rounding errors. These deviations may propagate into differing sets of generated fragment conformers. By default, the generic calculator is used.
+    # 
+    # \param packed If <tt>True</tt>, the packed force field calculator is used, and the generic one otherwise.
+    # 
+    # \since 1.4
+    # 
+    def packedForceFieldEvaluation(packed: bool) -> None: pass
+
+    ##
+    # \brief Tells whether the MMFF94 energy minimizations are performed by the packed force field calculator.
+    # 
+    # \return <tt>True</tt> if the packed force field calculator is used, and <tt>False</tt> otherwise.
+    # 
+    # \since 1.4
+    # 
+    def packedForceFieldEvaluation() -> bool: pass
+
     ##
     # \brief Sets the dielectric constant used by the MMFF94 electrostatic interactions.
     # 
@@ -348,6 +368,8 @@ class FragmentConformerGeneratorSettings(Boost.Python.instance):
 
     strictForceFieldParam = property(strictForceFieldParameterization, strictForceFieldParameterization)
 
+    packedForceFieldEval = property(packedForceFieldEvaluation, packedForceFieldEvaluation)
+
     dielectricConstant = property(getDielectricConstant, setDielectricConstant)
 
     distanceExponent = property(getDistanceExponent, setDistanceExponent)
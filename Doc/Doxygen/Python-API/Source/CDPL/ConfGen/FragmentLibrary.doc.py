@@ -24,6 +24,8 @@
 # 
 # Entries are FragmentLibraryEntry instances keyed by the hash code of the associated ConfGen.CanonicalFragment. The library is iterable, supports lookup/insertion/removal, can be serialized to and from a stream, and provides a process-wide default instance via the static set() / get() accessors. A built-in mutex is exposed via getMutex() to allow callers to coordinate concurrent access.
 # 
+# Libraries initialized by loadDefaults() or mapFile() do not decode their entries in advance. Instead, a sorted index of the entry hash codes is used to locate the encoded entry data, which is decoded on the first request of the entry by getEntry(). Concurrent calls to getEntry(), containsEntry() and getNumEntries() are safe. Methods that iterate over, remove or save the entries first decode all remaining entries.
+# 
 # \see [\ref CFRG]
 # 
 class FragmentLibrary(Boost.Python.instance):
@@ -123,6 +125,8 @@ class FragmentLibrary(Boost.Python.instance):
     ##
     # \brief Loads the default fragment library bundled with CDPKit.
     # 
+    # If the library is empty, the built-in entries get decoded on first request only (see getEntry()).
+    # 
     def loadDefaults() -> None: pass
 
     ##
@@ -132,6 +136,30 @@ class FragmentLibrary(Boost.Python.instance):
     # 
     def save(os: Base.OStream) -> None: pass
 
+    ##
+    # \brief Writes the contents of the library to the output stream <em>os</em> in indexed form.
+    # 
+    # The entries are written in ascending order of their hash codes and are preceded by a record that stores the hash code and the file offset of each entry. This record lets mapFile() access the entries without scanning the file first. load() and other readers of the regular format skip the index record, so the output remains a valid fragment library file.
+    # 
+    # \param os The output stream to write to.
+    # 
+    # \since 1.4
+    # 
+    def saveIndexed(os: Base.OStream) -> None: pass
+
+    ##
+    # \brief Replaces the contents of the library by the entries of the memory-mapped fragment library file <em>file_name</em>.
+    # 
+    # The file stays mapped read-only for the lifetime of the library (and its copies), and its pages are shared by all processes that map the same file. Entries get decoded on the first request only. If the file does not start with an index record (see saveIndexed()), the index gets built by a scan of the record headers.
+    # 
+    # \param file_name The path of the fragment library file.
+    # 
+    # \throw Base.IOError if the file cannot be mapped or is not a valid fragment library file.
+    # 
+    # \since 1.4
+    # 
+    def mapFile(file_name: str) -> None: pass
+
     ##
     # \brief Replaces the contents of this library with a copy of the contents of <em>lib</em>.
     # 
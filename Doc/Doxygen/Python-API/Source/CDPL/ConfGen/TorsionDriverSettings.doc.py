@@ -157,6 +157,26 @@ class TorsionDriverSettings(Boost.Python.instance):
     # 
     def strictForceFieldParameterization() -> bool: pass
 
+    ##
+    # \brief Specifies whether the MMFF94 energy calculations shall be performed by the packed force field calculator.
+    # 
+    # If enabled, ForceField.MMFF94PackedEnergyCalculator is used instead of ForceField.MMFF94EnergyCalculator. The packed calculator evaluates most interactions by vectorized kernels and is thus faster on CPUs supporting the AVX2 instruction set, but its results may deviate from the ones of the generic calculator within floating point rounding errors. These deviations may propagate into differing conformer energy rankings and selections. By default, the generic calculator is used.
+    # 
+    # \param packed If <tt>True</tt>, the packed force field calculator is used, and the generic one otherwise.
+    # 
+    # \since 1.4
+    # 
+    def packedForceFieldEvaluation(packed: bool) -> None: pass
+
+    ##
+    # \brief Tells whether the MMFF94 energy calculations are performed by the packed force field calculator.
+    # 
+    # \return <tt>True</tt> if the packed force field calculator is used, and <tt>False</tt> otherwise.
+    # 
+    # \since 1.4
+    # 
+    def packedForceFieldEvaluation() -> bool: pass
+
     ##
     # \brief Sets the dielectric constant used by the MMFF94 electrostatic interactions.
     # 
@@ -194,6 +214,8 @@ class TorsionDriverSettings(Boost.Python.instance):
 
     strictForceFieldParam = property(strictForceFieldParameterization, strictForceFieldParameterization)
 
+    packedForceFieldEval = property(packedForceFieldEvaluation, packedForceFieldEvaluation)
+
     dielectricConstant = property(getDielectricConstant, setDielectricConstant)
 
     distanceExponent = property(getDistanceExponent, setDistanceExponent)
@@ -28,6 +28,16 @@
 # 
 class MMFF94InteractionData(Boost.Python.instance):
 
+    ##
+    # \brief Specifies that no cutoff shall be applied to nonbonded interactions.
+    # 
+    NO_NONBONDED_CUTOFF = 0.0
+
+    ##
+    # \brief The default width of the nonbonded interaction switching region in Å.
+    # 
+    DEF_NONBONDED_SWITCHING_WIDTH = 2.0
+
     ##
     # \brief Initializes the \c %MMFF94InteractionData instance.
     # 
@@ -93,6 +103,49 @@ class MMFF94InteractionData(Boost.Python.instance):
     # 
     def getVanDerWaalsInteractions() -> MMFF94VanDerWaalsInteractionList: pass
 
+    ##
+    # \brief Sets the distance beyond which electrostatic and Van der Waals interactions shall be neglected.
+    # 
+    # If a cutoff greater than zero has been specified, energy and gradient calculators evaluate only those electrostatic and Van der Waals interactions whose atoms are currently closer than the cutoff distance (determined with the help of neighbor lists, see ForceField.NonbondedNeighborList). To retain a continuous energy function and gradient, the interaction energies get smoothly switched off over a distance range of getNonbondedSwitchingWidth() Å that ends at the cutoff distance.
+    # 
+    # \param cutoff The nonbonded interaction cutoff distance in Å or ForceField.MMFF94InteractionData.NO_NONBONDED_CUTOFF to evaluate all stored interactions (default).
+    # 
+    def setNonbondedCutoff(cutoff: float) -> None: pass
+
+    ##
+    # \brief Returns the distance beyond which electrostatic and Van der Waals interactions shall be neglected.
+    # 
+    # \return The nonbonded interaction cutoff distance in Å.
+    # 
+    def getNonbondedCutoff() -> float: pass
+
+    ##
+    # \brief Sets the width of the distance range preceding the cutoff in which nonbonded interaction energies get switched off.
+    # 
+    # \param width The switching region width in Å (a value of zero results in a hard cutoff).
+    # 
+    def setNonbondedSwitchingWidth(width: float) -> None: pass
+
+    ##
+    # \brief Returns the width of the distance range preceding the cutoff in which nonbonded interaction energies get switched off.
+    # 
+    # \return The switching region width in Å.
+    # 
+    def getNonbondedSwitchingWidth() -> float: pass
+
+    ##
+    # \brief Returns a value that identifies the current state of the electrostatic and Van der Waals interaction lists.
+    # 
+    # A new, process-wide unique version value gets assigned whenever one of the lists is accessed and by clear(). swap() exchanges the versions along with the data. Energy and gradient calculators compare the version with the one of their last invocation to detect that the interaction pair tables of their neighbor lists have to be rebuilt.
+    # 
+    # \return The nonbonded interaction data version.
+    # 
+    # \note Modifications made via list references that were obtained before the last version change can't be detected.
+    # 
+    # \since 1.4
+    # 
+    def getNonbondedDataVersion() -> int: pass
+
     ##
     # \brief Replaces the current state of \a self with a copy of the state of the \c %MMFF94InteractionData instance \a ia_data.
     # \param ia_data The \c %MMFF94InteractionData instance to copy.
@@ -101,7 +154,7 @@ class MMFF94InteractionData(Boost.Python.instance):
     def assign(ia_data: MMFF94InteractionData) -> MMFF94InteractionData: pass
 
     ##
-    # \brief Swaps the contents (all interaction lists) of this instance with <em>ia_data</em>.
+    # \brief Swaps the contents (all interaction lists and nonbonded cutoff settings) of this instance with <em>ia_data</em>.
     # 
     # \param ia_data The other interaction data instance.
     # 
@@ -134,3 +187,9 @@ class MMFF94InteractionData(Boost.Python.instance):
     electrostaticInteractions = property(getElectrostaticInteractions)
 
     vanDerWaalsInteractions = property(getVanDerWaalsInteractions)
+
+    nonbondedCutoff = property(getNonbondedCutoff, setNonbondedCutoff)
+
+    nonbondedSwitchingWidth = property(getNonbondedSwitchingWidth, setNonbondedSwitchingWidth)
+
+    nonbondedDataVersion = property(getNonbondedDataVersion)
@@ -241,6 +241,38 @@ class MMFF94InteractionParameterizer(Boost.Python.instance):
     # 
     def setDistanceExponent(dist_expo: float) -> None: pass
 
+    ##
+    # \brief Sets the nonbonded interaction cutoff distance that gets stored in the output interaction data.
+    # 
+    # \param cutoff The cutoff distance in Å or ForceField.MMFF94InteractionData.NO_NONBONDED_CUTOFF (default).
+    # 
+    # \see ForceField.MMFF94InteractionData.setNonbondedCutoff()
+    # 
+    def setNonbondedCutoff(cutoff: float) -> None: pass
+
+    ##
+    # \brief Returns the nonbonded interaction cutoff distance that gets stored in the output interaction data.
+    # 
+    # \return The cutoff distance in Å.
+    # 
+    def getNonbondedCutoff() -> float: pass
+
+    ##
+    # \brief Sets the width of the nonbonded interaction switching region that gets stored in the output interaction data.
+    # 
+    # \param width The switching region width in Å.
+    # 
+    # \see ForceField.MMFF94InteractionData.setNonbondedSwitchingWidth()
+    # 
+    def setNonbondedSwitchingWidth(width: float) -> None: pass
+
+    ##
+    # \brief Returns the width of the nonbonded interaction switching region that gets stored in the output interaction data.
+    # 
+    # \return The switching region width in Å.
+    # 
+    def getNonbondedSwitchingWidth() -> float: pass
+
     ##
     # \brief Switches the active MMFF94 parameter set variant to a different one.
     # 
@@ -268,3 +300,7 @@ class MMFF94InteractionParameterizer(Boost.Python.instance):
     def parameterize(molgraph: Chem.MolecularGraph, ia_data: MMFF94InteractionData, ia_types: int = 127, strict: bool = True) -> None: pass
 
     objectID = property(getObjectID)
+
+    nonbondedCutoff = property(getNonbondedCutoff, setNonbondedCutoff)
+
+    nonbondedSwitchingWidth = property(getNonbondedSwitchingWidth, setNonbondedSwitchingWidth)
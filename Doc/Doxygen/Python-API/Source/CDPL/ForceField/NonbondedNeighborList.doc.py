@@ -0,0 +1,150 @@
+#
+# This file is part of the Chemical Data Processing Toolkit
+#
+# Copyright (C) Thomas Seidel <thomas.seidel@univie.ac.at>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2 of the License, or (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program; see the file COPYING. If not, write to
+# the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+# Boston, MA 02111-1307, USA.
+#
+
+##
+# \brief Verlet neighbor list selecting the atom pair interactions of a pair interaction list (e.g. ForceField.MMFF94VanDerWaalsInteractionList) that lie within a given cutoff distance.
+# 
+# The neighbor list stores the indices of all interactions whose atom distance is less than the cutoff distance plus a skin distance. The list is rebuilt by update() via a spatial cell list only if at least one atom has moved by more than half of the skin distance since the last rebuild. Otherwise, the stored interaction indices remain valid and the rebuild is skipped. Interactions for which the current atom distance exceeds the cutoff have to be filtered out by the consumer of the list.
+# 
+# \since 1.4
+# 
+class NonbondedNeighborList(Boost.Python.instance):
+
+    ##
+    # \brief The default skin distance in Å.
+    # 
+    DEF_SKIN_DISTANCE = 2.0
+
+    ##
+    # \brief Constructs an empty neighbor list with a cutoff distance of zero.
+    # 
+    def __init__() -> None: pass
+
+    ##
+    # \brief Initializes a copy of the \c %NonbondedNeighborList instance \a nbr_list.
+    # \param nbr_list The \c %NonbondedNeighborList instance to copy.
+    # 
+    def __init__(nbr_list: NonbondedNeighborList) -> None: pass
+
+    ##
+    # \brief Returns the numeric identifier (ID) of the wrapped C++ class instance.
+    # 
+    # Different Python \c %NonbondedNeighborList instances may reference the same underlying C++ class instance. The commonly used Python expression
+    # <tt>a is not b</tt> thus cannot tell reliably whether the two \c %NonbondedNeighborList instances \e a and \e b reference different C++ objects. 
+    # The numeric identifier returned by this method allows to correctly implement such an identity test via the simple expression
+    # <tt>a.getObjectID() != b.getObjectID()</tt>.
+    # 
+    # \return The numeric ID of the internally referenced C++ class instance.
+    # 
+    def getObjectID() -> int: pass
+
+    ##
+    # \brief Replaces the current state of \a self with a copy of the state of the \c %NonbondedNeighborList instance \a nbr_list.
+    # \param nbr_list The \c %NonbondedNeighborList instance to copy.
+    # \return \a self
+    # 
+    def assign(nbr_list: NonbondedNeighborList) -> NonbondedNeighborList: pass
+
+    ##
+    # \brief Sets the cutoff distance.
+    # 
+    # \param cutoff The cutoff distance in Å.
+    # 
+    # \note Changing the cutoff distance forces a rebuild of the list by the next call to update().
+    # 
+    def setCutoff(cutoff: float) -> None: pass
+
+    ##
+    # \brief Returns the cutoff distance.
+    # 
+    # \return The cutoff distance in Å.
+    # 
+    def getCutoff() -> float: pass
+
+    ##
+    # \brief Sets the skin distance that gets added to the cutoff distance when the list is built.
+    # 
+    # Larger values lead to less frequent rebuilds but more interactions that have to be checked by the consumer.
+    # 
+    # \param skin The skin distance in Å.
+    # 
+    # \note Changing the skin distance forces a rebuild of the list by the next call to update().
+    # 
+    def setSkinDistance(skin: float) -> None: pass
+
+    ##
+    # \brief Returns the skin distance.
+    # 
+    # \return The skin distance in Å.
+    # 
+    def getSkinDistance() -> float: pass
+
+    ##
+    # \brief Initializes the list with the electrostatic interactions stored in \a ia_list.
+    # 
+    # \param ia_list The electrostatic interaction list.
+    # 
+    def setup(ia_list: MMFF94ElectrostaticInteractionList) -> None: pass
+
+    ##
+    # \brief Initializes the list with the Van der Waals interactions stored in \a ia_list.
+    # 
+    # \param ia_list The Van der Waals interaction list.
+    # 
+    def setup(ia_list: MMFF94VanDerWaalsInteractionList) -> None: pass
+
+    ##
+    # \brief Removes all interactions.
+    # 
+    def clear() -> None: pass
+
+    ##
+    # \brief Returns the number of interactions specified by the last call to setup().
+    # 
+    # \return The number of interactions.
+    # 
+    def getNumInteractions() -> int: pass
+
+    ##
+    # \brief Rebuilds the list of neighboring interactions if required for the atom positions \a coords.
+    # 
+    # \param coords The current atom 3D coordinates.
+    # 
+    # \return <tt>True</tt> if the list has been rebuilt, and <tt>False</tt> otherwise.
+    # 
+    def update(coords: Math.Vector3DArray) -> bool: pass
+
+    ##
+    # \brief Returns the indices of the interactions whose atom distance was within the cutoff plus skin distance at the time of the last rebuild.
+    # 
+    # \return The indices of the selected interactions in ascending order.
+    # 
+    def getInteractionIndices() -> list: pass
+
+    objectID = property(getObjectID)
+
+    cutoff = property(getCutoff, setCutoff)
+
+    skinDistance = property(getSkinDistance, setSkinDistance)
+
+    numInteractions = property(getNumInteractions)
+
+    interactionIndices = property(getInteractionIndices)
@@ -54,6 +54,28 @@ class Vector2DArrayBFGSMinimizer(Boost.Python.instance):
         #
         DELTAF_REACHED = 8
 
+    ##
+    # \brief Specifies the kind of evaluation requested by advance().
+    # 
+    # \since 1.4
+    # 
+    class EvaluationRequest(Boost.Python.enum):
+
+        ##
+        # \brief No evaluation required - the minimization has been finished (see getStatus()).
+        # 
+        NO_EVALUATION = 0
+
+        ##
+        # \brief The objective function value at getEvaluationPoint() has to be supplied via setFunctionValue().
+        # 
+        VALUE_EVALUATION = 1
+
+        ##
+        # \brief The objective function value and gradient at getEvaluationPoint() have to be supplied via setFunctionGradient().
+        # 
+        GRADIENT_EVALUATION = 2
+
     ##
     # \brief Initializes the \c %Vector2DArrayBFGSMinimizer instance.
     # \param func 
@@ -61,6 +83,13 @@ class Vector2DArrayBFGSMinimizer(Boost.Python.instance):
     # 
     def __init__(func: DoubleVector2DArrayFunctor, grad_func: object) -> None: pass
 
+    ##
+    # \brief Constructs a <tt>BFGSMinimizer</tt> instance without objective and gradient functions that can only be used via the reverse communication interface (see start()).
+    # 
+    # \since 1.4
+    # 
+    def __init__() -> None: pass
+
     ##
     # \brief Returns the numeric identifier (ID) of the wrapped C++ class instance.
     # 
@@ -134,6 +163,77 @@ class Vector2DArrayBFGSMinimizer(Boost.Python.instance):
     #
     def iterate(f: float, x: Vector2DArray, g: Vector2DArray) -> tuple: pass
 
+    ##
+    # \brief Starts a minimization that is driven by the caller via the reverse communication interface.
+    # 
+    # Instead of calling the objective and gradient functions, each call to advance() returns as soon as a function value or a function value and gradient at getEvaluationPoint() is required. The caller supplies the requested data via setFunctionValue() or setFunctionGradient() and calls advance() again until it returns EvaluationRequest.NO_EVALUATION. This allows to interleave multiple minimizations and to calculate the requested data in batches. The performed steps are exactly the same as those of setup() followed by minimize() with <em>do_setup</em> set to <tt>False</tt>.
+    # 
+    # \param x The starting variable vector.
+    # \param max_iter The maximum number of iterations (<em>0</em> means unlimited).
+    # \param g_norm The gradient-norm threshold below which the minimization is stopped (negative values disable this stop condition).
+    # \param delta_f The function-value-delta threshold below which the minimization is stopped (negative values disable this stop condition).
+    # \param step_size The initial step-size guess.
+    # \param tol The line-search tolerance.
+    # 
+    # \since 1.4
+    # 
+    def start(x: Vector2DArray, max_iter: int, g_norm: float, delta_f: float, step_size: float = 0.001, tol: float = 0.15) -> None: pass
+
+    ##
+    # \brief Advances the minimization started by start() until the next function evaluation is required or the minimization has been finished.
+    # 
+    # \return The kind of the requested evaluation, or EvaluationRequest.NO_EVALUATION if the minimization has been finished.
+    # 
+    # \since 1.4
+    # 
+    def advance() -> EvaluationRequest: pass
+
+    ##
+    # \brief Returns the variable vector at which the function value or gradient requested by advance() has to be calculated.
+    # 
+    # \return A reference to the evaluation point.
+    # 
+    # \since 1.4
+    # 
+    def getEvaluationPoint() -> Vector2DArray: pass
+
+    ##
+    # \brief Supplies the function value at getEvaluationPoint() requested by advance().
+    # 
+    # \param f The function value.
+    # 
+    # \since 1.4
+    # 
+    def setFunctionValue(f: float) -> None: pass
+
+    ##
+    # \brief Supplies the function value and gradient at getEvaluationPoint() requested by advance().
+    # 
+    # \param f The function value.
+    # \param g The gradient.
+    # 
+    # \since 1.4
+    # 
+    def setFunctionGradient(f: float, g: Vector2DArray) -> None: pass
+
+    ##
+    # \brief Returns the current variable vector of the minimization started by start().
+    # 
+    # \return A reference to the current variable vector.
+    # 
+    # \since 1.4
+    # 
+    def getPosition() -> Vector2DArray: pass
+
+    ##
+    # \brief Returns the gradient at the current variable vector of the minimization started by start().
+    # 
+    # \return A reference to the current gradient.
+    # 
+    # \since 1.4
+    # 
+    def getGradient() -> Vector2DArray: pass
+
     objectID = property(getObjectID)
 
     gradientNorm = property(getGradientNorm)
@@ -145,3 +245,9 @@ class Vector2DArrayBFGSMinimizer(Boost.Python.instance):
     numIterations = property(getNumIterations)
 
     status = property(getStatus)
+
+    evaluationPoint = property(getEvaluationPoint)
+
+    position = property(getPosition)
+
+    gradient = property(getGradient)
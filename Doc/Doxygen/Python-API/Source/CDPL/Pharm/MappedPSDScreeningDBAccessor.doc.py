@@ -0,0 +1,41 @@
+#
+# This file is part of the Chemical Data Processing Toolkit
+#
+# Copyright (C) Thomas Seidel <thomas.seidel@univie.ac.at>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2 of the License, or (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program; see the file COPYING. If not, write to
+# the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+# Boston, MA 02111-1307, USA.
+#
+
+##
+# \brief Pharm.ScreeningDBAccessor implementation that reads pharmacophore screening databases stored in memory-mapped PSD database files.
+# 
+# Memory-mapped PSD database files store the same PSD-encoded molecule and pharmacophore data as SQLite-based PSD files but in contiguous blocks that are addressed via fixed offset tables. Database files are created by means of Pharm.MappedPSDScreeningDBWriter.
+# 
+# \since 1.4
+# 
+class MappedPSDScreeningDBAccessor(ScreeningDBAccessor):
+
+    ##
+    # \brief Constructs a <tt>MappedPSDScreeningDBAccessor</tt> instance without an associated database.
+    # 
+    def __init__() -> None: pass
+
+    ##
+    # \brief Constructs a <tt>MappedPSDScreeningDBAccessor</tt> instance that will read data from the database-file specified by <em>name</em>.
+    # 
+    # \param name The name of the database-file.
+    # 
+    def __init__(name: str) -> None: pass
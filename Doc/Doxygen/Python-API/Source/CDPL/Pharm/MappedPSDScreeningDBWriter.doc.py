@@ -0,0 +1,116 @@
+#
+# This file is part of the Chemical Data Processing Toolkit
+#
+# Copyright (C) Thomas Seidel <thomas.seidel@univie.ac.at>
+#
+# This program is free software; you can redistribute it and/or
+# modify it under the terms of the GNU Lesser General Public
+# License as published by the Free Software Foundation; either
+# version 2 of the License, or (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+# Lesser General Public License for more details.
+#
+# You should have received a copy of the GNU Lesser General Public License
+# along with this program; see the file COPYING. If not, write to
+# the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+# Boston, MA 02111-1307, USA.
+#
+
+##
+# \brief Creates memory-mapped PSD database files that can be read by means of Pharm.MappedPSDScreeningDBAccessor.
+# 
+# The data get written to temporary files in the directory of the target file that are completed and renamed to the target path by close(). Files that have not been closed successfully get removed on destruction.
+# 
+# \since 1.4
+# 
+class MappedPSDScreeningDBWriter(Boost.Python.instance):
+
+    ##
+    # \brief Constructs a <tt>MappedPSDScreeningDBWriter</tt> instance that is not associated with a file.
+    # 
+    def __init__() -> None: pass
+
+    ##
+    # \brief Constructs a <tt>MappedPSDScreeningDBWriter</tt> instance that starts writing the database-file specified by <em>name</em>.
+    # 
+    # \param name The name of the database-file.
+    # 
+    def __init__(name: str) -> None: pass
+
+    ##
+    # \brief Returns the numeric identifier (ID) of the wrapped C++ class instance.
+    # 
+    # Different Python \c %MappedPSDScreeningDBWriter instances may reference the same underlying C++ class instance. The commonly used Python expression
+    # <tt>a is not b</tt> thus cannot tell reliably whether the two \c %MappedPSDScreeningDBWriter instances \e a and \e b reference different C++ objects. 
+    # The numeric identifier returned by this method allows to correctly implement such an identity test via the simple expression
+    # <tt>a.getObjectID() != b.getObjectID()</tt>.
+    # 
+    # \return The numeric ID of the internally referenced C++ class instance.
+    # 
+    def getObjectID() -> int: pass
+
+    ##
+    # \brief Starts writing the database-file specified by <em>name</em>.
+    # 
+    # \param name The name of the database-file.
+    # 
+    def open(name: str) -> None: pass
+
+    ##
+    # \brief Appends all molecule and pharmacophore records of <em>db_acc</em> to the database.
+    # 
+    # \param db_acc The source database accessor.
+    # \param func A progress-reporting callback invoked during the operation.
+    # 
+    # \return <tt>True</tt> if all records have been appended, and <tt>False</tt> if the operation was aborted by the callback.
+    # 
+    def append(db_acc: ScreeningDBAccessor, func: BoolDoubleFunctor = None) -> bool: pass
+
+    ##
+    # \brief Completes the database-file and renames it to the name specified on opening.
+    # 
+    def close() -> None: pass
+
+    ##
+    # \brief Stops writing and removes the data written so far.
+    # 
+    def discard() -> None: pass
+
+    ##
+    # \brief Tells whether a database-file is currently being written.
+    # 
+    # \return <tt>True</tt> if a file is being written, and <tt>False</tt> otherwise.
+    # 
+    def isOpen() -> bool: pass
+
+    ##
+    # \brief Returns the name of the currently written database-file.
+    # 
+    # \return The database-file name (or an empty string if no file is being written).
+    # 
+    def getDatabaseName() -> str: pass
+
+    ##
+    # \brief Returns the number of molecules appended since the last call to open().
+    # 
+    # \return The number of appended molecules.
+    # 
+    def getNumMolecules() -> int: pass
+
+    ##
+    # \brief Returns the number of pharmacophores appended since the last call to open().
+    # 
+    # \return The number of appended pharmacophores.
+    # 
+    def getNumPharmacophores() -> int: pass
+
+    objectID = property(getObjectID)
+
+    databaseName = property(getDatabaseName)
+
+    numMolecules = property(getNumMolecules)
+
+    numPharmacophores = property(getNumPharmacophores)
@@ -37,3 +37,59 @@ class PSDScreeningDBCreator(ScreeningDBCreator):
     # \param allow_dup_entries Specifies whether input molecules that are duplicates of already stored molecules should be discarded.
     # 
     def __init__(name: str, mode: Mode = CDPL.Pharm.Mode.CREATE, allow_dup_entries: bool = True) -> None: pass
+
+    ##
+    # \brief Specifies whether the created database shall contain an index of the binned feature pair distances of the stored pharmacophores.
+    # 
+    # The index allows Pharm.ScreeningProcessor to skip database pharmacophores that cannot match a given query without loading them. The setting takes effect when the next database gets opened. An index that is already present in an opened database is always kept up to date, regardless of this setting.
+    # 
+    # \param create <tt>True</tt> if the index shall be created, and <tt>False</tt> otherwise.
+    # 
+    # \note The default setting is <tt>False</tt>.
+    # \since 1.4
+    # 
+    def createTwoPointPharmacophoreIndex(create: bool) -> None: pass
+
+    ##
+    # \brief Tells whether the created database will contain an index of the binned feature pair distances of the stored pharmacophores.
+    # 
+    # \return <tt>True</tt> if the index gets created, and <tt>False</tt> otherwise.
+    # 
+    # \since 1.4
+    # 
+    def twoPointPharmacophoreIndexCreated() -> bool: pass
+
+    ##
+    # \brief Specifies whether process() may be called concurrently by multiple threads.
+    # 
+    # If enabled, the pharmacophores and the serialized database records of the molecules passed to process() are generated by the calling threads while a dedicated writer thread inserts the finished records into the database in batched transactions. Since the insertions are performed asynchronously, the deleted and inserted molecule counts only include the records written so far (see flush()). The setting takes effect when the next database gets opened. Note that merge() and all other methods must not be called concurrently with process().
+    # 
+    # \param enable <tt>True</tt> if concurrent calls to process() shall be supported, and <tt>False</tt> otherwise.
+    # 
+    # \note The default setting is <tt>False</tt>.
+    # \since 1.4
+    # 
+    def enableMultiThreading(enable: bool) -> None: pass
+
+    ##
+    # \brief Tells whether process() may be called concurrently by multiple threads.
+    # 
+    # \return <tt>True</tt> if concurrent calls to process() are supported, and <tt>False</tt> otherwise.
+    # 
+    # \since 1.4
+    # 
+    def multiThreadingEnabled() -> bool: pass
+
+    ##
+    # \brief Waits until all molecules accepted by process() have been inserted into the database.
+    # 
+    # Has only an effect if multithreading was enabled when the database was opened (see enableMultiThreading()).
+    # 
+    # \throw Base.IOError if inserting a record failed.
+    # \since 1.4
+    # 
+    def flush() -> None: pass
+
+    create2PointPharmIndex = property(twoPointPharmacophoreIndexCreated, createTwoPointPharmacophoreIndex)
+
+    multiThreading = property(multiThreadingEnabled, enableMultiThreading)
@@ -148,6 +148,43 @@ class ScreeningDBAccessor(Boost.Python.instance):
     # 
     def getFeatureCounts(mol_idx: int, mol_conf_idx: int) -> FeatureTypeHistogram: pass
 
+    ##
+    # \brief Tells whether the database provides an index of the (binned) feature pair distances of the stored pharmacophores.
+    # 
+    # \return <tt>True</tt> if getTwoPointPharmacophoreMatches() narrows down the set of candidate pharmacophores, and <tt>False</tt> otherwise.
+    # 
+    # \note The default implementation returns <tt>False</tt>.
+    # 
+    # \since 1.4
+    # 
+    def hasTwoPointPharmacophoreIndex() -> bool: pass
+
+    ##
+    # \brief Marks the pharmacophores that might contain a pair of features of type <em>ftr1_type</em> and <em>ftr2_type</em> whose distance lies within the range [<em>min_dist</em>, <em>max_dist</em>].
+    # 
+    # The bit set <em>pharm_set</em> gets resized to the number of stored pharmacophores and the bits at the indices of the marked pharmacophores are set. The marked pharmacophores are a superset of the actually matching ones, i.e. pharmacophores that do not get marked are guaranteed to contain no such feature pair.
+    # 
+    # \param ftr1_type The type of the first feature.
+    # \param ftr2_type The type of the second feature.
+    # \param min_dist The minimum feature distance.
+    # \param max_dist The maximum feature distance.
+    # \param pharm_set The output bit set.
+    # 
+    # \note The default implementation marks all pharmacophores.
+    # 
+    # \since 1.4
+    # 
+    def getTwoPointPharmacophoreMatches(ftr1_type: int, ftr2_type: int, min_dist: float, max_dist: float, pharm_set: Util.BitSet) -> None: pass
+
+    ##
+    # \brief Creates a new accessor of the same type that provides independent access to the currently open database.
+    # 
+    # \return The created accessor, or <tt>None</tt> if cloning is not supported (default implementation).
+    # 
+    # \since 1.4
+    # 
+    def clone() -> ScreeningDBAccessor: pass
+
     objectID = property(getObjectID)
 
     databaseName = property(getDatabaseName)
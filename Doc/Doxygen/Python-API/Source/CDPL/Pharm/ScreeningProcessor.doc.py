@@ -63,6 +63,20 @@ class ScreeningProcessor(Boost.Python.instance):
         # 
         def __init__(hit_prov: ScreeningProcessor, qry_pharm: FeatureContainer, hit_pharm: FeatureContainer, mol: Chem.Molecule, xform: Math.Matrix4D, pharm_idx: int, mol_idx: int, conf_idx: int) -> None: pass
 
+        ##
+        # \brief Constructs the \c %SearchHit instance with the given references.
+        # \param hit_prov The screening processor that produced the hit.
+        # \param db_acc The database accessor the hit data were retrieved from.
+        # \param qry_pharm The query pharmacophore.
+        # \param hit_pharm The hit pharmacophore.
+        # \param mol The hit molecule.
+        # \param xform The alignment transformation that maps the hit onto the query.
+        # \param pharm_idx The zero-based pharmacophore index within the source database.
+        # \param mol_idx The zero-based molecule index within the source database.
+        # \param conf_idx The zero-based conformer index within the source molecule.
+        # 
+        def __init__(hit_prov: ScreeningProcessor, db_acc: ScreeningDBAccessor, qry_pharm: FeatureContainer, hit_pharm: FeatureContainer, mol: Chem.Molecule, xform: Math.Matrix4D, pharm_idx: int, mol_idx: int, conf_idx: int) -> None: pass
+
         ##
         # \brief Initializes a copy of the \c %SearchHit instance \a hit.
         # \param hit The \c %SearchHit instance to copy.
@@ -93,8 +107,21 @@ class ScreeningProcessor(Boost.Python.instance):
         # 
         # \return A reference to the hit-providing screening processor.
         # 
+        # \note In multithreaded searches, the database accessor of the screening processor is not the one the hit data were retrieved from
+        #       and must not be used for accessing database records from within hit callbacks. Use getDBAccessor() instead.
+        # 
         def getHitProvider() -> ScreeningProcessor: pass
 
+        ##
+        # \brief Returns the database accessor the hit data were retrieved from.
+        # 
+        # In multithreaded searches, this is the database accessor of the search thread that found the hit which may safely be used
+        # from within hit callbacks invoked for this hit.
+        # 
+        # \return A reference to the database accessor.
+        # 
+        def getDBAccessor() -> ScreeningDBAccessor: pass
+
         ##
         # \brief Returns the query pharmacophore.
         # 
@@ -148,6 +175,8 @@ class ScreeningProcessor(Boost.Python.instance):
 
         hitProvider = property(getHitProvider)
 
+        dbAccessor = property(getDBAccessor)
+
         queryPharmacophore = property(getQueryPharmacophore)
 
         hitPharmacophore = property(getHitPharmacophore)
@@ -293,6 +322,26 @@ class ScreeningProcessor(Boost.Python.instance):
     # 
     def getScoringFunction() -> DoubleSearchHitFunctor: pass
 
+    ##
+    # \brief Specifies the number of threads used by searchDB().
+    # 
+    # If <em>num_threads</em> is greater than <em>1</em>, the molecules of the searched range get distributed dynamically among the threads. Each thread screens on its own clone of the database accessor and its own copy of the scoring function. Accessors implemented in Python and accessors that do not support cloning are always searched by the calling thread only. Invocations of the hit and progress callbacks are serialized but hits are not reported in the order of their database indices.
+    # 
+    # \param num_threads The number of threads (<em>0</em> or <em>1</em> disables multithreading).
+    # 
+    # \since 1.4
+    # 
+    def setNumThreads(num_threads: int) -> None: pass
+
+    ##
+    # \brief Returns the number of threads used by searchDB().
+    # 
+    # \return The number of threads.
+    # 
+    # \since 1.4
+    # 
+    def getNumThreads() -> int: pass
+
     ##
     # \brief Screens the database with the supplied query pharmacophore.
     # 
@@ -321,3 +370,5 @@ class ScreeningProcessor(Boost.Python.instance):
     checkXVolumes = property(xVolumeClashesChecked, checkXVolumeClashes)
 
     bestAlignments = property(bestAlignmentsSeeked, seekBestAlignments)
+
+    numThreads = property(getNumThreads, setNumThreads)
@@ -224,6 +224,7 @@
 #include "CDPL/Chem/JMEMolecularGraphWriter.hpp"
 #include "CDPL/Chem/JMEReactionWriter.hpp"
 #include "CDPL/Chem/SMILESMoleculeReader.hpp"
+#include "CDPL/Chem/SMILESRecordBoundaryFinder.hpp"
 #include "CDPL/Chem/SMILESReactionReader.hpp"
 #include "CDPL/Chem/SMILESMolecularGraphWriter.hpp"
 #include "CDPL/Chem/SMILESReactionWriter.hpp"
@@ -234,6 +235,7 @@
 #include "CDPL/Chem/MOLMoleculeReader.hpp"
 #include "CDPL/Chem/MOLMolecularGraphWriter.hpp"
 #include "CDPL/Chem/SDFMoleculeReader.hpp"
+#include "CDPL/Chem/SDFRecordBoundaryFinder.hpp"
 #include "CDPL/Chem/SDFMolecularGraphWriter.hpp"
 #include "CDPL/Chem/RXNReactionReader.hpp"
 #include "CDPL/Chem/RXNReactionWriter.hpp"
@@ -272,6 +274,8 @@
 #include "CDPL/Chem/MaxCommonBondSubstructureSearch.hpp"
 #include "CDPL/Chem/AutomorphismGroupSearch.hpp"
 #include "CDPL/Chem/MultiSubstructureSearch.hpp"
+#include "CDPL/Chem/SubstructureScreeningKeyGenerator.hpp"
+#include "CDPL/Chem/SubstructureScreeningIndex.hpp"
 #include "CDPL/Chem/Reactor.hpp"
 #include "CDPL/Chem/SubstructureEditor.hpp"
 #include "CDPL/Chem/MorganNumberingCalculator.hpp"
@@ -32,6 +32,8 @@
 #include "CDPL/Chem/DataFormat.hpp"
 #include "CDPL/Chem/CDFMoleculeReader.hpp"
 #include "CDPL/Util/DefaultDataInputHandler.hpp"
+#include "CDPL/Util/FileDataReader.hpp"
+#include "CDPL/Util/MappedFileIStream.hpp"
 
 
 namespace CDPL
@@ -42,8 +44,12 @@ namespace CDPL
 
         /**
          * \brief Handler for the input of molecule data in the native I/O format of the <em>%CDPL</em>.
+         *
+         * Files are read via a memory-mapped Util::MappedFileIStream, which lets the record data get decoded
+         * directly from the mapped file pages.
          */
-        typedef Util::DefaultDataInputHandler<CDFMoleculeReader, DataFormat::CDF> CDFMoleculeInputHandler;
+        typedef Util::DefaultDataInputHandler<CDFMoleculeReader, DataFormat::CDF, Molecule,
+                                              Util::FileDataReader<CDFMoleculeReader, Molecule, Util::MappedFileIStream> > CDFMoleculeInputHandler;
     } // namespace Chem
 } // namespace CDPL
 
@@ -32,6 +32,8 @@
 #include "CDPL/Chem/DataFormat.hpp"
 #include "CDPL/Chem/CDFReactionReader.hpp"
 #include "CDPL/Util/DefaultDataInputHandler.hpp"
+#include "CDPL/Util/FileDataReader.hpp"
+#include "CDPL/Util/MappedFileIStream.hpp"
 
 
 namespace CDPL
@@ -42,8 +44,12 @@ namespace CDPL
 
         /**
          * \brief Handler for the input of reaction data in the native I/O format of the <em>%CDPL</em>.
+         *
+         * Files are read via a memory-mapped Util::MappedFileIStream, which lets the record data get decoded
+         * directly from the mapped file pages.
          */
-        typedef Util::DefaultDataInputHandler<CDFReactionReader, DataFormat::CDF> CDFReactionInputHandler;
+        typedef Util::DefaultDataInputHandler<CDFReactionReader, DataFormat::CDF, Reaction,
+                                              Util::FileDataReader<CDFReactionReader, Reaction, Util::MappedFileIStream> > CDFReactionInputHandler;
     } // namespace Chem
 } // namespace CDPL
 
@@ -30,6 +30,7 @@
 #define CDPL_CHEM_CMLMOLECULEREADER_HPP
 
 #include <memory>
+#include <string>
 
 #include "CDPL/Chem/APIPrefix.hpp"
 #include "CDPL/Util/StreamDataReader.hpp"
@@ -75,6 +76,8 @@ namespace CDPL
             bool skipData(std::istream&);
             bool moreData(std::istream&);
 
+            std::string getRecordLayoutSettings() const;
+
             typedef std::unique_ptr<CMLDataReader> CMLDataReaderPtr;
 
             CMLDataReaderPtr reader;
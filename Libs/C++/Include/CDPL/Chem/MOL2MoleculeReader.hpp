@@ -30,6 +30,7 @@
 #define CDPL_CHEM_MOL2MOLECULEREADER_HPP
 
 #include <memory>
+#include <string>
 
 #include "CDPL/Chem/APIPrefix.hpp"
 #include "CDPL/Util/StreamDataReader.hpp"
@@ -74,6 +75,8 @@ namespace CDPL
             bool skipData(std::istream&);
             bool moreData(std::istream&);
 
+            std::string getRecordLayoutSettings() const;
+
             typedef std::unique_ptr<MOL2DataReader> MOL2DataReaderPtr;
 
             MOL2DataReaderPtr reader;
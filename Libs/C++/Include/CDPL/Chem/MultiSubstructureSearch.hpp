@@ -36,6 +36,8 @@
 
 #include "CDPL/Chem/APIPrefix.hpp"
 #include "CDPL/Chem/MolecularGraph.hpp"
+#include "CDPL/Chem/SubstructureScreeningKeyGenerator.hpp"
+#include "CDPL/Util/BitSet.hpp"
 
 
 namespace CDPL
@@ -80,12 +82,45 @@ namespace CDPL
 
             /**
              * \brief Evaluates the configured boolean substructure expression against the target molecular graph \a molgraph.
+             *
+             * The substructure screening keys of \a molgraph (see Chem::SubstructureScreeningKeyGenerator) are calculated
+             * once and shared by all substructure queries to avoid substructure searches for queries that cannot match.
+             *
              * \param molgraph The target molecular graph.
              * \return \c true if the boolean expression evaluates to true for \a molgraph, and \c false otherwise
              *         (also \c false when no expression has been compiled by setup() yet).
              */
             bool matches(const MolecularGraph& molgraph);
 
+            /**
+             * \brief Evaluates the configured boolean substructure expression against the target molecular graph \a molgraph
+             *        using the precomputed substructure screening keys \a tgt_keys of \a molgraph for pruning.
+             *
+             * Substructure queries whose screening keys (see Chem::SubstructureScreeningKeyGenerator) are not a subset of \a tgt_keys
+             * are considered as not matching without performing an actual substructure search. An empty \a tgt_keys bitset
+             * disables screening.
+             *
+             * \param molgraph The target molecular graph.
+             * \param tgt_keys The screening keys of \a molgraph.
+             * \return \c true if the boolean expression evaluates to true for \a molgraph, and \c false otherwise.
+             * \since 1.4
+             */
+            bool matches(const MolecularGraph& molgraph, const Util::BitSet& tgt_keys);
+
+            /**
+             * \brief Checks whether a target molecular graph with the substructure screening keys \a tgt_keys may satisfy the
+             *        configured boolean substructure expression.
+             *
+             * The expression is evaluated in three-valued logic where the result of each substructure query is either
+             * <em>no match</em> (query keys are not a subset of \a tgt_keys) or <em>unknown</em>.
+             *
+             * \param tgt_keys The screening keys of the target molecular graph.
+             * \return \c false if the target molecular graph can be safely rejected without performing any substructure searches,
+             *         and \c true otherwise.
+             * \since 1.4
+             */
+            bool screen(const Util::BitSet& tgt_keys);
+
             /**
              * \brief Appends a substructure query to the internal substructure list.
              *
@@ -142,11 +177,13 @@ namespace CDPL
             void validateTerm(const std::string& expr, std::size_t max_substr_id);
             void validateFactor(const std::string& expr, std::size_t max_substr_id);
 
-            MolGraphPtrArray substructures;
-            std::size_t      nextTokenStart;
-            Token            currToken;
-            std::size_t      substrID;
-            ExprTreeNodePtr  exprTree;
+            MolGraphPtrArray                  substructures;
+            std::size_t                       nextTokenStart;
+            Token                             currToken;
+            std::size_t                       substrID;
+            ExprTreeNodePtr                   exprTree;
+            SubstructureScreeningKeyGenerator keyGenerator;
+            Util::BitSet                      targetKeys;
         };
     } // namespace Chem
 } // namespace CDPL
@@ -36,6 +36,7 @@
 #include "CDPL/Chem/APIPrefix.hpp"
 #include "CDPL/Chem/MolecularGraph.hpp"
 #include "CDPL/Chem/SubstructureSearch.hpp"
+#include "CDPL/Chem/SubstructureScreeningKeyGenerator.hpp"
 #include "CDPL/Util/BitSet.hpp"
 
 
@@ -52,6 +53,12 @@ namespace CDPL
          * match-handling flags). On execute() the typer iterates the registered patterns in priority order,
          * runs each as a substructure query and assigns the corresponding atom label to every matched atom
          * unless the atom has already received a label from a pattern with higher priority.
+         *
+         * Each pattern is compiled once into its own Chem::SubstructureSearch instance that gets re-initialized only if
+         * the query molecular graph of the pattern has been replaced or modified. The substructure screening keys
+         * (see Chem::SubstructureScreeningKeyGenerator) of the processed molecular graph are calculated in a single pass
+         * and used to skip all patterns whose keys prove that they cannot match. The patterns are still searched one after
+         * another; a combined single-pass matching of all patterns is not performed.
          */
         class CDPL_CHEM_API PatternAtomTyper
         {
@@ -60,8 +67,12 @@ namespace CDPL
             class Pattern;
 
           private:
-            typedef std::vector<Pattern>     PatternList;
-            typedef std::vector<std::size_t> SizeTypeArray;
+            class PatternSearch;
+
+            typedef std::vector<Pattern>           PatternList;
+            typedef std::vector<std::size_t>       SizeTypeArray;
+            typedef std::shared_ptr<PatternSearch> PatternSearchPtr;
+            typedef std::vector<PatternSearchPtr>  PatternSearchList;
 
           public:
             /**
@@ -291,16 +302,19 @@ namespace CDPL
 
           private:
             void init(const MolecularGraph& molgraph);
+            void initPatternSearches();
 
             void processPattern(const Pattern& ptn, std::size_t ptn_idx);
             bool processMatch(const AtomMapping& mapping, const Pattern& ptn, std::size_t ptn_idx);
 
-            const MolecularGraph* molGraph;
-            PatternList           patterns;
-            SizeTypeArray         atomLabeling;
-            SizeTypeArray         matchingPatternIndices;
-            SubstructureSearch    subSearch;
-            Util::BitSet          labeledAtomMask;
+            const MolecularGraph*             molGraph;
+            PatternList                       patterns;
+            SizeTypeArray                     atomLabeling;
+            SizeTypeArray                     matchingPatternIndices;
+            PatternSearchList                 patternSearches;
+            SubstructureScreeningKeyGenerator keyGenerator;
+            Util::BitSet                      molGraphKeys;
+            Util::BitSet                      labeledAtomMask;
         };
     } // namespace Chem
 } // namespace CDPL
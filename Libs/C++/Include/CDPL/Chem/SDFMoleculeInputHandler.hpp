@@ -31,7 +31,10 @@
 
 #include "CDPL/Chem/DataFormat.hpp"
 #include "CDPL/Chem/SDFMoleculeReader.hpp"
+#include "CDPL/Chem/SDFRecordBoundaryFinder.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
 #include "CDPL/Util/DefaultDataInputHandler.hpp"
+#include "CDPL/Util/ParallelFileDataReader.hpp"
 
 
 namespace CDPL
@@ -42,8 +45,14 @@ namespace CDPL
 
         /**
          * \brief Handler for the input of molecule data in the <em>MDL SD-File</em> [\ref CTFILE] format.
+         *
+         * Files are read by a Util::ParallelFileDataReader (see Util::ControlParameter::NUM_READER_THREADS). Parallel reading
+         * requires the import of multi-conformer molecules to be disabled (see Chem::ControlParameter::MULTI_CONF_IMPORT),
+         * otherwise the records are read sequentially.
          */
-        typedef Util::DefaultDataInputHandler<SDFMoleculeReader, DataFormat::SDF> SDFMoleculeInputHandler;
+        typedef Util::DefaultDataInputHandler<SDFMoleculeReader, DataFormat::SDF, Molecule,
+                                              Util::ParallelFileDataReader<SDFMoleculeReader, SDFRecordBoundaryFinder, BasicMolecule> >
+            SDFMoleculeInputHandler;
     } // namespace Chem
 } // namespace CDPL
 
@@ -0,0 +1,98 @@
+/*
+ * SDFRecordBoundaryFinder.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of class CDPL::Chem::SDFRecordBoundaryFinder.
+ */
+
+#ifndef CDPL_CHEM_SDFRECORDBOUNDARYFINDER_HPP
+#define CDPL_CHEM_SDFRECORDBOUNDARYFINDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CDPL/Chem/APIPrefix.hpp"
+
+
+namespace CDPL
+{
+
+    namespace Base
+    {
+
+        class ControlParameterContainer;
+    }
+
+    namespace Chem
+    {
+
+        /**
+         * \brief Locates the start positions of the records of in-memory <em>MDL SD-File</em> [\ref CTFILE] data.
+         *
+         * Records are considered to be terminated by lines starting with the record delimiter <tt>$$$$</tt>.
+         * Used by Util::ParallelFileDataReader for the parallel reading of SD-files.
+         *
+         * \note Since the grouping of consecutive records into multi-conformer molecules requires the records to be
+         *       parsed, the record boundaries can only be located if the import of multi-conformer molecules is disabled
+         *       (see Chem::ControlParameter::MULTI_CONF_IMPORT which is enabled by default). Otherwise, SD-files are
+         *       read sequentially.
+         *
+         * \since 1.4
+         */
+        class CDPL_CHEM_API SDFRecordBoundaryFinder
+        {
+
+          public:
+            /**
+             * \brief Checks whether the SD-file records will map to the data records delivered by a reader using the
+             *        control-parameter settings \a params.
+             *
+             * This is not the case if the import of multi-conformer molecules is enabled (see
+             * Chem::ControlParameter::MULTI_CONF_IMPORT) since consecutive SD-file records may then get merged.
+             *
+             * \param params The control-parameters of the reader.
+             * \return \c true if the record boundaries can be located by this finder, and \c false otherwise.
+             */
+            bool init(const Base::ControlParameterContainer& params);
+
+            /**
+             * \brief Appends the start positions of all records following a record delimiter line starting
+             *        within the range [\a from, \a to) of \a data to \a rec_starts.
+             *
+             * Delimiter lines that are only followed by whitespace do not start a new record.
+             *
+             * \param data The SD-file data.
+             * \param size The size of \a data in bytes.
+             * \param from The start of the byte range to scan.
+             * \param to The end of the byte range to scan.
+             * \param rec_starts The array that receives the record start positions.
+             */
+            void operator()(const char* data, std::size_t size, std::size_t from, std::size_t to,
+                            std::vector<std::uint64_t>& rec_starts) const;
+        };
+    } // namespace Chem
+} // namespace CDPL
+
+#endif // CDPL_CHEM_SDFRECORDBOUNDARYFINDER_HPP
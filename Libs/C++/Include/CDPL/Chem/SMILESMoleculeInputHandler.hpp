@@ -31,7 +31,10 @@
 
 #include "CDPL/Chem/DataFormat.hpp"
 #include "CDPL/Chem/SMILESMoleculeReader.hpp"
+#include "CDPL/Chem/SMILESRecordBoundaryFinder.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
 #include "CDPL/Util/DefaultDataInputHandler.hpp"
+#include "CDPL/Util/ParallelFileDataReader.hpp"
 
 
 namespace CDPL
@@ -42,8 +45,12 @@ namespace CDPL
 
         /**
          * \brief Handler for the input of molecule data in the <em>Daylight SMILES</em> [\ref SMILES] format.
+         *
+         * Files are read by a Util::ParallelFileDataReader (see Util::ControlParameter::NUM_READER_THREADS).
          */
-        typedef Util::DefaultDataInputHandler<SMILESMoleculeReader, DataFormat::SMILES> SMILESMoleculeInputHandler;
+        typedef Util::DefaultDataInputHandler<SMILESMoleculeReader, DataFormat::SMILES, Molecule,
+                                              Util::ParallelFileDataReader<SMILESMoleculeReader, SMILESRecordBoundaryFinder, BasicMolecule> >
+            SMILESMoleculeInputHandler;
     } // namespace Chem
 } // namespace CDPL
 
@@ -30,6 +30,7 @@
 #define CDPL_CHEM_SMILESREACTIONREADER_HPP
 
 #include <memory>
+#include <string>
 
 #include "CDPL/Chem/APIPrefix.hpp"
 #include "CDPL/Util/StreamDataReader.hpp"
@@ -74,6 +75,8 @@ namespace CDPL
             bool skipData(std::istream&);
             bool moreData(std::istream&);
 
+            std::string getRecordLayoutSettings() const;
+
             typedef std::unique_ptr<SMILESDataReader> SMILESDataReaderPtr;
 
             SMILESDataReaderPtr reader;
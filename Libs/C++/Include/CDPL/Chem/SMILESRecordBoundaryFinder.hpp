@@ -0,0 +1,94 @@
+/*
+ * SMILESRecordBoundaryFinder.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of class CDPL::Chem::SMILESRecordBoundaryFinder.
+ */
+
+#ifndef CDPL_CHEM_SMILESRECORDBOUNDARYFINDER_HPP
+#define CDPL_CHEM_SMILESRECORDBOUNDARYFINDER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CDPL/Chem/APIPrefix.hpp"
+
+
+namespace CDPL
+{
+
+    namespace Base
+    {
+
+        class ControlParameterContainer;
+    }
+
+    namespace Chem
+    {
+
+        /**
+         * \brief Locates the start positions of the records of in-memory <em>Daylight SMILES</em> [\ref SMILES] data.
+         *
+         * Records are considered to be terminated by the character specified by the control-parameter
+         * Chem::ControlParameter::RECORD_SEPARATOR (or by a newline character if the separator is not a single character).
+         * Used by Util::ParallelFileDataReader for the parallel reading of SMILES files.
+         *
+         * \since 1.4
+         */
+        class CDPL_CHEM_API SMILESRecordBoundaryFinder
+        {
+
+          public:
+            /**
+             * \brief Constructs and initializes a \c %SMILESRecordBoundaryFinder instance.
+             */
+            SMILESRecordBoundaryFinder();
+
+            /**
+             * \brief Retrieves the record separator character from the control-parameter settings \a params.
+             * \param params The control-parameters of the reader.
+             * \return Always \c true.
+             */
+            bool init(const Base::ControlParameterContainer& params);
+
+            /**
+             * \brief Appends the start positions of all records following a record separator located 
+             *        within the range [\a from, \a to) of \a data to \a rec_starts.
+             * \param data The SMILES data.
+             * \param size The size of \a data in bytes.
+             * \param from The start of the byte range to scan.
+             * \param to The end of the byte range to scan.
+             * \param rec_starts The array that receives the record start positions.
+             */
+            void operator()(const char* data, std::size_t size, std::size_t from, std::size_t to,
+                            std::vector<std::uint64_t>& rec_starts) const;
+
+          private:
+            char separator;
+        };
+    } // namespace Chem
+} // namespace CDPL
+
+#endif // CDPL_CHEM_SMILESRECORDBOUNDARYFINDER_HPP
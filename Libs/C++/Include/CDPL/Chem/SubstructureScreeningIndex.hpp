@@ -0,0 +1,168 @@
+/* 
+ * SubstructureScreeningIndex.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of class CDPL::Chem::SubstructureScreeningIndex.
+ */
+
+#ifndef CDPL_CHEM_SUBSTRUCTURESCREENINGINDEX_HPP
+#define CDPL_CHEM_SUBSTRUCTURESCREENINGINDEX_HPP
+
+#include <string>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+#include "CDPL/Chem/APIPrefix.hpp"
+#include "CDPL/Util/BitSet.hpp"
+
+
+namespace boost
+{
+
+    namespace iostreams
+    {
+
+        class mapped_file_source;
+    }
+} // namespace boost
+
+
+namespace CDPL
+{
+
+    namespace Chem
+    {
+
+        /**
+         * \brief Provides read access to memory-mapped files storing the substructure screening keys of the
+         *        molecules in an input file.
+         *
+         * A screening index file stores for each record of a molecule input file the keys generated by
+         * Chem::SubstructureScreeningKeyGenerator, together with the number of key bits and a stamp of the input file
+         * state (see Util::calcFileStamp()). Index files are only considered valid if both values match the ones
+         * specified on opening.
+         *
+         * \since 1.4
+         */
+        class CDPL_CHEM_API SubstructureScreeningIndex
+        {
+
+          public:
+            /**
+             * \brief Constructs a \c %SubstructureScreeningIndex instance that is not associated with a file.
+             */
+            SubstructureScreeningIndex();
+
+            /**
+             * \brief Destructor.
+             */
+            ~SubstructureScreeningIndex();
+
+            /**
+             * \brief Memory-maps the index file \a path and checks whether it matches the specified data source state.
+             * \param path The path of the index file.
+             * \param src_stamp The stamp of the data source the index file has to belong to.
+             * \param num_bits The number of key bits the index file has to provide.
+             * \return \c true if the file could be opened and is valid, and \c false otherwise.
+             */
+            bool open(const std::string& path, std::uint64_t src_stamp, std::size_t num_bits);
+
+            /**
+             * \brief Unmaps the currently opened index file.
+             */
+            void close();
+
+            /**
+             * \brief Tells whether a valid index file is currently opened.
+             * \return \c true if a file is opened, and \c false otherwise.
+             */
+            bool isOpen() const;
+
+            /**
+             * \brief Returns the number of records whose keys are stored in the opened file.
+             * \return The number of records.
+             */
+            std::size_t getNumRecords() const;
+
+            /**
+             * \brief Returns the number of key bits stored per record.
+             * \return The number of key bits.
+             */
+            std::size_t getNumBits() const;
+
+            /**
+             * \brief Retrieves the screening keys of the record with index \a idx.
+             * \param idx The zero-based record index.
+             * \param keys The bitset storing the retrieved keys.
+             */
+            void getKeys(std::size_t idx, Util::BitSet& keys) const;
+
+            /**
+             * \brief Returns the number of 64-bit words required for the storage of \a num_bits key bits.
+             * \param num_bits The number of key bits.
+             * \return The number of required words.
+             */
+            static std::size_t getNumWords(std::size_t num_bits);
+
+            /**
+             * \brief Packs the bits of \a keys into the array of 64-bit words \a words.
+             * \param keys The keys to pack.
+             * \param words A pointer to the output array of at least getNumWords(keys.size()) words.
+             */
+            static void packKeys(const Util::BitSet& keys, std::uint64_t* words);
+
+            /**
+             * \brief Writes an index file.
+             *
+             * The data get written to a temporary file in the directory of \a path that is renamed to \a path
+             * after all data have been written. Concurrent processes will thus never see incomplete files.
+             *
+             * \param path The path of the index file.
+             * \param src_stamp The stamp of the data source the keys refer to.
+             * \param num_bits The number of key bits per record.
+             * \param words A pointer to the array of packed record keys (see packKeys()).
+             * \param num_records The number of records.
+             * \return \c true if the file was written successfully, and \c false otherwise.
+             */
+            static bool write(const std::string& path, std::uint64_t src_stamp, std::size_t num_bits,
+                              const std::uint64_t* words, std::size_t num_records);
+
+          private:
+            SubstructureScreeningIndex(const SubstructureScreeningIndex&);
+
+            SubstructureScreeningIndex& operator=(const SubstructureScreeningIndex&);
+
+            typedef boost::iostreams::mapped_file_source MappedFile;
+            typedef std::unique_ptr<MappedFile>          MappedFilePtr;
+
+            MappedFilePtr        mappedFile;
+            const std::uint64_t* keyWords;
+            std::size_t          numRecords;
+            std::size_t          numBits;
+        };
+    } // namespace Chem
+} // namespace CDPL
+
+#endif // CDPL_CHEM_SUBSTRUCTURESCREENINGINDEX_HPP
@@ -0,0 +1,121 @@
+/* 
+ * SubstructureScreeningKeyGenerator.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of class CDPL::Chem::SubstructureScreeningKeyGenerator.
+ */
+
+#ifndef CDPL_CHEM_SUBSTRUCTURESCREENINGKEYGENERATOR_HPP
+#define CDPL_CHEM_SUBSTRUCTURESCREENINGKEYGENERATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CDPL/Chem/APIPrefix.hpp"
+#include "CDPL/Util/BitSet.hpp"
+
+
+namespace CDPL
+{
+
+    namespace Chem
+    {
+
+        class MolecularGraph;
+
+        /**
+         * \brief Generation of fingerprint-like key sets for the fast screening of substructure search targets.
+         *
+         * The generated keys encode counts of element-specific atoms, bonds (atom type pairs) and two-bond paths
+         * (atom type triples) that get hashed into a bitset of configurable size. Keys of a query molecular graph are
+         * derived from the match constraints of its atoms (see generateQueryKeys()) and only comprise features that every
+         * matching target is guaranteed to exhibit. Thus, a target can only contain the query if the target keys are a
+         * superset of the query keys (bitwise superset test), and the expensive atom-by-atom matching can be skipped
+         * for all targets failing this test.
+         *
+         * \since 1.4
+         */
+        class CDPL_CHEM_API SubstructureScreeningKeyGenerator
+        {
+
+          public:
+            /**
+             * \brief The default number of key bits.
+             */
+            static constexpr std::size_t DEF_NUM_BITS = 512;
+
+            /**
+             * \brief Constructs the \c %SubstructureScreeningKeyGenerator instance.
+             * \param num_bits The number of key bits.
+             */
+            SubstructureScreeningKeyGenerator(std::size_t num_bits = DEF_NUM_BITS);
+
+            /**
+             * \brief Sets the number of key bits.
+             * \param num_bits The number of key bits.
+             */
+            void setNumBits(std::size_t num_bits);
+
+            /**
+             * \brief Returns the number of key bits.
+             * \return The number of key bits.
+             */
+            std::size_t getNumBits() const;
+
+            /**
+             * \brief Generates the screening keys of the target molecular graph \a molgraph.
+             * \param molgraph The target molecular graph.
+             * \param keys The bitset storing the generated keys.
+             */
+            void generate(const MolecularGraph& molgraph, Util::BitSet& keys);
+
+            /**
+             * \brief Generates the screening keys of the substructure query molecular graph \a molgraph.
+             *
+             * The atom types required by the query atoms are derived from the atom match constraints (see
+             * Chem::getMatchConstraints()). Atoms that may match more than one element do not contribute to the keys.
+             *
+             * \param molgraph The query molecular graph.
+             * \param keys The bitset storing the generated keys.
+             */
+            void generateQueryKeys(const MolecularGraph& molgraph, Util::BitSet& keys);
+
+          private:
+            void generate(const MolecularGraph& molgraph, Util::BitSet& keys, bool query);
+
+            void addFeature(std::uint64_t kind, unsigned int type1, unsigned int type2 = 0, unsigned int type3 = 0);
+
+            typedef std::vector<unsigned int>  AtomTypeArray;
+            typedef std::vector<std::uint64_t> FeatureArray;
+
+            std::size_t   numBits;
+            AtomTypeArray atomTypes;
+            AtomTypeArray nbrAtomTypes;
+            FeatureArray  features;
+        };
+    } // namespace Chem
+} // namespace CDPL
+
+#endif // CDPL_CHEM_SUBSTRUCTURESCREENINGKEYGENERATOR_HPP
@@ -30,12 +30,12 @@
 #define CDPL_CHEM_SUBSTRUCTURESEARCH_HPP
 
 #include <vector>
-#include <deque>
 #include <set>
 #include <cstddef>
 #include <unordered_map>
 #include <memory>
 #include <functional>
+#include <utility>
 
 #include <boost/iterator/indirect_iterator.hpp>
 
@@ -68,6 +68,11 @@ namespace CDPL
          * / Chem::MolecularGraphProperty objects). Result accumulation is bounded by setMaxNumMappings()
          * and uniqueMappingsOnly(); the search can also be aborted from a callback via stopSearch().
          *
+         * All data that only depend on the query (match expressions, query atom neighborhoods) are set up once after
+         * a call to setQuery() and all per-target working storage is retained between searches. Searching a single query
+         * against a large number of targets therefore does not perform any heap allocations once the internal buffers have
+         * grown to the size of the largest target (unless mappings have to be stored or checked for uniqueness).
+         *
          * \see [\ref VFLIB2]
          */
         class CDPL_CHEM_API SubstructureSearch
@@ -346,10 +351,18 @@ namespace CDPL
             void clearBondMappingConstraints();
 
           private:
+            typedef std::vector<std::size_t>            IndexArray;
+            typedef std::pair<std::size_t, std::size_t> AtomBondIndexPair;
+            typedef std::vector<AtomBondIndexPair>      AtomBondIndexPairArray;
+
             bool init(const MolecularGraph&);
 
             void initMatchExpressions();
 
+            void initNeighborLists(const MolecularGraph&, IndexArray&, AtomBondIndexPairArray&) const;
+
+            std::size_t findTargetBond(std::size_t, std::size_t) const;
+
             bool findEquivAtoms();
             bool findEquivBonds();
 
@@ -402,9 +415,6 @@ namespace CDPL
             };
 
             typedef std::vector<Util::BitSet>                         BitMatrix;
-            typedef std::vector<const Atom*>                          AtomMappingTable;
-            typedef std::vector<const Bond*>                          BondMappingTable;
-            typedef std::deque<std::size_t>                           AtomQueue;
             typedef std::set<ABMappingMask>                           UniqueMappingList;
             typedef std::vector<const Atom*>                          AtomList;
             typedef std::vector<const Bond*>                          BondList;
@@ -422,9 +432,15 @@ namespace CDPL
             BitMatrix                             bondEquivMatrix;
             MappingConstraintMap                  atomMappingConstrs;
             MappingConstraintMap                  bondMappingConstrs;
-            AtomQueue                             termQueryAtoms;
-            AtomMappingTable                      queryAtomMapping;
-            BondMappingTable                      queryBondMapping;
+            IndexArray                            termQueryAtoms;
+            std::size_t                           termQueryAtomsHead;
+            std::size_t                           termQueryAtomsTail;
+            IndexArray                            queryAtomMapping;
+            IndexArray                            queryBondMapping;
+            IndexArray                            queryNbrListOffsets;
+            AtomBondIndexPairArray                queryNbrLists;
+            IndexArray                            targetNbrListOffsets;
+            AtomBondIndexPairArray                targetNbrLists;
             Util::BitSet                          queryMappingMask;
             ABMappingMask                         targetMappingMask;
             ABMappingList                         foundMappings;
@@ -30,6 +30,7 @@
 #define CDPL_CHEM_XYZMOLECULEREADER_HPP
 
 #include <memory>
+#include <string>
 
 #include "CDPL/Chem/APIPrefix.hpp"
 #include "CDPL/Util/StreamDataReader.hpp"
@@ -80,6 +81,8 @@ namespace CDPL
             bool skipData(std::istream&);
             bool moreData(std::istream&);
 
+            std::string getRecordLayoutSettings() const;
+
             typedef std::unique_ptr<XYZDataReader> XYZDataReaderPtr;
 
             XYZDataReaderPtr reader;
@@ -36,6 +36,7 @@
 #include "CDPL/ConfGen/CanonicalFragment.hpp"
 #include "CDPL/ConfGen/FragmentLibrary.hpp"
 #include "CDPL/ConfGen/FragmentLibraryEntry.hpp"
+#include "CDPL/ConfGen/FragmentConformerCache.hpp"
 #include "CDPL/ConfGen/TorsionRule.hpp"
 #include "CDPL/ConfGen/TorsionCategory.hpp"
 #include "CDPL/ConfGen/TorsionLibrary.hpp"
@@ -40,6 +40,7 @@
 #include "CDPL/ConfGen/ConformerGeneratorSettings.hpp"
 #include "CDPL/ConfGen/FragmentLibrary.hpp"
 #include "CDPL/ConfGen/TorsionLibrary.hpp"
+#include "CDPL/Util/ThreadPool.hpp"
 
 
 namespace CDPL
@@ -146,6 +147,26 @@ namespace CDPL
              */
             const CallbackFunction& getAbortCallback() const;
 
+            /**
+             * \brief Specifies a thread pool providing the additional threads for multithreaded stochastic conformer sampling.
+             *
+             * If a thread pool has been specified, the additional threads (see ConformerGeneratorSettings::setNumThreads())
+             * are not created for each molecule but taken from the threads of \a pool that are idle at the start of the sampling.
+             * Multiple conformer generators can share a pool (which may also run their calling threads) in order to keep
+             * the overall number of threads within the pool size.
+             *
+             * \param pool The thread pool or a null pointer if threads shall be created on demand.
+             * \since 1.4
+             */
+            void setThreadPool(const Util::ThreadPool::SharedPointer& pool);
+
+            /**
+             * \brief Returns the thread pool providing the additional threads for multithreaded stochastic conformer sampling.
+             * \return A reference to the pointer to the thread pool.
+             * \since 1.4
+             */
+            const Util::ThreadPool::SharedPointer& getThreadPool() const;
+
             /**
              * \brief Sets the callback invoked periodically to check whether the configured timeout has elapsed.
              * \param func The timeout-check callback.
@@ -287,6 +287,30 @@ namespace CDPL
              */
             bool strictForceFieldParameterization() const;
 
+            /**
+             * \brief Specifies whether the MMFF94 energy and gradient calculations shall be performed by the packed force field calculators.
+             *
+             * If enabled, the energy minimizations of stochastic sampling and input coordinate processing use
+             * ForceField::MMFF94PackedGradientCalculator instead of ForceField::MMFF94GradientCalculator<double>, and the
+             * torsion driving of systematic sampling uses ForceField::MMFF94PackedEnergyCalculator instead of
+             * ForceField::MMFF94EnergyCalculator<double>. The packed calculators evaluate most interactions by vectorized
+             * kernels and are thus faster on CPUs supporting the AVX2 instruction set, but their results may deviate from the
+             * ones of the generic calculators within floating point rounding errors. These deviations may propagate into differing
+             * sets of generated conformers. By default, the generic calculators are used. The calculators used for the generation
+             * of ring system conformers are selected via the fragment build settings (see getFragmentBuildSettings()).
+             *
+             * \param packed If \c true, the packed force field calculators are used, and the generic ones otherwise.
+             * \since 1.4
+             */
+            void packedForceFieldEvaluation(bool packed);
+
+            /**
+             * \brief Tells whether the MMFF94 energy and gradient calculations are performed by the packed force field calculators.
+             * \return \c true if the packed force field calculators are used, and \c false otherwise.
+             * \since 1.4
+             */
+            bool packedForceFieldEvaluation() const;
+
             /**
              * \brief Sets the dielectric constant used by the MMFF94 electrostatic interactions.
              * \param de_const The new dielectric constant.
@@ -447,6 +471,33 @@ namespace CDPL
              */
             std::size_t getMacrocycleRotorBondCountThreshold() const;
 
+            /**
+             * \brief Specifies the maximum number of threads that may be used to generate the conformers of a single molecule.
+             *
+             * If \a num_threads is greater than \e 1, the structure generation trials of stochastic conformer sampling
+             * (and distance geometry based structure generation) get distributed among the calling thread and
+             * <em>num_threads - 1</em> additional threads (at most as many as there are idle threads in the thread pool specified
+             * via ConformerGenerator::setThreadPool(), if any). Since the order in which the threads deliver their results is
+             * not deterministic, the generated conformer ensembles may differ slightly between runs. In systematic sampling mode,
+             * the conformers of different torsion fragments (including the conformers of the contained ring systems) and of
+             * independent branches of the torsion driving fragment trees get generated concurrently. The generated conformers
+             * are the same as in single-threaded mode. If no thread pool has been specified, the additional threads
+             * of systematic sampling are provided by a thread pool owned by the conformer generator. Abort, timeout and log
+             * message callbacks are only invoked by the calling thread.
+             *
+             * \param num_threads The maximum number of threads (\e 0 or \e 1 disables multithreading).
+             * \note The default is \e 0.
+             * \since 1.4
+             */
+            void setNumThreads(std::size_t num_threads);
+
+            /**
+             * \brief Returns the maximum number of threads that may be used to generate the conformers of a single molecule.
+             * \return The maximum number of threads.
+             * \since 1.4
+             */
+            std::size_t getNumThreads() const;
+
             /**
              * \brief Returns a reference to the nested fragment conformer build settings.
              * \return A reference to the build settings.
@@ -483,6 +534,7 @@ namespace CDPL
             unsigned int                       forceFieldTypeSys;
             unsigned int                       forceFieldTypeStoch;
             bool                               strictParam;
+            bool                               packedFFEval;
             double                             dielectricConst;
             double                             distExponent;
             std::size_t                        maxNumOutputConfs;
@@ -494,6 +546,7 @@ namespace CDPL
             std::size_t                        maxNumSampledConfs;
             std::size_t                        convCheckCycleSize;
             std::size_t                        mcRotorBondCountThresh;
+            std::size_t                        numThreads;
             FragmentConformerGeneratorSettings fragBuildSettings;
         };
     }; // namespace ConfGen
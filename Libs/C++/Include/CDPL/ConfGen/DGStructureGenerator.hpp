@@ -85,6 +85,23 @@ namespace CDPL
              */
             const Util::BitSet& getExcludedHydrogenMask() const;
 
+            /**
+             * \brief Sets the seed of the random number generators used for the generation of initial coordinates.
+             *
+             * The random number generators get reseeded with the current seed whenever setup() is called.
+             *
+             * \param seed The new random seed.
+             * \since 1.4
+             */
+            void setRandomSeed(unsigned int seed);
+
+            /**
+             * \brief Returns the seed of the random number generators used for the generation of initial coordinates.
+             * \return The current random seed.
+             * \since 1.4
+             */
+            unsigned int getRandomSeed() const;
+
             /**
              * \brief Sets up the generator for \a molgraph using geometry defaults derived from each atom's
              *        element number and hybridization state.
@@ -177,6 +194,7 @@ namespace CDPL
             Util::DG3DCoordinatesGenerator phase1CoordsGen;
             Util::DG3DCoordinatesGenerator phase2CoordsGen;
             RandNumEngine                  randomEngine;
+            unsigned int                   randomSeed;
             DGStructureGeneratorSettings   settings;
         };
     } // namespace ConfGen
@@ -0,0 +1,170 @@
+/* 
+ * FragmentConformerCache.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of class CDPL::ConfGen::FragmentConformerCache.
+ */
+
+#ifndef CDPL_CONFGEN_FRAGMENTCONFORMERCACHE_HPP
+#define CDPL_CONFGEN_FRAGMENTCONFORMERCACHE_HPP
+
+#include <iosfwd>
+#include <cstddef>
+
+#include "CDPL/ConfGen/APIPrefix.hpp"
+
+
+namespace CDPL
+{
+
+    namespace ConfGen
+    {
+
+        /**
+         * \brief Provides access to the process-wide cache of generated fragment conformer ensembles.
+         *
+         * Fragment conformer ensembles that had to be generated from scratch during conformer generation are kept
+         * in a cache which is shared by all ConfGen::ConformerGenerator, ConfGen::StructureGenerator and
+         * ConfGen::FragmentAssembler instances of the process. Entries are keyed by the hash code of the
+         * corresponding ConfGen::CanonicalFragment and distributed over a fixed number of independently locked
+         * shards. When the memory consumed by the entries of a shard exceeds its share of the memory budget, the least
+         * recently used entries of the shard get evicted.
+         *
+         * The cache contents can be saved to and restored from a stream in the fragment library format (see
+         * ConfGen::FragmentLibrary) which allows successive jobs to reuse previously generated fragment conformers.
+         * Since the cache entries are not associated with the fragment conformer generation settings that were in
+         * effect when they were created, saved cache contents should only be restored by jobs that employ the same
+         * fragment conformer generation settings.
+         *
+         * \since 1.4
+         */
+        class CDPL_CONFGEN_API FragmentConformerCache
+        {
+
+          public:
+            /**
+             * \brief Usage statistics of the cache or one of its shards.
+             */
+            struct Statistics
+            {
+
+                /**
+                 * \brief The number of stored fragment conformer ensembles.
+                 */
+                std::size_t numEntries;
+
+                /**
+                 * \brief The estimated amount of memory (in bytes) consumed by the stored entries.
+                 */
+                std::size_t memoryUsage;
+
+                /**
+                 * \brief The number of successful entry lookups.
+                 */
+                std::size_t numHits;
+
+                /**
+                 * \brief The number of failed entry lookups.
+                 */
+                std::size_t numMisses;
+
+                /**
+                 * \brief The number of entries that were evicted to stay within the memory budget.
+                 */
+                std::size_t numEvictions;
+            };
+
+            /**
+             * \brief The default memory budget (in bytes).
+             */
+            static constexpr std::size_t DEF_MEMORY_BUDGET = 256 * 1024 * 1024;
+
+            /**
+             * \brief Specifies the maximum amount of memory (in bytes) that may be consumed by the cache entries.
+             *
+             * Entries exceeding the new budget get evicted immediately. A budget of zero disables caching.
+             *
+             * \param num_bytes The memory budget in bytes.
+             * \note The default budget is specified by FragmentConformerCache::DEF_MEMORY_BUDGET.
+             */
+            static void setMemoryBudget(std::size_t num_bytes);
+
+            /**
+             * \brief Returns the maximum amount of memory (in bytes) that may be consumed by the cache entries.
+             * \return The memory budget in bytes.
+             */
+            static std::size_t getMemoryBudget();
+
+            /**
+             * \brief Returns the number of shards the cache entries are distributed over.
+             * \return The number of shards.
+             */
+            static std::size_t getNumShards();
+
+            /**
+             * \brief Returns the usage statistics of the shard with index \a idx.
+             * \param idx The zero-based index of the shard.
+             * \return The usage statistics of the shard.
+             * \throw Base::IndexError if \a idx is not in the range [0, getNumShards() - 1].
+             */
+            static Statistics getStatistics(std::size_t idx);
+
+            /**
+             * \brief Returns the accumulated usage statistics of all shards.
+             * \return The usage statistics of the cache.
+             */
+            static Statistics getStatistics();
+
+            /**
+             * \brief Removes all entries and resets the usage statistics.
+             */
+            static void clear();
+
+            /**
+             * \brief Adds the fragment conformer ensembles read from the input stream \a is to the cache.
+             *
+             * The data are expected to be in the fragment library format. Entries that are already present in the
+             * cache are left unchanged.
+             *
+             * \param is The input stream to read from.
+             * \return The number of added entries.
+             * \throw Base::IOError if an error occurred while reading the data.
+             */
+            static std::size_t load(std::istream& is);
+
+            /**
+             * \brief Writes the cached fragment conformer ensembles to the output stream \a os in the fragment library format.
+             * \param os The output stream to write to.
+             * \return The number of written entries.
+             * \throw Base::IOError if an error occurred while writing the data.
+             */
+            static std::size_t save(std::ostream& os);
+
+          private:
+            FragmentConformerCache() {}
+        };
+    } // namespace ConfGen
+} // namespace CDPL
+
+#endif // CDPL_CONFGEN_FRAGMENTCONFORMERCACHE_HPP
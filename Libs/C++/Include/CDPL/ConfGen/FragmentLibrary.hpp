@@ -31,8 +31,10 @@
 
 #include <iosfwd>
 #include <cstddef>
+#include <string>
 #include <unordered_map>
 #include <mutex>
+#include <shared_mutex>
 #include <memory>
 
 #include "CDPL/ConfGen/APIPrefix.hpp"
@@ -54,6 +56,13 @@ namespace CDPL
          * process-wide default instance via the static set() / get() accessors. A built-in
          * mutex is exposed via getMutex() to allow callers to coordinate concurrent access.
          *
+         * Libraries initialized by loadDefaults() or mapFile() do not decode their entries in advance. Instead,
+         * a sorted index of the entry hash codes is used to locate the encoded entry data, which is decoded on the first
+         * request of the entry by getEntry(). Concurrent calls to getEntry(), containsEntry() and getNumEntries()
+         * are safe, also while entries get added, removed, loaded or saved by other threads. Iterators obtained by
+         * the entry iteration methods are not protected. Methods that iterate over, remove or save the entries first
+         * decode all remaining entries.
+         *
          * \see [\ref CFRG]
          */
         class CDPL_CONFGEN_API FragmentLibrary
@@ -218,8 +227,36 @@ namespace CDPL
              */
             void save(std::ostream& os) const;
 
+            /**
+             * \brief Writes the contents of the library to the output stream \a os in indexed form.
+             *
+             * The entries are written in ascending order of their hash codes and are preceded by a record
+             * that stores the hash code and the file offset of each entry. This record lets mapFile() access
+             * the entries without scanning the file first. load() and other readers of the regular format skip the
+             * index record, so the output remains a valid fragment library file.
+             *
+             * \param os The output stream to write to.
+             * \since 1.4
+             */
+            void saveIndexed(std::ostream& os) const;
+
+            /**
+             * \brief Replaces the contents of the library by the entries of the memory-mapped fragment library file \a file_name.
+             *
+             * The file stays mapped read-only for the lifetime of the library (and its copies), and its pages are shared
+             * by all processes that map the same file. Entries get decoded on the first request only. If the file does
+             * not start with an index record (see saveIndexed()), the index gets built by a scan of the record headers.
+             *
+             * \param file_name The path of the fragment library file.
+             * \throw Base::IOError if the file cannot be mapped or is not a valid fragment library file.
+             * \since 1.4
+             */
+            void mapFile(const std::string& file_name);
+
             /**
              * \brief Loads the default fragment library bundled with CDPKit.
+             *
+             * If the library is empty, the built-in entries get decoded on first request only (see getEntry()).
              */
             void loadDefaults();
 
@@ -242,9 +279,20 @@ namespace CDPL
             static const SharedPointer& get();
 
           private:
-            static SharedPointer   defaultLib;
-            mutable HashToEntryMap hashToEntryMap;
-            mutable std::mutex     mutex;
+            struct EntryIndex;
+
+            typedef std::shared_ptr<const EntryIndex> EntryIndexPointer;
+
+            void setEntryIndex(const EntryIndexPointer& index);
+            bool indexContainsEntry(std::uint64_t hash_code) const;
+            void decodeAllEntries() const;
+
+            static SharedPointer      defaultLib;
+            mutable HashToEntryMap    hashToEntryMap;
+            mutable EntryIndexPointer entryIndex;
+            mutable std::size_t       numDecodedEntries;
+            mutable std::shared_mutex indexMutex;
+            mutable std::mutex        mutex;
         };
     } // namespace ConfGen
 } // namespace CDPL
@@ -31,6 +31,7 @@
 
 #include <string>
 #include <cstddef>
+#include <atomic>
 
 #include <boost/ptr_container/ptr_vector.hpp>
 
@@ -45,6 +46,8 @@ namespace CDPL
     namespace ConfGen
     {
 
+        class TorsionLibraryDataReader;
+
         /**
          * \brief Represents a node of a hierarchical torsion library.
          *
@@ -82,6 +85,12 @@ namespace CDPL
              */
             TorsionCategory();
 
+            /**
+             * \brief Constructs a copy of the \c %TorsionCategory instance \a cat.
+             * \param cat The \c %TorsionCategory to copy.
+             */
+            TorsionCategory(const TorsionCategory& cat);
+
             /**
              * \brief Virtual destructor.
              */
@@ -113,6 +122,10 @@ namespace CDPL
 
             /**
              * \brief Returns the match pattern molecular graph used to perceive the bonds that belong to this category.
+             *
+             * For categories of the built-in torsion library (see TorsionLibrary::loadDefaults()) the match pattern
+             * molecular graph gets created from the \e SMARTS match pattern upon the first call.
+             *
              * \return A \c const shared pointer to the match pattern molecular graph.
              */
             const Chem::MolecularGraph::SharedPointer& getMatchPattern() const;
@@ -293,6 +306,13 @@ namespace CDPL
              */
             ConstRuleIterator getRulesEnd() const;
 
+            /**
+             * \brief Replaces the contents of this category with a copy of the contents of \a cat.
+             * \param cat The source \c %TorsionCategory.
+             * \return A reference to itself.
+             */
+            TorsionCategory& operator=(const TorsionCategory& cat);
+
             /**
              * \brief Swaps the contents of this category with \a cat.
              * \param cat The other category.
@@ -305,17 +325,23 @@ namespace CDPL
             void clear();
 
           private:
+            friend class TorsionLibraryDataReader;
+
+            void setMatchPatternPending();
+            void copyMatchPattern(const TorsionCategory& cat);
+
             void checkCategoryIndex(std::size_t idx, bool it) const;
 
             void checkRuleIndex(std::size_t idx, bool it) const;
 
-            std::string                         name;
-            std::string                         matchPatternStr;
-            Chem::MolecularGraph::SharedPointer matchPattern;
-            unsigned int                        bondAtom1Type;
-            unsigned int                        bondAtom2Type;
-            RuleList                            rules;
-            CategoryList                        categories;
+            std::string                                 name;
+            std::string                                 matchPatternStr;
+            mutable Chem::MolecularGraph::SharedPointer matchPattern;
+            mutable std::atomic<bool>                   matchPatternPending;
+            unsigned int                                bondAtom1Type;
+            unsigned int                                bondAtom2Type;
+            RuleList                                    rules;
+            CategoryList                                categories;
         };
     } // namespace ConfGen
 } // namespace CDPL
@@ -142,6 +142,27 @@ namespace CDPL
              */
             bool strictForceFieldParameterization() const;
 
+            /**
+             * \brief Specifies whether the MMFF94 energy calculations shall be performed by the packed force field calculator.
+             *
+             * If enabled, ForceField::MMFF94PackedEnergyCalculator is used instead of ForceField::MMFF94EnergyCalculator<double>. The packed
+             * calculator evaluates most interactions by vectorized kernels and is thus faster on CPUs supporting the AVX2
+             * instruction set, but its results may deviate from the ones of the generic calculator within floating point
+             * rounding errors. These deviations may propagate into differing conformer energy rankings and selections. By default,
+             * the generic calculator is used.
+             *
+             * \param packed If \c true, the packed force field calculator is used, and the generic one otherwise.
+             * \since 1.4
+             */
+            void packedForceFieldEvaluation(bool packed);
+
+            /**
+             * \brief Tells whether the MMFF94 energy calculations are performed by the packed force field calculator.
+             * \return \c true if the packed force field calculator is used, and \c false otherwise.
+             * \since 1.4
+             */
+            bool packedForceFieldEvaluation() const;
+
             /**
              * \brief Sets the dielectric constant used by the MMFF94 electrostatic interactions.
              * \param de_const The new dielectric constant.
@@ -174,6 +195,7 @@ namespace CDPL
             std::size_t  maxPoolSize;
             unsigned int forceFieldType;
             bool         strictParam;
+            bool         packedFFEval;
             double       dielectricConst;
             double       distExponent;
         };
@@ -71,6 +71,9 @@ namespace CDPL
 
             /**
              * \brief Loads the built-in \e %CDPL default torsion library.
+             *
+             * To keep load times short, the \e SMARTS match patterns of the built-in categories and rules do not get
+             * parsed immediately but on demand (see TorsionCategory::getMatchPattern() and TorsionRule::getMatchPattern()).
              */
             void loadDefaults();
 
@@ -32,6 +32,7 @@
 #include <vector>
 #include <cstddef>
 #include <string>
+#include <atomic>
 
 #include "CDPL/ConfGen/APIPrefix.hpp"
 #include "CDPL/Chem/MolecularGraph.hpp"
@@ -43,6 +44,8 @@ namespace CDPL
     namespace ConfGen
     {
 
+        class TorsionLibraryDataReader;
+
         /**
          * \brief Data structure for the representation of single torsion library rules.
          *
@@ -130,6 +133,17 @@ namespace CDPL
              */
             typedef AngleEntryList::const_iterator ConstAngleEntryIterator;
 
+            /**
+             * \brief Constructs an empty \c %TorsionRule instance.
+             */
+            TorsionRule();
+
+            /**
+             * \brief Constructs a copy of the \c %TorsionRule instance \a rule.
+             * \param rule The \c %TorsionRule to copy.
+             */
+            TorsionRule(const TorsionRule& rule);
+
             /**
              * \brief Returns the \e SMARTS match pattern.
              * \return A \c const reference to the \e SMARTS match pattern.
@@ -144,6 +158,10 @@ namespace CDPL
 
             /**
              * \brief Returns the match pattern molecular graph.
+             *
+             * For rules of the built-in torsion library (see TorsionLibrary::loadDefaults()) the match pattern
+             * molecular graph gets created from the \e SMARTS match pattern upon the first call.
+             *
              * \return A \c const shared pointer to the match pattern molecular graph.
              */
             const Chem::MolecularGraph::SharedPointer& getMatchPattern() const;
@@ -245,6 +263,13 @@ namespace CDPL
              */
             ConstAngleEntryIterator end() const;
 
+            /**
+             * \brief Replaces the contents of this rule with a copy of the contents of \a rule.
+             * \param rule The source \c %TorsionRule.
+             * \return A reference to itself.
+             */
+            TorsionRule& operator=(const TorsionRule& rule);
+
             /**
              * \brief Swaps the contents of this rule with \a rule.
              * \param rule The other torsion rule.
@@ -257,11 +282,17 @@ namespace CDPL
             void clear();
 
           private:
+            friend class TorsionLibraryDataReader;
+
+            void setMatchPatternPending();
+            void copyMatchPattern(const TorsionRule& rule);
+
             void checkAngleIndex(std::size_t idx, bool it) const;
 
-            std::string                         matchPatternStr;
-            Chem::MolecularGraph::SharedPointer matchPattern;
-            AngleEntryList                      angles;
+            std::string                                 matchPatternStr;
+            mutable Chem::MolecularGraph::SharedPointer matchPattern;
+            mutable std::atomic<bool>                   matchPatternPending;
+            AngleEntryList                              angles;
         };
     } // namespace ConfGen
 } // namespace CDPL
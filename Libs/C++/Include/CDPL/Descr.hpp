@@ -35,6 +35,7 @@
 #include "CDPL/Descr/SimilarityFunctions.hpp"
 #include "CDPL/Descr/SimilarityFunctors.hpp"
 #include "CDPL/Descr/BulkSimilarityCalculator.hpp"
+#include "CDPL/Descr/FingerprintBulkSimilarityCalculator.hpp"
 #include "CDPL/Descr/AutoCorrelation2DVectorCalculator.hpp"
 #include "CDPL/Descr/AutoCorrelation3DVectorCalculator.hpp"
 #include "CDPL/Descr/AtomAutoCorrelation3DVectorCalculator.hpp"
@@ -0,0 +1,304 @@
+/* 
+ * FingerprintBulkSimilarityCalculator.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of class CDPL::Descr::FingerprintBulkSimilarityCalculator.
+ */
+
+#ifndef CDPL_DESCR_FINGERPRINTBULKSIMILARITYCALCULATOR_HPP
+#define CDPL_DESCR_FINGERPRINTBULKSIMILARITYCALCULATOR_HPP
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+#include "CDPL/Descr/APIPrefix.hpp"
+#include "CDPL/Util/BitSet.hpp"
+
+
+namespace CDPL
+{
+
+    namespace Descr
+    {
+
+        /**
+         * \brief Calculator that performs a bulk comparison of a single query fingerprint against a stored set of
+         *        target fingerprints.
+         *
+         * In contrast to BulkSimilarityCalculator, the target fingerprints are not stored as individual Util::BitSet
+         * objects but packed into a contiguous array of fixed-width rows of 64-bit words, and the bit counts of the
+         * targets are computed once when they are added. Similarity values are calculated from the number of bits
+         * set in both fingerprints, which are counted by (runtime selected) AVX2, POPCNT or portable implementations.
+         * Resulting similarity values are identical to those of the corresponding functions in SimilarityFunctions.hpp.
+         *
+         * Besides calculating the similarities to all stored fingerprints, the calculator supports retrieving only
+         * the \e N most similar fingerprints (calculateTopN()) and the fingerprints with a similarity not lower
+         * than a given threshold (calculateAboveThreshold()).
+         *
+         * \since 1.4
+         */
+        class CDPL_DESCR_API FingerprintBulkSimilarityCalculator
+        {
+
+          public:
+            /**
+             * \brief Specifies the supported similarity measures.
+             */
+            enum SimilarityMeasure
+            {
+
+                /**
+                 * \brief <em>Tanimoto Similarity</em> (see calcTanimotoSimilarity()).
+                 */
+                TANIMOTO,
+
+                /**
+                 * \brief <em>Tversky Similarity</em> (see calcTverskySimilarity()) where the query is the first bitset.
+                 */
+                TVERSKY,
+
+                /**
+                 * \brief <em>Cosine Similarity</em> (see calcCosineSimilarity()).
+                 */
+                COSINE,
+
+                /**
+                 * \brief <em>Euclidean Similarity</em> (see calcEuclideanSimilarity()).
+                 */
+                EUCLIDEAN
+            };
+
+            /**
+             * \brief A single calculation result: (target fingerprint index, similarity value).
+             */
+            typedef std::pair<std::size_t, double> Result;
+
+            /**
+             * \brief A reference-counted smart pointer [\ref SHPTR] for dynamically allocated \c %FingerprintBulkSimilarityCalculator instances.
+             */
+            typedef std::shared_ptr<FingerprintBulkSimilarityCalculator> SharedPointer;
+
+          private:
+            typedef std::vector<Result> ResultList;
+
+          public:
+            /**
+             * \brief A constant iterator over the calculation results.
+             */
+            typedef ResultList::const_iterator ConstResultIterator;
+
+            /**
+             * \brief Constructs the \c %FingerprintBulkSimilarityCalculator instance.
+             * \param measure The similarity measure to use.
+             */
+            FingerprintBulkSimilarityCalculator(SimilarityMeasure measure = TANIMOTO);
+
+            /**
+             * \brief Sets the similarity measure.
+             * \param measure The new similarity measure.
+             */
+            void setSimilarityMeasure(SimilarityMeasure measure);
+
+            /**
+             * \brief Returns the currently configured similarity measure.
+             * \return The similarity measure.
+             */
+            SimilarityMeasure getSimilarityMeasure() const;
+
+            /**
+             * \brief Sets the bitset contribution weighting factors of the <em>Tversky</em> similarity measure.
+             * \param alpha Weights the contribution of the query fingerprint.
+             * \param beta Weights the contribution of the target fingerprint.
+             * \see calcTverskySimilarity()
+             */
+            void setTverskyWeights(double alpha, double beta);
+
+            /**
+             * \brief Returns the weighting factor of the query fingerprint contribution used by the <em>Tversky</em> similarity measure.
+             * \return The query fingerprint weighting factor (default: 0.95).
+             */
+            double getTverskyAlpha() const;
+
+            /**
+             * \brief Returns the weighting factor of the target fingerprint contribution used by the <em>Tversky</em> similarity measure.
+             * \return The target fingerprint weighting factor (default: 0.05).
+             */
+            double getTverskyBeta() const;
+
+            /**
+             * \brief Removes all stored fingerprints and calculation results.
+             */
+            void clear();
+
+            /**
+             * \brief Returns the number of stored fingerprints.
+             * \return The number of fingerprints.
+             */
+            std::size_t getNumFingerprints() const;
+
+            /**
+             * \brief Returns the size of the largest stored fingerprint in bits.
+             * \return The number of bits of a stored row.
+             */
+            std::size_t getNumBits() const;
+
+            /**
+             * \brief Adds the fingerprint \a fp to the stored fingerprint set.
+             *
+             * Rows of all stored fingerprints get extended if \a fp is larger than getNumBits().
+             *
+             * \param fp The fingerprint to add.
+             */
+            void addFingerprint(const Util::BitSet& fp);
+
+            /**
+             * \brief Retrieves the stored fingerprint at index \a idx.
+             * \param idx The zero-based fingerprint index.
+             * \param fp The output bitset.
+             * \throw Base::IndexError if \a idx is not in the range [0, getNumFingerprints()).
+             */
+            void getFingerprint(std::size_t idx, Util::BitSet& fp) const;
+
+            /**
+             * \brief Removes the fingerprint at index \a idx.
+             * \param idx The zero-based fingerprint index.
+             * \throw Base::IndexError if \a idx is not in the range [0, getNumFingerprints()).
+             */
+            void removeFingerprint(std::size_t idx);
+
+            /**
+             * \brief Computes the similarity between the query fingerprint \a fp and every stored fingerprint.
+             * \param fp The query fingerprint.
+             * \param sort If \c true, the resulting (index, similarity) pairs are sorted by similarity value.
+             * \param sort_desc If \c true (default), sorting is in descending order of similarity. If \c false, in ascending order.
+             */
+            void calculate(const Util::BitSet& fp, bool sort = false, bool sort_desc = true);
+
+            /**
+             * \brief Determines the \a num_results stored fingerprints that are most similar to the query fingerprint \a fp.
+             *
+             * The results are sorted in descending order of similarity (equally similar fingerprints in ascending order
+             * of their index). Undefined (NaN) similarity values are ignored.
+             *
+             * \param fp The query fingerprint.
+             * \param num_results The maximum number of results.
+             */
+            void calculateTopN(const Util::BitSet& fp, std::size_t num_results);
+
+            /**
+             * \brief Determines all stored fingerprints whose similarity to the query fingerprint \a fp is greater than
+             *        or equal to \a threshold.
+             *
+             * The results are listed in the order of the stored fingerprints.
+             *
+             * \param fp The query fingerprint.
+             * \param threshold The minimum similarity value.
+             */
+            void calculateAboveThreshold(const Util::BitSet& fp, double threshold);
+
+            /**
+             * \brief Returns the number of results of the last calculation.
+             * \return The number of results.
+             */
+            std::size_t getNumResults() const;
+
+            /**
+             * \brief Returns a constant iterator pointing to the first result of the last calculation.
+             * \return A constant iterator pointing to the first result.
+             */
+            ConstResultIterator getResultsBegin() const;
+
+            /**
+             * \brief Returns a constant iterator pointing one past the last result of the last calculation.
+             * \return A constant iterator pointing one past the last result.
+             */
+            ConstResultIterator getResultsEnd() const;
+
+            /**
+             * \brief Returns a constant iterator pointing to the first result (range-based for support).
+             * \return A constant iterator pointing to the first result.
+             */
+            ConstResultIterator begin() const;
+
+            /**
+             * \brief Returns a constant iterator pointing one past the last result (range-based for support).
+             * \return A constant iterator pointing one past the last result.
+             */
+            ConstResultIterator end() const;
+
+            /**
+             * \brief Returns the result at the given index.
+             * \param idx The zero-based result index.
+             * \return A \c const reference to the (fingerprint index, similarity) pair.
+             * \throw Base::IndexError if \a idx is not in the range [0, getNumResults()).
+             */
+            const Result& getResult(std::size_t idx) const;
+
+            /**
+             * \brief Returns the similarity value of the result at the given index.
+             * \param idx The zero-based result index.
+             * \return The similarity value.
+             * \throw Base::IndexError if \a idx is not in the range [0, getNumResults()).
+             */
+            double getSimilarity(std::size_t idx) const;
+
+            /**
+             * \brief Returns the index of the target fingerprint referenced by the result at the given result index.
+             * \param idx The zero-based result index.
+             * \return The fingerprint index referenced by the result.
+             * \throw Base::IndexError if \a idx is not in the range [0, getNumResults()).
+             */
+            std::size_t getFingerprintIndex(std::size_t idx) const;
+
+          private:
+            typedef std::vector<std::uint64_t> WordArray;
+            typedef std::vector<std::uint32_t> CountArray;
+            typedef std::vector<std::size_t>   SizeArray;
+
+            void packQuery(const Util::BitSet& fp);
+
+            template <typename Func>
+            void calcSimilarities(Func func);
+
+            SimilarityMeasure measure;
+            double            tverskyAlpha;
+            double            tverskyBeta;
+            std::size_t       numBits;
+            std::size_t       numWords;
+            WordArray         fpWords;
+            CountArray        fpBitCounts;
+            SizeArray         fpSizes;
+            WordArray         queryWords;
+            std::size_t       queryBitCount;
+            std::size_t       querySize;
+            CountArray        commonBitCounts;
+            ResultList        results;
+        };
+    } // namespace Descr
+} // namespace CDPL
+
+#endif // CDPL_DESCR_FINGERPRINTBULKSIMILARITYCALCULATOR_HPP
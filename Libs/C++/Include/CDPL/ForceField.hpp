@@ -53,6 +53,9 @@
 #include "CDPL/ForceField/MMFF94GradientFunctions.hpp"
 #include "CDPL/ForceField/MMFF94EnergyCalculator.hpp"
 #include "CDPL/ForceField/MMFF94GradientCalculator.hpp"
+#include "CDPL/ForceField/MMFF94PackedEnergyCalculator.hpp"
+#include "CDPL/ForceField/MMFF94PackedGradientCalculator.hpp"
+#include "CDPL/ForceField/NonbondedNeighborList.hpp"
 #include "CDPL/ForceField/MMFF94BondStretchingInteraction.hpp"
 #include "CDPL/ForceField/MMFF94AngleBendingInteraction.hpp"
 #include "CDPL/ForceField/MMFF94StretchBendInteraction.hpp"
@@ -33,6 +33,7 @@
 #include "CDPL/ForceField/MMFF94EnergyFunctions.hpp"
 #include "CDPL/ForceField/UtilityFunctions.hpp"
 #include "CDPL/ForceField/InteractionType.hpp"
+#include "CDPL/ForceField/NonbondedNeighborList.hpp"
 
 
 namespace CDPL
@@ -50,6 +51,14 @@ namespace CDPL
          * for a supplied set of atom 3D coordinates. The per-component energies are retained and made available
          * via the dedicated accessors, the calculated sum is returned by operator()() and getTotalEnergy().
          *
+         * If the interaction data specify a nonbonded interaction cutoff (see ForceField::MMFF94InteractionData::setNonbondedCutoff()),
+         * only electrostatic and Van der Waals interactions between atoms closer than the cutoff distance are evaluated and the
+         * energies of these interactions get smoothly switched off towards the cutoff. The relevant interactions are determined via
+         * neighbor lists (see ForceField::NonbondedNeighborList) which are rebuilt only if atoms have moved significantly.
+         * Changes of the electrostatic and Van der Waals interaction lists are detected via
+         * ForceField::MMFF94InteractionData::getNonbondedDataVersion(). If the lists get modified through previously obtained
+         * references, setup() has to be called again.
+         *
          * \tparam ValueType The floating-point value type used to represent the computed energies.
          * \see [\ref MMFF94]
          */
@@ -151,6 +160,14 @@ namespace CDPL
             const ValueType& getVanDerWaalsEnergy() const;
 
           private:
+            void checkNonbondedDataVersion();
+
+            template <typename CoordsArray>
+            ValueType calcCutoffElectrostaticEnergy(const CoordsArray& coords);
+
+            template <typename CoordsArray>
+            ValueType calcCutoffVanDerWaalsEnergy(const CoordsArray& coords);
+
             const MMFF94InteractionData* interactionData;
             ValueType                    totalEnergy;
             ValueType                    bondStretchingEnergy;
@@ -161,6 +178,9 @@ namespace CDPL
             ValueType                    electrostaticEnergy;
             ValueType                    vanDerWaalsEnergy;
             unsigned int                 interactionTypes;
+            NonbondedNeighborList        elecNeighborList;
+            NonbondedNeighborList        vdwNeighborList;
+            std::size_t                  nonbondedDataVersion;
         };
     } // namespace ForceField
 } // namespace CDPL
@@ -173,14 +193,14 @@ template <typename ValueType>
 CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::MMFF94EnergyCalculator():
     interactionData(0), totalEnergy(), bondStretchingEnergy(), angleBendingEnergy(),
     stretchBendEnergy(), outOfPlaneEnergy(), torsionEnergy(), electrostaticEnergy(),
-    vanDerWaalsEnergy(), interactionTypes(InteractionType::ALL)
+    vanDerWaalsEnergy(), interactionTypes(InteractionType::ALL), nonbondedDataVersion(0)
 {}
 
 template <typename ValueType>
 CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::MMFF94EnergyCalculator(const MMFF94InteractionData& ia_data):
     interactionData(&ia_data), totalEnergy(), bondStretchingEnergy(),
     angleBendingEnergy(), stretchBendEnergy(), outOfPlaneEnergy(), torsionEnergy(), electrostaticEnergy(),
-    vanDerWaalsEnergy(), interactionTypes(InteractionType::ALL)
+    vanDerWaalsEnergy(), interactionTypes(InteractionType::ALL), nonbondedDataVersion(ia_data.getNonbondedDataVersion())
 {}
 
 template <typename ValueType>
@@ -199,6 +219,25 @@ template <typename ValueType>
 void CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::setup(const MMFF94InteractionData& ia_data)
 {
     interactionData = &ia_data;
+
+    elecNeighborList.clear();
+    vdwNeighborList.clear();
+
+    nonbondedDataVersion = ia_data.getNonbondedDataVersion();
+}
+
+template <typename ValueType>
+void CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::checkNonbondedDataVersion()
+{
+    // interaction lists that were modified after setup() invalidate the interaction pair tables of the neighbor lists
+
+    if (nonbondedDataVersion == interactionData->getNonbondedDataVersion())
+        return;
+
+    elecNeighborList.clear();
+    vdwNeighborList.clear();
+
+    nonbondedDataVersion = interactionData->getNonbondedDataVersion();
 }
 
 template <typename ValueType>
@@ -220,6 +259,8 @@ const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::operator()
 
     totalEnergy = ValueType();
 
+    checkNonbondedDataVersion();
+
     if (interactionTypes & InteractionType::BOND_STRETCHING) {
         bondStretchingEnergy = calcMMFF94BondStretchingEnergy<ValueType>(interactionData->getBondStretchingInteractions().getElementsBegin(),
                                                                          interactionData->getBondStretchingInteractions().getElementsEnd(),
@@ -267,18 +308,24 @@ const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::operator()
         torsionEnergy = ValueType();
 
     if (interactionTypes & InteractionType::ELECTROSTATIC) {
-        electrostaticEnergy = calcMMFF94ElectrostaticEnergy<ValueType>(interactionData->getElectrostaticInteractions().getElementsBegin(),
-                                                                       interactionData->getElectrostaticInteractions().getElementsEnd(),
-                                                                       coords);
+        if (interactionData->getNonbondedCutoff() > 0.0)
+            electrostaticEnergy = calcCutoffElectrostaticEnergy(coords);
+        else
+            electrostaticEnergy = calcMMFF94ElectrostaticEnergy<ValueType>(interactionData->getElectrostaticInteractions().getElementsBegin(),
+                                                                           interactionData->getElectrostaticInteractions().getElementsEnd(),
+                                                                           coords);
         totalEnergy += electrostaticEnergy;
 
     } else
         electrostaticEnergy = ValueType();
 
     if (interactionTypes & InteractionType::VAN_DER_WAALS) {
-        vanDerWaalsEnergy = calcMMFF94VanDerWaalsEnergy<ValueType>(interactionData->getVanDerWaalsInteractions().getElementsBegin(),
-                                                                   interactionData->getVanDerWaalsInteractions().getElementsEnd(),
-                                                                   coords);
+        if (interactionData->getNonbondedCutoff() > 0.0)
+            vanDerWaalsEnergy = calcCutoffVanDerWaalsEnergy(coords);
+        else
+            vanDerWaalsEnergy = calcMMFF94VanDerWaalsEnergy<ValueType>(interactionData->getVanDerWaalsInteractions().getElementsBegin(),
+                                                                       interactionData->getVanDerWaalsInteractions().getElementsEnd(),
+                                                                       coords);
         totalEnergy += vanDerWaalsEnergy;
 
     } else
@@ -335,6 +382,34 @@ const ValueType& CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::getVanDerW
     return vanDerWaalsEnergy;
 }
 
+template <typename ValueType>
+template <typename CoordsArray>
+ValueType CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::calcCutoffElectrostaticEnergy(const CoordsArray& coords)
+{
+    const MMFF94ElectrostaticInteractionList& ia_list = interactionData->getElectrostaticInteractions();
+    double cutoff = interactionData->getNonbondedCutoff();
+
+    return Detail::accumSwitchedInteractionEnergies<ValueType>(ia_list, Detail::updateNeighborList(elecNeighborList, ia_list, coords, cutoff), coords,
+                                                               ValueType(Detail::getSwitchingOnDistance(cutoff, interactionData->getNonbondedSwitchingWidth())),
+                                                               ValueType(cutoff),
+                                                               static_cast<ValueType (*)(const MMFF94ElectrostaticInteraction&, const CoordsArray&)>(
+                                                                   &calcMMFF94ElectrostaticEnergy<ValueType, CoordsArray>));
+}
+
+template <typename ValueType>
+template <typename CoordsArray>
+ValueType CDPL::ForceField::MMFF94EnergyCalculator<ValueType>::calcCutoffVanDerWaalsEnergy(const CoordsArray& coords)
+{
+    const MMFF94VanDerWaalsInteractionList& ia_list = interactionData->getVanDerWaalsInteractions();
+    double cutoff = interactionData->getNonbondedCutoff();
+
+    return Detail::accumSwitchedInteractionEnergies<ValueType>(ia_list, Detail::updateNeighborList(vdwNeighborList, ia_list, coords, cutoff), coords,
+                                                               ValueType(Detail::getSwitchingOnDistance(cutoff, interactionData->getNonbondedSwitchingWidth())),
+                                                               ValueType(cutoff),
+                                                               static_cast<ValueType (*)(const MMFF94VanDerWaalsInteraction&, const CoordsArray&)>(
+                                                                   &calcMMFF94VanDerWaalsEnergy<ValueType, CoordsArray>));
+}
+
 // \endcond
 
 #endif // CDPL_FORCEFIELD_MMFF94ENERGYCALCULATOR_HPP
@@ -36,6 +36,8 @@
 #include "CDPL/ForceField/MMFF94GradientFunctions.hpp"
 #include "CDPL/ForceField/InteractionType.hpp"
 #include "CDPL/ForceField/GradientVectorTraits.hpp"
+#include "CDPL/ForceField/NonbondedNeighborList.hpp"
+#include "CDPL/ForceField/UtilityFunctions.hpp"
 #include "CDPL/Util/BitSet.hpp"
 
 
@@ -54,6 +56,14 @@ namespace CDPL
          * and made available via the dedicated accessors. A bit mask can be set to mark atoms whose gradient
          * contributions are zeroed, freezing them during an energy minimization run.
          *
+         * If the interaction data specify a nonbonded interaction cutoff (see ForceField::MMFF94InteractionData::setNonbondedCutoff()),
+         * only electrostatic and Van der Waals interactions between atoms closer than the cutoff distance are evaluated and the
+         * energies of these interactions get smoothly switched off towards the cutoff. The relevant interactions are determined via
+         * neighbor lists (see ForceField::NonbondedNeighborList) which are rebuilt only if atoms have moved significantly.
+         * Changes of the electrostatic and Van der Waals interaction lists are detected via
+         * ForceField::MMFF94InteractionData::getNonbondedDataVersion(). If the lists get modified through previously obtained
+         * references, setup() has to be called again.
+         *
          * \tparam ValueType The floating-point value type used to represent the computed energies and gradient vector elements.
          * \see [\ref MMFF94]
          */
@@ -185,6 +195,20 @@ namespace CDPL
             void resetFixedAtomMask();
 
           private:
+            void checkNonbondedDataVersion();
+
+            template <typename CoordsArray>
+            ValueType calcCutoffElectrostaticEnergy(const CoordsArray& coords);
+
+            template <typename CoordsArray>
+            ValueType calcCutoffVanDerWaalsEnergy(const CoordsArray& coords);
+
+            template <typename CoordsArray, typename GradVector>
+            ValueType calcCutoffElectrostaticGradient(const CoordsArray& coords, GradVector& grad);
+
+            template <typename CoordsArray, typename GradVector>
+            ValueType calcCutoffVanDerWaalsGradient(const CoordsArray& coords, GradVector& grad);
+
             const MMFF94InteractionData* interactionData;
             std::size_t                  numAtoms;
             ValueType                    totalEnergy;
@@ -196,6 +220,9 @@ namespace CDPL
             ValueType                    electrostaticEnergy;
             ValueType                    vanDerWaalsEnergy;
             unsigned int                 interactionTypes;
+            NonbondedNeighborList        elecNeighborList;
+            NonbondedNeighborList        vdwNeighborList;
+            std::size_t                  nonbondedDataVersion;
             Util::BitSet                 fixedAtomMask;
         };
     } // namespace ForceField
@@ -209,14 +236,14 @@ template <typename ValueType>
 CDPL::ForceField::MMFF94GradientCalculator<ValueType>::MMFF94GradientCalculator():
     interactionData(0), numAtoms(0), totalEnergy(), bondStretchingEnergy(), angleBendingEnergy(),
     stretchBendEnergy(), outOfPlaneEnergy(), torsionEnergy(), electrostaticEnergy(),
-    vanDerWaalsEnergy(), interactionTypes(InteractionType::ALL)
+    vanDerWaalsEnergy(), interactionTypes(InteractionType::ALL), nonbondedDataVersion(0)
 {}
 
 template <typename ValueType>
 CDPL::ForceField::MMFF94GradientCalculator<ValueType>::MMFF94GradientCalculator(const MMFF94InteractionData& ia_data, std::size_t num_atoms):
     interactionData(&ia_data), numAtoms(num_atoms), totalEnergy(), bondStretchingEnergy(), angleBendingEnergy(),
     stretchBendEnergy(), outOfPlaneEnergy(), torsionEnergy(), electrostaticEnergy(),
-    vanDerWaalsEnergy(), interactionTypes(InteractionType::ALL)
+    vanDerWaalsEnergy(), interactionTypes(InteractionType::ALL), nonbondedDataVersion(ia_data.getNonbondedDataVersion())
 {}
 
 template <typename ValueType>
@@ -236,6 +263,25 @@ void CDPL::ForceField::MMFF94GradientCalculator<ValueType>::setup(const MMFF94In
 {
     interactionData = &ia_data;
     numAtoms        = num_atoms;
+
+    elecNeighborList.clear();
+    vdwNeighborList.clear();
+
+    nonbondedDataVersion = ia_data.getNonbondedDataVersion();
+}
+
+template <typename ValueType>
+void CDPL::ForceField::MMFF94GradientCalculator<ValueType>::checkNonbondedDataVersion()
+{
+    // interaction lists that were modified after setup() invalidate the interaction pair tables of the neighbor lists
+
+    if (nonbondedDataVersion == interactionData->getNonbondedDataVersion())
+        return;
+
+    elecNeighborList.clear();
+    vdwNeighborList.clear();
+
+    nonbondedDataVersion = interactionData->getNonbondedDataVersion();
 }
 
 template <typename ValueType>
@@ -257,6 +303,8 @@ const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::operator
 
     totalEnergy = ValueType();
 
+    checkNonbondedDataVersion();
+
     if (interactionTypes & InteractionType::BOND_STRETCHING) {
         bondStretchingEnergy = calcMMFF94BondStretchingEnergy<ValueType>(interactionData->getBondStretchingInteractions().getElementsBegin(),
                                                                          interactionData->getBondStretchingInteractions().getElementsEnd(),
@@ -304,18 +352,24 @@ const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::operator
         torsionEnergy = ValueType();
 
     if (interactionTypes & InteractionType::ELECTROSTATIC) {
-        electrostaticEnergy = calcMMFF94ElectrostaticEnergy<ValueType>(interactionData->getElectrostaticInteractions().getElementsBegin(),
-                                                                       interactionData->getElectrostaticInteractions().getElementsEnd(),
-                                                                       coords);
+        if (interactionData->getNonbondedCutoff() > 0.0)
+            electrostaticEnergy = calcCutoffElectrostaticEnergy(coords);
+        else
+            electrostaticEnergy = calcMMFF94ElectrostaticEnergy<ValueType>(interactionData->getElectrostaticInteractions().getElementsBegin(),
+                                                                           interactionData->getElectrostaticInteractions().getElementsEnd(),
+                                                                           coords);
         totalEnergy += electrostaticEnergy;
 
     } else
         electrostaticEnergy = ValueType();
 
     if (interactionTypes & InteractionType::VAN_DER_WAALS) {
-        vanDerWaalsEnergy = calcMMFF94VanDerWaalsEnergy<ValueType>(interactionData->getVanDerWaalsInteractions().getElementsBegin(),
-                                                                   interactionData->getVanDerWaalsInteractions().getElementsEnd(),
-                                                                   coords);
+        if (interactionData->getNonbondedCutoff() > 0.0)
+            vanDerWaalsEnergy = calcCutoffVanDerWaalsEnergy(coords);
+        else
+            vanDerWaalsEnergy = calcMMFF94VanDerWaalsEnergy<ValueType>(interactionData->getVanDerWaalsInteractions().getElementsBegin(),
+                                                                       interactionData->getVanDerWaalsInteractions().getElementsEnd(),
+                                                                       coords);
         totalEnergy += vanDerWaalsEnergy;
 
     } else
@@ -345,6 +399,8 @@ const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::operator
 
     totalEnergy = ValueType();
 
+    checkNonbondedDataVersion();
+
     if (interactionTypes & InteractionType::BOND_STRETCHING) {
         bondStretchingEnergy = calcMMFF94BondStretchingGradient<ValueType>(interactionData->getBondStretchingInteractions().getElementsBegin(),
                                                                            interactionData->getBondStretchingInteractions().getElementsEnd(),
@@ -391,18 +447,24 @@ const ValueType& CDPL::ForceField::MMFF94GradientCalculator<ValueType>::operator
         torsionEnergy = ValueType();
 
     if (interactionTypes & InteractionType::ELECTROSTATIC) {
-        electrostaticEnergy = calcMMFF94ElectrostaticGradient<ValueType>(interactionData->getElectrostaticInteractions().getElementsBegin(),
-                                                                         interactionData->getElectrostaticInteractions().getElementsEnd(),
-                                                                         coords, grad);
+        if (interactionData->getNonbondedCutoff() > 0.0)
+            electrostaticEnergy = calcCutoffElectrostaticGradient(coords, grad);
+        else
+            electrostaticEnergy = calcMMFF94ElectrostaticGradient<ValueType>(interactionData->getElectrostaticInteractions().getElementsBegin(),
+                                                                             interactionData->getElectrostaticInteractions().getElementsEnd(),
+                                                                             coords, grad);
         totalEnergy += electrostaticEnergy;
 
     } else
         electrostaticEnergy = ValueType();
 
     if (interactionTypes & InteractionType::VAN_DER_WAALS) {
-        vanDerWaalsEnergy = calcMMFF94VanDerWaalsGradient<ValueType>(interactionData->getVanDerWaalsInteractions().getElementsBegin(),
-                                                                     interactionData->getVanDerWaalsInteractions().getElementsEnd(),
-                                                                     coords, grad);
+        if (interactionData->getNonbondedCutoff() > 0.0)
+            vanDerWaalsEnergy = calcCutoffVanDerWaalsGradient(coords, grad);
+        else
+            vanDerWaalsEnergy = calcMMFF94VanDerWaalsGradient<ValueType>(interactionData->getVanDerWaalsInteractions().getElementsBegin(),
+                                                                         interactionData->getVanDerWaalsInteractions().getElementsEnd(),
+                                                                         coords, grad);
         totalEnergy += vanDerWaalsEnergy;
 
     } else
@@ -481,6 +543,62 @@ void CDPL::ForceField::MMFF94GradientCalculator<ValueType>::resetFixedAtomMask()
     fixedAtomMask.clear();
 }
 
+template <typename ValueType>
+template <typename CoordsArray>
+ValueType CDPL::ForceField::MMFF94GradientCalculator<ValueType>::calcCutoffElectrostaticEnergy(const CoordsArray& coords)
+{
+    const MMFF94ElectrostaticInteractionList& ia_list = interactionData->getElectrostaticInteractions();
+    double cutoff = interactionData->getNonbondedCutoff();
+
+    return Detail::accumSwitchedInteractionEnergies<ValueType>(ia_list, Detail::updateNeighborList(elecNeighborList, ia_list, coords, cutoff), coords,
+                                                               ValueType(Detail::getSwitchingOnDistance(cutoff, interactionData->getNonbondedSwitchingWidth())),
+                                                               ValueType(cutoff),
+                                                               static_cast<ValueType (*)(const MMFF94ElectrostaticInteraction&, const CoordsArray&)>(
+                                                                   &calcMMFF94ElectrostaticEnergy<ValueType, CoordsArray>));
+}
+
+template <typename ValueType>
+template <typename CoordsArray>
+ValueType CDPL::ForceField::MMFF94GradientCalculator<ValueType>::calcCutoffVanDerWaalsEnergy(const CoordsArray& coords)
+{
+    const MMFF94VanDerWaalsInteractionList& ia_list = interactionData->getVanDerWaalsInteractions();
+    double cutoff = interactionData->getNonbondedCutoff();
+
+    return Detail::accumSwitchedInteractionEnergies<ValueType>(ia_list, Detail::updateNeighborList(vdwNeighborList, ia_list, coords, cutoff), coords,
+                                                               ValueType(Detail::getSwitchingOnDistance(cutoff, interactionData->getNonbondedSwitchingWidth())),
+                                                               ValueType(cutoff),
+                                                               static_cast<ValueType (*)(const MMFF94VanDerWaalsInteraction&, const CoordsArray&)>(
+                                                                   &calcMMFF94VanDerWaalsEnergy<ValueType, CoordsArray>));
+}
+
+template <typename ValueType>
+template <typename CoordsArray, typename GradVector>
+ValueType CDPL::ForceField::MMFF94GradientCalculator<ValueType>::calcCutoffElectrostaticGradient(const CoordsArray& coords, GradVector& grad)
+{
+    const MMFF94ElectrostaticInteractionList& ia_list = interactionData->getElectrostaticInteractions();
+    double cutoff = interactionData->getNonbondedCutoff();
+
+    return Detail::calcSwitchedInteractionGradient<ValueType>(ia_list, Detail::updateNeighborList(elecNeighborList, ia_list, coords, cutoff), coords, grad,
+                                                              ValueType(Detail::getSwitchingOnDistance(cutoff, interactionData->getNonbondedSwitchingWidth())),
+                                                              ValueType(cutoff),
+                                                              static_cast<ValueType (*)(const MMFF94ElectrostaticInteraction&, const CoordsArray&, Detail::PairGradient<ValueType>&)>(
+                                                                  &calcMMFF94ElectrostaticGradient<ValueType, CoordsArray, Detail::PairGradient<ValueType> >));
+}
+
+template <typename ValueType>
+template <typename CoordsArray, typename GradVector>
+ValueType CDPL::ForceField::MMFF94GradientCalculator<ValueType>::calcCutoffVanDerWaalsGradient(const CoordsArray& coords, GradVector& grad)
+{
+    const MMFF94VanDerWaalsInteractionList& ia_list = interactionData->getVanDerWaalsInteractions();
+    double cutoff = interactionData->getNonbondedCutoff();
+
+    return Detail::calcSwitchedInteractionGradient<ValueType>(ia_list, Detail::updateNeighborList(vdwNeighborList, ia_list, coords, cutoff), coords, grad,
+                                                              ValueType(Detail::getSwitchingOnDistance(cutoff, interactionData->getNonbondedSwitchingWidth())),
+                                                              ValueType(cutoff),
+                                                              static_cast<ValueType (*)(const MMFF94VanDerWaalsInteraction&, const CoordsArray&, Detail::PairGradient<ValueType>&)>(
+                                                                  &calcMMFF94VanDerWaalsGradient<ValueType, CoordsArray, Detail::PairGradient<ValueType> >));
+}
+
 // \endcond
 
 #endif // CDPL_FORCEFIELD_MMFF94GRADIENTCALCULATOR_HPP
@@ -30,6 +30,7 @@
 #define CDPL_FORCEFIELD_MMFF94INTERACTIONDATA_HPP
 
 #include <memory>
+#include <cstddef>
 
 #include "CDPL/ForceField/APIPrefix.hpp"
 #include "CDPL/ForceField/MMFF94BondStretchingInteractionList.hpp"
@@ -67,6 +68,23 @@ namespace CDPL
              */
             typedef std::shared_ptr<MMFF94InteractionData> SharedPointer;
 
+            /**
+             * \brief Specifies that no cutoff shall be applied to nonbonded interactions.
+             * \since 1.4
+             */
+            static constexpr double NO_NONBONDED_CUTOFF = 0.0;
+
+            /**
+             * \brief The default width of the nonbonded interaction switching region in Å.
+             * \since 1.4
+             */
+            static constexpr double DEF_NONBONDED_SWITCHING_WIDTH = 2.0;
+
+            /**
+             * \brief Constructs an empty interaction data set without nonbonded interaction cutoff.
+             */
+            MMFF94InteractionData();
+
             /**
              * \brief Returns the list of MMFF94 bond-stretching interactions.
              * \return A \c const reference to the bond-stretching interaction list.
@@ -136,6 +154,7 @@ namespace CDPL
             /**
              * \brief Returns the list of MMFF94 electrostatic interactions.
              * \return A reference to the electrostatic interaction list.
+             * \note Advances the nonbonded interaction data version (see getNonbondedDataVersion()).
              */
             MMFF94ElectrostaticInteractionList& getElectrostaticInteractions();
 
@@ -148,16 +167,66 @@ namespace CDPL
             /**
              * \brief Returns the list of MMFF94 Van der Waals interactions.
              * \return A reference to the Van der Waals interaction list.
+             * \note Advances the nonbonded interaction data version (see getNonbondedDataVersion()).
              */
             MMFF94VanDerWaalsInteractionList& getVanDerWaalsInteractions();
 
+            /**
+             * \brief Returns a value that identifies the current state of the electrostatic and Van der Waals interaction lists.
+             *
+             * A new, process-wide unique version value gets assigned whenever non-\c const access to one of the lists is requested
+             * and by clear(). swap() exchanges the versions along with the data. Energy and gradient calculators compare the version with the one of their last invocation
+             * to detect that the interaction pair tables of their neighbor lists have to be rebuilt.
+             *
+             * \return The nonbonded interaction data version.
+             * \note Modifications made via list references that were obtained before the last version change can't be detected.
+             * \since 1.4
+             */
+            std::size_t getNonbondedDataVersion() const;
+
+            /**
+             * \brief Sets the distance beyond which electrostatic and Van der Waals interactions shall be neglected.
+             *
+             * If a cutoff greater than zero has been specified, energy and gradient calculators evaluate only those
+             * electrostatic and Van der Waals interactions whose atoms are currently closer than the cutoff distance (determined
+             * with the help of neighbor lists, see ForceField::NonbondedNeighborList). To retain a continuous energy function and gradient,
+             * the interaction energies get smoothly switched off over a distance range of getNonbondedSwitchingWidth()
+             * Å that ends at the cutoff distance.
+             *
+             * \param cutoff The nonbonded interaction cutoff distance in Å or ForceField::MMFF94InteractionData::NO_NONBONDED_CUTOFF
+             *               to evaluate all stored interactions (default).
+             * \since 1.4
+             */
+            void setNonbondedCutoff(double cutoff);
+
+            /**
+             * \brief Returns the distance beyond which electrostatic and Van der Waals interactions shall be neglected.
+             * \return The nonbonded interaction cutoff distance in Å.
+             * \since 1.4
+             */
+            double getNonbondedCutoff() const;
+
+            /**
+             * \brief Sets the width of the distance range preceding the cutoff in which nonbonded interaction energies get switched off.
+             * \param width The switching region width in Å (a value of zero results in a hard cutoff).
+             * \since 1.4
+             */
+            void setNonbondedSwitchingWidth(double width);
+
+            /**
+             * \brief Returns the width of the distance range preceding the cutoff in which nonbonded interaction energies get switched off.
+             * \return The switching region width in Å.
+             * \since 1.4
+             */
+            double getNonbondedSwitchingWidth() const;
+
             /**
              * \brief Removes all stored interactions from every interaction list.
              */
             void clear();
 
             /**
-             * \brief Swaps the contents (all interaction lists) of this instance with \a ia_data.
+             * \brief Swaps the contents (all interaction lists and nonbonded cutoff settings) of this instance with \a ia_data.
              * \param ia_data The other interaction data instance.
              */
             void swap(MMFF94InteractionData& ia_data);
@@ -170,6 +239,9 @@ namespace CDPL
             MMFF94TorsionInteractionList           torsionData;
             MMFF94ElectrostaticInteractionList     electrostaticData;
             MMFF94VanDerWaalsInteractionList       vanDerWaalsData;
+            double                                 nonbondedCutoff;
+            double                                 nonbondedSwitchingWidth;
+            std::size_t                            nonbondedDataVersion;
         };
     } // namespace ForceField
 } // namespace CDPL
@@ -281,6 +281,36 @@ namespace CDPL
              */
             void setDistanceExponent(double dist_expo);
 
+            /**
+             * \brief Sets the nonbonded interaction cutoff distance that gets stored in the output interaction data.
+             * \param cutoff The cutoff distance in Å or ForceField::MMFF94InteractionData::NO_NONBONDED_CUTOFF (default).
+             * \see ForceField::MMFF94InteractionData::setNonbondedCutoff()
+             * \since 1.4
+             */
+            void setNonbondedCutoff(double cutoff);
+
+            /**
+             * \brief Returns the nonbonded interaction cutoff distance that gets stored in the output interaction data.
+             * \return The cutoff distance in Å.
+             * \since 1.4
+             */
+            double getNonbondedCutoff() const;
+
+            /**
+             * \brief Sets the width of the nonbonded interaction switching region that gets stored in the output interaction data.
+             * \param width The switching region width in Å.
+             * \see ForceField::MMFF94InteractionData::setNonbondedSwitchingWidth()
+             * \since 1.4
+             */
+            void setNonbondedSwitchingWidth(double width);
+
+            /**
+             * \brief Returns the width of the nonbonded interaction switching region that gets stored in the output interaction data.
+             * \return The switching region width in Å.
+             * \since 1.4
+             */
+            double getNonbondedSwitchingWidth() const;
+
             /**
              * \brief Switches the active MMFF94 parameter set variant to a different one.
              * \param param_set The new parameter set variant (see namespace ForceField::MMFF94ParameterSet).
@@ -348,6 +378,8 @@ namespace CDPL
             Util::UIArray                                   bondTypeIndices;
             Util::DArray                                    atomCharges;
             const Chem::MolecularGraph*                     molGraph;
+            double                                          nonbondedCutoff;
+            double                                          nonbondedSwitchingWidth;
         };
     } // namespace ForceField
 } // namespace CDPL
@@ -0,0 +1,184 @@
+/*
+ * MMFF94PackedEnergyCalculator.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of class CDPL::ForceField::MMFF94PackedEnergyCalculator.
+ */
+
+#ifndef CDPL_FORCEFIELD_MMFF94PACKEDENERGYCALCULATOR_HPP
+#define CDPL_FORCEFIELD_MMFF94PACKEDENERGYCALCULATOR_HPP
+
+#include <cstddef>
+
+#include "CDPL/ForceField/APIPrefix.hpp"
+#include "CDPL/ForceField/MMFF94PackedGradientCalculator.hpp"
+
+
+namespace CDPL
+{
+
+    namespace ForceField
+    {
+
+        /**
+         * \brief Calculates the total MMFF94 force field energy using interaction parameters stored in a packed
+         *        structure-of-arrays layout.
+         *
+         * The class is the energy-only counterpart of ForceField::MMFF94PackedGradientCalculator and a drop-in alternative
+         * for ForceField::MMFF94EnergyCalculator<double> (except that the number of atoms has to be specified upon setup()).
+         * The energies are calculated by the same kernels as used by ForceField::MMFF94PackedGradientCalculator and thus
+         * agree with the ones obtained by ForceField::MMFF94EnergyCalculator within floating point rounding errors.
+         * Since the interaction parameters are copied, setup() has to be called again whenever the associated
+         * ForceField::MMFF94InteractionData instance gets modified.
+         *
+         * \see [\ref MMFF94]
+         * \since 1.4
+         */
+        class CDPL_FORCEFIELD_API MMFF94PackedEnergyCalculator
+        {
+
+          public:
+            /**
+             * \brief Constructs the calculator without any interaction parameters.
+             *
+             * operator()() will return zero until setup() has been called.
+             */
+            MMFF94PackedEnergyCalculator();
+
+            /**
+             * \brief Constructs the calculator and initializes it with the parameters of the supplied ForceField::MMFF94InteractionData instance.
+             * \param ia_data The MMFF94 interaction data to use during energy calculation.
+             * \param num_atoms The number of atoms in the parameterized molecular graph.
+             */
+            MMFF94PackedEnergyCalculator(const MMFF94InteractionData& ia_data, std::size_t num_atoms);
+
+            /**
+             * \brief Enables/disables specific MMFF94 interaction-type contributions.
+             * \param types Bitwise-OR combination of ForceField::InteractionType flags.
+             * \note Only enabled contributions are evaluated.
+             */
+            void setEnabledInteractionTypes(unsigned int types);
+
+            /**
+             * \brief Returns the currently enabled interaction-type contributions.
+             * \return The bitwise-OR combination of ForceField::InteractionType flags.
+             */
+            unsigned int getEnabledInteractionTypes() const;
+
+            /**
+             * \brief Initializes the calculator with the parameters of the supplied ForceField::MMFF94InteractionData instance.
+             * \param ia_data The new MMFF94 interaction data to use for energy calculation.
+             * \param num_atoms The number of atoms in the parameterized molecular graph.
+             */
+            void setup(const MMFF94InteractionData& ia_data, std::size_t num_atoms);
+
+            /**
+             * \brief Computes the total MMFF94 energy of the conformation specified by \a coords.
+             * \tparam CoordsArray The atom coordinate array type.
+             * \param coords The 3D coordinates of the molecule.
+             * \return A \c const reference to the computed total energy.
+             */
+            template <typename CoordsArray>
+            const double& operator()(const CoordsArray& coords);
+
+            /**
+             * \brief Returns the total MMFF94 energy computed by the most recent operator()() call.
+             * \return A \c const reference to the total energy.
+             */
+            const double& getTotalEnergy() const;
+
+            /**
+             * \brief Returns the bond-stretching energy contribution computed by the most recent operator()() call.
+             * \return A \c const reference to the bond-stretching energy.
+             */
+            const double& getBondStretchingEnergy() const;
+
+            /**
+             * \brief Returns the angle-bending energy contribution computed by the most recent operator()() call.
+             * \return A \c const reference to the angle-bending energy.
+             */
+            const double& getAngleBendingEnergy() const;
+
+            /**
+             * \brief Returns the stretch-bend coupling energy contribution computed by the most recent operator()() call.
+             * \return A \c const reference to the stretch-bend energy.
+             */
+            const double& getStretchBendEnergy() const;
+
+            /**
+             * \brief Returns the out-of-plane bending energy contribution computed by the most recent operator()() call.
+             * \return A \c const reference to the out-of-plane bending energy.
+             */
+            const double& getOutOfPlaneBendingEnergy() const;
+
+            /**
+             * \brief Returns the torsion energy contribution computed by the most recent operator()() call.
+             * \return A \c const reference to the torsion energy.
+             */
+            const double& getTorsionEnergy() const;
+
+            /**
+             * \brief Returns the electrostatic energy contribution computed by the most recent operator()() call.
+             * \return A \c const reference to the electrostatic energy.
+             */
+            const double& getElectrostaticEnergy() const;
+
+            /**
+             * \brief Returns the Van der Waals energy contribution computed by the most recent operator()() call.
+             * \return A \c const reference to the Van der Waals energy.
+             */
+            const double& getVanDerWaalsEnergy() const;
+
+            /**
+             * \brief Specifies whether the portable kernels shall be used regardless of the executing CPU's capabilities.
+             * \param enforce If \c true, the portable kernels get used, otherwise the kernels selected for the executing CPU.
+             * \see ForceField::MMFF94PackedGradientCalculator::enforcePortableKernels()
+             */
+            void enforcePortableKernels(bool enforce);
+
+            /**
+             * \brief Tells whether the portable kernels are used regardless of the executing CPU's capabilities.
+             * \return \c true if the portable kernels are enforced, and \c false otherwise.
+             */
+            bool portableKernelsEnforced() const;
+
+          private:
+            MMFF94PackedGradientCalculator calculator;
+        };
+    } // namespace ForceField
+} // namespace CDPL
+
+
+// Implementation
+// \cond DOC_IMPL_DETAILS
+
+template <typename CoordsArray>
+const double& CDPL::ForceField::MMFF94PackedEnergyCalculator::operator()(const CoordsArray& coords)
+{
+    return calculator(coords);
+}
+
+// \endcond
+
+#endif // CDPL_FORCEFIELD_MMFF94PACKEDENERGYCALCULATOR_HPP
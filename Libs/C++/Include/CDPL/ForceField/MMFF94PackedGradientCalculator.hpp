@@ -0,0 +1,451 @@
+/*
+ * MMFF94PackedGradientCalculator.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of class CDPL::ForceField::MMFF94PackedGradientCalculator.
+ */
+
+#ifndef CDPL_FORCEFIELD_MMFF94PACKEDGRADIENTCALCULATOR_HPP
+#define CDPL_FORCEFIELD_MMFF94PACKEDGRADIENTCALCULATOR_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CDPL/ForceField/APIPrefix.hpp"
+#include "CDPL/ForceField/MMFF94InteractionData.hpp"
+#include "CDPL/ForceField/MMFF94EnergyFunctions.hpp"
+#include "CDPL/ForceField/MMFF94GradientFunctions.hpp"
+#include "CDPL/ForceField/InteractionType.hpp"
+#include "CDPL/ForceField/NonbondedNeighborList.hpp"
+#include "CDPL/ForceField/UtilityFunctions.hpp"
+#include "CDPL/ForceField/GradientVectorTraits.hpp"
+#include "CDPL/Util/BitSet.hpp"
+
+
+namespace CDPL
+{
+
+    namespace ForceField
+    {
+
+        /**
+         * \brief Calculates the total MMFF94 force field energy and its gradient using interaction parameters stored
+         *        in a packed structure-of-arrays layout.
+         *
+         * The class is a drop-in alternative for ForceField::MMFF94GradientCalculator<double> (and, via the energy-only
+         * operator()(), for ForceField::MMFF94EnergyCalculator<double>). Upon setup(), the parameters of the angle bending,
+         * torsion, electrostatic and Van der Waals interactions are copied into contiguous per-parameter arrays which get
+         * processed by dedicated kernels. On x86-64 CPUs supporting the AVX2 instruction set, the kernels for the angle bending,
+         * torsion and nonbonded terms process four interactions at once. Otherwise, portable scalar code is used. The remaining
+         * (less numerous) interaction types are evaluated by the generic MMFF94 energy and gradient functions.
+         *
+         * If the interaction data specify a nonbonded interaction cutoff (see ForceField::MMFF94InteractionData::setNonbondedCutoff()),
+         * the electrostatic and Van der Waals terms are instead evaluated by the generic functions for the interactions selected by
+         * neighbor lists, as done by ForceField::MMFF94GradientCalculator.
+         *
+         * The calculated energies and gradients agree with the ones obtained by ForceField::MMFF94GradientCalculator within
+         * floating point rounding errors. Since the interaction parameters are copied, setup() has to be called again
+         * whenever the associated ForceField::MMFF94InteractionData instance gets modified.
+         *
+         * \see [\ref MMFF94]
+         * \since 1.4
+         */
+        class CDPL_FORCEFIELD_API MMFF94PackedGradientCalculator
+        {
+
+          public:
+            /**
+             * \brief Constructs the calculator without any interaction parameters.
+             *
+             * operator()() will return zero until setup() has been called.
+             */
+            MMFF94PackedGradientCalculator();
+
+            /**
+             * \brief Constructs the calculator and initializes it with the parameters of the supplied ForceField::MMFF94InteractionData instance.
+             * \param ia_data The MMFF94 interaction data to use during energy/gradient calculation.
+             * \param num_atoms The number of atoms in the parameterized molecular graph.
+             */
+            MMFF94PackedGradientCalculator(const MMFF94InteractionData& ia_data, std::size_t num_atoms);
+
+            /**
+             * \brief Enables/disables specific MMFF94 interaction-type contributions.
+             * \param types Bitwise-OR combination of ForceField::InteractionType flags.
+             * \note Only enabled contributions are evaluated.
+             */
+            void setEnabledInteractionTypes(unsigned int types);
+
+            /**
+             * \brief Returns the currently enabled interaction-type contributions.
+             * \return The bitwise-OR combination of ForceField::InteractionType flags.
+             */
+            unsigned int getEnabledInteractionTypes() const;
+
+            /**
+             * \brief Initializes the calculator with the parameters of the supplied ForceField::MMFF94InteractionData instance.
+             * \param ia_data The new MMFF94 interaction data to use for energy/gradient calculation.
+             * \param num_atoms The number of atoms in the parameterized molecular graph.
+             */
+            void setup(const MMFF94InteractionData& ia_data, std::size_t num_atoms);
+
+            /**
+             * \brief Computes the total MMFF94 energy of the conformation specified by \a coords without calculating the gradient.
+             * \tparam CoordsArray The atom coordinate array type.
+             * \param coords The 3D coordinates of the molecule.
+             * \return A \c const reference to the computed total energy.
+             */
+            template <typename CoordsArray>
+            const double& operator()(const CoordsArray& coords);
+
+            /**
+             * \brief Computes the total MMFF94 energy and the per-atom gradient of the conformation specified by \a coords.
+             *
+             * Gradients of atoms marked in the fixed-atom mask (see setFixedAtomMask()) are zeroed after calculation.
+             *
+             * \tparam CoordsArray The atom coordinate array type.
+             * \tparam GradVector The gradient vector type (must satisfy ForceField::GradientVectorTraits requirements).
+             * \param coords The atom 3D coordinates.
+             * \param grad The output gradient vector.
+             * \return A \c const reference to the computed total energy.
+             */
+            template <typename CoordsArray, typename GradVector>
+            const double& operator()(const CoordsArray& coords, GradVector& grad);
+
+            /**
+             * \brief Returns the total MMFF94 energy computed by the most recent operator()() call.
+             * \return A \c const reference to the total energy.
+             */
+            const double& getTotalEnergy() const;
+
+            /**
+             * \brief Returns the bond-stretching energy contribution computed by the most recent operator()() call.
+             * \return A \c const reference to the bond-stretching energy.
+             */
+            const double& getBondStretchingEnergy() const;
+
+            /**
+             * \brief Returns the angle-bending energy contribution computed by the most recent operator()() call.
+             * \return A \c const reference to the angle-bending energy.
+             */
+            const double& getAngleBendingEnergy() const;
+
+            /**
+             * \brief Returns the stretch-bend coupling energy contribution computed by the most recent operator()() call.
+             * \return A \c const reference to the stretch-bend energy.
+             */
+            const double& getStretchBendEnergy() const;
+
+            /**
+             * \brief Returns the out-of-plane bending energy contribution computed by the most recent operator()() call.
+             * \return A \c const reference to the out-of-plane bending energy.
+             */
+            const double& getOutOfPlaneBendingEnergy() const;
+
+            /**
+             * \brief Returns the torsion energy contribution computed by the most recent operator()() call.
+             * \return A \c const reference to the torsion energy.
+             */
+            const double& getTorsionEnergy() const;
+
+            /**
+             * \brief Returns the electrostatic energy contribution computed by the most recent operator()() call.
+             * \return A \c const reference to the electrostatic energy.
+             */
+            const double& getElectrostaticEnergy() const;
+
+            /**
+             * \brief Returns the Van der Waals energy contribution computed by the most recent operator()() call.
+             * \return A \c const reference to the Van der Waals energy.
+             */
+            const double& getVanDerWaalsEnergy() const;
+
+            /**
+             * \brief Returns the bit mask flagging atoms whose gradient components are zeroed after evaluation.
+             * \return A \c const reference to the fixed-atom bit mask.
+             */
+            const Util::BitSet& getFixedAtomMask() const;
+
+            /**
+             * \brief Sets the bit mask flagging atoms whose gradient components shall be zeroed after calculation.
+             * \param mask The new fixed-atom bit mask (bit \e i set freezes atom \e i during minimization).
+             */
+            void setFixedAtomMask(const Util::BitSet& mask);
+
+            /**
+             * \brief Clears the fixed-atom mask so that all atoms contribute to the gradient.
+             */
+            void resetFixedAtomMask();
+
+            /**
+             * \brief Specifies whether the portable kernels shall be used regardless of the executing CPU's capabilities.
+             *
+             * Both kernel implementations deliver identical results, the portable kernels are just slower. Enforcing
+             * them is mainly useful for testing and benchmarking purposes.
+             *
+             * \param enforce If \c true, the portable kernels get used, otherwise the kernels selected for the executing CPU.
+             */
+            void enforcePortableKernels(bool enforce);
+
+            /**
+             * \brief Tells whether the portable kernels are used regardless of the executing CPU's capabilities.
+             * \return \c true if the portable kernels are enforced, and \c false otherwise.
+             */
+            bool portableKernelsEnforced() const;
+
+            /**
+             * \brief Returns the name of the kernel implementation (e.g. \c "AVX2" or \c "Portable") selected for the executing CPU.
+             * \return The name of the kernel implementation.
+             * \see enforcePortableKernels()
+             */
+            static const char* getKernelImplementationName();
+
+          private:
+            typedef std::vector<double>       ParameterArray;
+            typedef std::vector<std::int32_t> OffsetArray;
+
+            struct PackedInteractionTable
+            {
+
+                void clear();
+
+                std::size_t    size;
+                OffsetArray    atomOffsets;
+                ParameterArray params;
+            };
+
+            template <typename CoordsArray>
+            void loadCoordinates(const CoordsArray& coords);
+
+            template <typename GradVector>
+            void addPackedGradient(GradVector& grad) const;
+
+            template <typename CoordsArray>
+            void calcCutoffNonbondedEnergies(const CoordsArray& coords);
+
+            template <typename CoordsArray, typename GradVector>
+            void calcCutoffNonbondedGradient(const CoordsArray& coords, GradVector& grad);
+
+            bool packedInteractionsEnabled() const;
+
+            void calcPackedEnergies();
+            void calcPackedGradient();
+
+            void sumTotalEnergy();
+            void clearEnergies();
+
+            bool                                   initialized;
+            std::size_t                            numAtoms;
+            MMFF94BondStretchingInteractionList    bondStretchingData;
+            MMFF94StretchBendInteractionList       stretchBendData;
+            MMFF94OutOfPlaneBendingInteractionList outOfPlaneData;
+            MMFF94ElectrostaticInteractionList     electrostaticData;
+            MMFF94VanDerWaalsInteractionList       vanDerWaalsData;
+            double                                 nonbondedCutoff;
+            double                                 nonbondedSwitchingWidth;
+            NonbondedNeighborList                  elecNeighborList;
+            NonbondedNeighborList                  vdwNeighborList;
+            PackedInteractionTable                 angleBendingTable;
+            PackedInteractionTable                 torsionTable;
+            PackedInteractionTable                 electrostaticTable;
+            PackedInteractionTable                 vanDerWaalsTable;
+            double                                 elecDistExponent;
+            ParameterArray                         coordsBuffer;
+            ParameterArray                         gradBuffer;
+            ParameterArray                         gradContribBuffer;
+            double                                 totalEnergy;
+            double                                 bondStretchingEnergy;
+            double                                 angleBendingEnergy;
+            double                                 stretchBendEnergy;
+            double                                 outOfPlaneEnergy;
+            double                                 torsionEnergy;
+            double                                 electrostaticEnergy;
+            double                                 vanDerWaalsEnergy;
+            unsigned int                           interactionTypes;
+            Util::BitSet                           fixedAtomMask;
+            bool                                   portableKernels;
+        };
+    } // namespace ForceField
+} // namespace CDPL
+
+
+// Implementation
+// \cond DOC_IMPL_DETAILS
+
+template <typename CoordsArray>
+const double& CDPL::ForceField::MMFF94PackedGradientCalculator::operator()(const CoordsArray& coords)
+{
+    if (!initialized) {
+        clearEnergies();
+        return totalEnergy;
+    }
+
+    if (interactionTypes & InteractionType::BOND_STRETCHING)
+        bondStretchingEnergy = calcMMFF94BondStretchingEnergy<double>(bondStretchingData.getElementsBegin(),
+                                                                      bondStretchingData.getElementsEnd(), coords);
+    else
+        bondStretchingEnergy = 0.0;
+
+    if (interactionTypes & InteractionType::STRETCH_BEND)
+        stretchBendEnergy = calcMMFF94StretchBendEnergy<double>(stretchBendData.getElementsBegin(),
+                                                                stretchBendData.getElementsEnd(), coords);
+    else
+        stretchBendEnergy = 0.0;
+
+    if (interactionTypes & InteractionType::OUT_OF_PLANE_BENDING)
+        outOfPlaneEnergy = calcMMFF94OutOfPlaneBendingEnergy<double>(outOfPlaneData.getElementsBegin(),
+                                                                     outOfPlaneData.getElementsEnd(), coords);
+    else
+        outOfPlaneEnergy = 0.0;
+
+    if (packedInteractionsEnabled())
+        loadCoordinates(coords);
+
+    calcPackedEnergies();
+
+    if (nonbondedCutoff > 0.0)
+        calcCutoffNonbondedEnergies(coords);
+
+    sumTotalEnergy();
+
+    return totalEnergy;
+}
+
+template <typename CoordsArray, typename GradVector>
+const double& CDPL::ForceField::MMFF94PackedGradientCalculator::operator()(const CoordsArray& coords, GradVector& grad)
+{
+    GradientVectorTraits<GradVector>::clear(grad, numAtoms);
+
+    if (!initialized) {
+        clearEnergies();
+        return totalEnergy;
+    }
+
+    if (interactionTypes & InteractionType::BOND_STRETCHING)
+        bondStretchingEnergy = calcMMFF94BondStretchingGradient<double>(bondStretchingData.getElementsBegin(),
+                                                                        bondStretchingData.getElementsEnd(), coords, grad);
+    else
+        bondStretchingEnergy = 0.0;
+
+    if (interactionTypes & InteractionType::STRETCH_BEND)
+        stretchBendEnergy = calcMMFF94StretchBendGradient<double>(stretchBendData.getElementsBegin(),
+                                                                  stretchBendData.getElementsEnd(), coords, grad);
+    else
+        stretchBendEnergy = 0.0;
+
+    if (interactionTypes & InteractionType::OUT_OF_PLANE_BENDING)
+        outOfPlaneEnergy = calcMMFF94OutOfPlaneBendingGradient<double>(outOfPlaneData.getElementsBegin(),
+                                                                       outOfPlaneData.getElementsEnd(), coords, grad);
+    else
+        outOfPlaneEnergy = 0.0;
+
+    bool have_packed_iactions = packedInteractionsEnabled();
+
+    if (have_packed_iactions)
+        loadCoordinates(coords);
+
+    calcPackedGradient();
+
+    if (have_packed_iactions)
+        addPackedGradient(grad);
+
+    if (nonbondedCutoff > 0.0)
+        calcCutoffNonbondedGradient(coords, grad);
+
+    sumTotalEnergy();
+
+    if (!fixedAtomMask.empty())
+        for (Util::BitSet::size_type i = fixedAtomMask.find_first(); i != Util::BitSet::npos; i = fixedAtomMask.find_next(i))
+            grad[i].clear(0.0);
+
+    return totalEnergy;
+}
+
+template <typename CoordsArray>
+void CDPL::ForceField::MMFF94PackedGradientCalculator::calcCutoffNonbondedEnergies(const CoordsArray& coords)
+{
+    double sw_on_dist = Detail::getSwitchingOnDistance(nonbondedCutoff, nonbondedSwitchingWidth);
+
+    if (interactionTypes & InteractionType::ELECTROSTATIC)
+        electrostaticEnergy = Detail::accumSwitchedInteractionEnergies<double>(electrostaticData,
+                                                                               Detail::updateNeighborList(elecNeighborList, electrostaticData, coords, nonbondedCutoff),
+                                                                               coords, sw_on_dist, nonbondedCutoff,
+                                                                               static_cast<double (*)(const MMFF94ElectrostaticInteraction&, const CoordsArray&)>(
+                                                                                   &calcMMFF94ElectrostaticEnergy<double, CoordsArray>));
+
+    if (interactionTypes & InteractionType::VAN_DER_WAALS)
+        vanDerWaalsEnergy = Detail::accumSwitchedInteractionEnergies<double>(vanDerWaalsData,
+                                                                             Detail::updateNeighborList(vdwNeighborList, vanDerWaalsData, coords, nonbondedCutoff),
+                                                                             coords, sw_on_dist, nonbondedCutoff,
+                                                                             static_cast<double (*)(const MMFF94VanDerWaalsInteraction&, const CoordsArray&)>(
+                                                                                 &calcMMFF94VanDerWaalsEnergy<double, CoordsArray>));
+}
+
+template <typename CoordsArray, typename GradVector>
+void CDPL::ForceField::MMFF94PackedGradientCalculator::calcCutoffNonbondedGradient(const CoordsArray& coords, GradVector& grad)
+{
+    double sw_on_dist = Detail::getSwitchingOnDistance(nonbondedCutoff, nonbondedSwitchingWidth);
+
+    if (interactionTypes & InteractionType::ELECTROSTATIC)
+        electrostaticEnergy = Detail::calcSwitchedInteractionGradient<double>(electrostaticData,
+                                                                              Detail::updateNeighborList(elecNeighborList, electrostaticData, coords, nonbondedCutoff),
+                                                                              coords, grad, sw_on_dist, nonbondedCutoff,
+                                                                              static_cast<double (*)(const MMFF94ElectrostaticInteraction&, const CoordsArray&, Detail::PairGradient<double>&)>(
+                                                                                  &calcMMFF94ElectrostaticGradient<double, CoordsArray, Detail::PairGradient<double> >));
+
+    if (interactionTypes & InteractionType::VAN_DER_WAALS)
+        vanDerWaalsEnergy = Detail::calcSwitchedInteractionGradient<double>(vanDerWaalsData,
+                                                                            Detail::updateNeighborList(vdwNeighborList, vanDerWaalsData, coords, nonbondedCutoff),
+                                                                            coords, grad, sw_on_dist, nonbondedCutoff,
+                                                                            static_cast<double (*)(const MMFF94VanDerWaalsInteraction&, const CoordsArray&, Detail::PairGradient<double>&)>(
+                                                                                &calcMMFF94VanDerWaalsGradient<double, CoordsArray, Detail::PairGradient<double> >));
+}
+
+template <typename CoordsArray>
+void CDPL::ForceField::MMFF94PackedGradientCalculator::loadCoordinates(const CoordsArray& coords)
+{
+    double* buf = coordsBuffer.data();
+
+    for (std::size_t i = 0; i < numAtoms; i++, buf += 3) {
+        buf[0] = coords[i][0];
+        buf[1] = coords[i][1];
+        buf[2] = coords[i][2];
+    }
+}
+
+template <typename GradVector>
+void CDPL::ForceField::MMFF94PackedGradientCalculator::addPackedGradient(GradVector& grad) const
+{
+    const double* buf = gradBuffer.data();
+
+    for (std::size_t i = 0; i < numAtoms; i++, buf += 3) {
+        grad[i][0] += buf[0];
+        grad[i][1] += buf[1];
+        grad[i][2] += buf[2];
+    }
+}
+
+// \endcond
+
+#endif // CDPL_FORCEFIELD_MMFF94PACKEDGRADIENTCALCULATOR_HPP
@@ -0,0 +1,224 @@
+/*
+ * NonbondedNeighborList.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of class CDPL::ForceField::NonbondedNeighborList.
+ */
+
+#ifndef CDPL_FORCEFIELD_NONBONDEDNEIGHBORLIST_HPP
+#define CDPL_FORCEFIELD_NONBONDEDNEIGHBORLIST_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "CDPL/ForceField/APIPrefix.hpp"
+
+
+namespace CDPL
+{
+
+    namespace ForceField
+    {
+
+        /**
+         * \brief Verlet neighbor list selecting the atom pair interactions of a pair interaction list (e.g.
+         *        ForceField::MMFF94VanDerWaalsInteractionList) that lie within a given cutoff distance.
+         *
+         * The neighbor list stores the indices of all interactions whose atom distance is less than the cutoff
+         * distance plus a skin distance. The list is rebuilt by update() via a spatial cell list only if at least one atom has
+         * moved by more than half of the skin distance since the last rebuild. Otherwise, the stored interaction
+         * indices remain valid and the rebuild is skipped. Interactions for which the current atom distance exceeds the
+         * cutoff have to be filtered out by the consumer of the list.
+         *
+         * \since 1.4
+         */
+        class CDPL_FORCEFIELD_API NonbondedNeighborList
+        {
+
+          public:
+            /**
+             * \brief The array type storing the indices of the selected interactions.
+             */
+            typedef std::vector<std::size_t> IndexArray;
+
+            /**
+             * \brief The default skin distance in Å.
+             */
+            static constexpr double DEF_SKIN_DISTANCE = 2.0;
+
+            /**
+             * \brief Constructs an empty neighbor list with a cutoff distance of zero.
+             */
+            NonbondedNeighborList();
+
+            /**
+             * \brief Sets the cutoff distance.
+             * \param cutoff The cutoff distance in Å.
+             * \note Changing the cutoff distance forces a rebuild of the list by the next call to update().
+             */
+            void setCutoff(double cutoff);
+
+            /**
+             * \brief Returns the cutoff distance.
+             * \return The cutoff distance in Å.
+             */
+            double getCutoff() const;
+
+            /**
+             * \brief Sets the skin distance that gets added to the cutoff distance when the list is built.
+             *
+             * Larger values lead to less frequent rebuilds but more interactions that have to be checked by the consumer.
+             *
+             * \param skin The skin distance in Å.
+             * \note Changing the skin distance forces a rebuild of the list by the next call to update().
+             */
+            void setSkinDistance(double skin);
+
+            /**
+             * \brief Returns the skin distance.
+             * \return The skin distance in Å.
+             */
+            double getSkinDistance() const;
+
+            /**
+             * \brief Initializes the list with the pair interactions in the range [\a beg, \a end).
+             *
+             * The referenced objects must provide the methods \c getAtom1Index() and \c getAtom2Index().
+             * The stored indices refer to the position of the interaction in the specified range.
+             *
+             * \tparam Iter The iterator type.
+             * \param beg An iterator pointing to the first interaction.
+             * \param end An iterator pointing one past the last interaction.
+             */
+            template <typename Iter>
+            void setup(Iter beg, const Iter& end);
+
+            /**
+             * \brief Removes all interactions.
+             */
+            void clear();
+
+            /**
+             * \brief Returns the number of interactions specified by the last call to setup().
+             * \return The number of interactions.
+             */
+            std::size_t getNumInteractions() const;
+
+            /**
+             * \brief Rebuilds the list of neighboring interactions if required for the atom positions \a coords.
+             * \tparam CoordsArray The array type storing the atom 3D coordinates.
+             * \param coords The current atom 3D coordinates.
+             * \return \c true if the list has been rebuilt, and \c false otherwise.
+             */
+            template <typename CoordsArray>
+            bool update(const CoordsArray& coords);
+
+            /**
+             * \brief Returns the indices of the interactions whose atom distance was within the cutoff plus skin distance at
+             *        the time of the last rebuild.
+             * \return The indices of the selected interactions in ascending order.
+             */
+            const IndexArray& getInteractionIndices() const;
+
+          private:
+            struct PairEntry
+            {
+
+                bool operator<(const PairEntry& entry) const;
+
+                std::size_t partner;
+                std::size_t interaction;
+            };
+
+            typedef std::vector<PairEntry> PairEntryArray;
+            typedef std::vector<double>    CoordinatesArray;
+
+            void startPairCounting();
+            void countPair(std::size_t atom1_idx, std::size_t atom2_idx);
+            void initPairTable();
+            void insertPair(std::size_t atom1_idx, std::size_t atom2_idx, std::size_t ia_idx);
+            void finishPairTable();
+
+            bool rebuildRequired() const;
+            void rebuild();
+            void addNeighborInteractions(std::size_t atom1_idx, std::size_t atom2_idx);
+
+            double           cutoff;
+            double           skinDistance;
+            bool             valid;
+            std::size_t      numAtoms;
+            std::size_t      numInteractions;
+            IndexArray       pairOffsets;
+            PairEntryArray   pairEntries;
+            CoordinatesArray atomPositions;
+            CoordinatesArray refAtomPositions;
+            IndexArray       cellHeads;
+            IndexArray       cellLinks;
+            IndexArray       interactionIndices;
+        };
+    } // namespace ForceField
+} // namespace CDPL
+
+
+// Implementation
+// \cond DOC_IMPL_DETAILS
+
+template <typename Iter>
+void CDPL::ForceField::NonbondedNeighborList::setup(Iter beg, const Iter& end)
+{
+    startPairCounting();
+
+    for (Iter it = beg; it != end; ++it)
+        countPair(it->getAtom1Index(), it->getAtom2Index());
+
+    initPairTable();
+
+    for (std::size_t i = 0; beg != end; ++beg, i++)
+        insertPair(beg->getAtom1Index(), beg->getAtom2Index(), i);
+
+    finishPairTable();
+}
+
+template <typename CoordsArray>
+bool CDPL::ForceField::NonbondedNeighborList::update(const CoordsArray& coords)
+{
+    double* pos = atomPositions.data();
+
+    for (std::size_t i = 0; i < numAtoms; i++, pos += 3) {
+        pos[0] = coords[i][0];
+        pos[1] = coords[i][1];
+        pos[2] = coords[i][2];
+    }
+
+    if (!rebuildRequired())
+        return false;
+
+    rebuild();
+
+    return true;
+}
+
+// \endcond
+
+#endif // CDPL_FORCEFIELD_NONBONDEDNEIGHBORLIST_HPP
@@ -30,8 +30,11 @@
 #define CDPL_FORCEFIELD_UTILITYFUNCTIONS_HPP
 
 #include <cmath>
+#include <cstddef>
+#include <algorithm>
 
 #include "CDPL/ForceField/APIPrefix.hpp"
+#include "CDPL/ForceField/NonbondedNeighborList.hpp"
 #include "CDPL/Util/BitSet.hpp"
 
 
@@ -45,6 +48,9 @@ namespace CDPL
 
         /**
          * \brief Filters an MMFF94 interaction data set, retaining only those interactions that exclusively reference atoms in \a inc_atom_mask.
+         *
+         * The nonbonded interaction cutoff settings of \a ia_data get transferred to \a filtered_ia_data.
+         *
          * \param ia_data The input interaction data set.
          * \param filtered_ia_data The output interaction data set receiving the retained interactions.
          * \param inc_atom_mask A bit set whose set bits correspond to the indices of atoms that may appear in a retained interaction.
@@ -627,6 +633,139 @@ namespace CDPL
 
                 return e;
             }
+
+            /*
+             * Switching function S(r) (CHARMM form) decaying smoothly from 1 at r_on to 0 at r_off.
+             * Stores (dS/dr) / r in deriv_fact.
+             */
+            template <typename ValueType>
+            ValueType calcSwitchingFunction(const ValueType& r_2, const ValueType& r_on_2, const ValueType& r_off_2, ValueType& deriv_fact)
+            {
+                ValueType tmp1  = r_off_2 - r_2;
+                ValueType tmp2  = r_off_2 - r_on_2;
+                ValueType denom = tmp2 * tmp2 * tmp2;
+
+                deriv_fact = ValueType(12) * tmp1 * (r_on_2 - r_2) / denom;
+
+                return (tmp1 * tmp1 * (r_off_2 + 2 * r_2 - 3 * r_on_2) / denom);
+            }
+
+            /*
+             * Gradient vector array stand-in receiving the gradient contributions of a single atom pair interaction.
+             */
+            template <typename ValueType>
+            class PairGradient
+            {
+
+              public:
+                typedef ValueType VectorType[3];
+
+                PairGradient(std::size_t atom1_idx):
+                    atom1Index(atom1_idx), grad()
+                {}
+
+                VectorType& operator[](std::size_t atom_idx)
+                {
+                    return grad[atom_idx == atom1Index ? 0 : 1];
+                }
+
+              private:
+                std::size_t atom1Index;
+                VectorType  grad[2];
+            };
+
+            inline double getSwitchingOnDistance(double cutoff, double sw_width)
+            {
+                return std::max(cutoff - std::max(sw_width, 0.0), 0.0);
+            }
+
+            template <typename IAList, typename CoordsArray>
+            const NonbondedNeighborList::IndexArray& updateNeighborList(NonbondedNeighborList& nbr_list, const IAList& ia_list,
+                                                                        const CoordsArray& coords, double cutoff)
+            {
+                if (nbr_list.getCutoff() != cutoff)
+                    nbr_list.setCutoff(cutoff);
+
+                if (nbr_list.getNumInteractions() != ia_list.getSize())
+                    nbr_list.setup(ia_list.getElementsBegin(), ia_list.getElementsEnd());
+
+                nbr_list.update(coords);
+
+                return nbr_list.getInteractionIndices();
+            }
+
+            template <typename ValueType, typename IAList, typename IndexArray, typename CoordsArray, typename FuncType>
+            ValueType accumSwitchedInteractionEnergies(const IAList& ia_list, const IndexArray& ia_indices, const CoordsArray& coords,
+                                                       const ValueType& r_on, const ValueType& r_off, const FuncType& func)
+            {
+                ValueType e       = ValueType();
+                ValueType r_on_2  = r_on * r_on;
+                ValueType r_off_2 = r_off * r_off;
+                ValueType sw_deriv_fact;
+
+                for (typename IndexArray::const_iterator it = ia_indices.begin(), end = ia_indices.end(); it != end; ++it) {
+                    const typename IAList::ElementType& iaction = ia_list[*it];
+                    ValueType r_2 = calcSquaredDistance<ValueType>(coords[iaction.getAtom1Index()], coords[iaction.getAtom2Index()]);
+
+                    if (r_2 >= r_off_2)
+                        continue;
+
+                    if (r_2 <= r_on_2)
+                        e += func(iaction, coords);
+                    else
+                        e += func(iaction, coords) * calcSwitchingFunction(r_2, r_on_2, r_off_2, sw_deriv_fact);
+                }
+
+                return e;
+            }
+
+            template <typename ValueType, typename IAList, typename IndexArray, typename CoordsArray, typename GradVector, typename FuncType>
+            ValueType calcSwitchedInteractionGradient(const IAList& ia_list, const IndexArray& ia_indices, const CoordsArray& coords, GradVector& grad,
+                                                      const ValueType& r_on, const ValueType& r_off, const FuncType& func)
+            {
+                ValueType e       = ValueType();
+                ValueType r_on_2  = r_on * r_on;
+                ValueType r_off_2 = r_off * r_off;
+                ValueType dist_vec[3];
+
+                for (typename IndexArray::const_iterator it = ia_indices.begin(), end = ia_indices.end(); it != end; ++it) {
+                    const typename IAList::ElementType& iaction = ia_list[*it];
+                    std::size_t atom1_idx = iaction.getAtom1Index();
+                    std::size_t atom2_idx = iaction.getAtom2Index();
+
+                    subVectors(coords[atom2_idx], coords[atom1_idx], dist_vec);
+
+                    ValueType r_2 = calcDotProduct<ValueType>(dist_vec, dist_vec);
+
+                    if (r_2 >= r_off_2)
+                        continue;
+
+                    PairGradient<ValueType> pair_grad(atom1_idx);
+                    ValueType e_ij = func(iaction, coords, pair_grad);
+
+                    if (r_2 <= r_on_2) {
+                        addVectors(pair_grad[atom1_idx], grad[atom1_idx], grad[atom1_idx]);
+                        addVectors(pair_grad[atom2_idx], grad[atom2_idx], grad[atom2_idx]);
+
+                        e += e_ij;
+                        continue;
+                    }
+
+                    // d(E * S)/dp = S * dE/dp + E * dS/dr * dr/dp
+
+                    ValueType sw_deriv_fact;
+                    ValueType sw = calcSwitchingFunction(r_2, r_on_2, r_off_2, sw_deriv_fact);
+
+                    scaleAddVector(pair_grad[atom1_idx], sw, grad[atom1_idx]);
+                    scaleAddVector(pair_grad[atom2_idx], sw, grad[atom2_idx]);
+                    scaleAddVector(dist_vec, e_ij * sw_deriv_fact, grad[atom1_idx]);
+                    scaleAddVector(dist_vec, -e_ij * sw_deriv_fact, grad[atom2_idx]);
+
+                    e += e_ij * sw;
+                }
+
+                return e;
+            }
         } // namespace Detail
     } // namespace ForceField
 } // namespace CDPL
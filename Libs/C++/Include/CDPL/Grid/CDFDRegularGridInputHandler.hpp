@@ -32,6 +32,8 @@
 #include "CDPL/Grid/DataFormat.hpp"
 #include "CDPL/Grid/CDFDRegularGridReader.hpp"
 #include "CDPL/Util/DefaultDataInputHandler.hpp"
+#include "CDPL/Util/FileDataReader.hpp"
+#include "CDPL/Util/MappedFileIStream.hpp"
 
 
 namespace CDPL
@@ -42,8 +44,12 @@ namespace CDPL
 
         /**
          * \brief Handler for the input of regular spatial grid data in the native I/O format of the <em>%CDPL</em>.
+         *
+         * Files are read via a memory-mapped Util::MappedFileIStream, which lets the record data get decoded
+         * directly from the mapped file pages.
          */
-        typedef Util::DefaultDataInputHandler<CDFDRegularGridReader, DataFormat::CDF> CDFDRegularGridInputHandler;
+        typedef Util::DefaultDataInputHandler<CDFDRegularGridReader, DataFormat::CDF, DRegularGrid,
+                                              Util::FileDataReader<CDFDRegularGridReader, DRegularGrid, Util::MappedFileIStream> > CDFDRegularGridInputHandler;
     } // namespace Grid
 } // namespace CDPL
 
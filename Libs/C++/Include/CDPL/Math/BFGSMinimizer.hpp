@@ -28,7 +28,9 @@
 #define CDPL_MATH_BFGSMINIMIZER_HPP
 
 #include <cstddef>
+#include <cmath>
 #include <limits>
+#include <algorithm>
 #include <functional>
 
 #include "CDPL/Math/MinimizerVariableArrayTraits.hpp"
@@ -111,13 +113,46 @@ namespace CDPL
                 DELTAF_REACHED = 8
             };
 
+            /**
+             * \brief Specifies the kind of evaluation requested by advance().
+             * \since 1.4
+             */
+            enum EvaluationRequest
+            {
+
+                /**
+                 * \brief No evaluation required - the minimization has been finished (see getStatus()).
+                 */
+                NO_EVALUATION,
+
+                /**
+                 * \brief The objective function value at getEvaluationPoint() has to be supplied via setFunctionValue().
+                 */
+                VALUE_EVALUATION,
+
+                /**
+                 * \brief The objective function value and gradient at getEvaluationPoint() have to be supplied via
+                 *        setFunctionGradient().
+                 */
+                GRADIENT_EVALUATION
+            };
+
             /**
              * \brief Constructs the \c %BFGSMinimizer instance with the given objective and gradient functions.
              * \param func The objective function.
              * \param grad_func The gradient function (also computes the objective value).
              */
             BFGSMinimizer(const ObjectiveFunction& func, const GradientFunction& grad_func):
-                rho(0.01), tau1(9), tau2(0.05), tau3(0.5), order(3), sigma(0.1), func(func), gradFunc(grad_func), status(SUCCESS) {}
+                rho(0.01), tau1(9), tau2(0.05), tau3(0.5), order(3), sigma(0.1), func(func), gradFunc(grad_func), status(SUCCESS),
+                state(FINISHED) {}
+
+            /**
+             * \brief Constructs a \c %BFGSMinimizer instance without objective and gradient functions that can only be
+             *        used via the reverse communication interface (see start()).
+             * \since 1.4
+             */
+            BFGSMinimizer():
+                rho(0.01), tau1(9), tau2(0.05), tau3(0.5), order(3), sigma(0.1), status(SUCCESS), state(FINISHED) {}
 
             /**
              * \brief Returns the L2 norm of the gradient at the end of the most recent iterate() call.
@@ -188,11 +223,7 @@ namespace CDPL
                     if (status != SUCCESS)
                         return status;
 
-                    if (g_norm >= ValueType(0) && g0Norm <= g_norm)
-                        status = GNORM_REACHED;
-
-                    if (delta_f >= ValueType(0) && deltaF <= delta_f)
-                        status = Status(status | DELTAF_REACHED);
+                    status = checkStopConditions(g_norm, delta_f);
 
                     if (status != SUCCESS)
                         return status;
@@ -215,9 +246,234 @@ namespace CDPL
                 numIter = 0;
                 step    = step_size;
                 deltaF  = ValueType(0);
+                sigma   = tol;
 
                 startF = gradFunc(x, g);
 
+                initDirection(x, g);
+
+                return startF;
+            }
+
+            /**
+             * \brief Performs a single BFGS iteration: line search along the current search direction, BFGS update of the
+             *        inverse Hessian approximation, and selection of the new search direction.
+             * \param f The current function value (updated in place).
+             * \param x The current variable vector (updated in place).
+             * \param g The current gradient vector (updated in place).
+             * \return Status::SUCCESS if the iteration produced a step, otherwise the bitmask of stop conditions met.
+             */
+            Status iterate(ValueType& f, VariableArrayType& x, VariableArrayType& g)
+            {
+                if (numIter == 0)
+                    f = startF;
+
+                Status res = startIteration(f, x, g);
+
+                if (res != SUCCESS)
+                    return res;
+
+                for (EvaluationRequest req = continueIteration(); req != NO_EVALUATION; req = continueIteration())
+                    evaluate(req);
+
+                if (iterStatus == SUCCESS)
+                    f = fValue;
+
+                return iterStatus;
+            }
+
+            /**
+             * \brief Starts a minimization that is driven by the caller via the reverse communication interface.
+             *
+             * Instead of calling the objective and gradient functions, each call to advance() returns as soon as a function
+             * value or a function value and gradient at getEvaluationPoint() is required. The caller supplies the requested data via
+             * setFunctionValue() or setFunctionGradient() and calls advance() again until it returns
+             * EvaluationRequest::NO_EVALUATION. This allows to interleave multiple minimizations and to calculate the
+             * requested data in batches. The performed steps are exactly the same as those of setup() followed by
+             * minimize() with \a do_setup set to \c false.
+             *
+             * \param x The starting variable vector.
+             * \param max_iter The maximum number of iterations (\e 0 means unlimited).
+             * \param g_norm The gradient-norm threshold below which the minimization is stopped (negative values disable this stop condition).
+             * \param delta_f The function-value-delta threshold below which the minimization is stopped (negative values disable this stop condition).
+             * \param step_size The initial step-size guess.
+             * \param tol The line-search tolerance.
+             * \since 1.4
+             */
+            void start(const VariableArrayType& x, std::size_t max_iter, const ValueType& g_norm, const ValueType& delta_f,
+                       const ValueType& step_size = 0.001, const ValueType& tol = 0.15)
+            {
+                assign(position, x);
+
+                maxNumIter   = max_iter;
+                gNormThresh  = g_norm;
+                deltaFThresh = delta_f;
+                numIter      = 0;
+                step         = step_size;
+                deltaF       = ValueType(0);
+                sigma        = tol;
+                status       = SUCCESS;
+                evalPoint    = &position;
+                state        = SETUP;
+            }
+
+            /**
+             * \brief Advances the minimization started by start() until the next function evaluation is required
+             *        or the minimization has been finished.
+             * \return The kind of the requested evaluation, or EvaluationRequest::NO_EVALUATION if the minimization has
+             *         been finished.
+             * \since 1.4
+             */
+            EvaluationRequest advance()
+            {
+                while (true) {
+                    switch (state) {
+
+                        case SETUP:
+                            return GRADIENT_EVALUATION;
+
+                        case NEXT_ITERATION:
+                            if (maxNumIter != 0 && iterCount >= maxNumIter) {
+                                status = ITER_LIMIT_REACHED;
+                                state  = FINISHED;
+                                continue;
+                            }
+
+                            if (numIter == 0)
+                                fValue = startF;
+
+                            status = startIteration(fValue, position, gradient);
+
+                            if (status != SUCCESS) {
+                                state = FINISHED;
+                                continue;
+                            }
+
+                            state = ITERATION;
+                            continue;
+
+                        case ITERATION: {
+                            EvaluationRequest req = continueIteration();
+
+                            if (req != NO_EVALUATION)
+                                return req;
+
+                            status = (iterStatus != SUCCESS ? iterStatus : checkStopConditions(gNormThresh, deltaFThresh));
+
+                            if (status != SUCCESS) {
+                                state = FINISHED;
+                                continue;
+                            }
+
+                            iterCount++;
+                            state = NEXT_ITERATION;
+                            continue;
+                        }
+
+                        default:
+                            return NO_EVALUATION;
+                    }
+                }
+            }
+
+            /**
+             * \brief Returns the variable vector at which the function value or gradient requested by advance()
+             *        has to be calculated.
+             * \return A \c const reference to the evaluation point.
+             * \since 1.4
+             */
+            const VariableArrayType& getEvaluationPoint() const
+            {
+                return *evalPoint;
+            }
+
+            /**
+             * \brief Supplies the function value at getEvaluationPoint() requested by advance().
+             * \param f The function value.
+             * \since 1.4
+             */
+            void setFunctionValue(const ValueType& f)
+            {
+                fAlpha    = f;
+                fCacheKey = evalAlpha;
+            }
+
+            /**
+             * \brief Supplies the function value and gradient at getEvaluationPoint() requested by advance().
+             * \param f The function value.
+             * \param g The gradient.
+             * \since 1.4
+             */
+            void setFunctionGradient(const ValueType& f, const VariableArrayType& g)
+            {
+                if (state == SETUP) {
+                    startF = f;
+
+                    assign(gradient, g);
+                    initDirection(position, gradient);
+
+                    fValue    = ValueType(0);
+                    iterCount = 0;
+                    state     = NEXT_ITERATION;
+                    return;
+                }
+
+                assign(gAlpha, g);
+
+                fAlpha    = f;
+                gCacheKey = evalAlpha;
+                fCacheKey = evalAlpha;
+            }
+
+            /**
+             * \brief Returns the current variable vector of the minimization started by start().
+             * \return A \c const reference to the current variable vector.
+             * \since 1.4
+             */
+            const VariableArrayType& getPosition() const
+            {
+                return position;
+            }
+
+            /**
+             * \brief Returns the gradient at the current variable vector of the minimization started by start().
+             * \return A \c const reference to the current gradient.
+             * \since 1.4
+             */
+            const VariableArrayType& getGradient() const
+            {
+                return gradient;
+            }
+
+          private:
+            enum State
+            {
+
+                SETUP,
+                NEXT_ITERATION,
+                ITERATION,
+                FINISHED
+            };
+
+            enum IterationState
+            {
+
+                LINE_SEARCH_START,
+                BRACKETING,
+                BRACKETING_VALUE,
+                BRACKETING_SLOPE,
+                SECTIONING,
+                SECTIONING_VALUE,
+                SECTIONING_SLOPE,
+                POSITION_UPDATE,
+                ITERATION_FINISHED
+            };
+
+            static constexpr std::size_t NUM_BRACKETING_ITERATIONS = 100;
+            static constexpr std::size_t NUM_SECTIONING_ITERATIONS = 100;
+
+            void initDirection(const VariableArrayType& x, const VariableArrayType& g)
+            {
                 /* Use the gradient as the initial direction */
 
                 assign(x0, x);
@@ -233,52 +489,243 @@ namespace CDPL
                 /* Prepare the function evaluation cache */
 
                 initFuncEvalCache();
+            }
+
+            Status checkStopConditions(const ValueType& g_norm, const ValueType& delta_f) const
+            {
+                Status res = SUCCESS;
 
-                /* Prepare 1d minimisation parameters */
+                if (g_norm >= ValueType(0) && g0Norm <= g_norm)
+                    res = GNORM_REACHED;
 
-                sigma = tol;
+                if (delta_f >= ValueType(0) && deltaF <= delta_f)
+                    res = Status(res | DELTAF_REACHED);
 
-                return startF;
+                return res;
             }
 
-            /**
-             * \brief Performs a single BFGS iteration: line search along the current search direction, BFGS update of the
-             *        inverse Hessian approximation, and selection of the new search direction.
-             * \param f The current function value (updated in place).
-             * \param x The current variable vector (updated in place).
-             * \param g The current gradient vector (updated in place).
-             * \return Status::SUCCESS if the iteration produced a step, otherwise the bitmask of stop conditions met.
-             */
-            Status iterate(ValueType& f, VariableArrayType& x, VariableArrayType& g)
+            void evaluate(EvaluationRequest req)
             {
-                if (numIter == 0)
-                    f = startF;
+                if (req == VALUE_EVALUATION) {
+                    fAlpha    = func(xAlpha);
+                    fCacheKey = evalAlpha;
+                    return;
+                }
 
-                ValueType alpha = ValueType(0), alpha1;
-                ValueType f0    = f;
+                fAlpha    = gradFunc(xAlpha, gAlpha);
+                gCacheKey = evalAlpha;
+                fCacheKey = evalAlpha;
+            }
 
+            Status startIteration(const ValueType& f, VariableArrayType& x, VariableArrayType& g)
+            {
                 if (pNorm == ValueType(0) || g0Norm == ValueType(0) || fp0 == ValueType(0)) {
                     clear(dx);
                     return NO_PROGRESS;
                 }
 
+                iterX    = &x;
+                iterG    = &g;
+                iterF0   = f;
+                lsResult = ValueType(0);
+
                 if (deltaF < ValueType(0)) {
-                    ValueType del = std::max(-deltaF, 10 * std::numeric_limits<ValueType>::epsilon() * TypeTraits<ValueType>::abs(f0));
-                    alpha1        = std::min(ValueType(1), 2 * del / -fp0);
+                    ValueType del = std::max(-deltaF, 10 * std::numeric_limits<ValueType>::epsilon() * TypeTraits<ValueType>::abs(f));
+                    lsAlpha       = std::min(ValueType(1), 2 * del / -fp0);
 
                 } else
-                    alpha1 = TypeTraits<ValueType>::abs(step);
+                    lsAlpha = TypeTraits<ValueType>::abs(step);
+
+                iterState = LINE_SEARCH_START;
+
+                return SUCCESS;
+            }
+
+            /*
+             * Line minimisation with cubic interpolation (order = 3) along the current direction followed by the BFGS
+             * update - returns whenever a function value or gradient has to be calculated first.
+             */
+            EvaluationRequest continueIteration()
+            {
+                while (true) {
+                    switch (iterState) {
+
+                        case LINE_SEARCH_START:
+                            if (!getFDF(ValueType(0), lsF0, lsFp0))
+                                return evalRequest;
+
+                            lsAlphaPrev   = ValueType(0);
+                            lsA           = ValueType(0);
+                            lsFb          = ValueType(0);
+                            lsFpb         = ValueType(0);
+                            lsFAlphaPrev  = lsF0;
+                            lsFpAlphaPrev = lsFp0;
+                            lsB           = lsAlpha;
+                            lsFa          = lsF0;
+                            lsFpa         = lsFp0;
+                            lsIter        = 0;
+                            iterState     = BRACKETING;
+                            continue;
+
+                            /* Begin bracketing */
+
+                        case BRACKETING:
+                            iterState = (lsIter++ < NUM_BRACKETING_ITERATIONS ? BRACKETING_VALUE : SECTIONING);
+                            continue;
+
+                        case BRACKETING_VALUE:
+                            if (!getF(lsAlpha, lsFAlpha))
+                                return evalRequest;
+
+                            /* Fletcher's rho test */
+
+                            if (lsFAlpha > lsF0 + lsAlpha * rho * lsFp0 || lsFAlpha >= lsFAlphaPrev) {
+                                lsA       = lsAlphaPrev;
+                                lsFa      = lsFAlphaPrev;
+                                lsFpa     = lsFpAlphaPrev;
+                                lsB       = lsAlpha;
+                                lsFb      = lsFAlpha;
+                                lsFpb     = std::numeric_limits<ValueType>::quiet_NaN();
+                                iterState = SECTIONING;
+                                continue;
+                            }
+
+                            iterState = BRACKETING_SLOPE;
+                            continue;
+
+                        case BRACKETING_SLOPE: {
+                            if (!getDF(lsAlpha, lsFpAlpha))
+                                return evalRequest;
+
+                            /* Fletcher's sigma test */
+
+                            if (TypeTraits<ValueType>::abs(lsFpAlpha) <= -sigma * lsFp0) {
+                                lsResult  = lsAlpha;
+                                iterState = POSITION_UPDATE;
+                                continue;
+                            }
+
+                            if (lsFpAlpha >= ValueType(0)) {
+                                lsA       = lsAlpha;
+                                lsFa      = lsFAlpha;
+                                lsFpa     = lsFpAlpha;
+                                lsB       = lsAlphaPrev;
+                                lsFb      = lsFAlphaPrev;
+                                lsFpb     = lsFpAlphaPrev;
+                                iterState = SECTIONING;
+                                continue;
+                            }
+
+                            ValueType delta = lsAlpha - lsAlphaPrev;
+                            ValueType lower = lsAlpha + delta;
+                            ValueType upper = lsAlpha + tau1 * delta;
+
+                            ValueType alpha_next = interpolate(lsAlphaPrev, lsFAlphaPrev, lsFpAlphaPrev,
+                                                               lsAlpha, lsFAlpha, lsFpAlpha, lower, upper);
+
+                            lsAlphaPrev   = lsAlpha;
+                            lsFAlphaPrev  = lsFAlpha;
+                            lsFpAlphaPrev = lsFpAlpha;
+                            lsAlpha       = alpha_next;
+                            iterState     = BRACKETING;
+                            continue;
+                        }
 
-                /* line minimisation, with cubic interpolation (order = 3) */
+                            /*  Sectioning of bracket [a, b] */
 
-                Status status = minimize(alpha1, alpha);
+                        case SECTIONING: {
+                            if (lsIter++ >= NUM_SECTIONING_ITERATIONS) {
+                                iterState = POSITION_UPDATE;
+                                continue;
+                            }
 
-                if (status != SUCCESS)
-                    return status;
+                            ValueType delta = lsB - lsA;
+                            ValueType lower = lsA + tau2 * delta;
+                            ValueType upper = lsB - tau3 * delta;
 
-                updatePosition(alpha, x, f, g);
+                            lsAlpha   = interpolate(lsA, lsFa, lsFpa, lsB, lsFb, lsFpb, lower, upper);
+                            iterState = SECTIONING_VALUE;
+                            continue;
+                        }
+
+                        case SECTIONING_VALUE:
+                            if (!getF(lsAlpha, lsFAlpha))
+                                return evalRequest;
+
+                            if ((lsA - lsAlpha) * lsFpa <= std::numeric_limits<ValueType>::epsilon()) {
+                                /* roundoff prevents progress */
+                                iterStatus = NO_PROGRESS;
+                                iterState  = ITERATION_FINISHED;
+                                continue;
+                            }
+
+                            if (lsFAlpha > lsF0 + rho * lsAlpha * lsFp0 || lsFAlpha >= lsFa) {
+                                /*  a_next = a; */
+                                lsB       = lsAlpha;
+                                lsFb      = lsFAlpha;
+                                lsFpb     = std::numeric_limits<ValueType>::quiet_NaN();
+                                iterState = SECTIONING;
+                                continue;
+                            }
+
+                            iterState = SECTIONING_SLOPE;
+                            continue;
+
+                        case SECTIONING_SLOPE:
+                            if (!getDF(lsAlpha, lsFpAlpha))
+                                return evalRequest;
+
+                            if (TypeTraits<ValueType>::abs(lsFpAlpha) <= -sigma * lsFp0) {
+                                lsResult  = lsAlpha;
+                                iterState = POSITION_UPDATE;
+                                continue;
+                            }
+
+                            if (((lsB - lsA) >= ValueType(0) && lsFpAlpha >= ValueType(0)) || ((lsB - lsA) <= ValueType(0) && lsFpAlpha <= ValueType(0))) {
+                                lsB   = lsA;
+                                lsFb  = lsFa;
+                                lsFpb = lsFpa;
+                                lsA   = lsAlpha;
+                                lsFa  = lsFAlpha;
+                                lsFpa = lsFpAlpha;
+
+                            } else {
+                                lsA   = lsAlpha;
+                                lsFa  = lsFAlpha;
+                                lsFpa = lsFpAlpha;
+                            }
+
+                            iterState = SECTIONING;
+                            continue;
+
+                        case POSITION_UPDATE: {
+                            ValueType f_alpha, df_alpha;
+
+                            /* ensure that everything is fully cached */
+
+                            if (!getFDF(lsResult, f_alpha, df_alpha))
+                                return evalRequest;
+
+                            fValue = f_alpha;
+                            assign(*iterX, xAlpha);
+                            assign(*iterG, gAlpha);
+
+                            updateDirection(*iterX, *iterG);
+
+                            iterStatus = SUCCESS;
+                            iterState  = ITERATION_FINISHED;
+                            continue;
+                        }
+
+                        default:
+                            return NO_EVALUATION;
+                    }
+                }
+            }
 
-                deltaF = f - f0;
+            void updateDirection(const VariableArrayType& x, const VariableArrayType& g)
+            {
+                deltaF = fValue - iterF0;
 
                 /* Choose a new direction for the next step */
 
@@ -335,11 +782,8 @@ namespace CDPL
                 changeDirection();
 
                 numIter++;
-
-                return SUCCESS;
             }
 
-          private:
             void initFuncEvalCache()
             {
                 assign(xAlpha, x0);
@@ -407,78 +851,67 @@ namespace CDPL
                 xCacheKey = alpha;
             }
 
-            ValueType getF(const ValueType& alpha)
+            /* 
+             * The following functions return false if the requested quantity is not cached and has to be
+             * calculated first (see evalRequest).
+             */
+            bool getF(const ValueType& alpha, ValueType& f)
             {
-                if (alpha == fCacheKey) /* using previously cached f(alpha) */
-                    return fAlpha;
-
-                moveTo(alpha);
-
-                fAlpha    = func(xAlpha);
-                fCacheKey = alpha;
+                if (alpha != fCacheKey) {
+                    requestEvaluation(alpha, VALUE_EVALUATION);
+                    return false;
+                }
 
-                return fAlpha;
+                f = fAlpha; /* using previously cached f(alpha) */
+                return true;
             }
 
-            ValueType getDF(const ValueType& alpha)
+            bool getDF(const ValueType& alpha, ValueType& df)
             {
-                if (alpha == dfCacheKey) /* using previously cached df(alpha) */
-                    return dfAlpha;
+                if (alpha != dfCacheKey) {
+                    if (alpha != gCacheKey) {
+                        requestEvaluation(alpha, GRADIENT_EVALUATION);
+                        return false;
+                    }
 
-                moveTo(alpha);
+                    moveTo(alpha);
 
-                if (alpha != gCacheKey) {
-                    fAlpha    = gradFunc(xAlpha, gAlpha);
-                    gCacheKey = alpha;
-                    fCacheKey = alpha;
+                    dfAlpha    = slope();
+                    dfCacheKey = alpha;
                 }
 
-                dfAlpha    = slope();
-                dfCacheKey = alpha;
-
-                return dfAlpha;
+                df = dfAlpha; /* using previously cached df(alpha) */
+                return true;
             }
 
-            void getFDF(const ValueType& alpha, ValueType& f, ValueType& df)
+            bool getFDF(const ValueType& alpha, ValueType& f, ValueType& df)
             {
                 /* Check for previously cached values */
 
                 if (alpha == fCacheKey && alpha == dfCacheKey) {
                     f  = fAlpha;
                     df = dfAlpha;
-                    return;
+                    return true;
                 }
 
                 if (alpha == fCacheKey || alpha == dfCacheKey) {
-                    df = getDF(alpha);
-                    f  = getF(alpha);
-                    return;
-                }
-
-                moveTo(alpha);
-
-                fAlpha    = gradFunc(xAlpha, gAlpha);
-                fCacheKey = alpha;
-                gCacheKey = alpha;
+                    if (!getDF(alpha, df))
+                        return false;
 
-                dfAlpha    = slope();
-                dfCacheKey = alpha;
+                    return getF(alpha, f);
+                }
 
-                f  = fAlpha;
-                df = dfAlpha;
+                requestEvaluation(alpha, GRADIENT_EVALUATION);
+                return false;
             }
 
-            void updatePosition(const ValueType& alpha, VariableArrayType& x, ValueType& f, VariableArrayType& g)
+            void requestEvaluation(const ValueType& alpha, EvaluationRequest req)
             {
-                ValueType f_alpha, df_alpha;
-
-                /* ensure that everything is fully cached */
-
-                getFDF(alpha, f_alpha, df_alpha);
+                moveTo(alpha);
 
-                f = f_alpha;
-                assign(x, xAlpha);
-                assign(g, gAlpha);
+                evalPoint   = &xAlpha;
+                evalAlpha   = alpha;
+                evalRequest = req;
             }
 
             void changeDirection()
@@ -679,156 +1112,68 @@ namespace CDPL
                 return alpha;
             }
 
-            Status minimize(const ValueType& alpha1, ValueType& alpha_new)
-            {
-                ValueType falpha, fpalpha, delta, alpha_next;
-                ValueType alpha = alpha1, alpha_prev = ValueType(0);
-                ValueType a = ValueType(0), fb = ValueType(0), fpb = ValueType(0);
-
-                ValueType f0, fp0;
-
-                getFDF(ValueType(0), f0, fp0);
-
-                ValueType falpha_prev  = f0;
-                ValueType fpalpha_prev = fp0;
-
-                ValueType b   = alpha;
-                ValueType fa  = f0;
-                ValueType fpa = fp0;
-
-                /* Begin bracketing */
-
-                const std::size_t num_brack_iter = 100, section_iters = 100;
-                std::size_t       i = 0;
-
-                while (i++ < num_brack_iter) {
-                    falpha = getF(alpha);
-
-                    /* Fletcher's rho test */
-
-                    if (falpha > f0 + alpha * rho * fp0 || falpha >= falpha_prev) {
-                        a   = alpha_prev;
-                        fa  = falpha_prev;
-                        fpa = fpalpha_prev;
-                        b   = alpha;
-                        fb  = falpha;
-                        fpb = std::numeric_limits<ValueType>::quiet_NaN();
-                        break; /* goto sectioning */
-                    }
-
-                    fpalpha = getDF(alpha);
-
-                    /* Fletcher's sigma test */
-
-                    if (TypeTraits<ValueType>::abs(fpalpha) <= -sigma * fp0) {
-                        alpha_new = alpha;
-                        return SUCCESS;
-                    }
-
-                    if (fpalpha >= ValueType(0)) {
-                        a   = alpha;
-                        fa  = falpha;
-                        fpa = fpalpha;
-                        b   = alpha_prev;
-                        fb  = falpha_prev;
-                        fpb = fpalpha_prev;
-                        break; /* goto sectioning */
-                    }
-
-                    delta = alpha - alpha_prev;
-
-                    ValueType lower = alpha + delta;
-                    ValueType upper = alpha + tau1 * delta;
-
-                    alpha_next = interpolate(alpha_prev, falpha_prev, fpalpha_prev,
-                                             alpha, falpha, fpalpha, lower, upper);
-
-                    alpha_prev   = alpha;
-                    falpha_prev  = falpha;
-                    fpalpha_prev = fpalpha;
-                    alpha        = alpha_next;
-                }
-
-                /*  Sectioning of bracket [a, b] */
-
-                while (i++ < section_iters) {
-                    delta = b - a;
-
-                    ValueType lower = a + tau2 * delta;
-                    ValueType upper = b - tau3 * delta;
-
-                    alpha  = interpolate(a, fa, fpa, b, fb, fpb, lower, upper);
-                    falpha = getF(alpha);
-
-                    if ((a - alpha) * fpa <= std::numeric_limits<ValueType>::epsilon()) {
-                        /* roundoff prevents progress */
-                        return NO_PROGRESS;
-                    }
-
-                    if (falpha > f0 + rho * alpha * fp0 || falpha >= fa) {
-                        /*  a_next = a; */
-                        b   = alpha;
-                        fb  = falpha;
-                        fpb = std::numeric_limits<ValueType>::quiet_NaN();
-
-                    } else {
-                        fpalpha = getDF(alpha);
-
-                        if (TypeTraits<ValueType>::abs(fpalpha) <= -sigma * fp0) {
-                            alpha_new = alpha;
-                            return SUCCESS; /* terminate */
-                        }
-
-                        if (((b - a) >= ValueType(0) && fpalpha >= ValueType(0)) || ((b - a) <= ValueType(0) && fpalpha <= ValueType(0))) {
-                            b   = a;
-                            fb  = fa;
-                            fpb = fpa;
-                            a   = alpha;
-                            fa  = falpha;
-                            fpa = fpalpha;
-
-                        } else {
-                            a   = alpha;
-                            fa  = falpha;
-                            fpa = fpalpha;
-                        }
-                    }
-                }
-
-                return SUCCESS;
-            }
-
-            const ValueType   rho;
-            const ValueType   tau1;
-            const ValueType   tau2;
-            const ValueType   tau3;
-            const std::size_t order;
-            std::size_t       numIter;
-            ValueType         step;
-            ValueType         g0Norm;
-            ValueType         pNorm;
-            ValueType         startF;
-            ValueType         deltaF;
-            ValueType         fValue;
-            ValueType         fp0;
-            VariableArrayType x0;
-            VariableArrayType g0;
-            VariableArrayType p;
-            VariableArrayType dx;
-            VariableArrayType dx0;
-            VariableArrayType dg0;
-            VariableArrayType xAlpha;
-            VariableArrayType gAlpha;
-            ValueType         sigma;
-            ValueType         fAlpha;
-            ValueType         dfAlpha;
-            ValueType         fCacheKey;
-            ValueType         dfCacheKey;
-            ValueType         xCacheKey;
-            ValueType         gCacheKey;
-            ObjectiveFunction func;
-            GradientFunction  gradFunc;
-            Status            status;
+            const ValueType          rho;
+            const ValueType          tau1;
+            const ValueType          tau2;
+            const ValueType          tau3;
+            const std::size_t        order;
+            std::size_t              numIter;
+            ValueType                step;
+            ValueType                g0Norm;
+            ValueType                pNorm;
+            ValueType                startF;
+            ValueType                deltaF;
+            ValueType                fValue;
+            ValueType                fp0;
+            VariableArrayType        x0;
+            VariableArrayType        g0;
+            VariableArrayType        p;
+            VariableArrayType        dx;
+            VariableArrayType        dx0;
+            VariableArrayType        dg0;
+            VariableArrayType        xAlpha;
+            VariableArrayType        gAlpha;
+            ValueType                sigma;
+            ValueType                fAlpha;
+            ValueType                dfAlpha;
+            ValueType                fCacheKey;
+            ValueType                dfCacheKey;
+            ValueType                xCacheKey;
+            ValueType                gCacheKey;
+            ObjectiveFunction        func;
+            GradientFunction         gradFunc;
+            Status                   status;
+            State                    state;
+            IterationState           iterState;
+            Status                   iterStatus;
+            VariableArrayType*       iterX;
+            VariableArrayType*       iterG;
+            ValueType                iterF0;
+            ValueType                lsResult;
+            ValueType                lsAlpha;
+            ValueType                lsAlphaPrev;
+            ValueType                lsFAlpha;
+            ValueType                lsFAlphaPrev;
+            ValueType                lsFpAlpha;
+            ValueType                lsFpAlphaPrev;
+            ValueType                lsF0;
+            ValueType                lsFp0;
+            ValueType                lsA;
+            ValueType                lsB;
+            ValueType                lsFa;
+            ValueType                lsFb;
+            ValueType                lsFpa;
+            ValueType                lsFpb;
+            std::size_t              lsIter;
+            const VariableArrayType* evalPoint;
+            ValueType                evalAlpha;
+            EvaluationRequest        evalRequest;
+            VariableArrayType        position;
+            VariableArrayType        gradient;
+            std::size_t              maxNumIter;
+            std::size_t              iterCount;
+            ValueType                gNormThresh;
+            ValueType                deltaFThresh;
         };
     } // namespace Math
 } // namespace CDPL
@@ -128,5 +128,7 @@
 # include "CDPL/Pharm/PSDMolecularGraphWriter.hpp"
 # include "CDPL/Pharm/PSDScreeningDBCreator.hpp"
 # include "CDPL/Pharm/PSDScreeningDBAccessor.hpp"
+#include "CDPL/Pharm/MappedPSDScreeningDBAccessor.hpp"
+#include "CDPL/Pharm/MappedPSDScreeningDBWriter.hpp"
 
 #endif // CDPL_PHARM_HPP
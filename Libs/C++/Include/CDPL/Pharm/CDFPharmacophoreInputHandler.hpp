@@ -32,6 +32,8 @@
 #include "CDPL/Pharm/DataFormat.hpp"
 #include "CDPL/Pharm/CDFPharmacophoreReader.hpp"
 #include "CDPL/Util/DefaultDataInputHandler.hpp"
+#include "CDPL/Util/FileDataReader.hpp"
+#include "CDPL/Util/MappedFileIStream.hpp"
 
 
 namespace CDPL
@@ -42,8 +44,12 @@ namespace CDPL
 
         /**
          * \brief Handler for the input of pharmacophore data in the native I/O format of the <em>%CDPL</em>.
+         *
+         * Files are read via a memory-mapped Util::MappedFileIStream, which lets the record data get decoded
+         * directly from the mapped file pages.
          */
-        typedef Util::DefaultDataInputHandler<CDFPharmacophoreReader, DataFormat::CDF> CDFPharmacophoreInputHandler;
+        typedef Util::DefaultDataInputHandler<CDFPharmacophoreReader, DataFormat::CDF, Pharmacophore,
+                                              Util::FileDataReader<CDFPharmacophoreReader, Pharmacophore, Util::MappedFileIStream> > CDFPharmacophoreInputHandler;
     } // namespace Pharm
 } // namespace CDPL
 
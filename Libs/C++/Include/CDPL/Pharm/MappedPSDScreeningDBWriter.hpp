@@ -0,0 +1,156 @@
+/* 
+ * MappedPSDScreeningDBWriter.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of class CDPL::Pharm::MappedPSDScreeningDBWriter.
+ */
+
+#ifndef CDPL_PHARM_MAPPEDPSDSCREENINGDBWRITER_HPP
+#define CDPL_PHARM_MAPPEDPSDSCREENINGDBWRITER_HPP
+
+#include <string>
+#include <memory>
+#include <cstddef>
+
+#include "CDPL/Pharm/APIPrefix.hpp"
+#include "CDPL/Pharm/ScreeningDBCreator.hpp"
+
+
+namespace CDPL
+{
+
+    namespace Pharm
+    {
+
+        class ScreeningDBAccessor;
+        class MappedPSDScreeningDBWriterImpl;
+
+        /**
+         * \brief Creates memory-mapped PSD database files that can be read by means of Pharm::MappedPSDScreeningDBAccessor.
+         *
+         * The molecules and conformer pharmacophores of the source databases passed to append() are streamed to
+         * temporary files in the directory of the target file. Only the offset and feature count tables are kept
+         * in memory until close() gets called, which completes the file and renames it to the target path.
+         * Concurrent processes will thus never see incomplete files. Files that have not been closed successfully
+         * get removed on destruction.
+         *
+         * \since 1.4
+         */
+        class CDPL_PHARM_API MappedPSDScreeningDBWriter
+        {
+
+          public:
+            /**
+             * \brief A reference-counted smart pointer [\ref SHPTR] for dynamically allocated \c %MappedPSDScreeningDBWriter instances.
+             */
+            typedef std::shared_ptr<MappedPSDScreeningDBWriter> SharedPointer;
+
+            /**
+             * \brief The type of the progress callback function (see Pharm::ScreeningDBCreator::ProgressCallbackFunction).
+             */
+            typedef ScreeningDBCreator::ProgressCallbackFunction ProgressCallbackFunction;
+
+            /**
+             * \brief Constructs a \c %MappedPSDScreeningDBWriter instance that is not associated with a file.
+             */
+            MappedPSDScreeningDBWriter();
+
+            /**
+             * \brief Constructs a \c %MappedPSDScreeningDBWriter instance that starts writing the database-file specified by \a name.
+             * \param name The name of the database-file.
+             * \throw Base::IOError if the temporary output files cannot be created.
+             */
+            MappedPSDScreeningDBWriter(const std::string& name);
+
+            MappedPSDScreeningDBWriter(const MappedPSDScreeningDBWriter&) = delete;
+
+            /**
+             * \brief Destructor.
+             *
+             * Removes the data written so far if the database-file has not been closed.
+             */
+            ~MappedPSDScreeningDBWriter();
+
+            MappedPSDScreeningDBWriter& operator=(const MappedPSDScreeningDBWriter&) = delete;
+
+            /**
+             * \brief Starts writing the database-file specified by \a name.
+             * \param name The name of the database-file.
+             * \throw Base::IOError if the temporary output files cannot be created.
+             */
+            void open(const std::string& name);
+
+            /**
+             * \brief Appends all molecule and pharmacophore records of \a db_acc to the database.
+             * \param db_acc The source database accessor.
+             * \param func A progress-reporting callback invoked during the operation.
+             * \return \c true if all records have been appended, and \c false if the operation was aborted by the callback.
+             * \throw Base::IOError if no database-file is being written or an I/O error occurred.
+             */
+            bool append(const ScreeningDBAccessor& db_acc, const ProgressCallbackFunction& func = ProgressCallbackFunction());
+
+            /**
+             * \brief Completes the database-file and renames it to the name specified on opening.
+             * \throw Base::IOError if no database-file is being written or an I/O error occurred.
+             */
+            void close();
+
+            /**
+             * \brief Stops writing and removes the data written so far.
+             */
+            void discard();
+
+            /**
+             * \brief Tells whether a database-file is currently being written.
+             * \return \c true if a file is being written, and \c false otherwise.
+             */
+            bool isOpen() const;
+
+            /**
+             * \brief Returns the name of the currently written database-file.
+             * \return A \c const reference to the database-file name (or an empty string if no file is being written).
+             */
+            const std::string& getDatabaseName() const;
+
+            /**
+             * \brief Returns the number of molecules appended since the last call to open().
+             * \return The number of appended molecules.
+             */
+            std::size_t getNumMolecules() const;
+
+            /**
+             * \brief Returns the number of pharmacophores appended since the last call to open().
+             * \return The number of appended pharmacophores.
+             */
+            std::size_t getNumPharmacophores() const;
+
+          private:
+            typedef std::unique_ptr<MappedPSDScreeningDBWriterImpl> ImplementationPointer;
+
+            ImplementationPointer impl;
+        };
+    } // namespace Pharm
+} // namespace CDPL
+
+#endif // CDPL_PHARM_MAPPEDPSDSCREENINGDBWRITER_HPP
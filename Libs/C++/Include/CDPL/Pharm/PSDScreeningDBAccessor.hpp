@@ -167,6 +167,36 @@ namespace CDPL
              */
             const FeatureTypeHistogram& getFeatureCounts(std::size_t mol_idx, std::size_t mol_conf_idx) const;
 
+            /**
+             * \brief Tells whether the database-file contains an index of the binned feature pair distances of the stored pharmacophores.
+             * \return \c true if the index is present, and \c false otherwise.
+             * \see Pharm::PSDScreeningDBCreator::createTwoPointPharmacophoreIndex()
+             * \since 1.4
+             */
+            bool hasTwoPointPharmacophoreIndex() const;
+
+            /**
+             * \brief Marks the pharmacophores that might contain a pair of features of type \a ftr1_type and \a ftr2_type
+             *        whose distance lies within the range [\a min_dist, \a max_dist].
+             * \param ftr1_type The type of the first feature.
+             * \param ftr2_type The type of the second feature.
+             * \param min_dist The minimum feature distance.
+             * \param max_dist The maximum feature distance.
+             * \param pharm_set The output bit set.
+             * \note If the database-file does not contain an index of the feature pair distances, all pharmacophores get marked.
+             * \since 1.4
+             */
+            void getTwoPointPharmacophoreMatches(unsigned int ftr1_type, unsigned int ftr2_type, double min_dist, double max_dist,
+                                                 Util::BitSet& pharm_set) const;
+
+            /**
+             * \brief Creates a new \c %PSDScreeningDBAccessor instance that has the currently open database-file opened
+             *        via a separate connection.
+             * \return A smart pointer to the created accessor.
+             * \since 1.4
+             */
+            ScreeningDBAccessor::SharedPointer clone() const;
+
           private:
             typedef std::unique_ptr<PSDScreeningDBAccessorImpl> ImplementationPointer;
 
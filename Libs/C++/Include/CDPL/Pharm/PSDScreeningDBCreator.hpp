@@ -106,6 +106,50 @@ namespace CDPL
              */
             bool allowDuplicateEntries() const;
 
+            /**
+             * \brief Specifies whether the created database shall contain an index of the binned feature pair distances of
+             *        the stored pharmacophores.
+             *
+             * The index allows Pharm::ScreeningProcessor to skip database pharmacophores that cannot match a given query
+             * without loading them. The setting takes effect when the next database gets opened. An index that is already
+             * present in an opened database is always kept up to date, regardless of this setting.
+             *
+             * \param create \c true if the index shall be created, and \c false otherwise.
+             * \note The default setting is \c false.
+             * \since 1.4
+             */
+            void createTwoPointPharmacophoreIndex(bool create);
+
+            /**
+             * \brief Tells whether the created database will contain an index of the binned feature pair distances of
+             *        the stored pharmacophores.
+             * \return \c true if the index gets created, and \c false otherwise.
+             * \since 1.4
+             */
+            bool twoPointPharmacophoreIndexCreated() const;
+
+            /**
+             * \brief Specifies whether process() may be called concurrently by multiple threads.
+             *
+             * If enabled, the pharmacophores and the serialized database records of the molecules passed to process() are
+             * generated by the calling threads while a dedicated writer thread inserts the finished records into the
+             * database in batched transactions. Since the insertions are performed asynchronously, the deleted and inserted
+             * molecule counts only include the records written so far (see flush()). The setting takes effect when the next
+             * database gets opened. Note that merge() and all other methods must not be called concurrently with process().
+             *
+             * \param enable \c true if concurrent calls to process() shall be supported, and \c false otherwise.
+             * \note The default setting is \c false.
+             * \since 1.4
+             */
+            void enableMultiThreading(bool enable);
+
+            /**
+             * \brief Tells whether process() may be called concurrently by multiple threads.
+             * \return \c true if concurrent calls to process() are supported, and \c false otherwise.
+             * \since 1.4
+             */
+            bool multiThreadingEnabled() const;
+
             /**
              * \brief Processes \a molgraph and inserts the resulting molecule (with derived conformer pharmacophores) into the database.
              * \param molgraph The molecular graph to process.
@@ -113,6 +157,16 @@ namespace CDPL
              */
             bool process(const Chem::MolecularGraph& molgraph);
 
+            /**
+             * \brief Waits until all molecules accepted by process() have been inserted into the database.
+             *
+             * Has only an effect if multithreading was enabled when the database was opened (see enableMultiThreading()).
+             *
+             * \throw Base::IOError if inserting a record failed.
+             * \since 1.4
+             */
+            void flush();
+
             /**
              * \brief Merges all molecule/pharmacophore records of \a db_acc into the currently open database.
              * \param db_acc The source database accessor.
@@ -37,6 +37,7 @@
 #include "CDPL/Chem/MolecularGraph.hpp"
 #include "CDPL/Chem/AtomBondMapping.hpp"
 #include "CDPL/Chem/SubstructureSearch.hpp"
+#include "CDPL/Chem/SubstructureScreeningKeyGenerator.hpp"
 #include "CDPL/Util/BitSet.hpp"
 #include "CDPL/Util/ObjectStack.hpp"
 #include "CDPL/Math/Vector.hpp"
@@ -54,6 +55,10 @@ namespace CDPL
         /**
          * \brief Pharm::FeatureGenerator implementation that perceives pharmacophore features by
          *        substructure pattern matching, with separate include and exclude pattern lists.
+         *
+         * The substructure screening keys (see Chem::SubstructureScreeningKeyGenerator) of the processed molecular graph
+         * are calculated once per generate() call and used to skip all patterns whose keys prove that they cannot match.
+         * The substructure search data of a pattern get re-initialized if its query molecular graph has been modified.
          */
         class CDPL_PHARM_API PatternBasedFeatureGenerator : public FeatureGenerator
         {
@@ -171,32 +176,31 @@ namespace CDPL
             bool isContainedInExMatchList(const Util::BitSet&) const;
 
           private:
+            class PatternSearch;
+
+            typedef std::shared_ptr<PatternSearch> PatternSearchPtr;
+
             struct IncludePattern
             {
 
                 IncludePattern(const Chem::MolecularGraph::SharedPointer& molgraph, unsigned int type,
-                               double tol, unsigned int geom, double length):
-                    molGraph(molgraph), subSearch(new Chem::SubstructureSearch(*molgraph)), featureType(type),
-                    featureTol(tol), featureGeom(geom), vectorLength(length)
-                {}
-
-                Chem::MolecularGraph::SharedPointer     molGraph;
-                Chem::SubstructureSearch::SharedPointer subSearch;
-                unsigned int                            featureType;
-                double                                  featureTol;
-                unsigned int                            featureGeom;
-                double                                  vectorLength;
+                               double tol, unsigned int geom, double length);
+
+                Chem::MolecularGraph::SharedPointer molGraph;
+                PatternSearchPtr                    search;
+                unsigned int                        featureType;
+                double                              featureTol;
+                unsigned int                        featureGeom;
+                double                              vectorLength;
             };
 
             struct ExcludePattern
             {
 
-                ExcludePattern(const Chem::MolecularGraph::SharedPointer& molgraph):
-                    molGraph(molgraph), subSearch(new Chem::SubstructureSearch(*molgraph))
-                {}
+                ExcludePattern(const Chem::MolecularGraph::SharedPointer& molgraph);
 
-                Chem::MolecularGraph::SharedPointer     molGraph;
-                Chem::SubstructureSearch::SharedPointer subSearch;
+                Chem::MolecularGraph::SharedPointer molGraph;
+                PatternSearchPtr                    search;
             };
 
             typedef std::vector<IncludePattern>     IncludePatternList;
@@ -213,18 +217,20 @@ namespace CDPL
             bool createMatchedAtomMask(const Chem::AtomMapping&, Util::BitSet&, bool, bool = true) const;
             bool isContainedInList(const Util::BitSet&, const BitSetList&) const;
 
-            const Chem::MolecularGraph* molGraph;
-            IncludePatternList          includePatterns;
-            ExcludePatternList          excludePatterns;
-            BitSetList                  includeMatches;
-            BitSetList                  excludeMatches;
-            AtomList                    posRefAtomList;
-            AtomList                    geomRefAtom1List;
-            AtomList                    geomRefAtom2List;
-            Math::Matrix<double>        svdU;
-            Math::Matrix3D              svdV;
-            Math::Vector3D              svdW;
-            BitSetCache                 bitSetCache;
+            const Chem::MolecularGraph*             molGraph;
+            IncludePatternList                      includePatterns;
+            ExcludePatternList                      excludePatterns;
+            Chem::SubstructureScreeningKeyGenerator keyGenerator;
+            Util::BitSet                            molGraphKeys;
+            BitSetList                              includeMatches;
+            BitSetList                              excludeMatches;
+            AtomList                                posRefAtomList;
+            AtomList                                geomRefAtom1List;
+            AtomList                                geomRefAtom2List;
+            Math::Matrix<double>                    svdU;
+            Math::Matrix3D                          svdV;
+            Math::Vector3D                          svdW;
+            BitSetCache                             bitSetCache;
         };
     } // namespace Pharm
 } // namespace CDPL
@@ -34,6 +34,7 @@
 #include <memory>
 
 #include "CDPL/Pharm/APIPrefix.hpp"
+#include "CDPL/Util/BitSet.hpp"
 
 
 namespace CDPL
@@ -158,6 +159,53 @@ namespace CDPL
              */
             virtual const FeatureTypeHistogram& getFeatureCounts(std::size_t mol_idx, std::size_t mol_conf_idx) const = 0;
 
+            /**
+             * \brief Tells whether the database provides an index of the (binned) feature pair distances of the stored pharmacophores.
+             * \return \c true if getTwoPointPharmacophoreMatches() narrows down the set of candidate pharmacophores, and \c false otherwise.
+             * \note The default implementation returns \c false.
+             * \since 1.4
+             */
+            virtual bool hasTwoPointPharmacophoreIndex() const
+            {
+                return false;
+            }
+
+            /**
+             * \brief Marks the pharmacophores that might contain a pair of features of type \a ftr1_type and \a ftr2_type
+             *        whose distance lies within the range [\a min_dist, \a max_dist].
+             *
+             * The bit set \a pharm_set gets resized to the number of stored pharmacophores and the bits at the indices of
+             * the marked pharmacophores are set. The marked pharmacophores are a superset of the actually matching ones,
+             * i.e. pharmacophores that do not get marked are guaranteed to contain no such feature pair.
+             *
+             * \param ftr1_type The type of the first feature.
+             * \param ftr2_type The type of the second feature.
+             * \param min_dist The minimum feature distance.
+             * \param max_dist The maximum feature distance.
+             * \param pharm_set The output bit set.
+             * \note The default implementation marks all pharmacophores.
+             * \since 1.4
+             */
+            virtual void getTwoPointPharmacophoreMatches(unsigned int ftr1_type, unsigned int ftr2_type, double min_dist, double max_dist,
+                                                         Util::BitSet& pharm_set) const
+            {
+                pharm_set.resize(getNumPharmacophores());
+                pharm_set.set();
+            }
+
+            /**
+             * \brief Creates a new accessor of the same type that provides independent access to the currently open database.
+             * \return A smart pointer to the created accessor, or an empty pointer if cloning is not supported.
+             * \note Accessors are not required to be thread-safe. Multithreaded searches of Pharm::ScreeningProcessor
+             *       therefore use a separate clone for each worker thread and fall back to a single-threaded search
+             *       if no clone can be created. The default implementation returns an empty pointer.
+             * \since 1.4
+             */
+            virtual SharedPointer clone() const
+            {
+                return SharedPointer();
+            }
+
           protected:
             ScreeningDBAccessor& operator=(const ScreeningDBAccessor&)
             {
@@ -107,12 +107,42 @@ namespace CDPL
                           const Math::Matrix4D& xform, std::size_t pharm_idx,
                           std::size_t mol_idx, std::size_t conf_idx);
 
+                /**
+                 * \brief Constructs the \c %SearchHit instance with the given references.
+                 * \param hit_prov The screening processor that produced the hit.
+                 * \param db_acc The database accessor the hit data were retrieved from.
+                 * \param qry_pharm The query pharmacophore.
+                 * \param hit_pharm The hit pharmacophore.
+                 * \param mol The hit molecule.
+                 * \param xform The alignment transformation that maps the hit onto the query.
+                 * \param pharm_idx The zero-based pharmacophore index within the source database.
+                 * \param mol_idx The zero-based molecule index within the source database.
+                 * \param conf_idx The zero-based conformer index within the source molecule.
+                 */
+                SearchHit(const ScreeningProcessor& hit_prov, const ScreeningDBAccessor& db_acc,
+                          const FeatureContainer& qry_pharm, const FeatureContainer& hit_pharm,
+                          const Chem::Molecule& mol, const Math::Matrix4D& xform, std::size_t pharm_idx,
+                          std::size_t mol_idx, std::size_t conf_idx);
+
                 /**
                  * \brief Returns the screening processor that produced the hit.
                  * \return A \c const reference to the hit-providing screening processor.
+                 * \note In multithreaded searches, the database accessor of the screening processor is not the one
+                 *       the hit data were retrieved from and must not be used for accessing database records from
+                 *       within hit callbacks. Use getDBAccessor() instead.
                  */
                 const ScreeningProcessor& getHitProvider() const;
 
+                /**
+                 * \brief Returns the database accessor the hit data were retrieved from.
+                 *
+                 * In multithreaded searches, this is the database accessor of the search thread that found the hit
+                 * which may safely be used from within hit callbacks invoked for this hit.
+                 *
+                 * \return A \c const reference to the database accessor.
+                 */
+                const ScreeningDBAccessor& getDBAccessor() const;
+
                 /**
                  * \brief Returns the query pharmacophore.
                  * \return A \c const reference to the query pharmacophore.
@@ -156,14 +186,15 @@ namespace CDPL
                 std::size_t getHitConformationIndex() const;
 
               private:
-                const ScreeningProcessor* provider;
-                const FeatureContainer*   qryPharm;
-                const FeatureContainer*   hitPharm;
-                const Chem::Molecule*     molecule;
-                const Math::Matrix4D*     almntTransform;
-                std::size_t               pharmIndex;
-                std::size_t               molIndex;
-                std::size_t               confIndex;
+                const ScreeningProcessor*  provider;
+                const ScreeningDBAccessor* dbAccessor;
+                const FeatureContainer*    qryPharm;
+                const FeatureContainer*    hitPharm;
+                const Chem::Molecule*      molecule;
+                const Math::Matrix4D*      almntTransform;
+                std::size_t                pharmIndex;
+                std::size_t                molIndex;
+                std::size_t                confIndex;
             };
 
 
@@ -299,12 +330,34 @@ namespace CDPL
              */
             const ScoringFunction& getScoringFunction() const;
 
+            /**
+             * \brief Specifies the number of threads used by searchDB().
+             *
+             * If \a num_threads is greater than \e 1, the molecules of the searched range get distributed dynamically
+             * among the threads. Each thread screens on its own clone of the database accessor (see ScreeningDBAccessor::clone())
+             * and its own copy of the scoring function. If the accessor does not support cloning, the search is carried out
+             * by the calling thread only. Invocations of the hit and progress callbacks are serialized but
+             * may originate from any of the threads and hits are not reported in the order of their database indices.
+             *
+             * \param num_threads The number of threads (\e 0 or \e 1 disables multithreading).
+             * \since 1.4
+             */
+            void setNumThreads(std::size_t num_threads);
+
+            /**
+             * \brief Returns the number of threads used by searchDB().
+             * \return The number of threads.
+             * \since 1.4
+             */
+            std::size_t getNumThreads() const;
+
             /**
              * \brief Screens the database with the supplied query pharmacophore.
              * \param query The query feature container.
              * \param mol_start_idx The zero-based index of the first molecule to screen.
              * \param mol_end_idx The exclusive upper bound of the molecule range. If \e 0, the search runs through the end of the database.
              * \return The number of accepted hits produced by the search.
+             * \see setNumThreads()
              */
             std::size_t searchDB(const FeatureContainer& query, std::size_t mol_start_idx = 0, std::size_t mol_end_idx = 0);
 
@@ -47,6 +47,8 @@
 #include "CDPL/Shape/FastGaussianShapeAlignment.hpp"
 #include "CDPL/Shape/ScreeningSettings.hpp"
 #include "CDPL/Shape/ScreeningProcessor.hpp"
+#include "CDPL/Shape/GaussianShapeDatabase.hpp"
+#include "CDPL/Shape/GaussianShapeDatabaseWriter.hpp"
 #include "CDPL/Shape/SymmetryClass.hpp"
 #include "CDPL/Shape/AlignmentResultSelectionMode.hpp"
 #include "CDPL/Shape/GaussianShapeFunctions.hpp"
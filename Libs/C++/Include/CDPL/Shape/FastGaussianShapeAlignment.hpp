@@ -47,7 +47,6 @@
 #include "CDPL/Math/Matrix.hpp"
 #include "CDPL/Math/VectorArray.hpp"
 #include "CDPL/Math/QuaternionExpression.hpp"
-#include "CDPL/Math/BFGSMinimizer.hpp"
 
 
 namespace CDPL
@@ -249,6 +248,47 @@ namespace CDPL
              */
             double getOptimizationStopGradient() const;
 
+            /**
+             * \brief Specifies whether reference/aligned shape pairs that provably cannot yield a relevant result shall be skipped.
+             *
+             * Before a shape pair gets aligned, an upper bound of the achievable score is calculated by passing the maximum
+             * possible overlaps to the scoring function. Since the overlap of two Gaussian shapes can never exceed the geometric
+             * mean of their self-overlaps, the shape overlap is bounded by the self-overlaps of the non-color elements and the
+             * color overlap by the self-overlaps of the color elements of the feature types present in both shapes.
+             * The pair is skipped if the bound is lower than the pruning score cutoff, or if, for the current result selection
+             * mode, the bound cannot overtake the best result found so far. Pruning is only safe if the scoring function does not
+             * decrease with increasing overlap and the result-compare function ranks results by score (which holds for all
+             * functions provided by %CDPL). Since the calculated overlaps are approximations (fast exponential function, skipped
+             * distant element pairs), the overlap bounds get enlarged by a tolerance of 1% which is an empirical value and not a
+             * guaranteed upper limit of the approximation error. Pruning is disabled by default.
+             *
+             * \param prune \c true to enable pruning, and \c false to align all shape pairs.
+             * \since 1.4
+             */
+            void pruneAlignments(bool prune);
+
+            /**
+             * \brief Tells whether shape pairs that provably cannot yield a relevant result are skipped.
+             * \return \c true if pruning is enabled, and \c false otherwise.
+             * \since 1.4
+             */
+            bool pruneAlignments() const;
+
+            /**
+             * \brief Sets the score below which alignment results are of no interest and the corresponding shape pairs may be pruned.
+             * \param cutoff The new pruning score cutoff (NaN to disable cutoff based pruning).
+             * \note Results scoring below the cutoff are not removed if the shape pair was aligned.
+             * \since 1.4
+             */
+            void setPruningScoreCutoff(double cutoff);
+
+            /**
+             * \brief Returns the currently configured pruning score cutoff.
+             * \return The pruning score cutoff (NaN if cutoff based pruning is disabled).
+             * \since 1.4
+             */
+            double getPruningScoreCutoff() const;
+
             /**
              * \brief Removes all reference shapes and reference shape sets.
              */
@@ -414,6 +454,22 @@ namespace CDPL
              */
             bool align(const GaussianShapeSet& shapes);
 
+            /**
+             * \brief Returns the number of reference/aligned shape pairs that were aligned by the last call to align().
+             * \return The number of performed shape pair alignments.
+             * \since 1.4
+             */
+            std::size_t getNumPerformedAlignments() const;
+
+            /**
+             * \brief Returns the number of reference/aligned shape pairs that were skipped by the last call to align()
+             *        because they could not yield a relevant result.
+             * \return The number of pruned shape pair alignments.
+             * \see pruneAlignments(bool)
+             * \since 1.4
+             */
+            std::size_t getNumPrunedAlignments() const;
+
             /**
              * \brief Returns the number of stored alignment results.
              * \return The number of alignment results.
@@ -485,6 +541,8 @@ namespace CDPL
             ResultIterator end();
 
           private:
+            struct OptimizationState;
+
             struct ShapeData
             {
 
@@ -499,17 +557,21 @@ namespace CDPL
                     double         volume;
                 };
 
-                typedef std::vector<Element> ElementArray;
-
-                ElementArray   elements;
-                std::size_t    colElemOffs;
-                std::size_t    setIndex;
-                std::size_t    index;
-                unsigned int   symClass;
-                Math::Matrix4D transform;
-                double         selfOverlap;
-                double         colSelfOverlap;
-                bool           equalNonColDelta;
+                typedef std::vector<Element>                         ElementArray;
+                typedef std::vector<double>                          PackedElementData;
+                typedef std::vector<std::pair<std::size_t, double> > ColorSelfOverlapArray;
+
+                ElementArray          elements;
+                PackedElementData     packedElemData;
+                PackedElementData     packedColElemData;
+                std::size_t           colElemOffs;
+                std::size_t           setIndex;
+                std::size_t           index;
+                unsigned int          symClass;
+                Math::Matrix4D        transform;
+                double                selfOverlap;
+                double                colSelfOverlap;
+                ColorSelfOverlapArray colSelfOverlaps;
             };
 
             typedef std::pair<std::size_t, std::size_t> ResultID;
@@ -517,8 +579,11 @@ namespace CDPL
             void alignAndProcessResults(std::size_t ref_idx, std::size_t al_idx);
             void processResult(AlignmentResult& res, std::size_t ref_idx, std::size_t al_idx);
 
+            bool canPruneAlignment(std::size_t ref_idx);
+
             void setupShapeData(const GaussianShape& shape, ShapeData& data, bool ref);
             void setupShapeDataElement(const GaussianShape::Element& gs_elem, ShapeData::Element& sd_elem) const;
+            void setupPackedElementData(ShapeData& data) const;
 
             void prepareForAlignment();
 
@@ -532,11 +597,18 @@ namespace CDPL
 
             void transformAlignedShape();
 
-            double calcAlignmentFunctionValue(const QuaternionTransformation& xform_quat);
-            double calcAlignmentFunctionGradient(const QuaternionTransformation& xform_quat, QuaternionTransformation& xform_grad);
+            void optimizeStartTransforms(const ShapeData& ref_data, std::size_t num_opts);
+
+            void calcAlignmentFunctionValues(const ShapeData& ref_data);
+            void calcAlignmentFunctionGradients(const ShapeData& ref_data);
+
+            void calcStartTransformOverlaps(const ShapeData& ref_data, std::size_t start_idx, std::size_t num_starts);
+            void calcOptimizationPoseCoordinates(bool grad_eval);
 
             double calcOverlap(const ShapeData& ref_data, const ShapeData& ovl_data, bool color) const;
-            double calcOverlapGradient(const ShapeData& ref_data, Math::Vector3DArray& grad) const;
+
+            double calcColorSelfOverlaps(ShapeData& data) const;
+            double calcColorOverlapBound(const ShapeData& ref_data, const ShapeData& ovl_data) const;
 
             bool getResultIndex(const ResultID& res_id, std::size_t& res_idx);
 
@@ -544,13 +616,20 @@ namespace CDPL
             typedef std::unordered_map<ResultID, std::size_t, boost::hash<ResultID> > ResultIndexMap;
             typedef std::vector<QuaternionTransformation>                             StartTransformList;
             typedef boost::random::mt11213b                                           RandomEngine;
-            typedef Math::BFGSMinimizer<QuaternionTransformation>                     BFGSMinimizer;
+            typedef std::vector<double>                                               DoubleArray;
+            typedef std::vector<std::size_t>                                          IndexArray;
+            typedef std::vector<Math::Matrix4D>                                       MatrixArray;
+            typedef std::vector<OptimizationState>                                    OptimizationStateArray;
 
             bool                     perfAlignment;
             bool                     optOverlap;
             bool                     greedyOpt;
             std::size_t              maxNumOptIters;
             double                   optStopGrad;
+            bool                     pruneAligns;
+            double                   pruningScoreCutoff;
+            std::size_t              numPerfAligns;
+            std::size_t              numPrunedAligns;
             unsigned int             resultSelMode;
             ResultCompareFunction    resultCmpFunc;
             ScoringFunction          scoringFunc;
@@ -574,11 +653,16 @@ namespace CDPL
             RandomEngine             randomEngine;
             StartTransformList       startTransforms;
             Math::Vector3DArray      startPoseCoords;
-            Math::Vector3DArray      optPoseCoordsGrad;
-            BFGSMinimizer            minimizer;
+            DoubleArray              batchPoseCoords;
+            DoubleArray              batchPoseGrads;
+            DoubleArray              batchOverlaps;
+            OptimizationStateArray   optStates;
+            IndexArray               activeOpts;
+            IndexArray               valueEvalOpts;
+            IndexArray               gradEvalOpts;
+            MatrixArray              optXformMatrices;
             Math::Matrix4D           xformMatrix;
             QuaternionTransformation normXformQuat;
-            std::size_t              currRefShapeIdx;
         };
     } // namespace Shape
 } // namespace CDPL
@@ -53,6 +53,11 @@ namespace CDPL
          *     scaled van-der-Waals proximity test (see setRadiusScalingFactor()).
          *   - **Fast exponential function** replaces the expensive \c std::exp call with a fast
          *     approximation that is accurate enough for screening-style overlap evaluation.
+         *
+         * If both shape functions have a maximum product order of \e 1 and no custom color match or filter
+         * functions have been specified, overlaps and gradients are calculated by kernels that operate on
+         * packed element data and, if the fast exponential function is enabled, use AVX-512 or AVX2 instructions
+         * when supported by the executing CPU.
          */
         class CDPL_SHAPE_API FastGaussianShapeOverlapFunction : public GaussianShapeOverlapFunction
         {
@@ -224,6 +229,16 @@ namespace CDPL
           private:
             bool checkShapeFuncsNotNull() const;
 
+            bool usePackedElementData(const GaussianProductList* ref_prod_list, const GaussianProductList* ovl_prod_list,
+                                      bool color) const;
+
+            double calcFirstOrderOverlap(const GaussianProductList* ref_prod_list, const GaussianProductList* ovl_prod_list,
+                                         bool color) const;
+            double calcFirstOrderOverlap(const GaussianProductList* ref_prod_list, const GaussianProductList* ovl_prod_list,
+                                         const Math::Vector3DArray& coords, bool color) const;
+            double calcFirstOrderOverlapGradient(const GaussianProductList* ref_prod_list, const GaussianProductList* ovl_prod_list,
+                                                 const Math::Vector3DArray& coords, Math::Vector3DArray& grad) const;
+
             double calcOverlap(const GaussianProductList* ref_prod_list, const GaussianProductList* ovl_prod_list,
                                bool color) const;
             double calcOverlapExact(const GaussianProductList* ref_prod_list, const GaussianProductList* ovl_prod_list,
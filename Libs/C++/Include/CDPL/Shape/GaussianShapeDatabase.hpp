@@ -0,0 +1,193 @@
+/* 
+ * GaussianShapeDatabase.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of class CDPL::Shape::GaussianShapeDatabase.
+ */
+
+#ifndef CDPL_SHAPE_GAUSSIANSHAPEDATABASE_HPP
+#define CDPL_SHAPE_GAUSSIANSHAPEDATABASE_HPP
+
+#include <string>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+#include "CDPL/Shape/APIPrefix.hpp"
+#include "CDPL/Shape/ScreeningSettings.hpp"
+
+
+namespace boost
+{
+
+    namespace iostreams
+    {
+
+        class mapped_file_source;
+    }
+} // namespace boost
+
+
+namespace CDPL
+{
+
+    namespace Shape
+    {
+
+        class GaussianShape;
+        class GaussianShapeSet;
+
+        /**
+         * \brief Provides read access to memory-mapped files storing precomputed Gaussian shapes of the molecules in
+         *        an input file.
+         *
+         * A shape database file stores for each processed molecule record the index of the record in the
+         * input file, the molecule name and the Gaussian shapes (element centers, radii, hardness values and colors)
+         * of all of its conformers as generated by Shape::ScreeningProcessor. In addition, the file stores the shape
+         * generation settings (color feature type and all-carbon mode) and a stamp of the input file state (see
+         * Util::calcFileStamp()). Database files are only considered valid if the stamp matches the one specified
+         * on opening. Files are created by means of Shape::GaussianShapeDatabaseWriter.
+         *
+         * \since 1.4
+         */
+        class CDPL_SHAPE_API GaussianShapeDatabase
+        {
+
+          public:
+            /**
+             * \brief Constructs a \c %GaussianShapeDatabase instance that is not associated with a file.
+             */
+            GaussianShapeDatabase();
+
+            GaussianShapeDatabase(const GaussianShapeDatabase& db) = delete;
+
+            /**
+             * \brief Destructor.
+             */
+            ~GaussianShapeDatabase();
+
+            GaussianShapeDatabase& operator=(const GaussianShapeDatabase& db) = delete;
+
+            /**
+             * \brief Memory-maps the database file \a path and checks whether it matches the specified data source state.
+             * \param path The path of the database file.
+             * \param src_stamp The stamp of the data source the database file has to belong to.
+             * \return \c true if the file could be opened and is valid, and \c false otherwise.
+             */
+            bool open(const std::string& path, std::uint64_t src_stamp);
+
+            /**
+             * \brief Unmaps the currently opened database file.
+             */
+            void close();
+
+            /**
+             * \brief Tells whether a valid database file is currently opened.
+             * \return \c true if a file is opened, and \c false otherwise.
+             */
+            bool isOpen() const;
+
+            /**
+             * \brief Returns the color feature type the stored shapes were generated with.
+             * \return The color feature type.
+             */
+            ScreeningSettings::ColorFeatureType getColorFeatureType() const;
+
+            /**
+             * \brief Tells whether the stored shapes were generated in all-carbon mode.
+             * \return \c true if all atoms were treated as carbons, and \c false otherwise.
+             */
+            bool allCarbonMode() const;
+
+            /**
+             * \brief Returns the number of molecule records stored in the opened file.
+             * \return The number of molecule records.
+             */
+            std::size_t getNumRecords() const;
+
+            /**
+             * \brief Returns the total number of shapes stored in the opened file.
+             * \return The total number of shapes.
+             */
+            std::size_t getNumShapes() const;
+
+            /**
+             * \brief Returns the index of the input file record the molecule record \a idx was generated from.
+             * \param idx The zero-based index of the molecule record.
+             * \return The zero-based input file record index.
+             * \throw Base::IndexError if \a idx is not in the range [0, getNumRecords()).
+             */
+            std::size_t getRecordIndex(std::size_t idx) const;
+
+            /**
+             * \brief Returns the name of the molecule stored in record \a idx.
+             * \param idx The zero-based index of the molecule record.
+             * \return The molecule name.
+             * \throw Base::IndexError if \a idx is not in the range [0, getNumRecords()).
+             */
+            std::string getName(std::size_t idx) const;
+
+            /**
+             * \brief Returns the number of shapes (conformers) stored for the molecule record \a idx.
+             * \param idx The zero-based index of the molecule record.
+             * \return The number of shapes of the molecule.
+             * \throw Base::IndexError if \a idx is not in the range [0, getNumRecords()).
+             */
+            std::size_t getNumShapes(std::size_t idx) const;
+
+            /**
+             * \brief Retrieves the shape with index \a shape_idx of the molecule record \a idx.
+             * \param idx The zero-based index of the molecule record.
+             * \param shape_idx The zero-based index of the shape.
+             * \param shape The shape object storing the retrieved elements.
+             * \throw Base::IndexError if \a idx or \a shape_idx is out of bounds.
+             */
+            void getShape(std::size_t idx, std::size_t shape_idx, GaussianShape& shape) const;
+
+            /**
+             * \brief Retrieves all shapes of the molecule record \a idx.
+             * \param idx The zero-based index of the molecule record.
+             * \param shapes The shape set storing the retrieved shapes.
+             * \throw Base::IndexError if \a idx is not in the range [0, getNumRecords()).
+             */
+            void getShapes(std::size_t idx, GaussianShapeSet& shapes) const;
+
+          private:
+            typedef boost::iostreams::mapped_file_source MappedFile;
+            typedef std::unique_ptr<MappedFile>          MappedFilePtr;
+
+            MappedFilePtr                       mappedFile;
+            const char*                         elementData;
+            const std::uint64_t*                shapeOffsets;
+            const std::uint64_t*                recordTable;
+            const char*                         nameData;
+            std::size_t                         numRecords;
+            std::size_t                         numShapes;
+            ScreeningSettings::ColorFeatureType colorFtrType;
+            bool                                allCarbon;
+        };
+    } // namespace Shape
+} // namespace CDPL
+
+#endif // CDPL_SHAPE_GAUSSIANSHAPEDATABASE_HPP
@@ -0,0 +1,149 @@
+/* 
+ * GaussianShapeDatabaseWriter.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of class CDPL::Shape::GaussianShapeDatabaseWriter.
+ */
+
+#ifndef CDPL_SHAPE_GAUSSIANSHAPEDATABASEWRITER_HPP
+#define CDPL_SHAPE_GAUSSIANSHAPEDATABASEWRITER_HPP
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <fstream>
+#include <cstddef>
+#include <cstdint>
+
+#include "CDPL/Shape/APIPrefix.hpp"
+#include "CDPL/Shape/ScreeningSettings.hpp"
+
+
+namespace CDPL
+{
+
+    namespace Util
+    {
+
+        class FileRemover;
+    }
+
+    namespace Shape
+    {
+
+        class GaussianShapeSet;
+
+        /**
+         * \brief Creates shape database files that can be accessed by means of Shape::GaussianShapeDatabase.
+         *
+         * The shape data of added molecule records are streamed to a temporary file in the directory of the
+         * target file. Only the comparatively small record and shape tables are kept in memory until close()
+         * gets called, which completes the file and renames it to the target path. Concurrent processes will
+         * thus never see incomplete files. Files that have not been closed successfully get removed on
+         * destruction.
+         *
+         * \since 1.4
+         */
+        class CDPL_SHAPE_API GaussianShapeDatabaseWriter
+        {
+
+          public:
+            /**
+             * \brief Constructs a \c %GaussianShapeDatabaseWriter instance that is not associated with a file.
+             */
+            GaussianShapeDatabaseWriter();
+
+            GaussianShapeDatabaseWriter(const GaussianShapeDatabaseWriter& writer) = delete;
+
+            /**
+             * \brief Destructor.
+             *
+             * Removes the data written so far if the database file has not been closed.
+             */
+            ~GaussianShapeDatabaseWriter();
+
+            GaussianShapeDatabaseWriter& operator=(const GaussianShapeDatabaseWriter& writer) = delete;
+
+            /**
+             * \brief Starts writing a new database file.
+             * \param path The path of the database file.
+             * \param src_stamp The stamp of the data source the shapes get generated from.
+             * \param color_ftr_type The color feature type the shapes get generated with.
+             * \param all_carbon Specifies whether the shapes get generated in all-carbon mode.
+             * \return \c true if the temporary output file could be created, and \c false otherwise.
+             */
+            bool open(const std::string& path, std::uint64_t src_stamp, ScreeningSettings::ColorFeatureType color_ftr_type, 
+                      bool all_carbon);
+
+            /**
+             * \brief Appends a molecule record to the database file.
+             * \param rec_idx The zero-based index of the input file record the shapes were generated from.
+             * \param name The name of the molecule.
+             * \param shapes The Gaussian shapes of the molecule conformers.
+             * \return \c true if the record has been written successfully, and \c false otherwise.
+             */
+            bool addRecord(std::size_t rec_idx, const std::string& name, const GaussianShapeSet& shapes);
+
+            /**
+             * \brief Returns the number of molecule records added since the last call to open().
+             * \return The number of added molecule records.
+             */
+            std::size_t getNumRecords() const;
+
+            /**
+             * \brief Tells whether a database file is currently being written.
+             * \return \c true if a file is being written, and \c false otherwise.
+             */
+            bool isOpen() const;
+
+            /**
+             * \brief Completes the database file and renames it to the path specified on opening.
+             * \return \c true if the file has been written successfully, and \c false otherwise.
+             */
+            bool close();
+
+            /**
+             * \brief Stops writing and removes the data written so far.
+             */
+            void discard();
+
+          private:
+            typedef std::unique_ptr<Util::FileRemover> FileRemoverPtr;
+            typedef std::vector<std::uint64_t>         UInt64Array;
+
+            FileRemoverPtr                      tmpFileRemover;
+            std::ofstream                       outStream;
+            std::string                         path;
+            std::uint64_t                       sourceStamp;
+            ScreeningSettings::ColorFeatureType colorFtrType;
+            bool                                allCarbon;
+            std::uint64_t                       numElements;
+            UInt64Array                         recordTable;
+            UInt64Array                         shapeOffsets;
+            std::string                         nameData;
+        };
+    } // namespace Shape
+} // namespace CDPL
+
+#endif // CDPL_SHAPE_GAUSSIANSHAPEDATABASEWRITER_HPP
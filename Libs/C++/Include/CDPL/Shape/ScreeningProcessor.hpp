@@ -56,6 +56,7 @@ namespace CDPL
     {
 
         class AlignmentResult;
+        class GaussianShapeDatabase;
 
         /**
          * \brief High-level driver for shape-based virtual screening of molecular databases.
@@ -86,6 +87,13 @@ namespace CDPL
              */
             typedef std::function<void(const Chem::MolecularGraph&, const Chem::MolecularGraph&, const AlignmentResult&)> HitCallbackFunction;
 
+            /**
+             * \brief Type of the callback invoked for each alignment hit of a shape database record (arguments: query,
+             *        zero-based index of the hit database record, alignment result).
+             * \since 1.4
+             */
+            typedef std::function<void(const Chem::MolecularGraph&, std::size_t, const AlignmentResult&)>                DatabaseHitCallbackFunction;
+
             /**
              * \brief Constructs an empty \c %ScreeningProcessor instance.
              */
@@ -118,6 +126,21 @@ namespace CDPL
              */
             const HitCallbackFunction& getHitCallback() const;
 
+            /**
+             * \brief Sets the callback that is invoked for every alignment hit produced by
+             *        process(const GaussianShapeDatabase&, std::size_t).
+             * \param func The database hit-callback function.
+             * \since 1.4
+             */
+            void setDatabaseHitCallback(const DatabaseHitCallbackFunction& func);
+
+            /**
+             * \brief Returns the currently configured database hit callback.
+             * \return A \c const reference to the database hit-callback function.
+             * \since 1.4
+             */
+            const DatabaseHitCallbackFunction& getDatabaseHitCallback() const;
+
             /**
              * \brief Returns the current screening settings.
              * \return A \c const reference to the screening settings.
@@ -174,12 +197,63 @@ namespace CDPL
              */
             bool process(const Chem::MolecularGraph& molgraph);
 
+            /**
+             * \brief Processes the precomputed shapes of the molecule record \a idx stored in the shape database \a db,
+             *        aligning them against all query molecules.
+             *
+             * In contrast to process(const Chem::MolecularGraph&), no structure perception and shape generation work is
+             * required. Hits are reported through the callback set by setDatabaseHitCallback().
+             *
+             * \param db The shape database.
+             * \param idx The zero-based index of the molecule record in \a db.
+             * \return \c true if at least one alignment hit was produced for the record, and \c false otherwise.
+             * \throw Base::ValueError if the shapes in \a db were generated with a color feature type or all-carbon mode
+             *        setting that differs from the current settings, and Base::IndexError if \a idx is out of bounds.
+             * \since 1.4
+             */
+            bool process(const GaussianShapeDatabase& db, std::size_t idx);
+
+            /**
+             * \brief Returns the shapes that were generated for the database molecule of the last call to
+             *        process(const Chem::MolecularGraph&).
+             *
+             * The shapes can be stored by means of Shape::GaussianShapeDatabaseWriter for later screening runs.
+             *
+             * \return A \c const reference to the generated shapes.
+             * \since 1.4
+             */
+            const GaussianShapeSet& getDatabaseMoleculeShapes() const;
+
+            /**
+             * \brief Returns the total number of query/database conformer alignments performed by this processor.
+             * \return The number of performed conformer alignments.
+             * \since 1.4
+             */
+            std::size_t getNumPerformedAlignments() const;
+
+            /**
+             * \brief Returns the total number of query/database conformer alignments that were skipped by this processor
+             *        because they could not yield a hit.
+             * \return The number of pruned conformer alignments.
+             * \see ScreeningSettings::pruneAlignments(bool)
+             * \since 1.4
+             */
+            std::size_t getNumPrunedAlignments() const;
+
           private:
+            typedef std::vector<GaussianShape::SharedPointer> ShapeList;
+
             void init();
             void applyShapeGenSettings(bool query);
             void applyAlignmentSettings();
             void resetQuery();
 
+            template <typename HitFunc>
+            bool processShapes(const GaussianShapeSet& shapes, const HitFunc& hit_func);
+
+            bool alignShapes(const GaussianShape& shape);
+            bool alignShapes(const GaussianShapeSet& shapes);
+
             ScreeningSettings                    settings;
             ScreeningSettings::ColorFeatureType  colorFtrType;
             bool                                 allCarbon;
@@ -188,6 +262,11 @@ namespace CDPL
             GaussianShapeGenerator               shapeGen;
             MolecularGraphList                   queryList;
             HitCallbackFunction                  hitCallback;
+            DatabaseHitCallbackFunction          dbHitCallback;
+            GaussianShapeSet                     dbShapes;
+            ShapeList                            dbShapeCache;
+            std::size_t                          numPerfAligns;
+            std::size_t                          numPrunedAligns;
         };
     } // namespace Shape
 } // namespace CDPL
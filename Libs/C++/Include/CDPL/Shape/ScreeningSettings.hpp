@@ -259,6 +259,27 @@ namespace CDPL
              */
             bool greedyOptimization() const;
 
+            /**
+             * \brief Specifies whether alignments of query and database conformers that provably cannot yield a hit shall be skipped.
+             *
+             * The decision is based on an upper bound of the achievable score that is derived from the shape and color
+             * self-overlaps of the conformers (see Shape::FastGaussianShapeAlignment::pruneAlignments(bool)). Pruning does
+             * not alter the screening results only if the scoring function does not decrease with increasing overlap (as
+             * the built-in scoring functions). For other, user-provided scoring functions pruning must not be enabled.
+             * Pruning is disabled by default.
+             *
+             * \param prune \c true to enable pruning, and \c false to align all conformer pairs.
+             * \since 1.4
+             */
+            void pruneAlignments(bool prune);
+
+            /**
+             * \brief Tells whether alignments of query and database conformers that provably cannot yield a hit are skipped.
+             * \return \c true if pruning is enabled, and \c false otherwise.
+             * \since 1.4
+             */
+            bool pruneAlignments() const;
+
             /**
              * \brief Sets the maximum number of overlap-optimization iterations.
              * \param max_iter The new maximum number of iterations.
@@ -308,6 +329,7 @@ namespace CDPL
             std::size_t      numOptIter;
             double           optStopGrad;
             double           scoreCutoff;
+            bool             pruneAligns;
         };
     } // namespace Shape
 } // namespace CDPL
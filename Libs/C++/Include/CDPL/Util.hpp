@@ -43,6 +43,7 @@
 #include "CDPL/Util/StreamDataReader.hpp"
 #include "CDPL/Util/CompoundDataReader.hpp"
 #include "CDPL/Util/FileDataReader.hpp"
+#include "CDPL/Util/ParallelFileDataReader.hpp"
 #include "CDPL/Util/FileDataWriter.hpp"
 #include "CDPL/Util/MultiFormatDataReader.hpp"
 #include "CDPL/Util/MultiFormatDataWriter.hpp"
@@ -55,5 +56,11 @@
 #include "CDPL/Util/CompressionStreams.hpp"
 #include "CDPL/Util/CompressedDataReader.hpp"
 #include "CDPL/Util/CompressedDataWriter.hpp"
+#include "CDPL/Util/RecordIndexFile.hpp"
+#include "CDPL/Util/MappedFileIStream.hpp"
+#include "CDPL/Util/ThreadPool.hpp"
+#include "CDPL/Util/ControlParameter.hpp"
+#include "CDPL/Util/ControlParameterDefault.hpp"
+#include "CDPL/Util/ControlParameterFunctions.hpp"
 
 #endif // CDPL_UTIL_HPP
@@ -31,6 +31,8 @@
 
 #include <iosfwd>
 #include <functional>
+#include <string>
+#include <cstdint>
 
 #include "CDPL/Base/DataReader.hpp"
 #include "CDPL/Util/CompressionStreams.hpp"
@@ -130,6 +132,15 @@ namespace CDPL
              */
             void close();
 
+            /**
+             * \brief Specifies a file for the persistent storage of the record stream positions of the decompressed data.
+             * \param path The path of the record index file.
+             * \param src_stamp A value identifying the state of the data source.
+             * \see Util::StreamDataReader::setRecordIndexFile()
+             * \since 1.4
+             */
+            void setRecordIndexFile(const std::string& path, std::uint64_t src_stamp);
+
           private:
             DecompStream stream;
             ReaderImpl   reader;
@@ -218,4 +229,10 @@ void CDPL::Util::CompressedDataReader<ReaderImpl, DecompStream, DataType>::close
     stream.close();
 }
 
+template <typename ReaderImpl, typename DecompStream, typename DataType>
+void CDPL::Util::CompressedDataReader<ReaderImpl, DecompStream, DataType>::setRecordIndexFile(const std::string& path, std::uint64_t src_stamp)
+{
+    reader.setRecordIndexFile(path, src_stamp);
+}
+
 #endif // CDPL_UTIL_COMPRESSEDDATAREADER_HPP
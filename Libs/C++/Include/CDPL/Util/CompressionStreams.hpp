@@ -30,6 +30,9 @@
 #define CDPL_UTIL_COMPRESSIONSTREAMS_HPP
 
 #include <fstream>
+#include <vector>
+#include <memory>
+#include <algorithm>
 
 #include <boost/iostreams/copy.hpp>
 #include <boost/iostreams/filtering_stream.hpp>
@@ -176,9 +179,141 @@ namespace CDPL
             FileBufType tmpFileBuf;
         };
 
+        /**
+         * \brief Stream buffer that decompresses data on demand while it is being read from an underlying compressed source stream.
+         *
+         * In its default (streaming) mode, \c %DecompressionStreamBuffer pulls decompressed data chunk-wise through a
+         * boost::iostreams filter chain so that sequential reads do not require any temporary storage. The most recently
+         * decompressed data (at least \a HISTORY_SIZE characters) is kept in memory which allows for short backward seeks
+         * as performed by the format parsers when peeking ahead. Forward seeks are carried out by decompressing and discarding
+         * the skipped data.
+         *
+         * Seeks that cannot be served in streaming mode (i.e. seeks beyond the start of the retained data or relative to the end
+         * of the data) switch the buffer into random access mode: the whole source stream is then decompressed (once) into a
+         * hidden temporary file which serves all further read and seek operations.
+         *
+         * \tparam CompAlgo The compression algorithm identifier (see Util::CompressionAlgo).
+         * \tparam CharT The character type of the stream.
+         * \tparam TraitsT The character traits type of the stream.
+         * \since 1.4
+         */
+        template <CompressionAlgo CompAlgo, typename CharT = char, typename TraitsT = std::char_traits<CharT> >
+        class DecompressionStreamBuffer : public std::basic_streambuf<CharT, TraitsT>
+        {
+
+          public:
+            /**
+             * \brief The character type of the buffer.
+             */
+            typedef CharT                                   char_type;
+
+            /**
+             * \brief The character traits type of the buffer.
+             */
+            typedef TraitsT                                 traits_type;
+
+            /**
+             * \brief The integer type used to represent characters and EOF.
+             */
+            typedef typename traits_type::int_type          int_type;
+
+            /**
+             * \brief The type used to represent stream positions.
+             */
+            typedef typename traits_type::pos_type          pos_type;
+
+            /**
+             * \brief The type used to represent stream offsets.
+             */
+            typedef typename traits_type::off_type          off_type;
+
+            /**
+             * \brief Input-stream type with matching character and traits types.
+             */
+            typedef std::basic_istream<char_type, traits_type> IStreamType;
+
+            /**
+             * \brief The minimum number of already consumed characters that are kept in memory in streaming mode.
+             */
+            static constexpr std::size_t HISTORY_SIZE = 256 * 1024;
+
+            /**
+             * \brief The number of characters that get decompressed in one go.
+             */
+            static constexpr std::size_t CHUNK_SIZE   = 256 * 1024;
+
+            /**
+             * \brief Constructs the \c %DecompressionStreamBuffer instance without an associated source stream.
+             */
+            DecompressionStreamBuffer();
+
+            /**
+             * \brief Associates the buffer with the compressed source stream \a stream.
+             *
+             * Decompression starts at the current read position of \a stream.
+             *
+             * \param stream The compressed source stream to read from.
+             * \return \c true if the source stream is in a good state, and \c false otherwise.
+             */
+            bool open(IStreamType& stream);
+
+            /**
+             * \brief Releases the source stream, the filter chain and the temporary file (if any).
+             * \return \c true if the operation was successful, and \c false otherwise.
+             */
+            bool close();
+
+            /**
+             * \brief Tells whether the buffer is currently associated with a source stream.
+             * \return \c true if a source stream is associated, and \c false otherwise.
+             */
+            bool isOpen() const;
+
+            /**
+             * \brief Tells whether the buffer still operates in streaming mode or already switched to the temporary file.
+             * \return \c true if in streaming mode, and \c false if the data are read from a temporary file.
+             */
+            bool isStreaming() const;
+
+          protected:
+            int_type underflow();
+
+            pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which);
+            pos_type seekpos(pos_type pos, std::ios_base::openmode which);
+
+          private:
+            typedef boost::iostreams::filtering_streambuf<boost::iostreams::input, char_type, traits_type> FilterBufType;
+            typedef std::unique_ptr<FilterBufType>                                                         FilterBufPtr;
+            typedef std::basic_filebuf<char_type, traits_type>                                             FileBufType;
+            typedef std::vector<char_type>                                                                 CharBuffer;
+
+            bool fillBuffer();
+
+            pos_type seekTo(off_type pos);
+
+            bool switchToTmpFile();
+
+            IStreamType* source;
+            pos_type     sourceStartPos;
+            FilterBufPtr filterBuf;
+            FileBufType  tmpFileBuf;
+            bool         streaming;
+            CharBuffer   buffer;
+            off_type     bufferOffset;
+        };
+
         /**
          * \brief Input stream wrapper that transparently decompresses data read from an underlying compressed source stream.
          *
+         * Data are decompressed on demand while being read (see Util::DecompressionStreamBuffer). A temporary file holding
+         * the complete decompressed data is only created if random access to the data is requested (e.g. by seeking backwards
+         * over larger distances or relative to the end of the stream).
+         *
+         * \note Since the data are no longer decompressed completely on open(), the compressed source stream has to stay
+         *       alive (and must not be read or repositioned by other parties) until close() has been called or the
+         *       \c %DecompressionIStream instance has been destroyed. The temporary-file buffer provided by the
+         *       Util::CompressionStreamBase base class is not used anymore.
+         *
          * \tparam CompAlgo The compression algorithm identifier (see Util::CompressionAlgo).
          * \tparam CharT The character type of the stream.
          * \tparam TraitsT The character traits type of the stream.
@@ -231,7 +366,8 @@ namespace CDPL
 
             /**
              * \brief Opens the decompression stream on \a stream.
-             * \param stream The compressed source stream to read from.
+             * \param stream The compressed source stream to read from (has to outlive the decompression stream or
+             *               remain valid until close() gets called).
              */
             void open(StreamType& stream);
 
@@ -239,6 +375,16 @@ namespace CDPL
              * \brief Closes the decompression stream and releases the temporary buffer.
              */
             void close();
+
+            /**
+             * \brief Tells whether the data are still decompressed on the fly or already read from a temporary file.
+             * \return \c true if in streaming mode, and \c false otherwise.
+             * \since 1.4
+             */
+            bool isStreaming() const;
+
+          private:
+            DecompressionStreamBuffer<CompAlgo, CharT, TraitsT> streamBuf;
         };
 
         /**
@@ -503,31 +649,291 @@ void CDPL::Util::CompressionStreamBase<CompAlgo, StreamType>::compOutput(OStream
     this->setstate(os.rdstate() | fs.rdstate());
 }
 
+// DecompressionStreamBuffer Implementation
+
+template <CDPL::Util::CompressionAlgo CompAlgo, typename CharT, typename TraitsT>
+constexpr std::size_t CDPL::Util::DecompressionStreamBuffer<CompAlgo, CharT, TraitsT>::HISTORY_SIZE;
+
+template <CDPL::Util::CompressionAlgo CompAlgo, typename CharT, typename TraitsT>
+constexpr std::size_t CDPL::Util::DecompressionStreamBuffer<CompAlgo, CharT, TraitsT>::CHUNK_SIZE;
+
+template <CDPL::Util::CompressionAlgo CompAlgo, typename CharT, typename TraitsT>
+CDPL::Util::DecompressionStreamBuffer<CompAlgo, CharT, TraitsT>::DecompressionStreamBuffer():
+    source(0), sourceStartPos(-1), streaming(true), bufferOffset(0)
+{}
+
+template <CDPL::Util::CompressionAlgo CompAlgo, typename CharT, typename TraitsT>
+bool CDPL::Util::DecompressionStreamBuffer<CompAlgo, CharT, TraitsT>::open(IStreamType& stream)
+{
+    close();
+
+    if (!stream.good())
+        return false;
+
+    source         = &stream;
+    sourceStartPos = stream.tellg();
+
+    stream.clear();
+
+    if (!traits_type::eq_int_type(stream.rdbuf()->sgetc(), traits_type::eof())) { // empty input is not an error
+        filterBuf.reset(new FilterBufType());
+
+        filterBuf->push(typename CompressionAlgoTraits<CompAlgo>::DecompFilter());
+        filterBuf->push(stream);
+    }
+
+    buffer.resize(HISTORY_SIZE + CHUNK_SIZE);
+
+    return true;
+}
+
+template <CDPL::Util::CompressionAlgo CompAlgo, typename CharT, typename TraitsT>
+bool CDPL::Util::DecompressionStreamBuffer<CompAlgo, CharT, TraitsT>::close()
+{
+    bool ok = true;
+
+    if (tmpFileBuf.is_open())
+        ok = (tmpFileBuf.close() != 0);
+
+    filterBuf.reset();
+
+    source         = 0;
+    sourceStartPos = pos_type(-1);
+    streaming      = true;
+    bufferOffset   = 0;
+
+    this->setg(0, 0, 0);
+
+    CharBuffer().swap(buffer);
+
+    return ok;
+}
+
+template <CDPL::Util::CompressionAlgo CompAlgo, typename CharT, typename TraitsT>
+bool CDPL::Util::DecompressionStreamBuffer<CompAlgo, CharT, TraitsT>::isOpen() const
+{
+    return source;
+}
+
+template <CDPL::Util::CompressionAlgo CompAlgo, typename CharT, typename TraitsT>
+bool CDPL::Util::DecompressionStreamBuffer<CompAlgo, CharT, TraitsT>::isStreaming() const
+{
+    return streaming;
+}
+
+template <CDPL::Util::CompressionAlgo CompAlgo, typename CharT, typename TraitsT>
+typename CDPL::Util::DecompressionStreamBuffer<CompAlgo, CharT, TraitsT>::int_type
+CDPL::Util::DecompressionStreamBuffer<CompAlgo, CharT, TraitsT>::underflow()
+{
+    if (this->gptr() < this->egptr() || fillBuffer())
+        return traits_type::to_int_type(*this->gptr());
+
+    return traits_type::eof();
+}
+
+template <CDPL::Util::CompressionAlgo CompAlgo, typename CharT, typename TraitsT>
+typename CDPL::Util::DecompressionStreamBuffer<CompAlgo, CharT, TraitsT>::pos_type
+CDPL::Util::DecompressionStreamBuffer<CompAlgo, CharT, TraitsT>::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+    if (!source || !(which & std::ios_base::in))
+        return pos_type(off_type(-1));
+
+    switch (dir) {
+
+        case std::ios_base::beg:
+            return seekTo(off);
+
+        case std::ios_base::cur:
+            return seekTo(bufferOffset + off_type(this->gptr() - this->eback()) + off);
+
+        case std::ios_base::end: {
+            if (streaming && !switchToTmpFile())
+                return pos_type(off_type(-1));
+
+            off_type end_pos = tmpFileBuf.pubseekoff(0, std::ios_base::end, std::ios_base::in);
+
+            if (end_pos < 0)
+                return pos_type(off_type(-1));
+
+            bufferOffset = end_pos;
+
+            this->setg(buffer.data(), buffer.data(), buffer.data());
+
+            return seekTo(end_pos + off);
+        }
+
+        default:
+            return pos_type(off_type(-1));
+    }
+}
+
+template <CDPL::Util::CompressionAlgo CompAlgo, typename CharT, typename TraitsT>
+typename CDPL::Util::DecompressionStreamBuffer<CompAlgo, CharT, TraitsT>::pos_type
+CDPL::Util::DecompressionStreamBuffer<CompAlgo, CharT, TraitsT>::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+    if (!source || !(which & std::ios_base::in))
+        return pos_type(off_type(-1));
+
+    return seekTo(off_type(pos));
+}
+
+template <CDPL::Util::CompressionAlgo CompAlgo, typename CharT, typename TraitsT>
+typename CDPL::Util::DecompressionStreamBuffer<CompAlgo, CharT, TraitsT>::pos_type
+CDPL::Util::DecompressionStreamBuffer<CompAlgo, CharT, TraitsT>::seekTo(off_type pos)
+{
+    if (pos < 0)
+        return pos_type(off_type(-1));
+
+    if (pos >= bufferOffset) {
+        while (true) {
+            off_type buf_end = bufferOffset + off_type(this->egptr() - this->eback());
+
+            if (pos <= buf_end) {
+                this->setg(this->eback(), this->eback() + (pos - bufferOffset), this->egptr());
+                return pos_type(pos);
+            }
+
+            if (!streaming)
+                break;
+
+            // skip forward by decompressing and discarding the data in between
+                
+            this->setg(this->eback(), this->egptr(), this->egptr());
+
+            if (!fillBuffer())
+                return pos_type(off_type(-1));
+        }
+
+    } else if (streaming && !switchToTmpFile())
+        return pos_type(off_type(-1));
+
+    if (tmpFileBuf.pubseekpos(pos, std::ios_base::in) != pos_type(pos))
+        return pos_type(off_type(-1));
+
+    bufferOffset = pos;
+
+    this->setg(buffer.data(), buffer.data(), buffer.data());
+
+    return pos_type(pos);
+}
+
+template <CDPL::Util::CompressionAlgo CompAlgo, typename CharT, typename TraitsT>
+bool CDPL::Util::DecompressionStreamBuffer<CompAlgo, CharT, TraitsT>::fillBuffer()
+{
+    if (!source)
+        return false;
+
+    std::size_t data_len = this->egptr() - this->eback();
+    std::size_t read_pos = this->gptr() - this->eback();
+
+    if (data_len + CHUNK_SIZE > buffer.size()) {
+        std::size_t num_disc = data_len - std::min(data_len, HISTORY_SIZE);
+
+        std::copy(buffer.begin() + num_disc, buffer.begin() + data_len, buffer.begin());
+
+        bufferOffset += off_type(num_disc);
+        data_len -= num_disc;
+        read_pos -= num_disc;
+    }
+
+    std::streamsize num_read = 0;
+
+    if (!streaming)
+        num_read = tmpFileBuf.sgetn(buffer.data() + data_len, buffer.size() - data_len);
+
+    else if (filterBuf)
+        num_read = filterBuf->sgetn(buffer.data() + data_len, buffer.size() - data_len);
+
+    if (num_read > 0)
+        data_len += num_read;
+
+    this->setg(buffer.data(), buffer.data() + read_pos, buffer.data() + data_len);
+
+    return (num_read > 0);
+}
+
+template <CDPL::Util::CompressionAlgo CompAlgo, typename CharT, typename TraitsT>
+bool CDPL::Util::DecompressionStreamBuffer<CompAlgo, CharT, TraitsT>::switchToTmpFile()
+{
+    if (sourceStartPos == pos_type(-1))
+        return false;
+
+    FileRemover tmp_file_rem(genCheckedTempFilePath());
+
+    if (!tmpFileBuf.open(tmp_file_rem.getPath().c_str(),
+                         std::ios_base::in | std::ios_base::out |
+                             std::ios_base::trunc | std::ios_base::binary))
+        return false;
+
+    filterBuf.reset();
+
+    source->clear();
+    source->seekg(sourceStartPos);
+
+    if (!source->good())
+        return false;
+
+    if (!traits_type::eq_int_type(source->rdbuf()->sgetc(), traits_type::eof())) {
+        boost::iostreams::filtering_stream<boost::iostreams::input, char_type, traits_type> fs;
+
+        fs.push(typename CompressionAlgoTraits<CompAlgo>::DecompFilter());
+        fs.push(*source);
+
+        boost::iostreams::copy(fs, static_cast<std::basic_streambuf<char_type, traits_type>&>(tmpFileBuf)); // prevents closing of tmpFileBuf
+
+        if (fs.bad())
+            return false;
+    }
+
+    if (tmpFileBuf.pubseekpos(0, std::ios_base::in | std::ios_base::out) != pos_type(0))
+        return false;
+
+    streaming    = false;
+    bufferOffset = 0;
+
+    this->setg(buffer.data(), buffer.data(), buffer.data());
+
+    return true;
+}
+
 // DecompressionIStream Implementation
 
 template <CDPL::Util::CompressionAlgo CompAlgo, typename CharT, typename TraitsT>
 CDPL::Util::DecompressionIStream<CompAlgo, CharT, TraitsT>::DecompressionIStream()
-{}
+{
+    this->rdbuf(&streamBuf);
+}
 
 template <CDPL::Util::CompressionAlgo CompAlgo, typename CharT, typename TraitsT>
 CDPL::Util::DecompressionIStream<CompAlgo, CharT, TraitsT>::DecompressionIStream(StreamType& stream)
 {
+    this->rdbuf(&streamBuf);
+
     open(stream);
 }
 
 template <CDPL::Util::CompressionAlgo CompAlgo, typename CharT, typename TraitsT>
 void CDPL::Util::DecompressionIStream<CompAlgo, CharT, TraitsT>::open(StreamType& stream)
 {
-    this->openTmpFile();
-
-    if (this->good())
-        this->decompInput(stream);
+    if (!streamBuf.open(stream))
+        this->setstate(std::ios_base::failbit);
+    else
+        this->clear(std::ios_base::goodbit);
 }
 
 template <CDPL::Util::CompressionAlgo CompAlgo, typename CharT, typename TraitsT>
 void CDPL::Util::DecompressionIStream<CompAlgo, CharT, TraitsT>::close()
 {
-    this->closeTmpFile();
+    if (!streamBuf.close())
+        this->setstate(std::ios_base::failbit);
+    else
+        this->clear();
+}
+
+template <CDPL::Util::CompressionAlgo CompAlgo, typename CharT, typename TraitsT>
+bool CDPL::Util::DecompressionIStream<CompAlgo, CharT, TraitsT>::isStreaming() const
+{
+    return streamBuf.isStreaming();
 }
 
 // CompressionOStream Implementation
@@ -0,0 +1,82 @@
+/* 
+ * ControlParameter.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of constants in namespace CDPL::Util::ControlParameter.
+ */
+
+#ifndef CDPL_UTIL_CONTROLPARAMETER_HPP
+#define CDPL_UTIL_CONTROLPARAMETER_HPP
+
+#include "CDPL/Util/APIPrefix.hpp"
+
+
+namespace CDPL
+{
+
+    namespace Base
+    {
+
+        class LookupKey;
+    }
+
+    namespace Util
+    {
+
+        /**
+         * \brief Provides keys for built-in control-parameters.
+         * \since 1.4
+         */
+        namespace ControlParameter
+        {
+
+            /**
+             * \brief Specifies whether the stream positions of the data records found by a scan of an input file shall be
+             *        stored in and retrieved from a record index file that is located next to the input file.
+             *
+             * If the parameter is set to \c true, readers operating on files (see Util::FileDataReader) will try to load the
+             * record stream positions from a file named <em>&lt;input file&gt;.ridx</em> before the input file gets scanned.
+             * If the index file does not exist or does not match the current state of the input file, the input file is scanned
+             * as usual and the obtained record positions are saved to the index file afterwards for later reuse.
+             *
+             * \valuetype \c bool
+             * \since 1.4
+             */
+            extern CDPL_UTIL_API const Base::LookupKey USE_RECORD_INDEX_FILES;
+
+            /**
+             * \brief Specifies the number of threads that shall be used by readers supporting parallel parsing of the
+             *        records of an input file (see Util::ParallelFileDataReader).
+             *
+             * A value of \e 0 disables parallel parsing and the data records will be read sequentially.
+             *
+             * \valuetype \c std::size_t
+             * \since 1.4
+             */
+            extern CDPL_UTIL_API const Base::LookupKey NUM_READER_THREADS;
+        } // namespace ControlParameter
+    } // namespace Util
+} // namespace CDPL
+
+#endif // CDPL_UTIL_CONTROLPARAMETER_HPP
@@ -0,0 +1,65 @@
+/* 
+ * ControlParameterDefault.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of constants in namespace CDPL::Util::ControlParameterDefault.
+ */
+
+#ifndef CDPL_UTIL_CONTROLPARAMETERDEFAULT_HPP
+#define CDPL_UTIL_CONTROLPARAMETERDEFAULT_HPP
+
+#include <cstddef>
+
+#include "CDPL/Util/APIPrefix.hpp"
+
+
+namespace CDPL
+{
+
+    namespace Util
+    {
+
+        /**
+         * \brief Provides default values for built-in control-parameters.
+         * \since 1.4
+         */
+        namespace ControlParameterDefault
+        {
+
+            /**
+             * \brief Default value (= \c false) of the control-parameter Util::ControlParameter::USE_RECORD_INDEX_FILES.
+             * \since 1.4
+             */
+            extern CDPL_UTIL_API const bool USE_RECORD_INDEX_FILES;
+
+            /**
+             * \brief Default value (= \e 0) of the control-parameter Util::ControlParameter::NUM_READER_THREADS.
+             * \since 1.4
+             */
+            extern CDPL_UTIL_API const std::size_t NUM_READER_THREADS;
+        } // namespace ControlParameterDefault
+    } // namespace Util
+} // namespace CDPL
+
+#endif // CDPL_UTIL_CONTROLPARAMETERDEFAULT_HPP
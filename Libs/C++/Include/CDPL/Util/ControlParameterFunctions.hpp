@@ -0,0 +1,113 @@
+/* 
+ * ControlParameterFunctions.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Declaration of convenience functions for control-parameter handling.
+ */
+
+#ifndef CDPL_UTIL_CONTROLPARAMETERFUNCTIONS_HPP
+#define CDPL_UTIL_CONTROLPARAMETERFUNCTIONS_HPP
+
+#include <cstddef>
+
+#include "CDPL/Util/APIPrefix.hpp"
+
+
+namespace CDPL
+{
+
+    namespace Base
+    {
+
+        class ControlParameterContainer;
+    }
+
+    namespace Util
+    {
+
+        /**
+         * \brief Returns the value of the Util::ControlParameter::USE_RECORD_INDEX_FILES parameter stored in \a cntnr.
+         * \param cntnr The control-parameter container.
+         * \return \c true if record index files shall be used, and \c false otherwise.
+         * \since 1.4
+         */
+        CDPL_UTIL_API bool getUseRecordIndexFilesParameter(const Base::ControlParameterContainer& cntnr);
+
+        /**
+         * \brief Sets the value of the Util::ControlParameter::USE_RECORD_INDEX_FILES parameter of \a cntnr to \a use.
+         * \param cntnr The control-parameter container.
+         * \param use \c true to enable the use of record index files, and \c false to disable it.
+         * \since 1.4
+         */
+        CDPL_UTIL_API void setUseRecordIndexFilesParameter(Base::ControlParameterContainer& cntnr, bool use);
+
+        /**
+         * \brief Tells whether the Util::ControlParameter::USE_RECORD_INDEX_FILES parameter of \a cntnr is set.
+         * \param cntnr The control-parameter container.
+         * \return \c true if the parameter is set, and \c false otherwise.
+         * \since 1.4
+         */
+        CDPL_UTIL_API bool hasUseRecordIndexFilesParameter(const Base::ControlParameterContainer& cntnr);
+
+        /**
+         * \brief Removes the Util::ControlParameter::USE_RECORD_INDEX_FILES parameter from \a cntnr.
+         * \param cntnr The control-parameter container.
+         * \since 1.4
+         */
+        CDPL_UTIL_API void clearUseRecordIndexFilesParameter(Base::ControlParameterContainer& cntnr);
+
+        /**
+         * \brief Returns the value of the Util::ControlParameter::NUM_READER_THREADS parameter stored in \a cntnr.
+         * \param cntnr The control-parameter container.
+         * \return The number of threads used for parallel record parsing.
+         * \since 1.4
+         */
+        CDPL_UTIL_API std::size_t getNumReaderThreadsParameter(const Base::ControlParameterContainer& cntnr);
+
+        /**
+         * \brief Sets the value of the Util::ControlParameter::NUM_READER_THREADS parameter of \a cntnr to \a num_threads.
+         * \param cntnr The control-parameter container.
+         * \param num_threads The number of threads used for parallel record parsing (\e 0 disables parallel parsing).
+         * \since 1.4
+         */
+        CDPL_UTIL_API void setNumReaderThreadsParameter(Base::ControlParameterContainer& cntnr, std::size_t num_threads);
+
+        /**
+         * \brief Tells whether the Util::ControlParameter::NUM_READER_THREADS parameter of \a cntnr is set.
+         * \param cntnr The control-parameter container.
+         * \return \c true if the parameter is set, and \c false otherwise.
+         * \since 1.4
+         */
+        CDPL_UTIL_API bool hasNumReaderThreadsParameter(const Base::ControlParameterContainer& cntnr);
+
+        /**
+         * \brief Removes the Util::ControlParameter::NUM_READER_THREADS parameter from \a cntnr.
+         * \param cntnr The control-parameter container.
+         * \since 1.4
+         */
+        CDPL_UTIL_API void clearNumReaderThreadsParameter(Base::ControlParameterContainer& cntnr);
+    } // namespace Util
+} // namespace CDPL
+
+#endif // CDPL_UTIL_CONTROLPARAMETERFUNCTIONS_HPP
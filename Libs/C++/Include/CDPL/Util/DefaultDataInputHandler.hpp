@@ -42,13 +42,15 @@ namespace CDPL
         /**
          * \brief Default Base::DataInputHandler implementation that exposes a fixed Base::DataFormat and instantiates
          *        readers of the supplied stream-based \a ReaderImpl type (file-based readers are produced by wrapping it
-         *        in Util::FileDataReader).
+         *        in \a FileReaderImpl).
          *
          * \tparam ReaderImpl The underlying stream-based reader implementation type.
          * \tparam Format A reference to the Base::DataFormat constant advertised by the handler.
          * \tparam DataType The data type read by \a ReaderImpl.
+         * \tparam FileReaderImpl The type of the readers created for file input (since 1.4).
          */
-        template <typename ReaderImpl, const Base::DataFormat& Format, typename DataType = typename ReaderImpl::DataType>
+        template <typename ReaderImpl, const Base::DataFormat& Format, typename DataType = typename ReaderImpl::DataType,
+                  typename FileReaderImpl = Util::FileDataReader<ReaderImpl, DataType> >
         class DefaultDataInputHandler : public Base::DataInputHandler<DataType>
         {
 
@@ -81,11 +83,11 @@ namespace CDPL
              * \brief Creates a reader that reads from the file \a file_name (opened in mode \a mode).
              * \param file_name The path of the input file.
              * \param mode The open mode of the underlying file stream.
-             * \return A shared pointer to a freshly constructed Util::FileDataReader wrapping a \a ReaderImpl.
+             * \return A shared pointer to a freshly constructed \a FileReaderImpl wrapping a \a ReaderImpl.
              */
             typename ReaderType::SharedPointer createReader(const std::string& file_name, std::ios_base::openmode mode) const
             {
-                return typename ReaderType::SharedPointer(new Util::FileDataReader<ReaderImpl>(file_name, mode));
+                return typename ReaderType::SharedPointer(new FileReaderImpl(file_name, mode));
             }
         };
     } // namespace Util
@@ -35,6 +35,7 @@
 
 #include "CDPL/Base/DataReader.hpp"
 #include "CDPL/Base/Exceptions.hpp"
+#include "CDPL/Util/FileFunctions.hpp"
 
 
 namespace CDPL
@@ -45,12 +46,15 @@ namespace CDPL
 
         /**
          * \brief Convenience wrapper that adapts a stream-based reader implementation \a ReaderImpl into a file-based
-         *        Base::DataReader by opening an \c std::ifstream and forwarding all read operations to the wrapped reader.
+         *        Base::DataReader by opening an input file stream (by default an \c std::ifstream) and forwarding all
+         *        read operations to the wrapped reader.
          *
          * \tparam ReaderImpl The underlying stream-based reader implementation type.
          * \tparam DataType The data type read by \a ReaderImpl.
+         * \tparam StreamType The type of the input file stream (must provide the same constructor and \c close()
+         *         method as \c std::ifstream, since 1.4).
          */
-        template <typename ReaderImpl, typename DataType = typename ReaderImpl::DataType>
+        template <typename ReaderImpl, typename DataType = typename ReaderImpl::DataType, typename StreamType = std::ifstream>
         class FileDataReader : public Base::DataReader<DataType>
         {
 
@@ -59,7 +63,7 @@ namespace CDPL
              * \brief Constructs a \c %FileDataReader instance that opens the file \a file_name in the given mode and
              *        forwards all read operations to a freshly constructed \a ReaderImpl wrapping the file stream.
              * \param file_name The path of the input file to open.
-             * \param mode The open mode of the underlying \c std::ifstream.
+             * \param mode The open mode of the underlying file stream.
              * \throw Base::IOError if the file could not be opened.
              */
             FileDataReader(const std::string&      file_name,
@@ -133,7 +137,7 @@ namespace CDPL
             void close();
 
           private:
-            std::ifstream stream;
+            StreamType    stream;
             std::string   fileName;
             ReaderImpl    reader;
         };
@@ -143,8 +147,8 @@ namespace CDPL
 
 // Implementation
 
-template <typename ReaderImpl, typename DataType>
-CDPL::Util::FileDataReader<ReaderImpl, DataType>::FileDataReader(const std::string& file_name, std::ios_base::openmode mode):
+template <typename ReaderImpl, typename DataType, typename StreamType>
+CDPL::Util::FileDataReader<ReaderImpl, DataType, StreamType>::FileDataReader(const std::string& file_name, std::ios_base::openmode mode):
     stream(file_name.c_str(), mode), fileName(file_name), reader(stream)
 {
     if (!stream.good())
@@ -152,11 +156,12 @@ CDPL::Util::FileDataReader<ReaderImpl, DataType>::FileDataReader(const std::stri
 
     reader.setParent(this);
     reader.registerIOCallback(std::bind(&Base::DataIOBase::invokeIOCallbacks, this, std::placeholders::_2));
+    reader.setRecordIndexFile(file_name + ".ridx", calcFileStamp(file_name));
 }
 
-template <typename ReaderImpl, typename DataType>
-CDPL::Util::FileDataReader<ReaderImpl, DataType>&
-CDPL::Util::FileDataReader<ReaderImpl, DataType>::read(DataType& obj, bool overwrite)
+template <typename ReaderImpl, typename DataType, typename StreamType>
+CDPL::Util::FileDataReader<ReaderImpl, DataType, StreamType>&
+CDPL::Util::FileDataReader<ReaderImpl, DataType, StreamType>::read(DataType& obj, bool overwrite)
 {
     try {
         reader.read(obj, overwrite);
@@ -168,9 +173,9 @@ CDPL::Util::FileDataReader<ReaderImpl, DataType>::read(DataType& obj, bool overw
     return *this;
 }
 
-template <typename ReaderImpl, typename DataType>
-CDPL::Util::FileDataReader<ReaderImpl, DataType>&
-CDPL::Util::FileDataReader<ReaderImpl, DataType>::read(std::size_t idx, DataType& obj, bool overwrite)
+template <typename ReaderImpl, typename DataType, typename StreamType>
+CDPL::Util::FileDataReader<ReaderImpl, DataType, StreamType>&
+CDPL::Util::FileDataReader<ReaderImpl, DataType, StreamType>::read(std::size_t idx, DataType& obj, bool overwrite)
 {
     try {
         reader.read(idx, obj, overwrite);
@@ -182,9 +187,9 @@ CDPL::Util::FileDataReader<ReaderImpl, DataType>::read(std::size_t idx, DataType
     return *this;
 }
 
-template <typename ReaderImpl, typename DataType>
-CDPL::Util::FileDataReader<ReaderImpl, DataType>&
-CDPL::Util::FileDataReader<ReaderImpl, DataType>::skip()
+template <typename ReaderImpl, typename DataType, typename StreamType>
+CDPL::Util::FileDataReader<ReaderImpl, DataType, StreamType>&
+CDPL::Util::FileDataReader<ReaderImpl, DataType, StreamType>::skip()
 {
     try {
         reader.skip();
@@ -196,44 +201,44 @@ CDPL::Util::FileDataReader<ReaderImpl, DataType>::skip()
     return *this;
 }
 
-template <typename ReaderImpl, typename DataType>
-bool CDPL::Util::FileDataReader<ReaderImpl, DataType>::hasMoreData()
+template <typename ReaderImpl, typename DataType, typename StreamType>
+bool CDPL::Util::FileDataReader<ReaderImpl, DataType, StreamType>::hasMoreData()
 {
     return reader.hasMoreData();
 }
 
-template <typename ReaderImpl, typename DataType>
-std::size_t CDPL::Util::FileDataReader<ReaderImpl, DataType>::getRecordIndex() const
+template <typename ReaderImpl, typename DataType, typename StreamType>
+std::size_t CDPL::Util::FileDataReader<ReaderImpl, DataType, StreamType>::getRecordIndex() const
 {
     return reader.getRecordIndex();
 }
 
-template <typename ReaderImpl, typename DataType>
-void CDPL::Util::FileDataReader<ReaderImpl, DataType>::setRecordIndex(std::size_t idx)
+template <typename ReaderImpl, typename DataType, typename StreamType>
+void CDPL::Util::FileDataReader<ReaderImpl, DataType, StreamType>::setRecordIndex(std::size_t idx)
 {
     reader.setRecordIndex(idx);
 }
 
-template <typename ReaderImpl, typename DataType>
-std::size_t CDPL::Util::FileDataReader<ReaderImpl, DataType>::getNumRecords()
+template <typename ReaderImpl, typename DataType, typename StreamType>
+std::size_t CDPL::Util::FileDataReader<ReaderImpl, DataType, StreamType>::getNumRecords()
 {
     return reader.getNumRecords();
 }
 
-template <typename ReaderImpl, typename DataType>
-CDPL::Util::FileDataReader<ReaderImpl, DataType>::operator const void*() const
+template <typename ReaderImpl, typename DataType, typename StreamType>
+CDPL::Util::FileDataReader<ReaderImpl, DataType, StreamType>::operator const void*() const
 {
     return reader.operator const void*();
 }
 
-template <typename ReaderImpl, typename DataType>
-bool CDPL::Util::FileDataReader<ReaderImpl, DataType>::operator!() const
+template <typename ReaderImpl, typename DataType, typename StreamType>
+bool CDPL::Util::FileDataReader<ReaderImpl, DataType, StreamType>::operator!() const
 {
     return reader.operator!();
 }
 
-template <typename ReaderImpl, typename DataType>
-void CDPL::Util::FileDataReader<ReaderImpl, DataType>::close()
+template <typename ReaderImpl, typename DataType, typename StreamType>
+void CDPL::Util::FileDataReader<ReaderImpl, DataType, StreamType>::close()
 {
     reader.close();
     stream.close();
@@ -30,6 +30,7 @@
 #define CDPL_UTIL_FILEFUNCTIONS_HPP
 
 #include <string>
+#include <cstdint>
 
 #include "CDPL/Util/APIPrefix.hpp"
 
@@ -64,6 +65,24 @@ namespace CDPL
          * \return \c true if the file exists, and \c false otherwise.
          */
         CDPL_UTIL_API bool fileExists(const std::string& path);
+
+        /**
+         * \brief Calculates a stamp value for the file at \a path that changes whenever the size or the time of the last
+         *        modification of the file changes.
+         * \param path The file-system path of the file.
+         * \return The calculated stamp value, or \e 0 if the file does not exist or its status could not be retrieved.
+         * \since 1.4
+         */
+        CDPL_UTIL_API std::uint64_t calcFileStamp(const std::string& path);
+
+        /**
+         * \brief Renames the file at \a old_path to \a new_path, replacing any existing file at \a new_path.
+         * \param old_path The file-system path of the file to rename.
+         * \param new_path The new file-system path of the file.
+         * \return \c true if the file was renamed successfully, and \c false otherwise.
+         * \since 1.4
+         */
+        CDPL_UTIL_API bool renameFile(const std::string& old_path, const std::string& new_path);
     } // namespace Util
 } // namespace CDPL
 
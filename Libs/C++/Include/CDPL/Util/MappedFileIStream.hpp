@@ -0,0 +1,227 @@
+/* 
+ * MappedFileIStream.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of the classes CDPL::Util::MappedFileStreamBuffer and CDPL::Util::MappedFileIStream.
+ */
+
+#ifndef CDPL_UTIL_MAPPEDFILEISTREAM_HPP
+#define CDPL_UTIL_MAPPEDFILEISTREAM_HPP
+
+#include <streambuf>
+#include <istream>
+#include <string>
+#include <memory>
+#include <cstddef>
+
+#include "CDPL/Util/APIPrefix.hpp"
+
+
+namespace boost
+{
+
+    namespace iostreams
+    {
+
+        class mapped_file_source;
+    }
+} // namespace boost
+
+
+namespace CDPL
+{
+
+    namespace Util
+    {
+
+        /**
+         * \brief A read-only stream buffer that provides access to the contents of a memory-mapped file.
+         *
+         * The whole file is exposed as the get area of the buffer, so reading and seeking never copies data
+         * through an intermediate buffer. Readers that know about this class can furthermore access the mapped data
+         * directly via consume(). Pages ahead of the current read position get prefetched by means of
+         * \c posix_madvise() (where available) in windows of configurable size.
+         *
+         * \since 1.4
+         */
+        class CDPL_UTIL_API MappedFileStreamBuffer : public std::streambuf
+        {
+
+          public:
+            /**
+             * \brief The default size of the prefetched data window.
+             */
+            static constexpr std::size_t DEF_PREFETCH_SIZE = 4 * 1024 * 1024;
+
+            /**
+             * \brief Constructs a \c %MappedFileStreamBuffer instance that is not associated with a file.
+             */
+            MappedFileStreamBuffer();
+
+            /**
+             * \brief Destructor.
+             */
+            ~MappedFileStreamBuffer();
+
+            /**
+             * \brief Memory-maps the file \a path.
+             * \param path The path of the file to map.
+             * \return \c true if the file could be mapped, and \c false otherwise.
+             */
+            bool open(const std::string& path);
+
+            /**
+             * \brief Unmaps the currently mapped file.
+             */
+            void close();
+
+            /**
+             * \brief Tells whether a file is currently mapped.
+             * \return \c true if a file is mapped, and \c false otherwise.
+             */
+            bool isOpen() const;
+
+            /**
+             * \brief Returns a pointer to the beginning of the mapped file data.
+             * \return A pointer to the mapped data, or \c nullptr if no (or an empty) file is mapped.
+             */
+            const char* getData() const;
+
+            /**
+             * \brief Returns the size of the mapped file.
+             * \return The size of the mapped file in bytes.
+             */
+            std::size_t getSize() const;
+
+            /**
+             * \brief Returns the current read position.
+             * \return The offset of the current read position from the beginning of the file.
+             */
+            std::size_t getPosition() const;
+
+            /**
+             * \brief Provides direct access to the next \a num_bytes bytes of the mapped data and advances the
+             *        read position accordingly.
+             * \param num_bytes The number of bytes to consume.
+             * \return A pointer to the consumed data, or \c nullptr if less than \a num_bytes bytes are left.
+             */
+            const char* consume(std::size_t num_bytes);
+
+            /**
+             * \brief Advises the operating system to load the specified range of the mapped file in advance.
+             * \param pos The start offset of the range.
+             * \param num_bytes The length of the range in bytes.
+             */
+            void prefetch(std::size_t pos, std::size_t num_bytes) const;
+
+            /**
+             * \brief Specifies the size of the data window that gets prefetched ahead of the current read position.
+             * \param size The size of the prefetched window in bytes (\c 0 disables prefetching).
+             */
+            void setPrefetchSize(std::size_t size);
+
+            /**
+             * \brief Returns the size of the data window that gets prefetched ahead of the current read position.
+             * \return The size of the prefetched window in bytes.
+             */
+            std::size_t getPrefetchSize() const;
+
+          protected:
+            pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which);
+            pos_type seekpos(pos_type pos, std::ios_base::openmode which);
+
+            std::streamsize showmanyc();
+
+          private:
+            MappedFileStreamBuffer(const MappedFileStreamBuffer&);
+
+            MappedFileStreamBuffer& operator=(const MappedFileStreamBuffer&);
+
+            void prefetchAhead();
+
+            typedef boost::iostreams::mapped_file_source MappedFile;
+            typedef std::unique_ptr<MappedFile>          MappedFilePtr;
+
+            MappedFilePtr mappedFile;
+            bool          opened;
+            std::size_t   prefetchSize;
+            std::size_t   prefetchEnd;
+        };
+
+        /**
+         * \brief An input stream that reads the contents of a memory-mapped file.
+         *
+         * \c %MappedFileIStream is a drop-in replacement for \c std::ifstream (e.g. as stream type of Util::FileDataReader)
+         * that is backed by a Util::MappedFileStreamBuffer instance.
+         *
+         * \since 1.4
+         */
+        class CDPL_UTIL_API MappedFileIStream : public std::istream
+        {
+
+          public:
+            /**
+             * \brief Constructs a \c %MappedFileIStream instance that is not associated with a file.
+             */
+            MappedFileIStream();
+
+            /**
+             * \brief Constructs a \c %MappedFileIStream instance that reads the contents of the file \a file_name.
+             * \param file_name The path of the file to read.
+             * \param mode The open mode (only checked for compatibility with \c std::ifstream).
+             */
+            explicit MappedFileIStream(const std::string& file_name, std::ios_base::openmode mode = std::ios_base::in | std::ios_base::binary);
+
+            /**
+             * \brief Memory-maps the file \a file_name and resets the stream state.
+             * \param file_name The path of the file to read.
+             * \param mode The open mode (only checked for compatibility with \c std::ifstream).
+             * \note If the file cannot be mapped, the \c failbit of the stream gets set.
+             */
+            void open(const std::string& file_name, std::ios_base::openmode mode = std::ios_base::in | std::ios_base::binary);
+
+            /**
+             * \brief Unmaps the currently read file.
+             */
+            void close();
+
+            /**
+             * \brief Tells whether a file is currently associated with the stream.
+             * \return \c true if a file is associated with the stream, and \c false otherwise.
+             */
+            bool is_open() const;
+
+            /**
+             * \brief Returns a pointer to the underlying stream buffer.
+             * \return A pointer to the underlying stream buffer.
+             */
+            MappedFileStreamBuffer* rdbuf() const;
+
+          private:
+            mutable MappedFileStreamBuffer streamBuf;
+        };
+    } // namespace Util
+} // namespace CDPL
+
+#endif // CDPL_UTIL_MAPPEDFILEISTREAM_HPP
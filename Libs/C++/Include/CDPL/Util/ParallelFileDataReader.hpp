@@ -0,0 +1,757 @@
+/*
+ * ParallelFileDataReader.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of class CDPL::Util::ParallelFileDataReader.
+ */
+
+#ifndef CDPL_UTIL_PARALLELFILEDATAREADER_HPP
+#define CDPL_UTIL_PARALLELFILEDATAREADER_HPP
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/stream.hpp>
+
+#include "CDPL/Base/DataReader.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+#include "CDPL/Util/FileFunctions.hpp"
+#include "CDPL/Util/RecordIndexFile.hpp"
+#include "CDPL/Util/ControlParameterFunctions.hpp"
+
+
+namespace CDPL
+{
+
+    namespace Util
+    {
+
+        /**
+         * \brief File-based Base::DataReader that is able to parse the data records of the input file in parallel.
+         *
+         * If the control-parameter Util::ControlParameter::NUM_READER_THREADS specifies a value greater than zero, the
+         * input file gets memory-mapped and the start positions of the data records are located by a parallel scan of
+         * equally sized chunks of the file data. The records are then parsed ahead of the actual read requests by the
+         * specified number of worker threads, each using a private instance of \a ReaderImpl, and are delivered in input order.
+         * Otherwise, or if the record boundaries cannot be determined for the current control-parameter settings, the
+         * reader behaves exactly like Util::FileDataReader. The mode of operation gets selected on first access of the data.
+         *
+         * If the control-parameter Util::ControlParameter::USE_RECORD_INDEX_FILES is set to \c true, the located record start positions
+         * get stored in the record index file <tt>\<file_name\>.ridx</tt>, which is shared with Util::FileDataReader. Existing index files
+         * are only used if they were written for the same file state and a reader of type \a ReaderImpl with the same record-affecting settings
+         * (see Util::StreamDataReader::getRecordLayoutID()).
+         *
+         * \a RecordBoundaryFinder has to provide the following member functions:
+         *
+         * \code bool init(const Base::ControlParameterContainer& params) \endcode
+         *   Prepares the scan for record boundaries and tells whether the boundaries can be determined for the control-parameter
+         *   settings provided by \a params.
+         *
+         * \code void operator()(const char* data, std::size_t size, std::size_t from, std::size_t to, std::vector<std::uint64_t>& rec_starts) const \endcode
+         *   Appends the start positions of all records of \a data following a record terminator that begins in the range
+         *   [\a from, \a to) to \a rec_starts (in ascending order). Will be called concurrently for disjoint ranges.
+         *
+         * \note Control-parameters must not be modified while data records are read in parallel mode.
+         *
+         * \tparam ReaderImpl The underlying stream-based reader implementation type (has to be derived from Util::StreamDataReader).
+         * \tparam RecordBoundaryFinder The type of the function object locating the record start positions.
+         * \tparam ObjectType The concrete type of the objects storing the parsed data records.
+         * \tparam DataType The data type read by \a ReaderImpl.
+         * \since 1.4
+         */
+        template <typename ReaderImpl, typename RecordBoundaryFinder, typename ObjectType, typename DataType = typename ReaderImpl::DataType>
+        class ParallelFileDataReader : public Base::DataReader<DataType>
+        {
+
+          public:
+            /**
+             * \brief Constructs a \c %ParallelFileDataReader instance that will read the data records of the file \a file_name.
+             * \param file_name The path of the input file to open.
+             * \param mode The open mode of the underlying \c std::ifstream.
+             * \throw Base::IOError if the file could not be opened.
+             */
+            ParallelFileDataReader(const std::string&      file_name,
+                                   std::ios_base::openmode mode = std::ios_base::in | std::ios_base::binary);
+
+            /**
+             * \brief Destructor.
+             *
+             * Terminates all running worker threads.
+             */
+            ~ParallelFileDataReader();
+
+            /**
+             * \brief Reads the next data record into \a obj.
+             * \param obj The output object.
+             * \param overwrite If \c true, the output object is cleared before the record data are copied into it.
+             * \return A reference to itself.
+             * \throw Base::IOError on read failure.
+             */
+            ParallelFileDataReader& read(DataType& obj, bool overwrite = true);
+
+            /**
+             * \brief Reads the data record at index \a idx into \a obj.
+             * \param idx The zero-based record index.
+             * \param obj The output object.
+             * \param overwrite If \c true, the output object is cleared before the record data are copied into it.
+             * \return A reference to itself.
+             * \throw Base::IOError on read failure, Base::IndexError if \a idx is out of bounds.
+             */
+            ParallelFileDataReader& read(std::size_t idx, DataType& obj, bool overwrite = true);
+
+            /**
+             * \brief Skips the next data record.
+             * \return A reference to itself.
+             * \throw Base::IOError on read failure.
+             */
+            ParallelFileDataReader& skip();
+
+            /**
+             * \brief Tells whether there are more data records to read.
+             * \return \c true if at least one more record is available, and \c false otherwise.
+             */
+            bool hasMoreData();
+
+            /**
+             * \brief Returns the index of the current data record.
+             * \return The zero-based index of the next record to read.
+             */
+            std::size_t getRecordIndex() const;
+
+            /**
+             * \brief Sets the index of the current data record to \a idx.
+             * \param idx The new zero-based record index.
+             * \throw Base::IndexError if \a idx is out of bounds.
+             */
+            void setRecordIndex(std::size_t idx);
+
+            /**
+             * \brief Returns the total number of available data records.
+             * \return The record count.
+             */
+            std::size_t getNumRecords();
+
+            /**
+             * \brief Tells whether the reader is in a good (readable) state.
+             * \return A non-\c nullptr pointer if the reader is in a good state, and \c nullptr otherwise.
+             */
+            operator const void*() const;
+
+            /**
+             * \brief Tells whether the reader is in a bad (non-readable) state.
+             * \return \c true if the reader is in a bad state, and \c false otherwise.
+             */
+            bool operator!() const;
+
+            /**
+             * \brief Terminates the worker threads and closes the input file.
+             */
+            void close();
+
+            /**
+             * \brief Tells whether the data records are parsed in parallel.
+             * \return \c true if the data records are parsed by worker threads, and \c false if they are read sequentially.
+             */
+            bool isParallelModeEnabled();
+
+          private:
+            ParallelFileDataReader(const ParallelFileDataReader&);
+
+            ParallelFileDataReader& operator=(const ParallelFileDataReader&);
+
+            typedef boost::iostreams::stream<boost::iostreams::array_source> MemoryStream;
+            typedef boost::iostreams::mapped_file_source                     MappedFile;
+            typedef std::unique_ptr<ObjectType>                              ObjectPtr;
+            typedef std::vector<std::uint64_t>                               RecordPositionArray;
+
+            struct Record
+            {
+
+                Record():
+                    done(false), valid(false) {}
+
+                ObjectPtr   object;
+                std::string error;
+                bool        done;
+                bool        valid;
+            };
+
+            struct Worker
+            {
+
+                Worker(const char* data, std::size_t size):
+                    stream(data, size), reader(stream) {}
+
+                MemoryStream stream;
+                ReaderImpl   reader;
+                std::thread  thread;
+            };
+
+            typedef std::unique_ptr<Worker> WorkerPtr;
+            typedef std::vector<WorkerPtr>  WorkerArray;
+            typedef std::deque<Record>      RecordQueue;
+            typedef std::vector<ObjectPtr>  ObjectArray;
+
+            void init();
+
+            void scanRecords(std::size_t num_threads);
+
+            void startWorkers(std::size_t num_threads);
+            void stopWorkers();
+
+            void processRecords(Worker& worker);
+
+            void fetchRecord(std::size_t idx, Record& rec);
+
+            void freeObject(ObjectPtr& obj);
+
+            static constexpr std::size_t BATCH_SIZE          = 16;
+            static constexpr std::size_t MAX_PENDING_BATCHES = 4;
+            static constexpr std::size_t MIN_SCAN_CHUNK_SIZE = 4 * 1024 * 1024;
+
+            std::ifstream           stream;
+            std::string             fileName;
+            ReaderImpl              reader;
+            RecordBoundaryFinder    boundaryFinder;
+            MappedFile              mappedFile;
+            RecordPositionArray     recordPositions;
+            bool                    initialized;
+            bool                    parallel;
+            bool                    state;
+            std::size_t             recordIndex;
+            WorkerArray             workers;
+            std::mutex              mutex;
+            std::condition_variable jobCondition;
+            std::condition_variable resultCondition;
+            RecordQueue             pendingRecords;
+            ObjectArray             freeObjects;
+            std::size_t             firstPendingIndex;
+            std::size_t             nextJobIndex;
+            std::size_t             maxNumPending;
+            std::size_t             generation;
+            bool                    stopRequested;
+        };
+    } // namespace Util
+} // namespace CDPL
+
+
+// Implementation
+
+template <typename ReaderImpl, typename RecordBoundaryFinder, typename ObjectType, typename DataType>
+CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>::ParallelFileDataReader(const std::string& file_name, std::ios_base::openmode mode):
+    stream(file_name.c_str(), mode), fileName(file_name), reader(stream), initialized(false), parallel(false), state(true),
+    recordIndex(0), firstPendingIndex(0), nextJobIndex(0), maxNumPending(0), generation(0), stopRequested(false)
+{
+    if (!stream.good())
+        throw Base::IOError("ParallelFileDataReader: could not open file");
+
+    reader.setParent(this);
+    reader.registerIOCallback(std::bind(&Base::DataIOBase::invokeIOCallbacks, this, std::placeholders::_2));
+    reader.setRecordIndexFile(file_name + ".ridx", calcFileStamp(file_name));
+}
+
+template <typename ReaderImpl, typename RecordBoundaryFinder, typename ObjectType, typename DataType>
+CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>::~ParallelFileDataReader()
+{
+    stopWorkers();
+}
+
+template <typename ReaderImpl, typename RecordBoundaryFinder, typename ObjectType, typename DataType>
+CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>&
+CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>::read(DataType& obj, bool overwrite)
+{
+    init();
+
+    if (!parallel) {
+        try {
+            reader.read(obj, overwrite);
+
+        } catch (const std::exception& e) {
+            throw Base::IOError("ParallelFileDataReader: while reading file '" + fileName + "': " + e.what());
+        }
+
+        return *this;
+    }
+
+    state = false;
+
+    if (recordIndex >= recordPositions.size())
+        return *this;
+
+    if (!overwrite) {
+        // appending reads depend on the current state of obj and are thus not done in advance
+
+        try {
+            reader.seekRecord(recordIndex, std::istream::pos_type(std::streamoff(recordPositions[recordIndex])));
+
+            if ((state = static_cast<bool>(reader.read(obj, false))))
+                recordIndex++;
+
+        } catch (const std::exception& e) {
+            throw Base::IOError("ParallelFileDataReader: while reading file '" + fileName + "': " + e.what());
+        }
+
+        return *this;
+    }
+
+    Record rec;
+
+    fetchRecord(recordIndex, rec);
+
+    if (!rec.error.empty()) {
+        freeObject(rec.object);
+
+        throw Base::IOError("ParallelFileDataReader: while reading file '" + fileName + "': " + rec.error);
+    }
+
+    if (!rec.valid) {
+        freeObject(rec.object);
+        return *this;
+    }
+
+    obj = static_cast<const DataType&>(*rec.object);
+
+    freeObject(rec.object);
+
+    recordIndex++;
+    state = true;
+
+    this->invokeIOCallbacks(1.0);
+
+    return *this;
+}
+
+template <typename ReaderImpl, typename RecordBoundaryFinder, typename ObjectType, typename DataType>
+CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>&
+CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>::read(std::size_t idx, DataType& obj, bool overwrite)
+{
+    init();
+
+    if (!parallel) {
+        try {
+            reader.read(idx, obj, overwrite);
+
+        } catch (const std::exception& e) {
+            throw Base::IOError("ParallelFileDataReader: while reading file '" + fileName + "': " + e.what());
+        }
+
+        return *this;
+    }
+
+    state = false;
+
+    if (idx >= recordPositions.size())
+        throw Base::IndexError("ParallelFileDataReader: record index out of bounds");
+
+    recordIndex = idx;
+
+    return read(obj, overwrite);
+}
+
+template <typename ReaderImpl, typename RecordBoundaryFinder, typename ObjectType, typename DataType>
+CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>&
+CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>::skip()
+{
+    init();
+
+    if (!parallel) {
+        try {
+            reader.skip();
+
+        } catch (const std::exception& e) {
+            throw Base::IOError("ParallelFileDataReader: while reading file '" + fileName + "': " + e.what());
+        }
+
+        return *this;
+    }
+
+    state = false;
+
+    if (recordIndex >= recordPositions.size())
+        return *this;
+
+    recordIndex++;
+    state = true;
+
+    this->invokeIOCallbacks(1.0);
+
+    return *this;
+}
+
+template <typename ReaderImpl, typename RecordBoundaryFinder, typename ObjectType, typename DataType>
+bool CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>::hasMoreData()
+{
+    init();
+
+    if (!parallel)
+        return reader.hasMoreData();
+
+    return (recordIndex < recordPositions.size());
+}
+
+template <typename ReaderImpl, typename RecordBoundaryFinder, typename ObjectType, typename DataType>
+std::size_t CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>::getRecordIndex() const
+{
+    if (!parallel)
+        return reader.getRecordIndex();
+
+    return recordIndex;
+}
+
+template <typename ReaderImpl, typename RecordBoundaryFinder, typename ObjectType, typename DataType>
+void CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>::setRecordIndex(std::size_t idx)
+{
+    init();
+
+    if (!parallel) {
+        reader.setRecordIndex(idx);
+        return;
+    }
+
+    if (idx > recordPositions.size())
+        throw Base::IndexError("ParallelFileDataReader: record index out of bounds");
+
+    recordIndex = idx;
+}
+
+template <typename ReaderImpl, typename RecordBoundaryFinder, typename ObjectType, typename DataType>
+std::size_t CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>::getNumRecords()
+{
+    init();
+
+    if (!parallel)
+        return reader.getNumRecords();
+
+    return recordPositions.size();
+}
+
+template <typename ReaderImpl, typename RecordBoundaryFinder, typename ObjectType, typename DataType>
+CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>::operator const void*() const
+{
+    if (!parallel)
+        return reader.operator const void*();
+
+    return (state ? this : 0);
+}
+
+template <typename ReaderImpl, typename RecordBoundaryFinder, typename ObjectType, typename DataType>
+bool CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>::operator!() const
+{
+    if (!parallel)
+        return reader.operator!();
+
+    return !state;
+}
+
+template <typename ReaderImpl, typename RecordBoundaryFinder, typename ObjectType, typename DataType>
+void CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>::close()
+{
+    stopWorkers();
+
+    if (parallel) {
+        recordPositions.clear();
+        mappedFile.close();
+
+        recordIndex = 0;
+        state       = false;
+    }
+
+    initialized = true;
+
+    reader.close();
+    stream.close();
+}
+
+template <typename ReaderImpl, typename RecordBoundaryFinder, typename ObjectType, typename DataType>
+bool CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>::isParallelModeEnabled()
+{
+    init();
+
+    return parallel;
+}
+
+template <typename ReaderImpl, typename RecordBoundaryFinder, typename ObjectType, typename DataType>
+void CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>::init()
+{
+    if (initialized)
+        return;
+
+    initialized = true;
+
+    std::size_t num_threads = getNumReaderThreadsParameter(*this);
+
+    if (num_threads == 0 || !boundaryFinder.init(*this))
+        return;
+
+    try {
+        mappedFile.open(fileName);
+
+    } catch (const std::exception&) {
+        return;
+    }
+
+    if (!mappedFile.is_open())
+        return;
+
+    scanRecords(num_threads);
+    startWorkers(num_threads);
+
+    parallel = true;
+}
+
+template <typename ReaderImpl, typename RecordBoundaryFinder, typename ObjectType, typename DataType>
+void CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>::scanRecords(std::size_t num_threads)
+{
+    const char* data = mappedFile.data();
+    std::size_t size = mappedFile.size();
+
+    std::uint64_t src_stamp    = calcFileStamp(fileName);
+    bool          use_idx_file = (src_stamp != 0 && getUseRecordIndexFilesParameter(*this));
+
+    if (use_idx_file) {
+        RecordIndexFile idx_file;
+
+        if (idx_file.open(fileName + ".ridx", src_stamp, 0, reader.getRecordLayoutID())) {
+            recordPositions.resize(idx_file.getNumRecords());
+
+            for (std::size_t i = 0, num_recs = recordPositions.size(); i < num_recs; i++)
+                recordPositions[i] = idx_file.getRecordPosition(i);
+
+            this->invokeIOCallbacks(1.0);
+            return;
+        }
+    }
+
+    std::size_t num_chunks = std::max(std::size_t(1), std::min(num_threads, size / MIN_SCAN_CHUNK_SIZE));
+    std::vector<RecordPositionArray> chunk_rec_starts(num_chunks);
+    std::vector<std::thread> threads;
+
+    auto scan_chunk = [&, data, size, num_chunks](std::size_t chunk_idx) {
+        boundaryFinder(data, size, chunk_idx * size / num_chunks, (chunk_idx + 1) * size / num_chunks, chunk_rec_starts[chunk_idx]);
+    };
+
+    for (std::size_t i = 1; i < num_chunks; i++)
+        threads.emplace_back(scan_chunk, i);
+
+    scan_chunk(0);
+
+    for (auto& thread : threads)
+        thread.join();
+
+    recordPositions.clear();
+
+    if (size > 0)
+        recordPositions.push_back(0);
+
+    for (const auto& rec_starts : chunk_rec_starts)
+        for (auto pos : rec_starts)
+            if (pos < size)
+                recordPositions.push_back(pos);
+
+    this->invokeIOCallbacks(1.0);
+
+    if (use_idx_file)
+        RecordIndexFile::write(fileName + ".ridx", src_stamp, 0, recordPositions.data(), recordPositions.size(), reader.getRecordLayoutID());
+}
+
+template <typename ReaderImpl, typename RecordBoundaryFinder, typename ObjectType, typename DataType>
+void CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>::startWorkers(std::size_t num_threads)
+{
+    maxNumPending = num_threads * BATCH_SIZE * MAX_PENDING_BATCHES;
+
+    for (std::size_t i = 0; i < num_threads; i++) {
+        workers.emplace_back(new Worker(mappedFile.data(), mappedFile.size()));
+
+        workers.back()->reader.setParent(this);
+    }
+
+    for (auto& worker : workers)
+        worker->thread = std::thread(&ParallelFileDataReader::processRecords, this, std::ref(*worker));
+}
+
+template <typename ReaderImpl, typename RecordBoundaryFinder, typename ObjectType, typename DataType>
+void CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        stopRequested = true;
+    }
+
+    jobCondition.notify_all();
+
+    for (auto& worker : workers)
+        if (worker->thread.joinable())
+            worker->thread.join();
+
+    workers.clear();
+    pendingRecords.clear();
+    freeObjects.clear();
+}
+
+template <typename ReaderImpl, typename RecordBoundaryFinder, typename ObjectType, typename DataType>
+void CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>::processRecords(Worker& worker)
+{
+    ObjectArray              objects;
+    std::vector<std::string> errors;
+    std::vector<char>        valid;
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true) {
+        jobCondition.wait(lock, [this]() {
+            return (stopRequested || (nextJobIndex < recordPositions.size() && (nextJobIndex - firstPendingIndex) < maxNumPending));
+        });
+
+        if (stopRequested)
+            return;
+
+        std::size_t first_idx = nextJobIndex;
+        std::size_t num_recs  = std::min(std::min(BATCH_SIZE, recordPositions.size() - first_idx),
+                                         maxNumPending - (first_idx - firstPendingIndex));
+        std::size_t job_gen   = generation;
+
+        nextJobIndex += num_recs;
+        pendingRecords.resize(pendingRecords.size() + num_recs);
+
+        objects.resize(num_recs);
+        errors.resize(num_recs);
+        valid.resize(num_recs);
+
+        for (std::size_t i = 0; i < num_recs; i++) {
+            if (freeObjects.empty())
+                continue;
+
+            objects[i] = std::move(freeObjects.back());
+            freeObjects.pop_back();
+        }
+
+        lock.unlock();
+
+        for (std::size_t i = 0; i < num_recs; i++) {
+            if (!objects[i])
+                objects[i].reset(new ObjectType());
+
+            errors[i].clear();
+            valid[i] = false;
+
+            try {
+                worker.reader.seekRecord(first_idx + i, std::istream::pos_type(std::streamoff(recordPositions[first_idx + i])));
+
+                valid[i] = static_cast<bool>(worker.reader.read(*objects[i]));
+
+            } catch (const std::exception& e) {
+                errors[i] = e.what();
+
+            } catch (...) {
+                errors[i] = "unspecified error";
+            }
+        }
+
+        lock.lock();
+
+        for (std::size_t i = 0; i < num_recs; i++) {
+            std::size_t rec_idx = first_idx + i;
+
+            if (job_gen != generation || rec_idx < firstPendingIndex) {
+                freeObjects.push_back(std::move(objects[i]));
+                continue;
+            }
+
+            Record& rec = pendingRecords[rec_idx - firstPendingIndex];
+
+            rec.object = std::move(objects[i]);
+            rec.valid  = valid[i];
+            rec.done   = true;
+
+            rec.error.swap(errors[i]);
+        }
+
+        resultCondition.notify_all();
+    }
+}
+
+template <typename ReaderImpl, typename RecordBoundaryFinder, typename ObjectType, typename DataType>
+void CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>::fetchRecord(std::size_t idx, Record& rec)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    if (idx < firstPendingIndex || idx > nextJobIndex) {
+        for (auto& pending_rec : pendingRecords)
+            if (pending_rec.object)
+                freeObjects.push_back(std::move(pending_rec.object));
+
+        pendingRecords.clear();
+
+        firstPendingIndex = idx;
+        nextJobIndex      = idx;
+        generation++;
+
+    } else {
+        for ( ; firstPendingIndex < idx; firstPendingIndex++) {
+            if (pendingRecords.front().object)
+                freeObjects.push_back(std::move(pendingRecords.front().object));
+
+            pendingRecords.pop_front();
+        }
+    }
+
+    jobCondition.notify_all();
+
+    resultCondition.wait(lock, [this]() { return (!pendingRecords.empty() && pendingRecords.front().done); });
+
+    rec = std::move(pendingRecords.front());
+
+    pendingRecords.pop_front();
+    firstPendingIndex++;
+
+    lock.unlock();
+
+    jobCondition.notify_all();
+}
+
+template <typename ReaderImpl, typename RecordBoundaryFinder, typename ObjectType, typename DataType>
+void CDPL::Util::ParallelFileDataReader<ReaderImpl, RecordBoundaryFinder, ObjectType, DataType>::freeObject(ObjectPtr& obj)
+{
+    if (!obj)
+        return;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    freeObjects.push_back(std::move(obj));
+}
+
+#endif // CDPL_UTIL_PARALLELFILEDATAREADER_HPP
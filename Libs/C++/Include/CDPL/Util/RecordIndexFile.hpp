@@ -0,0 +1,147 @@
+/* 
+ * RecordIndexFile.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of class CDPL::Util::RecordIndexFile.
+ */
+
+#ifndef CDPL_UTIL_RECORDINDEXFILE_HPP
+#define CDPL_UTIL_RECORDINDEXFILE_HPP
+
+#include <string>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+#include "CDPL/Util/APIPrefix.hpp"
+
+
+namespace boost
+{
+
+    namespace iostreams
+    {
+
+        class mapped_file_source;
+    }
+} // namespace boost
+
+
+namespace CDPL
+{
+
+    namespace Util
+    {
+
+        /**
+         * \brief Provides read access to memory-mapped files storing the stream positions of the data records of an input file.
+         *
+         * A record index file stores the stream positions of the data records found by a scan of an input data stream
+         * (see Util::StreamDataReader) together with a stamp of the input file state (see Util::calcFileStamp()), an identifier
+         * of the reader type and the reader settings that determine the record boundaries (see Util::StreamDataReader::getRecordLayoutID())
+         * and the initial stream position. Index files are only considered valid if all three values match the ones specified on opening.
+         *
+         * \since 1.4
+         */
+        class CDPL_UTIL_API RecordIndexFile
+        {
+
+          public:
+            /**
+             * \brief Constructs a \c %RecordIndexFile instance that is not associated with a file.
+             */
+            RecordIndexFile();
+
+            /**
+             * \brief Destructor.
+             */
+            ~RecordIndexFile();
+
+            /**
+             * \brief Memory-maps the record index file \a path and checks whether it matches the specified data source state.
+             * \param path The path of the record index file.
+             * \param src_stamp The stamp of the data source the index file has to belong to.
+             * \param start_pos The stream position at which the record scan has to have started.
+             * \param layout_id The identifier of the record layout the stored positions have to refer to.
+             * \return \c true if the file could be opened and is valid, and \c false otherwise.
+             */
+            bool open(const std::string& path, std::uint64_t src_stamp, std::uint64_t start_pos, std::uint64_t layout_id = 0);
+
+            /**
+             * \brief Unmaps the currently opened record index file.
+             */
+            void close();
+
+            /**
+             * \brief Tells whether a valid record index file is currently opened.
+             * \return \c true if a file is opened, and \c false otherwise.
+             */
+            bool isOpen() const;
+
+            /**
+             * \brief Returns the number of record stream positions stored in the opened file.
+             * \return The number of stored record positions.
+             */
+            std::size_t getNumRecords() const;
+
+            /**
+             * \brief Returns the stream position of the data record with index \a idx.
+             * \param idx The zero-based record index.
+             * \return The stream position of the specified record.
+             */
+            std::uint64_t getRecordPosition(std::size_t idx) const;
+
+            /**
+             * \brief Writes a record index file.
+             *
+             * The data get written to a temporary file in the directory of \a path that is renamed to \a path
+             * after all data have been written. Concurrent processes will thus never see incomplete files.
+             *
+             * \param path The path of the record index file.
+             * \param src_stamp The stamp of the data source the record positions refer to.
+             * \param start_pos The stream position at which the record scan started.
+             * \param positions A pointer to the array of record stream positions.
+             * \param num_records The number of record stream positions.
+             * \param layout_id The identifier of the record layout the record positions refer to.
+             * \return \c true if the file was written successfully, and \c false otherwise.
+             */
+            static bool write(const std::string& path, std::uint64_t src_stamp, std::uint64_t start_pos,
+                              const std::uint64_t* positions, std::size_t num_records, std::uint64_t layout_id = 0);
+
+          private:
+            RecordIndexFile(const RecordIndexFile&);
+
+            RecordIndexFile& operator=(const RecordIndexFile&);
+
+            typedef boost::iostreams::mapped_file_source MappedFile;
+            typedef std::unique_ptr<MappedFile>          MappedFilePtr;
+
+            MappedFilePtr        mappedFile;
+            const std::uint64_t* positions;
+            std::size_t          numRecords;
+        };
+    } // namespace Util
+} // namespace CDPL
+
+#endif // CDPL_UTIL_RECORDINDEXFILE_HPP
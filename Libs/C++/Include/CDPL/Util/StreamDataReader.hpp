@@ -31,9 +31,14 @@
 
 #include <istream>
 #include <vector>
+#include <string>
+#include <cstdint>
+#include <typeinfo>
 
 #include "CDPL/Base/DataReader.hpp"
 #include "CDPL/Base/Exceptions.hpp"
+#include "CDPL/Util/RecordIndexFile.hpp"
+#include "CDPL/Util/ControlParameterFunctions.hpp"
 
 
 namespace CDPL
@@ -65,6 +70,12 @@ namespace CDPL
          *   Tells if more data records are available to read. Returns \c true if data records are available,
          *   and \c false otherwise.
          *
+         * The stream positions of the data records determined by a scan of the input stream can optionally be
+         * stored in a record index file which, on subsequent reads of the same data, makes the scan unnecessary
+         * (see setRecordIndexFile() and Util::ControlParameter::USE_RECORD_INDEX_FILES). Readers whose record boundaries depend on
+         * control-parameter settings have to override getRecordLayoutSettings() so that index files created with different
+         * settings do not get used.
+         *
          * \tparam DataType The type of the objects holding the read data.
          * \tparam ReaderImpl The type of the subclass implementing the basic input operations.
          */
@@ -134,19 +145,77 @@ namespace CDPL
              */
             bool operator!() const;
 
+            /**
+             * \brief Specifies a file for the persistent storage of the record stream positions.
+             *
+             * If the control-parameter Util::ControlParameter::USE_RECORD_INDEX_FILES is set to \c true, the record
+             * stream positions will be loaded from the file \a path instead of being determined by a scan of the input
+             * stream. If the file does not exist or does not match \a src_stamp, the input stream gets scanned and the
+             * obtained record positions are written to \a path.
+             *
+             * \param path The path of the record index file (an empty string disables the use of an index file).
+             * \param src_stamp A value identifying the state of the data source (see Util::calcFileStamp()). A
+             *                  value of \e 0 disables the use of an index file.
+             * \since 1.4
+             */
+            void setRecordIndexFile(const std::string& path, std::uint64_t src_stamp);
+
+            /**
+             * \brief Moves the input stream to the data record with index \a idx which is known to start at the stream position \a pos.
+             *
+             * Other than setRecordIndex(), the method does not require the input stream to be scanned for the positions of the
+             * data records. It is the responsibility of the caller to ensure that \a pos is the correct start position of the record.
+             *
+             * \param idx The zero-based index of the data record.
+             * \param pos The stream position at which the data record starts.
+             * \since 1.4
+             */
+            void seekRecord(std::size_t idx, std::istream::pos_type pos);
+
+            /**
+             * \brief Returns a value identifying the reader type and the reader settings that determine the partitioning of the
+             *        input data into records.
+             *
+             * The value gets stored in written record index files. Index files storing a different value are not used.
+             *
+             * \return The record layout identifier.
+             * \see getRecordLayoutSettings()
+             * \since 1.4
+             */
+            std::uint64_t getRecordLayoutID() const;
+
           protected:
             /**
              * \brief Constructs a \c %StreamDataReader instance that will read from the input stream \a is.
              * \param is The input stream to read from.
              */
             StreamDataReader(std::istream& is):
-                input(is), recordIndex(0), initStreamPos(is.tellg()), state(is.good()), streamScanned(false) {}
+                input(is), recordIndex(0), initStreamPos(is.tellg()), state(is.good()), streamScanned(false), indexFileSrcStamp(0) {}
+
+            /**
+             * \brief Returns a textual description of the current reader settings that affect the partitioning of the input data into records.
+             *
+             * The default implementation returns an empty string and has to be overridden by readers whose record boundaries
+             * depend on control-parameter settings (e.g. Chem::ControlParameter::MULTI_CONF_IMPORT).
+             *
+             * \return The description of the record-affecting reader settings.
+             * \see getRecordLayoutID()
+             * \since 1.4
+             */
+            virtual std::string getRecordLayoutSettings() const;
 
           private:
             StreamDataReader(const StreamDataReader& reader);
 
             void scanDataStream();
 
+            bool loadRecordIndexFile();
+            void saveRecordIndexFile() const;
+
+            std::size_t getNumRecordPositions() const;
+
+            std::istream::pos_type getRecordPosition(std::size_t idx) const;
+
             typedef std::vector<std::istream::pos_type> RecordStreamPosTable;
 
             std::istream&          input;
@@ -155,6 +224,9 @@ namespace CDPL
             bool                   state;
             bool                   streamScanned;
             RecordStreamPosTable   recordPositions;
+            std::string            indexFilePath;
+            std::uint64_t          indexFileSrcStamp;
+            RecordIndexFile        indexFile;
         };
     } // namespace Util
 } // namespace CDPL
@@ -184,11 +256,11 @@ CDPL::Util::StreamDataReader<DataType, ReaderImpl>::read(std::size_t idx, DataTy
 
     scanDataStream();
 
-    if (idx >= recordPositions.size())
+    if (idx >= getNumRecordPositions())
         throw Base::IndexError("StreamDataReader: record index out of bounds");
 
     input.clear();
-    input.seekg(recordPositions[idx]);
+    input.seekg(getRecordPosition(idx));
 
     recordIndex = idx;
 
@@ -231,15 +303,17 @@ void CDPL::Util::StreamDataReader<DataType, ReaderImpl>::setRecordIndex(std::siz
 {
     scanDataStream();
 
-    if (idx > recordPositions.size())
+    std::size_t num_recs = getNumRecordPositions();
+
+    if (idx > num_recs)
         throw Base::IndexError("StreamDataReader: record index out of bounds");
 
     input.clear();
     
-    if (idx == recordPositions.size())
+    if (idx == num_recs)
         input.seekg(0, std::ios_base::end);
     else
-        input.seekg(recordPositions[idx]);
+        input.seekg(getRecordPosition(idx));
 
     recordIndex = idx;
 }
@@ -249,7 +323,7 @@ std::size_t CDPL::Util::StreamDataReader<DataType, ReaderImpl>::getNumRecords()
 {
     scanDataStream();
 
-    return recordPositions.size();
+    return getNumRecordPositions();
 }
 
 template <typename DataType, typename ReaderImpl>
@@ -264,6 +338,48 @@ bool CDPL::Util::StreamDataReader<DataType, ReaderImpl>::operator!() const
     return !state;
 }
 
+template <typename DataType, typename ReaderImpl>
+void CDPL::Util::StreamDataReader<DataType, ReaderImpl>::setRecordIndexFile(const std::string& path, std::uint64_t src_stamp)
+{
+    indexFilePath     = path;
+    indexFileSrcStamp = src_stamp;
+}
+
+template <typename DataType, typename ReaderImpl>
+void CDPL::Util::StreamDataReader<DataType, ReaderImpl>::seekRecord(std::size_t idx, std::istream::pos_type pos)
+{
+    input.clear();
+    input.seekg(pos);
+
+    recordIndex = idx;
+}
+
+template <typename DataType, typename ReaderImpl>
+std::uint64_t CDPL::Util::StreamDataReader<DataType, ReaderImpl>::getRecordLayoutID() const
+{
+    std::string layout = typeid(ReaderImpl).name();
+
+    layout.push_back('\0');
+    layout.append(getRecordLayoutSettings());
+
+    // FNV-1a hash of the reader type name and settings
+
+    std::uint64_t id = 14695981039346656037ULL;
+
+    for (char c : layout) {
+        id ^= std::uint8_t(c);
+        id *= 1099511628211ULL;
+    }
+
+    return id;
+}
+
+template <typename DataType, typename ReaderImpl>
+std::string CDPL::Util::StreamDataReader<DataType, ReaderImpl>::getRecordLayoutSettings() const
+{
+    return std::string();
+}
+
 template <typename DataType, typename ReaderImpl>
 void CDPL::Util::StreamDataReader<DataType, ReaderImpl>::scanDataStream()
 {
@@ -272,6 +388,11 @@ void CDPL::Util::StreamDataReader<DataType, ReaderImpl>::scanDataStream()
 
     streamScanned = true;
 
+    if (loadRecordIndexFile()) {
+        this->invokeIOCallbacks(1.0);
+        return;
+    }
+
     std::size_t saved_rec_index = recordIndex;
 
     recordIndex = 0;
@@ -283,12 +404,16 @@ void CDPL::Util::StreamDataReader<DataType, ReaderImpl>::scanDataStream()
 
     input.seekg(initStreamPos);
 
+    bool complete = true;
+
     while (hasMoreData()) {
         std::istream::pos_type record_pos = input.tellg();
         state                             = false;
 
-        if (!(state = static_cast<ReaderImpl*>(this)->skipData(input)))
+        if (!(state = static_cast<ReaderImpl*>(this)->skipData(input))) {
+            complete = false;
             break;
+        }
 
         recordPositions.push_back(record_pos);
         recordIndex++;
@@ -298,6 +423,9 @@ void CDPL::Util::StreamDataReader<DataType, ReaderImpl>::scanDataStream()
 
     this->invokeIOCallbacks(1.0);
 
+    if (complete)
+        saveRecordIndexFile();
+
     if (saved_rec_index < recordPositions.size()) {
         recordIndex = saved_rec_index;
 
@@ -306,4 +434,54 @@ void CDPL::Util::StreamDataReader<DataType, ReaderImpl>::scanDataStream()
     }
 }
 
+template <typename DataType, typename ReaderImpl>
+bool CDPL::Util::StreamDataReader<DataType, ReaderImpl>::loadRecordIndexFile()
+{
+    if (indexFilePath.empty() || indexFileSrcStamp == 0 || initStreamPos == std::istream::pos_type(-1))
+        return false;
+
+    if (!getUseRecordIndexFilesParameter(*this))
+        return false;
+
+    return indexFile.open(indexFilePath, indexFileSrcStamp, std::uint64_t(std::streamoff(initStreamPos)), getRecordLayoutID());
+}
+
+template <typename DataType, typename ReaderImpl>
+void CDPL::Util::StreamDataReader<DataType, ReaderImpl>::saveRecordIndexFile() const
+{
+    if (indexFilePath.empty() || indexFileSrcStamp == 0 || initStreamPos == std::istream::pos_type(-1))
+        return;
+
+    if (!getUseRecordIndexFilesParameter(*this))
+        return;
+
+    std::vector<std::uint64_t> positions;
+
+    positions.reserve(recordPositions.size());
+
+    for (const auto& pos : recordPositions)
+        positions.push_back(std::streamoff(pos));
+
+    RecordIndexFile::write(indexFilePath, indexFileSrcStamp, std::uint64_t(std::streamoff(initStreamPos)),
+                           positions.data(), positions.size(), getRecordLayoutID());
+}
+
+template <typename DataType, typename ReaderImpl>
+std::size_t CDPL::Util::StreamDataReader<DataType, ReaderImpl>::getNumRecordPositions() const
+{
+    if (indexFile.isOpen())
+        return indexFile.getNumRecords();
+
+    return recordPositions.size();
+}
+
+template <typename DataType, typename ReaderImpl>
+std::istream::pos_type CDPL::Util::StreamDataReader<DataType, ReaderImpl>::getRecordPosition(std::size_t idx) const
+{
+    if (indexFile.isOpen())
+        return std::istream::pos_type(std::streamoff(indexFile.getRecordPosition(idx)));
+
+    return recordPositions[idx];
+}
+
 #endif // CDPL_UTIL_STREAMDATAREADER_HPP
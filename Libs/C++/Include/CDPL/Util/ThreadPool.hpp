@@ -0,0 +1,130 @@
+/* 
+ * ThreadPool.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of class CDPL::Util::ThreadPool.
+ */
+
+#ifndef CDPL_UTIL_THREADPOOL_HPP
+#define CDPL_UTIL_THREADPOOL_HPP
+
+#include <cstddef>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "CDPL/Util/APIPrefix.hpp"
+
+
+namespace CDPL
+{
+
+    namespace Util
+    {
+
+        /**
+         * \brief A fixed-size set of persistent threads that execute tasks on demand.
+         *
+         * Tasks are never queued: a task submitted via tryExecute() either gets started immediately by an idle
+         * thread or is rejected. Components that share a thread pool can therefore use spare threads without ever
+         * having to wait for each other and the total number of threads never exceeds the size of the pool (plus
+         * the threads the tasks get submitted from).
+         *
+         * \since 1.4
+         */
+        class CDPL_UTIL_API ThreadPool
+        {
+
+          public:
+            /**
+             * \brief A reference-counted smart pointer [\ref SHPTR] for dynamically allocated \c %ThreadPool instances.
+             */
+            typedef std::shared_ptr<ThreadPool> SharedPointer;
+
+            /**
+             * \brief The type of the executed tasks.
+             */
+            typedef std::function<void()> Task;
+
+            /**
+             * \brief Constructs a \c %ThreadPool instance that starts \a num_threads threads.
+             * \param num_threads The number of threads.
+             */
+            explicit ThreadPool(std::size_t num_threads);
+
+            ThreadPool(const ThreadPool& pool) = delete;
+
+            /**
+             * \brief Waits for all running tasks to finish and terminates the threads.
+             */
+            ~ThreadPool();
+
+            ThreadPool& operator=(const ThreadPool& pool) = delete;
+
+            /**
+             * \brief Returns the number of threads.
+             * \return The number of threads.
+             */
+            std::size_t getNumThreads() const;
+
+            /**
+             * \brief Returns the number of threads that currently do not execute a task.
+             * \return The number of idle threads.
+             */
+            std::size_t getNumIdleThreads() const;
+
+            /**
+             * \brief Executes \a task on an idle thread.
+             * \param task The task to execute.
+             * \return \c true if an idle thread has been found and \a task got started, and \c false otherwise.
+             * \note Exceptions thrown by \a task are ignored and thus have to be handled by the task itself.
+             */
+            bool tryExecute(const Task& task);
+
+            /**
+             * \brief Waits until all started tasks have finished.
+             */
+            void wait();
+
+          private:
+            void runThread();
+
+            typedef std::vector<std::thread> ThreadList;
+            typedef std::vector<Task>        TaskList;
+
+            ThreadList              threads;
+            TaskList                pendingTasks;
+            std::size_t             numIdleThreads;
+            bool                    terminate;
+            mutable std::mutex      mutex;
+            std::condition_variable taskCondition;
+            std::condition_variable idleCondition;
+        };
+    } // namespace Util
+} // namespace CDPL
+
+#endif // CDPL_UTIL_THREADPOOL_HPP
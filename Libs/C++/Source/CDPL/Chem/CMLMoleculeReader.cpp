@@ -26,6 +26,7 @@
 
 #include "CDPL/Chem/CMLMoleculeReader.hpp"
 #include "CDPL/Chem/Molecule.hpp"
+#include "CDPL/Chem/ControlParameterFunctions.hpp"
 #include "CDPL/Base/Exceptions.hpp"
 
 #include "CMLDataReader.hpp"
@@ -68,3 +69,10 @@ bool Chem::CMLMoleculeReader::moreData(std::istream& is)
 {
     return reader->hasMoreData(is);
 }
+
+std::string Chem::CMLMoleculeReader::getRecordLayoutSettings() const
+{
+    // consecutive records get merged if multi-conformer import is enabled
+
+    return (getMultiConfImportParameter(*this) ? "multi-conf" : "");
+}
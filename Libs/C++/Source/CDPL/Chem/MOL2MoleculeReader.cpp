@@ -26,6 +26,7 @@
 
 #include "CDPL/Chem/MOL2MoleculeReader.hpp"
 #include "CDPL/Chem/Molecule.hpp"
+#include "CDPL/Chem/ControlParameterFunctions.hpp"
 #include "CDPL/Base/Exceptions.hpp"
 
 #include "MOL2DataReader.hpp"
@@ -68,3 +69,10 @@ bool Chem::MOL2MoleculeReader::moreData(std::istream& is)
 {
     return reader->hasMoreData(is);
 }
+
+std::string Chem::MOL2MoleculeReader::getRecordLayoutSettings() const
+{
+    // consecutive records get merged if multi-conformer import is enabled
+
+    return (getMultiConfImportParameter(*this) ? "multi-conf" : "");
+}
@@ -28,7 +28,9 @@
 
 #include "CDPL/Chem/MultiSubstructureSearch.hpp"
 #include "CDPL/Chem/SubstructureSearch.hpp"
+#include "CDPL/Chem/SubstructureScreeningKeyGenerator.hpp"
 #include "CDPL/Base/Exceptions.hpp"
+#include "CDPL/Internal/SubstructureQueryState.hpp"
 
 
 using namespace CDPL;
@@ -46,6 +48,18 @@ enum Chem::MultiSubstructureSearch::Token : int
     SSID
 };
 
+namespace
+{
+
+    enum ScreeningResult
+    {
+
+        NO_MATCH,
+        MATCH,
+        UNKNOWN
+    };
+}
+
 class Chem::MultiSubstructureSearch::ExprTreeNode
 {
 
@@ -63,6 +77,8 @@ class Chem::MultiSubstructureSearch::ExprTreeNode
         switch (token) {
 
             case SSID:
+                checkQueryState();
+
                 if (!subSearch)
                     subSearch.reset(new SubstructureSearch(*queryMolgraph));
 
@@ -84,16 +100,138 @@ class Chem::MultiSubstructureSearch::ExprTreeNode
                 return false;
         }
     }
-    
+
+    bool matches(const MolecularGraph& molgraph, const Util::BitSet& tgt_keys) {
+        switch (token) {
+
+            case SSID:
+                checkQueryState();
+
+                if (!queryKeysMatch(tgt_keys))
+                    return false;
+
+                if (!subSearch)
+                    subSearch.reset(new SubstructureSearch(*queryMolgraph));
+
+                return subSearch->mappingExists(molgraph);
+                
+            case OR:
+                return (child1->matches(molgraph, tgt_keys) || child2->matches(molgraph, tgt_keys));
+                
+            case XOR:
+                return (child1->matches(molgraph, tgt_keys) != child2->matches(molgraph, tgt_keys));
+                
+            case AND:
+                return (child1->matches(molgraph, tgt_keys) && child2->matches(molgraph, tgt_keys));
+                 
+            case NOT:
+                return !child1->matches(molgraph, tgt_keys);
+                
+            default:
+                return false;
+        }
+    }
+
+    ScreeningResult screen(const Util::BitSet& tgt_keys) {
+        switch (token) {
+
+            case SSID:
+                checkQueryState();
+
+                return (queryKeysMatch(tgt_keys) ? UNKNOWN : NO_MATCH);
+
+            case OR: {
+                ScreeningResult res1 = child1->screen(tgt_keys);
+
+                if (res1 == MATCH)
+                    return MATCH;
+
+                ScreeningResult res2 = child2->screen(tgt_keys);
+
+                if (res2 == MATCH)
+                    return MATCH;
+
+                return (res1 == NO_MATCH && res2 == NO_MATCH ? NO_MATCH : UNKNOWN);
+            }
+
+            case XOR: {
+                ScreeningResult res1 = child1->screen(tgt_keys);
+
+                if (res1 == UNKNOWN)
+                    return UNKNOWN;
+
+                ScreeningResult res2 = child2->screen(tgt_keys);
+
+                if (res2 == UNKNOWN)
+                    return UNKNOWN;
+
+                return (res1 != res2 ? MATCH : NO_MATCH);
+            }
+
+            case AND: {
+                ScreeningResult res1 = child1->screen(tgt_keys);
+
+                if (res1 == NO_MATCH)
+                    return NO_MATCH;
+
+                ScreeningResult res2 = child2->screen(tgt_keys);
+
+                if (res2 == NO_MATCH)
+                    return NO_MATCH;
+
+                return (res1 == MATCH && res2 == MATCH ? MATCH : UNKNOWN);
+            }
+
+            case NOT:
+                switch (child1->screen(tgt_keys)) {
+
+                    case MATCH:
+                        return NO_MATCH;
+
+                    case NO_MATCH:
+                        return MATCH;
+
+                    default:
+                        return UNKNOWN;
+                }
+
+            default:
+                return NO_MATCH;
+        }
+    }
+
   private:
+    void checkQueryState() {
+        if (!queryState.update(*queryMolgraph)) // unmodified query molecular graph
+            return;
+
+        subSearch.reset();
+        queryKeys.clear();
+    }
+
+    bool queryKeysMatch(const Util::BitSet& tgt_keys) {
+        if (tgt_keys.empty())
+            return true;
+        
+        if (queryKeys.size() != tgt_keys.size()) {
+            SubstructureScreeningKeyGenerator key_gen(tgt_keys.size());
+
+            key_gen.generateQueryKeys(*queryMolgraph, queryKeys);
+        }
+
+        return queryKeys.is_subset_of(tgt_keys);
+    }
+
     typedef MolecularGraph::SharedPointer       MolGraphPtr;
     typedef std::unique_ptr<SubstructureSearch> SubSearchPtr;
 
-    Token           token;
-    ExprTreeNodePtr child1;
-    ExprTreeNodePtr child2;
-    SubSearchPtr    subSearch;
-    MolGraphPtr     queryMolgraph;
+    Token                            token;
+    ExprTreeNodePtr                  child1;
+    ExprTreeNodePtr                  child2;
+    SubSearchPtr                     subSearch;
+    MolGraphPtr                      queryMolgraph;
+    Util::BitSet                     queryKeys;
+    Internal::SubstructureQueryState queryState;
 };
 
 
@@ -166,11 +304,29 @@ std::string Chem::MultiSubstructureSearch::validate(const std::string& expr, std
 }
 
 bool Chem::MultiSubstructureSearch::matches(const MolecularGraph& molgraph)
+{
+    if (!exprTree)
+        return false;
+
+    keyGenerator.generate(molgraph, targetKeys);
+
+    return exprTree->matches(molgraph, targetKeys);
+}
+
+bool Chem::MultiSubstructureSearch::matches(const MolecularGraph& molgraph, const Util::BitSet& tgt_keys)
+{
+    if (!exprTree)
+        return false;
+    
+    return exprTree->matches(molgraph, tgt_keys);
+}
+
+bool Chem::MultiSubstructureSearch::screen(const Util::BitSet& tgt_keys)
 {
     if (!exprTree)
         return false;
     
-    return exprTree->matches(molgraph);
+    return (exprTree->screen(tgt_keys) != NO_MATCH);
 }
 
 Chem::MultiSubstructureSearch::Token Chem::MultiSubstructureSearch::nextToken(const std::string& expr)
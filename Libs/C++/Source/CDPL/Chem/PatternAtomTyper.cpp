@@ -28,11 +28,33 @@
 #include "CDPL/Chem/AtomFunctions.hpp"
 #include "CDPL/Chem/Atom.hpp"
 #include "CDPL/Base/Exceptions.hpp"
+#include "CDPL/Internal/SubstructureQueryState.hpp"
 
 
 using namespace CDPL;
 
 
+class Chem::PatternAtomTyper::PatternSearch
+{
+
+  public:
+    void init(const MolecularGraph::SharedPointer& ptn_molgraph, SubstructureScreeningKeyGenerator& key_gen) {
+        if (!queryState.update(*ptn_molgraph)) // same and unmodified query molecular graph
+            return;
+
+        query = ptn_molgraph;  // keeps the query alive -> its address cannot get reused by a different pattern
+
+        subSearch.setQuery(*ptn_molgraph);
+        key_gen.generateQueryKeys(*ptn_molgraph, queryKeys);
+    }
+
+    MolecularGraph::SharedPointer    query;
+    SubstructureSearch               subSearch;
+    Util::BitSet                     queryKeys;
+    Internal::SubstructureQueryState queryState;
+};
+
+
 Chem::PatternAtomTyper::Pattern::Pattern(const MolecularGraph::SharedPointer& molgraph, std::size_t atom_label, std::size_t priority, 
                                          bool all_matches, bool unique_matches):
     molGraph(molgraph), priority(priority), atomLabel(atom_label), allMatches(all_matches), uniqueMatches(unique_matches)
@@ -211,6 +233,7 @@ Chem::PatternAtomTyper& Chem::PatternAtomTyper::operator=(const PatternAtomTyper
 
 void Chem::PatternAtomTyper::execute(const MolecularGraph& molgraph)
 {
+    initPatternSearches();
     init(molgraph);
 
     std::size_t num_ptns = patterns.size();
@@ -232,6 +255,27 @@ void Chem::PatternAtomTyper::init(const MolecularGraph& molgraph)
         labeledAtomMask.resize(num_atoms);
 
     labeledAtomMask.reset();
+
+    keyGenerator.generate(molgraph, molGraphKeys);
+}
+
+void Chem::PatternAtomTyper::initPatternSearches()
+{
+    std::size_t num_ptns = patterns.size();
+
+    patternSearches.resize(num_ptns);
+
+    for (std::size_t i = 0; i < num_ptns; i++) {
+        const MolecularGraph::SharedPointer& ptn_molgraph = patterns[i].getStructure();
+
+        if (!ptn_molgraph)
+            continue;
+
+        if (!patternSearches[i])
+            patternSearches[i].reset(new PatternSearch());
+
+        patternSearches[i]->init(ptn_molgraph, keyGenerator);
+    }
 }
 
 void Chem::PatternAtomTyper::processPattern(const Pattern& ptn, std::size_t ptn_idx)
@@ -239,11 +283,17 @@ void Chem::PatternAtomTyper::processPattern(const Pattern& ptn, std::size_t ptn_
     if (!ptn.getStructure())
         return;
 
-    subSearch.uniqueMappingsOnly(ptn.processUniqueMatchesOnly());
-    subSearch.setQuery(*ptn.getStructure());
-    subSearch.findMappings(*molGraph);
+    PatternSearch& ptn_search = *patternSearches[ptn_idx];
+
+    if (!ptn_search.queryKeys.is_subset_of(molGraphKeys))
+        return;
+
+    SubstructureSearch& sub_search = ptn_search.subSearch;
+
+    sub_search.uniqueMappingsOnly(ptn.processUniqueMatchesOnly());
+    sub_search.findMappings(*molGraph);
 
-    for (SubstructureSearch::ConstMappingIterator it = subSearch.getMappingsBegin(), end = subSearch.getMappingsEnd(); it != end; ++it) {
+    for (SubstructureSearch::ConstMappingIterator it = sub_search.getMappingsBegin(), end = sub_search.getMappingsEnd(); it != end; ++it) {
         if (processMatch(it->getAtomMapping(), ptn, ptn_idx) && !ptn.processAllMatches())
             return;
     }
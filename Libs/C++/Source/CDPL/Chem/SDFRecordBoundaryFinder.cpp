@@ -0,0 +1,90 @@
+/*
+ * SDFRecordBoundaryFinder.cpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include <cstring>
+#include <cctype>
+
+#include "CDPL/Chem/SDFRecordBoundaryFinder.hpp"
+#include "CDPL/Chem/ControlParameterFunctions.hpp"
+
+#include "MDLFormatData.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+    bool onlyWhitespaceFollows(const char* data, const char* end)
+    {
+        for ( ; data != end; ++data)
+            if (!std::isspace(static_cast<unsigned char>(*data)))
+                return false;
+
+        return true;
+    }
+}
+
+
+bool Chem::SDFRecordBoundaryFinder::init(const Base::ControlParameterContainer& params)
+{
+    return !getMultiConfImportParameter(params);
+}
+
+void Chem::SDFRecordBoundaryFinder::operator()(const char* data, std::size_t size, std::size_t from, std::size_t to,
+                                               std::vector<std::uint64_t>& rec_starts) const
+{
+    const std::string& delim = MDL::SDFile::RECORD_DELIMITER;
+    const char* end = data + size;
+    const char* line = data + from;
+
+    // advance to the first line starting within the range
+
+    if (from > 0) {
+        line = static_cast<const char*>(std::memchr(line - 1, MDL::END_OF_LINE, end - line + 1));
+
+        if (!line)
+            return;
+
+        line++;
+    }
+
+    for (const char* range_end = data + to; line < range_end; ) {
+        const char* line_end = static_cast<const char*>(std::memchr(line, MDL::END_OF_LINE, end - line));
+
+        if (!line_end)
+            line_end = end;
+        else
+            line_end++;
+
+        if (std::size_t(end - line) >= delim.size() && std::memcmp(line, delim.data(), delim.size()) == 0 &&
+            !onlyWhitespaceFollows(line_end, end))
+            rec_starts.push_back(line_end - data);
+
+        line = line_end;
+    }
+}
@@ -26,6 +26,7 @@ x1 * along with this library; see the file COPYING. If not, write to
 
 #include "CDPL/Chem/SMILESMoleculeReader.hpp"
 #include "CDPL/Chem/Molecule.hpp"
+#include "CDPL/Chem/ControlParameterFunctions.hpp"
 #include "CDPL/Base/Exceptions.hpp"
 
 #include "SMILESDataReader.hpp"
@@ -68,3 +69,8 @@ bool Chem::SMILESMoleculeReader::moreData(std::istream& is)
 {
     return reader->hasMoreData(is);
 }
+
+std::string Chem::SMILESMoleculeReader::getRecordLayoutSettings() const
+{
+    return ("rec-sep=" + getRecordSeparatorParameter(*this));
+}
@@ -26,6 +26,7 @@
 
 #include "CDPL/Chem/SMILESReactionReader.hpp"
 #include "CDPL/Chem/Reaction.hpp"
+#include "CDPL/Chem/ControlParameterFunctions.hpp"
 #include "CDPL/Base/Exceptions.hpp"
 
 #include "SMILESDataReader.hpp"
@@ -68,3 +69,8 @@ bool Chem::SMILESReactionReader::moreData(std::istream& is)
 {
     return reader->hasMoreData(is);
 }
+
+std::string Chem::SMILESReactionReader::getRecordLayoutSettings() const
+{
+    return ("rec-sep=" + getRecordSeparatorParameter(*this));
+}
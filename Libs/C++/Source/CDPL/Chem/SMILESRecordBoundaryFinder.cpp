@@ -0,0 +1,60 @@
+/*
+ * SMILESRecordBoundaryFinder.cpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include <cstring>
+
+#include "CDPL/Chem/SMILESRecordBoundaryFinder.hpp"
+#include "CDPL/Chem/ControlParameterFunctions.hpp"
+
+
+using namespace CDPL;
+
+
+Chem::SMILESRecordBoundaryFinder::SMILESRecordBoundaryFinder():
+    separator('\n')
+{}
+
+bool Chem::SMILESRecordBoundaryFinder::init(const Base::ControlParameterContainer& params)
+{
+    const std::string& rec_sep = getRecordSeparatorParameter(params);
+
+    separator = (rec_sep.size() == 1 ? rec_sep[0] : '\n');
+
+    return true;
+}
+
+void Chem::SMILESRecordBoundaryFinder::operator()(const char* data, std::size_t size, std::size_t from, std::size_t to,
+                                                  std::vector<std::uint64_t>& rec_starts) const
+{
+    for (const char* it = data + from, * range_end = data + to; it < range_end; it++) {
+        it = static_cast<const char*>(std::memchr(it, separator, range_end - it));
+
+        if (!it)
+            return;
+
+        rec_starts.push_back(it + 1 - data);
+    }
+}
@@ -0,0 +1,205 @@
+/* 
+ * SubstructureScreeningIndex.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include <cstring>
+#include <fstream>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include "CDPL/Chem/SubstructureScreeningIndex.hpp"
+#include "CDPL/Util/FileFunctions.hpp"
+#include "CDPL/Util/FileRemover.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+    const char          FILE_ID[8]      = { 'C', 'D', 'P', 'L', 'S', 'S', 'I', 'X' };
+    const std::uint32_t FORMAT_VERSION  = 1;
+    const std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    struct Header
+    {
+
+        char          fileID[8];
+        std::uint32_t formatVersion;
+        std::uint32_t byteOrderMark;
+        std::uint64_t sourceStamp;
+        std::uint64_t numBits;
+        std::uint64_t numRecords;
+    };
+
+    inline std::size_t findLowestSetBit(std::uint64_t word)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_ctzll(word);
+#else
+        std::size_t idx = 0;
+
+        for ( ; !(word & 1); word >>= 1)
+            idx++;
+
+        return idx;
+#endif
+    }
+}
+
+
+Chem::SubstructureScreeningIndex::SubstructureScreeningIndex():
+    keyWords(0), numRecords(0), numBits(0)
+{}
+
+Chem::SubstructureScreeningIndex::~SubstructureScreeningIndex()
+{}
+
+bool Chem::SubstructureScreeningIndex::open(const std::string& path, std::uint64_t src_stamp, std::size_t num_bits)
+{
+    close();
+
+    if (!Util::fileExists(path))
+        return false;
+
+    try {
+        MappedFilePtr file(new MappedFile(path));
+
+        if (!file->is_open() || file->size() < sizeof(Header))
+            return false;
+
+        Header header;
+
+        std::memcpy(&header, file->data(), sizeof(Header));
+
+        if (std::memcmp(header.fileID, FILE_ID, sizeof(FILE_ID)) != 0 || header.formatVersion != FORMAT_VERSION ||
+            header.byteOrderMark != BYTE_ORDER_MARK || header.sourceStamp != src_stamp || header.numBits != num_bits)
+            return false;
+
+        if (file->size() != sizeof(Header) + header.numRecords * getNumWords(num_bits) * sizeof(std::uint64_t))
+            return false;
+
+        mappedFile.swap(file);
+
+        keyWords   = reinterpret_cast<const std::uint64_t*>(mappedFile->data() + sizeof(Header));
+        numRecords = header.numRecords;
+        numBits    = num_bits;
+
+        return true;
+
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+void Chem::SubstructureScreeningIndex::close()
+{
+    mappedFile.reset();
+
+    keyWords   = 0;
+    numRecords = 0;
+    numBits    = 0;
+}
+
+bool Chem::SubstructureScreeningIndex::isOpen() const
+{
+    return mappedFile.get();
+}
+
+std::size_t Chem::SubstructureScreeningIndex::getNumRecords() const
+{
+    return numRecords;
+}
+
+std::size_t Chem::SubstructureScreeningIndex::getNumBits() const
+{
+    return numBits;
+}
+
+void Chem::SubstructureScreeningIndex::getKeys(std::size_t idx, Util::BitSet& keys) const
+{
+    std::size_t num_words = getNumWords(numBits);
+    const std::uint64_t* words = keyWords + idx * num_words;
+
+    keys.resize(numBits);
+    keys.reset();
+
+    for (std::size_t i = 0; i < num_words; i++)
+        for (std::uint64_t word = words[i]; word != 0; word &= word - 1)
+            keys.set(i * 64 + findLowestSetBit(word));
+}
+
+std::size_t Chem::SubstructureScreeningIndex::getNumWords(std::size_t num_bits)
+{
+    return ((num_bits + 63) / 64);
+}
+
+void Chem::SubstructureScreeningIndex::packKeys(const Util::BitSet& keys, std::uint64_t* words)
+{
+    std::memset(words, 0, getNumWords(keys.size()) * sizeof(std::uint64_t));
+
+    for (Util::BitSet::size_type i = keys.find_first(); i != Util::BitSet::npos; i = keys.find_next(i))
+        words[i / 64] |= std::uint64_t(1) << (i % 64);
+}
+
+bool Chem::SubstructureScreeningIndex::write(const std::string& path, std::uint64_t src_stamp, std::size_t num_bits,
+                                             const std::uint64_t* words, std::size_t num_records)
+{
+    try {
+        std::string::size_type sep_pos = path.find_last_of("/\\");
+        Util::FileRemover tmp_file_rem(Util::genCheckedTempFilePath(sep_pos == std::string::npos ? std::string(".") : path.substr(0, sep_pos + 1),
+                                                                    "%%%%-%%%%-%%%%-%%%%.tmp"));
+
+        std::ofstream os(tmp_file_rem.getPath().c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+
+        if (!os)
+            return false;
+
+        Header header;
+
+        std::memcpy(header.fileID, FILE_ID, sizeof(FILE_ID));
+
+        header.formatVersion = FORMAT_VERSION;
+        header.byteOrderMark = BYTE_ORDER_MARK;
+        header.sourceStamp   = src_stamp;
+        header.numBits       = num_bits;
+        header.numRecords    = num_records;
+
+        os.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        os.write(reinterpret_cast<const char*>(words), std::streamsize(num_records * getNumWords(num_bits) * sizeof(std::uint64_t)));
+        os.close();
+
+        if (!os || !Util::renameFile(tmp_file_rem.getPath(), path))
+            return false;
+
+        tmp_file_rem.release();
+
+        return true;
+
+    } catch (const std::exception&) {
+        return false;
+    }
+}
@@ -0,0 +1,212 @@
+/* 
+ * SubstructureScreeningKeyGenerator.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include <algorithm>
+
+#include "CDPL/Chem/SubstructureScreeningKeyGenerator.hpp"
+#include "CDPL/Chem/MolecularGraph.hpp"
+#include "CDPL/Chem/Atom.hpp"
+#include "CDPL/Chem/Bond.hpp"
+#include "CDPL/Chem/AtomFunctions.hpp"
+#include "CDPL/Chem/AtomType.hpp"
+#include "CDPL/Chem/AtomMatchConstraint.hpp"
+#include "CDPL/Chem/MatchConstraintList.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+    constexpr std::uint64_t ATOM_FEATURE      = 1;
+    constexpr std::uint64_t BOND_FEATURE      = 2;
+    constexpr std::uint64_t PATH_FEATURE      = 3;
+    constexpr std::size_t   MAX_FEATURE_COUNT = 4;
+
+    std::uint64_t mixBits(std::uint64_t x)
+    {
+        x ^= x >> 30;
+        x *= 0xBF58476D1CE4E5B9ULL;
+        x ^= x >> 27;
+        x *= 0x94D049BB133111EBULL;
+        x ^= x >> 31;
+
+        return x;
+    }
+
+    unsigned int getRequiredAtomType(const Chem::Atom& atom, const Chem::MatchConstraintList& constr_list)
+    {
+        using namespace Chem;
+
+        if (constr_list.getType() != MatchConstraintList::AND_LIST)
+            return AtomType::UNKNOWN;
+
+        for (MatchConstraintList::ConstElementIterator it = constr_list.getElementsBegin(), end = constr_list.getElementsEnd(); it != end; ++it) {
+            const MatchConstraint& constraint = *it;
+
+            if (constraint.getRelation() != MatchConstraint::EQUAL)
+                continue;
+
+            try {
+                unsigned int atom_type = AtomType::UNKNOWN;
+
+                switch (constraint.getID()) {
+
+                    case AtomMatchConstraint::TYPE:
+                        atom_type = (constraint.hasValue() ? constraint.getValue<unsigned int>() : getType(atom));
+                        break;
+
+                    case AtomMatchConstraint::CONSTRAINT_LIST:
+                        atom_type = getRequiredAtomType(atom, *constraint.getValue<MatchConstraintList::SharedPointer>());
+                        break;
+
+                    default:
+                        continue;
+                }
+
+                if (atom_type != AtomType::UNKNOWN && atom_type <= AtomType::MAX_ATOMIC_NO)
+                    return atom_type;
+
+            } catch (const Base::BadCast&) {}
+        }
+
+        return AtomType::UNKNOWN;
+    }
+}
+
+
+constexpr std::size_t Chem::SubstructureScreeningKeyGenerator::DEF_NUM_BITS;
+
+
+Chem::SubstructureScreeningKeyGenerator::SubstructureScreeningKeyGenerator(std::size_t num_bits):
+    numBits(num_bits)
+{}
+
+void Chem::SubstructureScreeningKeyGenerator::setNumBits(std::size_t num_bits)
+{
+    numBits = num_bits;
+}
+
+std::size_t Chem::SubstructureScreeningKeyGenerator::getNumBits() const
+{
+    return numBits;
+}
+
+void Chem::SubstructureScreeningKeyGenerator::generate(const MolecularGraph& molgraph, Util::BitSet& keys)
+{
+    generate(molgraph, keys, false);
+}
+
+void Chem::SubstructureScreeningKeyGenerator::generateQueryKeys(const MolecularGraph& molgraph, Util::BitSet& keys)
+{
+    generate(molgraph, keys, true);
+}
+
+void Chem::SubstructureScreeningKeyGenerator::generate(const MolecularGraph& molgraph, Util::BitSet& keys, bool query)
+{
+    keys.resize(numBits);
+    keys.reset();
+
+    if (numBits == 0)
+        return;
+
+    atomTypes.clear();
+    features.clear();
+
+    for (MolecularGraph::ConstAtomIterator it = molgraph.getAtomsBegin(), end = molgraph.getAtomsEnd(); it != end; ++it) {
+        const Atom& atom = *it;
+        unsigned int atom_type = (query ? getRequiredAtomType(atom, *getMatchConstraints(atom)) : getType(atom));
+
+        if (atom_type > AtomType::MAX_ATOMIC_NO)
+            atom_type = AtomType::UNKNOWN;
+
+        atomTypes.push_back(atom_type);
+
+        if (atom_type != AtomType::UNKNOWN)
+            addFeature(ATOM_FEATURE, atom_type);
+    }
+
+    for (MolecularGraph::ConstBondIterator it = molgraph.getBondsBegin(), end = molgraph.getBondsEnd(); it != end; ++it) {
+        const Bond& bond = *it;
+
+        if (!molgraph.containsAtom(bond.getBegin()) || !molgraph.containsAtom(bond.getEnd()))
+            continue;
+
+        unsigned int type1 = atomTypes[molgraph.getAtomIndex(bond.getBegin())];
+        unsigned int type2 = atomTypes[molgraph.getAtomIndex(bond.getEnd())];
+
+        if (type1 != AtomType::UNKNOWN && type2 != AtomType::UNKNOWN)
+            addFeature(BOND_FEATURE, std::min(type1, type2), std::max(type1, type2));
+    }
+
+    for (std::size_t i = 0, num_atoms = atomTypes.size(); i < num_atoms; i++) {
+        if (atomTypes[i] == AtomType::UNKNOWN)
+            continue;
+
+        const Atom& atom = molgraph.getAtom(i);
+
+        nbrAtomTypes.clear();
+
+        Atom::ConstBondIterator b_it = atom.getBondsBegin();
+
+        for (Atom::ConstAtomIterator a_it = atom.getAtomsBegin(), a_end = atom.getAtomsEnd(); a_it != a_end; ++a_it, ++b_it) {
+            if (!molgraph.containsBond(*b_it) || !molgraph.containsAtom(*a_it))
+                continue;
+
+            unsigned int nbr_type = atomTypes[molgraph.getAtomIndex(*a_it)];
+
+            if (nbr_type != AtomType::UNKNOWN)
+                nbrAtomTypes.push_back(nbr_type);
+        }
+
+        for (std::size_t j = 0, num_nbrs = nbrAtomTypes.size(); j < num_nbrs; j++)
+            for (std::size_t k = j + 1; k < num_nbrs; k++)
+                addFeature(PATH_FEATURE, std::min(nbrAtomTypes[j], nbrAtomTypes[k]), atomTypes[i], std::max(nbrAtomTypes[j], nbrAtomTypes[k]));
+    }
+
+    std::sort(features.begin(), features.end());
+
+    // each occurrence count up to MAX_FEATURE_COUNT sets its own bit, so that a target with more instances
+    // of a feature also contains all keys of a query with fewer instances
+
+    for (std::size_t i = 0, num_features = features.size(); i < num_features; ) {
+        std::size_t count = 1;
+
+        for ( ; (i + count) < num_features && features[i + count] == features[i]; count++);
+
+        for (std::size_t j = 1; j <= std::min(count, MAX_FEATURE_COUNT); j++)
+            keys.set(mixBits(features[i] * MAX_FEATURE_COUNT + j) % numBits);
+
+        i += count;
+    }
+}
+
+void Chem::SubstructureScreeningKeyGenerator::addFeature(std::uint64_t kind, unsigned int type1, unsigned int type2, unsigned int type3)
+{
+    features.push_back((kind << 48) | (std::uint64_t(type1) << 32) | (std::uint64_t(type2) << 16) | type3);
+}
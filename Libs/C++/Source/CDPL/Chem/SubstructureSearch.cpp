@@ -25,6 +25,7 @@
 #include "StaticInit.hpp"
 
 #include <cassert>
+#include <limits>
 
 #include "CDPL/Chem/SubstructureSearch.hpp"
 #include "CDPL/Chem/MolecularGraph.hpp"
@@ -40,6 +41,7 @@ namespace
 {
     
     constexpr std::size_t MAX_MAPPING_CACHE_SIZE = 1000;
+    constexpr std::size_t NO_INDEX               = std::numeric_limits<std::size_t>::max();
 }
 
 using namespace CDPL;
@@ -50,8 +52,8 @@ Chem::SubstructureSearch::SubstructureSearch():
     atomMatchExprFunc(static_cast<const AtomMatchExprPtr& (*)(const Atom&)>(&getMatchExpression)), 
     bondMatchExprFunc(static_cast<const BondMatchExprPtr& (*)(const Bond&)>(&getMatchExpression)), 
     molGraphMatchExprFunc(static_cast<const MolGraphMatchExprPtr& (*)(const MolecularGraph&)>(&getMatchExpression)),
-    mappingCache(MAX_MAPPING_CACHE_SIZE), queryChanged(true), initQueryData(true), uniqueMatches(false), 
-    exitSearch(false), numMappedAtoms(0), maxNumMappings(0) 
+    termQueryAtomsHead(0), termQueryAtomsTail(0), mappingCache(MAX_MAPPING_CACHE_SIZE), queryChanged(true),
+    initQueryData(true), uniqueMatches(false), exitSearch(false), numMappedAtoms(0), maxNumMappings(0) 
 {
     mappingCache.setCleanupFunction(&AtomBondMapping::clear);
 }
@@ -60,7 +62,8 @@ Chem::SubstructureSearch::SubstructureSearch(const MolecularGraph& query):
     atomMatchExprFunc(static_cast<const AtomMatchExprPtr& (*)(const Atom&)>(&getMatchExpression)), 
     bondMatchExprFunc(static_cast<const BondMatchExprPtr& (*)(const Bond&)>(&getMatchExpression)), 
     molGraphMatchExprFunc(static_cast<const MolGraphMatchExprPtr& (*)(const MolecularGraph&)>(&getMatchExpression)),
-    mappingCache(MAX_MAPPING_CACHE_SIZE), uniqueMatches(false), exitSearch(false), numMappedAtoms(0), maxNumMappings(0)
+    termQueryAtomsHead(0), termQueryAtomsTail(0), mappingCache(MAX_MAPPING_CACHE_SIZE), uniqueMatches(false),
+    exitSearch(false), numMappedAtoms(0), maxNumMappings(0)
 {
     mappingCache.setCleanupFunction(&AtomBondMapping::clear);
 
@@ -238,6 +241,7 @@ bool Chem::SubstructureSearch::init(const MolecularGraph& tgt)
         numQueryBonds = query->getNumBonds();
 
         initMatchExpressions();
+        initNeighborLists(*query, queryNbrListOffsets, queryNbrLists);
 
         queryChanged = false;
     }
@@ -249,12 +253,18 @@ bool Chem::SubstructureSearch::init(const MolecularGraph& tgt)
             if (queryAtomMapping.size() < numQueryAtoms) 
                 queryMappingMask.resize(numQueryAtoms);
                 
-            queryAtomMapping.assign(numQueryAtoms, 0);
-            queryBondMapping.assign(numQueryBonds, 0);
+            queryAtomMapping.assign(numQueryAtoms, NO_INDEX);
+            queryBondMapping.assign(numQueryBonds, NO_INDEX);
+            termQueryAtoms.resize(numQueryAtoms);
 
             initQueryData = false;
         }
 
+        initNeighborLists(tgt, targetNbrListOffsets, targetNbrLists);
+
+        termQueryAtomsHead = 0;
+        termQueryAtomsTail = 0;
+
         targetMappingMask.initAtomMask(numTargetAtoms);
         targetMappingMask.initBondMask(numTargetBonds);
 
@@ -308,6 +318,42 @@ void Chem::SubstructureSearch::initMatchExpressions()
     molGraphMatchExpr = molGraphMatchExprFunc(*query);
 }
 
+void Chem::SubstructureSearch::initNeighborLists(const MolecularGraph& molgraph, IndexArray& nbr_list_offsets,
+                                                 AtomBondIndexPairArray& nbr_lists) const
+{
+    nbr_list_offsets.clear();
+    nbr_lists.clear();
+
+    MolecularGraph::ConstAtomIterator atoms_end = molgraph.getAtomsEnd();
+
+    for (MolecularGraph::ConstAtomIterator it = molgraph.getAtomsBegin(); it != atoms_end; ++it) {
+        const Atom& atom = *it;
+
+        nbr_list_offsets.push_back(nbr_lists.size());
+
+        Atom::ConstAtomIterator nbrs_end = atom.getAtomsEnd();
+        Atom::ConstBondIterator b_it = atom.getBondsBegin();
+
+        for (Atom::ConstAtomIterator a_it = atom.getAtomsBegin(); a_it != nbrs_end; ++a_it, ++b_it) {
+            if (!molgraph.containsAtom(*a_it) || !molgraph.containsBond(*b_it))
+                continue;
+
+            nbr_lists.emplace_back(molgraph.getAtomIndex(*a_it), molgraph.getBondIndex(*b_it));
+        }
+    }
+
+    nbr_list_offsets.push_back(nbr_lists.size());
+}
+
+std::size_t Chem::SubstructureSearch::findTargetBond(std::size_t target_atom1_idx, std::size_t target_atom2_idx) const
+{
+    for (std::size_t i = targetNbrListOffsets[target_atom1_idx], end = targetNbrListOffsets[target_atom1_idx + 1]; i < end; i++)
+        if (targetNbrLists[i].first == target_atom2_idx)
+            return targetNbrLists[i].second;
+
+    return NO_INDEX;
+}
+
 bool Chem::SubstructureSearch::findEquivAtoms()
 {    
     if (atomEquivMatrix.size() < numQueryAtoms)
@@ -412,13 +458,13 @@ std::size_t Chem::SubstructureSearch::nextQueryAtom() const
 {
     std::size_t idx = numQueryAtoms;
 
-    if (!termQueryAtoms.empty()) 
-        idx = termQueryAtoms.front();
+    if (termQueryAtomsHead != termQueryAtomsTail) 
+        idx = termQueryAtoms[termQueryAtomsHead];
     else {
         std::size_t min_num_equiv_tgt_atoms = std::numeric_limits<std::size_t>::max();
         
         for (std::size_t i = 0; i < numQueryAtoms; i++) {
-            if (queryAtomMapping[i])
+            if (queryAtomMapping[i] != NO_INDEX)
                 continue;
 
             std::size_t num_equiv_atoms = atomEquivMatrix[i].count();
@@ -439,20 +485,13 @@ std::size_t Chem::SubstructureSearch::nextQueryAtom() const
 bool Chem::SubstructureSearch::nextTargetAtom(std::size_t query_atom_idx, std::size_t& target_atom_idx, 
                                               std::size_t& target_atom_nbr_idx) const
 {
-    if (!termQueryAtoms.empty()) {
-        const Atom* prev_target_atom = queryAtomMapping[query_atom_idx];
-        std::size_t num_target_atom_nbrs = prev_target_atom->getNumBonds();
+    if (termQueryAtomsHead != termQueryAtomsTail) {
+        std::size_t prev_target_atom_idx = queryAtomMapping[query_atom_idx];
+        std::size_t nbr_list_offs = targetNbrListOffsets[prev_target_atom_idx];
+        std::size_t num_target_atom_nbrs = targetNbrListOffsets[prev_target_atom_idx + 1] - nbr_list_offs;
 
         for ( ; target_atom_nbr_idx < num_target_atom_nbrs; target_atom_nbr_idx++) {
-            const Atom& target_atom = prev_target_atom->getAtom(target_atom_nbr_idx);
-
-            if (!target->containsAtom(target_atom))
-                continue;
-
-            if (!target->containsBond(prev_target_atom->getBond(target_atom_nbr_idx)))
-                continue;
-
-            target_atom_idx = target->getAtomIndex(target_atom);
+            target_atom_idx = targetNbrLists[nbr_list_offs + target_atom_nbr_idx].first;
 
             if (!atomMappingAllowed(query_atom_idx, target_atom_idx))
                 continue;
@@ -512,52 +551,33 @@ bool Chem::SubstructureSearch::checkBondMappingConstraints(std::size_t query_bon
 
 bool Chem::SubstructureSearch::mapBonds(std::size_t query_atom_idx, std::size_t target_atom_idx)
 {
-    const Atom& query_atom = query->getAtom(query_atom_idx);
-    const Atom& target_atom = target->getAtom(target_atom_idx);
-
-    Atom::ConstAtomIterator atoms_end = query_atom.getAtomsEnd();
-    Atom::ConstBondIterator b_it = query_atom.getBondsBegin();
-
     std::size_t unmapped_query_nbrs = 0;
 
-    for (Atom::ConstAtomIterator a_it = query_atom.getAtomsBegin(); a_it != atoms_end; ++a_it, ++b_it) {
-        if (!query->containsAtom(*a_it) || !query->containsBond(*b_it))
-            continue;
-
-        std::size_t nbr_atom_idx = query->getAtomIndex(*a_it);
+    for (std::size_t i = queryNbrListOffsets[query_atom_idx], end = queryNbrListOffsets[query_atom_idx + 1]; i < end; i++) {
+        std::size_t nbr_atom_idx = queryNbrLists[i].first;
 
         if (queryMappingMask.test(nbr_atom_idx)) {
-            const Atom* mapped_target_atom = queryAtomMapping[nbr_atom_idx];
-            const Bond* target_nbr_bond = target_atom.findBondToAtom(*mapped_target_atom);
+            std::size_t target_bond_idx = findTargetBond(target_atom_idx, queryAtomMapping[nbr_atom_idx]);
 
-            if (!target_nbr_bond || !target->containsBond(*target_nbr_bond))
+            if (target_bond_idx == NO_INDEX)
                 return false;
 
-            std::size_t bond_idx = query->getBondIndex(*b_it);
+            std::size_t bond_idx = queryNbrLists[i].second;
 
-            if (!bondEquivMatrix[bond_idx].test(target->getBondIndex(*target_nbr_bond)))
+            if (!bondEquivMatrix[bond_idx].test(target_bond_idx))
                 return false;
 
-            queryBondMapping[bond_idx] = target_nbr_bond;
+            queryBondMapping[bond_idx] = target_bond_idx;
 
         } else
             unmapped_query_nbrs++;
     }
 
-    atoms_end = target_atom.getAtomsEnd();
-    b_it = target_atom.getBondsBegin();
-
     std::size_t unmapped_target_nbrs = 0;
 
-    for (Atom::ConstAtomIterator a_it = target_atom.getAtomsBegin(); a_it != atoms_end; ++a_it, ++b_it) {
-        if (!target->containsAtom(*a_it) || !target->containsBond(*b_it))
-            continue;
-
-        std::size_t nbr_atom_idx = target->getAtomIndex(*a_it);
-
-        if (!targetMappingMask.testAtomBit(nbr_atom_idx))
+    for (std::size_t i = targetNbrListOffsets[target_atom_idx], end = targetNbrListOffsets[target_atom_idx + 1]; i < end; i++)
+        if (!targetMappingMask.testAtomBit(targetNbrLists[i].first))
             unmapped_target_nbrs++;
-    }
 
     return (unmapped_query_nbrs <= unmapped_target_nbrs);
 }
@@ -572,34 +592,28 @@ bool Chem::SubstructureSearch::mapAtoms(std::size_t query_atom_idx, std::size_t
 
     bool had_term_atoms;
 
-    if ((had_term_atoms = !termQueryAtoms.empty()))
-        termQueryAtoms.pop_front();        
+    if ((had_term_atoms = (termQueryAtomsHead != termQueryAtomsTail)))
+        termQueryAtomsHead++;        
 
-    const Atom& query_atom = query->getAtom(query_atom_idx);
-    const Atom& target_atom = target->getAtom(target_atom_idx);
+    std::size_t prev_mapping = queryAtomMapping[query_atom_idx];
 
-    const Atom* prev_mapping = queryAtomMapping[query_atom_idx];
-
-    queryAtomMapping[query_atom_idx] = &target_atom;
+    queryAtomMapping[query_atom_idx] = target_atom_idx;
 
     queryMappingMask.set(query_atom_idx);
     targetMappingMask.setAtomBit(target_atom_idx);
 
-    Atom::ConstAtomIterator atoms_end = query_atom.getAtomsEnd();
-    Atom::ConstBondIterator b_it = query_atom.getBondsBegin();
-
     std::size_t num_term_atoms = 0;
 
-    for (Atom::ConstAtomIterator a_it = query_atom.getAtomsBegin(); a_it != atoms_end; ++a_it, ++b_it) {
-        if (!query->containsAtom(*a_it) || !query->containsBond(*b_it))
-            continue;
+    // every query atom enters the terminal atom queue at most once along a search path, so the queue never 
+    // holds more than numQueryAtoms entries and can be kept in a preallocated array
 
-        std::size_t nbr_atom_idx = query->getAtomIndex(*a_it);
+    for (std::size_t i = queryNbrListOffsets[query_atom_idx], end = queryNbrListOffsets[query_atom_idx + 1]; i < end; i++) {
+        std::size_t nbr_atom_idx = queryNbrLists[i].first;
 
-        if (!queryAtomMapping[nbr_atom_idx]) {
-            queryAtomMapping[nbr_atom_idx] = &target_atom;
+        if (queryAtomMapping[nbr_atom_idx] == NO_INDEX) {
+            queryAtomMapping[nbr_atom_idx] = target_atom_idx;
 
-            termQueryAtoms.push_back(nbr_atom_idx);
+            termQueryAtoms[termQueryAtomsTail++] = nbr_atom_idx;
             num_term_atoms++;
         }
     }
@@ -613,13 +627,11 @@ bool Chem::SubstructureSearch::mapAtoms(std::size_t query_atom_idx, std::size_t
     queryMappingMask.reset(query_atom_idx);
     targetMappingMask.resetAtomBit(target_atom_idx);
 
-    for (std::size_t i = 0; i < num_term_atoms; i++) { 
-        queryAtomMapping[termQueryAtoms.back()] = 0;
-        termQueryAtoms.pop_back();
-    }
+    for (std::size_t i = 0; i < num_term_atoms; i++)
+        queryAtomMapping[termQueryAtoms[--termQueryAtomsTail]] = NO_INDEX;
 
     if (had_term_atoms)
-        termQueryAtoms.push_front(query_atom_idx);
+        termQueryAtoms[--termQueryAtomsHead] = query_atom_idx;
 
     queryAtomMapping[query_atom_idx] = prev_mapping;
 
@@ -680,7 +692,7 @@ bool Chem::SubstructureSearch::foundMappingMatches(const AtomBondMapping* mappin
         const Atom& atom = **it;
         std::size_t atom_idx = query->getAtomIndex(atom);
 
-        if (!(*atomMatchExprTable[atom_idx])(atom, *query, *queryAtomMapping[atom_idx], 
+        if (!(*atomMatchExprTable[atom_idx])(atom, *query, target->getAtom(queryAtomMapping[atom_idx]), 
                                              *target, *mapping, Base::Any()))
             return false;
     }
@@ -691,7 +703,7 @@ bool Chem::SubstructureSearch::foundMappingMatches(const AtomBondMapping* mappin
         const Bond& bond = **it;
         std::size_t bond_idx = query->getBondIndex(bond);
 
-        if (!(*bondMatchExprTable[bond_idx])(bond, *query, *queryBondMapping[bond_idx], 
+        if (!(*bondMatchExprTable[bond_idx])(bond, *query, target->getBond(queryBondMapping[bond_idx]), 
                                              *target, *mapping, Base::Any()))
             return false;
     }
@@ -707,7 +719,7 @@ bool Chem::SubstructureSearch::foundMappingUnique()
         if (!bondMatchExprTable[i])
             continue;
 
-        targetMappingMask.setBondBit(target->getBondIndex(*queryBondMapping[i]));
+        targetMappingMask.setBondBit(queryBondMapping[i]);
     }
 
     return uniqueMappings.insert(targetMappingMask).second;
@@ -734,13 +746,13 @@ Chem::AtomBondMapping* Chem::SubstructureSearch::createAtomBondMapping()
     BondMapping& bond_mapping = mapping->getBondMapping();
 
     MolecularGraph::ConstAtomIterator atoms_end = query->getAtomsEnd();
-    AtomMappingTable::const_iterator am_it = queryAtomMapping.begin();
+    IndexArray::const_iterator am_it = queryAtomMapping.begin();
 
     for (MolecularGraph::ConstAtomIterator a_it = query->getAtomsBegin(); a_it != atoms_end; ++a_it, ++am_it)
-        atom_mapping.insertEntry(&*a_it, *am_it);
+        atom_mapping.insertEntry(&*a_it, &target->getAtom(*am_it));
 
     MolecularGraph::ConstBondIterator bonds_end = query->getBondsEnd();
-    BondMappingTable::const_iterator bm_it = queryBondMapping.begin();
+    IndexArray::const_iterator bm_it = queryBondMapping.begin();
 
     std::size_t i = 0;
 
@@ -748,7 +760,7 @@ Chem::AtomBondMapping* Chem::SubstructureSearch::createAtomBondMapping()
         if (!bondMatchExprTable[i])
             continue;
 
-        bond_mapping.insertEntry(&*b_it, *bm_it);
+        bond_mapping.insertEntry(&*b_it, &target->getBond(*bm_it));
     }
 
     return mapping;
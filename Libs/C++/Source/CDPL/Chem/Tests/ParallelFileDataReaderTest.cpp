@@ -0,0 +1,263 @@
+/* 
+ * ParallelFileDataReaderTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <string>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <iterator>
+#include <vector>
+#include <cstdint>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/Chem/SDFMoleculeReader.hpp"
+#include "CDPL/Chem/SMILESMoleculeReader.hpp"
+#include "CDPL/Chem/SDFRecordBoundaryFinder.hpp"
+#include "CDPL/Chem/SMILESRecordBoundaryFinder.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Chem/ControlParameterFunctions.hpp"
+#include "CDPL/Util/FileDataReader.hpp"
+#include "CDPL/Util/ParallelFileDataReader.hpp"
+#include "CDPL/Util/ControlParameterFunctions.hpp"
+#include "CDPL/Util/FileFunctions.hpp"
+#include "CDPL/Util/FileRemover.hpp"
+
+
+namespace
+{
+
+    template <typename ReaderImpl, typename BoundaryFinder>
+    void checkReader(const std::string& file_name)
+    {
+        using namespace CDPL;
+        using namespace Chem;
+
+        typedef Util::ParallelFileDataReader<ReaderImpl, BoundaryFinder, BasicMolecule> ParallelReader;
+
+        std::string file_path = std::string(std::getenv("CDPKIT_TEST_DATA_DIR")) + '/' + file_name;
+
+        Util::FileDataReader<ReaderImpl> seq_reader(file_path);
+        ParallelReader par_reader(file_path);
+
+        setMultiConfImportParameter(seq_reader, false);
+        setMultiConfImportParameter(par_reader, false);
+        Util::setNumReaderThreadsParameter(par_reader, 3);
+
+        BOOST_CHECK(par_reader.isParallelModeEnabled());
+        BOOST_CHECK(par_reader.getNumRecords() == seq_reader.getNumRecords());
+        BOOST_CHECK(par_reader.getNumRecords() > 50);
+
+        BasicMolecule seq_mol;
+        BasicMolecule par_mol;
+        std::size_t num_recs = 0;
+
+        while (seq_reader.read(seq_mol)) {
+            BOOST_CHECK(par_reader.hasMoreData());
+            BOOST_CHECK(par_reader.read(par_mol));
+            BOOST_CHECK(par_reader.getRecordIndex() == seq_reader.getRecordIndex());
+
+            BOOST_CHECK(getName(seq_mol) == getName(par_mol));
+            BOOST_CHECK(seq_mol.getNumAtoms() == par_mol.getNumAtoms());
+            BOOST_CHECK(seq_mol.getNumBonds() == par_mol.getNumBonds());
+
+            num_recs++;
+        }
+
+        BOOST_CHECK(num_recs == seq_reader.getNumRecords());
+
+        BOOST_CHECK(!par_reader.hasMoreData());
+        BOOST_CHECK(!par_reader.read(par_mol));
+        BOOST_CHECK(!par_reader);
+
+        // random access
+
+        for (std::size_t i = num_recs; i > 0; i -= 7) {
+            seq_reader.read(i - 1, seq_mol);
+            par_reader.read(i - 1, par_mol);
+
+            BOOST_CHECK(par_reader);
+            BOOST_CHECK(getName(seq_mol) == getName(par_mol));
+            BOOST_CHECK(seq_mol.getNumAtoms() == par_mol.getNumAtoms());
+
+            if (i <= 7)
+                break;
+        }
+
+        BOOST_CHECK_THROW(par_reader.read(num_recs, par_mol), Base::IndexError);
+
+        // skipping and appending reads
+
+        par_reader.setRecordIndex(5);
+        seq_reader.setRecordIndex(5);
+
+        BOOST_CHECK(par_reader.skip());
+        BOOST_CHECK(par_reader.getRecordIndex() == 6);
+        BOOST_CHECK(seq_reader.skip());
+
+        BOOST_CHECK(par_reader.read(par_mol));
+        BOOST_CHECK(par_reader.read(par_mol, false));
+        BOOST_CHECK(seq_reader.read(seq_mol));
+        BOOST_CHECK(seq_reader.read(seq_mol, false));
+
+        BOOST_CHECK(par_reader.getRecordIndex() == 8);
+        BOOST_CHECK(seq_mol.getNumAtoms() == par_mol.getNumAtoms());
+
+        BOOST_CHECK(par_reader.read(par_mol));
+        BOOST_CHECK(seq_reader.read(seq_mol));
+        BOOST_CHECK(getName(seq_mol) == getName(par_mol));
+
+        // sequential mode
+
+        ParallelReader par_reader2(file_path);
+
+        setMultiConfImportParameter(par_reader2, false);
+
+        BOOST_CHECK(!par_reader2.isParallelModeEnabled());
+        BOOST_CHECK(par_reader2.getNumRecords() == num_recs);
+    }
+
+    template <typename BoundaryFinder>
+    void checkBoundaryFinder(const std::string& data)
+    {
+        BoundaryFinder finder;
+        std::vector<std::uint64_t> ref_starts;
+
+        finder(data.data(), data.size(), 0, data.size(), ref_starts);
+
+        BOOST_CHECK(!ref_starts.empty());
+
+        for (std::size_t num_chunks = 2; num_chunks < 40; num_chunks += 3) {
+            std::vector<std::uint64_t> starts;
+
+            for (std::size_t i = 0; i < num_chunks; i++)
+                finder(data.data(), data.size(), i * data.size() / num_chunks, (i + 1) * data.size() / num_chunks, starts);
+
+            BOOST_CHECK(starts == ref_starts);
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(ParallelFileDataReaderTest)
+{
+    using namespace CDPL;
+    using namespace Chem;
+
+    checkReader<SDFMoleculeReader, SDFRecordBoundaryFinder>("ChEMBLStandardizerTestData.sdf");
+    checkReader<SMILESMoleculeReader, SMILESRecordBoundaryFinder>("CIPConfigLabelingTestSet.smi");
+
+    std::string file_path = std::string(std::getenv("CDPKIT_TEST_DATA_DIR")) + "/ChEMBLStandardizerTestData.sdf";
+
+    Util::ParallelFileDataReader<SDFMoleculeReader, SDFRecordBoundaryFinder, BasicMolecule> mc_reader(file_path);
+
+    Util::setNumReaderThreadsParameter(mc_reader, 2);
+    setMultiConfImportParameter(mc_reader, true);
+
+    BOOST_CHECK(!mc_reader.isParallelModeEnabled());
+
+    std::ifstream sdf_is(file_path);
+    std::ifstream smi_is(std::string(std::getenv("CDPKIT_TEST_DATA_DIR")) + "/CIPConfigLabelingTestSet.smi");
+
+    checkBoundaryFinder<SDFRecordBoundaryFinder>(std::string(std::istreambuf_iterator<char>(sdf_is), std::istreambuf_iterator<char>()));
+    checkBoundaryFinder<SMILESRecordBoundaryFinder>(std::string(std::istreambuf_iterator<char>(smi_is), std::istreambuf_iterator<char>()));
+
+    // whitespace after the last record delimiter must not start another record
+
+    SDFRecordBoundaryFinder sdf_finder;
+    std::vector<std::uint64_t> rec_starts;
+    std::string sdf_data = "Mol1\n\n\n  0  0  0  0  0  0  0  0  0  0999 V2000\nM  END\n$$$$\n"
+                           "Mol2\n\n\n  0  0  0  0  0  0  0  0  0  0999 V2000\nM  END\n$$$$\n";
+
+    sdf_finder(sdf_data.data(), sdf_data.size(), 0, sdf_data.size(), rec_starts);
+
+    BOOST_CHECK(rec_starts.size() == 1);
+
+    sdf_data.append(" \n\r\n\t\n");
+    rec_starts.clear();
+
+    sdf_finder(sdf_data.data(), sdf_data.size(), 0, sdf_data.size(), rec_starts);
+
+    BOOST_CHECK(rec_starts.size() == 1);
+}
+
+BOOST_AUTO_TEST_CASE(ParallelFileDataReaderRecordIndexFileTest)
+{
+    using namespace CDPL;
+    using namespace Chem;
+
+    typedef Util::ParallelFileDataReader<SDFMoleculeReader, SDFRecordBoundaryFinder, BasicMolecule> ParallelReader;
+
+    // the test file contains multiple consecutive conformers per molecule
+
+    Util::FileRemover sdf_file(Util::genCheckedTempFilePath("", "%%%%-%%%%-%%%%-%%%%.sdf"));
+    Util::FileRemover idx_file(sdf_file.getPath() + ".ridx");
+
+    {
+        std::ifstream ifs(std::string(std::getenv("CDPKIT_TEST_DATA_DIR")) + "/CDK2_actives.sdf", std::ios_base::in | std::ios_base::binary);
+        std::ofstream ofs(sdf_file.getPath().c_str(), std::ios_base::out | std::ios_base::binary);
+
+        BOOST_CHECK(ofs << ifs.rdbuf());
+    }
+
+    Util::FileDataReader<SDFMoleculeReader> ref_reader(sdf_file.getPath());
+
+    setMultiConfImportParameter(ref_reader, true);
+
+    std::size_t num_mc_recs = ref_reader.getNumRecords();
+
+    BOOST_CHECK(num_mc_recs < 282);
+
+    for (std::size_t i = 0; i < 2; i++) {
+        ParallelReader sc_reader(sdf_file.getPath());
+
+        setMultiConfImportParameter(sc_reader, false);
+        Util::setUseRecordIndexFilesParameter(sc_reader, true);
+        Util::setNumReaderThreadsParameter(sc_reader, 2);
+
+        BOOST_CHECK(sc_reader.isParallelModeEnabled());
+        BOOST_CHECK(sc_reader.getNumRecords() == 282);
+        BOOST_CHECK(Util::fileExists(idx_file.getPath()));
+
+        BasicMolecule mol;
+
+        BOOST_CHECK(sc_reader.read(281, mol));
+        BOOST_CHECK(!sc_reader.read(mol));
+
+        // multi-conformer import requires sequential reading and a different record partitioning
+
+        ParallelReader mc_reader(sdf_file.getPath());
+
+        setMultiConfImportParameter(mc_reader, true);
+        Util::setUseRecordIndexFilesParameter(mc_reader, true);
+        Util::setNumReaderThreadsParameter(mc_reader, 2);
+
+        BOOST_CHECK(!mc_reader.isParallelModeEnabled());
+        BOOST_CHECK(mc_reader.getNumRecords() == num_mc_recs);
+
+        BOOST_CHECK(mc_reader.read(num_mc_recs - 1, mol));
+        BOOST_CHECK(!mc_reader.read(mol));
+    }
+}
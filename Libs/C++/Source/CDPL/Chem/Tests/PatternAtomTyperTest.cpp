@@ -0,0 +1,90 @@
+/* 
+ * PatternAtomTyperTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/Chem/PatternAtomTyper.hpp"
+#include "CDPL/Chem/MultiSubstructureSearch.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/UtilityFunctions.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+
+
+BOOST_AUTO_TEST_CASE(PatternAtomTyperQueryModificationTest)
+{
+    using namespace CDPL;
+    using namespace Chem;
+
+    BasicMolecule tgt;
+
+    BOOST_CHECK(parseSMILES("CCO", tgt));
+
+    initSubstructureSearchTarget(tgt, false);
+
+    BasicMolecule::SharedPointer qry(new BasicMolecule());
+
+    BOOST_CHECK(parseSMARTS("[#8]", *qry));
+
+    PatternAtomTyper typer;
+
+    typer.addPattern(qry, 1);
+    typer.execute(tgt);
+
+    BOOST_CHECK(!typer.hasAtomLabel(0));
+    BOOST_CHECK(!typer.hasAtomLabel(1));
+    BOOST_CHECK(typer.hasAtomLabel(2) && typer.getAtomLabel(2) == 1);
+
+    // modifications of the query molecular graph must not be ignored by cached search data
+
+    BOOST_CHECK(parseSMARTS("[#6]", *qry));
+
+    typer.execute(tgt);
+
+    BOOST_CHECK(typer.hasAtomLabel(0) && typer.getAtomLabel(0) == 1);
+    BOOST_CHECK(typer.hasAtomLabel(1) && typer.getAtomLabel(1) == 1);
+    BOOST_CHECK(!typer.hasAtomLabel(2));
+
+    BOOST_CHECK(parseSMARTS("[#7]", *qry));
+
+    typer.execute(tgt);
+
+    BOOST_CHECK(!typer.hasAtomLabel(0));
+    BOOST_CHECK(!typer.hasAtomLabel(1));
+    BOOST_CHECK(!typer.hasAtomLabel(2));
+
+    MultiSubstructureSearch multi_srch;
+
+    multi_srch.addSubstructure(qry);
+    multi_srch.setup("1");
+
+    BOOST_CHECK(!multi_srch.matches(tgt));
+
+    BOOST_CHECK(parseSMARTS("[#6]-[#8]", *qry));
+
+    BOOST_CHECK(multi_srch.matches(tgt));
+
+    BOOST_CHECK(parseSMARTS("[#6]=[#8]", *qry));
+
+    BOOST_CHECK(!multi_srch.matches(tgt));
+}
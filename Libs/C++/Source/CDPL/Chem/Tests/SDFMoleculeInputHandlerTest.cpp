@@ -31,10 +31,17 @@
 
 #include "CDPL/Chem/DataFormat.hpp"
 #include "CDPL/Chem/JMEMoleculeReader.hpp"
+#include "CDPL/Chem/SDFMoleculeReader.hpp"
 #include "CDPL/Chem/SDFMolecularGraphWriter.hpp"
 #include "CDPL/Chem/BasicMolecule.hpp"
 #include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Chem/AtomFunctions.hpp"
+#include "CDPL/Chem/ControlParameterFunctions.hpp"
 #include "CDPL/Base/DataIOManager.hpp"
+#include "CDPL/Util/FileDataReader.hpp"
+#include "CDPL/Util/FileFunctions.hpp"
+#include "CDPL/Util/FileRemover.hpp"
+#include "CDPL/Util/ControlParameterFunctions.hpp"
 
 
 BOOST_AUTO_TEST_CASE(SDFMoleculeInputHandlerTest)
@@ -104,3 +111,59 @@ BOOST_AUTO_TEST_CASE(SDFMoleculeInputHandlerTest)
     BOOST_CHECK(calcHashCode(mol1) == calcHashCode(mol2));
 }
 
+BOOST_AUTO_TEST_CASE(SDFMoleculeReaderRecordIndexFileTest)
+{
+    using namespace CDPL;
+    using namespace Chem;
+
+    typedef Util::FileDataReader<SDFMoleculeReader> FileReader;
+
+    // the test file contains multiple consecutive conformers per molecule
+
+    Util::FileRemover sdf_file(Util::genCheckedTempFilePath("", "%%%%-%%%%-%%%%-%%%%.sdf"));
+    Util::FileRemover idx_file(sdf_file.getPath() + ".ridx");
+
+    {
+        std::ifstream ifs(std::string(std::getenv("CDPKIT_TEST_DATA_DIR")) + "/CDK2_actives.sdf", std::ios_base::in | std::ios_base::binary);
+        std::ofstream ofs(sdf_file.getPath().c_str(), std::ios_base::out | std::ios_base::binary);
+
+        BOOST_CHECK(ofs << ifs.rdbuf());
+    }
+
+    FileReader ref_reader(sdf_file.getPath());
+
+    setMultiConfImportParameter(ref_reader, true);
+
+    std::size_t num_mc_recs = ref_reader.getNumRecords();
+
+    BOOST_CHECK(!Util::fileExists(idx_file.getPath()));
+
+    for (std::size_t i = 0; i < 2; i++) {
+        FileReader sc_reader(sdf_file.getPath());
+
+        setMultiConfImportParameter(sc_reader, false);
+        Util::setUseRecordIndexFilesParameter(sc_reader, true);
+
+        BOOST_CHECK(sc_reader.getNumRecords() == 282);
+        BOOST_CHECK(Util::fileExists(idx_file.getPath()));
+
+        FileReader mc_reader(sdf_file.getPath());
+
+        setMultiConfImportParameter(mc_reader, true);
+        Util::setUseRecordIndexFilesParameter(mc_reader, true);
+
+        BOOST_CHECK(mc_reader.getNumRecords() == num_mc_recs);
+        BOOST_CHECK(mc_reader.getNumRecords() < 282);
+
+        // the last record must contain all remaining conformers
+
+        BasicMolecule mol1;
+        BasicMolecule mol2;
+
+        BOOST_CHECK(mc_reader.read(num_mc_recs - 1, mol1));
+        BOOST_CHECK(ref_reader.read(num_mc_recs - 1, mol2));
+        BOOST_CHECK(getName(mol1) == getName(mol2));
+        BOOST_CHECK(get3DCoordinatesArray(mol1.getAtom(0))->getSize() == get3DCoordinatesArray(mol2.getAtom(0))->getSize());
+        BOOST_CHECK(!mc_reader.read(mol1));
+    }
+}
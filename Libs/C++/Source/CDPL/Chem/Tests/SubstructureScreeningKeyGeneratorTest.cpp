@@ -0,0 +1,169 @@
+/* 
+ * SubstructureScreeningKeyGeneratorTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <string>
+#include <cstdlib>
+#include <cstdint>
+#include <vector>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/Chem/SubstructureScreeningKeyGenerator.hpp"
+#include "CDPL/Chem/SubstructureScreeningIndex.hpp"
+#include "CDPL/Chem/MultiSubstructureSearch.hpp"
+#include "CDPL/Chem/SubstructureSearch.hpp"
+#include "CDPL/Chem/SMILESMoleculeReader.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/UtilityFunctions.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Util/FileDataReader.hpp"
+#include "CDPL/Util/FileFunctions.hpp"
+#include "CDPL/Util/FileRemover.hpp"
+
+
+BOOST_AUTO_TEST_CASE(SubstructureScreeningKeyGeneratorTest)
+{
+    using namespace CDPL;
+    using namespace Chem;
+
+    const char* patterns[] = {
+        "c1ccccc1", "C(=O)[OH]", "[#7]", "[N;R]", "[Cl,Br]", "O=C-N", "[#6]~[#7]~[#8]", "S", "C#N",
+        "F", "c1ccncc1", "[#8]-[#6]-[#8]", "[#16]-[#6]", "P", "[#6]1~[#6]~[#6]~[#6]1", "[!#6]", "I"
+    };
+
+    Util::FileDataReader<SMILESMoleculeReader> reader(std::string(std::getenv("CDPKIT_TEST_DATA_DIR")) + "/CIPConfigLabelingTestSet.smi");
+
+    std::vector<BasicMolecule::SharedPointer> targets;
+
+    for (BasicMolecule::SharedPointer mol_ptr(new BasicMolecule()); reader.read(*mol_ptr); mol_ptr.reset(new BasicMolecule())) {
+        initSubstructureSearchTarget(*mol_ptr, false);
+        targets.push_back(mol_ptr);
+    }
+
+    BOOST_CHECK(targets.size() > 50);
+
+    SubstructureScreeningKeyGenerator key_gen;
+    std::vector<Util::BitSet> tgt_keys(targets.size());
+
+    BOOST_CHECK(key_gen.getNumBits() == SubstructureScreeningKeyGenerator::DEF_NUM_BITS);
+
+    for (std::size_t i = 0; i < targets.size(); i++) {
+        key_gen.generate(*targets[i], tgt_keys[i]);
+
+        BOOST_CHECK(tgt_keys[i].size() == key_gen.getNumBits());
+        BOOST_CHECK(tgt_keys[i].any());
+    }
+
+    SubstructureSearch sub_srch;
+    Util::BitSet qry_keys;
+    std::size_t num_screened_out = 0;
+
+    for (auto ptn : patterns) {
+        MolecularGraph::SharedPointer qry_ptr = parseSMARTS(ptn);
+
+        key_gen.generateQueryKeys(*qry_ptr, qry_keys);
+        sub_srch.setQuery(*qry_ptr);
+
+        BOOST_CHECK(qry_keys.size() == key_gen.getNumBits());
+
+        MultiSubstructureSearch multi_srch;
+
+        multi_srch.addSubstructure(qry_ptr);
+        multi_srch.setup("!1");
+
+        for (std::size_t i = 0; i < targets.size(); i++) {
+            bool match = sub_srch.mappingExists(*targets[i]);
+            bool passed = qry_keys.is_subset_of(tgt_keys[i]);
+
+            BOOST_CHECK_MESSAGE(!match || passed, "query keys of pattern " << ptn << " are not a subset of the keys of target " << i);
+
+            if (!passed)
+                num_screened_out++;
+
+            BOOST_CHECK(multi_srch.matches(*targets[i], tgt_keys[i]) == !match);
+            BOOST_CHECK(multi_srch.screen(tgt_keys[i]));
+        }
+    }
+
+    BOOST_CHECK(num_screened_out > 0);
+
+// -- Three-valued screening of match expressions --
+
+    MultiSubstructureSearch multi_srch;
+    Util::BitSet benzene_keys;
+
+    multi_srch.addSubstructure(parseSMARTS("c1ccccc1"));
+    multi_srch.addSubstructure(parseSMARTS("P"));
+
+    key_gen.generate(*parseSMILES("c1ccccc1"), benzene_keys);
+
+    multi_srch.setup("1 & 2");
+    BOOST_CHECK(!multi_srch.screen(benzene_keys));
+
+    multi_srch.setup("1 | 2");
+    BOOST_CHECK(multi_srch.screen(benzene_keys));
+
+    multi_srch.setup("!2");
+    BOOST_CHECK(multi_srch.screen(benzene_keys));
+
+    multi_srch.setup("!(1 | !2)");
+    BOOST_CHECK(!multi_srch.screen(benzene_keys));
+
+    multi_srch.setup("1 ^ 2");
+    BOOST_CHECK(multi_srch.screen(benzene_keys));
+
+// -- Index file roundtrip --
+
+    std::size_t num_words = SubstructureScreeningIndex::getNumWords(key_gen.getNumBits());
+    std::vector<std::uint64_t> key_words(targets.size() * num_words);
+
+    for (std::size_t i = 0; i < targets.size(); i++)
+        SubstructureScreeningIndex::packKeys(tgt_keys[i], &key_words[i * num_words]);
+
+    Util::FileRemover idx_file_rem(Util::genCheckedTempFilePath());
+
+    BOOST_CHECK(SubstructureScreeningIndex::write(idx_file_rem.getPath(), 42, key_gen.getNumBits(), key_words.data(), targets.size()));
+
+    SubstructureScreeningIndex index;
+
+    BOOST_CHECK(!index.open(idx_file_rem.getPath(), 43, key_gen.getNumBits()));
+    BOOST_CHECK(!index.isOpen());
+    BOOST_CHECK(!index.open(idx_file_rem.getPath(), 42, key_gen.getNumBits() + 1));
+    BOOST_CHECK(index.open(idx_file_rem.getPath(), 42, key_gen.getNumBits()));
+    BOOST_CHECK(index.isOpen());
+    BOOST_CHECK(index.getNumRecords() == targets.size());
+    BOOST_CHECK(index.getNumBits() == key_gen.getNumBits());
+
+    Util::BitSet keys;
+
+    for (std::size_t i = 0; i < targets.size(); i++) {
+        index.getKeys(i, keys);
+
+        BOOST_CHECK(keys == tgt_keys[i]);
+    }
+
+    index.close();
+
+    BOOST_CHECK(!index.isOpen());
+}
@@ -0,0 +1,162 @@
+/* 
+ * SubstructureSearchTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/Fragment.hpp"
+#include "CDPL/Chem/UtilityFunctions.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Chem/SubstructureSearch.hpp"
+
+
+namespace
+{
+
+    bool checkMappings(const CDPL::Chem::SubstructureSearch& sub_srch, const CDPL::Chem::MolecularGraph& query,
+                       const CDPL::Chem::MolecularGraph& target)
+    {
+        using namespace CDPL;
+        using namespace Chem;
+
+        for (const AtomBondMapping& mapping : sub_srch) {
+            if (mapping.getAtomMapping().getSize() != query.getNumAtoms())
+                return false;
+
+            if (mapping.getBondMapping().getSize() != query.getNumBonds())
+                return false;
+
+            for (const auto& entry : mapping.getAtomMapping())
+                if (!target.containsAtom(*entry.second))
+                    return false;
+
+            for (const auto& entry : mapping.getBondMapping()) {
+                if (!target.containsBond(*entry.second))
+                    return false;
+
+                const Atom* tgt_atom1 = mapping.getAtomMapping().getValue(&entry.first->getBegin());
+                const Atom* tgt_atom2 = mapping.getAtomMapping().getValue(&entry.first->getEnd());
+
+                if (!((&entry.second->getBegin() == tgt_atom1 && &entry.second->getEnd() == tgt_atom2) ||
+                      (&entry.second->getBegin() == tgt_atom2 && &entry.second->getEnd() == tgt_atom1)))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(SubstructureSearchTest)
+{
+    using namespace CDPL;
+    using namespace Chem;
+
+    BasicMolecule tgt_mol;
+    
+    BOOST_CHECK(parseSMILES("c1ccc2ccccc2c1CCO", tgt_mol));
+
+    initSubstructureSearchTarget(tgt_mol, false);
+
+    MolecularGraph::SharedPointer qry_ptr = parseSMARTS("c1ccccc1");
+    SubstructureSearch sub_srch(*qry_ptr);
+
+// -- Whole molecule target --
+
+    BOOST_CHECK(sub_srch.mappingExists(tgt_mol));
+    BOOST_CHECK(sub_srch.getNumMappings() == 0);
+
+    BOOST_CHECK(sub_srch.findMappings(tgt_mol));
+    BOOST_CHECK(sub_srch.getNumMappings() == 24);
+    BOOST_CHECK(checkMappings(sub_srch, *qry_ptr, tgt_mol));
+
+    sub_srch.uniqueMappingsOnly(true);
+
+    BOOST_CHECK(sub_srch.findMappings(tgt_mol));
+    BOOST_CHECK(sub_srch.getNumMappings() == 2);
+    BOOST_CHECK(checkMappings(sub_srch, *qry_ptr, tgt_mol));
+
+    sub_srch.uniqueMappingsOnly(false);
+    sub_srch.setMaxNumMappings(5);
+
+    BOOST_CHECK(sub_srch.findMappings(tgt_mol));
+    BOOST_CHECK(sub_srch.getNumMappings() == 5);
+
+    sub_srch.setMaxNumMappings(0);
+
+// -- Fragment target covering a single ring and the side chain --
+
+    Fragment frag;
+
+    for (std::size_t i = 0; i < tgt_mol.getNumBonds(); i++) {
+        const Bond& bond = tgt_mol.getBond(i);
+        std::size_t atom1_idx = tgt_mol.getAtomIndex(bond.getBegin());
+        std::size_t atom2_idx = tgt_mol.getAtomIndex(bond.getEnd());
+
+        if ((atom1_idx <= 3 || atom1_idx >= 8) && (atom2_idx <= 3 || atom2_idx >= 8))
+            frag.addBond(bond);
+    }
+
+    BOOST_CHECK(frag.getNumAtoms() == 9);
+    BOOST_CHECK(frag.getNumBonds() == 9);
+
+    BOOST_CHECK(sub_srch.findMappings(frag));
+    BOOST_CHECK(sub_srch.getNumMappings() == 12);
+    BOOST_CHECK(checkMappings(sub_srch, *qry_ptr, frag));
+
+// -- Query change and reuse of the search instance for several targets --
+
+    MolecularGraph::SharedPointer chain_qry_ptr = parseSMARTS("cCCO");
+
+    sub_srch.setQuery(*chain_qry_ptr);
+
+    BOOST_CHECK(sub_srch.findMappings(frag));
+    BOOST_CHECK(sub_srch.getNumMappings() == 1);
+    BOOST_CHECK(checkMappings(sub_srch, *chain_qry_ptr, frag));
+
+    BOOST_CHECK(sub_srch.findMappings(tgt_mol));
+    BOOST_CHECK(sub_srch.getNumMappings() == 1);
+    BOOST_CHECK(checkMappings(sub_srch, *chain_qry_ptr, tgt_mol));
+
+    BasicMolecule tgt_mol2;
+
+    BOOST_CHECK(parseSMILES("OCCc1ccccc1CCO", tgt_mol2));
+
+    initSubstructureSearchTarget(tgt_mol2, false);
+
+    BOOST_CHECK(sub_srch.findMappings(tgt_mol2));
+    BOOST_CHECK(sub_srch.getNumMappings() == 2);
+    BOOST_CHECK(checkMappings(sub_srch, *chain_qry_ptr, tgt_mol2));
+
+// -- Atom mapping constraints --
+
+    sub_srch.addAtomMappingConstraint(3, 0);
+
+    BOOST_CHECK(sub_srch.findMappings(tgt_mol2));
+    BOOST_CHECK(sub_srch.getNumMappings() == 1);
+    BOOST_CHECK(sub_srch.getMapping(0).getAtomMapping().getValue(&chain_qry_ptr->getAtom(3)) == &tgt_mol2.getAtom(0));
+
+    sub_srch.clearAtomMappingConstraints();
+}
@@ -26,6 +26,7 @@
 
 #include "CDPL/Chem/XYZMoleculeReader.hpp"
 #include "CDPL/Chem/Molecule.hpp"
+#include "CDPL/Chem/ControlParameterFunctions.hpp"
 #include "CDPL/Base/Exceptions.hpp"
 
 #include "XYZDataReader.hpp"
@@ -68,3 +69,10 @@ bool Chem::XYZMoleculeReader::moreData(std::istream& is)
 {
     return reader->hasMoreData(is);
 }
+
+std::string Chem::XYZMoleculeReader::getRecordLayoutSettings() const
+{
+    // consecutive records get merged if multi-conformer import is enabled
+
+    return (getMultiConfImportParameter(*this) ? "multi-conf" : "");
+}
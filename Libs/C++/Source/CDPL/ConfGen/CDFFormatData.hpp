@@ -41,8 +41,9 @@ namespace CDPL
 
             using namespace Internal::CDF;
 
-            const std::uint8_t FRAGLIB_DATA_RECORD_ID = 6;
-            const std::uint8_t CURR_FORMAT_VERSION    = 1;
+            const std::uint8_t FRAGLIB_DATA_RECORD_ID  = 6;
+            const std::uint8_t FRAGLIB_INDEX_RECORD_ID = 7;
+            const std::uint8_t CURR_FORMAT_VERSION     = 1;
         } // namespace CDF
     } // namespace ConfGen
 } // namespace CDPL
@@ -27,6 +27,7 @@
 #include <cstddef>
 
 #include "CDPL/ConfGen/FragmentLibraryEntry.hpp"
+#include "CDPL/Base/Exceptions.hpp"
 
 #include "CFLFragmentLibraryEntryReader.hpp"
 #include "CDFFormatData.hpp"
@@ -60,7 +61,45 @@ bool ConfGen::CFLFragmentLibraryEntryReader::read(std::istream& is, FragmentLibr
         return false;
 
     readData(is, header.recordDataLength, entryBuffer);
+    getEntry(entry);
 
+    return true;
+}
+
+bool ConfGen::CFLFragmentLibraryEntryReader::read(const char* data, std::size_t size, FragmentLibraryEntry& entry)
+{
+    CDF::Header header;
+
+    if (size < CDF::HEADER_SIZE) {
+        if (strictErrorChecking())
+            throw Base::IOError("CFLFragmentLibraryEntryReader: could not read CDF-header, unexpected end of data");
+
+        return false;
+    }
+
+    entryBuffer.wrap(data, CDF::HEADER_SIZE);
+
+    if (!getHeader(header, entryBuffer))
+        return false;
+
+    if (header.recordTypeID != CDF::FRAGLIB_DATA_RECORD_ID) {
+        if (strictErrorChecking())
+            throw Base::IOError("CFLFragmentLibraryEntryReader: invalid CDF-record type");
+
+        return false;
+    }
+
+    if (header.recordDataLength > (size - CDF::HEADER_SIZE))
+        throw Base::IOError("CFLFragmentLibraryEntryReader: could not read CDF-record data, unexpected end of data");
+
+    entryBuffer.wrap(data + CDF::HEADER_SIZE, header.recordDataLength);
+    getEntry(entry);
+
+    return true;
+}
+
+void ConfGen::CFLFragmentLibraryEntryReader::getEntry(FragmentLibraryEntry& entry)
+{
     std::uint64_t hash_code;
     CDF::SizeType num_confs;
     std::string smiles;
@@ -95,6 +134,4 @@ bool ConfGen::CFLFragmentLibraryEntryReader::read(std::istream& is, FragmentLibr
 
         entry.addConformer(conf_data);
     }
-
-    return true;
 }
@@ -26,6 +26,7 @@
 #define CDPL_CONFGEN_CFLFRAGMENTLIBRARYENTRYREADER_HPP
 
 #include <iosfwd>
+#include <cstddef>
 
 #include "CDPL/Internal/CDFDataReaderBase.hpp"
 #include "CDPL/Internal/ByteBuffer.hpp"
@@ -51,7 +52,11 @@ namespace CDPL
 
             bool read(std::istream& is, FragmentLibraryEntry& entry);
 
+            bool read(const char* data, std::size_t size, FragmentLibraryEntry& entry);
+
           private:
+            void getEntry(FragmentLibraryEntry& entry);
+
             Internal::ByteBuffer entryBuffer;
         };
     } // namespace ConfGen
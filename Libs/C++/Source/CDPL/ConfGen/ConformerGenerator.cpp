@@ -81,6 +81,16 @@ const ConfGen::CallbackFunction& ConfGen::ConformerGenerator::getAbortCallback()
     return impl->getAbortCallback();
 }
 
+void ConfGen::ConformerGenerator::setThreadPool(const Util::ThreadPool::SharedPointer& pool)
+{
+    impl->setThreadPool(pool);
+}
+
+const Util::ThreadPool::SharedPointer& ConfGen::ConformerGenerator::getThreadPool() const
+{
+    return impl->getThreadPool();
+}
+
 void ConfGen::ConformerGenerator::setTimeoutCallback(const CallbackFunction& func)
 {
     impl->setTimeoutCallback(func);
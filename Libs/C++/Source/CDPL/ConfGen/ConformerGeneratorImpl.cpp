@@ -28,6 +28,8 @@
 #include <algorithm>
 #include <iterator>
 #include <functional>
+#include <thread>
+#include <chrono>
 
 #include <boost/format.hpp>
 
@@ -94,21 +96,62 @@ namespace
     constexpr double      FRAG_CONF_COMBINATIONS_E_WINDOW_FACTOR = 1.5;
     constexpr double      CONF_DUPLICATE_ENERGY_TOLERANCE        = 0.01;
     constexpr double      ELASTIC_POTENTIAL_FORCE_CONST          = 500.0;
+    constexpr std::size_t CALLBACK_POLLING_INTERVAL              = 20; // ms
+}
+
+
+ConfGen::ConformerGeneratorImpl::SamplingWorker::SamplingWorker(ConformerGeneratorImpl& parent):
+    dgStructureGen(&parent.dgStructureGen),
+    energyMinimizer(std::bind(&ConformerGeneratorImpl::calcEnergy, &parent, std::ref(*this), std::placeholders::_1),
+                    std::bind(&ConformerGeneratorImpl::calcGradient, &parent, std::ref(*this), std::placeholders::_1, std::placeholders::_2))
+{
+    hCoordsCalc.undefinedOnly(true);
+    hCoordsCalc.setAtom3DCoordinatesCheckFunction(std::bind(&ConformerGeneratorImpl::has3DCoordinates, &parent, std::placeholders::_1));
+}
+
+
+ConfGen::ConformerGeneratorImpl::FragmentConfGenJob::FragmentConfGenJob(ConformerGeneratorImpl& parent):
+    fragConfData(0), numSplitBonds(0), finished(false)
+{
+    torDriver.setAbortCallback(std::bind(&ConformerGeneratorImpl::workerAborted, &parent));
+    torDriver.setTimeoutCallback(std::bind(&ConformerGeneratorImpl::workerTimedout, &parent));
+}
+
+void ConfGen::ConformerGeneratorImpl::FragmentConfGenJob::appendSetupLogMessage(const std::string& msg)
+{
+    setupLogMessages.append(msg);
+}
+
+
+ConfGen::ConformerGeneratorImpl::FragmentConfGenWorker::FragmentConfGenWorker(ConformerGeneratorImpl& parent):
+    job(0)
+{
+    using namespace std::placeholders;
+
+    fragAssembler.setAbortCallback(std::bind(&ConformerGeneratorImpl::workerAborted, &parent));
+    fragAssembler.setTimeoutCallback(std::bind(&ConformerGeneratorImpl::workerTimedout, &parent));
+    fragAssembler.setBondLengthFunction(std::bind(&ConformerGeneratorImpl::getMMFF94BondLength, &parent, _1, _2));
+}
+
+void ConfGen::ConformerGeneratorImpl::FragmentConfGenWorker::appendLogMessage(const std::string& msg)
+{
+    if (job)
+        job->logMessages.append(msg);
 }
 
 
 ConfGen::ConformerGeneratorImpl::ConformerGeneratorImpl():
     confDataCache(MAX_CONF_DATA_CACHE_SIZE), fragConfDataCache(MAX_FRAG_CONF_DATA_CACHE_SIZE),
     confCombDataCache(MAX_FRAG_CONF_COMBINATION_CACHE_SIZE), settings(ConformerGeneratorSettings::DEFAULT),
-    energyMinimizer(std::bind(&ConformerGeneratorImpl::calcEnergy, this, std::placeholders::_1),
-                    std::bind(&ConformerGeneratorImpl::calcGradient, this, std::placeholders::_1, std::placeholders::_2)) 
+    mainSamplingWorker(*this), mainFragConfGenWorker(*this), numFragConfGenJobs(0), workerStopCode(ReturnCode::SUCCESS)
 {
     using namespace std::placeholders;
-    
-    fragAssembler.setTimeoutCallback(std::bind(&ConformerGeneratorImpl::timedout, this));
-    fragAssembler.setBondLengthFunction(std::bind(&ConformerGeneratorImpl::getMMFF94BondLength, this, _1, _2));
 
-    torDriver.setTimeoutCallback(std::bind(&ConformerGeneratorImpl::timedout, this));
+    fragLibs.push_back(FragmentLibrary::get());
+    torLibs.push_back(TorsionLibrary::get());
+
+    torDriver.setAbortCallback(std::bind(&ConformerGeneratorImpl::workerAborted, this));
+    torDriver.setTimeoutCallback(std::bind(&ConformerGeneratorImpl::workerTimedout, this));
 
     confSelector.setAbortCallback(std::bind(&ConformerGeneratorImpl::rmsdConfSelectorAbortCallback, this));
     confSelector.setMaxNumSymmetryMappings(MAX_NUM_SYMMETRY_MAPPINGS + 1);
@@ -120,9 +163,6 @@ ConfGen::ConformerGeneratorImpl::ConformerGeneratorImpl():
 
     fragConfDataCache.setCleanupFunction(std::bind(&FragmentConfData::clear, _1));
 
-    hCoordsCalc.undefinedOnly(true);
-    hCoordsCalc.setAtom3DCoordinatesCheckFunction(std::bind(&ConformerGeneratorImpl::has3DCoordinates, this, _1));
-
     DGStructureGeneratorSettings& dg_settings = dgStructureGen.getSettings();
 
     dg_settings.excludeHydrogens(true);
@@ -140,30 +180,29 @@ ConfGen::ConformerGeneratorSettings& ConfGen::ConformerGeneratorImpl::getSetting
 
 void ConfGen::ConformerGeneratorImpl::clearFragmentLibraries()
 {
-    fragAssembler.clearFragmentLibraries();
+    fragLibs.clear();
 }
 
 void ConfGen::ConformerGeneratorImpl::addFragmentLibrary(const FragmentLibrary::SharedPointer& lib)
 {
-    fragAssembler.addFragmentLibrary(lib);
+    fragLibs.push_back(lib);
 }
 
 void ConfGen::ConformerGeneratorImpl::clearTorsionLibraries()
 {
+    torLibs.clear();
     torDriver.clearTorsionLibraries();
 }
 
 void ConfGen::ConformerGeneratorImpl::addTorsionLibrary(const TorsionLibrary::SharedPointer& lib)
 {
+    torLibs.push_back(lib);
     torDriver.addTorsionLibrary(lib);
 }
 
 void ConfGen::ConformerGeneratorImpl::setAbortCallback(const CallbackFunction& func)
 {
     abortCallback = func;
-
-    fragAssembler.setAbortCallback(func);
-    torDriver.setAbortCallback(func);
 }
 
 const ConfGen::CallbackFunction& ConfGen::ConformerGeneratorImpl::getAbortCallback() const
@@ -171,6 +210,16 @@ const ConfGen::CallbackFunction& ConfGen::ConformerGeneratorImpl::getAbortCallba
     return abortCallback;
 }
 
+void ConfGen::ConformerGeneratorImpl::setThreadPool(const Util::ThreadPool::SharedPointer& pool)
+{
+    threadPool = pool;
+}
+
+const Util::ThreadPool::SharedPointer& ConfGen::ConformerGeneratorImpl::getThreadPool() const
+{
+    return threadPool;
+}
+
 void ConfGen::ConformerGeneratorImpl::setTimeoutCallback(const CallbackFunction& func)
 {
     timeoutCallback = func;
@@ -186,7 +235,6 @@ void ConfGen::ConformerGeneratorImpl::setLogMessageCallback(const LogMessageCall
     logCallback = func;
 
     torDriver.setLogMessageCallback(func);
-    fragAssembler.setLogMessageCallback(func);
 }
 
 const ConfGen::LogMessageCallbackFunction& ConfGen::ConformerGeneratorImpl::getLogMessageCallback() const
@@ -203,6 +251,9 @@ unsigned int ConfGen::ConformerGeneratorImpl::generate(const Chem::MolecularGrap
     const FragmentList& comps = *getComponents(molgraph);
     unsigned int ret_code = ReturnCode::SUCCESS;
 
+    callerThreadID = std::this_thread::get_id();
+    workerStopCode = ReturnCode::SUCCESS;
+
     if (molgraph.getNumAtoms() == 0 || comps.isEmpty()) {
         outputConfs.clear();
 
@@ -533,7 +584,9 @@ unsigned int ConfGen::ConformerGeneratorImpl::generateConformersSystematic(bool
 
     td_settings.setMaxPoolSize(settings.getMaxPoolSize());
     td_settings.setEnergyWindow(eWindow);
+    td_settings.packedForceFieldEvaluation(settings.packedForceFieldEvaluation());
 
+    setupTaskScheduler();
     splitIntoTorsionFragments();
 
     unsigned int ret_code = generateFragmentConformers(struct_gen_only);
@@ -570,89 +623,104 @@ unsigned int ConfGen::ConformerGeneratorImpl::generateConformersStochastic(bool
 
     dgStructureGen.getSettings().setBoxSize(coreAtomMask.size() * 0.5);
 
-    hCoordsCalc.setup(*molGraph);
+    setupSamplingWorker(mainSamplingWorker, num_atoms);
 
-    mmff94GradientCalc.setup(mmff94Data, num_atoms);
-    mmff94GradientCalc.resetFixedAtomMask();
+    SamplingState state;
 
-    energyGradient.resize(num_atoms);
+    state.retCode = ReturnCode::SUCCESS;
+    state.done = false;
+    state.minEnergy = 0.0;
+    state.numSamples = 0;
+    state.numStructGenFails = 0;
+    state.numNewUniqueConfs = 0;
+    state.lastUniqueConfCount = 0;
 
-    double min_energy = 0.0;
-    ConformerData::SharedPointer conf_data_ptr;
-    unsigned int ret_code = ReturnCode::SUCCESS;
-    std::size_t conv_cycle_size = settings.getConvergenceCheckCycleSize();
-    std::size_t max_num_conf_samples = settings.getMaxNumSampledConformers();
-    std::size_t i = 0;
-    std::size_t num_new_unique_confs = 0;
-    std::size_t last_unique_conf_count = 0;
-    std::size_t num_struct_gen_fails = 0;
-            
     if (logCallback) 
         logCallback(struct_gen_only ? "Performing distance geometry based structure generation...\n" : "Performing stochastic conformer sampling...\n");
 
-    while (max_num_conf_samples == 0 || i < max_num_conf_samples) {
-        if ((ret_code = invokeCallbacks()) != ReturnCode::SUCCESS)
-            return ret_code;
+    std::size_t num_threads = settings.getNumThreads();
 
-        if (!conf_data_ptr) {
-            conf_data_ptr = confDataCache.get();
-            conf_data_ptr->resize(num_atoms);
-        }
+    if (num_threads > 1 && threadPool) {
+        // the calling thread takes part in the sampling and gets assisted by the currently idle threads of the pool
 
-        ConformerData& conf_data = *conf_data_ptr;
-        std::size_t j = 0;
+        initSamplingWorkers(std::min(num_threads - 1, threadPool->getNumIdleThreads()), num_atoms);
 
-        for ( ; j < MAX_NUM_STRUCTURE_GEN_TRIALS; j++) {
-            if (!dgStructureGen.generate(conf_data)) 
-                continue;
+        state.numPoolWorkers = 0;
 
-            if (!generateHydrogenCoordsAndMinimize(conf_data))
-                continue;
+        for (auto& worker : samplingWorkers) {
+            SamplingWorker* worker_ptr = worker.get();
+            SamplingState* state_ptr = &state;
 
-            if (!dgStructureGen.checkAtomConfigurations(conf_data)) 
-                continue;
+            {
+                std::lock_guard<std::mutex> lock(state.mutex);
 
-            if (!dgStructureGen.checkBondConfigurations(conf_data)) 
+                state.numPoolWorkers++;
+            }
+
+            bool started = threadPool->tryExecute([this, worker_ptr, state_ptr]() {
+                runSamplingWorker(*worker_ptr, *state_ptr);
+
+                std::lock_guard<std::mutex> lock(state_ptr->mutex);
+
+                if (--state_ptr->numPoolWorkers == 0)
+                    state_ptr->poolWorkerCondition.notify_all();
+            });
+
+            if (started)
                 continue;
 
+            // the idle threads have been taken by other users of the pool in the meantime
+
+            std::lock_guard<std::mutex> lock(state.mutex);
+
+            state.numPoolWorkers--;
             break;
         }
 
-        if (j == MAX_NUM_STRUCTURE_GEN_TRIALS) {
-            if (++num_struct_gen_fails == MAX_NUM_STRUCTURE_GEN_FAILS) {
-                if (logCallback) 
-                    logCallback("Could not generate any valid structure after " + std::to_string(num_struct_gen_fails) + 
-                                " consecutive trials - giving up!\n");
-                break;
-            }
+        runSamplingWorker(mainSamplingWorker, state);
 
-            continue;
-        }
+        std::unique_lock<std::mutex> lock(state.mutex);
 
-        num_struct_gen_fails = 0;
-        i++;
-        
-        double energy = conf_data.getEnergy();
+        state.poolWorkerCondition.wait(lock, [&state]() { return (state.numPoolWorkers == 0); });
 
-        if (workingConfs.empty() || energy < min_energy)
-            min_energy = energy;
+    } else if (num_threads > 1) {
+        // the calling thread takes part in the sampling
 
-        if (energy <= min_energy + eWindow) {
-            workingConfs.push_back(conf_data_ptr);
-            conf_data_ptr.reset();
-        }
-        
-        if (i % conv_cycle_size == 0) {
-            removeWorkingConfDuplicates();
+        initSamplingWorkers(num_threads - 1, num_atoms);
 
-            num_new_unique_confs = workingConfs.size() - last_unique_conf_count;
-            last_unique_conf_count = workingConfs.size();
-            
-            if (num_new_unique_confs == 0)
-                break;
+        std::vector<std::thread> threads;
+
+        try {
+            for (auto& worker : samplingWorkers)
+                threads.emplace_back(&ConformerGeneratorImpl::runSamplingWorker, this, std::ref(*worker), std::ref(state));
+
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(state.mutex);
+
+            state.exception = std::current_exception();
+            state.done = true;
         }
-    }
-    
+
+        runSamplingWorker(mainSamplingWorker, state);
+
+        for (auto& thread : threads)
+            thread.join();
+
+    } else
+        runSamplingWorker(mainSamplingWorker, state);
+
+    if (logCallback && !state.logMessages.empty())
+        logCallback(state.logMessages);
+
+    if (state.exception)
+        std::rethrow_exception(state.exception);
+
+    if (state.retCode != ReturnCode::SUCCESS)
+        return state.retCode;
+
+    double min_energy = state.minEnergy;
+    std::size_t conv_cycle_size = settings.getConvergenceCheckCycleSize();
+
     for (ConformerDataArray::const_iterator it = workingConfs.begin(), end = workingConfs.end(); it != end; ++it) {
         const ConformerData::SharedPointer& conf = *it;
 
@@ -667,21 +735,174 @@ unsigned int ConfGen::ConformerGeneratorImpl::generateConformersStochastic(bool
                 
     if (logCallback) {
         logCallback((struct_gen_only ? "Distance geometry based structure generation terminated after " : "Stochastic conformer sampling terminated after ") +
-                    std::to_string(i) + " iteration(s)\n");
+                    std::to_string(state.numSamples) + " iteration(s)\n");
 
         if (!struct_gen_only) {
             logCallback("Generated " + std::to_string(workingConfs.size()) + " conformer(s) within energy window\n");
-            logCallback((boost::format("%.1f") % (100.0 * double(conv_cycle_size - num_new_unique_confs) / conv_cycle_size)).str() + "% convergence reached\n");
+            logCallback((boost::format("%.1f") % (100.0 * double(conv_cycle_size - state.numNewUniqueConfs) / conv_cycle_size)).str() + "% convergence reached\n");
         }
-
-    
-        if (ret_code == ReturnCode::TIMEOUT && workingConfs.empty())
-            logCallback("Time limit exceeded!\n");
     }
     
     return (workingConfs.empty() ? ReturnCode::CONF_GEN_FAILED : ReturnCode::SUCCESS);
 }
 
+void ConfGen::ConformerGeneratorImpl::setupSamplingWorker(SamplingWorker& worker, std::size_t num_atoms)
+{
+    worker.hCoordsCalc.setup(*molGraph);
+
+    worker.mmff94GradientCalc.setup(mmff94Data, num_atoms, settings.packedForceFieldEvaluation());
+    worker.mmff94GradientCalc.resetFixedAtomMask();
+
+    worker.energyGradient.resize(num_atoms);
+}
+
+void ConfGen::ConformerGeneratorImpl::initSamplingWorkers(std::size_t num_workers, std::size_t num_atoms)
+{
+    if (samplingWorkers.size() > num_workers)
+        samplingWorkers.resize(num_workers);
+
+    while (samplingWorkers.size() < num_workers)
+        samplingWorkers.emplace_back(new SamplingWorker(*this));
+
+    for (std::size_t i = 0; i < num_workers; i++) {
+        SamplingWorker& worker = *samplingWorkers[i];
+
+        // each worker operates on a copy of the set up structure generator with a different random seed
+
+        worker.localDGStructureGen = dgStructureGen;
+        worker.localDGStructureGen.setRandomSeed(dgStructureGen.getRandomSeed() + i + 1);
+        worker.dgStructureGen = &worker.localDGStructureGen;
+
+        setupSamplingWorker(worker, num_atoms);
+    }
+}
+
+void ConfGen::ConformerGeneratorImpl::runSamplingWorker(SamplingWorker& worker, SamplingState& state)
+{
+    try {
+        sampleConformers(worker, state);
+
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        if (!state.exception)
+            state.exception = std::current_exception();
+
+        state.done = true;
+    }
+
+    // conformer data objects must be returned to the cache under the lock
+    std::lock_guard<std::mutex> lock(state.mutex);
+
+    worker.confData.reset();
+}
+
+void ConfGen::ConformerGeneratorImpl::sampleConformers(SamplingWorker& worker, SamplingState& state)
+{
+    std::size_t num_atoms = molGraph->getNumAtoms();
+    bool main_worker = (&worker == &mainSamplingWorker);
+
+    while (true) {
+        // user callbacks must only be invoked from the calling thread
+
+        unsigned int ret_code = (main_worker ? invokeCallbacks() : ReturnCode::SUCCESS);
+
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+
+            if (state.done)
+                return;
+
+            if (ret_code != ReturnCode::SUCCESS) {
+                state.retCode = ret_code;
+                state.done = true;
+                return;
+            }
+
+            if (!worker.confData) {
+                worker.confData = confDataCache.get();
+                worker.confData->resize(num_atoms);
+            }
+        }
+
+        bool success = generateStructure(worker, *worker.confData);
+
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        if (state.done)
+            return;
+
+        if (!processSamplingResult(state, worker.confData, success)) {
+            state.done = true;
+            return;
+        }
+    }
+}
+
+bool ConfGen::ConformerGeneratorImpl::processSamplingResult(SamplingState& state, ConformerData::SharedPointer& conf_data_ptr, bool success)
+{
+    if (!success) {
+        if (++state.numStructGenFails == MAX_NUM_STRUCTURE_GEN_FAILS) {
+            // may be called by any sampling thread -> message gets logged by the calling thread after sampling has finished
+
+            if (logCallback) 
+                state.logMessages.append("Could not generate any valid structure after " + std::to_string(state.numStructGenFails) + 
+                                         " consecutive trials - giving up!\n");
+            return false;
+        }
+
+        return true;
+    }
+
+    state.numStructGenFails = 0;
+    state.numSamples++;
+        
+    double energy = conf_data_ptr->getEnergy();
+
+    if (workingConfs.empty() || energy < state.minEnergy)
+        state.minEnergy = energy;
+
+    if (energy <= state.minEnergy + eWindow) {
+        workingConfs.push_back(conf_data_ptr);
+        conf_data_ptr.reset();
+    }
+        
+    if (state.numSamples % settings.getConvergenceCheckCycleSize() == 0) {
+        removeWorkingConfDuplicates();
+
+        state.numNewUniqueConfs = workingConfs.size() - state.lastUniqueConfCount;
+        state.lastUniqueConfCount = workingConfs.size();
+            
+        if (state.numNewUniqueConfs == 0)
+            return false;
+    }
+
+    std::size_t max_num_conf_samples = settings.getMaxNumSampledConformers();
+
+    return (max_num_conf_samples == 0 || state.numSamples < max_num_conf_samples);
+}
+
+bool ConfGen::ConformerGeneratorImpl::generateStructure(SamplingWorker& worker, ConformerData& conf_data)
+{
+    for (std::size_t i = 0; i < MAX_NUM_STRUCTURE_GEN_TRIALS; i++) {
+        if (!worker.dgStructureGen->generate(conf_data)) 
+            continue;
+
+        if (!generateHydrogenCoordsAndMinimize(worker, conf_data))
+            continue;
+
+        if (!worker.dgStructureGen->checkAtomConfigurations(conf_data)) 
+            continue;
+
+        if (!worker.dgStructureGen->checkBondConfigurations(conf_data)) 
+            continue;
+
+        return true;
+    }
+
+    return false;
+}
+
 void ConfGen::ConformerGeneratorImpl::removeWorkingConfDuplicates()
 {
     double last_energy = 0.0;
@@ -770,19 +991,19 @@ unsigned int ConfGen::ConformerGeneratorImpl::perceiveRotBonds()
     return ReturnCode::SUCCESS;
 }
 
-bool ConfGen::ConformerGeneratorImpl::generateHydrogenCoordsAndMinimize(ConformerData& conf_data)
+bool ConfGen::ConformerGeneratorImpl::generateHydrogenCoordsAndMinimize(SamplingWorker& worker, ConformerData& conf_data)
 {
-    hCoordsCalc.calculate(conf_data, false);
+    worker.hCoordsCalc.calculate(conf_data, false);
 
     Math::Vector3DArray::StorageType& conf_coords_data = conf_data.getData();
     std::size_t max_ref_iters = settings.getMaxNumRefinementIterations();
     double ref_tol = settings.getRefinementTolerance();
     double energy = 0.0;
 
-    energyMinimizer.setup(conf_coords_data, energyGradient, 0.001, 0.25);
+    worker.energyMinimizer.setup(conf_coords_data, worker.energyGradient, 0.001, 0.25);
 
     for (std::size_t j = 0; max_ref_iters == 0 || j < max_ref_iters; j++) {
-        if (energyMinimizer.iterate(energy, conf_coords_data, energyGradient) != BFGSMinimizer::SUCCESS) {
+        if (worker.energyMinimizer.iterate(energy, conf_coords_data, worker.energyGradient) != BFGSMinimizer::SUCCESS) {
             if (std::isnan(energy)) 
                 return false;
 
@@ -792,34 +1013,34 @@ bool ConfGen::ConformerGeneratorImpl::generateHydrogenCoordsAndMinimize(Conforme
         if (std::isnan(energy)) 
             return false;
         
-        if (energyMinimizer.getFunctionDelta() < ref_tol)
+        if (worker.energyMinimizer.getFunctionDelta() < ref_tol)
             break;
     }
 
     if (!elasticPotentials.isEmpty())
-        conf_data.setEnergy(mmff94GradientCalc(conf_coords_data));
+        conf_data.setEnergy(worker.mmff94GradientCalc(conf_coords_data));
     else
         conf_data.setEnergy(energy);
 
     return true;
 }
 
-double ConfGen::ConformerGeneratorImpl::calcEnergy(const Math::Vector3DArray::StorageType& coords)
+double ConfGen::ConformerGeneratorImpl::calcEnergy(SamplingWorker& worker, const Math::Vector3DArray::StorageType& coords)
 {
     if (elasticPotentials.isEmpty())
-        return mmff94GradientCalc(coords);
+        return worker.mmff94GradientCalc(coords);
                 
-    return (mmff94GradientCalc(coords) +
+    return (worker.mmff94GradientCalc(coords) +
             ForceField::calcElasticPotentialEnergy<double>(elasticPotentials.getElementsBegin(),
                                                            elasticPotentials.getElementsEnd(), coords));
 }
 
-double ConfGen::ConformerGeneratorImpl::calcGradient(const Math::Vector3DArray::StorageType& coords, Math::Vector3DArray::StorageType& grad)
+double ConfGen::ConformerGeneratorImpl::calcGradient(SamplingWorker& worker, const Math::Vector3DArray::StorageType& coords, Math::Vector3DArray::StorageType& grad)
 {
      if (elasticPotentials.isEmpty())
-         return mmff94GradientCalc(coords, grad);
+         return worker.mmff94GradientCalc(coords, grad);
 
-     return (mmff94GradientCalc(coords, grad) +
+     return (worker.mmff94GradientCalc(coords, grad) +
             ForceField::calcElasticPotentialGradient<double>(elasticPotentials.getElementsBegin(),
                                                              elasticPotentials.getElementsEnd(), coords, grad));
 }
@@ -877,17 +1098,19 @@ ConfGen::ConformerData::SharedPointer ConfGen::ConformerGeneratorImpl::getInputC
         }
     } 
 
-    mmff94GradientCalc.setup(mmff94Data, num_atoms);
+    SamplingWorker& worker = mainSamplingWorker;
+
+    worker.mmff94GradientCalc.setup(mmff94Data, num_atoms, settings.packedForceFieldEvaluation());
 
     if (!coords_compl) {
-        mmff94GradientCalc.setFixedAtomMask(coreAtomMask);
-        energyGradient.resize(num_atoms);
-        hCoordsCalc.setup(*molGraph);
+        worker.mmff94GradientCalc.setFixedAtomMask(coreAtomMask);
+        worker.energyGradient.resize(num_atoms);
+        worker.hCoordsCalc.setup(*molGraph);
 
         if (logCallback)
             logCallback("Using provided input coordinates, generating missing hydrogen coordinates\n");
 
-        if (!generateHydrogenCoordsAndMinimize(*ipt_coords)) {
+        if (!generateHydrogenCoordsAndMinimize(worker, *ipt_coords)) {
             if (logCallback)
                 logCallback("Generation of hydrogen coordinates failed!\n");
 
@@ -898,7 +1121,7 @@ ConfGen::ConformerData::SharedPointer ConfGen::ConformerGeneratorImpl::getInputC
         if (logCallback)
             logCallback("Using provided input coordinates\n");
 
-        ipt_coords->setEnergy(mmff94GradientCalc(ipt_coords_data));
+        ipt_coords->setEnergy(worker.mmff94GradientCalc(ipt_coords_data));
     }
 
     return ipt_coords;
@@ -991,32 +1214,123 @@ bool ConfGen::ConformerGeneratorImpl::setupMMFF94Parameters(unsigned int ff_type
     return false;
 }
 
+void ConfGen::ConformerGeneratorImpl::setupTaskScheduler()
+{
+    std::size_t num_threads = settings.getNumThreads();
+
+    if (num_threads <= 1) {
+        taskScheduler.reset();
+        torDriver.setTaskScheduler(0);
+        return;
+    }
+
+    Util::ThreadPool::SharedPointer pool = threadPool;
+
+    if (!pool) {
+        // without a user-specified thread pool the additional threads are provided by a private one
+
+        if (!localThreadPool || localThreadPool->getNumThreads() != (num_threads - 1))
+            localThreadPool.reset(new Util::ThreadPool(num_threads - 1));
+
+        pool = localThreadPool;
+    }
+
+    taskScheduler.setup(pool, num_threads - 1);
+    torDriver.setTaskScheduler(&taskScheduler);
+}
+
 unsigned int ConfGen::ConformerGeneratorImpl::generateFragmentConformers(bool struct_gen_only)
 {
-    using namespace Chem;
+    prepareFragmentConfGenJobs();
 
-    torDriver.getSettings().sampleAngleToleranceRanges(false);
+    FragmentConfGenState state;
 
-    FragmentAssemblerSettings& fa_settings = fragAssembler.getSettings();
+    state.numPoolWorkers = 0;
+    state.nextJobIdx = 0;
+    state.nextLogJobIdx = 0;
+    state.retCode = ReturnCode::SUCCESS;
+    state.done = false;
 
-    fa_settings.getFragmentBuildSettings() = settings.getFragmentBuildSettings();
-    fa_settings.enumerateRings(settings.enumerateRings());
-    fa_settings.setNitrogenEnumerationMode(settings.getNitrogenEnumerationMode());
-    fa_settings.generateCoordinatesFromScratch(settings.generateCoordinatesFromScratch());
+    setupFragmentConfGenWorker(mainFragConfGenWorker);
 
-    for (FragmentConfDataList::const_iterator it = torFragConfData.begin(), end = torFragConfData.end(); it != end; ++it) {
-        FragmentConfData& frag_conf_data = **it;
-        Fragment& frag = *frag_conf_data.fragment;
+    if (numFragConfGenJobs > 1 && taskScheduler.isEnabled()) {
+        // the calling thread processes torsion fragments and gets assisted by the idle threads of the task scheduler
 
-        if (logCallback)
-            logCallback("Generating conformers for torsion fragment " + getSMILES(frag) + "...\n");
+        std::size_t num_workers = std::min(numFragConfGenJobs - 1, taskScheduler.getNumFreeSlots());
 
-        unsigned int ret_code = fragAssembler.assemble(frag, *molGraph, fixedSubstruct, fixedSubstructCoords);
+        while (fragConfGenWorkers.size() < num_workers)
+            fragConfGenWorkers.emplace_back(new FragmentConfGenWorker(*this));
 
-        if (ret_code != ReturnCode::SUCCESS) 
-            return ret_code;
+        for (std::size_t i = 0; i < num_workers; i++) {
+            FragmentConfGenWorker* worker_ptr = fragConfGenWorkers[i].get();
+            FragmentConfGenState* state_ptr = &state;
 
-        invertibleNMask |= fragAssembler.getInvertibleNitrogenMask();
+            setupFragmentConfGenWorker(*worker_ptr);
+
+            {
+                std::lock_guard<std::mutex> lock(state.mutex);
+
+                state.numPoolWorkers++;
+            }
+
+            bool started = taskScheduler.tryExecute([this, worker_ptr, state_ptr, struct_gen_only]() {
+                runFragmentConfGenWorker(*worker_ptr, *state_ptr, struct_gen_only);
+
+                std::lock_guard<std::mutex> lock(state_ptr->mutex);
+
+                state_ptr->numPoolWorkers--;
+                state_ptr->condition.notify_all();
+            });
+
+            if (started)
+                continue;
+
+            // the idle threads have been taken by other tasks in the meantime
+
+            std::lock_guard<std::mutex> lock(state.mutex);
+
+            state.numPoolWorkers--;
+            break;
+        }
+    }
+
+    runFragmentConfGenWorker(mainFragConfGenWorker, state, struct_gen_only);
+    waitForFragmentConfGenWorkers(state);
+    flushFragmentConfGenLogMessages(state);
+
+    if (state.exception)
+        std::rethrow_exception(state.exception);
+
+    return state.retCode;
+}
+
+void ConfGen::ConformerGeneratorImpl::prepareFragmentConfGenJobs()
+{
+    using namespace Chem;
+    using namespace std::placeholders;
+
+    TaskScheduler* scheduler = (taskScheduler.isEnabled() ? &taskScheduler : 0);
+
+    numFragConfGenJobs = torFragConfData.size();
+
+    while (fragConfGenJobs.size() < numFragConfGenJobs)
+        fragConfGenJobs.emplace_back(new FragmentConfGenJob(*this));
+
+    // the torsion drivers have to be set up in fragment order since the force field interactions get
+    // assigned to the first fragment containing all of the interaction's atoms
+
+    for (std::size_t i = 0; i < numFragConfGenJobs; i++) {
+        FragmentConfGenJob& job = *fragConfGenJobs[i];
+        FragmentConfData& frag_conf_data = *torFragConfData[i];
+        Fragment& frag = *frag_conf_data.fragment;
+
+        job.fragConfData = &frag_conf_data;
+        job.finished = false;
+        job.setupLogMessages.clear();
+        job.logMessages.clear();
+
+        if (logCallback)
+            job.logMessages.append("Generating conformers for torsion fragment " + getSMILES(frag) + "...\n");
 
         std::size_t num_bonds = frag.getNumBonds();
     
@@ -1024,8 +1338,8 @@ unsigned int ConfGen::ConformerGeneratorImpl::generateFragmentConformers(bool st
         tmpBitSet.reset();
         fragSplitBonds.clear();
 
-        for (std::size_t i = 0; i < num_bonds; i++) {
-            const Bond& bond = frag.getBond(i);
+        for (std::size_t j = 0; j < num_bonds; j++) {
+            const Bond& bond = frag.getBond(j);
 
             if (!rotBondMask.test(molGraph->getBondIndex(bond)))
                 continue;
@@ -1033,123 +1347,310 @@ unsigned int ConfGen::ConformerGeneratorImpl::generateFragmentConformers(bool st
             if (!isRotatableBond(bond, frag, false))
                 continue;
 
-            tmpBitSet.set(i);
+            tmpBitSet.set(j);
             fragSplitBonds.push_back(&bond);
         }
 
         if (fragSplitBonds.empty()) {
-            fragments.clear();
-            fragments.addElement(frag_conf_data.fragment);
+            job.fragments.clear();
+            job.fragments.addElement(frag_conf_data.fragment);
 
         } else 
-            Chem::splitIntoFragments(frag, fragments, tmpBitSet, false);
+            Chem::splitIntoFragments(frag, job.fragments, tmpBitSet, false);
 
-        if (logCallback && !fragSplitBonds.empty())
-            logCallback("Found " + std::to_string(fragSplitBonds.size()) + " rotatable fragment bond(s), performing torsion driving...\n");
+        job.numSplitBonds = fragSplitBonds.size();
 
-        torDriver.setup(fragments, *molGraph, fragSplitBonds.begin(), fragSplitBonds.end());
-        torDriver.setMMFF94Parameters(mmff94Data, mmff94InteractionMask);
+        TorsionDriverImpl& job_tor_driver = job.torDriver;
 
-        if (fragSplitBonds.empty()) {
-            FragmentTreeNode& frag_node = torDriver.getFragmentNode(0);
+        job_tor_driver.getSettings() = torDriver.getSettings();
+        job_tor_driver.getSettings().sampleAngleToleranceRanges(false);
+        job_tor_driver.clearTorsionLibraries();
 
-            for (FragmentAssemblerImpl::ConstConformerIterator conf_it = fragAssembler.getConformersBegin(), conf_end = fragAssembler.getConformersEnd();
-                 conf_it != conf_end; ++conf_it) {
+        for (const auto& lib : torLibs)
+            job_tor_driver.addTorsionLibrary(lib);
 
-                ConformerData& conf_data = **conf_it;
-                double energy = frag_node.calcMMFF94Energy(conf_data);
-                ConformerData::SharedPointer final_conf_data = confDataCache.get();
+        if (logCallback)
+            job_tor_driver.setLogMessageCallback(std::bind(&FragmentConfGenJob::appendSetupLogMessage, &job, _1));
+        else
+            job_tor_driver.setLogMessageCallback(LogMessageCallbackFunction());
+
+        job_tor_driver.setTaskScheduler(scheduler);
+        job_tor_driver.setup(job.fragments, *molGraph, fragSplitBonds.begin(), fragSplitBonds.end());
+        job_tor_driver.setMMFF94Parameters(mmff94Data, mmff94InteractionMask);
+    }
+}
+
+void ConfGen::ConformerGeneratorImpl::setupFragmentConfGenWorker(FragmentConfGenWorker& worker)
+{
+    using namespace std::placeholders;
+
+    FragmentAssemblerSettings& fa_settings = worker.fragAssembler.getSettings();
+
+    fa_settings.getFragmentBuildSettings() = settings.getFragmentBuildSettings();
+    fa_settings.enumerateRings(settings.enumerateRings());
+    fa_settings.setNitrogenEnumerationMode(settings.getNitrogenEnumerationMode());
+    fa_settings.generateCoordinatesFromScratch(settings.generateCoordinatesFromScratch());
+
+    worker.fragAssembler.clearFragmentLibraries();
+
+    for (const auto& lib : fragLibs)
+        worker.fragAssembler.addFragmentLibrary(lib);
+
+    if (logCallback)
+        worker.fragAssembler.setLogMessageCallback(std::bind(&FragmentConfGenWorker::appendLogMessage, &worker, _1));
+    else
+        worker.fragAssembler.setLogMessageCallback(LogMessageCallbackFunction());
+}
+
+void ConfGen::ConformerGeneratorImpl::runFragmentConfGenWorker(FragmentConfGenWorker& worker, FragmentConfGenState& state,
+                                                               bool struct_gen_only)
+{
+    bool main_worker = (&worker == &mainFragConfGenWorker);
 
-                final_conf_data->swap(conf_data);
-                final_conf_data->setEnergy(energy);
+    while (true) {
+        FragmentConfGenJob* job;
 
-                frag_conf_data.conformers.push_back(final_conf_data);
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+
+            if (state.done || state.nextJobIdx == numFragConfGenJobs)
+                return;
+
+            job = fragConfGenJobs[state.nextJobIdx++].get();
+        }
+
+        unsigned int ret_code = ReturnCode::SUCCESS;
+        std::exception_ptr exception;
+
+        worker.job = job;
+
+        try {
+            ret_code = generateFragmentConformers(worker, *job, state, struct_gen_only);
+
+        } catch (...) {
+            exception = std::current_exception();
+        }
+
+        worker.job = 0;
+
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+
+            job->finished = true;
+
+            if (exception) {
+                if (!state.exception)
+                    state.exception = exception;
+
+                state.done = true;
+
+            } else if (ret_code != ReturnCode::SUCCESS && !state.done) {
+                state.retCode = ret_code;
+                state.done = true;
             }
 
-        } else {
-            double min_energy = 0.0;
+            state.condition.notify_all();
+        }
 
-            for (FragmentAssemblerImpl::ConstConformerIterator fa_conf_it = fragAssembler.getConformersBegin(), fa_conf_end = fragAssembler.getConformersEnd();
-                 fa_conf_it != fa_conf_end; ++fa_conf_it) {
+        // log messages are passed on in fragment order by the calling thread
 
-                ConformerData& fa_conf_data = **fa_conf_it;
+        if (main_worker)
+            flushFragmentConfGenLogMessages(state);
+    }
+}
 
-                torDriver.setInputCoordinates(fa_conf_data);
+unsigned int ConfGen::ConformerGeneratorImpl::generateFragmentConformers(FragmentConfGenWorker& worker, FragmentConfGenJob& job,
+                                                                         FragmentConfGenState& state, bool struct_gen_only)
+{
+    FragmentConfData& frag_conf_data = *job.fragConfData;
+    FragmentAssemblerImpl& frag_assembler = worker.fragAssembler;
+    TorsionDriverImpl& tor_driver = job.torDriver;
 
-                ret_code = torDriver.generateConformers();
+    unsigned int ret_code = frag_assembler.assemble(*frag_conf_data.fragment, *molGraph, fixedSubstruct, fixedSubstructCoords);
 
-                if (ret_code != ReturnCode::SUCCESS)
-                    return ret_code;
+    if (ret_code != ReturnCode::SUCCESS) 
+        return ret_code;
 
-                if (struct_gen_only) {
-                    TorsionDriverImpl::ConstConformerIterator min_e_conf = std::min_element(torDriver.getConformersBegin(), torDriver.getConformersEnd(), 
-                                                                                            &compareConformerEnergy);
+    // note: all accesses to shared data (including the deferred return of conformer data objects to the cache)
+    // have to be performed under the lock
 
-                    if (min_e_conf != torDriver.getConformersEnd()) {
-                        ConformerData& conf_data = **min_e_conf;
-                        double energy = conf_data.getEnergy();
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
 
-                        if (frag_conf_data.conformers.empty() || energy < min_energy)
-                            min_energy = energy;
+        invertibleNMask |= frag_assembler.getInvertibleNitrogenMask();
+    }
 
-                        else if (energy > (min_energy + eWindow))
-                            continue;
+    if (logCallback) {
+        if (job.numSplitBonds > 0)
+            job.logMessages.append("Found " + std::to_string(job.numSplitBonds) + " rotatable fragment bond(s), performing torsion driving...\n");
 
-                        ConformerData::SharedPointer final_conf_data = confDataCache.get();
+        job.logMessages.append(job.setupLogMessages);
+    }
 
-                        final_conf_data->swap(conf_data);
-                        frag_conf_data.conformers.push_back(final_conf_data);
-                    }
+    if (job.numSplitBonds == 0) {
+        FragmentTreeNode& frag_node = tor_driver.getFragmentNode(0);
 
-                } else {
-                    for (TorsionDriverImpl::ConstConformerIterator td_conf_it = torDriver.getConformersBegin(), td_conf_end = torDriver.getConformersEnd();
-                         td_conf_it != td_conf_end; ++td_conf_it) {
+        for (FragmentAssemblerImpl::ConstConformerIterator conf_it = frag_assembler.getConformersBegin(), conf_end = frag_assembler.getConformersEnd();
+             conf_it != conf_end; ++conf_it) {
 
-                        ConformerData& td_conf_data = **td_conf_it;
-                        double energy = td_conf_data.getEnergy();
+            ConformerData& conf_data = **conf_it;
+            double energy = frag_node.calcMMFF94Energy(conf_data);
 
-                        if (frag_conf_data.conformers.empty() || energy < min_energy)
-                            min_energy = energy;
+            {
+                std::lock_guard<std::mutex> lock(state.mutex);
 
-                        else if (energy > (min_energy + eWindow))
-                            continue;
+                frag_conf_data.conformers.push_back(confDataCache.get());
+            }
+
+            ConformerData& final_conf_data = *frag_conf_data.conformers.back();
+
+            final_conf_data.swap(conf_data);
+            final_conf_data.setEnergy(energy);
+        }
+
+    } else {
+        double min_energy = 0.0;
+
+        for (FragmentAssemblerImpl::ConstConformerIterator fa_conf_it = frag_assembler.getConformersBegin(), fa_conf_end = frag_assembler.getConformersEnd();
+             fa_conf_it != fa_conf_end; ++fa_conf_it) {
+
+            ConformerData& fa_conf_data = **fa_conf_it;
+
+            tor_driver.setInputCoordinates(fa_conf_data);
+
+            ret_code = tor_driver.generateConformers();
+
+            if (ret_code != ReturnCode::SUCCESS)
+                return ret_code;
+
+            if (struct_gen_only) {
+                TorsionDriverImpl::ConstConformerIterator min_e_conf = std::min_element(tor_driver.getConformersBegin(), tor_driver.getConformersEnd(), 
+                                                                                        &compareConformerEnergy);
+
+                if (min_e_conf != tor_driver.getConformersEnd()) {
+                    ConformerData& conf_data = **min_e_conf;
+                    double energy = conf_data.getEnergy();
 
-                        ConformerData::SharedPointer final_conf_data = confDataCache.get();
+                    if (frag_conf_data.conformers.empty() || energy < min_energy)
+                        min_energy = energy;
 
-                        final_conf_data->swap(td_conf_data);
-                        frag_conf_data.conformers.push_back(final_conf_data);
+                    else if (energy > (min_energy + eWindow))
+                        continue;
+
+                    {
+                        std::lock_guard<std::mutex> lock(state.mutex);
+
+                        frag_conf_data.conformers.push_back(confDataCache.get());
                     }
+
+                    frag_conf_data.conformers.back()->swap(conf_data);
                 }
-            }
 
-            if (frag_conf_data.conformers.size() > 1) {
-                double max_energy = min_energy + eWindow;
+            } else {
+                for (TorsionDriverImpl::ConstConformerIterator td_conf_it = tor_driver.getConformersBegin(), td_conf_end = tor_driver.getConformersEnd();
+                     td_conf_it != td_conf_end; ++td_conf_it) {
+
+                    ConformerData& td_conf_data = **td_conf_it;
+                    double energy = td_conf_data.getEnergy();
+
+                    if (frag_conf_data.conformers.empty() || energy < min_energy)
+                        min_energy = energy;
 
-                for (ConformerDataArray::const_iterator conf_it = frag_conf_data.conformers.begin(), confs_end = frag_conf_data.conformers.end(); conf_it != confs_end; ++conf_it) {
-                    const ConformerData::SharedPointer& conf_data = *conf_it;
+                    else if (energy > (min_energy + eWindow))
+                        continue;
 
-                    if (conf_data->getEnergy() <= max_energy)
-                        tmpWorkingConfs.push_back(conf_data);
+                    {
+                        std::lock_guard<std::mutex> lock(state.mutex);
+
+                        frag_conf_data.conformers.push_back(confDataCache.get());
+                    }
+
+                    frag_conf_data.conformers.back()->swap(td_conf_data);
                 }
-                
-                frag_conf_data.conformers.swap(tmpWorkingConfs);
-                tmpWorkingConfs.clear();
             }
         }
 
-        orderConformersByEnergy(frag_conf_data.conformers); 
+        if (frag_conf_data.conformers.size() > 1) {
+            double max_energy = min_energy + eWindow;
 
-        if (settings.getMaxPoolSize() > 0 && frag_conf_data.conformers.size() > settings.getMaxPoolSize())
-            frag_conf_data.conformers.resize(settings.getMaxPoolSize());
+            for (ConformerDataArray::const_iterator conf_it = frag_conf_data.conformers.begin(), confs_end = frag_conf_data.conformers.end(); conf_it != confs_end; ++conf_it) {
+                const ConformerData::SharedPointer& conf_data = *conf_it;
 
-        frag_conf_data.lastConfIdx = frag_conf_data.conformers.size();
+                if (conf_data->getEnergy() <= max_energy)
+                    worker.tmpConformers.push_back(conf_data);
+            }
+                
+            frag_conf_data.conformers.swap(worker.tmpConformers);
 
-        if (logCallback)
-            logCallback("Generated " + std::to_string(frag_conf_data.lastConfIdx) + " torsion fragment conformer(s)\n");
+            std::lock_guard<std::mutex> lock(state.mutex);
+
+            worker.tmpConformers.clear();
+        }
+    }
+
+    orderConformersByEnergy(frag_conf_data.conformers); 
+
+    if (settings.getMaxPoolSize() > 0 && frag_conf_data.conformers.size() > settings.getMaxPoolSize()) {
+        std::lock_guard<std::mutex> lock(state.mutex);
+
+        frag_conf_data.conformers.resize(settings.getMaxPoolSize());
     }
 
+    frag_conf_data.lastConfIdx = frag_conf_data.conformers.size();
+
+    if (logCallback)
+        job.logMessages.append("Generated " + std::to_string(frag_conf_data.lastConfIdx) + " torsion fragment conformer(s)\n");
+
     return ReturnCode::SUCCESS;
 }
+
+void ConfGen::ConformerGeneratorImpl::waitForFragmentConfGenWorkers(FragmentConfGenState& state)
+{
+    std::unique_lock<std::mutex> lock(state.mutex);
+
+    while (state.numPoolWorkers > 0) {
+        state.condition.wait_for(lock, std::chrono::milliseconds(CALLBACK_POLLING_INTERVAL));
+
+        bool done = state.done;
+
+        lock.unlock();
+
+        // user callbacks must only be invoked from the calling thread - a stop request gets noticed by the
+        // pool threads via workerAborted() and workerTimedout()
+
+        flushFragmentConfGenLogMessages(state);
+
+        bool stop = (!done && (workerAborted() || workerTimedout()));
+
+        lock.lock();
+
+        if (stop && !state.done) {
+            state.retCode = workerStopCode;
+            state.done = true;
+        }
+    }
+}
+
+void ConfGen::ConformerGeneratorImpl::flushFragmentConfGenLogMessages(FragmentConfGenState& state)
+{
+    if (!logCallback)
+        return;
+
+    while (true) {
+        FragmentConfGenJob* job;
+
+        {
+            std::lock_guard<std::mutex> lock(state.mutex);
+
+            if (state.nextLogJobIdx == numFragConfGenJobs || !fragConfGenJobs[state.nextLogJobIdx]->finished)
+                return;
+
+            job = fragConfGenJobs[state.nextLogJobIdx++].get();
+        }
+
+        logCallback(job->logMessages);
+    }
+}
             
 unsigned int ConfGen::ConformerGeneratorImpl::generateFragmentConformerCombinations()
 {
@@ -1591,6 +2092,35 @@ bool ConfGen::ConformerGeneratorImpl::timedout() const
     return (std::chrono::duration_cast<std::chrono::milliseconds>(timer.elapsed()) > std::chrono::milliseconds(timeout));
 }
 
+bool ConfGen::ConformerGeneratorImpl::workerAborted() const
+{
+    // user callbacks must only be invoked from the calling thread - concurrently running tasks just
+    // get notified about a stop request issued by the calling thread
+
+    if (std::this_thread::get_id() != callerThreadID)
+        return (workerStopCode.load() == ReturnCode::ABORTED);
+
+    if (abortCallback && abortCallback()) {
+        workerStopCode = ReturnCode::ABORTED;
+        return true;
+    }
+
+    return false;
+}
+
+bool ConfGen::ConformerGeneratorImpl::workerTimedout() const
+{
+    if (std::this_thread::get_id() != callerThreadID)
+        return (workerStopCode.load() == ReturnCode::TIMEOUT);
+
+    if (timedout()) {
+        workerStopCode = ReturnCode::TIMEOUT;
+        return true;
+    }
+
+    return false;
+}
+
 bool ConfGen::ConformerGeneratorImpl::rmsdConfSelectorAbortCallback() const
 {
     return (invokeCallbacks() != ReturnCode::SUCCESS);
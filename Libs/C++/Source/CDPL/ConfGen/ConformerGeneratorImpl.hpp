@@ -30,8 +30,15 @@
 #define CDPL_CONFGEN_CONFORMERGENERATORIMPL_HPP
 
 #include <vector>
+#include <string>
 #include <cstddef>
 #include <utility>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <atomic>
+#include <thread>
 
 #include "CDPL/ConfGen/ConformerGeneratorSettings.hpp"
 #include "CDPL/ConfGen/ConformerDataArray.hpp"
@@ -43,18 +50,20 @@
 #include "CDPL/Chem/ComponentSet.hpp"
 #include "CDPL/ForceField/MMFF94InteractionParameterizer.hpp"
 #include "CDPL/ForceField/MMFF94InteractionData.hpp"
-#include "CDPL/ForceField/MMFF94GradientCalculator.hpp"
 #include "CDPL/ForceField/ElasticPotentialList.hpp"
 #include "CDPL/Math/BFGSMinimizer.hpp"
 #include "CDPL/Util/ObjectPool.hpp"
 #include "CDPL/Util/ObjectStack.hpp"
 #include "CDPL/Util/BitSet.hpp"
+#include "CDPL/Util/ThreadPool.hpp"
 #include "CDPL/Internal/Timer.hpp"
 
 #include "TorsionDriverImpl.hpp"
 #include "FragmentAssemblerImpl.hpp"
 #include "ForceFieldInteractionMask.hpp"
+#include "MMFF94GradientCalculatorSelector.hpp"
 #include "ExtendedConnectivityCalculator.hpp"
+#include "TaskScheduler.hpp"
 
 
 namespace CDPL
@@ -95,6 +104,10 @@ namespace CDPL
 
             const LogMessageCallbackFunction& getLogMessageCallback() const;
 
+            void setThreadPool(const Util::ThreadPool::SharedPointer& pool);
+
+            const Util::ThreadPool::SharedPointer& getThreadPool() const;
+
             unsigned int generate(const Chem::MolecularGraph& molgraph, bool struct_gen_only,
                                   const Chem::MolecularGraph* fixed_substr,
                                   const Math::Vector3DArray* fixed_substr_coords);
@@ -112,6 +125,11 @@ namespace CDPL
           private:
             struct FragmentConfData;
             struct ConfCombinationData;
+            struct SamplingWorker;
+            struct SamplingState;
+            struct FragmentConfGenJob;
+            struct FragmentConfGenWorker;
+            struct FragmentConfGenState;
 
             typedef Util::ObjectPool<FragmentConfData>         FragmentConfDataCache;
             typedef FragmentConfDataCache::SharedObjectPointer FragmentConfDataPtr;
@@ -132,6 +150,18 @@ namespace CDPL
 
             unsigned int generateConformersStochastic(bool struct_gen_only);
 
+            void setupSamplingWorker(SamplingWorker& worker, std::size_t num_atoms);
+
+            void initSamplingWorkers(std::size_t num_workers, std::size_t num_atoms);
+
+            void runSamplingWorker(SamplingWorker& worker, SamplingState& state);
+
+            void sampleConformers(SamplingWorker& worker, SamplingState& state);
+
+            bool processSamplingResult(SamplingState& state, ConformerData::SharedPointer& conf_data_ptr, bool success);
+
+            bool generateStructure(SamplingWorker& worker, ConformerData& conf_data);
+
             void removeWorkingConfDuplicates();
 
             bool determineSamplingMode();
@@ -140,10 +170,10 @@ namespace CDPL
 
             unsigned int perceiveRotBonds();
             
-            bool generateHydrogenCoordsAndMinimize(ConformerData& conf_data);
+            bool generateHydrogenCoordsAndMinimize(SamplingWorker& worker, ConformerData& conf_data);
 
-            double calcEnergy(const Math::Vector3DArray::StorageType& coords);
-            double calcGradient(const Math::Vector3DArray::StorageType& coords,
+            double calcEnergy(SamplingWorker& worker, const Math::Vector3DArray::StorageType& coords);
+            double calcGradient(SamplingWorker& worker, const Math::Vector3DArray::StorageType& coords,
                                 Math::Vector3DArray::StorageType& grad);
             
             ConformerData::SharedPointer getInputCoordinatesForFixedSubstruct(const Chem::MolecularGraph& molgraph);
@@ -153,8 +183,23 @@ namespace CDPL
 
             bool setupMMFF94Parameters(unsigned int ff_type);
 
+            void setupTaskScheduler();
+
             unsigned int generateFragmentConformers(bool struct_gen_only);
 
+            void prepareFragmentConfGenJobs();
+
+            void setupFragmentConfGenWorker(FragmentConfGenWorker& worker);
+
+            void runFragmentConfGenWorker(FragmentConfGenWorker& worker, FragmentConfGenState& state, bool struct_gen_only);
+
+            unsigned int generateFragmentConformers(FragmentConfGenWorker& worker, FragmentConfGenJob& job,
+                                                    FragmentConfGenState& state, bool struct_gen_only);
+
+            void waitForFragmentConfGenWorkers(FragmentConfGenState& state);
+
+            void flushFragmentConfGenLogMessages(FragmentConfGenState& state);
+
             unsigned int generateFragmentConformerCombinations();
 
             void generateFragmentConformerCombinations(std::size_t frag_idx, double comb_energy);
@@ -175,6 +220,9 @@ namespace CDPL
             unsigned int invokeCallbacks() const;
             bool         timedout() const;
 
+            bool workerAborted() const;
+            bool workerTimedout() const;
+
             bool rmsdConfSelectorAbortCallback() const;
 
             typedef std::vector<std::size_t> UIntArray;
@@ -202,16 +250,112 @@ namespace CDPL
                 double    energy;
             };
 
+            typedef MMFF94GradientCalculatorSelector                              MMFF94GradientCalculator;
+            typedef Math::BFGSMinimizer<Math::Vector3DArray::StorageType, double> BFGSMinimizer;
+
+            struct SamplingWorker
+            {
+
+                SamplingWorker(ConformerGeneratorImpl& parent);
+
+                DGStructureGenerator*                 dgStructureGen;
+                DGStructureGenerator                  localDGStructureGen;
+                Chem::Hydrogen3DCoordinatesCalculator hCoordsCalc;
+                MMFF94GradientCalculator              mmff94GradientCalc;
+                BFGSMinimizer                         energyMinimizer;
+                Math::Vector3DArray::StorageType      energyGradient;
+                ConformerData::SharedPointer          confData;
+
+              private:
+                SamplingWorker(const SamplingWorker&);
+
+                SamplingWorker& operator=(const SamplingWorker&);
+            };
+
+            struct SamplingState
+            {
+
+                std::mutex              mutex;
+                std::condition_variable poolWorkerCondition;
+                std::size_t             numPoolWorkers;
+                std::exception_ptr      exception;
+                unsigned int            retCode;
+                bool                    done;
+                double                  minEnergy;
+                std::size_t             numSamples;
+                std::size_t             numStructGenFails;
+                std::size_t             numNewUniqueConfs;
+                std::size_t             lastUniqueConfCount;
+                std::string             logMessages;
+            };
+
+            struct FragmentConfGenJob
+            {
+
+                FragmentConfGenJob(ConformerGeneratorImpl& parent);
+
+                void appendSetupLogMessage(const std::string& msg);
+
+                FragmentConfData*  fragConfData;
+                TorsionDriverImpl  torDriver;
+                Chem::FragmentList fragments;
+                std::size_t        numSplitBonds;
+                std::string        setupLogMessages;
+                std::string        logMessages;
+                bool               finished;
+
+              private:
+                FragmentConfGenJob(const FragmentConfGenJob&);
+
+                FragmentConfGenJob& operator=(const FragmentConfGenJob&);
+            };
+
+            struct FragmentConfGenWorker
+            {
+
+                FragmentConfGenWorker(ConformerGeneratorImpl& parent);
+
+                void appendLogMessage(const std::string& msg);
+
+                FragmentAssemblerImpl fragAssembler;
+                ConformerDataArray    tmpConformers;
+                FragmentConfGenJob*   job;
+
+              private:
+                FragmentConfGenWorker(const FragmentConfGenWorker&);
+
+                FragmentConfGenWorker& operator=(const FragmentConfGenWorker&);
+            };
+
+            struct FragmentConfGenState
+            {
+
+                std::mutex              mutex;
+                std::condition_variable condition;
+                std::size_t             numPoolWorkers;
+                std::size_t             nextJobIdx;
+                std::size_t             nextLogJobIdx;
+                std::exception_ptr      exception;
+                unsigned int            retCode;
+                bool                    done;
+            };
+
+            typedef std::unique_ptr<SamplingWorker>                               SamplingWorkerPtr;
+            typedef std::vector<SamplingWorkerPtr>                                SamplingWorkerList;
             typedef Util::ObjectStack<ConfCombinationData>                        ConfCombinationDataCache;
             typedef Util::ObjectPool<ConformerData>                               ConformerDataCache;
             typedef std::vector<FragmentConfDataPtr>                              FragmentConfDataList;
             typedef ForceField::MMFF94InteractionData                             MMFF94InteractionData;
             typedef ForceField::MMFF94InteractionParameterizer                    MMFF94Parameterizer;
-            typedef ForceField::MMFF94GradientCalculator<double>                  MMFF94GradientCalculator;
             typedef ForceField::ElasticPotentialList                              ElasticPotentialList;
             typedef std::vector<const Chem::Bond*>                                BondList;
             typedef std::vector<ConfCombinationData*>                             ConfCombinationDataList;
-            typedef Math::BFGSMinimizer<Math::Vector3DArray::StorageType, double> BFGSMinimizer;
+            typedef std::unique_ptr<FragmentConfGenJob>                           FragmentConfGenJobPtr;
+            typedef std::vector<FragmentConfGenJobPtr>                            FragmentConfGenJobList;
+            typedef std::unique_ptr<FragmentConfGenWorker>                        FragmentConfGenWorkerPtr;
+            typedef std::vector<FragmentConfGenWorkerPtr>                         FragmentConfGenWorkerList;
+            typedef std::vector<FragmentLibrary::SharedPointer>                   FragmentLibraryList;
+            typedef std::vector<TorsionLibrary::SharedPointer>                    TorsionLibraryList;
 
             ConformerDataCache                    confDataCache;
             FragmentConfDataCache                 fragConfDataCache;
@@ -227,19 +371,25 @@ namespace CDPL
             CallbackFunction                      abortCallback;
             CallbackFunction                      timeoutCallback;
             LogMessageCallbackFunction            logCallback;
+            Util::ThreadPool::SharedPointer       threadPool;
+            Util::ThreadPool::SharedPointer       localThreadPool;
             Internal::Timer                       timer;
             RMSDConformerSelector                 confSelector;
             TorsionDriverImpl                     torDriver;
-            FragmentAssemblerImpl                 fragAssembler;
+            FragmentLibraryList                   fragLibs;
+            TorsionLibraryList                    torLibs;
             DGStructureGenerator                  dgStructureGen;
             ExtendedConnectivityCalculator        atomECCalc;
             MMFF94Parameterizer                   mmff94Parameterizer;
             MMFF94InteractionData                 mmff94Data;
             ForceFieldInteractionMask             mmff94InteractionMask;
-            MMFF94GradientCalculator              mmff94GradientCalc;
             ElasticPotentialList                  elasticPotentials;
-            BFGSMinimizer                         energyMinimizer;
-            Chem::Hydrogen3DCoordinatesCalculator hCoordsCalc;
+            SamplingWorker                        mainSamplingWorker;
+            SamplingWorkerList                    samplingWorkers;
+            FragmentConfGenWorker                 mainFragConfGenWorker;
+            FragmentConfGenWorkerList             fragConfGenWorkers;
+            FragmentConfGenJobList                fragConfGenJobs;
+            std::size_t                           numFragConfGenJobs;
             BondList                              torDriveBonds;
             BondList                              fragSplitBonds;
             Chem::FragmentList                    fragments;
@@ -256,8 +406,10 @@ namespace CDPL
             UIntArray                             currConfComb;
             UIntArray                             parentAtomInds;
             UIntArray                             outConfCandInds;
-            Math::Vector3DArray::StorageType      energyGradient;
             bool                                  inStochasticMode;
+            std::thread::id                       callerThreadID;
+            mutable std::atomic<unsigned int>     workerStopCode;
+            TaskScheduler                         taskScheduler;
         };
     } // namespace ConfGen
 } // namespace CDPL
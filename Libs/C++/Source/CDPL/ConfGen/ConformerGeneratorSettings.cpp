@@ -38,11 +38,11 @@ ConfGen::ConformerGeneratorSettings::ConformerGeneratorSettings():
     samplingMode(ConformerSamplingMode::AUTO), sampleHetAtomHs(false), sampleTolRanges(true), 
     enumRings(true), nitrogenEnumMode(NitrogenEnumerationMode::UNSPECIFIED_STEREO),
     fromScratch(true), incInputCoords(false), eWindow(10.0), maxPoolSize(10000), maxRotorBondCount(-1), timeout(60 * 60 * 1000), 
-    forceFieldTypeSys(ForceFieldType::MMFF94S_RTOR_NO_ESTAT), forceFieldTypeStoch(ForceFieldType::MMFF94S_RTOR), strictParam(true), 
+    forceFieldTypeSys(ForceFieldType::MMFF94S_RTOR_NO_ESTAT), forceFieldTypeStoch(ForceFieldType::MMFF94S_RTOR), strictParam(true), packedFFEval(false), 
     dielectricConst(ForceField::MMFF94ElectrostaticInteractionParameterizer::DIELECTRIC_CONSTANT_WATER),
     distExponent(ForceField::MMFF94ElectrostaticInteractionParameterizer::DEF_DISTANCE_EXPONENT),
     maxNumOutputConfs(100), minRMSD(0.5), maxNumRefIters(0), refTolerance(0.001), maxNumSampledConfs(2000),
-    convCheckCycleSize(100), mcRotorBondCountThresh(10)
+    convCheckCycleSize(100), mcRotorBondCountThresh(10), numThreads(0)
 {}
 
 void ConfGen::ConformerGeneratorSettings::setSamplingMode(unsigned int mode)
@@ -202,6 +202,16 @@ bool ConfGen::ConformerGeneratorSettings::strictForceFieldParameterization() con
 {
     return strictParam;
 }
+
+void ConfGen::ConformerGeneratorSettings::packedForceFieldEvaluation(bool packed)
+{
+    packedFFEval = packed;
+}
+
+bool ConfGen::ConformerGeneratorSettings::packedForceFieldEvaluation() const
+{
+    return packedFFEval;
+}
             
 void ConfGen::ConformerGeneratorSettings::setDielectricConstant(double de_const)
 {
@@ -329,6 +339,16 @@ std::size_t ConfGen::ConformerGeneratorSettings::getMacrocycleRotorBondCountThre
     return mcRotorBondCountThresh;
 }
 
+void ConfGen::ConformerGeneratorSettings::setNumThreads(std::size_t num_threads)
+{
+    numThreads = num_threads;
+}
+
+std::size_t ConfGen::ConformerGeneratorSettings::getNumThreads() const
+{
+    return numThreads;
+}
+
 ConfGen::FragmentConformerGeneratorSettings& ConfGen::ConformerGeneratorSettings::getFragmentBuildSettings()
 {
     return fragBuildSettings;
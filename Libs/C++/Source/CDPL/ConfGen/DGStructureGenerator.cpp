@@ -38,7 +38,7 @@ using namespace CDPL;
 
 
 ConfGen::DGStructureGenerator::DGStructureGenerator(): 
-    molGraph(0), settings(DGStructureGeneratorSettings::DEFAULT)
+    molGraph(0), randomSeed(170375), settings(DGStructureGeneratorSettings::DEFAULT)
 {
     phase1CoordsGen.setNumCycles(70);
     phase1CoordsGen.setCycleStepCountFactor(1.3);
@@ -56,6 +56,20 @@ const ConfGen::DGStructureGeneratorSettings& ConfGen::DGStructureGenerator::getS
     return settings;
 }
 
+void ConfGen::DGStructureGenerator::setRandomSeed(unsigned int seed)
+{
+    randomSeed = seed;
+
+    phase1CoordsGen.setRandomSeed(seed);
+    phase2CoordsGen.setRandomSeed(seed);
+    randomEngine.seed(seed);
+}
+
+unsigned int ConfGen::DGStructureGenerator::getRandomSeed() const
+{
+    return randomSeed;
+}
+
 const Util::BitSet& ConfGen::DGStructureGenerator::getExcludedHydrogenMask() const
 {
     return dgConstraintsGen.getExcludedHydrogenMask();
@@ -173,7 +187,7 @@ void ConfGen::DGStructureGenerator::setup(const Chem::MolecularGraph& molgraph,
 
     phase1CoordsGen.clearDistanceConstraints();
     phase1CoordsGen.clearVolumeConstraints();
-    phase1CoordsGen.setRandomSeed(170375);
+    phase1CoordsGen.setRandomSeed(randomSeed);
 
     if (fixed_substr_frags) {
         fixedSubstructFragCtrs.clear();
@@ -219,7 +233,7 @@ void ConfGen::DGStructureGenerator::setup(const Chem::MolecularGraph& molgraph,
         phase2CoordsGen.clearDistanceConstraints();
     }
 
-    randomEngine.seed(170375);
+    randomEngine.seed(randomSeed);
 }
 
 bool ConfGen::DGStructureGenerator::checkAtomConfigurations(Math::Vector3DArray& coords) const
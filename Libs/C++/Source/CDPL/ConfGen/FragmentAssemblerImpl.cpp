@@ -26,7 +26,6 @@
 
 #include <algorithm>
 #include <cmath>
-#include <mutex>
 #include <functional>
 
 #include "CDPL/ConfGen/BondFunctions.hpp"
@@ -52,7 +51,7 @@
 #include "FragmentTreeNode.hpp"
 #include "TorsionLibraryDataReader.hpp"
 #include "FallbackTorsionLibrary.hpp"
-#include "FragmentConformerCache.hpp"
+#include "FragmentConformerCacheImpl.hpp"
 #include "UtilityFunctions.hpp"
 
 
@@ -531,13 +530,14 @@ bool ConfGen::FragmentAssemblerImpl::fetchConformersFromFragmentLibrary(unsigned
 bool ConfGen::FragmentAssemblerImpl::fetchConformersFromFragmentCache(unsigned int frag_type, const Chem::Fragment& frag, 
                                                                       FragmentTreeNode* node)
 {
-    std::lock_guard<std::mutex> cache_lock(FragmentConformerCache::getMutex());
-    const ConformerDataArray* cache_confs = FragmentConformerCache::getEntry(canonFrag.getHashCode());
-
-    if (!cache_confs)
+    if (!FragmentConformerCacheImpl::getInstance().getEntry(canonFrag.getHashCode(), cacheConformers))
         return false;
 
-    if (!setNodeConformers(frag_type, frag, node, *cache_confs))
+    bool success = setNodeConformers(frag_type, frag, node, cacheConformers);
+
+    cacheConformers.clear();
+
+    if (!success)
         return false;
 
     if (logCallback)
@@ -662,12 +662,8 @@ unsigned int ConfGen::FragmentAssemblerImpl::generateFragmentConformers(unsigned
             enumChainFragmentNitrogens(frag, node);
         
     } else {
-        {
-            std::lock_guard<std::mutex> cache_lock(FragmentConformerCache::getMutex());
+        FragmentConformerCacheImpl::getInstance().addEntry(canonFrag.getHashCode(), fragConfGen.getConformersBegin(), fragConfGen.getConformersEnd());
 
-            FragmentConformerCache::addEntry(canonFrag.getHashCode(), fragConfGen.getConformersBegin(), fragConfGen.getConformersEnd());
-        }
-        
         fixBondLengths(frag, node);
 
         if (frag_type == FragmentType::CHAIN)
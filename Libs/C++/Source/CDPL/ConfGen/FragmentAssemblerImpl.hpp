@@ -195,6 +195,7 @@ namespace CDPL
             FragmentConformerGeneratorImpl fragConfGen;
             CanonicalFragment              canonFrag;
             IndexPairList                  canonFragAtomIdxMap;
+            ConformerDataArray             cacheConformers;
             Chem::Fragment                 fixedCanonFragSubstruct;
             Math::Vector3DArray            fixedCanonFragSubstructCoords;
             BondLengthTablePtr             bondLengthTable;
@@ -24,134 +24,66 @@
 
 #include "StaticInit.hpp"
 
-#include "FragmentConformerCache.hpp"
+#include "CDPL/ConfGen/FragmentConformerCache.hpp"
 
+#include "FragmentConformerCacheImpl.hpp"
 
-using namespace CDPL;
-
-
-namespace
-{
-
-    constexpr std::size_t MAX_CACHE_SIZE = 10000;
-}
-
-
-ConfGen::FragmentConformerCache* ConfGen::FragmentConformerCache::instance = 0;
 
-std::once_flag ConfGen::FragmentConformerCache::onceFlag;
+using namespace CDPL;
 
 
-ConfGen::FragmentConformerCache::FragmentConformerCache():
-    lruListHead(0), numEntries(0)
-{}
+constexpr std::size_t ConfGen::FragmentConformerCache::DEF_MEMORY_BUDGET;
 
-ConfGen::FragmentConformerCache::~FragmentConformerCache() 
-{}
 
-const ConfGen::ConformerDataArray* ConfGen::FragmentConformerCache::getEntry(std::uint64_t frag_hash)
+void ConfGen::FragmentConformerCache::setMemoryBudget(std::size_t num_bytes)
 {
-    FragmentConformerCache& inst = getInstance();
-    HashToCacheEntryMap::const_iterator it = inst.hashToEntryMap.find(frag_hash);
-
-    if (it == inst.hashToEntryMap.end())
-        return 0;
-
-    Entry* entry = it->second;
-
-    // unlink entry
-    entry->previous->next = entry->next;
-    entry->next->previous = entry->previous;
-
-    // insert entry before current head of the LRU list  
-    entry->next = inst.lruListHead;
-    entry->previous = inst.lruListHead->previous;
-    entry->previous->next = entry;
-    inst.lruListHead->previous = entry;
-    
-    // make entry new head of the LRU list  
-    inst.lruListHead = entry;
-
-    return &entry->conformers;
+    FragmentConformerCacheImpl::getInstance().setMemoryBudget(num_bytes);
 }
 
-void ConfGen::FragmentConformerCache::addEntry(std::uint64_t frag_hash, 
-                                               const ConformerDataArray::const_iterator& confs_beg, 
-                                               const ConformerDataArray::const_iterator& confs_end)
+std::size_t ConfGen::FragmentConformerCache::getMemoryBudget()
 {
-    FragmentConformerCache& inst = getInstance();
-    HashToCacheEntryMap::const_iterator it = inst.hashToEntryMap.find(frag_hash);
-
-    if (it != inst.hashToEntryMap.end())
-        return;
-
-    std::ptrdiff_t num_new_confs = confs_end - confs_beg;
-
-    if (num_new_confs <= 0) // sanity check
-        return;
-
-    if (!inst.lruListHead) { // create first entry
-        Entry* new_entry = new Entry();
-
-        new_entry->next = new_entry;
-        new_entry->previous = new_entry;
-
-        inst.lruListHead = new_entry;
-        inst.numEntries = 1;
-
-    } else if (inst.numEntries < MAX_CACHE_SIZE) { // add new entry
-        Entry* new_entry = new Entry();
-
-        new_entry->next = inst.lruListHead;
-        new_entry->previous = inst.lruListHead->previous;
-        new_entry->previous->next = new_entry;
-        inst.lruListHead->previous = new_entry;
-
-        inst.numEntries++;
+    return FragmentConformerCacheImpl::getInstance().getMemoryBudget();
+}
 
-    } else // reuse old entry at LRU list tail
-        inst.hashToEntryMap.erase(inst.lruListHead->previous->fragHash);
-    
-    Entry* entry = inst.lruListHead->previous;
+std::size_t ConfGen::FragmentConformerCache::getNumShards()
+{
+    return FragmentConformerCacheImpl::NUM_SHARDS;
+}
 
-    entry->fragHash = frag_hash;
-    entry->conformers.reserve(num_new_confs);
+ConfGen::FragmentConformerCache::Statistics ConfGen::FragmentConformerCache::getStatistics(std::size_t idx)
+{
+    return FragmentConformerCacheImpl::getInstance().getStatistics(idx);
+}
 
-    while (entry->conformers.size() > std::size_t(num_new_confs)) {
-        inst.confDataCache.push_back(entry->conformers.back());
-        entry->conformers.pop_back();
-    }
+ConfGen::FragmentConformerCache::Statistics ConfGen::FragmentConformerCache::getStatistics()
+{
+    FragmentConformerCacheImpl& cache = FragmentConformerCacheImpl::getInstance();
+    Statistics stats = Statistics();
 
-    while (entry->conformers.size() < std::size_t(num_new_confs)) {
-        if (inst.confDataCache.empty()) 
-            entry->conformers.push_back(ConformerData::SharedPointer(new ConformerData()));
+    for (std::size_t i = 0; i < FragmentConformerCacheImpl::NUM_SHARDS; i++) {
+        Statistics shard_stats = cache.getStatistics(i);
 
-        else {
-            entry->conformers.push_back(inst.confDataCache.back());
-            inst.confDataCache.pop_back();
-        }
+        stats.numEntries += shard_stats.numEntries;
+        stats.memoryUsage += shard_stats.memoryUsage;
+        stats.numHits += shard_stats.numHits;
+        stats.numMisses += shard_stats.numMisses;
+        stats.numEvictions += shard_stats.numEvictions;
     }
 
-    for (ConformerDataArray::const_iterator src_it = confs_beg, tgt_it = entry->conformers.begin(); src_it != confs_end; ++src_it, ++tgt_it)
-        (*src_it)->swap(**tgt_it);
-
-    inst.hashToEntryMap.insert(HashToCacheEntryMap::value_type(frag_hash, entry));
-    inst.lruListHead = entry;
+    return stats;
 }
 
-std::mutex& ConfGen::FragmentConformerCache::getMutex()
+void ConfGen::FragmentConformerCache::clear()
 {
-    return getInstance().mutex;
+    FragmentConformerCacheImpl::getInstance().clear();
 }
 
-void ConfGen::FragmentConformerCache::createInstance() 
+std::size_t ConfGen::FragmentConformerCache::load(std::istream& is)
 {
-    instance = new FragmentConformerCache();
+    return FragmentConformerCacheImpl::getInstance().load(is);
 }
 
-ConfGen::FragmentConformerCache& ConfGen::FragmentConformerCache::getInstance() 
+std::size_t ConfGen::FragmentConformerCache::save(std::ostream& os)
 {
-    std::call_once(onceFlag, &createInstance);
-
-    return *instance;
+    return FragmentConformerCacheImpl::getInstance().save(os);
 }
@@ -0,0 +1,293 @@
+/* 
+ * FragmentConformerCacheImpl.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include <istream>
+#include <ostream>
+#include <vector>
+#include <exception>
+
+#include "CDPL/ConfGen/FragmentLibraryEntry.hpp"
+#include "CDPL/Math/Vector.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+#include "FragmentConformerCacheImpl.hpp"
+#include "CFLFragmentLibraryEntryReader.hpp"
+#include "CFLFragmentLibraryEntryWriter.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+    // rough estimates of the bookkeeping overhead of a cache entry and of its individual conformers
+    constexpr std::size_t ENTRY_MEMORY_OVERHEAD = 128;
+    constexpr std::size_t CONF_MEMORY_OVERHEAD  = sizeof(ConfGen::ConformerData) + sizeof(ConfGen::ConformerData::SharedPointer) + 32;
+
+    std::size_t calcMemoryUsage(const ConfGen::ConformerDataArray& confs)
+    {
+        std::size_t mem_usage = ENTRY_MEMORY_OVERHEAD;
+
+        for (const auto& conf : confs)
+            mem_usage += CONF_MEMORY_OVERHEAD + conf->getSize() * sizeof(Math::Vector3D);
+
+        return mem_usage;
+    }
+}
+
+
+constexpr std::size_t ConfGen::FragmentConformerCacheImpl::NUM_SHARDS;
+
+ConfGen::FragmentConformerCacheImpl* ConfGen::FragmentConformerCacheImpl::instance = 0;
+
+std::once_flag ConfGen::FragmentConformerCacheImpl::onceFlag;
+
+
+ConfGen::FragmentConformerCacheImpl::Shard::Shard():
+    statistics()
+{}
+
+ConfGen::FragmentConformerCacheImpl::FragmentConformerCacheImpl():
+    memoryBudget(FragmentConformerCache::DEF_MEMORY_BUDGET)
+{}
+
+bool ConfGen::FragmentConformerCacheImpl::getEntry(std::uint64_t frag_hash, ConformerDataArray& confs)
+{
+    Shard& shard = getShard(frag_hash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    HashToEntryMap::iterator it = shard.hashToEntryMap.find(frag_hash);
+
+    if (it == shard.hashToEntryMap.end()) {
+        shard.statistics.numMisses++;
+        return false;
+    }
+
+    // make entry new head of the LRU list
+    shard.lruList.splice(shard.lruList.begin(), shard.lruList, it->second);
+    shard.statistics.numHits++;
+
+    confs.assign(it->second->conformers.begin(), it->second->conformers.end());
+
+    return true;
+}
+
+void ConfGen::FragmentConformerCacheImpl::addEntry(std::uint64_t frag_hash,
+                                                   const ConformerDataArray::const_iterator& confs_beg,
+                                                   const ConformerDataArray::const_iterator& confs_end)
+{
+    std::ptrdiff_t num_new_confs = confs_end - confs_beg;
+
+    if (num_new_confs <= 0) // sanity check
+        return;
+
+    Shard& shard = getShard(frag_hash);
+
+    {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        if (shard.hashToEntryMap.find(frag_hash) != shard.hashToEntryMap.end())
+            return;
+    }
+
+    // copy conformer data outside of the shard lock
+    Entry entry;
+
+    entry.fragHash = frag_hash;
+    entry.conformers.reserve(num_new_confs);
+
+    for (ConformerDataArray::const_iterator it = confs_beg; it != confs_end; ++it)
+        entry.conformers.push_back(ConformerData::SharedPointer(new ConformerData(**it)));
+
+    addEntry(entry);
+}
+
+void ConfGen::FragmentConformerCacheImpl::setMemoryBudget(std::size_t num_bytes)
+{
+    memoryBudget = num_bytes;
+
+    for (std::size_t i = 0; i < NUM_SHARDS; i++) {
+        std::lock_guard<std::mutex> lock(shards[i].mutex);
+
+        evictEntries(shards[i], num_bytes / NUM_SHARDS);
+    }
+}
+
+std::size_t ConfGen::FragmentConformerCacheImpl::getMemoryBudget() const
+{
+    return memoryBudget;
+}
+
+ConfGen::FragmentConformerCacheImpl::Statistics ConfGen::FragmentConformerCacheImpl::getStatistics(std::size_t shard_idx)
+{
+    if (shard_idx >= NUM_SHARDS)
+        throw Base::IndexError("FragmentConformerCache: shard index out of bounds");
+
+    Shard& shard = shards[shard_idx];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    Statistics stats = shard.statistics;
+
+    stats.numEntries = shard.hashToEntryMap.size();
+
+    return stats;
+}
+
+void ConfGen::FragmentConformerCacheImpl::clear()
+{
+    for (std::size_t i = 0; i < NUM_SHARDS; i++) {
+        Shard& shard = shards[i];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+
+        shard.hashToEntryMap.clear();
+        shard.lruList.clear();
+        shard.statistics = Statistics();
+    }
+}
+
+std::size_t ConfGen::FragmentConformerCacheImpl::load(std::istream& is)
+{
+    CFLFragmentLibraryEntryReader reader;
+    FragmentLibraryEntry          lib_entry;
+    Entry                         entry;
+    std::size_t                   num_added = 0;
+
+    try {
+        while (reader.read(is, lib_entry)) {
+            if (lib_entry.getNumConformers() == 0)
+                continue;
+
+            // the reader allocates new conformer data objects for each entry which thus can be shared
+            entry.fragHash = lib_entry.getHashCode();
+            entry.conformers.assign(lib_entry.getData().begin(), lib_entry.getData().end());
+
+            if (addEntry(entry))
+                num_added++;
+        }
+
+    } catch (const Base::IOError&) {
+        throw;
+
+    } catch (const std::exception& e) {
+        throw Base::IOError(std::string("FragmentConformerCache: error while loading cache entries: ") + e.what());
+    }
+
+    return num_added;
+}
+
+std::size_t ConfGen::FragmentConformerCacheImpl::save(std::ostream& os)
+{
+    CFLFragmentLibraryEntryWriter writer;
+    FragmentLibraryEntry          lib_entry;
+    std::vector<Entry>            entries;
+    std::size_t                   num_saved = 0;
+
+    try {
+        for (std::size_t i = 0; i < NUM_SHARDS; i++) {
+            Shard& shard = shards[i];
+
+            {
+                std::lock_guard<std::mutex> lock(shard.mutex);
+
+                // least recently used entries first so that a subsequent load() restores the LRU order
+                entries.assign(shard.lruList.rbegin(), shard.lruList.rend());
+            }
+
+            for (const Entry& entry : entries) {
+                lib_entry.setHashCode(entry.fragHash);
+                lib_entry.clearConformers();
+
+                for (const auto& conf : entry.conformers)
+                    lib_entry.addConformer(conf);
+
+                if (!writer.write(os, lib_entry))
+                    throw Base::IOError("FragmentConformerCache: error while saving cache entries");
+
+                num_saved++;
+            }
+        }
+
+    } catch (const Base::IOError&) {
+        throw;
+
+    } catch (const std::exception& e) {
+        throw Base::IOError(std::string("FragmentConformerCache: error while saving cache entries: ") + e.what());
+    }
+
+    return num_saved;
+}
+
+ConfGen::FragmentConformerCacheImpl::Shard& ConfGen::FragmentConformerCacheImpl::getShard(std::uint64_t frag_hash)
+{
+    return shards[frag_hash % NUM_SHARDS];
+}
+
+bool ConfGen::FragmentConformerCacheImpl::addEntry(Entry& entry)
+{
+    std::size_t max_mem_usage = memoryBudget / NUM_SHARDS;
+
+    entry.memoryUsage = calcMemoryUsage(entry.conformers);
+
+    if (entry.memoryUsage > max_mem_usage)
+        return false;
+
+    Shard& shard = getShard(entry.fragHash);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    if (shard.hashToEntryMap.find(entry.fragHash) != shard.hashToEntryMap.end())
+        return false;
+
+    evictEntries(shard, max_mem_usage - entry.memoryUsage);
+
+    shard.statistics.memoryUsage += entry.memoryUsage;
+    shard.lruList.push_front(std::move(entry));
+    shard.hashToEntryMap.insert(HashToEntryMap::value_type(shard.lruList.front().fragHash, shard.lruList.begin()));
+
+    return true;
+}
+
+void ConfGen::FragmentConformerCacheImpl::evictEntries(Shard& shard, std::size_t max_mem_usage)
+{
+    while (!shard.lruList.empty() && shard.statistics.memoryUsage > max_mem_usage) {
+        const Entry& entry = shard.lruList.back();
+
+        shard.statistics.memoryUsage -= entry.memoryUsage;
+        shard.statistics.numEvictions++;
+        shard.hashToEntryMap.erase(entry.fragHash);
+        shard.lruList.pop_back();
+    }
+}
+
+void ConfGen::FragmentConformerCacheImpl::createInstance()
+{
+    instance = new FragmentConformerCacheImpl();
+}
+
+ConfGen::FragmentConformerCacheImpl& ConfGen::FragmentConformerCacheImpl::getInstance()
+{
+    std::call_once(onceFlag, &createInstance);
+
+    return *instance;
+}
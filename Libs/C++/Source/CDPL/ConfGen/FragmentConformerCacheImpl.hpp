@@ -0,0 +1,122 @@
+/* 
+ * FragmentConformerCacheImpl.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of the class CDPL::ConfGen::FragmentConformerCacheImpl.
+ */
+
+#ifndef CDPL_CONFGEN_FRAGMENTCONFORMERCACHEIMPL_HPP
+#define CDPL_CONFGEN_FRAGMENTCONFORMERCACHEIMPL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <list>
+#include <unordered_map>
+#include <mutex>
+#include <atomic>
+
+#include "CDPL/ConfGen/FragmentConformerCache.hpp"
+#include "CDPL/ConfGen/ConformerDataArray.hpp"
+
+
+namespace CDPL
+{
+
+    namespace ConfGen
+    {
+
+        class FragmentConformerCacheImpl
+        {
+
+          public:
+            typedef FragmentConformerCache::Statistics Statistics;
+
+            static constexpr std::size_t NUM_SHARDS = 32;
+
+            static FragmentConformerCacheImpl& getInstance();
+
+            bool getEntry(std::uint64_t frag_hash, ConformerDataArray& confs);
+
+            void addEntry(std::uint64_t                             frag_hash,
+                          const ConformerDataArray::const_iterator& confs_beg,
+                          const ConformerDataArray::const_iterator& confs_end);
+
+            void setMemoryBudget(std::size_t num_bytes);
+
+            std::size_t getMemoryBudget() const;
+
+            Statistics getStatistics(std::size_t shard_idx);
+
+            void clear();
+
+            std::size_t load(std::istream& is);
+
+            std::size_t save(std::ostream& os);
+
+          private:
+            struct Entry
+            {
+
+                std::uint64_t      fragHash;
+                ConformerDataArray conformers;
+                std::size_t        memoryUsage;
+            };
+
+            typedef std::list<Entry>                                       EntryList;
+            typedef std::unordered_map<std::uint64_t, EntryList::iterator> HashToEntryMap;
+
+            struct Shard
+            {
+
+                Shard();
+
+                std::mutex     mutex;
+                EntryList      lruList;
+                HashToEntryMap hashToEntryMap;
+                Statistics     statistics;
+            };
+
+            FragmentConformerCacheImpl();
+            FragmentConformerCacheImpl(const FragmentConformerCacheImpl& cache);
+
+            FragmentConformerCacheImpl& operator=(const FragmentConformerCacheImpl& cache);
+
+            static void createInstance();
+
+            Shard& getShard(std::uint64_t frag_hash);
+
+            bool addEntry(Entry& entry);
+
+            void evictEntries(Shard& shard, std::size_t max_mem_usage);
+
+            static FragmentConformerCacheImpl* instance;
+            static std::once_flag              onceFlag;
+            Shard                              shards[NUM_SHARDS];
+            std::atomic<std::size_t>           memoryBudget;
+        };
+    } // namespace ConfGen
+} // namespace CDPL
+
+#endif // CDPL_CONFGEN_FRAGMENTCONFORMERCACHEIMPL_HPP
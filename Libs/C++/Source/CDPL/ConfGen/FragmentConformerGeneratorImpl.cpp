@@ -405,7 +405,7 @@ bool ConfGen::FragmentConformerGeneratorImpl::setupForceField()
         return false;
     }
 
-    mmff94GradientCalc.setup(mmff94Data, numAtoms);
+    mmff94GradientCalc.setup(mmff94Data, numAtoms, settings.packedForceFieldEvaluation());
     energyGradient.resize(numAtoms);
 
     return true;
@@ -39,7 +39,6 @@
 #include "CDPL/ConfGen/LogMessageCallbackFunction.hpp"
 #include "CDPL/ForceField/MMFF94InteractionParameterizer.hpp"
 #include "CDPL/ForceField/MMFF94InteractionData.hpp"
-#include "CDPL/ForceField/MMFF94GradientCalculator.hpp"
 #include "CDPL/ForceField/ElasticPotentialList.hpp"
 #include "CDPL/Chem/Hydrogen3DCoordinatesCalculator.hpp"
 #include "CDPL/Chem/AutomorphismGroupSearch.hpp"
@@ -50,6 +49,8 @@
 #include "CDPL/Util/ObjectPool.hpp"
 #include "CDPL/Internal/Timer.hpp"
 
+#include "MMFF94GradientCalculatorSelector.hpp"
+
 
 namespace CDPL
 {
@@ -149,7 +150,7 @@ namespace CDPL
 
             bool has3DCoordinates(const Chem::Atom& atom) const;
 
-            typedef ForceField::MMFF94GradientCalculator<double>                  MMFF94GradientCalculator;
+            typedef MMFF94GradientCalculatorSelector                              MMFF94GradientCalculator;
             typedef ForceField::MMFF94InteractionParameterizer                    MMFF94InteractionParameterizer;
             typedef ForceField::MMFF94InteractionData                             MMFF94InteractionData;
             typedef ForceField::ElasticPotentialList                              ElasticPotentialList;
@@ -99,7 +99,7 @@ double ConfGen::FragmentConformerGeneratorSettings::FragmentSettings::getMinRMSD
 
 
 ConfGen::FragmentConformerGeneratorSettings::FragmentConformerGeneratorSettings():
-    preserveBondGeom(false), forceFieldType(ForceFieldType::MMFF94S_RTOR_NO_ESTAT), strictParam(true), 
+    preserveBondGeom(false), forceFieldType(ForceFieldType::MMFF94S_RTOR_NO_ESTAT), strictParam(true), packedFFEval(false), 
     dielectricConst(ForceField::MMFF94ElectrostaticInteractionParameterizer::DEF_DIELECTRIC_CONSTANT),
     distExponent(ForceField::MMFF94ElectrostaticInteractionParameterizer::DEF_DISTANCE_EXPONENT),
     maxNumRefIters(0), refStopGrad(0.1), mcRotorBondCountThresh(10), srSamplingFactor(6) 
@@ -156,6 +156,16 @@ bool ConfGen::FragmentConformerGeneratorSettings::strictForceFieldParameterizati
     return strictParam;
 }
 
+void ConfGen::FragmentConformerGeneratorSettings::packedForceFieldEvaluation(bool packed)
+{
+    packedFFEval = packed;
+}
+
+bool ConfGen::FragmentConformerGeneratorSettings::packedForceFieldEvaluation() const
+{
+    return packedFFEval;
+}
+
 void ConfGen::FragmentConformerGeneratorSettings::setDielectricConstant(double de_const)
 {
     dielectricConst = de_const;
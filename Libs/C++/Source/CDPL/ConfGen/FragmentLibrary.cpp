@@ -25,15 +25,23 @@
 #include "StaticInit.hpp"
 
 #include <string>
+#include <sstream>
+#include <fstream>
+#include <vector>
+#include <utility>
+#include <algorithm>
 
 #include <boost/iostreams/device/array.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
 #include <boost/iostreams/stream.hpp>
 
 #include "CDPL/ConfGen/FragmentLibrary.hpp"
 #include "CDPL/Base/Exceptions.hpp"
+#include "CDPL/Internal/ByteBuffer.hpp"
 
 #include "CFLFragmentLibraryEntryReader.hpp"
 #include "CFLFragmentLibraryEntryWriter.hpp"
+#include "CDFFormatData.hpp"
 #include "FragmentLibraryData.hpp"
 
 
@@ -45,6 +53,8 @@ namespace
 
     const ConfGen::FragmentLibraryEntry::SharedPointer NO_ENTRY;
 
+    constexpr std::size_t INDEX_ENTRY_SIZE = 2 * sizeof(std::uint64_t);
+
     ConfGen::FragmentLibrary::SharedPointer builtinFragLib(new ConfGen::FragmentLibrary());
 
     std::once_flag initBuiltinFragLibFlag;
@@ -53,18 +63,177 @@ namespace
     {
         builtinFragLib->loadDefaults();
     }
+
+    std::uint64_t getUInt64(const char* data)
+    {
+        Internal::ByteBuffer bbuf(0);
+        std::uint64_t value;
+
+        bbuf.wrap(data, sizeof(std::uint64_t));
+        bbuf.getInt(value);
+
+        return value;
+    }
+
+    bool getHeader(const char* data, ConfGen::CDF::Header& header)
+    {
+        Internal::ByteBuffer bbuf(0);
+
+        bbuf.wrap(data, ConfGen::CDF::HEADER_SIZE);
+        bbuf.getInt(header.formatID);
+        bbuf.getInt(header.recordTypeID);
+        bbuf.getInt(header.recordFormatVersion);
+        bbuf.getInt(header.recordDataLength);
+
+        return (header.formatID == ConfGen::CDF::FORMAT_ID);
+    }
 } // namespace
 
 
-ConfGen::FragmentLibrary::SharedPointer ConfGen::FragmentLibrary::defaultLib = builtinFragLib;
+struct ConfGen::FragmentLibrary::EntryIndex
+{
+
+    typedef boost::iostreams::mapped_file_source     MappedFile;
+    typedef std::pair<std::uint64_t, std::uint64_t> HashCodeOffsetPair;
+    typedef std::vector<HashCodeOffsetPair>          HashCodeOffsetPairArray;
+
+    EntryIndex(): data(0), dataSize(0), indexData(0), numEntries(0) {}
+
+    void init();
+
+    std::uint64_t getHashCode(std::size_t idx) const;
+
+    std::size_t findEntry(std::uint64_t hash_code) const;
+
+    FragmentLibraryEntry::SharedPointer decodeEntry(std::size_t idx, CFLFragmentLibraryEntryReader& reader) const;
+
+    std::unique_ptr<MappedFile> mappedFile;
+    const char*                 data;
+    std::size_t                 dataSize;
+    const char*                 indexData;
+    std::size_t                 numEntries;
+    HashCodeOffsetPairArray     scannedEntries;
+};
+
+
+void ConfGen::FragmentLibrary::EntryIndex::init()
+{
+    CDF::Header header;
+
+    if (dataSize >= CDF::HEADER_SIZE && getHeader(data, header) && header.recordTypeID == CDF::FRAGLIB_INDEX_RECORD_ID) {
+        if (header.recordDataLength < sizeof(std::uint64_t) || header.recordDataLength > (dataSize - CDF::HEADER_SIZE))
+            throw Base::IOError("FragmentLibrary: invalid fragment library index record");
+
+        numEntries = getUInt64(data + CDF::HEADER_SIZE);
+
+        if ((header.recordDataLength - sizeof(std::uint64_t)) / INDEX_ENTRY_SIZE != numEntries ||
+            (header.recordDataLength - sizeof(std::uint64_t)) % INDEX_ENTRY_SIZE != 0)
+            throw Base::IOError("FragmentLibrary: invalid fragment library index record");
+
+        indexData = data + CDF::HEADER_SIZE + sizeof(std::uint64_t);
+        return;
+    }
+
+    // no stored index - locate the entry records by a scan of the record headers
+
+    for (std::size_t pos = 0; pos < dataSize; ) {
+        if ((dataSize - pos) < CDF::HEADER_SIZE || !getHeader(data + pos, header))
+            throw Base::IOError("FragmentLibrary: invalid fragment library data, could not read CDF-header");
+
+        if (header.recordDataLength > (dataSize - pos - CDF::HEADER_SIZE))
+            throw Base::IOError("FragmentLibrary: invalid fragment library data, unexpected end of data");
+
+        if (header.recordTypeID == CDF::FRAGLIB_DATA_RECORD_ID) {
+            if (header.recordDataLength < sizeof(std::uint64_t))
+                throw Base::IOError("FragmentLibrary: invalid fragment library data, truncated entry record");
+
+            scannedEntries.emplace_back(getUInt64(data + pos + CDF::HEADER_SIZE), pos);
+        }
+
+        pos += CDF::HEADER_SIZE + header.recordDataLength;
+    }
+
+    // on duplicate hash codes the first entry wins (as with load())
+
+    std::stable_sort(scannedEntries.begin(), scannedEntries.end(),
+                     [](const HashCodeOffsetPair& e1, const HashCodeOffsetPair& e2) { return (e1.first < e2.first); });
+
+    scannedEntries.erase(std::unique(scannedEntries.begin(), scannedEntries.end(),
+                                     [](const HashCodeOffsetPair& e1, const HashCodeOffsetPair& e2) { return (e1.first == e2.first); }),
+                         scannedEntries.end());
+
+    numEntries = scannedEntries.size();
+}
+
+std::uint64_t ConfGen::FragmentLibrary::EntryIndex::getHashCode(std::size_t idx) const
+{
+    if (indexData)
+        return getUInt64(indexData + idx * INDEX_ENTRY_SIZE);
+
+    return scannedEntries[idx].first;
+}
 
+std::size_t ConfGen::FragmentLibrary::EntryIndex::findEntry(std::uint64_t hash_code) const
+{
+    std::size_t first = 0;
+    std::size_t last = numEntries;
+
+    while (first < last) {
+        std::size_t mid = first + (last - first) / 2;
+
+        if (getHashCode(mid) < hash_code)
+            first = mid + 1;
+        else
+            last = mid;
+    }
+
+    if (first < numEntries && getHashCode(first) == hash_code)
+        return first;
+
+    return numEntries;
+}
+
+ConfGen::FragmentLibraryEntry::SharedPointer
+ConfGen::FragmentLibrary::EntryIndex::decodeEntry(std::size_t idx, CFLFragmentLibraryEntryReader& reader) const
+{
+    std::uint64_t offset = (indexData ? getUInt64(indexData + idx * INDEX_ENTRY_SIZE + sizeof(std::uint64_t)) : scannedEntries[idx].second);
 
-ConfGen::FragmentLibrary::FragmentLibrary() {}
+    if (offset >= dataSize)
+        throw Base::IOError("FragmentLibrary: invalid fragment library index, entry offset out of range");
 
-ConfGen::FragmentLibrary::FragmentLibrary(const FragmentLibrary& lib):
-    hashToEntryMap(lib.hashToEntryMap)
+    FragmentLibraryEntry::SharedPointer entry(new FragmentLibraryEntry());
+
+    try {
+        if (!reader.read(data + offset, dataSize - offset, *entry))
+            throw Base::IOError("unspecified error");
+
+    } catch (const std::exception& e) {
+        throw Base::IOError("FragmentLibrary: error while decoding fragment library entry: " + std::string(e.what()));
+    }
+
+    if (entry->getHashCode() != getHashCode(idx))
+        throw Base::IOError("FragmentLibrary: invalid fragment library index, entry hash code mismatch");
+
+    return entry;
+}
+
+
+ConfGen::FragmentLibrary::SharedPointer ConfGen::FragmentLibrary::defaultLib = builtinFragLib;
+
+
+ConfGen::FragmentLibrary::FragmentLibrary():
+    numDecodedEntries(0)
 {}
 
+ConfGen::FragmentLibrary::FragmentLibrary(const FragmentLibrary& lib)
+{
+    std::shared_lock<std::shared_mutex> lock(lib.indexMutex);
+
+    hashToEntryMap    = lib.hashToEntryMap;
+    entryIndex        = lib.entryIndex;
+    numDecodedEntries = lib.numDecodedEntries;
+}
+
 ConfGen::FragmentLibrary::~FragmentLibrary() {}
 
 ConfGen::FragmentLibrary& ConfGen::FragmentLibrary::operator=(const FragmentLibrary& lib)
@@ -72,16 +241,31 @@ ConfGen::FragmentLibrary& ConfGen::FragmentLibrary::operator=(const FragmentLibr
     if (this == &lib)
         return *this;
 
-    hashToEntryMap = lib.hashToEntryMap;
+    std::shared_lock<std::shared_mutex> lock(lib.indexMutex);
+
+    hashToEntryMap    = lib.hashToEntryMap;
+    entryIndex        = lib.entryIndex;
+    numDecodedEntries = lib.numDecodedEntries;
 
     return *this;
 }
 
 void ConfGen::FragmentLibrary::addEntries(const FragmentLibrary& lib)
 {
+    if (this == &lib)
+        return;
+
+    lib.decodeAllEntries();
+
+    std::shared_lock<std::shared_mutex> src_lock(lib.indexMutex, std::defer_lock);
+    std::unique_lock<std::shared_mutex> lock(indexMutex, std::defer_lock);
+
+    std::lock(src_lock, lock);
+
     for (HashToEntryMap::iterator it = lib.hashToEntryMap.begin(), end = lib.hashToEntryMap.end();
          it != end; ++it)
-        hashToEntryMap.insert(*it);
+        if (!indexContainsEntry(it->first))
+            hashToEntryMap.insert(*it);
 }
 
 bool ConfGen::FragmentLibrary::addEntry(const FragmentLibraryEntry::SharedPointer& entry)
@@ -89,84 +273,138 @@ bool ConfGen::FragmentLibrary::addEntry(const FragmentLibraryEntry::SharedPointe
     if (!entry)
         return false;
 
+    std::lock_guard<std::shared_mutex> lock(indexMutex);
+
+    if (indexContainsEntry(entry->getHashCode()))
+        return false;
+
     return hashToEntryMap.insert(Entry(entry->getHashCode(), entry)).second;
 }
 
 const ConfGen::FragmentLibraryEntry::SharedPointer&
 ConfGen::FragmentLibrary::getEntry(std::uint64_t hash_code) const
 {
-    HashToEntryMap::iterator it = hashToEntryMap.find(hash_code);
+    EntryIndexPointer index;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(indexMutex);
+
+        HashToEntryMap::const_iterator it = hashToEntryMap.find(hash_code);
+
+        if (it != hashToEntryMap.end())
+            return it->second;
+
+        if (!entryIndex)
+            return NO_ENTRY;
+
+        index = entryIndex;
+    }
 
-    if (it == hashToEntryMap.end())
+    std::size_t idx = index->findEntry(hash_code);
+
+    if (idx == index->numEntries)
         return NO_ENTRY;
 
-    return it->second;
+    // decode without holding the lock - if another thread decoded the same entry meanwhile, its result is kept
+
+    CFLFragmentLibraryEntryReader reader;
+    FragmentLibraryEntry::SharedPointer entry = index->decodeEntry(idx, reader);
+
+    std::lock_guard<std::shared_mutex> lock(indexMutex);
+
+    std::pair<HashToEntryMap::iterator, bool> res = hashToEntryMap.insert(Entry(hash_code, entry));
+
+    if (res.second && entryIndex == index)
+        numDecodedEntries++;
+
+    return res.first->second;
 }
 
 bool ConfGen::FragmentLibrary::containsEntry(std::uint64_t hash_code) const
 {
-    return (hashToEntryMap.find(hash_code) != hashToEntryMap.end());
+    std::shared_lock<std::shared_mutex> lock(indexMutex);
+
+    return (hashToEntryMap.find(hash_code) != hashToEntryMap.end() || indexContainsEntry(hash_code));
 }
 
 std::size_t ConfGen::FragmentLibrary::getNumEntries() const
 {
-    return hashToEntryMap.size();
+    std::shared_lock<std::shared_mutex> lock(indexMutex);
+
+    if (!entryIndex)
+        return hashToEntryMap.size();
+
+    return (hashToEntryMap.size() + entryIndex->numEntries - numDecodedEntries);
 }
 
 void ConfGen::FragmentLibrary::clear()
 {
-    hashToEntryMap.clear();
+    setEntryIndex(EntryIndexPointer());
 }
 
 bool ConfGen::FragmentLibrary::removeEntry(std::uint64_t hash_code)
 {
+    decodeAllEntries();
+
+    std::lock_guard<std::shared_mutex> lock(indexMutex);
+
     return (hashToEntryMap.erase(hash_code) > 0);
 }
 
 ConfGen::FragmentLibrary::EntryIterator
 ConfGen::FragmentLibrary::removeEntry(const EntryIterator& it)
 {
+    std::lock_guard<std::shared_mutex> lock(indexMutex);
+
     return hashToEntryMap.erase(it);
 }
 
 ConfGen::FragmentLibrary::ConstEntryIterator ConfGen::FragmentLibrary::getEntriesBegin() const
 {
+    decodeAllEntries();
+
     return hashToEntryMap.begin();
 }
 
 ConfGen::FragmentLibrary::ConstEntryIterator ConfGen::FragmentLibrary::getEntriesEnd() const
 {
+    decodeAllEntries();
+
     return hashToEntryMap.end();
 }
 
 ConfGen::FragmentLibrary::EntryIterator ConfGen::FragmentLibrary::getEntriesBegin()
 {
+    decodeAllEntries();
+
     return hashToEntryMap.begin();
 }
 
 ConfGen::FragmentLibrary::EntryIterator ConfGen::FragmentLibrary::getEntriesEnd()
 {
+    decodeAllEntries();
+
     return hashToEntryMap.end();
 }
 
 ConfGen::FragmentLibrary::ConstEntryIterator ConfGen::FragmentLibrary::begin() const
 {
-    return hashToEntryMap.begin();
+    return getEntriesBegin();
 }
 
 ConfGen::FragmentLibrary::ConstEntryIterator ConfGen::FragmentLibrary::end() const
 {
-    return hashToEntryMap.end();
+    return getEntriesEnd();
 }
 
 ConfGen::FragmentLibrary::EntryIterator ConfGen::FragmentLibrary::begin()
 {
-    return hashToEntryMap.begin();
+    return getEntriesBegin();
 }
 
 ConfGen::FragmentLibrary::EntryIterator ConfGen::FragmentLibrary::end()
 {
-    return hashToEntryMap.end();
+    return getEntriesEnd();
 }
 
 std::mutex& ConfGen::FragmentLibrary::getMutex()
@@ -185,7 +423,10 @@ void ConfGen::FragmentLibrary::load(std::istream& is)
             if (!reader.read(is, *entry))
                 break;
 
-            hashToEntryMap.insert(Entry(entry->getHashCode(), entry));
+            std::lock_guard<std::shared_mutex> lock(indexMutex);
+
+            if (!indexContainsEntry(entry->getHashCode()))
+                hashToEntryMap.insert(Entry(entry->getHashCode(), entry));
 
         } catch (const std::exception& e) {
             throw Base::IOError("FragmentLibrary: error while loading fragment library: " +
@@ -198,6 +439,10 @@ void ConfGen::FragmentLibrary::save(std::ostream& os) const
 {
     CFLFragmentLibraryEntryWriter writer;
 
+    decodeAllEntries();
+
+    std::shared_lock<std::shared_mutex> lock(indexMutex);
+
     for (HashToEntryMap::const_iterator it = hashToEntryMap.begin(), end = hashToEntryMap.end();
          it != end; ++it) {
         try {
@@ -212,12 +457,110 @@ void ConfGen::FragmentLibrary::save(std::ostream& os) const
     }
 }
 
+void ConfGen::FragmentLibrary::saveIndexed(std::ostream& os) const
+{
+    typedef std::vector<FragmentLibraryEntry::SharedPointer> EntryList;
+
+    decodeAllEntries();
+
+    EntryList entries;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(indexMutex);
+
+        entries.reserve(hashToEntryMap.size());
+
+        for (HashToEntryMap::const_iterator it = hashToEntryMap.begin(), end = hashToEntryMap.end(); it != end; ++it)
+            entries.push_back(it->second);
+    }
+
+    std::sort(entries.begin(), entries.end(),
+              [](const FragmentLibraryEntry::SharedPointer& e1, const FragmentLibraryEntry::SharedPointer& e2) { return (e1->getHashCode() < e2->getHashCode()); });
+
+    // the entry records get written in hash code order behind the index record
+
+    std::uint64_t index_data_len = sizeof(std::uint64_t) + entries.size() * INDEX_ENTRY_SIZE;
+    std::ostringstream entry_os(std::ios_base::out | std::ios_base::binary);
+    CFLFragmentLibraryEntryWriter writer;
+    Internal::ByteBuffer index_buf(CDF::HEADER_SIZE + index_data_len);
+
+    index_buf.putInt(CDF::FORMAT_ID, false);
+    index_buf.putInt(CDF::FRAGLIB_INDEX_RECORD_ID, false);
+    index_buf.putInt(CDF::CURR_FORMAT_VERSION, false);
+    index_buf.putInt(index_data_len, false);
+    index_buf.putInt(std::uint64_t(entries.size()), false);
+
+    try {
+        for (EntryList::const_iterator it = entries.begin(), end = entries.end(); it != end; ++it) {
+            std::uint64_t offset = CDF::HEADER_SIZE + index_data_len + std::uint64_t(entry_os.tellp());
+
+            if (!writer.write(entry_os, **it))
+                throw Base::IOError("unspecified error");
+
+            index_buf.putInt((*it)->getHashCode(), false);
+            index_buf.putInt(offset, false);
+        }
+
+        index_buf.writeBuffer(os);
+
+        std::string entry_data = entry_os.str();
+
+        os.write(entry_data.data(), entry_data.size());
+
+        if (!os.good())
+            throw Base::IOError("output stream write error");
+
+    } catch (const std::exception& e) {
+        throw Base::IOError("FragmentLibrary: error while saving fragment library: " +
+                            std::string(e.what()));
+    }
+}
+
+void ConfGen::FragmentLibrary::mapFile(const std::string& file_name)
+{
+    std::shared_ptr<EntryIndex> index(new EntryIndex());
+    std::ifstream is(file_name, std::ios_base::in | std::ios_base::binary | std::ios_base::ate);
+
+    if (!is)
+        throw Base::IOError("FragmentLibrary: could not open fragment library file '" + file_name + "'");
+
+    if (is.tellg() > 0) {
+        try {
+            index->mappedFile.reset(new EntryIndex::MappedFile(file_name));
+
+        } catch (const std::exception& e) {
+            throw Base::IOError("FragmentLibrary: could not map fragment library file '" + file_name + "': " +
+                                std::string(e.what()));
+        }
+
+        index->data     = index->mappedFile->data();
+        index->dataSize = index->mappedFile->size();
+        index->init();
+    }
+
+    setEntryIndex(index);
+}
+
 void ConfGen::FragmentLibrary::loadDefaults()
 {
     std::pair<const char*, std::size_t> builtin_frag_data = FragmentLibraryData::get();
-    boost::iostreams::stream<boost::iostreams::array_source> is(builtin_frag_data.first, builtin_frag_data.second);
 
-    load(is);
+    if (getNumEntries() > 0) {
+        boost::iostreams::stream<boost::iostreams::array_source> is(builtin_frag_data.first, builtin_frag_data.second);
+
+        load(is);
+        return;
+    }
+
+    // the built-in data are part of the read-only library image - index them, decode on demand
+
+    std::shared_ptr<EntryIndex> index(new EntryIndex());
+
+    index->data     = builtin_frag_data.first;
+    index->dataSize = builtin_frag_data.second;
+    index->init();
+
+    setEntryIndex(index);
 }
 
 void ConfGen::FragmentLibrary::set(const SharedPointer& lib)
@@ -231,3 +574,50 @@ const ConfGen::FragmentLibrary::SharedPointer& ConfGen::FragmentLibrary::get()
 
     return defaultLib;
 }
+
+void ConfGen::FragmentLibrary::setEntryIndex(const EntryIndexPointer& index)
+{
+    std::lock_guard<std::shared_mutex> lock(indexMutex);
+
+    hashToEntryMap.clear();
+
+    entryIndex        = index;
+    numDecodedEntries = 0;
+}
+
+bool ConfGen::FragmentLibrary::indexContainsEntry(std::uint64_t hash_code) const
+{
+    if (!entryIndex)
+        return false;
+
+    return (entryIndex->findEntry(hash_code) != entryIndex->numEntries);
+}
+
+void ConfGen::FragmentLibrary::decodeAllEntries() const
+{
+    {
+        std::shared_lock<std::shared_mutex> lock(indexMutex);
+
+        if (!entryIndex)
+            return;
+    }
+
+    std::lock_guard<std::shared_mutex> lock(indexMutex);
+
+    if (!entryIndex)
+        return;
+
+    CFLFragmentLibraryEntryReader reader;
+
+    hashToEntryMap.reserve(hashToEntryMap.size() + entryIndex->numEntries - numDecodedEntries);
+
+    for (std::size_t i = 0; i < entryIndex->numEntries; i++) {
+        std::uint64_t hash_code = entryIndex->getHashCode(i);
+
+        if (hashToEntryMap.find(hash_code) == hashToEntryMap.end())
+            hashToEntryMap.insert(Entry(hash_code, entryIndex->decodeEntry(i, reader)));
+    }
+
+    entryIndex.reset();
+    numDecodedEntries = 0;
+}
@@ -26,6 +26,7 @@
 
 #include <algorithm>
 #include <functional>
+#include <utility>
 
 #include "CDPL/Chem/Bond.hpp"
 #include "CDPL/Chem/FragmentList.hpp"
@@ -47,7 +48,7 @@ using namespace CDPL;
 ConfGen::FragmentTree::FragmentTree(std::size_t max_conf_data_cache_size):
     confDataCache(max_conf_data_cache_size),
     nodeCache(std::bind(&FragmentTree::createTreeNode, this), MAX_TREE_NODE_CACHE_SIZE), 
-    molGraph(0)
+    molGraph(0), taskScheduler(0), packedMMFF94EnergyCalc(false)
 {
     nodeCache.setCleanupFunction(std::bind(&FragmentTreeNode::clearConformers, std::placeholders::_1));
 
@@ -87,6 +88,26 @@ const ConfGen::CallbackFunction& ConfGen::FragmentTree::getTimeoutCallback() con
     return timeoutCallback;
 }
 
+void ConfGen::FragmentTree::setTaskScheduler(TaskScheduler* scheduler)
+{
+    taskScheduler = scheduler;
+}
+
+ConfGen::TaskScheduler* ConfGen::FragmentTree::getTaskScheduler() const
+{
+    return taskScheduler;
+}
+
+void ConfGen::FragmentTree::usePackedMMFF94EnergyCalculator(bool use)
+{
+    packedMMFF94EnergyCalc = use;
+}
+
+bool ConfGen::FragmentTree::packedMMFF94EnergyCalculatorUsed() const
+{
+    return packedMMFF94EnergyCalc;
+}
+
 std::size_t ConfGen::FragmentTree::getNumFragments() const
 {
     return fragToNodeMap.size();
@@ -231,7 +252,26 @@ const Chem::Bond* ConfGen::FragmentTree::findConnectingBond(FragmentTreeNode* no
 
 ConfGen::ConformerData::SharedPointer ConfGen::FragmentTree::allocConformerData()
 {
-    ConformerData::SharedPointer conf_data = confDataCache.get();
+    ConformerData::SharedPointer conf_data;
+
+    if (taskScheduler) {
+        // subtrees may get processed concurrently -> cache accesses (including the deferred return of
+        // the conformer data objects) have to be serialized
+
+        ConformerDataReleaser releaser{this, ConformerData::SharedPointer()};
+
+        {
+            std::lock_guard<std::mutex> lock(confDataCacheMutex);
+
+            releaser.confData = confDataCache.get();
+        }
+
+        ConformerData* conf_data_ptr = releaser.confData.get();
+
+        conf_data.reset(conf_data_ptr, std::move(releaser));
+
+    } else
+        conf_data = confDataCache.get();
 
     conf_data->resize(molGraph->getNumAtoms());
     conf_data->setEnergy(0.0);
@@ -239,6 +279,13 @@ ConfGen::ConformerData::SharedPointer ConfGen::FragmentTree::allocConformerData(
     return conf_data;
 }
 
+void ConfGen::FragmentTree::ConformerDataReleaser::operator()(ConformerData*) const
+{
+    std::lock_guard<std::mutex> lock(tree->confDataCacheMutex);
+
+    confData.reset();
+}
+
 ConfGen::FragmentTreeNode* ConfGen::FragmentTree::allocTreeNode()
 {
     FragmentTreeNode* node = nodeCache.get();
@@ -32,6 +32,7 @@
 #include <utility>
 #include <vector>
 #include <cstddef>
+#include <mutex>
 
 #include "CDPL/ConfGen/ConformerData.hpp"
 #include "CDPL/ConfGen/CallbackFunction.hpp"
@@ -53,6 +54,7 @@ namespace CDPL
     {
 
         class FragmentTreeNode;
+        class TaskScheduler;
 
         class FragmentTree
         {
@@ -76,6 +78,14 @@ namespace CDPL
 
             const CallbackFunction& getTimeoutCallback() const;
 
+            void setTaskScheduler(TaskScheduler* scheduler);
+
+            TaskScheduler* getTaskScheduler() const;
+
+            void usePackedMMFF94EnergyCalculator(bool use);
+
+            bool packedMMFF94EnergyCalculatorUsed() const;
+
             const Chem::MolecularGraph* getMolecularGraph() const;
 
             FragmentTreeNode* getRoot() const;
@@ -106,6 +116,15 @@ namespace CDPL
             bool aborted() const;
             bool timedout() const;
 
+            struct ConformerDataReleaser
+            {
+
+                void operator()(ConformerData*) const;
+
+                FragmentTree*                        tree;
+                mutable ConformerData::SharedPointer confData;
+            };
+
             typedef Util::ObjectPool<ConformerData>                                           ConformerDataCache;
             typedef std::vector<const Chem::Bond*>                                            BondList;
             typedef Util::ObjectStack<FragmentTreeNode>                                       TreeNodeCache;
@@ -121,6 +140,9 @@ namespace CDPL
             FragmentToNodeMap           fragToNodeMap;
             CallbackFunction            abortCallback;
             CallbackFunction            timeoutCallback;
+            TaskScheduler*              taskScheduler;
+            bool                        packedMMFF94EnergyCalc;
+            std::mutex                  confDataCacheMutex;
         };
     } // namespace ConfGen
 } // namespace CDPL
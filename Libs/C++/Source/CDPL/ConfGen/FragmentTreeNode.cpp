@@ -26,6 +26,10 @@
 
 #include <cmath>
 #include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <chrono>
 
 #include "CDPL/ConfGen/ReturnCode.hpp"
 #include "CDPL/Chem/MolecularGraph.hpp"
@@ -39,6 +43,7 @@
 #include "FragmentTreeNode.hpp"
 #include "FragmentTree.hpp"
 #include "ForceFieldInteractionMask.hpp"
+#include "TaskScheduler.hpp"
 #include "UtilityFunctions.hpp"
 
 
@@ -59,14 +64,25 @@ namespace
         return (conf_data1->getEnergy() < conf_data2->getEnergy());
     } 
 
+    struct SubtreeTaskData
+    {
+
+        std::mutex              mutex;
+        std::condition_variable condition;
+        bool                    done{false};
+        unsigned int            retCode{ConfGen::ReturnCode::SUCCESS};
+        std::exception_ptr      exception;
+    };
+
     constexpr double CONFORMER_LINEUP_SPACING       = 4.0;
     const double MAX_TORSION_REF_BOND_ANGLE_COS = std::cos(2.5 / 180.0 * M_PI);
     constexpr double MAX_PLANAR_ATOM_GEOM_OOP_ANGLE = 10.0 / 180.0 * M_PI;
+    constexpr std::size_t CALLBACK_POLLING_INTERVAL = 20; // ms
 }
 
 
 ConfGen::FragmentTreeNode::FragmentTreeNode(ConfGen::FragmentTree& owner): 
-    owner(owner), parent(0), splitBond(0), changed(true)
+    owner(owner), parent(0), splitBond(0), usePackedMMFF94EnergyCalc(false), changed(true)
 {
     splitBondAtoms[0] = 0;
     splitBondAtoms[1] = 0;
@@ -214,7 +230,12 @@ void ConfGen::FragmentTreeNode::distMMFF94Parameters(const ForceField::MMFF94Int
     extractFragmentMMFF94InteractionParams4(ia_data.getTorsionInteractions(), mmff94Data.getTorsionInteractions(), 
                                             ia_mask.torsion, atomMask);
 
-    mmff94EnergyCalc.setup(mmff94Data);
+    usePackedMMFF94EnergyCalc = owner.packedMMFF94EnergyCalculatorUsed();
+
+    if (usePackedMMFF94EnergyCalc)
+        packedMMFF94EnergyCalc.setup(mmff94Data, owner.getMolecularGraph()->getNumAtoms());
+    else
+        mmff94EnergyCalc.setup(mmff94Data);
 }
 
 const ConfGen::ConformerDataArray& ConfGen::FragmentTreeNode::getConformers() const
@@ -308,12 +329,7 @@ unsigned int ConfGen::FragmentTreeNode::generateConformers(double e_window, std:
         return ReturnCode::TORSION_DRIVING_FAILED;
     }
 
-    unsigned int ret_code = leftChild->generateConformers(e_window, max_pool_size);
-
-    if (ret_code != ReturnCode::SUCCESS)
-        return ret_code;
-
-    ret_code = rightChild->generateConformers(e_window, max_pool_size);
+    unsigned int ret_code = generateChildConformers(e_window, max_pool_size);
 
     if (ret_code != ReturnCode::SUCCESS)
         return ret_code;
@@ -338,6 +354,88 @@ unsigned int ConfGen::FragmentTreeNode::generateConformers(double e_window, std:
     return invokeCallbacks();
 }
 
+unsigned int ConfGen::FragmentTreeNode::generateChildConformers(double e_window, std::size_t max_pool_size)
+{
+    TaskScheduler* scheduler = owner.getTaskScheduler();
+
+    if (scheduler && leftChild->needsConformerGeneration() && rightChild->needsConformerGeneration()) {
+        // the conformers of the left subtree get generated by an idle thread (if available) while
+        // the current thread takes care of the right subtree
+
+        SubtreeTaskData task_data;
+        SubtreeTaskData* task_data_ptr = &task_data;
+        FragmentTreeNode* left_child = leftChild;
+
+        bool started = scheduler->tryExecute([task_data_ptr, left_child, e_window, max_pool_size]() {
+            unsigned int ret_code = ReturnCode::SUCCESS;
+            std::exception_ptr exception;
+
+            try {
+                ret_code = left_child->generateConformers(e_window, max_pool_size);
+
+            } catch (...) {
+                exception = std::current_exception();
+            }
+
+            std::lock_guard<std::mutex> lock(task_data_ptr->mutex);
+
+            task_data_ptr->retCode = ret_code;
+            task_data_ptr->exception = exception;
+            task_data_ptr->done = true;
+            task_data_ptr->condition.notify_all();
+        });
+
+        if (started) {
+            auto wait_for_task = [this, &task_data]() {
+                std::unique_lock<std::mutex> lock(task_data.mutex);
+
+                while (!task_data.done) {
+                    if (task_data.condition.wait_for(lock, std::chrono::milliseconds(CALLBACK_POLLING_INTERVAL)) == std::cv_status::no_timeout)
+                        continue;
+
+                    // keep the owner's callbacks polled - a stop request will also terminate the left subtree task
+
+                    lock.unlock();
+                    invokeCallbacks();
+                    lock.lock();
+                }
+            };
+
+            unsigned int ret_code = ReturnCode::SUCCESS;
+
+            try {
+                ret_code = rightChild->generateConformers(e_window, max_pool_size);
+
+            } catch (...) {
+                wait_for_task();
+                throw;
+            }
+
+            wait_for_task();
+
+            if (task_data.exception)
+                std::rethrow_exception(task_data.exception);
+
+            if (task_data.retCode != ReturnCode::SUCCESS)
+                return task_data.retCode;
+
+            return ret_code;
+        }
+    }
+
+    unsigned int ret_code = leftChild->generateConformers(e_window, max_pool_size);
+
+    if (ret_code != ReturnCode::SUCCESS)
+        return ret_code;
+
+    return rightChild->generateConformers(e_window, max_pool_size);
+}
+
+bool ConfGen::FragmentTreeNode::needsConformerGeneration() const
+{
+    return (conformers.empty() && hasChildren());
+}
+
 void ConfGen::FragmentTreeNode::lineupChildConformers(double e_window)
 {
     std::size_t num_left_chld_confs = leftChild->conformers.size();
@@ -891,6 +989,9 @@ void ConfGen::FragmentTreeNode::calcVirtualTorsionReferenceAtomVector(const Math
 
 double ConfGen::FragmentTreeNode::calcMMFF94Energy(const Math::Vector3DArray& coords)
 {
+    if (usePackedMMFF94EnergyCalc)
+        return packedMMFF94EnergyCalc(coords.getData());
+
     return mmff94EnergyCalc(coords.getData());
 }
 
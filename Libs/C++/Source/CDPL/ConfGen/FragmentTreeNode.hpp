@@ -35,6 +35,7 @@
 #include "CDPL/ConfGen/ConformerDataArray.hpp"
 #include "CDPL/ForceField/MMFF94InteractionData.hpp"
 #include "CDPL/ForceField/MMFF94EnergyCalculator.hpp"
+#include "CDPL/ForceField/MMFF94PackedEnergyCalculator.hpp"
 #include "CDPL/Util/BitSet.hpp"
 
 
@@ -130,6 +131,10 @@ namespace CDPL
 
             FragmentTreeNode& operator=(const FragmentTreeNode&);
 
+            unsigned int generateChildConformers(double e_window, std::size_t max_pool_size);
+
+            bool needsConformerGeneration() const;
+
             void lineupChildConformers(double e_window);
             void alignAndRotateChildConformers(double e_window);
 
@@ -175,25 +180,28 @@ namespace CDPL
 
             typedef ForceField::MMFF94InteractionData          MMFF94InteractionData;
             typedef ForceField::MMFF94EnergyCalculator<double> MMFF94EnergyCalculator;
-
-            FragmentTree&          owner;
-            FragmentTreeNode*      parent;
-            const Chem::Bond*      splitBond;
-            const Chem::Atom*      splitBondAtoms[2];
-            const Chem::Atom*      torsionRefAtoms[2];
-            FragmentTreeNode*      leftChild;
-            FragmentTreeNode*      rightChild;
-            IndexArray             atomIndices;
-            Util::BitSet           atomMask;
-            Util::BitSet           coreAtomMask;
-            ConformerDataArray     conformers;
-            ConformerDataArray     tmpConformers;
-            DoubleArray            torsionAngles;
-            DoubleArray            torsionAngleCosines;
-            DoubleArray            torsionAngleSines;
-            MMFF94InteractionData  mmff94Data;
-            MMFF94EnergyCalculator mmff94EnergyCalc;
-            bool                   changed;
+            typedef ForceField::MMFF94PackedEnergyCalculator   MMFF94PackedEnergyCalculator;
+
+            FragmentTree&                owner;
+            FragmentTreeNode*            parent;
+            const Chem::Bond*            splitBond;
+            const Chem::Atom*            splitBondAtoms[2];
+            const Chem::Atom*            torsionRefAtoms[2];
+            FragmentTreeNode*            leftChild;
+            FragmentTreeNode*            rightChild;
+            IndexArray                   atomIndices;
+            Util::BitSet                 atomMask;
+            Util::BitSet                 coreAtomMask;
+            ConformerDataArray           conformers;
+            ConformerDataArray           tmpConformers;
+            DoubleArray                  torsionAngles;
+            DoubleArray                  torsionAngleCosines;
+            DoubleArray                  torsionAngleSines;
+            MMFF94InteractionData        mmff94Data;
+            MMFF94EnergyCalculator       mmff94EnergyCalc;
+            MMFF94PackedEnergyCalculator packedMMFF94EnergyCalc;
+            bool                         usePackedMMFF94EnergyCalc;
+            bool                         changed;
         };
     } // namespace ConfGen
 } // namespace CDPL
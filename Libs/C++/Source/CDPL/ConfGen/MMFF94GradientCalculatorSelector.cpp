@@ -0,0 +1,62 @@
+/* 
+ * MMFF94GradientCalculatorSelector.cpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+ 
+#include "StaticInit.hpp"
+
+#include "MMFF94GradientCalculatorSelector.hpp"
+
+
+using namespace CDPL;
+
+
+ConfGen::MMFF94GradientCalculatorSelector::MMFF94GradientCalculatorSelector():
+    packed(false)
+{}
+
+void ConfGen::MMFF94GradientCalculatorSelector::setup(const ForceField::MMFF94InteractionData& ia_data, std::size_t num_atoms, bool use_packed)
+{
+    packed = use_packed;
+
+    if (packed)
+        packedCalculator.setup(ia_data, num_atoms);
+    else
+        calculator.setup(ia_data, num_atoms);
+}
+
+bool ConfGen::MMFF94GradientCalculatorSelector::packedCalculatorUsed() const
+{
+    return packed;
+}
+
+void ConfGen::MMFF94GradientCalculatorSelector::setFixedAtomMask(const Util::BitSet& mask)
+{
+    calculator.setFixedAtomMask(mask);
+    packedCalculator.setFixedAtomMask(mask);
+}
+
+void ConfGen::MMFF94GradientCalculatorSelector::resetFixedAtomMask()
+{
+    calculator.resetFixedAtomMask();
+    packedCalculator.resetFixedAtomMask();
+}
@@ -0,0 +1,97 @@
+/* 
+ * MMFF94GradientCalculatorSelector.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+/**
+ * \file
+ * \brief Definition of the class CDPL::ConfGen::MMFF94GradientCalculatorSelector.
+ */
+
+#ifndef CDPL_CONFGEN_MMFF94GRADIENTCALCULATORSELECTOR_HPP
+#define CDPL_CONFGEN_MMFF94GRADIENTCALCULATORSELECTOR_HPP
+
+#include <cstddef>
+
+#include "CDPL/ForceField/MMFF94GradientCalculator.hpp"
+#include "CDPL/ForceField/MMFF94PackedGradientCalculator.hpp"
+#include "CDPL/Util/BitSet.hpp"
+
+
+namespace CDPL
+{
+
+    namespace ConfGen
+    {
+
+        /*
+         * Forwards MMFF94 energy and gradient calculations either to a ForceField::MMFF94GradientCalculator or,
+         * if requested upon setup(), to a ForceField::MMFF94PackedGradientCalculator instance.
+         */
+        class MMFF94GradientCalculatorSelector
+        {
+
+          public:
+            MMFF94GradientCalculatorSelector();
+
+            void setup(const ForceField::MMFF94InteractionData& ia_data, std::size_t num_atoms, bool use_packed);
+
+            bool packedCalculatorUsed() const;
+
+            void setFixedAtomMask(const Util::BitSet& mask);
+
+            void resetFixedAtomMask();
+
+            template <typename CoordsArray>
+            double operator()(const CoordsArray& coords);
+
+            template <typename CoordsArray, typename GradVector>
+            double operator()(const CoordsArray& coords, GradVector& grad);
+
+          private:
+            ForceField::MMFF94GradientCalculator<double> calculator;
+            ForceField::MMFF94PackedGradientCalculator   packedCalculator;
+            bool                                         packed;
+        };
+    } // namespace ConfGen
+} // namespace CDPL
+
+
+// Implementation
+
+template <typename CoordsArray>
+double CDPL::ConfGen::MMFF94GradientCalculatorSelector::operator()(const CoordsArray& coords)
+{
+    if (packed)
+        return packedCalculator(coords);
+
+    return calculator(coords);
+}
+
+template <typename CoordsArray, typename GradVector>
+double CDPL::ConfGen::MMFF94GradientCalculatorSelector::operator()(const CoordsArray& coords, GradVector& grad)
+{
+    if (packed)
+        return packedCalculator(coords, grad);
+
+    return calculator(coords, grad);
+}
+
+#endif // CDPL_CONFGEN_MMFF94GRADIENTCALCULATORSELECTOR_HPP
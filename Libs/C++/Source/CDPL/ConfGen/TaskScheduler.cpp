@@ -0,0 +1,126 @@
+/*
+ * TaskScheduler.cpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include <algorithm>
+
+#include "TaskScheduler.hpp"
+
+
+using namespace CDPL;
+
+
+ConfGen::TaskScheduler::TaskScheduler():
+    maxNumTasks(0), numTasks(0)
+{}
+
+ConfGen::TaskScheduler::~TaskScheduler()
+{
+    wait();
+}
+
+void ConfGen::TaskScheduler::setup(const Util::ThreadPool::SharedPointer& pool, std::size_t max_num_tasks)
+{
+    wait();
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    threadPool = pool;
+    maxNumTasks = max_num_tasks;
+}
+
+void ConfGen::TaskScheduler::reset()
+{
+    setup(Util::ThreadPool::SharedPointer(), 0);
+}
+
+bool ConfGen::TaskScheduler::isEnabled() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return (threadPool && maxNumTasks > 0);
+}
+
+std::size_t ConfGen::TaskScheduler::getNumFreeSlots() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (!threadPool || numTasks >= maxNumTasks)
+        return 0;
+
+    return std::min(maxNumTasks - numTasks, threadPool->getNumIdleThreads());
+}
+
+bool ConfGen::TaskScheduler::tryExecute(const Task& task)
+{
+    Util::ThreadPool::SharedPointer pool;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (!threadPool || numTasks >= maxNumTasks)
+            return false;
+
+        pool = threadPool;
+        numTasks++;
+    }
+
+    bool started = false;
+
+    try {
+        started = pool->tryExecute([this, task]() {
+            try {
+                task();
+
+            } catch (...) {}
+
+            taskFinished();
+        });
+
+    } catch (...) {
+        taskFinished();
+        throw;
+    }
+
+    if (!started)
+        taskFinished();
+
+    return started;
+}
+
+void ConfGen::TaskScheduler::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    condition.wait(lock, [this]() { return (numTasks == 0); });
+}
+
+void ConfGen::TaskScheduler::taskFinished()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (--numTasks == 0)
+        condition.notify_all();
+}
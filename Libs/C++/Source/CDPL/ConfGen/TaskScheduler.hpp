@@ -0,0 +1,91 @@
+/*
+ * TaskScheduler.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of the class CDPL::ConfGen::TaskScheduler.
+ */
+
+#ifndef CDPL_CONFGEN_TASKSCHEDULER_HPP
+#define CDPL_CONFGEN_TASKSCHEDULER_HPP
+
+#include <cstddef>
+#include <mutex>
+#include <condition_variable>
+
+#include "CDPL/Util/ThreadPool.hpp"
+
+
+namespace CDPL
+{
+
+    namespace ConfGen
+    {
+
+        /*
+         * Hands out tasks to the idle threads of a thread pool while limiting the number of
+         * concurrently running tasks. Tasks that cannot be started have to be executed by the
+         * submitting thread.
+         */
+        class TaskScheduler
+        {
+
+          public:
+            typedef Util::ThreadPool::Task Task;
+
+            TaskScheduler();
+
+            ~TaskScheduler();
+
+            void setup(const Util::ThreadPool::SharedPointer& pool, std::size_t max_num_tasks);
+
+            void reset();
+
+            bool isEnabled() const;
+
+            std::size_t getNumFreeSlots() const;
+
+            bool tryExecute(const Task& task);
+
+            /*
+             * Waits until all started tasks (including the bookkeeping following their execution) have finished.
+             */
+            void wait();
+
+          private:
+            TaskScheduler(const TaskScheduler&);
+
+            TaskScheduler& operator=(const TaskScheduler&);
+
+            void taskFinished();
+
+            Util::ThreadPool::SharedPointer threadPool;
+            std::size_t                     maxNumTasks;
+            std::size_t                     numTasks;
+            mutable std::mutex              mutex;
+            std::condition_variable         condition;
+        };
+    } // namespace ConfGen
+} // namespace CDPL
+
+#endif // CDPL_CONFGEN_TASKSCHEDULER_HPP
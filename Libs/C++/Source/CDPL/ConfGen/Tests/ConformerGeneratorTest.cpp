@@ -0,0 +1,228 @@
+/* 
+ * ConformerGeneratorTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstddef>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/ConfGen/ConformerGenerator.hpp"
+#include "CDPL/ConfGen/ConformerSamplingMode.hpp"
+#include "CDPL/ConfGen/ReturnCode.hpp"
+#include "CDPL/ConfGen/MoleculeFunctions.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/UtilityFunctions.hpp"
+#include "CDPL/Util/ThreadPool.hpp"
+
+
+BOOST_AUTO_TEST_CASE(ConformerGeneratorMultiThreadedSamplingTest)
+{
+    using namespace CDPL;
+    using namespace ConfGen;
+
+    const static std::size_t NUM_THREADS    = 4;
+    const static std::size_t ABORT_CALL_IDX  = 10;
+    const static std::size_t MAX_NUM_SAMPLES = 50;
+
+    Chem::BasicMolecule mol;
+
+    BOOST_CHECK(Chem::parseSMILES("CCCCOc1ccccc1C(=O)NCCO", mol));
+
+    prepareForConformerGeneration(mol);
+
+    ConformerGenerator conf_gen;
+
+    conf_gen.getSettings().setSamplingMode(ConformerSamplingMode::STOCHASTIC);
+    conf_gen.getSettings().setNumThreads(NUM_THREADS);
+    conf_gen.getSettings().setTimeout(0);
+    conf_gen.getSettings().setMaxNumSampledConformers(MAX_NUM_SAMPLES);
+
+    std::thread::id caller_id = std::this_thread::get_id();
+    std::mutex mutex;
+    std::size_t num_calls = 0;
+    std::size_t num_foreign_calls = 0;
+
+    auto record_call = [&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        num_calls++;
+
+        if (std::this_thread::get_id() != caller_id)
+            num_foreign_calls++;
+    };
+
+    conf_gen.setAbortCallback([&]() -> bool {
+        record_call();
+
+        return (num_calls >= ABORT_CALL_IDX);
+    });
+
+    conf_gen.setLogMessageCallback([&](const std::string&) {
+        record_call();
+    });
+
+    // callbacks must only be invoked from the calling thread and aborting must stop all sampling threads
+
+    BOOST_CHECK(conf_gen.generate(mol) == ReturnCode::ABORTED);
+    BOOST_CHECK(num_calls >= ABORT_CALL_IDX);
+    BOOST_CHECK(num_foreign_calls == 0);
+
+    // without abort request the sampling must run to completion
+
+    num_calls = 0;
+    num_foreign_calls = 0;
+
+    conf_gen.setAbortCallback([&]() -> bool {
+        record_call();
+
+        return false;
+    });
+
+    BOOST_CHECK(conf_gen.generate(mol) == ReturnCode::SUCCESS);
+    BOOST_CHECK(conf_gen.getNumConformers() > 0);
+    BOOST_CHECK(num_calls > 0);
+    BOOST_CHECK(num_foreign_calls == 0);
+}
+
+BOOST_AUTO_TEST_CASE(ConformerGeneratorMultiThreadedSystematicSamplingTest)
+{
+    using namespace CDPL;
+    using namespace ConfGen;
+
+    const static std::size_t NUM_THREADS = 4;
+
+    Chem::BasicMolecule mol;
+
+    BOOST_CHECK(Chem::parseSMILES("CC(C)CC(NC(=O)C(Cc1ccccc1)NC(=O)c1ccncc1)C(=O)NCc1ccc(O)cc1", mol));
+
+    prepareForConformerGeneration(mol);
+
+    ConformerGenerator ref_conf_gen;
+
+    ref_conf_gen.getSettings().setSamplingMode(ConformerSamplingMode::SYSTEMATIC);
+    ref_conf_gen.getSettings().setTimeout(0);
+
+    BOOST_CHECK(ref_conf_gen.generate(mol) == ReturnCode::SUCCESS);
+    BOOST_CHECK(ref_conf_gen.getNumConformers() > 0);
+
+    ConformerGenerator conf_gen;
+
+    conf_gen.getSettings().setSamplingMode(ConformerSamplingMode::SYSTEMATIC);
+    conf_gen.getSettings().setTimeout(0);
+    conf_gen.getSettings().setNumThreads(NUM_THREADS);
+
+    std::thread::id caller_id = std::this_thread::get_id();
+    std::mutex mutex;
+    std::size_t num_foreign_calls = 0;
+
+    auto record_call = [&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (std::this_thread::get_id() != caller_id)
+            num_foreign_calls++;
+    };
+
+    conf_gen.setAbortCallback([&]() -> bool {
+        record_call();
+
+        return false;
+    });
+
+    conf_gen.setLogMessageCallback([&](const std::string&) {
+        record_call();
+    });
+
+    // concurrent generation of the torsion fragment and fragment tree branch conformers must not change the result,
+    // regardless of whether the threads are provided by a private or a user-specified thread pool
+
+    for (std::size_t i = 0; i < 2; i++) {
+        if (i == 1)
+            conf_gen.setThreadPool(Util::ThreadPool::SharedPointer(new Util::ThreadPool(NUM_THREADS - 1)));
+
+        BOOST_CHECK(conf_gen.generate(mol) == ReturnCode::SUCCESS);
+        BOOST_CHECK(num_foreign_calls == 0);
+        BOOST_CHECK_EQUAL(conf_gen.getNumConformers(), ref_conf_gen.getNumConformers());
+
+        for (std::size_t j = 0, num_confs = std::min(conf_gen.getNumConformers(), ref_conf_gen.getNumConformers()); j < num_confs; j++) {
+            const ConformerData& conf = conf_gen.getConformer(j);
+            const ConformerData& ref_conf = ref_conf_gen.getConformer(j);
+
+            BOOST_CHECK_EQUAL(conf.getEnergy(), ref_conf.getEnergy());
+            BOOST_CHECK(conf.getSize() == ref_conf.getSize());
+
+            for (std::size_t k = 0, num_atoms = std::min(conf.getSize(), ref_conf.getSize()); k < num_atoms; k++)
+                BOOST_CHECK(conf[k] == ref_conf[k]);
+        }
+    }
+
+    // an abort request of the calling thread must stop all threads
+
+    conf_gen.setAbortCallback([&]() -> bool {
+        record_call();
+
+        return true;
+    });
+
+    BOOST_CHECK(conf_gen.generate(mol) == ReturnCode::ABORTED);
+    BOOST_CHECK(num_foreign_calls == 0);
+}
+
+BOOST_AUTO_TEST_CASE(ConformerGeneratorPackedForceFieldEvaluationTest)
+{
+    using namespace CDPL;
+    using namespace ConfGen;
+
+    Chem::BasicMolecule mol;
+
+    BOOST_CHECK(Chem::parseSMILES("CCCCOc1ccccc1C(=O)NCCO", mol));
+
+    prepareForConformerGeneration(mol);
+
+    ConformerGenerator conf_gen;
+
+    // the generic force field calculators must be used by default
+
+    BOOST_CHECK(!conf_gen.getSettings().packedForceFieldEvaluation());
+    BOOST_CHECK(!conf_gen.getSettings().getFragmentBuildSettings().packedForceFieldEvaluation());
+
+    conf_gen.getSettings().packedForceFieldEvaluation(true);
+    conf_gen.getSettings().getFragmentBuildSettings().packedForceFieldEvaluation(true);
+    conf_gen.getSettings().setTimeout(0);
+
+    BOOST_CHECK(conf_gen.getSettings().packedForceFieldEvaluation());
+    BOOST_CHECK(conf_gen.getSettings().getFragmentBuildSettings().packedForceFieldEvaluation());
+
+    conf_gen.getSettings().setSamplingMode(ConformerSamplingMode::STOCHASTIC);
+    conf_gen.getSettings().setMaxNumSampledConformers(50);
+
+    BOOST_CHECK(conf_gen.generate(mol) == ReturnCode::SUCCESS);
+    BOOST_CHECK(conf_gen.getNumConformers() > 0);
+
+    conf_gen.getSettings().setSamplingMode(ConformerSamplingMode::SYSTEMATIC);
+
+    BOOST_CHECK(conf_gen.generate(mol) == ReturnCode::SUCCESS);
+    BOOST_CHECK(conf_gen.getNumConformers() > 0);
+}
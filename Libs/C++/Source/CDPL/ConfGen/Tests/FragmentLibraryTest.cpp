@@ -0,0 +1,215 @@
+/* 
+ * FragmentLibraryTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstddef>
+#include <string>
+#include <fstream>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/ConfGen/FragmentLibrary.hpp"
+#include "CDPL/Util/FileFunctions.hpp"
+#include "CDPL/Util/FileRemover.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+
+namespace
+{
+
+    const std::size_t NUM_TEST_ENTRIES = 50;
+
+    CDPL::ConfGen::FragmentLibraryEntry::SharedPointer createEntry(std::size_t idx)
+    {
+        using namespace CDPL;
+
+        ConfGen::FragmentLibraryEntry::SharedPointer entry(new ConfGen::FragmentLibraryEntry());
+
+        entry->setHashCode(idx * 7919 + 17);
+        entry->setSMILES(std::string(idx % 10 + 1, 'C'));
+
+        for (std::size_t i = 0; i < idx % 3 + 1; i++) {
+            ConfGen::ConformerData::SharedPointer conf(new ConfGen::ConformerData());
+
+            for (std::size_t j = 0; j < idx % 10 + 1; j++)
+                conf->addElement(Math::vec(1.5 * j, 0.1 * i, -0.2 * idx));
+
+            conf->setEnergy(0.5 * i + idx);
+
+            entry->addConformer(conf);
+        }
+
+        return entry;
+    }
+
+    bool isEqual(const CDPL::ConfGen::FragmentLibraryEntry& entry1, const CDPL::ConfGen::FragmentLibraryEntry& entry2)
+    {
+        if (entry1.getHashCode() != entry2.getHashCode() || entry1.getSMILES() != entry2.getSMILES() ||
+            entry1.getNumConformers() != entry2.getNumConformers())
+            return false;
+
+        for (std::size_t i = 0; i < entry1.getNumConformers(); i++) {
+            const CDPL::ConfGen::ConformerData& conf1 = entry1.getConformer(i);
+            const CDPL::ConfGen::ConformerData& conf2 = entry2.getConformer(i);
+
+            if (conf1.getEnergy() != conf2.getEnergy() || conf1.getSize() != conf2.getSize())
+                return false;
+
+            for (std::size_t j = 0; j < conf1.getSize(); j++)
+                if (conf1[j] != conf2[j])
+                    return false;
+        }
+
+        return true;
+    }
+
+    void checkLibrary(CDPL::ConfGen::FragmentLibrary& lib, const CDPL::ConfGen::FragmentLibrary& ref_lib)
+    {
+        BOOST_CHECK(lib.getNumEntries() == ref_lib.getNumEntries());
+        BOOST_CHECK(!lib.containsEntry(1));
+        BOOST_CHECK(!lib.getEntry(1));
+
+        // on demand decoding must not change the number of entries
+
+        for (CDPL::ConfGen::FragmentLibrary::ConstEntryIterator it = ref_lib.getEntriesBegin(), end = ref_lib.getEntriesEnd(); it != end; ++it) {
+            BOOST_CHECK(lib.containsEntry(it->first));
+
+            const CDPL::ConfGen::FragmentLibraryEntry::SharedPointer& entry = lib.getEntry(it->first);
+
+            BOOST_CHECK(entry && isEqual(*entry, *it->second));
+            BOOST_CHECK(lib.getEntry(it->first) == entry);
+            BOOST_CHECK(lib.getNumEntries() == ref_lib.getNumEntries());
+        }
+
+        std::size_t num_entries = 0;
+
+        for (CDPL::ConfGen::FragmentLibrary::ConstEntryIterator it = lib.getEntriesBegin(), end = lib.getEntriesEnd(); it != end; ++it, num_entries++)
+            BOOST_CHECK(ref_lib.containsEntry(it->first) && isEqual(*it->second, *ref_lib.getEntry(it->first)));
+
+        BOOST_CHECK(num_entries == ref_lib.getNumEntries());
+    }
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(FragmentLibraryIndexedFileTest)
+{
+    using namespace CDPL;
+    using namespace ConfGen;
+
+    FragmentLibrary src_lib;
+
+    for (std::size_t i = 0; i < NUM_TEST_ENTRIES; i++)
+        BOOST_CHECK(src_lib.addEntry(createEntry(i)));
+
+    BOOST_CHECK(!src_lib.addEntry(createEntry(0)));
+    BOOST_CHECK(src_lib.getNumEntries() == NUM_TEST_ENTRIES);
+
+    Util::FileRemover plain_file(Util::genCheckedTempFilePath());
+    Util::FileRemover idx_file(Util::genCheckedTempFilePath());
+
+    {
+        std::ofstream os(plain_file.getPath().c_str(), std::ios_base::out | std::ios_base::binary);
+
+        src_lib.save(os);
+    }
+
+    {
+        std::ofstream os(idx_file.getPath().c_str(), std::ios_base::out | std::ios_base::binary);
+
+        src_lib.saveIndexed(os);
+    }
+
+    // entries decoded on demand must equal the entries read by load() (coordinates are stored with reduced precision)
+
+    FragmentLibrary ref_lib;
+
+    {
+        std::ifstream is(plain_file.getPath().c_str(), std::ios_base::in | std::ios_base::binary);
+
+        ref_lib.load(is);
+    }
+
+    BOOST_CHECK(ref_lib.getNumEntries() == NUM_TEST_ENTRIES);
+
+    // mapped files with and without stored index
+
+    FragmentLibrary lib;
+
+    lib.mapFile(idx_file.getPath());
+
+    checkLibrary(lib, ref_lib);
+
+    lib.mapFile(plain_file.getPath());
+
+    checkLibrary(lib, ref_lib);
+
+    // copies share the index of the mapped file
+
+    lib.mapFile(idx_file.getPath());
+
+    FragmentLibrary lib_copy(lib);
+
+    checkLibrary(lib_copy, ref_lib);
+
+    // modifications of a mapped library
+
+    lib.mapFile(idx_file.getPath());
+
+    BOOST_CHECK(!lib.addEntry(createEntry(1)));
+    BOOST_CHECK(lib.addEntry(createEntry(NUM_TEST_ENTRIES)));
+    BOOST_CHECK(lib.getNumEntries() == NUM_TEST_ENTRIES + 1);
+    BOOST_CHECK(lib.removeEntry(createEntry(2)->getHashCode()));
+    BOOST_CHECK(lib.getNumEntries() == NUM_TEST_ENTRIES);
+    BOOST_CHECK(!lib.containsEntry(createEntry(2)->getHashCode()));
+
+    lib.clear();
+
+    BOOST_CHECK(lib.getNumEntries() == 0);
+
+    // load() must skip the stored index record
+
+    {
+        std::ifstream is(idx_file.getPath().c_str(), std::ios_base::in | std::ios_base::binary);
+
+        lib.load(is);
+    }
+
+    checkLibrary(lib, ref_lib);
+
+    // invalid and empty files
+
+    {
+        std::ofstream os(plain_file.getPath().c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+    }
+
+    lib.mapFile(plain_file.getPath());
+
+    BOOST_CHECK(lib.getNumEntries() == 0);
+
+    {
+        std::ofstream(plain_file.getPath().c_str(), std::ios_base::out | std::ios_base::binary | std::ios_base::trunc) << "no fragment library data";
+    }
+
+    BOOST_CHECK_THROW(lib.mapFile(plain_file.getPath()), Base::IOError);
+    BOOST_CHECK_THROW(lib.mapFile(plain_file.getPath() + ".missing"), Base::IOError);
+}
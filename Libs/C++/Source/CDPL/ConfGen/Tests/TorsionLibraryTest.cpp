@@ -0,0 +1,141 @@
+/* 
+ * TorsionLibraryTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstddef>
+#include <algorithm>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/ConfGen/TorsionLibrary.hpp"
+
+
+namespace
+{
+
+    void checkMatchPattern(const CDPL::Chem::MolecularGraph::SharedPointer& ptn, const CDPL::Chem::MolecularGraph::SharedPointer& ref_ptn)
+    {
+        BOOST_CHECK(ptn);
+        BOOST_CHECK(ref_ptn);
+
+        if (!ptn || !ref_ptn)
+            return;
+
+        BOOST_CHECK(ptn->getNumAtoms() == ref_ptn->getNumAtoms());
+        BOOST_CHECK(ptn->getNumBonds() == ref_ptn->getNumBonds());
+    }
+
+    void checkCategory(const CDPL::ConfGen::TorsionCategory& cat, const CDPL::ConfGen::TorsionCategory& ref_cat)
+    {
+        using namespace CDPL;
+
+        BOOST_CHECK(cat.getName() == ref_cat.getName());
+        BOOST_CHECK(cat.getMatchPatternString() == ref_cat.getMatchPatternString());
+        BOOST_CHECK(cat.getBondAtom1Type() == ref_cat.getBondAtom1Type());
+        BOOST_CHECK(cat.getBondAtom2Type() == ref_cat.getBondAtom2Type());
+
+        if (!ref_cat.getMatchPatternString().empty())
+            checkMatchPattern(cat.getMatchPattern(), ref_cat.getMatchPattern());
+
+        BOOST_CHECK(cat.getNumRules() == ref_cat.getNumRules());
+
+        for (std::size_t i = 0, num_rules = std::min(cat.getNumRules(), ref_cat.getNumRules()); i < num_rules; i++) {
+            const ConfGen::TorsionRule& rule = cat.getRule(i);
+            const ConfGen::TorsionRule& ref_rule = ref_cat.getRule(i);
+
+            BOOST_CHECK(rule.getMatchPatternString() == ref_rule.getMatchPatternString());
+            BOOST_CHECK(rule.getNumAngles() == ref_rule.getNumAngles());
+
+            checkMatchPattern(rule.getMatchPattern(), ref_rule.getMatchPattern());
+        }
+
+        BOOST_CHECK(cat.getNumCategories() == ref_cat.getNumCategories());
+
+        for (std::size_t i = 0, num_cats = std::min(cat.getNumCategories(), ref_cat.getNumCategories()); i < num_cats; i++)
+            checkCategory(cat.getCategory(i), ref_cat.getCategory(i));
+    }
+
+    void getMatchPatterns(const CDPL::ConfGen::TorsionCategory& cat, std::vector<const CDPL::Chem::MolecularGraph*>& ptns)
+    {
+        ptns.push_back(cat.getMatchPattern().get());
+
+        for (std::size_t i = 0; i < cat.getNumRules(); i++)
+            ptns.push_back(cat.getRule(i).getMatchPattern().get());
+
+        for (std::size_t i = 0; i < cat.getNumCategories(); i++)
+            getMatchPatterns(cat.getCategory(i), ptns);
+    }
+} // namespace
+
+
+BOOST_AUTO_TEST_CASE(TorsionLibraryLazyPatternParsingTest)
+{
+    using namespace CDPL;
+    using namespace ConfGen;
+
+    // the match patterns of the built-in library get parsed on demand, patterns of explicitly loaded libraries immediately
+
+    TorsionLibrary lazy_lib;
+
+    lazy_lib.loadDefaults();
+
+    BOOST_CHECK(lazy_lib.getNumRules(true) > 0);
+
+    std::stringstream ss;
+
+    lazy_lib.save(ss);
+
+    TorsionLibrary ref_lib;
+
+    ref_lib.load(ss);
+
+    TorsionLibrary lib_copy(lazy_lib);
+
+    checkCategory(lib_copy, ref_lib);
+    checkCategory(lazy_lib, ref_lib);
+
+    // concurrent first accesses must all yield the same pattern instances
+
+    const std::size_t NUM_THREADS = 4;
+
+    TorsionLibrary shared_lib;
+
+    shared_lib.loadDefaults();
+
+    std::vector<std::vector<const Chem::MolecularGraph*> > thread_ptns(NUM_THREADS);
+    std::vector<std::thread> threads;
+
+    for (std::size_t i = 0; i < NUM_THREADS; i++)
+        threads.emplace_back([&shared_lib, &thread_ptns, i]() { getMatchPatterns(shared_lib, thread_ptns[i]); });
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    for (std::size_t i = 1; i < NUM_THREADS; i++)
+        BOOST_CHECK(thread_ptns[i] == thread_ptns[0]);
+
+    checkCategory(shared_lib, ref_lib);
+}
@@ -25,19 +25,53 @@
 #include "StaticInit.hpp"
 
 #include <algorithm>
+#include <mutex>
 
 #include "CDPL/ConfGen/TorsionCategory.hpp"
 #include "CDPL/Chem/AtomType.hpp"
 #include "CDPL/Base/Exceptions.hpp"
 
+#include "TorsionLibraryDataReader.hpp"
+
 
 using namespace CDPL;
 
 
+namespace
+{
+
+    std::mutex ptnParsingMutex;
+}
+
+
 ConfGen::TorsionCategory::TorsionCategory():
-    bondAtom1Type(Chem::AtomType::UNKNOWN), bondAtom2Type(Chem::AtomType::UNKNOWN)
+    matchPatternPending(false), bondAtom1Type(Chem::AtomType::UNKNOWN), bondAtom2Type(Chem::AtomType::UNKNOWN)
 {}
 
+ConfGen::TorsionCategory::TorsionCategory(const TorsionCategory& cat):
+    name(cat.name), matchPatternStr(cat.matchPatternStr), matchPatternPending(false),
+    bondAtom1Type(cat.bondAtom1Type), bondAtom2Type(cat.bondAtom2Type), rules(cat.rules), categories(cat.categories)
+{
+    copyMatchPattern(cat);
+}
+
+ConfGen::TorsionCategory& ConfGen::TorsionCategory::operator=(const TorsionCategory& cat)
+{
+    if (this == &cat)
+        return *this;
+
+    name = cat.name;
+    matchPatternStr = cat.matchPatternStr;
+    bondAtom1Type = cat.bondAtom1Type;
+    bondAtom2Type = cat.bondAtom2Type;
+    rules = cat.rules;
+    categories = cat.categories;
+
+    copyMatchPattern(cat);
+
+    return *this;
+}
+
 const std::string& ConfGen::TorsionCategory::getName() const
 {
     return name;
@@ -60,12 +94,24 @@ void ConfGen::TorsionCategory::setMatchPatternString(const std::string& ptn_str)
 
 const Chem::MolecularGraph::SharedPointer& ConfGen::TorsionCategory::getMatchPattern() const
 {
+    if (matchPatternPending.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(ptnParsingMutex);
+
+        if (matchPatternPending.load(std::memory_order_relaxed)) {
+            matchPattern = TorsionLibraryDataReader::parseSMARTS(matchPatternStr);
+
+            matchPatternPending.store(false, std::memory_order_release);
+        }
+    }
+
     return matchPattern;
 }
 
 void ConfGen::TorsionCategory::setMatchPattern(const Chem::MolecularGraph::SharedPointer& ptn)
 {
     matchPattern = ptn;
+
+    matchPatternPending.store(false, std::memory_order_relaxed);
 }
             
 unsigned int ConfGen::TorsionCategory::getBondAtom1Type() const
@@ -242,7 +288,13 @@ void ConfGen::TorsionCategory::swap(TorsionCategory& cat)
 {
     std::swap(bondAtom1Type, cat.bondAtom1Type);
     std::swap(bondAtom2Type, cat.bondAtom2Type);
-    
+
+    bool ptn_pending = matchPatternPending.load(std::memory_order_relaxed);
+
+    matchPatternPending.store(cat.matchPatternPending.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    cat.matchPatternPending.store(ptn_pending, std::memory_order_relaxed);
+
+    matchPatternStr.swap(cat.matchPatternStr);
     matchPattern.swap(cat.matchPattern);
     name.swap(cat.name);
     categories.swap(cat.categories);
@@ -256,10 +308,28 @@ void ConfGen::TorsionCategory::clear()
     categories.clear();
     matchPattern.reset();
 
+    matchPatternPending.store(false, std::memory_order_relaxed);
+
     bondAtom1Type = Chem::AtomType::UNKNOWN;
     bondAtom2Type = Chem::AtomType::UNKNOWN;
 }
 
+void ConfGen::TorsionCategory::setMatchPatternPending()
+{
+    matchPattern.reset();
+
+    matchPatternPending.store(true, std::memory_order_relaxed);
+}
+
+void ConfGen::TorsionCategory::copyMatchPattern(const TorsionCategory& cat)
+{
+    std::lock_guard<std::mutex> lock(ptnParsingMutex);
+
+    matchPattern = cat.matchPattern;
+
+    matchPatternPending.store(cat.matchPatternPending.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
 void ConfGen::TorsionCategory::checkCategoryIndex(std::size_t idx, bool it) const
 {
     if (idx >= categories.size())
@@ -179,6 +179,7 @@ void ConfGen::TorsionDriverImpl::setup(const Chem::MolecularGraph& molgraph, con
 
 void ConfGen::TorsionDriverImpl::setMMFF94Parameters(const ForceField::MMFF94InteractionData& ia_data, ForceFieldInteractionMask& ia_mask)
 {
+    fragTree.usePackedMMFF94EnergyCalculator(settings.packedForceFieldEvaluation());
     fragTree.getRoot()->distMMFF94Parameters(ia_data, ia_mask);
 }
 
@@ -186,6 +187,7 @@ void ConfGen::TorsionDriverImpl::setMMFF94Parameters(const ForceField::MMFF94Int
 {
     mmff94InteractionMask.setup(ia_data);
 
+    fragTree.usePackedMMFF94EnergyCalculator(settings.packedForceFieldEvaluation());
     fragTree.getRoot()->distMMFF94Parameters(ia_data, mmff94InteractionMask);
 }
 
@@ -310,6 +312,16 @@ const ConfGen::CallbackFunction& ConfGen::TorsionDriverImpl::getTimeoutCallback(
     return fragTree.getTimeoutCallback();
 }
 
+void ConfGen::TorsionDriverImpl::setTaskScheduler(TaskScheduler* scheduler)
+{
+    fragTree.setTaskScheduler(scheduler);
+}
+
+ConfGen::TaskScheduler* ConfGen::TorsionDriverImpl::getTaskScheduler() const
+{
+    return fragTree.getTaskScheduler();
+}
+
 void ConfGen::TorsionDriverImpl::setLogMessageCallback(const LogMessageCallbackFunction& func)
 {
     logCallback = func;
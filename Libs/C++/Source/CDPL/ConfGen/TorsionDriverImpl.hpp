@@ -114,6 +114,10 @@ namespace CDPL
 
             const CallbackFunction& getTimeoutCallback() const;
 
+            void setTaskScheduler(TaskScheduler* scheduler);
+
+            TaskScheduler* getTaskScheduler() const;
+
             void setLogMessageCallback(const LogMessageCallbackFunction& func);
 
             const LogMessageCallbackFunction& getLogMessageCallback() const;
@@ -34,7 +34,7 @@ using namespace CDPL;
 
 ConfGen::TorsionDriverSettings::TorsionDriverSettings(): 
     sampleHetAtomHs(false), sampleTolRanges(false), energyOrdered(true), eWindow(0.0), maxPoolSize(10000),
-    forceFieldType(ForceFieldType::MMFF94S_NO_ESTAT), strictParam(true),
+    forceFieldType(ForceFieldType::MMFF94S_NO_ESTAT), strictParam(true), packedFFEval(false),
     dielectricConst(ForceField::MMFF94ElectrostaticInteractionParameterizer::DIELECTRIC_CONSTANT_WATER),
     distExponent(ForceField::MMFF94ElectrostaticInteractionParameterizer::DEF_DISTANCE_EXPONENT)
 {}
@@ -109,6 +109,16 @@ bool ConfGen::TorsionDriverSettings::strictForceFieldParameterization() const
     return strictParam;
 }
 
+void ConfGen::TorsionDriverSettings::packedForceFieldEvaluation(bool packed)
+{
+    packedFFEval = packed;
+}
+
+bool ConfGen::TorsionDriverSettings::packedForceFieldEvaluation() const
+{
+    return packedFFEval;
+}
+
 void ConfGen::TorsionDriverSettings::setDielectricConstant(double de_const)
 {
     dielectricConst = de_const;
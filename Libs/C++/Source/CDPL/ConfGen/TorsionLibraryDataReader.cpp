@@ -116,7 +116,11 @@ void ConfGen::TorsionLibraryDataReader::processCategory(const XMLNode* cat_node,
 
     if (attr)  {
         cat.setMatchPatternString(attr->value());
-        cat.setMatchPattern(parseSMARTS(attr->value()));
+
+        if (lazyPtnParsing)
+            cat.setMatchPatternPending();
+        else
+            cat.setMatchPattern(parseSMARTS(cat.getMatchPatternString()));
     }
 
     for (const XMLNode* node = cat_node->first_node(); node; node = node->next_sibling()) {
@@ -138,13 +142,17 @@ void ConfGen::TorsionLibraryDataReader::processRule(const XMLNode* rule_node, To
     const XMLAttribute* attr = rule_node->first_attribute(Attribute::RULE_PATTERN.c_str());
 
     if (attr) {
-        rule.setMatchPattern(parseSMARTS(attr->value()));
         rule.setMatchPatternString(attr->value());
 
+        if (lazyPtnParsing)
+            rule.setMatchPatternPending();
+        else
+            rule.setMatchPattern(parseSMARTS(rule.getMatchPatternString()));
+
     } else
         throw Base::IOError("TorsionLibraryDataReader: missing rule '" + Attribute::RULE_PATTERN + "' attribute");
 
-    if (!rule.getMatchPattern())
+    if (lazyPtnParsing ? rule.getMatchPatternString().empty() : !rule.getMatchPattern())
         throw Base::IOError("TorsionLibraryDataReader: empty or invalid rule '" + Attribute::RULE_PATTERN + "' attribute");
 
     for (const XMLNode* node = rule_node->first_node(); node; node = node->next_sibling()) {
@@ -197,11 +205,11 @@ void ConfGen::TorsionLibraryDataReader::processAngleList(const XMLNode* ang_list
     }
 }
 
-Chem::MolecularGraph::SharedPointer ConfGen::TorsionLibraryDataReader::parseSMARTS(const char* str) const
+Chem::MolecularGraph::SharedPointer ConfGen::TorsionLibraryDataReader::parseSMARTS(const std::string& str)
 {
     using namespace Chem;
 
-    boost::iostreams::stream<boost::iostreams::array_source> is(str, std::strlen(str));
+    boost::iostreams::stream<boost::iostreams::array_source> is(str.c_str(), str.size());
     
     BasicMolecule::SharedPointer mol_ptr(new BasicMolecule());
     SMARTSMoleculeReader reader(is);
@@ -47,9 +47,14 @@ namespace CDPL
         {
 
           public:
+            TorsionLibraryDataReader(bool lazy_ptn_parsing = false):
+                lazyPtnParsing(lazy_ptn_parsing) {}
+
             void read(std::istream& is, TorsionLibrary& lib);
             void read(const char* data, TorsionLibrary& lib);
 
+            static Chem::MolecularGraph::SharedPointer parseSMARTS(const std::string& str);
+
           private:
             typedef rapidxml::xml_document<char>  XMLDocument;
             typedef rapidxml::xml_node<char>      XMLNode;
@@ -61,8 +66,7 @@ namespace CDPL
             void processRule(const XMLNode* rule_node, TorsionRule& rule) const;
             void processAngleList(const XMLNode* ang_list_node, TorsionRule& rule) const;
 
-            Chem::MolecularGraph::SharedPointer parseSMARTS(const char* str) const;
-
+            bool        lazyPtnParsing;
             CharBuffer  charBuffer;
             XMLDocument torLibDocument;
         };
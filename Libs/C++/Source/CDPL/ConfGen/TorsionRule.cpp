@@ -24,13 +24,48 @@
 
 #include "StaticInit.hpp"
 
+#include <mutex>
+
 #include "CDPL/ConfGen/TorsionRule.hpp"
 #include "CDPL/Base/Exceptions.hpp"
 
+#include "TorsionLibraryDataReader.hpp"
+
 
 using namespace CDPL;
 
 
+namespace
+{
+
+    std::mutex ptnParsingMutex;
+}
+
+
+ConfGen::TorsionRule::TorsionRule():
+    matchPatternPending(false)
+{}
+
+ConfGen::TorsionRule::TorsionRule(const TorsionRule& rule):
+    matchPatternStr(rule.matchPatternStr), matchPatternPending(false), angles(rule.angles)
+{
+    copyMatchPattern(rule);
+}
+
+ConfGen::TorsionRule& ConfGen::TorsionRule::operator=(const TorsionRule& rule)
+{
+    if (this == &rule)
+        return *this;
+
+    matchPatternStr = rule.matchPatternStr;
+    angles = rule.angles;
+
+    copyMatchPattern(rule);
+
+    return *this;
+}
+
+
 const std::string& ConfGen::TorsionRule::getMatchPatternString() const
 {
     return matchPatternStr;
@@ -43,12 +78,24 @@ void ConfGen::TorsionRule::setMatchPatternString(const std::string& ptn_str)
 
 const Chem::MolecularGraph::SharedPointer& ConfGen::TorsionRule::getMatchPattern() const
 {
+    if (matchPatternPending.load(std::memory_order_acquire)) {
+        std::lock_guard<std::mutex> lock(ptnParsingMutex);
+
+        if (matchPatternPending.load(std::memory_order_relaxed)) {
+            matchPattern = TorsionLibraryDataReader::parseSMARTS(matchPatternStr);
+
+            matchPatternPending.store(false, std::memory_order_release);
+        }
+    }
+
     return matchPattern;
 }
 
 void ConfGen::TorsionRule::setMatchPattern(const Chem::MolecularGraph::SharedPointer& ptn)
 {
     matchPattern = ptn;
+
+    matchPatternPending.store(false, std::memory_order_relaxed);
 }
 
 void ConfGen::TorsionRule::addAngle(const AngleEntry& angle)
@@ -127,16 +174,40 @@ ConfGen::TorsionRule::ConstAngleEntryIterator ConfGen::TorsionRule::end() const
     return angles.end();
 }
 
-void ConfGen::TorsionRule::swap(TorsionRule& cat)
+void ConfGen::TorsionRule::swap(TorsionRule& rule)
 {
-    matchPattern.swap(cat.matchPattern);
-    angles.swap(cat.angles);
+    bool ptn_pending = matchPatternPending.load(std::memory_order_relaxed);
+
+    matchPatternPending.store(rule.matchPatternPending.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    rule.matchPatternPending.store(ptn_pending, std::memory_order_relaxed);
+
+    matchPatternStr.swap(rule.matchPatternStr);
+    matchPattern.swap(rule.matchPattern);
+    angles.swap(rule.angles);
 }
 
 void ConfGen::TorsionRule::clear()
 {
     angles.clear();
     matchPattern.reset();
+
+    matchPatternPending.store(false, std::memory_order_relaxed);
+}
+
+void ConfGen::TorsionRule::setMatchPatternPending()
+{
+    matchPattern.reset();
+
+    matchPatternPending.store(true, std::memory_order_relaxed);
+}
+
+void ConfGen::TorsionRule::copyMatchPattern(const TorsionRule& rule)
+{
+    std::lock_guard<std::mutex> lock(ptnParsingMutex);
+
+    matchPattern = rule.matchPattern;
+
+    matchPatternPending.store(rule.matchPatternPending.load(std::memory_order_relaxed), std::memory_order_relaxed);
 }
 
 void ConfGen::TorsionRule::checkAngleIndex(std::size_t idx, bool it) const
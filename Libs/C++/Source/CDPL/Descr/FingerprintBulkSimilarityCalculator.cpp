@@ -0,0 +1,345 @@
+/* 
+ * FingerprintBulkSimilarityCalculator.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "CDPL/Descr/FingerprintBulkSimilarityCalculator.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+#include "CDPL/Internal/PopCount.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+    constexpr std::size_t BLOCK_SIZE = 1024;
+
+    inline std::size_t getNumWords(std::size_t num_bits)
+    {
+        return ((num_bits + 63) / 64);
+    }
+
+    void packBits(const Util::BitSet& bs, std::uint64_t* words)
+    {
+        for (Util::BitSet::size_type i = bs.find_first(); i != Util::BitSet::npos; i = bs.find_next(i))
+            words[i / 64] |= (std::uint64_t(1) << (i % 64));
+    }
+
+    bool isMoreSimilar(const Descr::FingerprintBulkSimilarityCalculator::Result& r1,
+                       const Descr::FingerprintBulkSimilarityCalculator::Result& r2)
+    {
+        if (r1.second > r2.second)
+            return true;
+
+        if (r1.second < r2.second)
+            return false;
+
+        return (r1.first < r2.first);
+    }
+}
+
+
+Descr::FingerprintBulkSimilarityCalculator::FingerprintBulkSimilarityCalculator(SimilarityMeasure measure):
+    measure(measure), tverskyAlpha(0.95), tverskyBeta(0.05), numBits(0), numWords(0), queryBitCount(0), querySize(0)
+{}
+
+void Descr::FingerprintBulkSimilarityCalculator::setSimilarityMeasure(SimilarityMeasure measure)
+{
+    this->measure = measure;
+}
+
+Descr::FingerprintBulkSimilarityCalculator::SimilarityMeasure Descr::FingerprintBulkSimilarityCalculator::getSimilarityMeasure() const
+{
+    return measure;
+}
+
+void Descr::FingerprintBulkSimilarityCalculator::setTverskyWeights(double alpha, double beta)
+{
+    tverskyAlpha = alpha;
+    tverskyBeta  = beta;
+}
+
+double Descr::FingerprintBulkSimilarityCalculator::getTverskyAlpha() const
+{
+    return tverskyAlpha;
+}
+
+double Descr::FingerprintBulkSimilarityCalculator::getTverskyBeta() const
+{
+    return tverskyBeta;
+}
+
+void Descr::FingerprintBulkSimilarityCalculator::clear()
+{
+    numBits  = 0;
+    numWords = 0;
+
+    fpWords.clear();
+    fpBitCounts.clear();
+    fpSizes.clear();
+    results.clear();
+}
+
+std::size_t Descr::FingerprintBulkSimilarityCalculator::getNumFingerprints() const
+{
+    return fpSizes.size();
+}
+
+std::size_t Descr::FingerprintBulkSimilarityCalculator::getNumBits() const
+{
+    return numBits;
+}
+
+void Descr::FingerprintBulkSimilarityCalculator::addFingerprint(const Util::BitSet& fp)
+{
+    std::size_t num_fps = fpSizes.size();
+
+    if (fp.size() > numBits) {
+        std::size_t new_num_words = getNumWords(fp.size());
+
+        if (new_num_words > numWords) {
+            WordArray new_words(num_fps * new_num_words);
+
+            for (std::size_t i = 0; i < num_fps; i++)
+                std::copy(fpWords.begin() + i * numWords, fpWords.begin() + (i + 1) * numWords, new_words.begin() + i * new_num_words);
+
+            fpWords.swap(new_words);
+            numWords = new_num_words;
+        }
+
+        numBits = fp.size();
+    }
+
+    fpWords.resize((num_fps + 1) * numWords);
+
+    packBits(fp, fpWords.data() + num_fps * numWords);
+
+    fpBitCounts.push_back(fp.count());
+    fpSizes.push_back(fp.size());
+}
+
+void Descr::FingerprintBulkSimilarityCalculator::getFingerprint(std::size_t idx, Util::BitSet& fp) const
+{
+    if (idx >= fpSizes.size())
+        throw Base::IndexError("FingerprintBulkSimilarityCalculator: fingerprint index out of bounds");
+
+    fp.clear();
+    fp.resize(fpSizes[idx]);
+
+    const std::uint64_t* words = fpWords.data() + idx * numWords;
+
+    for (std::size_t i = 0, num_bits = fpSizes[idx]; i < num_bits; i++)
+        if (words[i / 64] & (std::uint64_t(1) << (i % 64)))
+            fp.set(i);
+}
+
+void Descr::FingerprintBulkSimilarityCalculator::removeFingerprint(std::size_t idx)
+{
+    if (idx >= fpSizes.size())
+        throw Base::IndexError("FingerprintBulkSimilarityCalculator: fingerprint index out of bounds");
+
+    fpWords.erase(fpWords.begin() + idx * numWords, fpWords.begin() + (idx + 1) * numWords);
+    fpBitCounts.erase(fpBitCounts.begin() + idx);
+    fpSizes.erase(fpSizes.begin() + idx);
+}
+
+void Descr::FingerprintBulkSimilarityCalculator::calculate(const Util::BitSet& fp, bool sort, bool sort_desc)
+{
+    packQuery(fp);
+
+    results.clear();
+    results.reserve(fpSizes.size());
+
+    calcSimilarities([this](std::size_t idx, double sim) {
+                         results.emplace_back(idx, sim);
+                     });
+
+    if (!sort)
+        return;
+
+    if (sort_desc)
+        std::sort(results.begin(), results.end(),
+                  [](const Result& r1, const Result& r2) {
+                      return (r1.second > r2.second);
+                  });
+    else
+        std::sort(results.begin(), results.end(),
+                  [](const Result& r1, const Result& r2) {
+                      return (r1.second < r2.second);
+                  });
+}
+
+void Descr::FingerprintBulkSimilarityCalculator::calculateTopN(const Util::BitSet& fp, std::size_t num_results)
+{
+    packQuery(fp);
+
+    results.clear();
+
+    if (num_results == 0)
+        return;
+
+    // min-heap (w.r.t. isMoreSimilar) of the best results found so far: the front is the least similar one
+
+    calcSimilarities([this, num_results](std::size_t idx, double sim) {
+                         if (std::isnan(sim))
+                             return;
+
+                         Result res(idx, sim);
+
+                         if (results.size() < num_results) {
+                             results.push_back(res);
+                             std::push_heap(results.begin(), results.end(), &isMoreSimilar);
+                             return;
+                         }
+
+                         if (!isMoreSimilar(res, results.front()))
+                             return;
+
+                         std::pop_heap(results.begin(), results.end(), &isMoreSimilar);
+                         results.back() = res;
+                         std::push_heap(results.begin(), results.end(), &isMoreSimilar);
+                     });
+
+    std::sort_heap(results.begin(), results.end(), &isMoreSimilar);
+}
+
+void Descr::FingerprintBulkSimilarityCalculator::calculateAboveThreshold(const Util::BitSet& fp, double threshold)
+{
+    packQuery(fp);
+
+    results.clear();
+
+    calcSimilarities([this, threshold](std::size_t idx, double sim) {
+                         if (sim >= threshold)
+                             results.emplace_back(idx, sim);
+                     });
+}
+
+std::size_t Descr::FingerprintBulkSimilarityCalculator::getNumResults() const
+{
+    return results.size();
+}
+
+Descr::FingerprintBulkSimilarityCalculator::ConstResultIterator Descr::FingerprintBulkSimilarityCalculator::getResultsBegin() const
+{
+    return results.begin();
+}
+
+Descr::FingerprintBulkSimilarityCalculator::ConstResultIterator Descr::FingerprintBulkSimilarityCalculator::getResultsEnd() const
+{
+    return results.end();
+}
+
+Descr::FingerprintBulkSimilarityCalculator::ConstResultIterator Descr::FingerprintBulkSimilarityCalculator::begin() const
+{
+    return results.begin();
+}
+
+Descr::FingerprintBulkSimilarityCalculator::ConstResultIterator Descr::FingerprintBulkSimilarityCalculator::end() const
+{
+    return results.end();
+}
+
+const Descr::FingerprintBulkSimilarityCalculator::Result& Descr::FingerprintBulkSimilarityCalculator::getResult(std::size_t idx) const
+{
+    if (idx >= results.size())
+        throw Base::IndexError("FingerprintBulkSimilarityCalculator: result index out of bounds");
+
+    return results[idx];
+}
+
+double Descr::FingerprintBulkSimilarityCalculator::getSimilarity(std::size_t idx) const
+{
+    if (idx >= results.size())
+        throw Base::IndexError("FingerprintBulkSimilarityCalculator: result index out of bounds");
+
+    return results[idx].second;
+}
+
+std::size_t Descr::FingerprintBulkSimilarityCalculator::getFingerprintIndex(std::size_t idx) const
+{
+    if (idx >= results.size())
+        throw Base::IndexError("FingerprintBulkSimilarityCalculator: result index out of bounds");
+
+    return results[idx].first;
+}
+
+void Descr::FingerprintBulkSimilarityCalculator::packQuery(const Util::BitSet& fp)
+{
+    queryWords.assign(std::max(numWords, getNumWords(fp.size())), 0);
+
+    packBits(fp, queryWords.data());
+
+    queryBitCount = fp.count();
+    querySize     = fp.size();
+}
+
+template <typename Func>
+void Descr::FingerprintBulkSimilarityCalculator::calcSimilarities(Func func)
+{
+    std::size_t num_fps = fpSizes.size();
+
+    commonBitCounts.resize(std::min(num_fps, BLOCK_SIZE));
+
+    for (std::size_t start = 0; start < num_fps; start += BLOCK_SIZE) {
+        std::size_t num_rows = std::min(BLOCK_SIZE, num_fps - start);
+
+        Internal::popCountAnd(queryWords.data(), fpWords.data() + start * numWords, numWords, num_rows, commonBitCounts.data());
+
+        for (std::size_t i = 0; i < num_rows; i++) {
+            std::size_t idx = start + i;
+            std::size_t bab = commonBitCounts[i];
+            std::size_t a   = queryBitCount;
+            std::size_t b   = fpBitCounts[idx];
+
+            switch (measure) {
+
+                case TVERSKY:
+                    func(idx, double(bab) / (tverskyAlpha * (a - bab) + tverskyBeta * (b - bab) + bab));
+                    continue;
+
+                case COSINE:
+                    func(idx, double(bab) / std::sqrt(double(a * b)));
+                    continue;
+
+                case EUCLIDEAN: {
+                    std::size_t size = std::max(querySize, fpSizes[idx]);
+                    std::size_t nab  = size - (a + b - bab);
+
+                    func(idx, std::sqrt(double(bab + nab) / double(size)));
+                    continue;
+                }
+
+                default:
+                    func(idx, double(bab) / (a + b - bab));
+            }
+        }
+    }
+}
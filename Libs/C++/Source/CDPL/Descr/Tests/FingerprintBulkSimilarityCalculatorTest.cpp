@@ -0,0 +1,209 @@
+/* 
+ * FingerprintBulkSimilarityCalculatorTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cmath>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/Descr/FingerprintBulkSimilarityCalculator.hpp"
+#include "CDPL/Descr/SimilarityFunctions.hpp"
+#include "CDPL/Util/BitSet.hpp"
+
+
+namespace
+{
+
+    bool isSameValue(double v1, double v2)
+    {
+        if (std::isnan(v1))
+            return std::isnan(v2);
+
+        return (v1 == v2);
+    }
+
+    double calcSimilarity(const CDPL::Util::BitSet& bs1, const CDPL::Util::BitSet& bs2,
+                          CDPL::Descr::FingerprintBulkSimilarityCalculator::SimilarityMeasure measure)
+    {
+        using namespace CDPL;
+        using namespace Descr;
+
+        switch (measure) {
+
+            case FingerprintBulkSimilarityCalculator::TVERSKY:
+                return calcTverskySimilarity(bs1, bs2, 0.95, 0.05);
+
+            case FingerprintBulkSimilarityCalculator::COSINE:
+                return calcCosineSimilarity(bs1, bs2);
+
+            case FingerprintBulkSimilarityCalculator::EUCLIDEAN:
+                return calcEuclideanSimilarity(bs1, bs2);
+
+            default:
+                return calcTanimotoSimilarity(bs1, bs2);
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(FingerprintBulkSimilarityCalculatorTest)
+{
+    using namespace CDPL;
+    using namespace Descr;
+    using namespace Util;
+
+    typedef FingerprintBulkSimilarityCalculator Calculator;
+
+    std::mt19937 rand_eng(42);
+    std::vector<BitSet> fps;
+    const std::size_t fp_sizes[] = { 1024, 1024, 1024, 166, 2048, 0, 1024, 70 };
+
+    for (std::size_t i = 0; i < 2500; i++) {
+        BitSet fp(fp_sizes[i % (sizeof(fp_sizes) / sizeof(std::size_t))]);
+        double density = (i % 7) * 0.05;
+
+        for (std::size_t j = 0; j < fp.size(); j++)
+            if (std::uniform_real_distribution<double>(0.0, 1.0)(rand_eng) < density)
+                fp.set(j);
+
+        fps.push_back(fp);
+    }
+
+    Calculator calc;
+
+    BOOST_CHECK(calc.getSimilarityMeasure() == Calculator::TANIMOTO);
+    BOOST_CHECK_EQUAL(calc.getTverskyAlpha(), 0.95);
+    BOOST_CHECK_EQUAL(calc.getTverskyBeta(), 0.05);
+    BOOST_CHECK_EQUAL(calc.getNumFingerprints(), 0);
+    BOOST_CHECK_EQUAL(calc.getNumBits(), 0);
+
+    calc.calculate(fps[0]);
+
+    BOOST_CHECK_EQUAL(calc.getNumResults(), 0);
+
+    for (std::size_t i = 0; i < 1000; i++)
+        calc.addFingerprint(fps[i]);
+
+    BOOST_CHECK_EQUAL(calc.getNumBits(), 2048);
+
+    for (std::size_t i = 1000; i < fps.size(); i++)
+        calc.addFingerprint(fps[i]);
+
+    BOOST_CHECK_EQUAL(calc.getNumFingerprints(), fps.size());
+
+    BitSet fp;
+
+    for (std::size_t i = 0; i < fps.size(); i++) {
+        calc.getFingerprint(i, fp);
+
+        BOOST_CHECK(fp == fps[i]);
+    }
+
+    BOOST_CHECK_THROW(calc.getFingerprint(fps.size(), fp), Base::IndexError);
+    BOOST_CHECK_THROW(calc.getResult(fps.size()), Base::IndexError);
+
+    const Calculator::SimilarityMeasure measures[] = { Calculator::TANIMOTO, Calculator::TVERSKY, Calculator::COSINE, Calculator::EUCLIDEAN };
+    const std::size_t query_indices[] = { 1, 3, 4, 5, 7, 13 };
+
+    for (auto measure : measures) {
+        calc.setSimilarityMeasure(measure);
+
+        for (auto query_idx : query_indices) {
+            const BitSet& query = fps[query_idx];
+
+            calc.calculate(query);
+
+            BOOST_CHECK_EQUAL(calc.getNumResults(), fps.size());
+
+            std::size_t num_mismatches = 0;
+
+            for (std::size_t i = 0; i < fps.size(); i++)
+                if (calc.getFingerprintIndex(i) != i || !isSameValue(calc.getSimilarity(i), calcSimilarity(query, fps[i], measure)))
+                    num_mismatches++;
+
+            BOOST_CHECK_MESSAGE(num_mismatches == 0, "measure " << measure << ", query " << query_idx << ": " << num_mismatches << " mismatches");
+
+            std::vector<Calculator::Result> ref_results;
+
+            for (std::size_t i = 0; i < fps.size(); i++) {
+                double sim = calcSimilarity(query, fps[i], measure);
+
+                if (!std::isnan(sim))
+                    ref_results.emplace_back(i, sim);
+            }
+
+            std::sort(ref_results.begin(), ref_results.end(),
+                      [](const Calculator::Result& r1, const Calculator::Result& r2) {
+                          return (r1.second > r2.second || (r1.second == r2.second && r1.first < r2.first));
+                      });
+
+            calc.calculateTopN(query, 25);
+
+            BOOST_CHECK_EQUAL(calc.getNumResults(), std::min(std::size_t(25), ref_results.size()));
+            BOOST_CHECK(std::equal(calc.getResultsBegin(), calc.getResultsEnd(), ref_results.begin()));
+
+            if (ref_results.empty())
+                continue;
+
+            double threshold = ref_results[ref_results.size() / 3].second;
+
+            calc.calculateAboveThreshold(query, threshold);
+
+            std::size_t num_above = std::count_if(ref_results.begin(), ref_results.end(),
+                                                  [=](const Calculator::Result& res) { return (res.second >= threshold); });
+
+            BOOST_CHECK_EQUAL(calc.getNumResults(), num_above);
+            BOOST_CHECK(std::is_sorted(calc.getResultsBegin(), calc.getResultsEnd(),
+                                       [](const Calculator::Result& r1, const Calculator::Result& r2) { return (r1.first < r2.first); }));
+            BOOST_CHECK(std::all_of(calc.getResultsBegin(), calc.getResultsEnd(),
+                                    [=](const Calculator::Result& res) { return (res.second >= threshold); }));
+        }
+    }
+
+    calc.setSimilarityMeasure(Calculator::TANIMOTO);
+    calc.calculate(fps[1], true);
+
+    BOOST_CHECK_EQUAL(calc.getFingerprintIndex(0), 1);
+    BOOST_CHECK_EQUAL(calc.getSimilarity(0), 1.0);
+
+    calc.calculateTopN(fps[1], fps.size() * 2);
+
+    BOOST_CHECK_EQUAL(calc.getNumResults(), fps.size());
+
+    calc.removeFingerprint(1);
+
+    BOOST_CHECK_EQUAL(calc.getNumFingerprints(), fps.size() - 1);
+
+    calc.getFingerprint(1, fp);
+
+    BOOST_CHECK(fp == fps[2]);
+    BOOST_CHECK_THROW(calc.removeFingerprint(fps.size() - 1), Base::IndexError);
+
+    calc.clear();
+
+    BOOST_CHECK_EQUAL(calc.getNumFingerprints(), 0);
+    BOOST_CHECK_EQUAL(calc.getNumBits(), 0);
+}
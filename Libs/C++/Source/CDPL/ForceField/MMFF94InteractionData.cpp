@@ -24,12 +24,37 @@
 
 #include "StaticInit.hpp"
 
+#include <utility>
+#include <atomic>
+
 #include "CDPL/ForceField/MMFF94InteractionData.hpp"
 
 
 using namespace CDPL; 
 
 
+namespace
+{
+
+    std::atomic<std::size_t> nextNonbondedDataVersion(0);
+
+    std::size_t newNonbondedDataVersion()
+    {
+        return nextNonbondedDataVersion++;
+    }
+}
+
+
+constexpr double ForceField::MMFF94InteractionData::NO_NONBONDED_CUTOFF;
+constexpr double ForceField::MMFF94InteractionData::DEF_NONBONDED_SWITCHING_WIDTH;
+
+
+ForceField::MMFF94InteractionData::MMFF94InteractionData():
+    nonbondedCutoff(NO_NONBONDED_CUTOFF), nonbondedSwitchingWidth(DEF_NONBONDED_SWITCHING_WIDTH),
+    nonbondedDataVersion(newNonbondedDataVersion())
+{}
+
+
 const ForceField::MMFF94BondStretchingInteractionList& ForceField::MMFF94InteractionData::getBondStretchingInteractions() const
 {
     return bondStretchingData;
@@ -87,6 +112,8 @@ const ForceField::MMFF94ElectrostaticInteractionList& ForceField::MMFF94Interact
 
 ForceField::MMFF94ElectrostaticInteractionList& ForceField::MMFF94InteractionData::getElectrostaticInteractions()
 {
+    nonbondedDataVersion = newNonbondedDataVersion();
+
     return electrostaticData;
 }
 
@@ -97,9 +124,36 @@ const ForceField::MMFF94VanDerWaalsInteractionList& ForceField::MMFF94Interactio
 
 ForceField::MMFF94VanDerWaalsInteractionList& ForceField::MMFF94InteractionData::getVanDerWaalsInteractions()
 {
+    nonbondedDataVersion = newNonbondedDataVersion();
+
     return vanDerWaalsData;
 }
 
+std::size_t ForceField::MMFF94InteractionData::getNonbondedDataVersion() const
+{
+    return nonbondedDataVersion;
+}
+
+void ForceField::MMFF94InteractionData::setNonbondedCutoff(double cutoff)
+{
+    nonbondedCutoff = cutoff;
+}
+
+double ForceField::MMFF94InteractionData::getNonbondedCutoff() const
+{
+    return nonbondedCutoff;
+}
+
+void ForceField::MMFF94InteractionData::setNonbondedSwitchingWidth(double width)
+{
+    nonbondedSwitchingWidth = width;
+}
+
+double ForceField::MMFF94InteractionData::getNonbondedSwitchingWidth() const
+{
+    return nonbondedSwitchingWidth;
+}
+
 void ForceField::MMFF94InteractionData::clear()
 {
     bondStretchingData.clear();
@@ -109,6 +163,8 @@ void ForceField::MMFF94InteractionData::clear()
     torsionData.clear();
     electrostaticData.clear();
     vanDerWaalsData.clear();
+
+    nonbondedDataVersion = newNonbondedDataVersion();
 }
 
 void ForceField::MMFF94InteractionData::swap(MMFF94InteractionData& ia_data)
@@ -120,4 +176,8 @@ void ForceField::MMFF94InteractionData::swap(MMFF94InteractionData& ia_data)
     torsionData.swap(ia_data.torsionData);
     electrostaticData.swap(ia_data.electrostaticData);
     vanDerWaalsData.swap(ia_data.vanDerWaalsData);
+
+    std::swap(nonbondedCutoff, ia_data.nonbondedCutoff);
+    std::swap(nonbondedSwitchingWidth, ia_data.nonbondedSwitchingWidth);
+    std::swap(nonbondedDataVersion, ia_data.nonbondedDataVersion);
 }
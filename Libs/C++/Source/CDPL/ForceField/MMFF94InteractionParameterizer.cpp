@@ -38,7 +38,9 @@
 using namespace CDPL; 
 
     
-ForceField::MMFF94InteractionParameterizer::MMFF94InteractionParameterizer(unsigned int param_set)
+ForceField::MMFF94InteractionParameterizer::MMFF94InteractionParameterizer(unsigned int param_set):
+    nonbondedCutoff(MMFF94InteractionData::NO_NONBONDED_CUTOFF),
+    nonbondedSwitchingWidth(MMFF94InteractionData::DEF_NONBONDED_SWITCHING_WIDTH)
 {
     setPropertyFunctions();
     setParameterSet(param_set);
@@ -54,7 +56,9 @@ ForceField::MMFF94InteractionParameterizer::MMFF94InteractionParameterizer(const
     electrostaticParameterizer(parameterizer.electrostaticParameterizer),
     atomTyper(parameterizer.atomTyper),
     bondTyper(parameterizer.bondTyper),
-    chargeCalculator(parameterizer.chargeCalculator)
+    chargeCalculator(parameterizer.chargeCalculator),
+    nonbondedCutoff(parameterizer.nonbondedCutoff),
+    nonbondedSwitchingWidth(parameterizer.nonbondedSwitchingWidth)
 {
     setPropertyFunctions();
 }
@@ -211,6 +215,26 @@ void ForceField::MMFF94InteractionParameterizer::setDistanceExponent(double dist
     electrostaticParameterizer.setDistanceExponent(dist_expo);
 } 
 
+void ForceField::MMFF94InteractionParameterizer::setNonbondedCutoff(double cutoff)
+{
+    nonbondedCutoff = cutoff;
+}
+
+double ForceField::MMFF94InteractionParameterizer::getNonbondedCutoff() const
+{
+    return nonbondedCutoff;
+}
+
+void ForceField::MMFF94InteractionParameterizer::setNonbondedSwitchingWidth(double width)
+{
+    nonbondedSwitchingWidth = width;
+}
+
+double ForceField::MMFF94InteractionParameterizer::getNonbondedSwitchingWidth() const
+{
+    return nonbondedSwitchingWidth;
+}
+
 void ForceField::MMFF94InteractionParameterizer::setParameterSet(unsigned int param_set)
 {
     outOfPlaneParameterizer.setOutOfPlaneBendingParameterTable(MMFF94OutOfPlaneBendingParameterTable::get(param_set));
@@ -249,6 +273,9 @@ void ForceField::MMFF94InteractionParameterizer::parameterize(const Chem::Molecu
 
     if (ia_types & InteractionType::VAN_DER_WAALS)
         vanDerWaalsParameterizer.parameterize(molgraph, ia_list.getVanDerWaalsInteractions(), strict);
+
+    ia_list.setNonbondedCutoff(nonbondedCutoff);
+    ia_list.setNonbondedSwitchingWidth(nonbondedSwitchingWidth);
 }
 
 ForceField::MMFF94InteractionParameterizer& ForceField::MMFF94InteractionParameterizer::operator=(const MMFF94InteractionParameterizer& parameterizer)
@@ -266,6 +293,8 @@ ForceField::MMFF94InteractionParameterizer& ForceField::MMFF94InteractionParamet
     atomTyper = parameterizer.atomTyper;
     bondTyper = parameterizer.bondTyper;
     chargeCalculator = parameterizer.chargeCalculator;
+    nonbondedCutoff = parameterizer.nonbondedCutoff;
+    nonbondedSwitchingWidth = parameterizer.nonbondedSwitchingWidth;
     
     setPropertyFunctions();
 
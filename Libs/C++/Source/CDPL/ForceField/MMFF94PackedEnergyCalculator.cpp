@@ -0,0 +1,102 @@
+/*
+ * MMFF94PackedEnergyCalculator.cpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include "StaticInit.hpp"
+
+#include "CDPL/ForceField/MMFF94PackedEnergyCalculator.hpp"
+
+
+using namespace CDPL;
+
+
+ForceField::MMFF94PackedEnergyCalculator::MMFF94PackedEnergyCalculator()
+{}
+
+ForceField::MMFF94PackedEnergyCalculator::MMFF94PackedEnergyCalculator(const MMFF94InteractionData& ia_data, std::size_t num_atoms):
+    calculator(ia_data, num_atoms)
+{}
+
+void ForceField::MMFF94PackedEnergyCalculator::setEnabledInteractionTypes(unsigned int types)
+{
+    calculator.setEnabledInteractionTypes(types);
+}
+
+unsigned int ForceField::MMFF94PackedEnergyCalculator::getEnabledInteractionTypes() const
+{
+    return calculator.getEnabledInteractionTypes();
+}
+
+void ForceField::MMFF94PackedEnergyCalculator::setup(const MMFF94InteractionData& ia_data, std::size_t num_atoms)
+{
+    calculator.setup(ia_data, num_atoms);
+}
+
+const double& ForceField::MMFF94PackedEnergyCalculator::getTotalEnergy() const
+{
+    return calculator.getTotalEnergy();
+}
+
+const double& ForceField::MMFF94PackedEnergyCalculator::getBondStretchingEnergy() const
+{
+    return calculator.getBondStretchingEnergy();
+}
+
+const double& ForceField::MMFF94PackedEnergyCalculator::getAngleBendingEnergy() const
+{
+    return calculator.getAngleBendingEnergy();
+}
+
+const double& ForceField::MMFF94PackedEnergyCalculator::getStretchBendEnergy() const
+{
+    return calculator.getStretchBendEnergy();
+}
+
+const double& ForceField::MMFF94PackedEnergyCalculator::getOutOfPlaneBendingEnergy() const
+{
+    return calculator.getOutOfPlaneBendingEnergy();
+}
+
+const double& ForceField::MMFF94PackedEnergyCalculator::getTorsionEnergy() const
+{
+    return calculator.getTorsionEnergy();
+}
+
+const double& ForceField::MMFF94PackedEnergyCalculator::getElectrostaticEnergy() const
+{
+    return calculator.getElectrostaticEnergy();
+}
+
+const double& ForceField::MMFF94PackedEnergyCalculator::getVanDerWaalsEnergy() const
+{
+    return calculator.getVanDerWaalsEnergy();
+}
+
+void ForceField::MMFF94PackedEnergyCalculator::enforcePortableKernels(bool enforce)
+{
+    calculator.enforcePortableKernels(enforce);
+}
+
+bool ForceField::MMFF94PackedEnergyCalculator::portableKernelsEnforced() const
+{
+    return calculator.portableKernelsEnforced();
+}
@@ -0,0 +1,1203 @@
+/*
+ * MMFF94PackedGradientCalculator.cpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#include "StaticInit.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+# define CDPL_FORCEFIELD_MMFF94_KERNEL_X86_DISPATCH
+# include <immintrin.h>
+#endif
+
+#include "CDPL/ForceField/MMFF94PackedGradientCalculator.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+    /*
+     * Layout of the packed interaction tables: for an interaction table of size n, the offset of the
+     * k-th interaction atom of interaction i in the coordinates buffer (3 * atom index) is stored at
+     * atomOffsets[k * n + i] and parameter p at params[p * n + i]. The gradient kernels store the
+     * contribution of interaction i to component c of the gradient of its k-th atom at
+     * grad_contribs[(k * 3 + c) * n + i]. For the two-atom interactions only the contribution to the
+     * gradient of the first atom is stored (the one of the second atom has the opposite sign).
+     */
+
+    enum
+    {
+
+        ANGLE_TERM_ATOM1,
+        ANGLE_CTR_ATOM,
+        ANGLE_TERM_ATOM2,
+        NUM_ANGLE_ATOMS
+    };
+
+    enum
+    {
+
+        ANGLE_FORCE_CONST,
+        ANGLE_REF_ANGLE,
+        ANGLE_LINEAR_FLAG,
+        NUM_ANGLE_PARAMS
+    };
+
+    enum
+    {
+
+        TORSION_TERM_ATOM1,
+        TORSION_CTR_ATOM1,
+        TORSION_CTR_ATOM2,
+        TORSION_TERM_ATOM2,
+        NUM_TORSION_ATOMS
+    };
+
+    enum
+    {
+
+        TORSION_PARAM1,
+        TORSION_PARAM2,
+        TORSION_PARAM3,
+        NUM_TORSION_PARAMS
+    };
+
+    enum
+    {
+
+        PAIR_ATOM1,
+        PAIR_ATOM2,
+        NUM_PAIR_ATOMS
+    };
+
+    enum
+    {
+
+        ELEC_CHARGE_FACTOR,
+        ELEC_DIST_EXPONENT,
+        NUM_ELEC_PARAMS
+    };
+
+    enum
+    {
+
+        VDW_E_IJ,
+        VDW_R_IJ,
+        VDW_R_IJ_7,
+        NUM_VDW_PARAMS
+    };
+
+    constexpr std::size_t NUM_LANES = 4;
+
+    typedef double (*KernelFunction)(const std::int32_t* offsets, const double* params, std::size_t num_iactions,
+                                     const double* coords, double* grad_contribs);
+
+    /*
+     * All kernels accumulate the interaction energies in NUM_LANES partial sums (interaction i adds to
+     * sum i % NUM_LANES) which get combined in the same order as the lanes of an AVX2 register. Since the
+     * scalar code performs exactly the same floating point operations per interaction as the vector code,
+     * the results do not depend on the selected implementation (which is checked by the unit tests with
+     * the help of MMFF94PackedGradientCalculator::enforcePortableKernels()).
+     */
+
+    inline double sumLanes(const double* lane_sums)
+    {
+        return ((lane_sums[0] + lane_sums[2]) + (lane_sums[1] + lane_sums[3]));
+    }
+
+    inline double clampCosine(double v)
+    {
+        return std::min(std::max(v, -1.0), 1.0);
+    }
+
+    template <bool GRAD>
+    void accumAngleBendingPortable(const std::int32_t* offsets, const double* params, std::size_t num_iactions, std::size_t beg,
+                                  const double* coords, double* grad_contribs, double* lane_sums)
+    {
+        for (std::size_t i = beg; i < num_iactions; i++) {
+            const double* term1_pos = coords + offsets[ANGLE_TERM_ATOM1 * num_iactions + i];
+            const double* ctr_pos   = coords + offsets[ANGLE_CTR_ATOM * num_iactions + i];
+            const double* term2_pos = coords + offsets[ANGLE_TERM_ATOM2 * num_iactions + i];
+
+            double force_const = params[ANGLE_FORCE_CONST * num_iactions + i];
+            double ref_angle   = params[ANGLE_REF_ANGLE * num_iactions + i];
+            bool   linear      = (params[ANGLE_LINEAR_FLAG * num_iactions + i] != 0.0);
+
+            double bv1_x = term1_pos[0] - ctr_pos[0];
+            double bv1_y = term1_pos[1] - ctr_pos[1];
+            double bv1_z = term1_pos[2] - ctr_pos[2];
+            double bv2_x = term2_pos[0] - ctr_pos[0];
+            double bv2_y = term2_pos[1] - ctr_pos[1];
+            double bv2_z = term2_pos[2] - ctr_pos[2];
+
+            double bl1      = std::sqrt(bv1_x * bv1_x + bv1_y * bv1_y + bv1_z * bv1_z);
+            double bl2      = std::sqrt(bv2_x * bv2_x + bv2_y * bv2_y + bv2_z * bv2_z);
+            double dot_prod = bv1_x * bv2_x + bv1_y * bv2_y + bv1_z * bv2_z;
+            double bl_prod  = bl1 * bl2;
+            double a_cos    = clampCosine(dot_prod / bl_prod);
+            double e_a;
+
+            if (!GRAD) {
+                if (linear)
+                    e_a = 143.9325 * force_const * (1 + a_cos);
+
+                else {
+                    double da = std::acos(a_cos) * (180 / M_PI) - ref_angle;
+
+                    e_a = (0.043844 * 0.5) * force_const * da * da * (1 - 0.007 * da);
+                }
+
+                lane_sums[i % NUM_LANES] += e_a;
+                continue;
+            }
+
+            double grad_fact;
+
+            if (linear) {
+                grad_fact = 143.9325 * force_const;
+                e_a       = 143.9325 * force_const * (1 + a_cos);
+
+            } else {
+                double a   = std::acos(a_cos);
+                double div = std::sqrt(1 - a_cos * a_cos);
+
+                if (div < 0.0000001)
+                    div = 0.0000001;
+
+                grad_fact = force_const / div *
+                            (a * (86.58992538 * a - 143.9313616) -
+                             ref_angle * (3.022558594 * a - 0.02637679965 * ref_angle - 2.512076157));
+
+                double da = a * (180 / M_PI) - ref_angle;
+
+                e_a = (0.043844 * 0.5) * force_const * da * da * (1 - 0.007 * da);
+            }
+
+            lane_sums[i % NUM_LANES] += e_a;
+
+            double fact1 = dot_prod / (bl1 * bl1 * bl_prod);
+            double fact2 = dot_prod / (bl2 * bl2 * bl_prod);
+
+            double t1_x = (bv2_x / bl_prod - bv1_x * fact1) * grad_fact;
+            double t1_y = (bv2_y / bl_prod - bv1_y * fact1) * grad_fact;
+            double t1_z = (bv2_z / bl_prod - bv1_z * fact1) * grad_fact;
+            double t2_x = (bv1_x / bl_prod - bv2_x * fact2) * grad_fact;
+            double t2_y = (bv1_y / bl_prod - bv2_y * fact2) * grad_fact;
+            double t2_z = (bv1_z / bl_prod - bv2_z * fact2) * grad_fact;
+
+            grad_contribs[(ANGLE_TERM_ATOM1 * 3 + 0) * num_iactions + i] = t1_x;
+            grad_contribs[(ANGLE_TERM_ATOM1 * 3 + 1) * num_iactions + i] = t1_y;
+            grad_contribs[(ANGLE_TERM_ATOM1 * 3 + 2) * num_iactions + i] = t1_z;
+            grad_contribs[(ANGLE_CTR_ATOM * 3 + 0) * num_iactions + i]   = -t1_x - t2_x;
+            grad_contribs[(ANGLE_CTR_ATOM * 3 + 1) * num_iactions + i]   = -t1_y - t2_y;
+            grad_contribs[(ANGLE_CTR_ATOM * 3 + 2) * num_iactions + i]   = -t1_z - t2_z;
+            grad_contribs[(ANGLE_TERM_ATOM2 * 3 + 0) * num_iactions + i] = t2_x;
+            grad_contribs[(ANGLE_TERM_ATOM2 * 3 + 1) * num_iactions + i] = t2_y;
+            grad_contribs[(ANGLE_TERM_ATOM2 * 3 + 2) * num_iactions + i] = t2_z;
+        }
+    }
+
+    template <bool GRAD>
+    void accumTorsionPortable(const std::int32_t* offsets, const double* params, std::size_t num_iactions, std::size_t beg,
+                             const double* coords, double* grad_contribs, double* lane_sums)
+    {
+        for (std::size_t i = beg; i < num_iactions; i++) {
+            const double* term1_pos = coords + offsets[TORSION_TERM_ATOM1 * num_iactions + i];
+            const double* ctr1_pos  = coords + offsets[TORSION_CTR_ATOM1 * num_iactions + i];
+            const double* ctr2_pos  = coords + offsets[TORSION_CTR_ATOM2 * num_iactions + i];
+            const double* term2_pos = coords + offsets[TORSION_TERM_ATOM2 * num_iactions + i];
+
+            double tb1_x = term1_pos[0] - ctr1_pos[0];
+            double tb1_y = term1_pos[1] - ctr1_pos[1];
+            double tb1_z = term1_pos[2] - ctr1_pos[2];
+            double cb_x  = ctr2_pos[0] - ctr1_pos[0];
+            double cb_y  = ctr2_pos[1] - ctr1_pos[1];
+            double cb_z  = ctr2_pos[2] - ctr1_pos[2];
+            double tb2_x = ctr2_pos[0] - term2_pos[0];
+            double tb2_y = ctr2_pos[1] - term2_pos[1];
+            double tb2_z = ctr2_pos[2] - term2_pos[2];
+
+            double pn1_x = tb1_y * cb_z - tb1_z * cb_y;
+            double pn1_y = tb1_z * cb_x - tb1_x * cb_z;
+            double pn1_z = tb1_x * cb_y - tb1_y * cb_x;
+            double pn2_x = cb_y * tb2_z - cb_z * tb2_y;
+            double pn2_y = cb_z * tb2_x - cb_x * tb2_z;
+            double pn2_z = cb_x * tb2_y - cb_y * tb2_x;
+
+            double pn1_len = std::sqrt(pn1_x * pn1_x + pn1_y * pn1_y + pn1_z * pn1_z);
+            double pn2_len = std::sqrt(pn2_x * pn2_x + pn2_y * pn2_y + pn2_z * pn2_z);
+
+            pn1_x /= pn1_len;
+            pn1_y /= pn1_len;
+            pn1_z /= pn1_len;
+            pn2_x /= pn2_len;
+            pn2_y /= pn2_len;
+            pn2_z /= pn2_len;
+
+            double t_cos = clampCosine(pn1_x * pn2_x + pn1_y * pn2_y + pn1_z * pn2_z);
+
+            // cos(2 * phi) and cos(3 * phi) are obtained via the Chebyshev recurrence which also
+            // avoids the singularity of the derivative w.r.t. phi at phi = 0 and phi = PI
+
+            double tor_param1 = params[TORSION_PARAM1 * num_iactions + i];
+            double tor_param2 = params[TORSION_PARAM2 * num_iactions + i];
+            double tor_param3 = params[TORSION_PARAM3 * num_iactions + i];
+            double t_cos_2    = t_cos * t_cos;
+            double cos_2phi   = 2 * t_cos_2 - 1;
+            double cos_3phi   = (4 * t_cos_2 - 3) * t_cos;
+
+            lane_sums[i % NUM_LANES] += 0.5 * (tor_param1 * (1 + t_cos) + tor_param2 * (1 - cos_2phi) + tor_param3 * (1 + cos_3phi));
+
+            if (!GRAD)
+                continue;
+
+            double grad_fact = 0.5 * tor_param1 - 2 * tor_param2 * t_cos + tor_param3 * (6 * t_cos_2 - 1.5);
+
+            double a_x = (pn2_x - pn1_x * t_cos) / pn1_len;
+            double a_y = (pn2_y - pn1_y * t_cos) / pn1_len;
+            double a_z = (pn2_z - pn1_z * t_cos) / pn1_len;
+            double b_x = (pn1_x - pn2_x * t_cos) / pn2_len;
+            double b_y = (pn1_y - pn2_y * t_cos) / pn2_len;
+            double b_z = (pn1_z - pn2_z * t_cos) / pn2_len;
+
+            double t1c2_x = term1_pos[0] - ctr2_pos[0];
+            double t1c2_y = term1_pos[1] - ctr2_pos[1];
+            double t1c2_z = term1_pos[2] - ctr2_pos[2];
+
+            double t1_x = (cb_y * a_z - cb_z * a_y) * grad_fact;
+            double t1_y = (cb_z * a_x - cb_x * a_z) * grad_fact;
+            double t1_z = (cb_x * a_y - cb_y * a_x) * grad_fact;
+            double t2_x = (cb_y * b_z - cb_z * b_y) * grad_fact;
+            double t2_y = (cb_z * b_x - cb_x * b_z) * grad_fact;
+            double t2_z = (cb_x * b_y - cb_y * b_x) * grad_fact;
+            double c1_x = ((t1c2_y * a_z - t1c2_z * a_y) - (tb2_y * b_z - tb2_z * b_y)) * grad_fact;
+            double c1_y = ((t1c2_z * a_x - t1c2_x * a_z) - (tb2_z * b_x - tb2_x * b_z)) * grad_fact;
+            double c1_z = ((t1c2_x * a_y - t1c2_y * a_x) - (tb2_x * b_y - tb2_y * b_x)) * grad_fact;
+
+            grad_contribs[(TORSION_TERM_ATOM1 * 3 + 0) * num_iactions + i] = t1_x;
+            grad_contribs[(TORSION_TERM_ATOM1 * 3 + 1) * num_iactions + i] = t1_y;
+            grad_contribs[(TORSION_TERM_ATOM1 * 3 + 2) * num_iactions + i] = t1_z;
+            grad_contribs[(TORSION_CTR_ATOM1 * 3 + 0) * num_iactions + i]  = c1_x;
+            grad_contribs[(TORSION_CTR_ATOM1 * 3 + 1) * num_iactions + i]  = c1_y;
+            grad_contribs[(TORSION_CTR_ATOM1 * 3 + 2) * num_iactions + i]  = c1_z;
+            grad_contribs[(TORSION_CTR_ATOM2 * 3 + 0) * num_iactions + i]  = -(t1_x + c1_x + t2_x);
+            grad_contribs[(TORSION_CTR_ATOM2 * 3 + 1) * num_iactions + i]  = -(t1_y + c1_y + t2_y);
+            grad_contribs[(TORSION_CTR_ATOM2 * 3 + 2) * num_iactions + i]  = -(t1_z + c1_z + t2_z);
+            grad_contribs[(TORSION_TERM_ATOM2 * 3 + 0) * num_iactions + i] = t2_x;
+            grad_contribs[(TORSION_TERM_ATOM2 * 3 + 1) * num_iactions + i] = t2_y;
+            grad_contribs[(TORSION_TERM_ATOM2 * 3 + 2) * num_iactions + i] = t2_z;
+        }
+    }
+
+    // EXPO == 0 denotes an arbitrary, per-interaction distance exponent
+
+    template <unsigned int EXPO, bool GRAD>
+    void accumElectrostaticPortable(const std::int32_t* offsets, const double* params, std::size_t num_iactions, std::size_t beg,
+                                   const double* coords, double* grad_contribs, double* lane_sums)
+    {
+        for (std::size_t i = beg; i < num_iactions; i++) {
+            const double* atom1_pos = coords + offsets[PAIR_ATOM1 * num_iactions + i];
+            const double* atom2_pos = coords + offsets[PAIR_ATOM2 * num_iactions + i];
+
+            double d_x = atom1_pos[0] - atom2_pos[0];
+            double d_y = atom1_pos[1] - atom2_pos[1];
+            double d_z = atom1_pos[2] - atom2_pos[2];
+            double r   = std::sqrt(d_x * d_x + d_y * d_y + d_z * d_z);
+
+            double tmp1 = r + 0.05;
+            double expo = (EXPO == 0 ? params[ELEC_DIST_EXPONENT * num_iactions + i] : double(EXPO));
+            double tmp2 = (EXPO == 1 ? tmp1 : EXPO == 2 ? tmp1 * tmp1 : std::pow(tmp1, expo));
+            double e_q  = params[ELEC_CHARGE_FACTOR * num_iactions + i] / tmp2;
+
+            lane_sums[i % NUM_LANES] += e_q;
+
+            if (!GRAD)
+                continue;
+
+            double grad_fact = -expo * e_q / tmp1;
+
+            grad_contribs[0 * num_iactions + i] = d_x / r * grad_fact;
+            grad_contribs[1 * num_iactions + i] = d_y / r * grad_fact;
+            grad_contribs[2 * num_iactions + i] = d_z / r * grad_fact;
+        }
+    }
+
+    template <bool GRAD>
+    void accumVanDerWaalsPortable(const std::int32_t* offsets, const double* params, std::size_t num_iactions, std::size_t beg,
+                                 const double* coords, double* grad_contribs, double* lane_sums)
+    {
+        for (std::size_t i = beg; i < num_iactions; i++) {
+            const double* atom1_pos = coords + offsets[PAIR_ATOM1 * num_iactions + i];
+            const double* atom2_pos = coords + offsets[PAIR_ATOM2 * num_iactions + i];
+
+            double d_x = atom1_pos[0] - atom2_pos[0];
+            double d_y = atom1_pos[1] - atom2_pos[1];
+            double d_z = atom1_pos[2] - atom2_pos[2];
+            double r   = std::sqrt(d_x * d_x + d_y * d_y + d_z * d_z);
+
+            double e_IJ   = params[VDW_E_IJ * num_iactions + i];
+            double r_IJ   = params[VDW_R_IJ * num_iactions + i];
+            double r_IJ_7 = params[VDW_R_IJ_7 * num_iactions + i];
+
+            double r_2 = r * r;
+            double r_6 = r_2 * r_2 * r_2;
+            double r_7 = r_6 * r;
+
+            double tmp1   = r + 0.07 * r_IJ;
+            double tmp2   = r_7 + 0.12 * r_IJ_7;
+            double tmp3   = 1.07 * r_IJ / tmp1;
+            double tmp3_2 = tmp3 * tmp3;
+            double tmp3_7 = tmp3_2 * tmp3_2 * tmp3_2 * tmp3;
+
+            lane_sums[i % NUM_LANES] += e_IJ * tmp3_7 * (1.12 * r_IJ_7 / tmp2 - 2);
+
+            if (!GRAD)
+                continue;
+
+            double tmp1_2 = tmp1 * tmp1;
+            double tmp1_4 = tmp1_2 * tmp1_2;
+
+            double grad_fact = -r_IJ_7 * e_IJ / (tmp1_4 * tmp1_4 * tmp2 * tmp2) *
+                               (-22.48094067 * r_7 * r_7 + 19.78322779 * r_7 * r_IJ_7 +
+                                0.8812528743 * r_6 * r_IJ_7 * r_IJ + 1.186993667 * r_IJ_7 * r_IJ_7);
+
+            grad_contribs[0 * num_iactions + i] = d_x / r * grad_fact;
+            grad_contribs[1 * num_iactions + i] = d_y / r * grad_fact;
+            grad_contribs[2 * num_iactions + i] = d_z / r * grad_fact;
+        }
+    }
+
+    template <bool GRAD>
+    double calcAngleBendingsPortable(const std::int32_t* offsets, const double* params, std::size_t num_iactions,
+                                     const double* coords, double* grad_contribs)
+    {
+        double lane_sums[NUM_LANES] = { 0.0, 0.0, 0.0, 0.0 };
+
+        accumAngleBendingPortable<GRAD>(offsets, params, num_iactions, 0, coords, grad_contribs, lane_sums);
+
+        return sumLanes(lane_sums);
+    }
+
+    template <bool GRAD>
+    double calcTorsionsPortable(const std::int32_t* offsets, const double* params, std::size_t num_iactions,
+                                const double* coords, double* grad_contribs)
+    {
+        double lane_sums[NUM_LANES] = { 0.0, 0.0, 0.0, 0.0 };
+
+        accumTorsionPortable<GRAD>(offsets, params, num_iactions, 0, coords, grad_contribs, lane_sums);
+
+        return sumLanes(lane_sums);
+    }
+
+    template <unsigned int EXPO, bool GRAD>
+    double calcElectrostaticsPortable(const std::int32_t* offsets, const double* params, std::size_t num_iactions,
+                                      const double* coords, double* grad_contribs)
+    {
+        double lane_sums[NUM_LANES] = { 0.0, 0.0, 0.0, 0.0 };
+
+        accumElectrostaticPortable<EXPO, GRAD>(offsets, params, num_iactions, 0, coords, grad_contribs, lane_sums);
+
+        return sumLanes(lane_sums);
+    }
+
+    template <bool GRAD>
+    double calcVanDerWaalsPortable(const std::int32_t* offsets, const double* params, std::size_t num_iactions,
+                                   const double* coords, double* grad_contribs)
+    {
+        double lane_sums[NUM_LANES] = { 0.0, 0.0, 0.0, 0.0 };
+
+        accumVanDerWaalsPortable<GRAD>(offsets, params, num_iactions, 0, coords, grad_contribs, lane_sums);
+
+        return sumLanes(lane_sums);
+    }
+
+#ifdef CDPL_FORCEFIELD_MMFF94_KERNEL_X86_DISPATCH
+
+    struct Vec256d3
+    {
+
+        __m256d x;
+        __m256d y;
+        __m256d z;
+    };
+
+#ifndef _MSC_VER
+# pragma GCC diagnostic push
+# pragma GCC diagnostic ignored "-Wuninitialized"   // false positives caused by the AVX2 gather intrinsics
+# pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif // !_MSC_VER
+
+    __attribute__((target("avx2")))
+    inline Vec256d3 gatherPositions(const double* coords, const std::int32_t* offsets)
+    {
+        __m128i offs = _mm_loadu_si128(reinterpret_cast<const __m128i*>(offsets));
+
+        return Vec256d3{ _mm256_i32gather_pd(coords, offs, 8), _mm256_i32gather_pd(coords + 1, offs, 8),
+                         _mm256_i32gather_pd(coords + 2, offs, 8) };
+    }
+
+#ifndef _MSC_VER
+# pragma GCC diagnostic pop
+#endif // !_MSC_VER
+
+    __attribute__((target("avx2")))
+    inline Vec256d3 sub(const Vec256d3& v1, const Vec256d3& v2)
+    {
+        return Vec256d3{ _mm256_sub_pd(v1.x, v2.x), _mm256_sub_pd(v1.y, v2.y), _mm256_sub_pd(v1.z, v2.z) };
+    }
+
+    __attribute__((target("avx2")))
+    inline Vec256d3 cross(const Vec256d3& v1, const Vec256d3& v2)
+    {
+        return Vec256d3{ _mm256_sub_pd(_mm256_mul_pd(v1.y, v2.z), _mm256_mul_pd(v1.z, v2.y)),
+                         _mm256_sub_pd(_mm256_mul_pd(v1.z, v2.x), _mm256_mul_pd(v1.x, v2.z)),
+                         _mm256_sub_pd(_mm256_mul_pd(v1.x, v2.y), _mm256_mul_pd(v1.y, v2.x)) };
+    }
+
+    __attribute__((target("avx2")))
+    inline __m256d dot(const Vec256d3& v1, const Vec256d3& v2)
+    {
+        return _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(v1.x, v2.x), _mm256_mul_pd(v1.y, v2.y)), _mm256_mul_pd(v1.z, v2.z));
+    }
+
+    __attribute__((target("avx2")))
+    inline Vec256d3 scale(const Vec256d3& v, __m256d fact)
+    {
+        return Vec256d3{ _mm256_mul_pd(v.x, fact), _mm256_mul_pd(v.y, fact), _mm256_mul_pd(v.z, fact) };
+    }
+
+    __attribute__((target("avx2")))
+    inline void store(const Vec256d3& v, double* grad_contribs, std::size_t num_iactions)
+    {
+        _mm256_storeu_pd(grad_contribs, v.x);
+        _mm256_storeu_pd(grad_contribs + num_iactions, v.y);
+        _mm256_storeu_pd(grad_contribs + 2 * num_iactions, v.z);
+    }
+
+    __attribute__((target("avx2")))
+    inline void storePairGradContribs(const Vec256d3& d, __m256d r, __m256d grad_fact, double* grad_contribs, std::size_t num_iactions)
+    {
+        _mm256_storeu_pd(grad_contribs, _mm256_mul_pd(_mm256_div_pd(d.x, r), grad_fact));
+        _mm256_storeu_pd(grad_contribs + num_iactions, _mm256_mul_pd(_mm256_div_pd(d.y, r), grad_fact));
+        _mm256_storeu_pd(grad_contribs + 2 * num_iactions, _mm256_mul_pd(_mm256_div_pd(d.z, r), grad_fact));
+    }
+
+    __attribute__((target("avx2")))
+    inline void storeLanes(__m256d lane_sums_vec, double* lane_sums)
+    {
+        _mm256_storeu_pd(lane_sums, lane_sums_vec);
+    }
+
+    // the geometry and energy terms of four angles are computed at once, the acos() of the bending angles
+    // is evaluated per lane by the same libm function as used by the portable kernel
+
+    template <bool GRAD>
+    __attribute__((target("avx2")))
+    double calcAngleBendingsAVX2(const std::int32_t* offsets, const double* params, std::size_t num_iactions,
+                                 const double* coords, double* grad_contribs)
+    {
+        const __m256d one      = _mm256_set1_pd(1.0);
+        const __m256d mone     = _mm256_set1_pd(-1.0);
+        const __m256d sign_bit = _mm256_set1_pd(-0.0);
+        const __m256d rad2deg  = _mm256_set1_pd(180 / M_PI);
+
+        __m256d     lane_sums_vec = _mm256_setzero_pd();
+        std::size_t i             = 0;
+        double      lane_vals[NUM_LANES];
+
+        for (; i + NUM_LANES <= num_iactions; i += NUM_LANES) {
+            Vec256d3 ctr_pos = gatherPositions(coords, offsets + ANGLE_CTR_ATOM * num_iactions + i);
+            Vec256d3 bv1     = sub(gatherPositions(coords, offsets + ANGLE_TERM_ATOM1 * num_iactions + i), ctr_pos);
+            Vec256d3 bv2     = sub(gatherPositions(coords, offsets + ANGLE_TERM_ATOM2 * num_iactions + i), ctr_pos);
+
+            __m256d force_const = _mm256_loadu_pd(params + ANGLE_FORCE_CONST * num_iactions + i);
+            __m256d ref_angle   = _mm256_loadu_pd(params + ANGLE_REF_ANGLE * num_iactions + i);
+            __m256d linear      = _mm256_cmp_pd(_mm256_loadu_pd(params + ANGLE_LINEAR_FLAG * num_iactions + i), _mm256_setzero_pd(), _CMP_NEQ_UQ);
+
+            __m256d bl1      = _mm256_sqrt_pd(dot(bv1, bv1));
+            __m256d bl2      = _mm256_sqrt_pd(dot(bv2, bv2));
+            __m256d dot_prod = dot(bv1, bv2);
+            __m256d bl_prod  = _mm256_mul_pd(bl1, bl2);
+            __m256d a_cos    = _mm256_min_pd(one, _mm256_max_pd(mone, _mm256_div_pd(dot_prod, bl_prod))); // same semantics as clampCosine()
+
+            _mm256_storeu_pd(lane_vals, a_cos);
+
+            for (std::size_t j = 0; j < NUM_LANES; j++)
+                lane_vals[j] = std::acos(lane_vals[j]);
+
+            __m256d a  = _mm256_loadu_pd(lane_vals);
+            __m256d da = _mm256_sub_pd(_mm256_mul_pd(a, rad2deg), ref_angle);
+
+            __m256d lin_e_fact = _mm256_mul_pd(_mm256_set1_pd(143.9325), force_const);
+            __m256d e_a        = _mm256_blendv_pd(_mm256_mul_pd(_mm256_mul_pd(_mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(0.043844 * 0.5), force_const), da), da),
+                                                                _mm256_sub_pd(one, _mm256_mul_pd(_mm256_set1_pd(0.007), da))),
+                                                  _mm256_mul_pd(lin_e_fact, _mm256_add_pd(one, a_cos)), linear);
+
+            lane_sums_vec = _mm256_add_pd(lane_sums_vec, e_a);
+
+            if (!GRAD)
+                continue;
+
+            __m256d div  = _mm256_max_pd(_mm256_set1_pd(0.0000001), _mm256_sqrt_pd(_mm256_sub_pd(one, _mm256_mul_pd(a_cos, a_cos))));
+            __m256d poly = _mm256_sub_pd(_mm256_mul_pd(a, _mm256_sub_pd(_mm256_mul_pd(_mm256_set1_pd(86.58992538), a), _mm256_set1_pd(143.9313616))),
+                                         _mm256_mul_pd(ref_angle, _mm256_sub_pd(_mm256_sub_pd(_mm256_mul_pd(_mm256_set1_pd(3.022558594), a),
+                                                                                              _mm256_mul_pd(_mm256_set1_pd(0.02637679965), ref_angle)),
+                                                                                _mm256_set1_pd(2.512076157))));
+
+            __m256d grad_fact = _mm256_blendv_pd(_mm256_mul_pd(_mm256_div_pd(force_const, div), poly), lin_e_fact, linear);
+
+            __m256d fact1 = _mm256_div_pd(dot_prod, _mm256_mul_pd(_mm256_mul_pd(bl1, bl1), bl_prod));
+            __m256d fact2 = _mm256_div_pd(dot_prod, _mm256_mul_pd(_mm256_mul_pd(bl2, bl2), bl_prod));
+
+            Vec256d3 t1{ _mm256_mul_pd(_mm256_sub_pd(_mm256_div_pd(bv2.x, bl_prod), _mm256_mul_pd(bv1.x, fact1)), grad_fact),
+                         _mm256_mul_pd(_mm256_sub_pd(_mm256_div_pd(bv2.y, bl_prod), _mm256_mul_pd(bv1.y, fact1)), grad_fact),
+                         _mm256_mul_pd(_mm256_sub_pd(_mm256_div_pd(bv2.z, bl_prod), _mm256_mul_pd(bv1.z, fact1)), grad_fact) };
+            Vec256d3 t2{ _mm256_mul_pd(_mm256_sub_pd(_mm256_div_pd(bv1.x, bl_prod), _mm256_mul_pd(bv2.x, fact2)), grad_fact),
+                         _mm256_mul_pd(_mm256_sub_pd(_mm256_div_pd(bv1.y, bl_prod), _mm256_mul_pd(bv2.y, fact2)), grad_fact),
+                         _mm256_mul_pd(_mm256_sub_pd(_mm256_div_pd(bv1.z, bl_prod), _mm256_mul_pd(bv2.z, fact2)), grad_fact) };
+            Vec256d3 c{ _mm256_sub_pd(_mm256_xor_pd(t1.x, sign_bit), t2.x), _mm256_sub_pd(_mm256_xor_pd(t1.y, sign_bit), t2.y),
+                        _mm256_sub_pd(_mm256_xor_pd(t1.z, sign_bit), t2.z) };
+
+            store(t1, grad_contribs + (ANGLE_TERM_ATOM1 * 3) * num_iactions + i, num_iactions);
+            store(c, grad_contribs + (ANGLE_CTR_ATOM * 3) * num_iactions + i, num_iactions);
+            store(t2, grad_contribs + (ANGLE_TERM_ATOM2 * 3) * num_iactions + i, num_iactions);
+        }
+
+        double lane_sums[NUM_LANES];
+
+        storeLanes(lane_sums_vec, lane_sums);
+        accumAngleBendingPortable<GRAD>(offsets, params, num_iactions, i, coords, grad_contribs, lane_sums);
+
+        return sumLanes(lane_sums);
+    }
+
+    template <bool GRAD>
+    __attribute__((target("avx2")))
+    double calcTorsionsAVX2(const std::int32_t* offsets, const double* params, std::size_t num_iactions,
+                            const double* coords, double* grad_contribs)
+    {
+        const __m256d one  = _mm256_set1_pd(1.0);
+        const __m256d mone = _mm256_set1_pd(-1.0);
+        const __m256d half = _mm256_set1_pd(0.5);
+        const __m256d two  = _mm256_set1_pd(2.0);
+
+        __m256d     lane_sums_vec = _mm256_setzero_pd();
+        std::size_t i             = 0;
+
+        for (; i + NUM_LANES <= num_iactions; i += NUM_LANES) {
+            Vec256d3 term1_pos = gatherPositions(coords, offsets + TORSION_TERM_ATOM1 * num_iactions + i);
+            Vec256d3 ctr1_pos  = gatherPositions(coords, offsets + TORSION_CTR_ATOM1 * num_iactions + i);
+            Vec256d3 ctr2_pos  = gatherPositions(coords, offsets + TORSION_CTR_ATOM2 * num_iactions + i);
+            Vec256d3 term2_pos = gatherPositions(coords, offsets + TORSION_TERM_ATOM2 * num_iactions + i);
+
+            Vec256d3 tb1 = sub(term1_pos, ctr1_pos);
+            Vec256d3 cb  = sub(ctr2_pos, ctr1_pos);
+            Vec256d3 tb2 = sub(ctr2_pos, term2_pos);
+
+            Vec256d3 pn1 = cross(tb1, cb);
+            Vec256d3 pn2 = cross(cb, tb2);
+
+            __m256d pn1_len = _mm256_sqrt_pd(dot(pn1, pn1));
+            __m256d pn2_len = _mm256_sqrt_pd(dot(pn2, pn2));
+
+            pn1 = Vec256d3{ _mm256_div_pd(pn1.x, pn1_len), _mm256_div_pd(pn1.y, pn1_len), _mm256_div_pd(pn1.z, pn1_len) };
+            pn2 = Vec256d3{ _mm256_div_pd(pn2.x, pn2_len), _mm256_div_pd(pn2.y, pn2_len), _mm256_div_pd(pn2.z, pn2_len) };
+
+            __m256d t_cos = _mm256_min_pd(_mm256_max_pd(dot(pn1, pn2), mone), one);
+
+            __m256d tor_param1 = _mm256_loadu_pd(params + TORSION_PARAM1 * num_iactions + i);
+            __m256d tor_param2 = _mm256_loadu_pd(params + TORSION_PARAM2 * num_iactions + i);
+            __m256d tor_param3 = _mm256_loadu_pd(params + TORSION_PARAM3 * num_iactions + i);
+            __m256d t_cos_2    = _mm256_mul_pd(t_cos, t_cos);
+            __m256d cos_2phi   = _mm256_sub_pd(_mm256_mul_pd(two, t_cos_2), one);
+            __m256d cos_3phi   = _mm256_mul_pd(_mm256_sub_pd(_mm256_mul_pd(_mm256_set1_pd(4.0), t_cos_2), _mm256_set1_pd(3.0)), t_cos);
+
+            __m256d e_t = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(tor_param1, _mm256_add_pd(one, t_cos)),
+                                                      _mm256_mul_pd(tor_param2, _mm256_sub_pd(one, cos_2phi))),
+                                        _mm256_mul_pd(tor_param3, _mm256_add_pd(one, cos_3phi)));
+
+            lane_sums_vec = _mm256_add_pd(lane_sums_vec, _mm256_mul_pd(half, e_t));
+
+            if (!GRAD)
+                continue;
+
+            __m256d grad_fact = _mm256_add_pd(_mm256_sub_pd(_mm256_mul_pd(half, tor_param1), _mm256_mul_pd(_mm256_mul_pd(two, tor_param2), t_cos)),
+                                              _mm256_mul_pd(tor_param3, _mm256_sub_pd(_mm256_mul_pd(_mm256_set1_pd(6.0), t_cos_2), _mm256_set1_pd(1.5))));
+
+            Vec256d3 a{ _mm256_div_pd(_mm256_sub_pd(pn2.x, _mm256_mul_pd(pn1.x, t_cos)), pn1_len),
+                        _mm256_div_pd(_mm256_sub_pd(pn2.y, _mm256_mul_pd(pn1.y, t_cos)), pn1_len),
+                        _mm256_div_pd(_mm256_sub_pd(pn2.z, _mm256_mul_pd(pn1.z, t_cos)), pn1_len) };
+            Vec256d3 b{ _mm256_div_pd(_mm256_sub_pd(pn1.x, _mm256_mul_pd(pn2.x, t_cos)), pn2_len),
+                        _mm256_div_pd(_mm256_sub_pd(pn1.y, _mm256_mul_pd(pn2.y, t_cos)), pn2_len),
+                        _mm256_div_pd(_mm256_sub_pd(pn1.z, _mm256_mul_pd(pn2.z, t_cos)), pn2_len) };
+
+            Vec256d3 t1c2 = sub(term1_pos, ctr2_pos);
+            Vec256d3 t1   = scale(cross(cb, a), grad_fact);
+            Vec256d3 t2   = scale(cross(cb, b), grad_fact);
+            Vec256d3 c1   = scale(sub(cross(t1c2, a), cross(tb2, b)), grad_fact);
+            Vec256d3 c2   = scale(Vec256d3{ _mm256_add_pd(_mm256_add_pd(t1.x, c1.x), t2.x), _mm256_add_pd(_mm256_add_pd(t1.y, c1.y), t2.y),
+                                            _mm256_add_pd(_mm256_add_pd(t1.z, c1.z), t2.z) }, mone);
+
+            store(t1, grad_contribs + (TORSION_TERM_ATOM1 * 3) * num_iactions + i, num_iactions);
+            store(c1, grad_contribs + (TORSION_CTR_ATOM1 * 3) * num_iactions + i, num_iactions);
+            store(c2, grad_contribs + (TORSION_CTR_ATOM2 * 3) * num_iactions + i, num_iactions);
+            store(t2, grad_contribs + (TORSION_TERM_ATOM2 * 3) * num_iactions + i, num_iactions);
+        }
+
+        double lane_sums[NUM_LANES];
+
+        storeLanes(lane_sums_vec, lane_sums);
+        accumTorsionPortable<GRAD>(offsets, params, num_iactions, i, coords, grad_contribs, lane_sums);
+
+        return sumLanes(lane_sums);
+    }
+
+    template <unsigned int EXPO, bool GRAD>
+    __attribute__((target("avx2")))
+    double calcElectrostaticsAVX2(const std::int32_t* offsets, const double* params, std::size_t num_iactions,
+                                  const double* coords, double* grad_contribs)
+    {
+        const __m256d dist_buf = _mm256_set1_pd(0.05);
+        const __m256d mexpo    = _mm256_set1_pd(-double(EXPO));
+
+        __m256d     lane_sums_vec = _mm256_setzero_pd();
+        std::size_t i             = 0;
+
+        for (; i + NUM_LANES <= num_iactions; i += NUM_LANES) {
+            Vec256d3 d = sub(gatherPositions(coords, offsets + PAIR_ATOM1 * num_iactions + i),
+                             gatherPositions(coords, offsets + PAIR_ATOM2 * num_iactions + i));
+
+            __m256d r    = _mm256_sqrt_pd(dot(d, d));
+            __m256d tmp1 = _mm256_add_pd(r, dist_buf);
+            __m256d tmp2 = (EXPO == 1 ? tmp1 : _mm256_mul_pd(tmp1, tmp1));
+            __m256d e_q  = _mm256_div_pd(_mm256_loadu_pd(params + ELEC_CHARGE_FACTOR * num_iactions + i), tmp2);
+
+            lane_sums_vec = _mm256_add_pd(lane_sums_vec, e_q);
+
+            if (GRAD)
+                storePairGradContribs(d, r, _mm256_div_pd(_mm256_mul_pd(mexpo, e_q), tmp1), grad_contribs + i, num_iactions);
+        }
+
+        double lane_sums[NUM_LANES];
+
+        storeLanes(lane_sums_vec, lane_sums);
+        accumElectrostaticPortable<EXPO, GRAD>(offsets, params, num_iactions, i, coords, grad_contribs, lane_sums);
+
+        return sumLanes(lane_sums);
+    }
+
+    template <bool GRAD>
+    __attribute__((target("avx2")))
+    double calcVanDerWaalsAVX2(const std::int32_t* offsets, const double* params, std::size_t num_iactions,
+                               const double* coords, double* grad_contribs)
+    {
+        __m256d     lane_sums_vec = _mm256_setzero_pd();
+        std::size_t i             = 0;
+
+        for (; i + NUM_LANES <= num_iactions; i += NUM_LANES) {
+            Vec256d3 d = sub(gatherPositions(coords, offsets + PAIR_ATOM1 * num_iactions + i),
+                             gatherPositions(coords, offsets + PAIR_ATOM2 * num_iactions + i));
+
+            __m256d r = _mm256_sqrt_pd(dot(d, d));
+
+            __m256d e_IJ   = _mm256_loadu_pd(params + VDW_E_IJ * num_iactions + i);
+            __m256d r_IJ   = _mm256_loadu_pd(params + VDW_R_IJ * num_iactions + i);
+            __m256d r_IJ_7 = _mm256_loadu_pd(params + VDW_R_IJ_7 * num_iactions + i);
+
+            __m256d r_2 = _mm256_mul_pd(r, r);
+            __m256d r_6 = _mm256_mul_pd(_mm256_mul_pd(r_2, r_2), r_2);
+            __m256d r_7 = _mm256_mul_pd(r_6, r);
+
+            __m256d tmp1   = _mm256_add_pd(r, _mm256_mul_pd(_mm256_set1_pd(0.07), r_IJ));
+            __m256d tmp2   = _mm256_add_pd(r_7, _mm256_mul_pd(_mm256_set1_pd(0.12), r_IJ_7));
+            __m256d tmp3   = _mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.07), r_IJ), tmp1);
+            __m256d tmp3_2 = _mm256_mul_pd(tmp3, tmp3);
+            __m256d tmp3_7 = _mm256_mul_pd(_mm256_mul_pd(_mm256_mul_pd(tmp3_2, tmp3_2), tmp3_2), tmp3);
+
+            __m256d e_vdw = _mm256_mul_pd(_mm256_mul_pd(e_IJ, tmp3_7),
+                                          _mm256_sub_pd(_mm256_div_pd(_mm256_mul_pd(_mm256_set1_pd(1.12), r_IJ_7), tmp2), _mm256_set1_pd(2.0)));
+
+            lane_sums_vec = _mm256_add_pd(lane_sums_vec, e_vdw);
+
+            if (!GRAD)
+                continue;
+
+            __m256d tmp1_2 = _mm256_mul_pd(tmp1, tmp1);
+            __m256d tmp1_4 = _mm256_mul_pd(tmp1_2, tmp1_2);
+
+            __m256d poly = _mm256_add_pd(_mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(-22.48094067), r_7), r_7),
+                                                                     _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(19.78322779), r_7), r_IJ_7)),
+                                                       _mm256_mul_pd(_mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(0.8812528743), r_6), r_IJ_7), r_IJ)),
+                                         _mm256_mul_pd(_mm256_mul_pd(_mm256_set1_pd(1.186993667), r_IJ_7), r_IJ_7));
+
+            __m256d denom     = _mm256_mul_pd(_mm256_mul_pd(_mm256_mul_pd(tmp1_4, tmp1_4), tmp2), tmp2);
+            __m256d grad_fact = _mm256_mul_pd(_mm256_div_pd(_mm256_mul_pd(_mm256_sub_pd(_mm256_setzero_pd(), r_IJ_7), e_IJ), denom), poly);
+
+            storePairGradContribs(d, r, grad_fact, grad_contribs + i, num_iactions);
+        }
+
+        double lane_sums[NUM_LANES];
+
+        storeLanes(lane_sums_vec, lane_sums);
+        accumVanDerWaalsPortable<GRAD>(offsets, params, num_iactions, i, coords, grad_contribs, lane_sums);
+
+        return sumLanes(lane_sums);
+    }
+
+#endif // CDPL_FORCEFIELD_MMFF94_KERNEL_X86_DISPATCH
+
+    struct KernelImpl
+    {
+
+        KernelImpl(bool portable)
+        {
+#ifdef CDPL_FORCEFIELD_MMFF94_KERNEL_X86_DISPATCH
+            __builtin_cpu_init();
+
+            if (!portable && __builtin_cpu_supports("avx2")) {
+                angleBendingFuncs[0] = &calcAngleBendingsAVX2<false>;
+                angleBendingFuncs[1] = &calcAngleBendingsAVX2<true>;
+                torsionFuncs[0]  = &calcTorsionsAVX2<false>;
+                torsionFuncs[1]  = &calcTorsionsAVX2<true>;
+                elecFuncs[0][0]  = &calcElectrostaticsPortable<0, false>;
+                elecFuncs[0][1]  = &calcElectrostaticsPortable<0, true>;
+                elecFuncs[1][0]  = &calcElectrostaticsAVX2<1, false>;
+                elecFuncs[1][1]  = &calcElectrostaticsAVX2<1, true>;
+                elecFuncs[2][0]  = &calcElectrostaticsAVX2<2, false>;
+                elecFuncs[2][1]  = &calcElectrostaticsAVX2<2, true>;
+                vanDerWaalsFuncs[0] = &calcVanDerWaalsAVX2<false>;
+                vanDerWaalsFuncs[1] = &calcVanDerWaalsAVX2<true>;
+                name             = "AVX2";
+                return;
+            }
+#endif
+            angleBendingFuncs[0] = &calcAngleBendingsPortable<false>;
+            angleBendingFuncs[1] = &calcAngleBendingsPortable<true>;
+            torsionFuncs[0]  = &calcTorsionsPortable<false>;
+            torsionFuncs[1]  = &calcTorsionsPortable<true>;
+            elecFuncs[0][0]  = &calcElectrostaticsPortable<0, false>;
+            elecFuncs[0][1]  = &calcElectrostaticsPortable<0, true>;
+            elecFuncs[1][0]  = &calcElectrostaticsPortable<1, false>;
+            elecFuncs[1][1]  = &calcElectrostaticsPortable<1, true>;
+            elecFuncs[2][0]  = &calcElectrostaticsPortable<2, false>;
+            elecFuncs[2][1]  = &calcElectrostaticsPortable<2, true>;
+            vanDerWaalsFuncs[0] = &calcVanDerWaalsPortable<false>;
+            vanDerWaalsFuncs[1] = &calcVanDerWaalsPortable<true>;
+            name             = "Portable";
+        }
+
+        KernelFunction angleBendingFuncs[2];
+        KernelFunction torsionFuncs[2];
+        KernelFunction elecFuncs[3][2];
+        KernelFunction vanDerWaalsFuncs[2];
+        const char*    name;
+    };
+
+    const KernelImpl& getKernelImpl(bool portable)
+    {
+        static const KernelImpl dispatched_impl(false);
+        static const KernelImpl portable_impl(true);
+
+        return (portable ? portable_impl : dispatched_impl);
+    }
+
+    void addGradContribs(const std::int32_t* offsets, std::size_t num_iactions, std::size_t num_atoms,
+                         const double* grad_contribs, double* grad)
+    {
+        for (std::size_t k = 0; k < num_atoms; k++, offsets += num_iactions, grad_contribs += 3 * num_iactions)
+            for (std::size_t i = 0; i < num_iactions; i++) {
+                double* atom_grad = grad + offsets[i];
+
+                atom_grad[0] += grad_contribs[i];
+                atom_grad[1] += grad_contribs[num_iactions + i];
+                atom_grad[2] += grad_contribs[2 * num_iactions + i];
+            }
+    }
+
+    void addPairGradContribs(const std::int32_t* offsets, std::size_t num_iactions, const double* grad_contribs, double* grad)
+    {
+        for (std::size_t i = 0; i < num_iactions; i++) {
+            double* atom1_grad = grad + offsets[PAIR_ATOM1 * num_iactions + i];
+            double* atom2_grad = grad + offsets[PAIR_ATOM2 * num_iactions + i];
+
+            double g_x = grad_contribs[i];
+            double g_y = grad_contribs[num_iactions + i];
+            double g_z = grad_contribs[2 * num_iactions + i];
+
+            atom1_grad[0] += g_x;
+            atom1_grad[1] += g_y;
+            atom1_grad[2] += g_z;
+
+            atom2_grad[0] -= g_x;
+            atom2_grad[1] -= g_y;
+            atom2_grad[2] -= g_z;
+        }
+    }
+
+    std::int32_t toCoordsOffset(std::size_t atom_idx)
+    {
+        return std::int32_t(atom_idx * 3);
+    }
+}
+
+
+void ForceField::MMFF94PackedGradientCalculator::PackedInteractionTable::clear()
+{
+    size = 0;
+
+    atomOffsets.clear();
+    params.clear();
+}
+
+
+ForceField::MMFF94PackedGradientCalculator::MMFF94PackedGradientCalculator():
+    initialized(false), numAtoms(0), nonbondedCutoff(0.0), nonbondedSwitchingWidth(0.0), elecDistExponent(0.0), totalEnergy(0.0), bondStretchingEnergy(0.0),
+    angleBendingEnergy(0.0), stretchBendEnergy(0.0), outOfPlaneEnergy(0.0), torsionEnergy(0.0),
+    electrostaticEnergy(0.0), vanDerWaalsEnergy(0.0), interactionTypes(InteractionType::ALL), portableKernels(false)
+{
+    angleBendingTable.clear();
+    torsionTable.clear();
+    electrostaticTable.clear();
+    vanDerWaalsTable.clear();
+}
+
+ForceField::MMFF94PackedGradientCalculator::MMFF94PackedGradientCalculator(const MMFF94InteractionData& ia_data, std::size_t num_atoms):
+    MMFF94PackedGradientCalculator()
+{
+    setup(ia_data, num_atoms);
+}
+
+void ForceField::MMFF94PackedGradientCalculator::setEnabledInteractionTypes(unsigned int types)
+{
+    interactionTypes = types;
+}
+
+unsigned int ForceField::MMFF94PackedGradientCalculator::getEnabledInteractionTypes() const
+{
+    return interactionTypes;
+}
+
+void ForceField::MMFF94PackedGradientCalculator::setup(const MMFF94InteractionData& ia_data, std::size_t num_atoms)
+{
+    numAtoms           = num_atoms;
+    bondStretchingData = ia_data.getBondStretchingInteractions();
+    stretchBendData    = ia_data.getStretchBendInteractions();
+    outOfPlaneData     = ia_data.getOutOfPlaneBendingInteractions();
+
+    // with a nonbonded cutoff, the electrostatic and Van der Waals terms are not packed but evaluated
+    // for the interactions selected by neighbor lists
+
+    nonbondedCutoff         = ia_data.getNonbondedCutoff();
+    nonbondedSwitchingWidth = ia_data.getNonbondedSwitchingWidth();
+
+    elecNeighborList.clear();
+    vdwNeighborList.clear();
+
+    if (nonbondedCutoff > 0.0) {
+        electrostaticData = ia_data.getElectrostaticInteractions();
+        vanDerWaalsData   = ia_data.getVanDerWaalsInteractions();
+
+    } else {
+        electrostaticData.clear();
+        vanDerWaalsData.clear();
+    }
+
+    // angle bending interactions
+
+    const MMFF94AngleBendingInteractionList& ab_iactions = ia_data.getAngleBendingInteractions();
+    std::size_t num_iactions = ab_iactions.getSize();
+
+    angleBendingTable.size = num_iactions;
+    angleBendingTable.atomOffsets.resize(NUM_ANGLE_ATOMS * num_iactions);
+    angleBendingTable.params.resize(NUM_ANGLE_PARAMS * num_iactions);
+
+    for (std::size_t i = 0; i < num_iactions; i++) {
+        const MMFF94AngleBendingInteraction& iaction = ab_iactions[i];
+
+        angleBendingTable.atomOffsets[ANGLE_TERM_ATOM1 * num_iactions + i] = toCoordsOffset(iaction.getTerminalAtom1Index());
+        angleBendingTable.atomOffsets[ANGLE_CTR_ATOM * num_iactions + i]   = toCoordsOffset(iaction.getCenterAtomIndex());
+        angleBendingTable.atomOffsets[ANGLE_TERM_ATOM2 * num_iactions + i] = toCoordsOffset(iaction.getTerminalAtom2Index());
+
+        angleBendingTable.params[ANGLE_FORCE_CONST * num_iactions + i] = iaction.getForceConstant();
+        angleBendingTable.params[ANGLE_REF_ANGLE * num_iactions + i]   = iaction.getReferenceAngle();
+        angleBendingTable.params[ANGLE_LINEAR_FLAG * num_iactions + i] = (iaction.isLinearAngle() ? 1.0 : 0.0);
+    }
+
+    std::size_t max_num_contribs = NUM_ANGLE_ATOMS * 3 * num_iactions;
+
+    // torsion interactions
+
+    const MMFF94TorsionInteractionList& tor_iactions = ia_data.getTorsionInteractions();
+
+    num_iactions = tor_iactions.getSize();
+
+    torsionTable.size = num_iactions;
+    torsionTable.atomOffsets.resize(NUM_TORSION_ATOMS * num_iactions);
+    torsionTable.params.resize(NUM_TORSION_PARAMS * num_iactions);
+
+    for (std::size_t i = 0; i < num_iactions; i++) {
+        const MMFF94TorsionInteraction& iaction = tor_iactions[i];
+
+        torsionTable.atomOffsets[TORSION_TERM_ATOM1 * num_iactions + i] = toCoordsOffset(iaction.getTerminalAtom1Index());
+        torsionTable.atomOffsets[TORSION_CTR_ATOM1 * num_iactions + i]  = toCoordsOffset(iaction.getCenterAtom1Index());
+        torsionTable.atomOffsets[TORSION_CTR_ATOM2 * num_iactions + i]  = toCoordsOffset(iaction.getCenterAtom2Index());
+        torsionTable.atomOffsets[TORSION_TERM_ATOM2 * num_iactions + i] = toCoordsOffset(iaction.getTerminalAtom2Index());
+
+        torsionTable.params[TORSION_PARAM1 * num_iactions + i] = iaction.getTorsionParameter1();
+        torsionTable.params[TORSION_PARAM2 * num_iactions + i] = iaction.getTorsionParameter2();
+        torsionTable.params[TORSION_PARAM3 * num_iactions + i] = iaction.getTorsionParameter3();
+    }
+
+    max_num_contribs = std::max(max_num_contribs, std::size_t(NUM_TORSION_ATOMS * 3 * num_iactions));
+
+    // electrostatic interactions
+
+    const MMFF94ElectrostaticInteractionList& elec_iactions = ia_data.getElectrostaticInteractions();
+
+    num_iactions = (nonbondedCutoff > 0.0 ? 0 : elec_iactions.getSize());
+
+    electrostaticTable.size = num_iactions;
+    electrostaticTable.atomOffsets.resize(NUM_PAIR_ATOMS * num_iactions);
+    electrostaticTable.params.resize(NUM_ELEC_PARAMS * num_iactions);
+
+    elecDistExponent = (num_iactions > 0 ? elec_iactions[0].getDistanceExponent() : 1.0);
+
+    for (std::size_t i = 0; i < num_iactions; i++) {
+        const MMFF94ElectrostaticInteraction& iaction = elec_iactions[i];
+
+        electrostaticTable.atomOffsets[PAIR_ATOM1 * num_iactions + i] = toCoordsOffset(iaction.getAtom1Index());
+        electrostaticTable.atomOffsets[PAIR_ATOM2 * num_iactions + i] = toCoordsOffset(iaction.getAtom2Index());
+
+        electrostaticTable.params[ELEC_CHARGE_FACTOR * num_iactions + i] = iaction.getScalingFactor() * 332.0716 * iaction.getAtom1Charge() *
+                                                                           iaction.getAtom2Charge() / iaction.getDielectricConstant();
+        electrostaticTable.params[ELEC_DIST_EXPONENT * num_iactions + i] = iaction.getDistanceExponent();
+
+        if (iaction.getDistanceExponent() != elecDistExponent)
+            elecDistExponent = 0.0;
+    }
+
+    max_num_contribs = std::max(max_num_contribs, std::size_t(3 * num_iactions));
+
+    // Van der Waals interactions
+
+    const MMFF94VanDerWaalsInteractionList& vdw_iactions = ia_data.getVanDerWaalsInteractions();
+
+    num_iactions = (nonbondedCutoff > 0.0 ? 0 : vdw_iactions.getSize());
+
+    vanDerWaalsTable.size = num_iactions;
+    vanDerWaalsTable.atomOffsets.resize(NUM_PAIR_ATOMS * num_iactions);
+    vanDerWaalsTable.params.resize(NUM_VDW_PARAMS * num_iactions);
+
+    for (std::size_t i = 0; i < num_iactions; i++) {
+        const MMFF94VanDerWaalsInteraction& iaction = vdw_iactions[i];
+
+        vanDerWaalsTable.atomOffsets[PAIR_ATOM1 * num_iactions + i] = toCoordsOffset(iaction.getAtom1Index());
+        vanDerWaalsTable.atomOffsets[PAIR_ATOM2 * num_iactions + i] = toCoordsOffset(iaction.getAtom2Index());
+
+        vanDerWaalsTable.params[VDW_E_IJ * num_iactions + i]   = iaction.getEIJ();
+        vanDerWaalsTable.params[VDW_R_IJ * num_iactions + i]   = iaction.getRIJ();
+        vanDerWaalsTable.params[VDW_R_IJ_7 * num_iactions + i] = iaction.getRIJPow7();
+    }
+
+    max_num_contribs = std::max(max_num_contribs, std::size_t(3 * num_iactions));
+
+    coordsBuffer.resize(num_atoms * 3);
+    gradBuffer.resize(num_atoms * 3);
+    gradContribBuffer.resize(max_num_contribs);
+
+    initialized = true;
+}
+
+const double& ForceField::MMFF94PackedGradientCalculator::getTotalEnergy() const
+{
+    return totalEnergy;
+}
+
+const double& ForceField::MMFF94PackedGradientCalculator::getBondStretchingEnergy() const
+{
+    return bondStretchingEnergy;
+}
+
+const double& ForceField::MMFF94PackedGradientCalculator::getAngleBendingEnergy() const
+{
+    return angleBendingEnergy;
+}
+
+const double& ForceField::MMFF94PackedGradientCalculator::getStretchBendEnergy() const
+{
+    return stretchBendEnergy;
+}
+
+const double& ForceField::MMFF94PackedGradientCalculator::getOutOfPlaneBendingEnergy() const
+{
+    return outOfPlaneEnergy;
+}
+
+const double& ForceField::MMFF94PackedGradientCalculator::getTorsionEnergy() const
+{
+    return torsionEnergy;
+}
+
+const double& ForceField::MMFF94PackedGradientCalculator::getElectrostaticEnergy() const
+{
+    return electrostaticEnergy;
+}
+
+const double& ForceField::MMFF94PackedGradientCalculator::getVanDerWaalsEnergy() const
+{
+    return vanDerWaalsEnergy;
+}
+
+const Util::BitSet& ForceField::MMFF94PackedGradientCalculator::getFixedAtomMask() const
+{
+    return fixedAtomMask;
+}
+
+void ForceField::MMFF94PackedGradientCalculator::setFixedAtomMask(const Util::BitSet& mask)
+{
+    fixedAtomMask = mask;
+}
+
+void ForceField::MMFF94PackedGradientCalculator::resetFixedAtomMask()
+{
+    fixedAtomMask.clear();
+}
+
+void ForceField::MMFF94PackedGradientCalculator::enforcePortableKernels(bool enforce)
+{
+    portableKernels = enforce;
+}
+
+bool ForceField::MMFF94PackedGradientCalculator::portableKernelsEnforced() const
+{
+    return portableKernels;
+}
+
+const char* ForceField::MMFF94PackedGradientCalculator::getKernelImplementationName()
+{
+    return getKernelImpl(false).name;
+}
+
+bool ForceField::MMFF94PackedGradientCalculator::packedInteractionsEnabled() const
+{
+    return (interactionTypes & (InteractionType::ANGLE_BENDING | InteractionType::TORSION |
+                                InteractionType::ELECTROSTATIC | InteractionType::VAN_DER_WAALS));
+}
+
+void ForceField::MMFF94PackedGradientCalculator::calcPackedEnergies()
+{
+    const KernelImpl& impl   = getKernelImpl(portableKernels);
+    const double*     coords = coordsBuffer.data();
+
+    if (interactionTypes & InteractionType::ANGLE_BENDING)
+        angleBendingEnergy = impl.angleBendingFuncs[0](angleBendingTable.atomOffsets.data(), angleBendingTable.params.data(),
+                                                       angleBendingTable.size, coords, 0);
+    else
+        angleBendingEnergy = 0.0;
+
+    if (interactionTypes & InteractionType::TORSION)
+        torsionEnergy = impl.torsionFuncs[0](torsionTable.atomOffsets.data(), torsionTable.params.data(),
+                                             torsionTable.size, coords, 0);
+    else
+        torsionEnergy = 0.0;
+
+    if (interactionTypes & InteractionType::ELECTROSTATIC)
+        electrostaticEnergy = impl.elecFuncs[elecDistExponent == 1.0 ? 1 : elecDistExponent == 2.0 ? 2 : 0][0](
+            electrostaticTable.atomOffsets.data(), electrostaticTable.params.data(), electrostaticTable.size, coords, 0);
+    else
+        electrostaticEnergy = 0.0;
+
+    if (interactionTypes & InteractionType::VAN_DER_WAALS)
+        vanDerWaalsEnergy = impl.vanDerWaalsFuncs[0](vanDerWaalsTable.atomOffsets.data(), vanDerWaalsTable.params.data(),
+                                                     vanDerWaalsTable.size, coords, 0);
+    else
+        vanDerWaalsEnergy = 0.0;
+}
+
+void ForceField::MMFF94PackedGradientCalculator::calcPackedGradient()
+{
+    const KernelImpl& impl     = getKernelImpl(portableKernels);
+    const double*     coords   = coordsBuffer.data();
+    double*           grad     = gradBuffer.data();
+    double*           contribs = gradContribBuffer.data();
+
+    std::fill(gradBuffer.begin(), gradBuffer.end(), 0.0);
+
+    if (interactionTypes & InteractionType::ANGLE_BENDING) {
+        angleBendingEnergy = impl.angleBendingFuncs[1](angleBendingTable.atomOffsets.data(), angleBendingTable.params.data(),
+                                                       angleBendingTable.size, coords, contribs);
+
+        addGradContribs(angleBendingTable.atomOffsets.data(), angleBendingTable.size, NUM_ANGLE_ATOMS, contribs, grad);
+
+    } else
+        angleBendingEnergy = 0.0;
+
+    if (interactionTypes & InteractionType::TORSION) {
+        torsionEnergy = impl.torsionFuncs[1](torsionTable.atomOffsets.data(), torsionTable.params.data(),
+                                             torsionTable.size, coords, contribs);
+
+        addGradContribs(torsionTable.atomOffsets.data(), torsionTable.size, NUM_TORSION_ATOMS, contribs, grad);
+
+    } else
+        torsionEnergy = 0.0;
+
+    if (interactionTypes & InteractionType::ELECTROSTATIC) {
+        electrostaticEnergy = impl.elecFuncs[elecDistExponent == 1.0 ? 1 : elecDistExponent == 2.0 ? 2 : 0][1](
+            electrostaticTable.atomOffsets.data(), electrostaticTable.params.data(), electrostaticTable.size, coords, contribs);
+
+        addPairGradContribs(electrostaticTable.atomOffsets.data(), electrostaticTable.size, contribs, grad);
+
+    } else
+        electrostaticEnergy = 0.0;
+
+    if (interactionTypes & InteractionType::VAN_DER_WAALS) {
+        vanDerWaalsEnergy = impl.vanDerWaalsFuncs[1](vanDerWaalsTable.atomOffsets.data(), vanDerWaalsTable.params.data(),
+                                                     vanDerWaalsTable.size, coords, contribs);
+
+        addPairGradContribs(vanDerWaalsTable.atomOffsets.data(), vanDerWaalsTable.size, contribs, grad);
+
+    } else
+        vanDerWaalsEnergy = 0.0;
+}
+
+void ForceField::MMFF94PackedGradientCalculator::sumTotalEnergy()
+{
+    totalEnergy = bondStretchingEnergy + angleBendingEnergy + stretchBendEnergy + outOfPlaneEnergy +
+                  torsionEnergy + electrostaticEnergy + vanDerWaalsEnergy;
+}
+
+void ForceField::MMFF94PackedGradientCalculator::clearEnergies()
+{
+    totalEnergy          = 0.0;
+    bondStretchingEnergy = 0.0;
+    angleBendingEnergy   = 0.0;
+    stretchBendEnergy    = 0.0;
+    outOfPlaneEnergy     = 0.0;
+    torsionEnergy        = 0.0;
+    electrostaticEnergy  = 0.0;
+    vanDerWaalsEnergy    = 0.0;
+}
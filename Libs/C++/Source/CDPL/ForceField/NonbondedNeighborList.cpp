@@ -0,0 +1,290 @@
+/*
+ * NonbondedNeighborList.cpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "CDPL/ForceField/NonbondedNeighborList.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+    constexpr std::size_t NO_ATOM            = std::numeric_limits<std::size_t>::max();
+    constexpr double      MAX_CELLS_PER_ATOM = 8.0;
+
+    inline std::size_t getCellCoordinate(double pos, double min_pos, double cell_size, std::size_t dim)
+    {
+        return std::min(std::size_t((pos - min_pos) / cell_size), dim - 1);
+    }
+}
+
+
+constexpr double ForceField::NonbondedNeighborList::DEF_SKIN_DISTANCE;
+
+
+bool ForceField::NonbondedNeighborList::PairEntry::operator<(const PairEntry& entry) const
+{
+    if (partner == entry.partner)
+        return (interaction < entry.interaction);
+
+    return (partner < entry.partner);
+}
+
+
+ForceField::NonbondedNeighborList::NonbondedNeighborList():
+    cutoff(0.0), skinDistance(DEF_SKIN_DISTANCE), valid(false), numAtoms(0), numInteractions(0), pairOffsets(1, 0)
+{}
+
+void ForceField::NonbondedNeighborList::setCutoff(double cutoff)
+{
+    this->cutoff = cutoff;
+    valid = false;
+}
+
+double ForceField::NonbondedNeighborList::getCutoff() const
+{
+    return cutoff;
+}
+
+void ForceField::NonbondedNeighborList::setSkinDistance(double skin)
+{
+    skinDistance = skin;
+    valid = false;
+}
+
+double ForceField::NonbondedNeighborList::getSkinDistance() const
+{
+    return skinDistance;
+}
+
+void ForceField::NonbondedNeighborList::clear()
+{
+    valid           = false;
+    numAtoms        = 0;
+    numInteractions = 0;
+
+    pairOffsets.assign(1, 0);
+    pairEntries.clear();
+    interactionIndices.clear();
+}
+
+std::size_t ForceField::NonbondedNeighborList::getNumInteractions() const
+{
+    return numInteractions;
+}
+
+const ForceField::NonbondedNeighborList::IndexArray& ForceField::NonbondedNeighborList::getInteractionIndices() const
+{
+    return interactionIndices;
+}
+
+void ForceField::NonbondedNeighborList::startPairCounting()
+{
+    clear();
+}
+
+void ForceField::NonbondedNeighborList::countPair(std::size_t atom1_idx, std::size_t atom2_idx)
+{
+    std::size_t max_idx = std::max(atom1_idx, atom2_idx);
+
+    if (max_idx >= numAtoms) {
+        numAtoms = max_idx + 1;
+        pairOffsets.resize(numAtoms + 1, 0);
+    }
+
+    pairOffsets[std::min(atom1_idx, atom2_idx) + 1]++;
+    numInteractions++;
+}
+
+void ForceField::NonbondedNeighborList::initPairTable()
+{
+    for (std::size_t i = 1; i <= numAtoms; i++)
+        pairOffsets[i] += pairOffsets[i - 1];
+
+    pairEntries.resize(numInteractions);
+}
+
+void ForceField::NonbondedNeighborList::insertPair(std::size_t atom1_idx, std::size_t atom2_idx, std::size_t ia_idx)
+{
+    PairEntry& entry = pairEntries[pairOffsets[std::min(atom1_idx, atom2_idx)]++];
+
+    entry.partner     = std::max(atom1_idx, atom2_idx);
+    entry.interaction = ia_idx;
+}
+
+void ForceField::NonbondedNeighborList::finishPairTable()
+{
+    // insertPair() advanced each row offset to the end of the row
+
+    for (std::size_t i = numAtoms; i > 0; i--)
+        pairOffsets[i] = pairOffsets[i - 1];
+
+    pairOffsets[0] = 0;
+
+    for (std::size_t i = 0; i < numAtoms; i++)
+        std::sort(pairEntries.begin() + pairOffsets[i], pairEntries.begin() + pairOffsets[i + 1]);
+
+    atomPositions.resize(numAtoms * 3);
+    refAtomPositions.resize(numAtoms * 3);
+    cellLinks.resize(numAtoms);
+}
+
+bool ForceField::NonbondedNeighborList::rebuildRequired() const
+{
+    if (!valid)
+        return true;
+
+    double max_disp = skinDistance * 0.5;
+    double max_disp_2 = max_disp * max_disp;
+
+    for (std::size_t i = 0, num_coords = numAtoms * 3; i < num_coords; i += 3) {
+        double dx = atomPositions[i] - refAtomPositions[i];
+        double dy = atomPositions[i + 1] - refAtomPositions[i + 1];
+        double dz = atomPositions[i + 2] - refAtomPositions[i + 2];
+
+        if ((dx * dx + dy * dy + dz * dz) > max_disp_2)
+            return true;
+    }
+
+    return false;
+}
+
+void ForceField::NonbondedNeighborList::rebuild()
+{
+    valid = true;
+
+    refAtomPositions = atomPositions;
+    interactionIndices.clear();
+
+    double list_cutoff = std::max(cutoff, 0.0) + std::max(skinDistance, 0.0);
+
+    if (numInteractions == 0 || list_cutoff <= 0.0)
+        return;
+
+    double bbox_min[3] = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max() };
+    double bbox_max[3] = { -std::numeric_limits<double>::max(), -std::numeric_limits<double>::max(), -std::numeric_limits<double>::max() };
+
+    for (std::size_t i = 0, num_coords = numAtoms * 3; i < num_coords; i += 3) {
+        for (std::size_t j = 0; j < 3; j++) {
+            bbox_min[j] = std::min(bbox_min[j], atomPositions[i + j]);
+            bbox_max[j] = std::max(bbox_max[j], atomPositions[i + j]);
+        }
+    }
+
+    for (std::size_t i = 0; i < 3; i++) {
+        if (std::isfinite(bbox_max[i] - bbox_min[i]))
+            continue;
+
+        // degenerate coordinates - fall back to the full interaction list
+
+        interactionIndices.resize(numInteractions);
+
+        for (std::size_t j = 0; j < numInteractions; j++)
+            interactionIndices[j] = j;
+
+        return;
+    }
+
+    double cell_size = list_cutoff;
+    std::size_t dims[3];
+
+    while (true) {
+        double num_cells = 1.0;
+
+        for (std::size_t i = 0; i < 3; i++)
+            num_cells *= std::floor((bbox_max[i] - bbox_min[i]) / cell_size) + 1.0;
+
+        if (num_cells <= MAX_CELLS_PER_ATOM * numAtoms)
+            break;
+
+        cell_size *= 2.0;
+    }
+
+    for (std::size_t i = 0; i < 3; i++)
+        dims[i] = std::size_t((bbox_max[i] - bbox_min[i]) / cell_size) + 1;
+
+    cellHeads.assign(dims[0] * dims[1] * dims[2], NO_ATOM);
+
+    for (std::size_t i = 0; i < numAtoms; i++) {
+        const double* pos = &atomPositions[i * 3];
+        std::size_t cell_idx = (getCellCoordinate(pos[0], bbox_min[0], cell_size, dims[0]) * dims[1] +
+                                getCellCoordinate(pos[1], bbox_min[1], cell_size, dims[1])) * dims[2] +
+                                getCellCoordinate(pos[2], bbox_min[2], cell_size, dims[2]);
+
+        cellLinks[i]        = cellHeads[cell_idx];
+        cellHeads[cell_idx] = i;
+    }
+
+    double list_cutoff_2 = list_cutoff * list_cutoff;
+
+    for (std::size_t i = 0; i < numAtoms; i++) {
+        if (pairOffsets[i] == pairOffsets[i + 1])
+            continue;
+
+        const double* pos1 = &atomPositions[i * 3];
+        std::size_t cell_coords[3];
+
+        for (std::size_t j = 0; j < 3; j++)
+            cell_coords[j] = getCellCoordinate(pos1[j], bbox_min[j], cell_size, dims[j]);
+
+        for (std::size_t x = (cell_coords[0] > 0 ? cell_coords[0] - 1 : 0), x_end = std::min(cell_coords[0] + 2, dims[0]); x < x_end; x++) {
+            for (std::size_t y = (cell_coords[1] > 0 ? cell_coords[1] - 1 : 0), y_end = std::min(cell_coords[1] + 2, dims[1]); y < y_end; y++) {
+                for (std::size_t z = (cell_coords[2] > 0 ? cell_coords[2] - 1 : 0), z_end = std::min(cell_coords[2] + 2, dims[2]); z < z_end; z++) {
+                    for (std::size_t j = cellHeads[(x * dims[1] + y) * dims[2] + z]; j != NO_ATOM; j = cellLinks[j]) {
+                        if (j <= i)
+                            continue;
+
+                        const double* pos2 = &atomPositions[j * 3];
+                        double dx = pos2[0] - pos1[0];
+                        double dy = pos2[1] - pos1[1];
+                        double dz = pos2[2] - pos1[2];
+
+                        if ((dx * dx + dy * dy + dz * dz) > list_cutoff_2)
+                            continue;
+
+                        addNeighborInteractions(i, j);
+                    }
+                }
+            }
+        }
+    }
+
+    std::sort(interactionIndices.begin(), interactionIndices.end());
+}
+
+void ForceField::NonbondedNeighborList::addNeighborInteractions(std::size_t atom1_idx, std::size_t atom2_idx)
+{
+    PairEntry key = { atom2_idx, 0 };
+
+    for (PairEntryArray::const_iterator it = std::lower_bound(pairEntries.begin() + pairOffsets[atom1_idx], pairEntries.begin() + pairOffsets[atom1_idx + 1], key),
+             end = pairEntries.begin() + pairOffsets[atom1_idx + 1]; it != end && it->partner == atom2_idx; ++it)
+        interactionIndices.push_back(it->interaction);
+}
@@ -0,0 +1,135 @@
+/* 
+ * MMFF94PackedEnergyCalculatorTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+
+#include <cstddef>
+#include <cmath>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/ForceField/MMFF94InteractionData.hpp"
+#include "CDPL/ForceField/MMFF94InteractionParameterizer.hpp"
+#include "CDPL/ForceField/MMFF94EnergyCalculator.hpp"
+#include "CDPL/ForceField/MMFF94PackedEnergyCalculator.hpp"
+#include "CDPL/ForceField/MMFF94PackedGradientCalculator.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Chem/Entity3DContainerFunctions.hpp"
+
+#include "MMFF94TestData.hpp"
+
+
+BOOST_AUTO_TEST_CASE(MMFF94PackedEnergyCalculatorTest)
+{
+    const static double E_DELTA_MAX = 0.0000001;
+
+    using namespace CDPL;
+    using namespace Testing;
+
+    ForceField::MMFF94InteractionParameterizer parameterizer;
+    ForceField::MMFF94InteractionData ia_data;
+    ForceField::MMFF94EnergyCalculator<double> e_calc;
+    ForceField::MMFF94PackedEnergyCalculator pkd_calc;
+    ForceField::MMFF94PackedEnergyCalculator port_calc;
+    ForceField::MMFF94PackedGradientCalculator pkd_gr_calc;
+    Math::Vector3DArray coords;
+    Math::Vector3DArray grad;
+
+    BOOST_CHECK(pkd_calc(coords) == 0.0);
+
+    port_calc.enforcePortableKernels(true);
+
+    BOOST_CHECK(port_calc.portableKernelsEnforced());
+    BOOST_CHECK(!pkd_calc.portableKernelsEnforced());
+
+    for (bool stat = false; !stat; stat = true) {
+        const MMFF94TestData::MoleculeList& mols = (stat ? MMFF94TestData::STAT_TEST_MOLECULES : MMFF94TestData::DYN_TEST_MOLECULES);
+
+        if (stat)
+            parameterizer.setParameterSet(ForceField::MMFF94ParameterSet::STATIC);
+        else
+            parameterizer.setParameterSet(ForceField::MMFF94ParameterSet::DYNAMIC);
+
+        for (std::size_t mol_idx = 0; mol_idx < mols.size(); mol_idx++) {
+            const Chem::Molecule& mol = *mols[mol_idx];
+    
+            coords.clear();
+            get3DCoordinates(mol, coords);
+
+            grad.resize(coords.getSize());
+
+            parameterizer.parameterize(mol, ia_data);
+            e_calc.setup(ia_data);
+            pkd_calc.setup(ia_data, mol.getNumAtoms());
+            port_calc.setup(ia_data, mol.getNumAtoms());
+            pkd_gr_calc.setup(ia_data, mol.getNumAtoms());
+
+            e_calc(coords);
+            pkd_calc(coords);
+
+            BOOST_CHECK_MESSAGE(std::abs(pkd_calc.getTotalEnergy() - e_calc.getTotalEnergy()) <= E_DELTA_MAX, 
+                                "Total energy mismatch for molecule #" << mol_idx << " (" << getName(mol) <<
+                                "): packed calculator energy " << pkd_calc.getTotalEnergy() << " != " << e_calc.getTotalEnergy());
+
+            BOOST_CHECK(pkd_calc.getBondStretchingEnergy() == e_calc.getBondStretchingEnergy());
+            BOOST_CHECK(pkd_calc.getStretchBendEnergy() == e_calc.getStretchBendEnergy());
+            BOOST_CHECK(pkd_calc.getOutOfPlaneBendingEnergy() == e_calc.getOutOfPlaneBendingEnergy());
+            BOOST_CHECK(std::abs(pkd_calc.getAngleBendingEnergy() - e_calc.getAngleBendingEnergy()) <= E_DELTA_MAX);
+            BOOST_CHECK(std::abs(pkd_calc.getTorsionEnergy() - e_calc.getTorsionEnergy()) <= E_DELTA_MAX);
+            BOOST_CHECK(std::abs(pkd_calc.getVanDerWaalsEnergy() - e_calc.getVanDerWaalsEnergy()) <= E_DELTA_MAX);
+            BOOST_CHECK(std::abs(pkd_calc.getElectrostaticEnergy() - e_calc.getElectrostaticEnergy()) <= E_DELTA_MAX);
+
+            // the energies must be exactly the same as the ones calculated by the portable kernels
+
+            BOOST_CHECK_MESSAGE(port_calc(coords) == pkd_calc.getTotalEnergy(),
+                                "Total energy mismatch for molecule #" << mol_idx << " (" << getName(mol) <<
+                                "): " << pkd_calc.getTotalEnergy() << " != " << port_calc.getTotalEnergy() << " (portable kernels)");
+
+            // the packed kernel energies must be exactly the same as the ones calculated by the packed gradient calculator
+            // (the remaining bonded terms are calculated by the generic gradient functions and thus may differ slightly)
+
+            BOOST_CHECK(std::abs(pkd_gr_calc(coords, grad) - pkd_calc.getTotalEnergy()) <= E_DELTA_MAX);
+            BOOST_CHECK(pkd_gr_calc.getAngleBendingEnergy() == pkd_calc.getAngleBendingEnergy());
+            BOOST_CHECK(pkd_gr_calc.getTorsionEnergy() == pkd_calc.getTorsionEnergy());
+            BOOST_CHECK(pkd_gr_calc.getVanDerWaalsEnergy() == pkd_calc.getVanDerWaalsEnergy());
+            BOOST_CHECK(pkd_gr_calc.getElectrostaticEnergy() == pkd_calc.getElectrostaticEnergy());
+
+            // only the enabled interaction types must contribute
+
+            e_calc.setEnabledInteractionTypes(ForceField::InteractionType::ANGLE_BENDING | ForceField::InteractionType::ELECTROSTATIC);
+            pkd_calc.setEnabledInteractionTypes(ForceField::InteractionType::ANGLE_BENDING | ForceField::InteractionType::ELECTROSTATIC);
+
+            BOOST_CHECK(pkd_calc.getEnabledInteractionTypes() == (ForceField::InteractionType::ANGLE_BENDING | ForceField::InteractionType::ELECTROSTATIC));
+
+            e_calc(coords);
+            pkd_calc(coords);
+
+            BOOST_CHECK(pkd_calc.getTorsionEnergy() == 0.0);
+            BOOST_CHECK(pkd_calc.getVanDerWaalsEnergy() == 0.0);
+            BOOST_CHECK(std::abs(pkd_calc.getTotalEnergy() - e_calc.getTotalEnergy()) <= E_DELTA_MAX);
+
+            e_calc.setEnabledInteractionTypes(ForceField::InteractionType::ALL);
+            pkd_calc.setEnabledInteractionTypes(ForceField::InteractionType::ALL);
+        }
+    }
+}
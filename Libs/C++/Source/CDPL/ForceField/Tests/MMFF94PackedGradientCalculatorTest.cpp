@@ -0,0 +1,232 @@
+/* 
+ * MMFF94PackedGradientCalculatorTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+
+#include <cstddef>
+#include <cmath>
+#include <string>
+#include <algorithm>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/ForceField/MMFF94InteractionData.hpp"
+#include "CDPL/ForceField/MMFF94InteractionParameterizer.hpp"
+#include "CDPL/ForceField/MMFF94GradientCalculator.hpp"
+#include "CDPL/ForceField/MMFF94PackedGradientCalculator.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Chem/Entity3DContainerFunctions.hpp"
+
+#include "MMFF94TestData.hpp"
+
+
+BOOST_AUTO_TEST_CASE(MMFF94PackedGradientCalculatorTest)
+{
+    const static double E_DELTA_MAX = 0.0000001;
+    const static double GRAD_DELTA_MAX = 0.000001;
+
+    using namespace CDPL;
+    using namespace Testing;
+
+    ForceField::MMFF94InteractionParameterizer parameterizer;
+    ForceField::MMFF94InteractionData ia_data;
+    ForceField::MMFF94GradientCalculator<double> gr_calc;
+    ForceField::MMFF94PackedGradientCalculator pkd_calc;
+    Math::Vector3DArray coords;
+    Math::Vector3DArray grad;
+    Math::Vector3DArray pkd_grad;
+
+    BOOST_TEST_MESSAGE("Kernel implementation: " << ForceField::MMFF94PackedGradientCalculator::getKernelImplementationName());
+
+    BOOST_CHECK(pkd_calc(coords) == 0.0);
+
+    for (bool stat = false; !stat; stat = true) {
+        const MMFF94TestData::MoleculeList& mols = (stat ? MMFF94TestData::STAT_TEST_MOLECULES : MMFF94TestData::DYN_TEST_MOLECULES);
+
+        if (stat)
+            parameterizer.setParameterSet(ForceField::MMFF94ParameterSet::STATIC);
+        else
+            parameterizer.setParameterSet(ForceField::MMFF94ParameterSet::DYNAMIC);
+
+        for (std::size_t mol_idx = 0; mol_idx < mols.size(); mol_idx++) {
+            const Chem::Molecule& mol = *mols[mol_idx];
+    
+            coords.clear();
+            get3DCoordinates(mol, coords);
+
+            grad.resize(coords.getSize());
+            pkd_grad.resize(coords.getSize());
+    
+            parameterizer.parameterize(mol, ia_data);
+            gr_calc.setup(ia_data, mol.getNumAtoms());
+            pkd_calc.setup(ia_data, mol.getNumAtoms());
+
+            gr_calc(coords, grad);
+            pkd_calc(coords, pkd_grad);
+
+            BOOST_CHECK_MESSAGE(std::abs(pkd_calc.getTotalEnergy() - gr_calc.getTotalEnergy()) <= E_DELTA_MAX, 
+                                "Total energy mismatch for molecule #" << mol_idx << " (" << getName(mol) <<
+                                "): packed calculator energy " << pkd_calc.getTotalEnergy() << " != " << gr_calc.getTotalEnergy());
+
+            BOOST_CHECK(pkd_calc.getBondStretchingEnergy() == gr_calc.getBondStretchingEnergy());
+            BOOST_CHECK(pkd_calc.getStretchBendEnergy() == gr_calc.getStretchBendEnergy());
+            BOOST_CHECK(pkd_calc.getOutOfPlaneBendingEnergy() == gr_calc.getOutOfPlaneBendingEnergy());
+
+            BOOST_CHECK_MESSAGE(std::abs(pkd_calc.getAngleBendingEnergy() - gr_calc.getAngleBendingEnergy()) <= E_DELTA_MAX, 
+                                "Total angle bending energy mismatch for molecule #" << mol_idx << " (" << getName(mol) <<
+                                "): packed calculator energy " << pkd_calc.getAngleBendingEnergy() << " != " << gr_calc.getAngleBendingEnergy());
+
+            BOOST_CHECK_MESSAGE(std::abs(pkd_calc.getTorsionEnergy() - gr_calc.getTorsionEnergy()) <= E_DELTA_MAX, 
+                                "Total torsion energy mismatch for molecule #" << mol_idx << " (" << getName(mol) <<
+                                "): packed calculator energy " << pkd_calc.getTorsionEnergy() << " != " << gr_calc.getTorsionEnergy());
+        
+            BOOST_CHECK_MESSAGE(std::abs(pkd_calc.getVanDerWaalsEnergy() - gr_calc.getVanDerWaalsEnergy()) <= E_DELTA_MAX, 
+                                "Total van der Waals energy mismatch for molecule #" << mol_idx << " (" << getName(mol) <<
+                                "): packed calculator energy " << pkd_calc.getVanDerWaalsEnergy() << " != " << gr_calc.getVanDerWaalsEnergy());
+    
+            BOOST_CHECK_MESSAGE(std::abs(pkd_calc.getElectrostaticEnergy() - gr_calc.getElectrostaticEnergy()) <= E_DELTA_MAX, 
+                                "Total electrostatic energy mismatch for molecule #" << mol_idx << " (" << getName(mol) <<
+                                "): packed calculator energy " << pkd_calc.getElectrostaticEnergy() << " != " << gr_calc.getElectrostaticEnergy());
+
+            double max_diff = 0.0;
+
+            for (std::size_t i = 0; i < coords.getSize(); i++)
+                max_diff = std::max(max_diff, normInf(grad[i] - pkd_grad[i]));
+
+            BOOST_CHECK_MESSAGE((max_diff <= GRAD_DELTA_MAX), 
+                                "Gradient deviation too large for molecule #" << mol_idx << " (" << getName(mol) <<
+                                "): max. packed/generic grad. element deviation of " << max_diff << " > " << GRAD_DELTA_MAX);
+
+            double total_energy = pkd_calc.getTotalEnergy();
+
+            BOOST_CHECK(std::abs(pkd_calc(coords) - total_energy) <= E_DELTA_MAX);
+
+            // only the enabled interaction types and non-fixed atoms must contribute
+
+            Util::BitSet fixed_atoms(coords.getSize());
+
+            fixed_atoms.set(0);
+
+            gr_calc.setEnabledInteractionTypes(ForceField::InteractionType::TORSION | ForceField::InteractionType::VAN_DER_WAALS);
+            pkd_calc.setEnabledInteractionTypes(ForceField::InteractionType::TORSION | ForceField::InteractionType::VAN_DER_WAALS);
+            gr_calc.setFixedAtomMask(fixed_atoms);
+            pkd_calc.setFixedAtomMask(fixed_atoms);
+
+            gr_calc(coords, grad);
+            pkd_calc(coords, pkd_grad);
+
+            BOOST_CHECK(pkd_calc.getAngleBendingEnergy() == 0.0);
+            BOOST_CHECK(pkd_calc.getElectrostaticEnergy() == 0.0);
+            BOOST_CHECK(std::abs(pkd_calc.getTotalEnergy() - gr_calc.getTotalEnergy()) <= E_DELTA_MAX);
+            BOOST_CHECK(normInf(pkd_grad[0]) == 0.0);
+
+            max_diff = 0.0;
+
+            for (std::size_t i = 0; i < coords.getSize(); i++)
+                max_diff = std::max(max_diff, normInf(grad[i] - pkd_grad[i]));
+
+            BOOST_CHECK(max_diff <= GRAD_DELTA_MAX);
+
+            gr_calc.setEnabledInteractionTypes(ForceField::InteractionType::ALL);
+            pkd_calc.setEnabledInteractionTypes(ForceField::InteractionType::ALL);
+            gr_calc.resetFixedAtomMask();
+            pkd_calc.resetFixedAtomMask();
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(MMFF94PackedGradientCalculatorKernelTest)
+{
+    using namespace CDPL;
+    using namespace Testing;
+
+    ForceField::MMFF94InteractionParameterizer parameterizer;
+    ForceField::MMFF94InteractionData ia_data;
+    ForceField::MMFF94PackedGradientCalculator disp_calc;
+    ForceField::MMFF94PackedGradientCalculator port_calc;
+    Math::Vector3DArray coords;
+    Math::Vector3DArray disp_grad;
+    Math::Vector3DArray port_grad;
+
+    BOOST_CHECK(!disp_calc.portableKernelsEnforced());
+
+    port_calc.enforcePortableKernels(true);
+
+    BOOST_CHECK(port_calc.portableKernelsEnforced());
+
+    BOOST_TEST_MESSAGE("Comparing kernel implementation " << ForceField::MMFF94PackedGradientCalculator::getKernelImplementationName() <<
+                       " against the portable kernels");
+
+    // the selected kernels must produce exactly the same results as the portable ones
+
+    for (bool stat = false; !stat; stat = true) {
+        const MMFF94TestData::MoleculeList& mols = (stat ? MMFF94TestData::STAT_TEST_MOLECULES : MMFF94TestData::DYN_TEST_MOLECULES);
+
+        if (stat)
+            parameterizer.setParameterSet(ForceField::MMFF94ParameterSet::STATIC);
+        else
+            parameterizer.setParameterSet(ForceField::MMFF94ParameterSet::DYNAMIC);
+
+        for (std::size_t mol_idx = 0; mol_idx < mols.size(); mol_idx++) {
+            const Chem::Molecule& mol = *mols[mol_idx];
+
+            coords.clear();
+            get3DCoordinates(mol, coords);
+
+            disp_grad.resize(coords.getSize());
+            port_grad.resize(coords.getSize());
+
+            parameterizer.parameterize(mol, ia_data);
+
+            port_calc.setup(ia_data, mol.getNumAtoms());
+            disp_calc.setup(ia_data, mol.getNumAtoms());
+
+            double disp_energy = disp_calc(coords);
+            double port_energy = port_calc(coords);
+
+            BOOST_CHECK_MESSAGE(disp_energy == port_energy,
+                                "Total energy mismatch for molecule #" << mol_idx << " (" << getName(mol) <<
+                                "): " << disp_energy << " != " << port_energy);
+
+            disp_calc(coords, disp_grad);
+            port_calc(coords, port_grad);
+
+            BOOST_CHECK(disp_calc.getTotalEnergy() == port_calc.getTotalEnergy());
+            BOOST_CHECK(disp_calc.getAngleBendingEnergy() == port_calc.getAngleBendingEnergy());
+            BOOST_CHECK(disp_calc.getTorsionEnergy() == port_calc.getTorsionEnergy());
+            BOOST_CHECK(disp_calc.getElectrostaticEnergy() == port_calc.getElectrostaticEnergy());
+            BOOST_CHECK(disp_calc.getVanDerWaalsEnergy() == port_calc.getVanDerWaalsEnergy());
+
+            std::size_t num_diffs = 0;
+
+            for (std::size_t i = 0; i < coords.getSize(); i++)
+                for (std::size_t j = 0; j < 3; j++)
+                    if (disp_grad[i][j] != port_grad[i][j])
+                        num_diffs++;
+
+            BOOST_CHECK_MESSAGE(num_diffs == 0,
+                                "Gradient mismatch for molecule #" << mol_idx << " (" << getName(mol) <<
+                                "): " << num_diffs << " differing grad. elements");
+        }
+    }
+}
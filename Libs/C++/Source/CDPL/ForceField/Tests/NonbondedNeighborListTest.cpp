@@ -0,0 +1,251 @@
+/*
+ * NonbondedNeighborListTest.cpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/ForceField/NonbondedNeighborList.hpp"
+#include "CDPL/ForceField/MMFF94InteractionData.hpp"
+#include "CDPL/ForceField/MMFF94InteractionParameterizer.hpp"
+#include "CDPL/ForceField/MMFF94EnergyCalculator.hpp"
+#include "CDPL/ForceField/MMFF94GradientCalculator.hpp"
+#include "CDPL/ForceField/MMFF94PackedGradientCalculator.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Chem/Entity3DContainerFunctions.hpp"
+
+#include "MMFF94TestData.hpp"
+
+
+BOOST_AUTO_TEST_CASE(NonbondedNeighborListTest)
+{
+    using namespace CDPL;
+    using namespace Testing;
+
+    const static double CUTOFF = 4.0;
+
+    ForceField::MMFF94InteractionParameterizer parameterizer;
+    ForceField::MMFF94InteractionData ia_data;
+    ForceField::NonbondedNeighborList nbr_list;
+    ForceField::NonbondedNeighborList::IndexArray ref_indices;
+    Math::Vector3DArray coords;
+
+    BOOST_CHECK(nbr_list.getNumInteractions() == 0);
+    BOOST_CHECK(nbr_list.getInteractionIndices().empty());
+    BOOST_CHECK(nbr_list.getSkinDistance() == ForceField::NonbondedNeighborList::DEF_SKIN_DISTANCE);
+
+    nbr_list.setCutoff(CUTOFF);
+
+    BOOST_CHECK(nbr_list.getCutoff() == CUTOFF);
+
+    const MMFF94TestData::MoleculeList& mols = MMFF94TestData::DYN_TEST_MOLECULES;
+
+    for (std::size_t mol_idx = 0; mol_idx < mols.size(); mol_idx++) {
+        const Chem::Molecule& mol = *mols[mol_idx];
+
+        coords.clear();
+        get3DCoordinates(mol, coords);
+
+        parameterizer.parameterize(mol, ia_data);
+
+        const ForceField::MMFF94VanDerWaalsInteractionList& ia_list = ia_data.getVanDerWaalsInteractions();
+
+        nbr_list.setup(ia_list.getElementsBegin(), ia_list.getElementsEnd());
+
+        BOOST_CHECK(nbr_list.getNumInteractions() == ia_list.getSize());
+        BOOST_CHECK(nbr_list.update(coords));
+        BOOST_CHECK(!nbr_list.update(coords));
+
+        // the list must contain exactly the interactions within cutoff + skin distance
+
+        double list_cutoff = CUTOFF + nbr_list.getSkinDistance();
+
+        ref_indices.clear();
+
+        for (std::size_t i = 0; i < ia_list.getSize(); i++) {
+            const ForceField::MMFF94VanDerWaalsInteraction& iaction = ia_list[i];
+
+            if (length(coords[iaction.getAtom1Index()] - coords[iaction.getAtom2Index()]) <= list_cutoff)
+                ref_indices.push_back(i);
+        }
+
+        BOOST_CHECK_MESSAGE(nbr_list.getInteractionIndices() == ref_indices,
+                            "Neighbor list mismatch for molecule #" << mol_idx << " (" << getName(mol) <<
+                            "): " << nbr_list.getInteractionIndices().size() << " != " << ref_indices.size() << " selected interactions");
+
+        // small displacements must not trigger a rebuild, larger ones must
+
+        if (ia_list.isEmpty())
+            continue;
+
+        std::size_t atom_idx = ia_list[0].getAtom1Index();
+
+        coords[atom_idx][0] += nbr_list.getSkinDistance() * 0.25;
+
+        BOOST_CHECK(!nbr_list.update(coords));
+
+        coords[atom_idx][0] += nbr_list.getSkinDistance() * 0.5;
+
+        BOOST_CHECK(nbr_list.update(coords));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(MMFF94NonbondedCutoffTest)
+{
+    using namespace CDPL;
+    using namespace Testing;
+
+    const static double E_DELTA_MAX = 0.0000001;
+    const static double GRAD_DELTA_MAX = 0.000001;
+    const static double NUM_GRAD_DELTA_MAX = 0.0001;
+    const static double NUM_GRAD_STEP = 0.00001;
+    const static std::size_t MAX_NUM_GRAD_MOLS = 20;
+
+    ForceField::MMFF94InteractionParameterizer parameterizer;
+    ForceField::MMFF94InteractionData ia_data;
+    ForceField::MMFF94EnergyCalculator<double> e_calc;
+    ForceField::MMFF94GradientCalculator<double> gr_calc;
+    ForceField::MMFF94PackedGradientCalculator pkd_calc;
+    Math::Vector3DArray coords;
+    Math::Vector3DArray grad;
+    Math::Vector3DArray pkd_grad;
+
+    BOOST_CHECK(ia_data.getNonbondedCutoff() == ForceField::MMFF94InteractionData::NO_NONBONDED_CUTOFF);
+    BOOST_CHECK(parameterizer.getNonbondedCutoff() == ForceField::MMFF94InteractionData::NO_NONBONDED_CUTOFF);
+    BOOST_CHECK(parameterizer.getNonbondedSwitchingWidth() == ForceField::MMFF94InteractionData::DEF_NONBONDED_SWITCHING_WIDTH);
+
+    const MMFF94TestData::MoleculeList& mols = MMFF94TestData::DYN_TEST_MOLECULES;
+
+    for (std::size_t mol_idx = 0; mol_idx < mols.size(); mol_idx++) {
+        const Chem::Molecule& mol = *mols[mol_idx];
+
+        coords.clear();
+        get3DCoordinates(mol, coords);
+
+        grad.resize(coords.getSize());
+        pkd_grad.resize(coords.getSize());
+
+        // a cutoff beyond all atom distances must reproduce the full nonbonded energies
+
+        parameterizer.setNonbondedCutoff(ForceField::MMFF94InteractionData::NO_NONBONDED_CUTOFF);
+        parameterizer.parameterize(mol, ia_data);
+        e_calc.setup(ia_data);
+
+        e_calc(coords);
+
+        double ref_elec_energy = e_calc.getElectrostaticEnergy();
+        double ref_vdw_energy = e_calc.getVanDerWaalsEnergy();
+
+        parameterizer.setNonbondedCutoff(1000.0);
+        parameterizer.parameterize(mol, ia_data);
+
+        BOOST_CHECK(ia_data.getNonbondedCutoff() == 1000.0);
+
+        e_calc.setup(ia_data);
+        e_calc(coords);
+
+        BOOST_CHECK_MESSAGE(std::abs(e_calc.getElectrostaticEnergy() - ref_elec_energy) <= E_DELTA_MAX,
+                            "Electrostatic energy mismatch for molecule #" << mol_idx << " (" << getName(mol) <<
+                            "): cutoff energy " << e_calc.getElectrostaticEnergy() << " != " << ref_elec_energy);
+        BOOST_CHECK_MESSAGE(std::abs(e_calc.getVanDerWaalsEnergy() - ref_vdw_energy) <= E_DELTA_MAX,
+                            "Van der Waals energy mismatch for molecule #" << mol_idx << " (" << getName(mol) <<
+                            "): cutoff energy " << e_calc.getVanDerWaalsEnergy() << " != " << ref_vdw_energy);
+
+        // a short cutoff: energy/gradient calculators must agree with each other
+
+        parameterizer.setNonbondedCutoff(4.0);
+        parameterizer.setNonbondedSwitchingWidth(1.5);
+        parameterizer.parameterize(mol, ia_data);
+
+        e_calc.setup(ia_data);
+        gr_calc.setup(ia_data, mol.getNumAtoms());
+        pkd_calc.setup(ia_data, mol.getNumAtoms());
+
+        e_calc(coords);
+        gr_calc(coords, grad);
+        pkd_calc(coords, pkd_grad);
+
+        BOOST_CHECK(std::abs(gr_calc.getTotalEnergy() - e_calc.getTotalEnergy()) <= E_DELTA_MAX);
+        BOOST_CHECK(std::abs(pkd_calc.getTotalEnergy() - e_calc.getTotalEnergy()) <= E_DELTA_MAX);
+        BOOST_CHECK(std::abs(gr_calc.getElectrostaticEnergy() - e_calc.getElectrostaticEnergy()) <= E_DELTA_MAX);
+        BOOST_CHECK(std::abs(pkd_calc.getVanDerWaalsEnergy() - e_calc.getVanDerWaalsEnergy()) <= E_DELTA_MAX);
+
+        double max_diff = 0.0;
+
+        for (std::size_t i = 0; i < coords.getSize(); i++)
+            max_diff = std::max(max_diff, normInf(grad[i] - pkd_grad[i]));
+
+        BOOST_CHECK_MESSAGE((max_diff <= GRAD_DELTA_MAX),
+                            "Gradient deviation too large for molecule #" << mol_idx << " (" << getName(mol) <<
+                            "): max. packed/generic grad. element deviation of " << max_diff << " > " << GRAD_DELTA_MAX);
+
+        // in-place modifications of the nonbonded interaction lists must be detected without a new setup() call
+
+        std::size_t data_version = ia_data.getNonbondedDataVersion();
+        double ref_total_energy = e_calc.getTotalEnergy();
+
+        std::reverse(ia_data.getElectrostaticInteractions().getElementsBegin(), ia_data.getElectrostaticInteractions().getElementsEnd());
+        std::reverse(ia_data.getVanDerWaalsInteractions().getElementsBegin(), ia_data.getVanDerWaalsInteractions().getElementsEnd());
+
+        BOOST_CHECK(ia_data.getNonbondedDataVersion() != data_version);
+
+        e_calc(coords);
+        gr_calc(coords, grad);
+
+        BOOST_CHECK(std::abs(e_calc.getTotalEnergy() - ref_total_energy) <= E_DELTA_MAX);
+        BOOST_CHECK(std::abs(gr_calc.getTotalEnergy() - ref_total_energy) <= E_DELTA_MAX);
+
+        if (mol_idx >= MAX_NUM_GRAD_MOLS)
+            continue;
+
+        // the switched gradient must match a central difference approximation
+
+        max_diff = 0.0;
+
+        for (std::size_t i = 0; i < coords.getSize(); i++) {
+            for (std::size_t j = 0; j < 3; j++) {
+                double orig_pos = coords[i][j];
+
+                coords[i][j] = orig_pos + NUM_GRAD_STEP;
+                double e_plus = e_calc(coords);
+
+                coords[i][j] = orig_pos - NUM_GRAD_STEP;
+                double e_minus = e_calc(coords);
+
+                coords[i][j] = orig_pos;
+
+                max_diff = std::max(max_diff, std::abs((e_plus - e_minus) / (2.0 * NUM_GRAD_STEP) - grad[i][j]));
+            }
+        }
+
+        BOOST_CHECK_MESSAGE((max_diff <= NUM_GRAD_DELTA_MAX),
+                            "Gradient deviation too large for molecule #" << mol_idx << " (" << getName(mol) <<
+                            "): max. analytical/numerical grad. element deviation of " << max_diff << " > " << NUM_GRAD_DELTA_MAX);
+
+        parameterizer.setNonbondedSwitchingWidth(ForceField::MMFF94InteractionData::DEF_NONBONDED_SWITCHING_WIDTH);
+    }
+}
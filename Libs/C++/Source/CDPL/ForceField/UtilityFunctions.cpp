@@ -142,4 +142,7 @@ void ForceField::filterInteractions(const MMFF94InteractionData& ia_data, MMFF94
 
         filtered_ia_data.getTorsionInteractions().addElement(iactn);
     }
+
+    filtered_ia_data.setNonbondedCutoff(ia_data.getNonbondedCutoff());
+    filtered_ia_data.setNonbondedSwitchingWidth(ia_data.getNonbondedSwitchingWidth());
 }
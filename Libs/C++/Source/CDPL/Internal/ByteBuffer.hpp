@@ -75,6 +75,14 @@ namespace CDPL
             inline
             void reserve(std::size_t size);
 
+            /*
+             * Lets the buffer refer to \a size bytes of external data for reading without copying them.
+             * The data must stay valid as long as they are read. Any subsequent write operation first
+             * copies the data into the buffer's own storage.
+             */
+            inline
+            void wrap(const char* data, std::size_t size);
+
             inline
             void resize(std::size_t size, char value = 0);
 
@@ -124,6 +132,11 @@ namespace CDPL
             char* getData();
 
           private:
+            inline
+            void detach();
+            inline
+            const char* getReadData() const;
+
             inline
             void reserveWriteSpace(std::size_t num_bytes);
             inline
@@ -138,6 +151,8 @@ namespace CDPL
 
             StorageType data;
             std::size_t ioPointer;
+            const char* extData;
+            std::size_t extDataSize;
         };
     } // namespace Internal
 } // namespace CDPL
@@ -145,7 +160,7 @@ namespace CDPL
 
 // Implementation
 
-CDPL::Internal::ByteBuffer::ByteBuffer(std::size_t reserve): ioPointer(0)
+CDPL::Internal::ByteBuffer::ByteBuffer(std::size_t reserve): ioPointer(0), extData(0), extDataSize(0)
 {
     data.reserve(reserve);
 }
@@ -167,12 +182,21 @@ void CDPL::Internal::ByteBuffer::reserve(std::size_t size)
 
 void CDPL::Internal::ByteBuffer::resize(std::size_t size, char value)
 {
+    detach();
+
     data.resize(size, value);
 }
 
+void CDPL::Internal::ByteBuffer::wrap(const char* ext_data, std::size_t size)
+{
+    extData     = ext_data;
+    extDataSize = size;
+    ioPointer   = 0;
+}
+
 std::size_t CDPL::Internal::ByteBuffer::getSize() const
 {
-    return data.size();
+    return (extData ? extDataSize : data.size());
 }
 
 void CDPL::Internal::ByteBuffer::putBytes(const char* bytes, std::size_t num_bytes)
@@ -185,19 +209,21 @@ void CDPL::Internal::ByteBuffer::putBytes(const char* bytes, std::size_t num_byt
 
 void CDPL::Internal::ByteBuffer::putBytes(const ByteBuffer& buffer)
 {
-    putBytes(&buffer.data[0], buffer.getSize());
+    putBytes(buffer.getReadData(), buffer.getSize());
 }
 
 void CDPL::Internal::ByteBuffer::getBytes(char* bytes, std::size_t num_bytes)
 {
     checkReadSpace(num_bytes);
 
-    std::memcpy(bytes, &data[ioPointer], num_bytes);
+    std::memcpy(bytes, getReadData() + ioPointer, num_bytes);
     ioPointer += num_bytes;
 }
 
 std::size_t CDPL::Internal::ByteBuffer::readBuffer(std::istream& is, std::size_t num_bytes)
 {
+    extData = 0;
+
     data.resize(num_bytes);
     is.read(&data[0], num_bytes);
 
@@ -206,11 +232,27 @@ std::size_t CDPL::Internal::ByteBuffer::readBuffer(std::istream& is, std::size_t
 
 void CDPL::Internal::ByteBuffer::writeBuffer(std::ostream& os) const
 {
-    os.write(&data[0], data.size());
+    os.write(getReadData(), getSize());
+}
+
+void CDPL::Internal::ByteBuffer::detach()
+{
+    if (!extData)
+        return;
+
+    data.assign(extData, extData + extDataSize);
+    extData = 0;
+}
+
+const char* CDPL::Internal::ByteBuffer::getReadData() const
+{
+    return (extData ? extData : data.data());
 }
 
 void CDPL::Internal::ByteBuffer::reserveWriteSpace(std::size_t num_bytes)
 {
+    detach();
+
     std::size_t req_size = ioPointer + num_bytes;
 
     if (req_size > data.size())
@@ -221,7 +263,7 @@ void CDPL::Internal::ByteBuffer::checkReadSpace(std::size_t num_bytes) const
 {
     std::size_t req_size = ioPointer + num_bytes;
 
-    if (req_size > data.size())
+    if (req_size > getSize())
         throw Base::IOError("ByteBuffer: attempting to read beyond the end of data");
 }
 
@@ -262,25 +304,29 @@ void CDPL::Internal::ByteBuffer::getValueBytes(char* bytes, std::size_t type_siz
 {
     checkReadSpace(num_bytes);
 
+    const char* read_data = getReadData();
+
     if (CDPL_BIG_ENDIAN_NATIVE_ORDER) {
         bytes += type_size;
 
         for (std::size_t i = 0; i < num_bytes; i++)
-            *(--bytes) = data[ioPointer++];
+            *(--bytes) = read_data[ioPointer++];
 
     } else {
-        std::memcpy(bytes, &data[ioPointer], num_bytes);
+        std::memcpy(bytes, read_data + ioPointer, num_bytes);
         ioPointer += num_bytes;
     }
 }
 
 const char* CDPL::Internal::ByteBuffer::getData() const
 {
-    return &data[0];
+    return getReadData();
 }
 
 char* CDPL::Internal::ByteBuffer::getData()
 {
+    detach();
+
     return &data[0];
 }
 
@@ -32,6 +32,7 @@
 
 #include "CDPL/Math/VectorArray.hpp"
 #include "CDPL/Base/Exceptions.hpp"
+#include "CDPL/Util/MappedFileIStream.hpp"
 
 #include "CDPL/Internal/CDFFormatData.hpp"
 #include "CDPL/Internal/ByteBuffer.hpp"
@@ -465,6 +466,16 @@ bool CDPL::Internal::CDFDataReaderBase::getHeader(CDF::Header& header, ByteBuffe
 
 void CDPL::Internal::CDFDataReaderBase::readData(std::istream& is, std::size_t length, ByteBuffer& bbuf) const
 {
+    if (Util::MappedFileStreamBuffer* mf_buf = dynamic_cast<Util::MappedFileStreamBuffer*>(is.rdbuf())) {
+        const char* data = mf_buf->consume(length); // decode directly from the mapped pages
+
+        if (!data)
+            throw Base::IOError("CDFDataReaderBase: could not read CDF-record data, unexpected end of input");
+
+        bbuf.wrap(data, length);
+        return;
+    }
+
     std::size_t num_read = bbuf.readBuffer(is, length);
 
     if (!is.good())
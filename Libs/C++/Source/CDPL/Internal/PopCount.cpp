@@ -0,0 +1,247 @@
+/* 
+ * PopCount.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+# define CDPL_INTERNAL_POPCOUNT_X86_DISPATCH
+# include <immintrin.h>
+#endif
+
+#include "PopCount.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+    inline std::size_t popCountWord(std::uint64_t x)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return __builtin_popcountll(x);
+#else
+        x = x - ((x >> 1) & 0x5555555555555555ULL);
+        x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+        x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+
+        return std::size_t((x * 0x0101010101010101ULL) >> 56);
+#endif
+    }
+
+    std::size_t popCountPortable(const std::uint64_t* words, std::size_t num_words)
+    {
+        std::size_t count = 0;
+
+        for (std::size_t i = 0; i < num_words; i++)
+            count += popCountWord(words[i]);
+
+        return count;
+    }
+
+    std::size_t popCountAndPortable(const std::uint64_t* words1, const std::uint64_t* words2, std::size_t num_words)
+    {
+        std::size_t count = 0;
+
+        for (std::size_t i = 0; i < num_words; i++)
+            count += popCountWord(words1[i] & words2[i]);
+
+        return count;
+    }
+
+    void popCountAndRowsPortable(const std::uint64_t* query, const std::uint64_t* rows, std::size_t num_words,
+                                 std::size_t num_rows, std::uint32_t* counts)
+    {
+        for (std::size_t i = 0; i < num_rows; i++, rows += num_words)
+            counts[i] = std::uint32_t(popCountAndPortable(query, rows, num_words));
+    }
+
+#ifdef CDPL_INTERNAL_POPCOUNT_X86_DISPATCH
+
+    __attribute__((target("popcnt")))
+    std::size_t popCountPOPCNT(const std::uint64_t* words, std::size_t num_words)
+    {
+        std::size_t count = 0;
+
+        for (std::size_t i = 0; i < num_words; i++)
+            count += __builtin_popcountll(words[i]);
+
+        return count;
+    }
+
+    __attribute__((target("popcnt")))
+    std::size_t popCountAndPOPCNT(const std::uint64_t* words1, const std::uint64_t* words2, std::size_t num_words)
+    {
+        std::size_t count = 0;
+
+        for (std::size_t i = 0; i < num_words; i++)
+            count += __builtin_popcountll(words1[i] & words2[i]);
+
+        return count;
+    }
+
+    __attribute__((target("popcnt")))
+    void popCountAndRowsPOPCNT(const std::uint64_t* query, const std::uint64_t* rows, std::size_t num_words,
+                               std::size_t num_rows, std::uint32_t* counts)
+    {
+        for (std::size_t i = 0; i < num_rows; i++, rows += num_words)
+            counts[i] = std::uint32_t(popCountAndPOPCNT(query, rows, num_words));
+    }
+
+    // nibble lookup based byte population counts (W. Mula), summed up per 64-bit lane by vpsadbw
+
+    __attribute__((target("avx2")))
+    inline __m256i popCount256(__m256i v)
+    {
+        const __m256i lookup   = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                  0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        const __m256i low_mask = _mm256_set1_epi8(0x0f);
+
+        __m256i lo = _mm256_and_si256(v, low_mask);
+        __m256i hi = _mm256_and_si256(_mm256_srli_epi16(v, 4), low_mask);
+        __m256i cnt = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, lo), _mm256_shuffle_epi8(lookup, hi));
+
+        return _mm256_sad_epu8(cnt, _mm256_setzero_si256());
+    }
+
+    __attribute__((target("avx2")))
+    inline std::size_t sumLanes(__m256i acc)
+    {
+        __m128i sum = _mm_add_epi64(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+
+        return std::size_t(std::uint64_t(_mm_cvtsi128_si64(sum)) + std::uint64_t(_mm_extract_epi64(sum, 1)));
+    }
+
+    __attribute__((target("avx2,popcnt")))
+    std::size_t popCountAVX2(const std::uint64_t* words, std::size_t num_words)
+    {
+        __m256i acc = _mm256_setzero_si256();
+        std::size_t i = 0;
+
+        for ( ; (i + 4) <= num_words; i += 4)
+            acc = _mm256_add_epi64(acc, popCount256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(words + i))));
+
+        std::size_t count = sumLanes(acc);
+
+        for ( ; i < num_words; i++)
+            count += __builtin_popcountll(words[i]);
+
+        return count;
+    }
+
+    __attribute__((target("avx2,popcnt")))
+    std::size_t popCountAndAVX2(const std::uint64_t* words1, const std::uint64_t* words2, std::size_t num_words)
+    {
+        __m256i acc = _mm256_setzero_si256();
+        std::size_t i = 0;
+
+        for ( ; (i + 4) <= num_words; i += 4)
+            acc = _mm256_add_epi64(acc, popCount256(_mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(words1 + i)),
+                                                                     _mm256_loadu_si256(reinterpret_cast<const __m256i*>(words2 + i)))));
+        std::size_t count = sumLanes(acc);
+
+        for ( ; i < num_words; i++)
+            count += __builtin_popcountll(words1[i] & words2[i]);
+
+        return count;
+    }
+
+    __attribute__((target("avx2,popcnt")))
+    void popCountAndRowsAVX2(const std::uint64_t* query, const std::uint64_t* rows, std::size_t num_words,
+                             std::size_t num_rows, std::uint32_t* counts)
+    {
+        for (std::size_t i = 0; i < num_rows; i++, rows += num_words)
+            counts[i] = std::uint32_t(popCountAndAVX2(query, rows, num_words));
+    }
+
+#endif // CDPL_INTERNAL_POPCOUNT_X86_DISPATCH
+
+    typedef std::size_t (*PopCountFunction)(const std::uint64_t*, std::size_t);
+    typedef std::size_t (*PopCountAndFunction)(const std::uint64_t*, const std::uint64_t*, std::size_t);
+    typedef void (*PopCountAndRowsFunction)(const std::uint64_t*, const std::uint64_t*, std::size_t, std::size_t, std::uint32_t*);
+
+    struct PopCountImpl
+    {
+
+        PopCountImpl()
+        {
+#ifdef CDPL_INTERNAL_POPCOUNT_X86_DISPATCH
+            __builtin_cpu_init();
+
+            if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("popcnt")) {
+                popCount        = &popCountAVX2;
+                popCountAnd     = &popCountAndAVX2;
+                popCountAndRows = &popCountAndRowsAVX2;
+                name            = "AVX2";
+                return;
+            }
+
+            if (__builtin_cpu_supports("popcnt")) {
+                popCount        = &popCountPOPCNT;
+                popCountAnd     = &popCountAndPOPCNT;
+                popCountAndRows = &popCountAndRowsPOPCNT;
+                name            = "POPCNT";
+                return;
+            }
+#endif
+            popCount        = &popCountPortable;
+            popCountAnd     = &popCountAndPortable;
+            popCountAndRows = &popCountAndRowsPortable;
+            name            = "Portable";
+        }
+
+        PopCountFunction        popCount;
+        PopCountAndFunction     popCountAnd;
+        PopCountAndRowsFunction popCountAndRows;
+        const char*             name;
+    };
+
+    const PopCountImpl& getImpl()
+    {
+        static const PopCountImpl impl;
+
+        return impl;
+    }
+}
+
+
+std::size_t Internal::popCount(const std::uint64_t* words, std::size_t num_words)
+{
+    return getImpl().popCount(words, num_words);
+}
+
+std::size_t Internal::popCountAnd(const std::uint64_t* words1, const std::uint64_t* words2, std::size_t num_words)
+{
+    return getImpl().popCountAnd(words1, words2, num_words);
+}
+
+void Internal::popCountAnd(const std::uint64_t* query, const std::uint64_t* rows, std::size_t num_words,
+                           std::size_t num_rows, std::uint32_t* counts)
+{
+    getImpl().popCountAndRows(query, rows, num_words, num_rows, counts);
+}
+
+const char* Internal::getPopCountImplName()
+{
+    return getImpl().name;
+}
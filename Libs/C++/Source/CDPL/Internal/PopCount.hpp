@@ -0,0 +1,58 @@
+/* 
+ * PopCount.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef CDPL_INTERNAL_POPCOUNT_HPP
+#define CDPL_INTERNAL_POPCOUNT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace CDPL
+{
+
+    namespace Internal
+    {
+
+        /*
+         * Population counts over packed 64-bit words. The implementation gets selected once at runtime
+         * (AVX2, POPCNT or portable code) depending on the capabilities of the executing CPU.
+         */
+
+        std::size_t popCount(const std::uint64_t* words, std::size_t num_words);
+
+        std::size_t popCountAnd(const std::uint64_t* words1, const std::uint64_t* words2, std::size_t num_words);
+
+        /*
+         * Stores the number of bits set in both the query word array and each of the num_rows consecutive
+         * word arrays (rows) of length num_words at rows in counts[0..num_rows).
+         */
+        void popCountAnd(const std::uint64_t* query, const std::uint64_t* rows, std::size_t num_words,
+                         std::size_t num_rows, std::uint32_t* counts);
+
+        const char* getPopCountImplName();
+    } // namespace Internal
+} // namespace CDPL
+
+#endif // CDPL_INTERNAL_POPCOUNT_HPP
@@ -0,0 +1,129 @@
+/* 
+ * SubstructureQueryState.hpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef CDPL_INTERNAL_SUBSTRUCTUREQUERYSTATE_HPP
+#define CDPL_INTERNAL_SUBSTRUCTUREQUERYSTATE_HPP
+
+#include <vector>
+#include <memory>
+
+#include "CDPL/Chem/MolecularGraph.hpp"
+#include "CDPL/Chem/Atom.hpp"
+#include "CDPL/Chem/Bond.hpp"
+#include "CDPL/Chem/AtomFunctions.hpp"
+#include "CDPL/Chem/BondFunctions.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+
+
+namespace CDPL
+{
+
+    namespace Internal
+    {
+
+        /*
+         * Records the query data a Chem::SubstructureSearch instance and the substructure screening key generation
+         * depend on (atoms, bonds, match constraints and match expressions) to detect modifications of a
+         * query molecular graph that invalidate cached search data.
+         */
+        class SubstructureQueryState
+        {
+
+          public:
+            /*
+             * Returns true if the recorded state differs from the current state of query (always true on
+             * the first call) and records the current state.
+             */
+            bool update(const Chem::MolecularGraph& query)
+            {
+                using namespace Chem;
+
+                tmpState.clear();
+                tmpState.push_back(&query);
+                tmpState.push_back(getExpressionPointer(query));
+
+                for (MolecularGraph::ConstAtomIterator it = query.getAtomsBegin(), end = query.getAtomsEnd(); it != end; ++it) {
+                    const Atom& atom = *it;
+
+                    tmpState.push_back(&atom);
+                    tmpState.push_back(getExpressionPointer(atom));
+                    tmpState.push_back(getMatchConstraints(atom).get());
+                }
+
+                for (MolecularGraph::ConstBondIterator it = query.getBondsBegin(), end = query.getBondsEnd(); it != end; ++it) {
+                    const Bond& bond = *it;
+
+                    tmpState.push_back(&bond.getBegin());
+                    tmpState.push_back(&bond.getEnd());
+                    tmpState.push_back(getExpressionPointer(bond));
+                }
+
+                if (tmpState == state)
+                    return false;
+
+                state.swap(tmpState);
+
+                // the recorded match expressions and constraints are kept alive to prevent that their addresses
+                // get reused by newly created objects
+
+                heldObjects.clear();
+
+                holdExpression(query);
+
+                for (MolecularGraph::ConstAtomIterator it = query.getAtomsBegin(), end = query.getAtomsEnd(); it != end; ++it) {
+                    holdExpression(*it);
+                    heldObjects.push_back(getMatchConstraints(*it));
+                }
+
+                for (MolecularGraph::ConstBondIterator it = query.getBondsBegin(), end = query.getBondsEnd(); it != end; ++it)
+                    holdExpression(*it);
+
+                return true;
+            }
+
+          private:
+            typedef std::vector<const void*>                 PointerArray;
+            typedef std::vector<std::shared_ptr<const void>> SharedPointerArray;
+
+            template <typename T>
+            static const void* getExpressionPointer(const T& obj)
+            {
+                return (Chem::hasMatchExpression(obj) ? Chem::getMatchExpression(obj).get() : 0);
+            }
+
+            template <typename T>
+            void holdExpression(const T& obj)
+            {
+                if (Chem::hasMatchExpression(obj))
+                    heldObjects.push_back(Chem::getMatchExpression(obj));
+            }
+
+            PointerArray       state;
+            PointerArray       tmpState;
+            SharedPointerArray heldObjects;
+        };
+    } // namespace Internal
+} // namespace CDPL
+
+#endif // CDPL_INTERNAL_SUBSTRUCTUREQUERYSTATE_HPP
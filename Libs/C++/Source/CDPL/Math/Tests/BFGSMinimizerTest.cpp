@@ -312,6 +312,39 @@ namespace
         
         BOOST_CHECK_EQUAL(status, minimizer.getStatus());
         BOOST_CHECK_EQUAL(status, MinimizerType::DELTAF_REACHED);
+
+        // -----------------
+
+        // a minimization driven via the reverse communication interface has to yield exactly the same results
+
+        func.init();
+
+        typename F::VectorType start_x = func.x;
+        typename F::ValueType step_size = 0.1 * func.xNorm2();
+
+        minimizer.setup(func.x, func.g, step_size, 0.1);
+        status = minimizer.minimize(func.x, func.g, num_req_iter + 1, min_gnorm * 0.5, -1, false);
+
+        MinimizerType rc_minimizer;
+        typename F::VectorType eval_grad = func.g;
+
+        rc_minimizer.start(start_x, num_req_iter + 1, min_gnorm * 0.5, -1, step_size, 0.1);
+
+        for (typename MinimizerType::EvaluationRequest req = rc_minimizer.advance(); req != MinimizerType::NO_EVALUATION;
+             req = rc_minimizer.advance()) {
+
+            if (req == MinimizerType::VALUE_EVALUATION)
+                rc_minimizer.setFunctionValue(F::valueFunc(rc_minimizer.getEvaluationPoint()));
+            else
+                rc_minimizer.setFunctionGradient(F::valueAndGradientFunc(rc_minimizer.getEvaluationPoint(), eval_grad), eval_grad);
+        }
+
+        BOOST_CHECK_EQUAL(rc_minimizer.getStatus(), status);
+        BOOST_CHECK_EQUAL(rc_minimizer.getNumIterations(), minimizer.getNumIterations());
+        BOOST_CHECK(rc_minimizer.getFunctionValue() == minimizer.getFunctionValue());
+        BOOST_CHECK(rc_minimizer.getGradientNorm() == minimizer.getGradientNorm());
+        BOOST_CHECK(rc_minimizer.getPosition() == func.x);
+        BOOST_CHECK(rc_minimizer.getGradient() == func.g);
     }
 }
 
@@ -171,7 +171,7 @@ bool Pharm::FileScreeningHitCollector::operator()(const ScreeningProcessor::Sear
 
     if (optDBName)
         struc_data->addEntry(DB_NAME_PROPERTY_NAME, 
-                             FILESYSTEM_NS::path(hit.getHitProvider().getDBAccessor().getDatabaseName()).filename().string());
+                             FILESYSTEM_NS::path(hit.getDBAccessor().getDatabaseName()).filename().string());
 
     if (optMolIndex) {
         struc_data->addEntry(MOL_INDEX_PROPERTY_NAME, 
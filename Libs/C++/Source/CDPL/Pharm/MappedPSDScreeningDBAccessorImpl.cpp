@@ -0,0 +1,309 @@
+/* 
+ * MappedPSDScreeningDBAccessorImpl.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include <cstring>
+#include <limits>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include "CDPL/Base/Exceptions.hpp"
+
+#include "MappedPSDScreeningDBAccessorImpl.hpp"
+#include "MappedPSDScreeningDBFormat.hpp"
+
+
+using namespace CDPL;
+
+namespace Format = Pharm::MappedPSDScreeningDBFormat;
+
+
+Pharm::MappedPSDScreeningDBAccessorImpl::MappedPSDScreeningDBAccessorImpl():
+    pharmData(0), molData(0), molDataOffsets(0), molPharmOffsets(0), pharmDataOffsets(0), pharmMolIndices(0), 
+    featureTypes(0), featureCountTable(0), numMolecules(0), numPharmacophores(0), numFeatureTypes(0), molDataSize(0), 
+    pharmDataSize(0), featureCountsMolIdx(std::numeric_limits<std::size_t>::max())
+{}
+
+Pharm::MappedPSDScreeningDBAccessorImpl::~MappedPSDScreeningDBAccessorImpl()
+{}
+
+void Pharm::MappedPSDScreeningDBAccessorImpl::open(const std::string& name)
+{
+    close();
+
+    MappedFilePtr file;
+
+    try {
+        file.reset(new MappedFile(name));
+
+    } catch (const std::exception& e) {
+        throw Base::IOError("MappedPSDScreeningDBAccessorImpl: could not open database file '" + name + "': " + e.what());
+    }
+
+    if (!file->is_open() || file->size() < sizeof(Format::Header))
+        throw Base::IOError("MappedPSDScreeningDBAccessorImpl: could not open database file '" + name + "'");
+
+    Format::Header header;
+
+    std::memcpy(&header, file->data(), sizeof(Format::Header));
+
+    if (std::memcmp(header.fileID, Format::FILE_ID, sizeof(Format::FILE_ID)) != 0)
+        throw Base::IOError("MappedPSDScreeningDBAccessorImpl: '" + name + "' is not a memory-mapped PSD database file");
+
+    if (header.formatVersion != Format::FORMAT_VERSION || header.byteOrderMark != Format::BYTE_ORDER_MARK)
+        throw Base::IOError("MappedPSDScreeningDBAccessorImpl: unsupported format version or byte order of database file '" + name + "'");
+
+    std::uint64_t pharm_data_size = Format::getPaddedSize(header.pharmDataSize);
+    std::uint64_t mol_data_size = Format::getPaddedSize(header.molDataSize);
+    std::uint64_t mol_tab_size = (header.numMolecules + 1) * sizeof(std::uint64_t);
+    std::uint64_t pharm_tab_size = (header.numPharmacophores + 1) * sizeof(std::uint64_t);
+    std::uint64_t pharm_mol_tab_size = header.numPharmacophores * sizeof(std::uint64_t);
+    std::uint64_t ftr_type_tab_size = header.numFeatureTypes * sizeof(std::uint64_t);
+    std::uint64_t ftr_count_tab_size = Format::getPaddedSize(header.numFeatureTypes * header.numMolecules * sizeof(std::uint32_t));
+
+    if (file->size() != sizeof(Format::Header) + pharm_data_size + mol_data_size + 2 * mol_tab_size + pharm_tab_size + 
+        pharm_mol_tab_size + ftr_type_tab_size + ftr_count_tab_size)
+        throw Base::IOError("MappedPSDScreeningDBAccessorImpl: database file '" + name + "' is truncated or corrupted");
+
+    const char* data = file->data() + sizeof(Format::Header);
+    const char* tables = data + pharm_data_size + mol_data_size;
+
+    const std::uint64_t* mol_data_offs = reinterpret_cast<const std::uint64_t*>(tables);
+    const std::uint64_t* mol_pharm_offs = mol_data_offs + header.numMolecules + 1;
+    const std::uint64_t* pharm_data_offs = mol_pharm_offs + header.numMolecules + 1;
+
+    // the complete offset tables only get validated entry-wise on access
+
+    if (mol_data_offs[header.numMolecules] != header.molDataSize || mol_pharm_offs[header.numMolecules] != header.numPharmacophores ||
+        pharm_data_offs[header.numPharmacophores] != header.pharmDataSize)
+        throw Base::IOError("MappedPSDScreeningDBAccessorImpl: database file '" + name + "' is corrupted");
+
+    mappedFile.swap(file);
+
+    dbName            = name;
+    pharmData         = data;
+    molData           = data + pharm_data_size;
+    molDataOffsets    = mol_data_offs;
+    molPharmOffsets   = mol_pharm_offs;
+    pharmDataOffsets  = pharm_data_offs;
+    pharmMolIndices   = pharm_data_offs + header.numPharmacophores + 1;
+    featureTypes      = pharmMolIndices + header.numPharmacophores;
+    featureCountTable = reinterpret_cast<const std::uint32_t*>(featureTypes + header.numFeatureTypes);
+    numMolecules      = header.numMolecules;
+    numPharmacophores = header.numPharmacophores;
+    numFeatureTypes   = header.numFeatureTypes;
+    molDataSize       = header.molDataSize;
+    pharmDataSize     = header.pharmDataSize;
+}
+
+void Pharm::MappedPSDScreeningDBAccessorImpl::share(const MappedPSDScreeningDBAccessorImpl& impl)
+{
+    close();
+
+    if (!impl.mappedFile)
+        return;
+
+    mappedFile        = impl.mappedFile;
+    dbName            = impl.dbName;
+    pharmData         = impl.pharmData;
+    molData           = impl.molData;
+    molDataOffsets    = impl.molDataOffsets;
+    molPharmOffsets   = impl.molPharmOffsets;
+    pharmDataOffsets  = impl.pharmDataOffsets;
+    pharmMolIndices   = impl.pharmMolIndices;
+    featureTypes      = impl.featureTypes;
+    featureCountTable = impl.featureCountTable;
+    numMolecules      = impl.numMolecules;
+    numPharmacophores = impl.numPharmacophores;
+    numFeatureTypes   = impl.numFeatureTypes;
+    molDataSize       = impl.molDataSize;
+    pharmDataSize     = impl.pharmDataSize;
+}
+
+void Pharm::MappedPSDScreeningDBAccessorImpl::close()
+{
+    mappedFile.reset();
+    dbName.clear();
+    featureCounts.clear();
+    byteBuffer.resize(0);
+
+    pharmData           = 0;
+    molData             = 0;
+    molDataOffsets      = 0;
+    molPharmOffsets     = 0;
+    pharmDataOffsets    = 0;
+    pharmMolIndices     = 0;
+    featureTypes        = 0;
+    featureCountTable   = 0;
+    numMolecules        = 0;
+    numPharmacophores   = 0;
+    numFeatureTypes     = 0;
+    molDataSize         = 0;
+    pharmDataSize       = 0;
+    featureCountsMolIdx = std::numeric_limits<std::size_t>::max();
+}
+
+const std::string& Pharm::MappedPSDScreeningDBAccessorImpl::getDatabaseName() const
+{
+    return dbName;
+}
+
+std::size_t Pharm::MappedPSDScreeningDBAccessorImpl::getNumMolecules() const
+{
+    return numMolecules;
+}
+
+std::size_t Pharm::MappedPSDScreeningDBAccessorImpl::getNumPharmacophores() const
+{
+    return numPharmacophores;
+}
+
+std::size_t Pharm::MappedPSDScreeningDBAccessorImpl::getNumPharmacophores(std::size_t mol_idx) const
+{
+    if (!mappedFile)
+        return 0;
+
+    checkMoleculeIndex(mol_idx);
+
+    return (molPharmOffsets[mol_idx + 1] - molPharmOffsets[mol_idx]);
+}
+
+void Pharm::MappedPSDScreeningDBAccessorImpl::getMolecule(std::size_t mol_idx, Chem::Molecule& mol)
+{
+    checkOpen();
+    checkMoleculeIndex(mol_idx);
+    wrapData(molData, molDataOffsets, molDataSize, mol_idx);
+
+    molReader.readMolecule(byteBuffer, mol);
+}
+
+void Pharm::MappedPSDScreeningDBAccessorImpl::getPharmacophore(std::size_t pharm_idx, Pharmacophore& pharm)
+{
+    checkOpen();
+    checkPharmacophoreIndex(pharm_idx);
+    wrapData(pharmData, pharmDataOffsets, pharmDataSize, pharm_idx);
+
+    pharmReader.readPharmacophore(byteBuffer, pharm);
+}
+
+void Pharm::MappedPSDScreeningDBAccessorImpl::getPharmacophore(std::size_t mol_idx, std::size_t mol_conf_idx, Pharmacophore& pharm)
+{
+    checkOpen();
+
+    if (mol_conf_idx >= getNumPharmacophores(mol_idx))
+        throw Base::IOError("MappedPSDScreeningDBAccessorImpl: requested pharmacophore not found");
+
+    getPharmacophore(molPharmOffsets[mol_idx] + mol_conf_idx, pharm);
+}
+
+std::size_t Pharm::MappedPSDScreeningDBAccessorImpl::getMoleculeIndex(std::size_t pharm_idx) const
+{
+    checkOpen();
+    checkPharmacophoreIndex(pharm_idx);
+
+    return pharmMolIndices[pharm_idx];
+}
+
+std::size_t Pharm::MappedPSDScreeningDBAccessorImpl::getConformationIndex(std::size_t pharm_idx) const
+{
+    checkOpen();
+    checkPharmacophoreIndex(pharm_idx);
+
+    return (pharm_idx - molPharmOffsets[pharmMolIndices[pharm_idx]]);
+}
+
+const Pharm::FeatureTypeHistogram& Pharm::MappedPSDScreeningDBAccessorImpl::getFeatureCounts(std::size_t pharm_idx)
+{
+    checkOpen();
+    checkPharmacophoreIndex(pharm_idx);
+    loadFeatureCounts(pharmMolIndices[pharm_idx]);
+
+    return featureCounts;
+}
+
+const Pharm::FeatureTypeHistogram& Pharm::MappedPSDScreeningDBAccessorImpl::getFeatureCounts(std::size_t mol_idx, std::size_t mol_conf_idx)
+{
+    checkOpen();
+    checkMoleculeIndex(mol_idx);
+    loadFeatureCounts(mol_idx);
+
+    return featureCounts;
+}
+
+void Pharm::MappedPSDScreeningDBAccessorImpl::checkOpen() const
+{
+    if (!mappedFile)
+        throw Base::IOError("MappedPSDScreeningDBAccessorImpl: no open database file");
+}
+
+void Pharm::MappedPSDScreeningDBAccessorImpl::checkMoleculeIndex(std::size_t mol_idx) const
+{
+    if (mol_idx >= numMolecules)
+        throw Base::IndexError("MappedPSDScreeningDBAccessorImpl: molecule index out of bounds");
+
+    if (molPharmOffsets[mol_idx] > molPharmOffsets[mol_idx + 1] || molPharmOffsets[mol_idx + 1] > numPharmacophores)
+        throw Base::IOError("MappedPSDScreeningDBAccessorImpl: corrupted molecule pharmacophore table");
+}
+
+void Pharm::MappedPSDScreeningDBAccessorImpl::checkPharmacophoreIndex(std::size_t pharm_idx) const
+{
+    if (pharm_idx >= numPharmacophores)
+        throw Base::IndexError("MappedPSDScreeningDBAccessorImpl: pharmacophore index out of bounds");
+
+    std::uint64_t mol_idx = pharmMolIndices[pharm_idx];
+
+    if (mol_idx >= numMolecules || pharm_idx < molPharmOffsets[mol_idx] || pharm_idx >= molPharmOffsets[mol_idx + 1])
+        throw Base::IOError("MappedPSDScreeningDBAccessorImpl: corrupted pharmacophore molecule index table");
+}
+
+void Pharm::MappedPSDScreeningDBAccessorImpl::wrapData(const char* data, const std::uint64_t* offsets, std::uint64_t data_size, std::size_t idx)
+{
+    std::uint64_t start = offsets[idx];
+    std::uint64_t end = offsets[idx + 1];
+
+    if (start > end || end > data_size)
+        throw Base::IOError("MappedPSDScreeningDBAccessorImpl: corrupted data offset table");
+
+    // the PSD readers decode the record directly in the mapped file
+
+    byteBuffer.wrap(data + start, end - start);
+}
+
+void Pharm::MappedPSDScreeningDBAccessorImpl::loadFeatureCounts(std::size_t mol_idx)
+{
+    if (featureCountsMolIdx == mol_idx)
+        return;
+
+    featureCounts.clear();
+
+    for (std::size_t i = 0; i < numFeatureTypes; i++) {
+        std::uint32_t count = featureCountTable[i * numMolecules + mol_idx];
+
+        if (count > 0)
+            featureCounts.setEntry(featureTypes[i], count);
+    }
+
+    featureCountsMolIdx = mol_idx;
+}
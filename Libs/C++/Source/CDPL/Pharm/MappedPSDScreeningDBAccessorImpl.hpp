@@ -0,0 +1,137 @@
+/* 
+ * MappedPSDScreeningDBAccessorImpl.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef CDPL_PHARM_MAPPEDPSDSCREENINGDBACCESSORIMPL_HPP
+#define CDPL_PHARM_MAPPEDPSDSCREENINGDBACCESSORIMPL_HPP
+
+#include <string>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+#include "CDPL/Pharm/FeatureTypeHistogram.hpp"
+#include "CDPL/Internal/ByteBuffer.hpp"
+
+#include "PSDPharmacophoreByteBufferReader.hpp"
+#include "PSDMoleculeByteBufferReader.hpp"
+
+
+namespace boost
+{
+
+    namespace iostreams
+    {
+
+        class mapped_file_source;
+    }
+} // namespace boost
+
+
+namespace CDPL
+{
+
+    namespace Chem
+    {
+
+        class Molecule;
+    }
+
+    namespace Pharm
+    {
+
+        class Pharmacophore;
+
+        class MappedPSDScreeningDBAccessorImpl
+        {
+
+          public:
+            MappedPSDScreeningDBAccessorImpl();
+
+            ~MappedPSDScreeningDBAccessorImpl();
+
+            void open(const std::string& name);
+
+            void share(const MappedPSDScreeningDBAccessorImpl& impl);
+
+            void close();
+
+            const std::string& getDatabaseName() const;
+
+            std::size_t getNumMolecules() const;
+
+            std::size_t getNumPharmacophores() const;
+
+            std::size_t getNumPharmacophores(std::size_t mol_idx) const;
+
+            void getMolecule(std::size_t mol_idx, Chem::Molecule& mol);
+
+            void getPharmacophore(std::size_t pharm_idx, Pharmacophore& pharm);
+
+            void getPharmacophore(std::size_t mol_idx, std::size_t mol_conf_idx, Pharmacophore& pharm);
+
+            std::size_t getMoleculeIndex(std::size_t pharm_idx) const;
+
+            std::size_t getConformationIndex(std::size_t pharm_idx) const;
+
+            const FeatureTypeHistogram& getFeatureCounts(std::size_t pharm_idx);
+
+            const FeatureTypeHistogram& getFeatureCounts(std::size_t mol_idx, std::size_t mol_conf_idx);
+
+          private:
+            void checkOpen() const;
+            void checkMoleculeIndex(std::size_t mol_idx) const;
+            void checkPharmacophoreIndex(std::size_t pharm_idx) const;
+
+            void wrapData(const char* data, const std::uint64_t* offsets, std::uint64_t data_size, std::size_t idx);
+
+            void loadFeatureCounts(std::size_t mol_idx);
+
+            typedef boost::iostreams::mapped_file_source MappedFile;
+            typedef std::shared_ptr<MappedFile>          MappedFilePtr;
+
+            MappedFilePtr                    mappedFile;
+            std::string                      dbName;
+            const char*                      pharmData;
+            const char*                      molData;
+            const std::uint64_t*             molDataOffsets;
+            const std::uint64_t*             molPharmOffsets;
+            const std::uint64_t*             pharmDataOffsets;
+            const std::uint64_t*             pharmMolIndices;
+            const std::uint64_t*             featureTypes;
+            const std::uint32_t*             featureCountTable;
+            std::size_t                      numMolecules;
+            std::size_t                      numPharmacophores;
+            std::size_t                      numFeatureTypes;
+            std::uint64_t                    molDataSize;
+            std::uint64_t                    pharmDataSize;
+            FeatureTypeHistogram             featureCounts;
+            std::size_t                      featureCountsMolIdx;
+            Internal::ByteBuffer             byteBuffer;
+            PSDPharmacophoreByteBufferReader pharmReader;
+            PSDMoleculeByteBufferReader      molReader;
+        };
+    } // namespace Pharm
+} // namespace CDPL
+
+#endif // CDPL_PHARM_MAPPEDPSDSCREENINGDBACCESSORIMPL_HPP
@@ -0,0 +1,86 @@
+/* 
+ * MappedPSDScreeningDBFormat.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of the binary layout of memory-mapped PSD screening database files.
+ */
+
+#ifndef CDPL_PHARM_MAPPEDPSDSCREENINGDBFORMAT_HPP
+#define CDPL_PHARM_MAPPEDPSDSCREENINGDBFORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace CDPL
+{
+
+    namespace Pharm
+    {
+
+        namespace MappedPSDScreeningDBFormat
+        {
+
+            /*
+             * A database file consists of the header followed by these sections (each starting at an 8-byte aligned
+             * file offset, numbers are stored in native byte order):
+             *
+             *  - the concatenated PSD-encoded pharmacophore data of all conformers
+             *  - the concatenated PSD-encoded molecule data
+             *  - the molecule data offset table (numMolecules + 1 entries)
+             *  - the molecule pharmacophore table (numMolecules + 1 entries specifying the index of the first
+             *    pharmacophore of each molecule; the pharmacophores of a molecule are stored in conformer order)
+             *  - the pharmacophore data offset table (numPharmacophores + 1 entries)
+             *  - the pharmacophore molecule index table (numPharmacophores entries)
+             *  - the list of the feature types occurring in the database (numFeatureTypes entries)
+             *  - the feature count table that stores for each feature type in the list a column of 32-bit
+             *    per molecule maximum feature counts (numFeatureTypes * numMolecules entries)
+             */
+
+            const char          FILE_ID[8]      = { 'C', 'D', 'P', 'L', 'M', 'P', 'S', 'D' };
+            const std::uint32_t FORMAT_VERSION  = 1;
+            const std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+            struct Header
+            {
+
+                char          fileID[8];
+                std::uint32_t formatVersion;
+                std::uint32_t byteOrderMark;
+                std::uint64_t numMolecules;
+                std::uint64_t numPharmacophores;
+                std::uint64_t numFeatureTypes;
+                std::uint64_t molDataSize;
+                std::uint64_t pharmDataSize;
+            };
+
+            inline std::uint64_t getPaddedSize(std::uint64_t size)
+            {
+                return ((size + 7) & ~std::uint64_t(7));
+            }
+        } // namespace MappedPSDScreeningDBFormat
+    } // namespace Pharm
+} // namespace CDPL
+
+#endif // CDPL_PHARM_MAPPEDPSDSCREENINGDBFORMAT_HPP
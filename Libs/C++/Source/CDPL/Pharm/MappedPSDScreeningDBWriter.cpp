@@ -0,0 +1,85 @@
+/* 
+ * MappedPSDScreeningDBWriter.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include "CDPL/Pharm/MappedPSDScreeningDBWriter.hpp"
+
+#include "MappedPSDScreeningDBWriterImpl.hpp"
+
+
+using namespace CDPL;
+
+
+Pharm::MappedPSDScreeningDBWriter::MappedPSDScreeningDBWriter():
+    impl(new MappedPSDScreeningDBWriterImpl())
+{}
+
+Pharm::MappedPSDScreeningDBWriter::MappedPSDScreeningDBWriter(const std::string& name):
+    impl(new MappedPSDScreeningDBWriterImpl())
+{
+    impl->open(name);
+}
+
+Pharm::MappedPSDScreeningDBWriter::~MappedPSDScreeningDBWriter() {}
+
+void Pharm::MappedPSDScreeningDBWriter::open(const std::string& name)
+{
+    impl->open(name);
+}
+
+bool Pharm::MappedPSDScreeningDBWriter::append(const ScreeningDBAccessor& db_acc, const ProgressCallbackFunction& func)
+{
+    return impl->append(db_acc, func);
+}
+
+void Pharm::MappedPSDScreeningDBWriter::close()
+{
+    impl->close();
+}
+
+void Pharm::MappedPSDScreeningDBWriter::discard()
+{
+    impl->discard();
+}
+
+bool Pharm::MappedPSDScreeningDBWriter::isOpen() const
+{
+    return impl->isOpen();
+}
+
+const std::string& Pharm::MappedPSDScreeningDBWriter::getDatabaseName() const
+{
+    return impl->getDatabaseName();
+}
+
+std::size_t Pharm::MappedPSDScreeningDBWriter::getNumMolecules() const
+{
+    return impl->getNumMolecules();
+}
+
+std::size_t Pharm::MappedPSDScreeningDBWriter::getNumPharmacophores() const
+{
+    return impl->getNumPharmacophores();
+}
@@ -0,0 +1,283 @@
+/* 
+ * MappedPSDScreeningDBWriterImpl.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include <cstring>
+
+#include <boost/numeric/conversion/cast.hpp>
+
+#include "CDPL/Pharm/ScreeningDBAccessor.hpp"
+#include "CDPL/Pharm/FeatureTypeHistogram.hpp"
+#include "CDPL/Util/FileFunctions.hpp"
+#include "CDPL/Util/FileRemover.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+#include "MappedPSDScreeningDBWriterImpl.hpp"
+#include "MappedPSDScreeningDBFormat.hpp"
+
+
+using namespace CDPL;
+
+namespace Format = Pharm::MappedPSDScreeningDBFormat;
+
+
+Pharm::MappedPSDScreeningDBWriterImpl::MappedPSDScreeningDBWriterImpl():
+    pharmDataSize(0), molDataSize(0)
+{}
+
+Pharm::MappedPSDScreeningDBWriterImpl::~MappedPSDScreeningDBWriterImpl()
+{
+    discard();
+}
+
+void Pharm::MappedPSDScreeningDBWriterImpl::open(const std::string& name)
+{
+    discard();
+
+    try {
+        std::string::size_type sep_pos = name.find_last_of("/\\");
+        std::string dir = (sep_pos == std::string::npos ? std::string(".") : name.substr(0, sep_pos + 1));
+
+        tmpFileRemover.reset(new Util::FileRemover(Util::genCheckedTempFilePath(dir, "%%%%-%%%%-%%%%-%%%%.tmp")));
+        tmpMolDataFileRemover.reset(new Util::FileRemover(Util::genCheckedTempFilePath(dir, "%%%%-%%%%-%%%%-%%%%.tmp")));
+
+    } catch (const std::exception& e) {
+        discard();
+        throw Base::IOError(std::string("MappedPSDScreeningDBWriterImpl: could not create temporary files: ") + e.what());
+    }
+
+    outStream.open(tmpFileRemover->getPath().c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+    molDataStream.open(tmpMolDataFileRemover->getPath().c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+
+    // the header gets written on close() when all counts are known
+
+    Format::Header header;
+
+    std::memset(&header, 0, sizeof(Format::Header));
+
+    outStream.write(reinterpret_cast<const char*>(&header), sizeof(Format::Header));
+
+    if (!outStream || !molDataStream) {
+        discard();
+        throw Base::IOError("MappedPSDScreeningDBWriterImpl: could not open temporary files for writing");
+    }
+
+    dbName = name;
+
+    molDataOffsets.push_back(0);
+    molPharmOffsets.push_back(0);
+    pharmDataOffsets.push_back(0);
+}
+
+bool Pharm::MappedPSDScreeningDBWriterImpl::append(const ScreeningDBAccessor& db_acc, const MappedPSDScreeningDBWriter::ProgressCallbackFunction& func)
+{
+    if (!isOpen())
+        throw Base::IOError("MappedPSDScreeningDBWriterImpl: no open database file");
+
+    std::size_t num_mols = db_acc.getNumMolecules();
+
+    for (std::size_t i = 0; i < num_mols; i++) {
+        if (func && !func(double(i) / num_mols))
+            return false;
+
+        appendMolecule(db_acc, i);
+    }
+
+    if (func)
+        func(1.0);
+
+    return true;
+}
+
+void Pharm::MappedPSDScreeningDBWriterImpl::close()
+{
+    if (!isOpen())
+        throw Base::IOError("MappedPSDScreeningDBWriterImpl: no open database file");
+
+    std::size_t num_mols = getNumMolecules();
+
+    Format::Header header;
+
+    std::memcpy(header.fileID, Format::FILE_ID, sizeof(Format::FILE_ID));
+
+    header.formatVersion     = Format::FORMAT_VERSION;
+    header.byteOrderMark     = Format::BYTE_ORDER_MARK;
+    header.numMolecules      = num_mols;
+    header.numPharmacophores = getNumPharmacophores();
+    header.numFeatureTypes   = featureCounts.size();
+    header.molDataSize       = molDataSize;
+    header.pharmDataSize     = pharmDataSize;
+
+    writePadding(outStream, pharmDataSize);
+
+    molDataStream.close();
+
+    if (!molDataStream) {
+        discard();
+        throw Base::IOError("MappedPSDScreeningDBWriterImpl: error while writing molecule data");
+    }
+
+    if (molDataSize > 0) {
+        std::ifstream mol_data_is(tmpMolDataFileRemover->getPath().c_str(), std::ios_base::in | std::ios_base::binary);
+
+        outStream << mol_data_is.rdbuf();
+    }
+
+    writePadding(outStream, molDataSize);
+    writeTable(molDataOffsets);
+    writeTable(molPharmOffsets);
+    writeTable(pharmDataOffsets);
+    writeTable(pharmMolIndices);
+
+    for (auto& col : featureCounts) {
+        std::uint64_t type = col.first;
+
+        outStream.write(reinterpret_cast<const char*>(&type), sizeof(std::uint64_t));
+    }
+
+    for (auto& col : featureCounts) {
+        col.second.resize(num_mols, 0);
+
+        outStream.write(reinterpret_cast<const char*>(col.second.data()), std::streamsize(num_mols * sizeof(std::uint32_t)));
+    }
+
+    writePadding(outStream, featureCounts.size() * num_mols * sizeof(std::uint32_t));
+
+    outStream.seekp(0);
+    outStream.write(reinterpret_cast<const char*>(&header), sizeof(Format::Header));
+    outStream.close();
+
+    if (!outStream || !Util::renameFile(tmpFileRemover->getPath(), dbName)) {
+        discard();
+        throw Base::IOError("MappedPSDScreeningDBWriterImpl: error while writing database file");
+    }
+
+    tmpFileRemover->release();
+    discard();
+}
+
+void Pharm::MappedPSDScreeningDBWriterImpl::discard()
+{
+    if (outStream.is_open())
+        outStream.close();
+
+    if (molDataStream.is_open())
+        molDataStream.close();
+
+    outStream.clear();
+    molDataStream.clear();
+
+    tmpFileRemover.reset();
+    tmpMolDataFileRemover.reset();
+
+    dbName.clear();
+    molDataOffsets.clear();
+    molPharmOffsets.clear();
+    pharmDataOffsets.clear();
+    pharmMolIndices.clear();
+    featureCounts.clear();
+
+    pharmDataSize = 0;
+    molDataSize = 0;
+}
+
+bool Pharm::MappedPSDScreeningDBWriterImpl::isOpen() const
+{
+    return tmpFileRemover.get();
+}
+
+const std::string& Pharm::MappedPSDScreeningDBWriterImpl::getDatabaseName() const
+{
+    return dbName;
+}
+
+std::size_t Pharm::MappedPSDScreeningDBWriterImpl::getNumMolecules() const
+{
+    return (molDataOffsets.empty() ? 0 : molDataOffsets.size() - 1);
+}
+
+std::size_t Pharm::MappedPSDScreeningDBWriterImpl::getNumPharmacophores() const
+{
+    return pharmMolIndices.size();
+}
+
+void Pharm::MappedPSDScreeningDBWriterImpl::appendMolecule(const ScreeningDBAccessor& db_acc, std::size_t mol_idx)
+{
+    std::size_t new_mol_idx = getNumMolecules();
+    std::size_t num_pharms = db_acc.getNumPharmacophores(mol_idx);
+
+    db_acc.getMolecule(mol_idx, molecule);
+    molWriter.writeMolecularGraph(molecule, byteBuffer);
+
+    writeData(molDataStream, molDataSize, molDataOffsets);
+
+    for (std::size_t i = 0; i < num_pharms; i++) {
+        db_acc.getPharmacophore(mol_idx, i, pharmacophore);
+        pharmWriter.writeFeatureContainer(pharmacophore, byteBuffer);
+
+        writeData(outStream, pharmDataSize, pharmDataOffsets);
+        pharmMolIndices.push_back(new_mol_idx);
+    }
+
+    molPharmOffsets.push_back(pharmMolIndices.size());
+
+    if (num_pharms == 0)
+        return;
+
+    const FeatureTypeHistogram& ftr_counts = db_acc.getFeatureCounts(mol_idx, 0);
+
+    for (FeatureTypeHistogram::ConstEntryIterator it = ftr_counts.getEntriesBegin(), end = ftr_counts.getEntriesEnd(); it != end; ++it) {
+        if (it->second == 0)
+            continue;
+
+        UInt32Array& col = featureCounts[it->first];
+
+        col.resize(new_mol_idx + 1, 0);
+        col[new_mol_idx] = boost::numeric_cast<std::uint32_t>(it->second);
+    }
+}
+
+void Pharm::MappedPSDScreeningDBWriterImpl::writeData(std::ofstream& os, std::uint64_t& data_size, UInt64Array& offsets)
+{
+    byteBuffer.writeBuffer(os);
+
+    if (!os)
+        throw Base::IOError("MappedPSDScreeningDBWriterImpl: error while writing record data");
+
+    data_size += byteBuffer.getSize();
+    offsets.push_back(data_size);
+}
+
+void Pharm::MappedPSDScreeningDBWriterImpl::writePadding(std::ofstream& os, std::uint64_t size)
+{
+    static const char PADDING[8] = { 0 };
+
+    os.write(PADDING, std::streamsize(Format::getPaddedSize(size) - size));
+}
+
+void Pharm::MappedPSDScreeningDBWriterImpl::writeTable(const UInt64Array& table)
+{
+    outStream.write(reinterpret_cast<const char*>(table.data()), std::streamsize(table.size() * sizeof(std::uint64_t)));
+}
@@ -0,0 +1,114 @@
+/* 
+ * MappedPSDScreeningDBWriterImpl.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef CDPL_PHARM_MAPPEDPSDSCREENINGDBWRITERIMPL_HPP
+#define CDPL_PHARM_MAPPEDPSDSCREENINGDBWRITERIMPL_HPP
+
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <fstream>
+#include <cstddef>
+#include <cstdint>
+
+#include "CDPL/Pharm/MappedPSDScreeningDBWriter.hpp"
+#include "CDPL/Pharm/BasicPharmacophore.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Internal/ByteBuffer.hpp"
+
+#include "PSDFeatureContainerByteBufferWriter.hpp"
+#include "PSDMolecularGraphByteBufferWriter.hpp"
+
+
+namespace CDPL
+{
+
+    namespace Util
+    {
+
+        class FileRemover;
+    }
+
+    namespace Pharm
+    {
+
+        class MappedPSDScreeningDBWriterImpl
+        {
+
+          public:
+            MappedPSDScreeningDBWriterImpl();
+
+            ~MappedPSDScreeningDBWriterImpl();
+
+            void open(const std::string& name);
+
+            bool append(const ScreeningDBAccessor& db_acc, const MappedPSDScreeningDBWriter::ProgressCallbackFunction& func);
+
+            void close();
+
+            void discard();
+
+            bool isOpen() const;
+
+            const std::string& getDatabaseName() const;
+
+            std::size_t getNumMolecules() const;
+
+            std::size_t getNumPharmacophores() const;
+
+          private:
+            void appendMolecule(const ScreeningDBAccessor& db_acc, std::size_t mol_idx);
+
+            void writeData(std::ofstream& os, std::uint64_t& data_size, std::vector<std::uint64_t>& offsets);
+            void writePadding(std::ofstream& os, std::uint64_t size);
+            void writeTable(const std::vector<std::uint64_t>& table);
+
+            typedef std::unique_ptr<Util::FileRemover>        FileRemoverPtr;
+            typedef std::vector<std::uint64_t>                UInt64Array;
+            typedef std::vector<std::uint32_t>                UInt32Array;
+            typedef std::map<unsigned int, UInt32Array>       FeatureCountTable;
+
+            FileRemoverPtr                      tmpFileRemover;
+            FileRemoverPtr                      tmpMolDataFileRemover;
+            std::ofstream                       outStream;
+            std::ofstream                       molDataStream;
+            std::string                         dbName;
+            std::uint64_t                       pharmDataSize;
+            std::uint64_t                       molDataSize;
+            UInt64Array                         molDataOffsets;
+            UInt64Array                         molPharmOffsets;
+            UInt64Array                         pharmDataOffsets;
+            UInt64Array                         pharmMolIndices;
+            FeatureCountTable                   featureCounts;
+            Chem::BasicMolecule                 molecule;
+            BasicPharmacophore                  pharmacophore;
+            Internal::ByteBuffer                byteBuffer;
+            PSDFeatureContainerByteBufferWriter pharmWriter;
+            PSDMolecularGraphByteBufferWriter   molWriter;
+        };
+    } // namespace Pharm
+} // namespace CDPL
+
+#endif // CDPL_PHARM_MAPPEDPSDSCREENINGDBWRITERIMPL_HPP
@@ -119,3 +119,24 @@ const Pharm::FeatureTypeHistogram& Pharm::PSDScreeningDBAccessor::getFeatureCoun
 {
     return impl->getFeatureCounts(mol_idx, mol_conf_idx);
 }
+
+bool Pharm::PSDScreeningDBAccessor::hasTwoPointPharmacophoreIndex() const
+{
+    return impl->hasTwoPointPharmacophoreIndex();
+}
+
+void Pharm::PSDScreeningDBAccessor::getTwoPointPharmacophoreMatches(unsigned int ftr1_type, unsigned int ftr2_type, double min_dist,
+                                                                    double max_dist, Util::BitSet& pharm_set) const
+{
+    impl->getTwoPointPharmacophoreMatches(ftr1_type, ftr2_type, min_dist, max_dist, pharm_set);
+}
+
+Pharm::ScreeningDBAccessor::SharedPointer Pharm::PSDScreeningDBAccessor::clone() const
+{
+    const std::string& db_name = impl->getDatabaseName();
+
+    if (db_name.empty())
+        return SharedPointer(new PSDScreeningDBAccessor());
+
+    return SharedPointer(new PSDScreeningDBAccessor(db_name));
+}
@@ -28,6 +28,7 @@
 
 #include "PSDScreeningDBAccessorImpl.hpp"
 #include "PSDTableInfo.hpp"
+#include "PSDTwoPointPharmacophoreKeys.hpp"
 
 
 using namespace CDPL;
@@ -72,6 +73,16 @@ namespace
         "SELECT * FROM sqlite_master WHERE type = 'index' AND tbl_name = '" +
         Pharm::PSDTableInfo::FTR_COUNT_TABLE_NAME + "' AND name = '" +
         Pharm::PSDTableInfo::FTR_COUNT_TABLE_IDX_NAME + "';";
+
+    const std::string TWO_POINT_PHARM_TABLE_IDX_INFO_QUERY_SQL =
+        "SELECT * FROM sqlite_master WHERE type = 'index' AND tbl_name = '" +
+        Pharm::PSDTableInfo::TWO_POINT_PHARM_TABLE_NAME + "' AND name = '" +
+        Pharm::PSDTableInfo::TWO_POINT_PHARM_TABLE_IDX_NAME + "';";
+
+    const std::string TWO_POINT_PHARM_MATCHES_QUERY_SQL = "SELECT " +
+        Pharm::PSDTableInfo::PHARM_REFS_COLUMN_NAME + " FROM " +
+        Pharm::PSDTableInfo::TWO_POINT_PHARM_TABLE_NAME + " WHERE " +
+        Pharm::PSDTableInfo::PHARM_KEY_COLUMN_NAME + " BETWEEN ?1 AND ?2;";
 }
 
 
@@ -80,6 +91,7 @@ void Pharm::PSDScreeningDBAccessorImpl::open(const std::string& name)
     close();
     openDBConnection(name, SQLITE_OPEN_READONLY);
     checkForFtrCountsTableIndex();
+    checkForTwoPointPharmTableIndex();
 }
 
 void Pharm::PSDScreeningDBAccessorImpl::close()
@@ -94,6 +106,8 @@ void Pharm::PSDScreeningDBAccessorImpl::close()
     selAllFtrCountsStmt.reset();
     selMolIDFtrCountsStmt.reset();
     selFtrCountsTableIdxInfoStmt.reset();
+    sel2PointPharmTableIdxInfoStmt.reset();
+    sel2PointPharmMatchesStmt.reset();
     
     SQLiteDataIOBase::closeDBConnection();
 
@@ -170,9 +184,7 @@ void Pharm::PSDScreeningDBAccessorImpl::getMolecule(std::size_t mol_idx, Chem::M
     const void* blob = sqlite3_column_blob(selMolDataStmt.get(), 0);
     std::size_t num_bytes = sqlite3_column_bytes(selMolDataStmt.get(), 0);
 
-    byteBuffer.resize(0);
-    byteBuffer.setIOPointer(0);
-    byteBuffer.putBytes(reinterpret_cast<const char*>(blob), num_bytes);
+    byteBuffer.wrap(reinterpret_cast<const char*>(blob), num_bytes);
 
     molReader.readMolecule(byteBuffer, mol);
 }
@@ -303,6 +315,72 @@ const Pharm::FeatureTypeHistogram& Pharm::PSDScreeningDBAccessorImpl::getFeature
     return featureCounts[mol_idx];
 }
 
+bool Pharm::PSDScreeningDBAccessorImpl::hasTwoPointPharmacophoreIndex() const
+{
+    return (getDBConnection() && found2PointPharmTableIdx);
+}
+
+void Pharm::PSDScreeningDBAccessorImpl::getTwoPointPharmacophoreMatches(unsigned int ftr1_type, unsigned int ftr2_type, double min_dist,
+                                                                        double max_dist, Util::BitSet& pharm_set)
+{
+    using namespace PSDTwoPointPharmacophoreKeys;
+
+    if (!getDBConnection())
+        throw Base::IOError("PSDScreeningDBAccessorImpl: no open database connection");
+
+    initPharmIdxMolIDConfIdxMappings();
+
+    pharm_set.resize(pharmIdxToMolIDConfIdxMap.size());
+    pharm_set.reset();
+
+    if (!found2PointPharmTableIdx || !isIndexable(ftr1_type, ftr2_type)) {
+        pharm_set.set();
+        return;
+    }
+
+    if (max_dist < min_dist || max_dist < 0.0)
+        return;
+
+    setupStatement(sel2PointPharmMatchesStmt, TWO_POINT_PHARM_MATCHES_QUERY_SQL, true);
+
+    if (sqlite3_bind_int64(sel2PointPharmMatchesStmt.get(), 1, getKey(ftr1_type, ftr2_type, min_dist)) != SQLITE_OK)
+        throwSQLiteIOError("PSDScreeningDBAccessorImpl: error while binding two-point pharmacophore key to prepared statement");
+
+    if (sqlite3_bind_int64(sel2PointPharmMatchesStmt.get(), 2, getKey(ftr1_type, ftr2_type, max_dist)) != SQLITE_OK)
+        throwSQLiteIOError("PSDScreeningDBAccessorImpl: error while binding two-point pharmacophore key to prepared statement");
+
+    int res;
+
+    while ((res = sqlite3_step(sel2PointPharmMatchesStmt.get())) == SQLITE_ROW) {
+        const void* blob = sqlite3_column_blob(sel2PointPharmMatchesStmt.get(), 0);
+        std::size_t num_bytes = sqlite3_column_bytes(sel2PointPharmMatchesStmt.get(), 0);
+        std::int64_t mol_id = 0;
+
+        byteBuffer.wrap(reinterpret_cast<const char*>(blob), num_bytes);
+
+        while (byteBuffer.getIOPointer() < num_bytes) {
+            std::uint64_t mol_id_delta = 0;
+            std::uint64_t conf_idx = 0;
+
+            byteBuffer.getCompressedInt(mol_id_delta);
+            byteBuffer.getCompressedInt(conf_idx);
+
+            mol_id += mol_id_delta;
+
+            auto it = molIDConfIdxToPharmIdxMap.find(MolIDConfIdxPair(mol_id, conf_idx));
+
+            // references to pharmacophores of molecules that got replaced or deleted after indexing are stale
+            // and not an error
+
+            if (it != molIDConfIdxToPharmIdxMap.end())
+                pharm_set.set(it->second);
+        }
+    }
+
+    if (res != SQLITE_DONE)
+        throwSQLiteIOError("PSDScreeningDBAccessorImpl: error while loading two-point pharmacophore matches");
+}
+
 void Pharm::PSDScreeningDBAccessorImpl::loadPharmacophore(std::int64_t mol_id, int mol_conf_idx, Pharmacophore& pharm)
 {
     setupStatement(selPharmDataStmt, PHARM_DATA_QUERY_SQL, true);
@@ -324,9 +402,7 @@ void Pharm::PSDScreeningDBAccessorImpl::loadPharmacophore(std::int64_t mol_id, i
     const void* blob = sqlite3_column_blob(selPharmDataStmt.get(), 0);
     std::size_t num_bytes = sqlite3_column_bytes(selPharmDataStmt.get(), 0);
 
-    byteBuffer.resize(0);
-    byteBuffer.setIOPointer(0);
-    byteBuffer.putBytes(reinterpret_cast<const char*>(blob), num_bytes);
+    byteBuffer.wrap(reinterpret_cast<const char*>(blob), num_bytes);
 
     pharmReader.readPharmacophore(byteBuffer, pharm);
 } 
@@ -349,6 +425,23 @@ void Pharm::PSDScreeningDBAccessorImpl::checkForFtrCountsTableIndex()
         throwSQLiteIOError("PSDScreeningDBAccessorImpl: error while checking for the presence of a feature count table molecule ID index");
 }
 
+void Pharm::PSDScreeningDBAccessorImpl::checkForTwoPointPharmTableIndex()
+{
+    found2PointPharmTableIdx = false;
+    
+    setupStatement(sel2PointPharmTableIdxInfoStmt, TWO_POINT_PHARM_TABLE_IDX_INFO_QUERY_SQL, false);
+
+    int res = sqlite3_step(sel2PointPharmTableIdxInfoStmt.get());
+
+    if (res == SQLITE_ROW) {
+        found2PointPharmTableIdx = true;
+        return;
+    }
+
+    if (res != SQLITE_DONE)
+        throwSQLiteIOError("PSDScreeningDBAccessorImpl: error while checking for the presence of a two-point pharmacophore table index");
+}
+
 void Pharm::PSDScreeningDBAccessorImpl::initMolIdxIDMappings()
 {
     if (!molIdxToIDMap.empty())
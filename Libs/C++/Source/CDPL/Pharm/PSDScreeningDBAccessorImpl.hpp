@@ -35,6 +35,7 @@
 
 #include "CDPL/Pharm/SQLiteDataIOBase.hpp"
 #include "CDPL/Pharm/FeatureTypeHistogram.hpp"
+#include "CDPL/Util/BitSet.hpp"
 #include "CDPL/Internal/ByteBuffer.hpp"
 
 #include "PSDPharmacophoreByteBufferReader.hpp"
@@ -77,8 +78,14 @@ namespace CDPL
 
             const FeatureTypeHistogram& getFeatureCounts(std::size_t mol_idx, std::size_t mol_conf_idx);
 
+            bool hasTwoPointPharmacophoreIndex() const;
+
+            void getTwoPointPharmacophoreMatches(unsigned int ftr1_type, unsigned int ftr2_type, double min_dist, double max_dist,
+                                                 Util::BitSet& pharm_set);
+
           private:
             void checkForFtrCountsTableIndex();
+            void checkForTwoPointPharmTableIndex();
 
             void loadPharmacophore(std::int64_t mol_id, int conf_idx, Pharmacophore& pharm);
 
@@ -101,7 +108,10 @@ namespace CDPL
             SQLite3StmtPointer               selAllFtrCountsStmt;
             SQLite3StmtPointer               selMolIDFtrCountsStmt;
             SQLite3StmtPointer               selFtrCountsTableIdxInfoStmt;
+            SQLite3StmtPointer               sel2PointPharmTableIdxInfoStmt;
+            SQLite3StmtPointer               sel2PointPharmMatchesStmt;
             bool                             foundFtrCountsTableIdx;
+            bool                             found2PointPharmTableIdx;
             FeatureCountsArray               featureCounts;
             std::int64_t                     featureCountsMolID;
             MolIDArray                       molIdxToIDMap;
@@ -64,11 +64,36 @@ bool Pharm::PSDScreeningDBCreator::allowDuplicateEntries() const
     return impl->allowDuplicateEntries();
 }
 
+void Pharm::PSDScreeningDBCreator::createTwoPointPharmacophoreIndex(bool create)
+{
+    impl->createTwoPointPharmacophoreIndex(create);
+}
+
+bool Pharm::PSDScreeningDBCreator::twoPointPharmacophoreIndexCreated() const
+{
+    return impl->twoPointPharmacophoreIndexCreated();
+}
+
+void Pharm::PSDScreeningDBCreator::enableMultiThreading(bool enable)
+{
+    impl->enableMultiThreading(enable);
+}
+
+bool Pharm::PSDScreeningDBCreator::multiThreadingEnabled() const
+{
+    return impl->multiThreadingEnabled();
+}
+
 bool Pharm::PSDScreeningDBCreator::process(const Chem::MolecularGraph& molgraph)
 {
     return impl->process(molgraph);
 }
 
+void Pharm::PSDScreeningDBCreator::flush()
+{
+    impl->flush();
+}
+
 bool Pharm::PSDScreeningDBCreator::merge(const ScreeningDBAccessor& db_acc, const ProgressCallbackFunction& func)
 {
     return impl->merge(db_acc, func);
@@ -39,6 +39,7 @@
 
 #include "PSDScreeningDBCreatorImpl.hpp"
 #include "PSDTableInfo.hpp"
+#include "PSDTwoPointPharmacophoreKeys.hpp"
 
 
 using namespace CDPL;
@@ -85,6 +86,22 @@ namespace
     const std::string DROP_FTR_COUNT_TABLE_IDX_SQL = "DROP INDEX IF EXISTS " + 
         Pharm::PSDTableInfo::FTR_COUNT_TABLE_IDX_NAME + ";";
 
+    const std::string CREATE_TWO_POINT_PHARM_TABLE_SQL = "CREATE TABLE IF NOT EXISTS " + 
+        Pharm::PSDTableInfo::TWO_POINT_PHARM_TABLE_NAME + "(" + 
+        Pharm::PSDTableInfo::PHARM_KEY_COLUMN_NAME + " INTEGER, " + 
+        Pharm::PSDTableInfo::PHARM_REFS_COLUMN_NAME + " BLOB);";
+
+    const std::string CREATE_TWO_POINT_PHARM_TABLE_IDX_SQL = "CREATE INDEX IF NOT EXISTS " +
+        Pharm::PSDTableInfo::TWO_POINT_PHARM_TABLE_IDX_NAME + " ON " + 
+        Pharm::PSDTableInfo::TWO_POINT_PHARM_TABLE_NAME + "(" + 
+        Pharm::PSDTableInfo::PHARM_KEY_COLUMN_NAME + ");";
+
+    const std::string DROP_TWO_POINT_PHARM_TABLE_SQL = "DROP TABLE IF EXISTS " + 
+        Pharm::PSDTableInfo::TWO_POINT_PHARM_TABLE_NAME + ";";
+
+    const std::string DROP_TWO_POINT_PHARM_TABLE_IDX_SQL = "DROP INDEX IF EXISTS " + 
+        Pharm::PSDTableInfo::TWO_POINT_PHARM_TABLE_IDX_NAME + ";";
+
     const std::string CREATE_TABLES_SQL = 
         CREATE_MOL_TABLE_SQL +
         CREATE_PHARM_TABLE_SQL +
@@ -93,11 +110,21 @@ namespace
     const std::string DROP_TABLES_SQL =
         DROP_MOL_TABLE_SQL +
         DROP_PHARM_TABLE_SQL +
-        DROP_FTR_COUNT_TABLE_SQL;
+        DROP_FTR_COUNT_TABLE_SQL +
+        DROP_TWO_POINT_PHARM_TABLE_SQL;
 
     const std::string VACUUM_SQL = 
         "VACUUM;";
 
+    const std::string SCHEMA_OBJECT_INFO_QUERY_SQL =
+        "SELECT * FROM sqlite_master WHERE type = ?1 AND name = ?2;";
+
+    const std::string PHARM_DATA_QUERY_SQL = "SELECT " +
+        Pharm::PSDTableInfo::MOL_ID_COLUMN_NAME + ", " +
+        Pharm::PSDTableInfo::MOL_CONF_IDX_COLUMN_NAME + ", " +
+        Pharm::PSDTableInfo::PHARM_DATA_COLUMN_NAME + " FROM " +
+        Pharm::PSDTableInfo::PHARM_TABLE_NAME + ";";
+
     const std::string MOL_ID_AND_HASH_QUERY_SQL = "SELECT " +
         Pharm::PSDTableInfo::MOL_HASH_COLUMN_NAME + ", " +
         Pharm::PSDTableInfo::MOL_ID_COLUMN_NAME + " FROM " +
@@ -133,10 +160,19 @@ namespace
         Pharm::PSDTableInfo::FTR_TYPE_COLUMN_NAME + ", " +
         Pharm::PSDTableInfo::FTR_COUNT_COLUMN_NAME + ") VALUES (?1, 0, ?2, ?3);";
 
+    const std::string INSERT_TWO_POINT_PHARM_REFS_SQL = "INSERT INTO " +
+        Pharm::PSDTableInfo::TWO_POINT_PHARM_TABLE_NAME + "(" +
+        Pharm::PSDTableInfo::PHARM_KEY_COLUMN_NAME + ", " +
+        Pharm::PSDTableInfo::PHARM_REFS_COLUMN_NAME + ") VALUES (?1, ?2);";
+
     const std::string BEGIN_TRANSACTION_SQL    = "BEGIN TRANSACTION;";
     const std::string COMMIT_TRANSACTION_SQL   = "COMMIT TRANSACTION;";
     const std::string ROLLBACK_TRANSACTION_SQL = "ROLLBACK TRANSACTION;";
     
+    const std::size_t MAX_NUM_PENDING_TWO_POINT_PHARM_REFS = 2000000;
+    const std::size_t MAX_NUM_PENDING_ENTRIES              = 256;
+    const std::size_t MAX_WRITE_BATCH_SIZE                 = 128;
+
     const std::string SQLITE_OPEN_PRAGMAS = 
         "PRAGMA page_size = 4096;"
         "PRAGMA cache_size = 10000;"  
@@ -167,13 +203,22 @@ namespace
 
 
 Pharm::PSDScreeningDBCreatorImpl::PSDScreeningDBCreatorImpl():
-    pharmGenerator(), mode(ScreeningDBCreator::CREATE),
-    allowDupEntries(true), numProcessed(0), numRejected(0), numDeleted(0), numInserted(0)
+    mode(ScreeningDBCreator::CREATE), allowDupEntries(true), create2PointPharmIndex(false), have2PointPharmIndex(false),
+    multiThreading(false), numWritingEntries(0), stopWriting(false), numProcessed(0), numRejected(0), numDeleted(0),
+    numInserted(0)
 {}
 
 Pharm::PSDScreeningDBCreatorImpl::~PSDScreeningDBCreatorImpl()
 {
     if (getDBConnection()) {
+        try {
+            stopWriter();
+
+            if (have2PointPharmIndex)
+                finish2PointPharmIndex();
+
+        } catch (...) {}
+
         try {
             execStatements(CREATE_FTR_COUNT_TABLE_IDX_SQL);
         } catch (...) {}
@@ -190,6 +235,9 @@ void Pharm::PSDScreeningDBCreatorImpl::open(const std::string& name, ScreeningDB
   
     setupTables();
     loadMolHashToIDMap();
+
+    if (multiThreading)
+        startWriter();
 }
 
 void Pharm::PSDScreeningDBCreatorImpl::close()
@@ -197,6 +245,14 @@ void Pharm::PSDScreeningDBCreatorImpl::close()
     if (!getDBConnection())
         return;
 
+    stopWriter();
+
+    if (have2PointPharmIndex) {
+        try {
+            finish2PointPharmIndex();
+        } catch (const Base::IOError&) {}
+    }
+
     try {
         execStatements(CREATE_FTR_COUNT_TABLE_IDX_SQL);
     } catch (const Base::IOError&) {}
@@ -206,6 +262,7 @@ void Pharm::PSDScreeningDBCreatorImpl::close()
     insMoleculeStmt.reset();
     insPharmStmt.reset();
     insFtrCountStmt.reset();
+    ins2PointPharmRefsStmt.reset();
     delMolWithMolIDStmt.reset();
     delPharmsWithMolIDStmt.reset();
     delFeatureCountsWithMolIDStmt.reset();
@@ -218,6 +275,10 @@ void Pharm::PSDScreeningDBCreatorImpl::close()
     numRejected = 0;
     numDeleted = 0;
     numInserted = 0;
+    have2PointPharmIndex = false;
+    writerError = std::exception_ptr();
+
+    pending2PointPharmRefs.clear();
 }
 
 const std::string& Pharm::PSDScreeningDBCreatorImpl::getDatabaseName() const
@@ -235,23 +296,51 @@ bool Pharm::PSDScreeningDBCreatorImpl::allowDuplicateEntries() const
     return allowDupEntries;
 }
 
+void Pharm::PSDScreeningDBCreatorImpl::createTwoPointPharmacophoreIndex(bool create)
+{
+    create2PointPharmIndex = create;
+}
+
+bool Pharm::PSDScreeningDBCreatorImpl::twoPointPharmacophoreIndexCreated() const
+{
+    return create2PointPharmIndex;
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::enableMultiThreading(bool enable)
+{
+    multiThreading = enable;
+}
+
+bool Pharm::PSDScreeningDBCreatorImpl::multiThreadingEnabled() const
+{
+    return multiThreading;
+}
+
 std::size_t Pharm::PSDScreeningDBCreatorImpl::getNumProcessed() const
 {
+    std::lock_guard<std::mutex> lock(mutex);
+
     return numProcessed;
 }
 
 std::size_t Pharm::PSDScreeningDBCreatorImpl::getNumRejected() const
 {
+    std::lock_guard<std::mutex> lock(mutex);
+
     return numRejected;
 }
 
 std::size_t Pharm::PSDScreeningDBCreatorImpl::getNumDeleted() const
 {
+    std::lock_guard<std::mutex> lock(mutex);
+
     return numDeleted;
 }
 
 std::size_t Pharm::PSDScreeningDBCreatorImpl::getNumInserted() const
 {
+    std::lock_guard<std::mutex> lock(mutex);
+
     return numInserted;
 }
 
@@ -260,31 +349,26 @@ bool Pharm::PSDScreeningDBCreatorImpl::process(const Chem::MolecularGraph& molgr
     if (!getDBConnection())
         throw Base::IOError("PSDScreeningDBCreatorImpl: no open database connection");
 
-    numProcessed++;
+    if (writerThread.joinable())
+        return processConcurrently(molgraph);
 
-    std::uint64_t mol_hash = hashCalculator.calculate(molgraph);
+    numProcessed++;
 
-    if (!allowDupEntries) {
-        if (procMolecules.find(mol_hash) != procMolecules.end()) {
-            numRejected++;
-            return false;
-        }
+    std::uint64_t mol_hash = entryGenerator.hashCalculator.calculate(molgraph);
 
-        if (mode == ScreeningDBCreator::APPEND && molHashToIDMap.find(mol_hash) != molHashToIDMap.end()) {
-            numRejected++;
-            return false;
-        }
+    if (isDuplicate(mol_hash)) {
+        numRejected++;
+        return false;
     }
 
-    beginTransaction();
+    entryData.molHash = mol_hash;
 
-    TransactionRollback trb(getDBConnection().get());
-    std::size_t num_del = 0;
+    genEntryData(molgraph, entryGenerator, entryData);
 
-    if (mode == ScreeningDBCreator::UPDATE)
-        num_del = deleteEntries(mol_hash);
+    beginTransaction();
 
-    genAndInsertPharmData(molgraph, insertMolecule(molgraph, mol_hash));
+    TransactionRollback trb(getDBConnection().get());
+    std::size_t num_del = insertEntry(entryData);
 
     commitTransaction();
     trb.disable();
@@ -301,11 +385,25 @@ bool Pharm::PSDScreeningDBCreatorImpl::process(const Chem::MolecularGraph& molgr
     return true;
 }
 
+void Pharm::PSDScreeningDBCreatorImpl::flush()
+{
+    if (!writerThread.joinable())
+        return;
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    doneCondition.wait(lock, [this]() { return (pendingEntries.empty() && numWritingEntries == 0); });
+
+    checkWriterError();
+}
+
 bool  Pharm::PSDScreeningDBCreatorImpl::merge(const ScreeningDBAccessor& db_acc, const ScreeningDBCreator::ProgressCallbackFunction& func)
 {
     if (!getDBConnection())
         throw Base::IOError("PSDScreeningDBCreatorImpl: no open database connection");
 
+    flush();
+
     Chem::BasicMolecule mol;
     std::size_t num_mols = db_acc.getNumMolecules();
     std::size_t old_num_ins = numInserted;
@@ -320,45 +418,34 @@ bool  Pharm::PSDScreeningDBCreatorImpl::merge(const ScreeningDBAccessor& db_acc,
         calcAtomCIPConfigurations(mol, false);
         calcBondCIPConfigurations(mol, false);
 
-        auto mol_hash = hashCalculator.calculate(mol);
+        auto mol_hash = entryGenerator.hashCalculator.calculate(mol);
     
         numProcessed++;
 
-        if (!allowDupEntries) {
-            if (procMolecules.find(mol_hash) != procMolecules.end()) {
-                numRejected++;
-                continue;
-            }
-
-            if (mode == ScreeningDBCreator::APPEND && molHashToIDMap.find(mol_hash) != molHashToIDMap.end()) {
-                numRejected++;
-                continue;
-            }
+        if (isDuplicate(mol_hash)) {
+            numRejected++;
+            continue;
         }
 
-        beginTransaction();
-
-        TransactionRollback trb(getDBConnection().get());
-        std::size_t num_del = 0;
+        std::size_t num_pharms = db_acc.getNumPharmacophores(i);
 
-        if (mode == ScreeningDBCreator::UPDATE)
-            num_del = deleteEntries(mol_hash);
+        entryData.molHash = mol_hash;
+        entryData.numPharms = 0;
+        entryData.featureCounts.clear();
 
-        std::int64_t mol_id = insertMolecule(mol, mol_hash);
-        std::size_t num_pharms = db_acc.getNumPharmacophores(i);
+        entryGenerator.molWriter.writeMolecularGraph(mol, entryData.molData);
 
         for (std::size_t j = 0; j < num_pharms; j++) {
-            pharmacophore.clear();
-            db_acc.getPharmacophore(i, j, pharmacophore);
+            entryGenerator.pharmacophore.clear();
+            db_acc.getPharmacophore(i, j, entryGenerator.pharmacophore);
 
-            featureCounts = db_acc.getFeatureCounts(i, j);
-
-            insertPharmacophore(mol_id, j);
-            genFtrCounts();
-            mergeFtrCounts(j == 0);
+            addPharmacophore(entryGenerator.pharmacophore, entryGenerator, entryData);
         }
 
-        insertFtrCounts(mol_id);
+        beginTransaction();
+
+        TransactionRollback trb(getDBConnection().get());
+        std::size_t num_del = insertEntry(entryData);
  
         commitTransaction();
         trb.disable();
@@ -383,16 +470,32 @@ void Pharm::PSDScreeningDBCreatorImpl::setupTables()
 {
     execStatements(SQLITE_OPEN_PRAGMAS);
 
+    // an already present two-point pharmacophore index always needs to be kept in sync - the index
+    // gets created last and a table without it is a leftover of an unfinished run that has to be rebuilt
+
+    bool had_2pt_pharm_table = (mode != ScreeningDBCreator::CREATE && schemaObjectExists("table", PSDTableInfo::TWO_POINT_PHARM_TABLE_NAME));
+    bool valid_2pt_pharm_table = (had_2pt_pharm_table && schemaObjectExists("index", PSDTableInfo::TWO_POINT_PHARM_TABLE_IDX_NAME));
+
+    have2PointPharmIndex = (create2PointPharmIndex || had_2pt_pharm_table);
+    pending2PointPharmRefs.clear();
+
     beginTransaction();
     TransactionRollback trb(getDBConnection().get());
 
     execStatements(DROP_FTR_COUNT_TABLE_IDX_SQL);
-    
+    execStatements(DROP_TWO_POINT_PHARM_TABLE_IDX_SQL);
+
     if (mode == ScreeningDBCreator::CREATE)
         execStatements(DROP_TABLES_SQL);
 
+    else if (had_2pt_pharm_table && !valid_2pt_pharm_table)
+        execStatements(DROP_TWO_POINT_PHARM_TABLE_SQL);
+
     execStatements(CREATE_TABLES_SQL);
 
+    if (have2PointPharmIndex)
+        execStatements(CREATE_TWO_POINT_PHARM_TABLE_SQL);
+
     commitTransaction();
     trb.disable();
 
@@ -402,6 +505,63 @@ void Pharm::PSDScreeningDBCreatorImpl::setupTables()
 
     if (mode == ScreeningDBCreator::CREATE)
         execStatements(VACUUM_SQL);
+
+    else if (have2PointPharmIndex && !valid_2pt_pharm_table)
+        index2PointPharmacophores();
+}
+
+bool Pharm::PSDScreeningDBCreatorImpl::schemaObjectExists(const std::string& type, const std::string& name)
+{
+    SQLite3StmtPointer stmt_ptr;
+
+    setupStatement(stmt_ptr, SCHEMA_OBJECT_INFO_QUERY_SQL, false);
+
+    if (sqlite3_bind_text(stmt_ptr.get(), 1, type.c_str(), -1, SQLITE_STATIC) != SQLITE_OK)
+        throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while binding schema object type to prepared statement");
+
+    if (sqlite3_bind_text(stmt_ptr.get(), 2, name.c_str(), -1, SQLITE_STATIC) != SQLITE_OK)
+        throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while binding schema object name to prepared statement");
+
+    int res = sqlite3_step(stmt_ptr.get());
+
+    if (res == SQLITE_ROW)
+        return true;
+
+    if (res != SQLITE_DONE)
+        throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while checking for the presence of a schema object");
+
+    return false;
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::index2PointPharmacophores()
+{
+    SQLite3StmtPointer stmt_ptr;
+    PharmKeyList pharm_keys;
+    int res;
+
+    setupStatement(stmt_ptr, PHARM_DATA_QUERY_SQL, false);
+    beginTransaction();
+
+    TransactionRollback trb(getDBConnection().get());
+
+    while ((res = sqlite3_step(stmt_ptr.get())) == SQLITE_ROW) {
+        sqlite3_int64 mol_id = sqlite3_column_int64(stmt_ptr.get(), 0);
+        int conf_idx = sqlite3_column_int(stmt_ptr.get(), 1);
+        const void* blob = sqlite3_column_blob(stmt_ptr.get(), 2);
+        std::size_t num_bytes = sqlite3_column_bytes(stmt_ptr.get(), 2);
+
+        byteBuffer.wrap(reinterpret_cast<const char*>(blob), num_bytes);
+
+        gen2PointPharmKeys(byteBuffer, entryGenerator, pharm_keys);
+        add2PointPharmRefs(mol_id, conf_idx, pharm_keys);
+    }
+
+    if (res != SQLITE_DONE)
+        throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while indexing stored pharmacophores");
+
+    flush2PointPharmRefs();
+    commitTransaction();
+    trb.disable();
 }
 
 void Pharm::PSDScreeningDBCreatorImpl::loadMolHashToIDMap()
@@ -428,82 +588,370 @@ void Pharm::PSDScreeningDBCreatorImpl::loadMolHashToIDMap()
         throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while loading existing molecule IDs and hashes");
 }
 
-std::size_t Pharm::PSDScreeningDBCreatorImpl::deleteEntries(std::uint64_t mol_hash)
+bool Pharm::PSDScreeningDBCreatorImpl::processConcurrently(const Chem::MolecularGraph& molgraph)
 {
-    std::size_t num_del = 0;
-    std::pair<MolHashToIDMap::iterator, MolHashToIDMap::iterator> mols_with_hash = molHashToIDMap.equal_range(mol_hash);
+    // the entry data get generated by the calling thread - only the database insertions are
+    // performed by the writer thread
 
-    for (MolHashToIDMap::iterator it = mols_with_hash.first; it != mols_with_hash.second; ++it, num_del++) {
-        std::uint64_t mol_id = it->second;
-        
-        deleteRowsWithMolID(delMolWithMolIDStmt, DELETE_MOL_WITH_MOL_ID_SQL, mol_id);
-        deleteRowsWithMolID(delPharmsWithMolIDStmt, DELETE_PHARMS_WITH_MOL_ID_SQL, mol_id);
-        deleteRowsWithMolID(delFeatureCountsWithMolIDStmt, DELETE_FTR_COUNTS_WITH_MOL_ID_SQL, mol_id);
+    EntryGeneratorPtr gen = acquireEntryGenerator();
+    EntryDataPtr entry;
+
+    try {
+        std::uint64_t mol_hash = gen->hashCalculator.calculate(molgraph);
+
+        if (!acceptEntry(mol_hash, entry)) {
+            recycle(gen, entry);
+            return false;
+        }
+
+        genEntryData(molgraph, *gen, *entry);
+        queueEntry(entry);
+
+    } catch (...) {
+        // an accepted but not queued molecule must not be considered as already processed
+        // (as in single-threaded mode)
+
+        if (entry && !allowDupEntries) {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            procMolecules.erase(entry->molHash);
+        }
+
+        recycle(gen, entry);
+        throw;
     }
 
-    return num_del;
+    recycle(gen, entry);
+
+    return true;
 }
 
-std::int64_t Pharm::PSDScreeningDBCreatorImpl::insertMolecule(const Chem::MolecularGraph& molgraph, std::uint64_t mol_hash)
+bool Pharm::PSDScreeningDBCreatorImpl::isDuplicate(std::uint64_t mol_hash) const
 {
-    molWriter.writeMolecularGraph(molgraph, byteBuffer);
+    if (allowDupEntries)
+        return false;
 
-    setupStatement(insMoleculeStmt, INSERT_MOL_DATA_SQL, true);
+    if (procMolecules.find(mol_hash) != procMolecules.end())
+        return true;
 
-    if (sqlite3_bind_int64(insMoleculeStmt.get(), 1, mol_hash) != SQLITE_OK)
-        throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while binding molecule hashcode to prepared statement");
+    // in multithreaded mode, molHashToIDMap gets modified by the writer thread only in UPDATE mode
 
-    if (sqlite3_bind_blob(insMoleculeStmt.get(), 2, byteBuffer.getData(), boost::numeric_cast<int>(byteBuffer.getSize()),
-                          SQLITE_TRANSIENT) != SQLITE_OK)
-        throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while binding molecule data BLOB to prepared statement");
+    if (mode == ScreeningDBCreator::APPEND && molHashToIDMap.find(mol_hash) != molHashToIDMap.end())
+        return true;
 
-    evalStatement(insMoleculeStmt);
+    return false;
+}
 
-    return sqlite3_last_insert_rowid(getDBConnection().get());
+void Pharm::PSDScreeningDBCreatorImpl::startWriter()
+{
+    pendingEntries.clear();
+
+    numWritingEntries = 0;
+    stopWriting = false;
+    writerError = std::exception_ptr();
+
+    writerThread = std::thread(&PSDScreeningDBCreatorImpl::writeEntries, this);
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::stopWriter()
+{
+    if (!writerThread.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        stopWriting = true;
+    }
+
+    entryCondition.notify_one();
+    writerThread.join();
 }
 
-void Pharm::PSDScreeningDBCreatorImpl::genAndInsertPharmData(const Chem::MolecularGraph& molgraph, std::int64_t mol_id)
+void Pharm::PSDScreeningDBCreatorImpl::writeEntries()
 {
+    EntryDataList batch;
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true) {
+        entryCondition.wait(lock, [this]() { return (!pendingEntries.empty() || stopWriting); });
+
+        if (pendingEntries.empty())
+            return;
+
+        // the entries queued in the meantime get inserted in a single transaction
+
+        for (std::size_t i = 0; i < MAX_WRITE_BATCH_SIZE && !pendingEntries.empty(); i++) {
+            batch.push_back(std::move(pendingEntries.front()));
+            pendingEntries.pop_front();
+        }
+
+        numWritingEntries = batch.size();
+
+        spaceCondition.notify_all();
+
+        bool failed = static_cast<bool>(writerError);
+        std::size_t num_del = 0;
+
+        lock.unlock();
+
+        if (!failed) {
+            try {
+                beginTransaction();
+
+                TransactionRollback trb(getDBConnection().get());
+
+                for (auto& entry : batch)
+                    num_del += insertEntry(*entry);
+
+                commitTransaction();
+                trb.disable();
+
+            } catch (...) {
+                failed = true;
+
+                lock.lock();
+                writerError = std::current_exception();
+                lock.unlock();
+            }
+        }
+
+        lock.lock();
+
+        if (!failed) {
+            numDeleted += num_del;
+            numInserted += batch.size();
+
+            if (mode == ScreeningDBCreator::UPDATE)
+                for (auto& entry : batch)
+                    molHashToIDMap.erase(entry->molHash);
+        }
+
+        for (auto& entry : batch)
+            freeEntries.push_back(std::move(entry));
+
+        batch.clear();
+        numWritingEntries = 0;
+
+        doneCondition.notify_all();
+        spaceCondition.notify_all();
+    }
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::checkWriterError()
+{
+    if (writerError)
+        std::rethrow_exception(writerError);
+}
+
+Pharm::PSDScreeningDBCreatorImpl::EntryGeneratorPtr Pharm::PSDScreeningDBCreatorImpl::acquireEntryGenerator()
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (freeEntryGenerators.empty())
+        return EntryGeneratorPtr(new EntryGenerator());
+
+    EntryGeneratorPtr gen = std::move(freeEntryGenerators.back());
+
+    freeEntryGenerators.pop_back();
+
+    return gen;
+}
+
+bool Pharm::PSDScreeningDBCreatorImpl::acceptEntry(std::uint64_t mol_hash, EntryDataPtr& entry)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    checkWriterError();
+
+    numProcessed++;
+
+    if (isDuplicate(mol_hash)) {
+        numRejected++;
+        return false;
+    }
+
+    if (!allowDupEntries)
+        procMolecules.insert(mol_hash);
+
+    if (freeEntries.empty())
+        entry.reset(new EntryData());
+
+    else {
+        entry = std::move(freeEntries.back());
+        freeEntries.pop_back();
+    }
+
+    entry->molHash = mol_hash;
+
+    return true;
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::queueEntry(EntryDataPtr& entry)
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    spaceCondition.wait(lock, [this]() { return (pendingEntries.size() < MAX_NUM_PENDING_ENTRIES || writerError); });
+
+    checkWriterError();
+
+    pendingEntries.push_back(std::move(entry));
+    entryCondition.notify_one();
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::recycle(EntryGeneratorPtr& gen, EntryDataPtr& entry)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (gen)
+        freeEntryGenerators.push_back(std::move(gen));
+
+    if (entry)
+        freeEntries.push_back(std::move(entry));
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::genEntryData(const Chem::MolecularGraph& molgraph, EntryGenerator& gen, EntryData& entry) const
+{
+    gen.molWriter.writeMolecularGraph(molgraph, entry.molData);
+
+    entry.numPharms = 0;
+    entry.featureCounts.clear();
+
     std::size_t num_confs = getNumConformations(molgraph);
 
     if (num_confs == 0) {
         if (hasCoordinates(molgraph, 3)) {
-            coordinates.clear();
-            get3DCoordinates(molgraph, coordinates);
+            gen.coordinates.clear();
+            get3DCoordinates(molgraph, gen.coordinates);
+
+            gen.pharmGenerator.setAtom3DCoordinatesFunction(Chem::AtomArray3DCoordinatesFunctor(gen.coordinates, molgraph));
+            gen.pharmacophore.clear();
+            gen.pharmGenerator.generate(molgraph, gen.pharmacophore);
 
-            pharmGenerator.setAtom3DCoordinatesFunction(Chem::AtomArray3DCoordinatesFunctor(coordinates, molgraph));
-            genAndInsertPharmData(molgraph, mol_id, 0);
-            insertFtrCounts(mol_id);
+            addPharmacophore(gen.pharmacophore, gen, entry);
         }
 
         return;
     }
 
     for (std::size_t i = 0; i < num_confs; i++) {
-        coordinates.clear();
-        getConformation(molgraph, i, coordinates);
+        gen.coordinates.clear();
+        getConformation(molgraph, i, gen.coordinates);
 
-        pharmGenerator.setAtom3DCoordinatesFunction(Chem::AtomArray3DCoordinatesFunctor(coordinates, molgraph));
-        genAndInsertPharmData(molgraph, mol_id, i);
+        gen.pharmGenerator.setAtom3DCoordinatesFunction(Chem::AtomArray3DCoordinatesFunctor(gen.coordinates, molgraph));
+        gen.pharmacophore.clear();
+        gen.pharmGenerator.generate(molgraph, gen.pharmacophore);
+
+        addPharmacophore(gen.pharmacophore, gen, entry);
     }
+}
 
-    insertFtrCounts(mol_id);
+void Pharm::PSDScreeningDBCreatorImpl::addPharmacophore(const FeatureContainer& pharm, EntryGenerator& gen, EntryData& entry) const
+{
+    if (entry.pharmData.size() <= entry.numPharms) {
+        entry.pharmData.resize(entry.numPharms + 1);
+        entry.pharmKeys.resize(entry.numPharms + 1);
+    }
+
+    Internal::ByteBuffer& pharm_data = entry.pharmData[entry.numPharms];
+
+    gen.pharmWriter.writeFeatureContainer(pharm, pharm_data);
+
+    gen.tmpFeatureCounts.clear();
+    generateFeatureTypeHistogram(pharm, gen.tmpFeatureCounts);
+
+    if (entry.numPharms == 0)
+        entry.featureCounts = gen.tmpFeatureCounts;
+
+    else
+        for (auto& tcp : gen.tmpFeatureCounts)
+            entry.featureCounts[tcp.first] = std::max(entry.featureCounts[tcp.first], tcp.second);
+
+    if (have2PointPharmIndex)
+        gen2PointPharmKeys(pharm_data, gen, entry.pharmKeys[entry.numPharms]);
+
+    entry.numPharms++;
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::gen2PointPharmKeys(Internal::ByteBuffer& pharm_data, EntryGenerator& gen, PharmKeyList& keys) const
+{
+    // the keys get derived from the pharmacophore as stored (and later on retrieved by the screening
+    // processor) and not from the original, non-quantized feature positions
+
+    gen.storedPharmacophore.clear();
+    gen.pharmReader.readPharmacophore(pharm_data, gen.storedPharmacophore);
+
+    gen.twoPointPharms.clear();
+    gen.twoPointPharmGen.generate(gen.storedPharmacophore.getFeaturesBegin(), gen.storedPharmacophore.getFeaturesEnd(),
+                                  std::back_inserter(gen.twoPointPharms));
+
+    keys.clear();
+
+    for (auto& pharm : gen.twoPointPharms)
+        if (PSDTwoPointPharmacophoreKeys::isIndexable(pharm.getFeature1Type(), pharm.getFeature2Type()))
+            keys.push_back(PSDTwoPointPharmacophoreKeys::getKey(pharm.getFeature1Type(), pharm.getFeature2Type(),
+                                                                pharm.getFeatureDistance()));
+
+    std::sort(keys.begin(), keys.end());
+
+    keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+}
+
+std::size_t Pharm::PSDScreeningDBCreatorImpl::insertEntry(const EntryData& entry)
+{
+    std::size_t num_del = 0;
+
+    if (mode == ScreeningDBCreator::UPDATE)
+        num_del = deleteEntries(entry.molHash);
+
+    std::int64_t mol_id = insertMolecule(entry);
+
+    for (std::size_t i = 0; i < entry.numPharms; i++) {
+        insertPharmacophore(mol_id, i, entry.pharmData[i]);
+
+        if (have2PointPharmIndex)
+            add2PointPharmRefs(mol_id, i, entry.pharmKeys[i]);
+    }
+
+    insertFtrCounts(mol_id, entry.featureCounts);
+
+    return num_del;
 }
 
-void Pharm::PSDScreeningDBCreatorImpl::genAndInsertPharmData(const Chem::MolecularGraph& molgraph, std::int64_t mol_id, std::size_t conf_idx)
+std::size_t Pharm::PSDScreeningDBCreatorImpl::deleteEntries(std::uint64_t mol_hash)
 {
-    pharmacophore.clear();
-    pharmGenerator.generate(molgraph, pharmacophore);
+    std::size_t num_del = 0;
+    std::pair<MolHashToIDMap::iterator, MolHashToIDMap::iterator> mols_with_hash = molHashToIDMap.equal_range(mol_hash);
+
+    for (MolHashToIDMap::iterator it = mols_with_hash.first; it != mols_with_hash.second; ++it, num_del++) {
+        std::uint64_t mol_id = it->second;
+        
+        deleteRowsWithMolID(delMolWithMolIDStmt, DELETE_MOL_WITH_MOL_ID_SQL, mol_id);
+        deleteRowsWithMolID(delPharmsWithMolIDStmt, DELETE_PHARMS_WITH_MOL_ID_SQL, mol_id);
+        deleteRowsWithMolID(delFeatureCountsWithMolIDStmt, DELETE_FTR_COUNTS_WITH_MOL_ID_SQL, mol_id);
+    }
 
-    insertPharmacophore(mol_id, conf_idx);
-    genFtrCounts();
-    mergeFtrCounts(conf_idx == 0);
+    return num_del;
 }
 
-void Pharm::PSDScreeningDBCreatorImpl::insertPharmacophore(std::int64_t mol_id, std::size_t conf_idx)
+std::int64_t Pharm::PSDScreeningDBCreatorImpl::insertMolecule(const EntryData& entry)
 {
-    pharmWriter.writeFeatureContainer(pharmacophore, byteBuffer);
+    setupStatement(insMoleculeStmt, INSERT_MOL_DATA_SQL, true);
+
+    if (sqlite3_bind_int64(insMoleculeStmt.get(), 1, entry.molHash) != SQLITE_OK)
+        throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while binding molecule hashcode to prepared statement");
 
+    if (sqlite3_bind_blob(insMoleculeStmt.get(), 2, entry.molData.getData(), boost::numeric_cast<int>(entry.molData.getSize()),
+                          SQLITE_TRANSIENT) != SQLITE_OK)
+        throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while binding molecule data BLOB to prepared statement");
+
+    evalStatement(insMoleculeStmt);
+
+    return sqlite3_last_insert_rowid(getDBConnection().get());
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::insertPharmacophore(std::int64_t mol_id, std::size_t conf_idx, const Internal::ByteBuffer& pharm_data)
+{
     setupStatement(insPharmStmt, INSERT_PHARM_DATA_SQL, true);
 
     if (sqlite3_bind_int64(insPharmStmt.get(), 1, mol_id) != SQLITE_OK)
@@ -512,33 +960,75 @@ void Pharm::PSDScreeningDBCreatorImpl::insertPharmacophore(std::int64_t mol_id,
     if (sqlite3_bind_int(insPharmStmt.get(), 2, boost::numeric_cast<int>(conf_idx)) != SQLITE_OK)
         throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while binding pharmacophore conf. index to prepared statement");
 
-    if (sqlite3_bind_blob(insPharmStmt.get(), 3, byteBuffer.getData(), boost::numeric_cast<int>(byteBuffer.getSize()),
+    if (sqlite3_bind_blob(insPharmStmt.get(), 3, pharm_data.getData(), boost::numeric_cast<int>(pharm_data.getSize()),
                           SQLITE_TRANSIENT) != SQLITE_OK)
         throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while binding pharmacophore data BLOB to prepared statement");
 
     evalStatement(insPharmStmt);
 }
 
-void Pharm::PSDScreeningDBCreatorImpl::genFtrCounts()
+void Pharm::PSDScreeningDBCreatorImpl::add2PointPharmRefs(std::int64_t mol_id, std::size_t conf_idx, const PharmKeyList& keys)
 {
-    tmpFeatureCounts.clear();
-    generateFeatureTypeHistogram(pharmacophore, tmpFeatureCounts);
+    for (auto key : keys)
+        pending2PointPharmRefs.emplace_back(key, mol_id, conf_idx);
+
+    if (pending2PointPharmRefs.size() >= MAX_NUM_PENDING_TWO_POINT_PHARM_REFS)
+        flush2PointPharmRefs();
 }
 
-void Pharm::PSDScreeningDBCreatorImpl::mergeFtrCounts(bool init)
+void Pharm::PSDScreeningDBCreatorImpl::flush2PointPharmRefs()
 {
-    if (init) {
-        featureCounts = tmpFeatureCounts;
-        return;
+    // the pending references get written as one row per key holding a BLOB with the delta-encoded
+    // list of the referenced (molecule ID, conformer index) pairs in ascending order
+
+    std::sort(pending2PointPharmRefs.begin(), pending2PointPharmRefs.end());
+
+    for (TwoPointPharmRefList::const_iterator it = pending2PointPharmRefs.begin(), end = pending2PointPharmRefs.end(); it != end; ) {
+        std::int64_t key = std::get<0>(*it);
+        std::int64_t last_mol_id = 0;
+
+        refsByteBuffer.setIOPointer(0);
+
+        for ( ; it != end && std::get<0>(*it) == key; ++it) {
+            refsByteBuffer.putCompressedInt(std::uint64_t(std::get<1>(*it) - last_mol_id));
+            refsByteBuffer.putCompressedInt(std::uint64_t(std::get<2>(*it)));
+
+            last_mol_id = std::get<1>(*it);
+        }
+
+        setupStatement(ins2PointPharmRefsStmt, INSERT_TWO_POINT_PHARM_REFS_SQL, true);
+
+        if (sqlite3_bind_int64(ins2PointPharmRefsStmt.get(), 1, key) != SQLITE_OK)
+            throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while binding two-point pharmacophore key to prepared statement");
+
+        if (sqlite3_bind_blob(ins2PointPharmRefsStmt.get(), 2, refsByteBuffer.getData(), boost::numeric_cast<int>(refsByteBuffer.getIOPointer()), 
+                              SQLITE_STATIC) != SQLITE_OK)
+            throwSQLiteIOError("PSDScreeningDBCreatorImpl: error while binding two-point pharmacophore references BLOB to prepared statement");
+
+        evalStatement(ins2PointPharmRefsStmt);
+    }
+
+    pending2PointPharmRefs.clear();
+}
+
+void Pharm::PSDScreeningDBCreatorImpl::finish2PointPharmIndex()
+{
+    if (!pending2PointPharmRefs.empty()) {
+        beginTransaction();
+
+        TransactionRollback trb(getDBConnection().get());
+
+        flush2PointPharmRefs();
+        commitTransaction();
+        trb.disable();
     }
 
-    for (auto& tcp : tmpFeatureCounts)
-        featureCounts[tcp.first] = std::max(featureCounts[tcp.first], tcp.second);
+    execStatements(CREATE_TWO_POINT_PHARM_TABLE_IDX_SQL);
 }
 
-void Pharm::PSDScreeningDBCreatorImpl::insertFtrCounts(std::int64_t mol_id)
+void Pharm::PSDScreeningDBCreatorImpl::insertFtrCounts(std::int64_t mol_id, const FeatureTypeHistogram& ftr_counts)
 {
-    for (FeatureTypeHistogram::ConstEntryIterator it = featureCounts.getEntriesBegin(), end = featureCounts.getEntriesEnd(); it != end; ++it)
+    for (FeatureTypeHistogram::ConstEntryIterator it = ftr_counts.getEntriesBegin(), end = ftr_counts.getEntriesEnd(); it != end; ++it)
         insertFtrCount(mol_id, it->first, it->second);
 }
 
@@ -25,6 +25,14 @@
 #ifndef CDPL_PHARM_PSDSCREENINGDBCREATORIMPL_HPP
 #define CDPL_PHARM_PSDSCREENINGDBCREATORIMPL_HPP
 
+#include <vector>
+#include <deque>
+#include <tuple>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -33,12 +41,15 @@
 #include "CDPL/Pharm/BasicPharmacophore.hpp"
 #include "CDPL/Pharm/DefaultPharmacophoreGenerator.hpp"
 #include "CDPL/Pharm/FeatureTypeHistogram.hpp"
+#include "CDPL/Pharm/TwoPointPharmacophore.hpp"
+#include "CDPL/Pharm/TwoPointPharmacophoreGenerator.hpp"
 #include "CDPL/Chem/HashCodeCalculator.hpp"
 #include "CDPL/Math/VectorArray.hpp"
 #include "CDPL/Internal/ByteBuffer.hpp"
 
 #include "PSDFeatureContainerByteBufferWriter.hpp"
 #include "PSDMolecularGraphByteBufferWriter.hpp"
+#include "PSDPharmacophoreByteBufferReader.hpp"
 
 
 namespace CDPL
@@ -67,8 +78,18 @@ namespace CDPL
 
             bool allowDuplicateEntries() const;
 
+            void createTwoPointPharmacophoreIndex(bool create);
+
+            bool twoPointPharmacophoreIndexCreated() const;
+
+            void enableMultiThreading(bool enable);
+
+            bool multiThreadingEnabled() const;
+
             bool process(const Chem::MolecularGraph& molgraph);
 
+            void flush();
+
             bool merge(const ScreeningDBAccessor& db_acc, const ScreeningDBCreator::ProgressCallbackFunction& func);
 
             std::size_t getNumProcessed() const;
@@ -80,22 +101,89 @@ namespace CDPL
             std::size_t getNumInserted() const;
 
           private:
+            typedef std::vector<std::int64_t>                             PharmKeyList;
+            typedef std::vector<TwoPointPharmacophore>                    TwoPointPharmacophoreList;
+            typedef TwoPointPharmacophoreGenerator<TwoPointPharmacophore> TwoPointPharmGenerator;
+
+            struct EntryGenerator
+            {
+
+                Chem::HashCodeCalculator            hashCalculator;
+                PSDFeatureContainerByteBufferWriter pharmWriter;
+                PSDMolecularGraphByteBufferWriter   molWriter;
+                PSDPharmacophoreByteBufferReader    pharmReader;
+                DefaultPharmacophoreGenerator       pharmGenerator;
+                BasicPharmacophore                  pharmacophore;
+                BasicPharmacophore                  storedPharmacophore;
+                TwoPointPharmGenerator              twoPointPharmGen;
+                TwoPointPharmacophoreList           twoPointPharms;
+                FeatureTypeHistogram                tmpFeatureCounts;
+                Math::Vector3DArray                 coordinates;
+            };
+
+            typedef std::vector<Internal::ByteBuffer> ByteBufferArray;
+            typedef std::vector<PharmKeyList>         PharmKeyListArray;
+
+            struct EntryData
+            {
+
+                std::uint64_t        molHash;
+                Internal::ByteBuffer molData;
+                std::size_t          numPharms;
+                ByteBufferArray      pharmData;
+                PharmKeyListArray    pharmKeys;
+                FeatureTypeHistogram featureCounts;
+            };
+
+            typedef std::unique_ptr<EntryGenerator> EntryGeneratorPtr;
+            typedef std::unique_ptr<EntryData>      EntryDataPtr;
+
             void setupTables();
 
+            bool schemaObjectExists(const std::string& type, const std::string& name);
+
+            void index2PointPharmacophores();
+
             void loadMolHashToIDMap();
 
+            bool processConcurrently(const Chem::MolecularGraph& molgraph);
+
+            bool isDuplicate(std::uint64_t mol_hash) const;
+
+            void startWriter();
+            void stopWriter();
+
+            void writeEntries();
+
+            void checkWriterError();
+
+            EntryGeneratorPtr acquireEntryGenerator();
+
+            bool acceptEntry(std::uint64_t mol_hash, EntryDataPtr& entry);
+
+            void queueEntry(EntryDataPtr& entry);
+
+            void recycle(EntryGeneratorPtr& gen, EntryDataPtr& entry);
+
+            void genEntryData(const Chem::MolecularGraph& molgraph, EntryGenerator& gen, EntryData& entry) const;
+
+            void addPharmacophore(const FeatureContainer& pharm, EntryGenerator& gen, EntryData& entry) const;
+
+            void gen2PointPharmKeys(Internal::ByteBuffer& pharm_data, EntryGenerator& gen, PharmKeyList& keys) const;
+
+            std::size_t insertEntry(const EntryData& entry);
+
             std::size_t deleteEntries(std::uint64_t mol_hash);
 
-            std::int64_t insertMolecule(const Chem::MolecularGraph& molgraph, std::uint64_t mol_hash);
+            std::int64_t insertMolecule(const EntryData& entry);
 
-            void genAndInsertPharmData(const Chem::MolecularGraph& molgraph, std::int64_t mol_id);
-            void genAndInsertPharmData(const Chem::MolecularGraph& molgraph, std::int64_t mol_id, std::size_t conf_idx);
+            void insertPharmacophore(std::int64_t mol_id, std::size_t conf_idx, const Internal::ByteBuffer& pharm_data);
 
-            void insertPharmacophore(std::int64_t mol_id, std::size_t conf_idx);
+            void add2PointPharmRefs(std::int64_t mol_id, std::size_t conf_idx, const PharmKeyList& keys);
+            void flush2PointPharmRefs();
+            void finish2PointPharmIndex();
 
-            void genFtrCounts();
-            void mergeFtrCounts(bool init);
-            void insertFtrCounts(std::int64_t mol_id);
+            void insertFtrCounts(std::int64_t mol_id, const FeatureTypeHistogram& ftr_counts);
             void insertFtrCount(std::int64_t mol_id, unsigned int ftr_type, std::size_t ftr_count);
 
             void deleteRowsWithMolID(SQLite3StmtPointer& stmt_ptr, const std::string& sql_stmt, std::int64_t mol_id) const;
@@ -105,12 +193,18 @@ namespace CDPL
        
             typedef std::unordered_multimap<std::uint64_t, std::int64_t> MolHashToIDMap;
             typedef std::unordered_set<std::uint64_t>                    MolHashSet;
+            typedef std::tuple<std::int64_t, std::int64_t, std::size_t>  TwoPointPharmRef;
+            typedef std::vector<TwoPointPharmRef>                        TwoPointPharmRefList;
+            typedef std::vector<EntryGeneratorPtr>                       EntryGeneratorList;
+            typedef std::vector<EntryDataPtr>                            EntryDataList;
+            typedef std::deque<EntryDataPtr>                             EntryDataQueue;
 
             SQLite3StmtPointer                  beginTransStmt;
             SQLite3StmtPointer                  commitTransStmt;
             SQLite3StmtPointer                  insMoleculeStmt;
             SQLite3StmtPointer                  insPharmStmt;
             SQLite3StmtPointer                  insFtrCountStmt;
+            SQLite3StmtPointer                  ins2PointPharmRefsStmt;
             SQLite3StmtPointer                  delMolWithMolIDStmt;
             SQLite3StmtPointer                  delPharmsWithMolIDStmt;
             SQLite3StmtPointer                  delFeatureCountsWithMolIDStmt;
@@ -118,17 +212,27 @@ namespace CDPL
             SQLite3StmtPointer                  delThreePointPharmsWithMolIDStmt;
             MolHashToIDMap                      molHashToIDMap;
             MolHashSet                          procMolecules;
-            Chem::HashCodeCalculator            hashCalculator;
+            EntryGenerator                      entryGenerator;
+            EntryData                           entryData;
             Internal::ByteBuffer                byteBuffer;
-            PSDFeatureContainerByteBufferWriter pharmWriter;
-            PSDMolecularGraphByteBufferWriter   molWriter;
-            BasicPharmacophore                  pharmacophore;
-            DefaultPharmacophoreGenerator       pharmGenerator;
-            FeatureTypeHistogram                featureCounts;
-            FeatureTypeHistogram                tmpFeatureCounts;
-            Math::Vector3DArray                 coordinates;
+            TwoPointPharmRefList                pending2PointPharmRefs;
+            Internal::ByteBuffer                refsByteBuffer;
             ScreeningDBCreator::Mode            mode;
             bool                                allowDupEntries;
+            bool                                create2PointPharmIndex;
+            bool                                have2PointPharmIndex;
+            bool                                multiThreading;
+            std::thread                         writerThread;
+            mutable std::mutex                  mutex;
+            std::condition_variable             entryCondition;
+            std::condition_variable             spaceCondition;
+            std::condition_variable             doneCondition;
+            EntryDataQueue                      pendingEntries;
+            EntryDataList                       freeEntries;
+            EntryGeneratorList                  freeEntryGenerators;
+            std::size_t                         numWritingEntries;
+            bool                                stopWriting;
+            std::exception_ptr                  writerError;
             std::size_t                         numProcessed;
             std::size_t                         numRejected;
             std::size_t                         numDeleted;
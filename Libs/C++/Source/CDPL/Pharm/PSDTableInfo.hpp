@@ -37,10 +37,12 @@ namespace CDPL
         namespace PSDTableInfo
         {
 
-            const std::string MOL_TABLE_NAME           = "molecules";
-            const std::string PHARM_TABLE_NAME         = "pharmacophores";
-            const std::string FTR_COUNT_TABLE_NAME     = "ftr_counts";
-            const std::string FTR_COUNT_TABLE_IDX_NAME = "ftr_counts_idx";
+            const std::string MOL_TABLE_NAME                 = "molecules";
+            const std::string PHARM_TABLE_NAME               = "pharmacophores";
+            const std::string FTR_COUNT_TABLE_NAME           = "ftr_counts";
+            const std::string FTR_COUNT_TABLE_IDX_NAME       = "ftr_counts_idx";
+            const std::string TWO_POINT_PHARM_TABLE_NAME     = "two_point_pharms";
+            const std::string TWO_POINT_PHARM_TABLE_IDX_NAME = "two_point_pharms_idx";
 
             const std::string MOL_ID_COLUMN_NAME       = "mol_id";
             const std::string MOL_HASH_COLUMN_NAME     = "mol_hash";
@@ -51,6 +53,9 @@ namespace CDPL
 
             const std::string FTR_TYPE_COLUMN_NAME  = "ftr_type";
             const std::string FTR_COUNT_COLUMN_NAME = "ftr_count";
+
+            const std::string PHARM_KEY_COLUMN_NAME  = "pharm_key";
+            const std::string PHARM_REFS_COLUMN_NAME = "pharm_refs";
         } // namespace PSDTableInfo
     } // namespace Pharm
 } // namespace CDPL
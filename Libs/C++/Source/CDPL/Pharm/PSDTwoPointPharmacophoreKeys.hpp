@@ -0,0 +1,89 @@
+/* 
+ * PSDTwoPointPharmacophoreKeys.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#ifndef CDPL_PHARM_PSDTWOPOINTPHARMACOPHOREKEYS_HPP
+#define CDPL_PHARM_PSDTWOPOINTPHARMACOPHOREKEYS_HPP
+
+#include <cstdint>
+#include <cmath>
+#include <utility>
+
+
+namespace CDPL
+{
+
+    namespace Pharm
+    {
+
+        /*
+         * Integer keys of the two-point pharmacophore index stored in PSD files. A key encodes
+         * the (canonically ordered) types of the two features and the bin of their distance in
+         * such a way that all keys of a given feature type pair and a contiguous distance range
+         * form a contiguous key range.
+         */
+        namespace PSDTwoPointPharmacophoreKeys
+        {
+
+            constexpr double        DISTANCE_BIN_WIDTH = 1.0;
+            constexpr unsigned int  FEATURE_TYPE_BITS  = 20;
+            constexpr unsigned int  DISTANCE_BIN_BITS  = 20;
+            constexpr std::uint64_t MAX_FEATURE_TYPE   = (std::uint64_t(1) << FEATURE_TYPE_BITS) - 1;
+            constexpr std::uint64_t MAX_DISTANCE_BIN   = (std::uint64_t(1) << DISTANCE_BIN_BITS) - 1;
+
+            inline bool isIndexable(unsigned int ftr1_type, unsigned int ftr2_type)
+            {
+                return (ftr1_type <= MAX_FEATURE_TYPE && ftr2_type <= MAX_FEATURE_TYPE);
+            }
+
+            inline std::uint64_t getDistanceBin(double dist)
+            {
+                if (!(dist > 0.0))
+                    return 0;
+
+                double bin = std::floor(dist / DISTANCE_BIN_WIDTH);
+
+                if (bin >= double(MAX_DISTANCE_BIN))
+                    return MAX_DISTANCE_BIN;
+
+                return std::uint64_t(bin);
+            }
+
+            inline std::int64_t getKey(unsigned int ftr1_type, unsigned int ftr2_type, std::uint64_t dist_bin)
+            {
+                if (ftr1_type > ftr2_type)
+                    std::swap(ftr1_type, ftr2_type);
+
+                return std::int64_t((std::uint64_t(ftr1_type) << (FEATURE_TYPE_BITS + DISTANCE_BIN_BITS)) |
+                                    (std::uint64_t(ftr2_type) << DISTANCE_BIN_BITS) | dist_bin);
+            }
+
+            inline std::int64_t getKey(unsigned int ftr1_type, unsigned int ftr2_type, double dist)
+            {
+                return getKey(ftr1_type, ftr2_type, getDistanceBin(dist));
+            }
+        } // namespace PSDTwoPointPharmacophoreKeys
+    } // namespace Pharm
+} // namespace CDPL
+
+#endif // CDPL_PHARM_PSDTWOPOINTPHARMACOPHOREKEYS_HPP
@@ -38,6 +38,7 @@
 #include "CDPL/Chem/Entity3DFunctions.hpp"
 #include "CDPL/Math/SVDecomposition.hpp"
 #include "CDPL/Base/Exceptions.hpp"
+#include "CDPL/Internal/SubstructureQueryState.hpp"
 
 
 namespace
@@ -50,6 +51,34 @@ namespace
 using namespace CDPL; 
 
 
+class Pharm::PatternBasedFeatureGenerator::PatternSearch
+{
+
+  public:
+    void init(const Chem::MolecularGraph& ptn_molgraph, Chem::SubstructureScreeningKeyGenerator& key_gen) {
+        if (!queryState.update(ptn_molgraph)) // unmodified query molecular graph
+            return;
+
+        subSearch.setQuery(ptn_molgraph);
+        key_gen.generateQueryKeys(ptn_molgraph, queryKeys);
+    }
+
+    Chem::SubstructureSearch         subSearch;
+    Util::BitSet                     queryKeys;
+    Internal::SubstructureQueryState queryState;
+};
+
+
+Pharm::PatternBasedFeatureGenerator::IncludePattern::IncludePattern(const Chem::MolecularGraph::SharedPointer& molgraph, unsigned int type,
+                                                                    double tol, unsigned int geom, double length):
+    molGraph(molgraph), search(new PatternSearch()), featureType(type), featureTol(tol), featureGeom(geom), vectorLength(length)
+{}
+
+Pharm::PatternBasedFeatureGenerator::ExcludePattern::ExcludePattern(const Chem::MolecularGraph::SharedPointer& molgraph):
+    molGraph(molgraph), search(new PatternSearch())
+{}
+
+
 Pharm::PatternBasedFeatureGenerator::PatternBasedFeatureGenerator():
     bitSetCache(MAX_BIT_SET_CACHE_SIZE)
 {}
@@ -101,10 +130,17 @@ void Pharm::PatternBasedFeatureGenerator::generate(const Chem:: MolecularGraph&
     for (IncludePatternList::const_iterator p_it = includePatterns.begin(), p_end = includePatterns.end(); p_it != p_end; ++p_it) {
         const IncludePattern& ptn = *p_it;
 
-        ptn.subSearch->findMappings(molgraph);
+        ptn.search->init(*ptn.molGraph, keyGenerator);
+
+        if (!ptn.search->queryKeys.is_subset_of(molGraphKeys))
+            continue;
+
+        SubstructureSearch& sub_search = ptn.search->subSearch;
+
+        sub_search.findMappings(molgraph);
 
-        for (SubstructureSearch::ConstMappingIterator m_it = ptn.subSearch->getMappingsBegin(),
-                 m_end = ptn.subSearch->getMappingsEnd(); m_it != m_end; ++m_it) {
+        for (SubstructureSearch::ConstMappingIterator m_it = sub_search.getMappingsBegin(),
+                 m_end = sub_search.getMappingsEnd(); m_it != m_end; ++m_it) {
 
             const AtomBondMapping& mapping = *m_it;
 
@@ -312,10 +348,17 @@ void Pharm::PatternBasedFeatureGenerator::getExcludeMatches()
     for (ExcludePatternList::const_iterator p_it = excludePatterns.begin(), p_end = excludePatterns.end(); p_it != p_end; ++p_it) {
         const ExcludePattern& x_ptn = *p_it;
 
-        x_ptn.subSearch->findMappings(*molGraph);
+        x_ptn.search->init(*x_ptn.molGraph, keyGenerator);
 
-        for (SubstructureSearch::ConstMappingIterator m_it = x_ptn.subSearch->getMappingsBegin(), 
-                 m_end = x_ptn.subSearch->getMappingsEnd(); m_it != m_end; ++m_it) {
+        if (!x_ptn.search->queryKeys.is_subset_of(molGraphKeys))
+            continue;
+
+        SubstructureSearch& sub_search = x_ptn.search->subSearch;
+
+        sub_search.findMappings(*molGraph);
+
+        for (SubstructureSearch::ConstMappingIterator m_it = sub_search.getMappingsBegin(), 
+                 m_end = sub_search.getMappingsEnd(); m_it != m_end; ++m_it) {
 
             Util::BitSet* atom_mask = bitSetCache.get();
             const AtomMapping& atom_mapping = m_it->getAtomMapping();
@@ -382,4 +425,6 @@ void Pharm::PatternBasedFeatureGenerator::init(const Chem::MolecularGraph& molgr
     excludeMatches.clear();
 
     bitSetCache.putAll();
+
+    keyGenerator.generate(molgraph, molGraphKeys);
 }
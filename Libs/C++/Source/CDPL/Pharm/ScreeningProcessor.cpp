@@ -38,7 +38,14 @@ Pharm::ScreeningProcessor::SearchHit::SearchHit(const ScreeningProcessor& hit_pr
                                                 const FeatureContainer& hit_pharm, const Chem::Molecule& mol, 
                                                 const Math::Matrix4D& xform, std::size_t pharm_idx, 
                                                 std::size_t mol_idx, std::size_t conf_idx):
-    provider(&hit_prov), qryPharm(&qry_pharm), hitPharm(&hit_pharm), molecule(&mol),
+    provider(&hit_prov), dbAccessor(&hit_prov.getDBAccessor()), qryPharm(&qry_pharm), hitPharm(&hit_pharm), molecule(&mol),
+    almntTransform(&xform), pharmIndex(pharm_idx), molIndex(mol_idx), confIndex(conf_idx) {}
+
+Pharm::ScreeningProcessor::SearchHit::SearchHit(const ScreeningProcessor& hit_prov, const ScreeningDBAccessor& db_acc,
+                                                const FeatureContainer& qry_pharm, const FeatureContainer& hit_pharm,
+                                                const Chem::Molecule& mol, const Math::Matrix4D& xform, std::size_t pharm_idx, 
+                                                std::size_t mol_idx, std::size_t conf_idx):
+    provider(&hit_prov), dbAccessor(&db_acc), qryPharm(&qry_pharm), hitPharm(&hit_pharm), molecule(&mol),
     almntTransform(&xform), pharmIndex(pharm_idx), molIndex(mol_idx), confIndex(conf_idx) {}
 
 const Pharm::ScreeningProcessor& Pharm::ScreeningProcessor::SearchHit::getHitProvider() const
@@ -46,6 +53,11 @@ const Pharm::ScreeningProcessor& Pharm::ScreeningProcessor::SearchHit::getHitPro
     return *provider;
 }
 
+const Pharm::ScreeningDBAccessor& Pharm::ScreeningProcessor::SearchHit::getDBAccessor() const
+{
+    return *dbAccessor;
+}
+
 const Pharm::FeatureContainer& Pharm::ScreeningProcessor::SearchHit::getQueryPharmacophore() const
 {
     return *qryPharm;
@@ -170,6 +182,16 @@ const Pharm::ScreeningProcessor::ScoringFunction& Pharm::ScreeningProcessor::get
     return impl->getScoringFunction();
 }
 
+void Pharm::ScreeningProcessor::setNumThreads(std::size_t num_threads)
+{
+    impl->setNumThreads(num_threads);
+}
+
+std::size_t Pharm::ScreeningProcessor::getNumThreads() const
+{
+    return impl->getNumThreads();
+}
+
 std::size_t Pharm::ScreeningProcessor::searchDB(const FeatureContainer& query, std::size_t mol_start_idx, std::size_t mol_end_idx)
 {
     return impl->searchDB(query, mol_start_idx, mol_end_idx);
@@ -28,6 +28,8 @@
 #include <limits>
 #include <cmath>
 #include <iterator>
+#include <algorithm>
+#include <thread>
 #include <cassert>
 
 #include "CDPL/Pharm/ScreeningDBAccessor.hpp"
@@ -69,7 +71,8 @@ namespace
 Pharm::ScreeningProcessorImpl::ScreeningProcessorImpl(ScreeningProcessor& parent, ScreeningDBAccessor& db_acc): 
     parent(&parent), dbAccessor(&db_acc), reportMode(ScreeningProcessor::FIRST_MATCHING_CONF), maxOmittedFeatures(0),
     checkXVolumes(true), bestAlignments(false), hitCallback(), progressCallback(), 
-    scoringFunction(PharmacophoreFitScreeningScore()), featureGeomMatchFunction(), pharmAlignment(true)
+    scoringFunction(PharmacophoreFitScreeningScore()), featureGeomMatchFunction(), pharmAlignment(true),
+    numThreads(0), parSearchData(0)
 {
     pharmAlignment.setTopAlignmentConstraintFunction(
         [this](const Util::STPairArray& mapping) -> bool { return checkTopologicalMapping(mapping); });
@@ -80,6 +83,8 @@ Pharm::ScreeningProcessorImpl::ScreeningProcessorImpl(ScreeningProcessor& parent
 void Pharm::ScreeningProcessorImpl::setDBAccessor(ScreeningDBAccessor& db_acc)
 {
     dbAccessor = &db_acc;
+
+    workers.clear();
 }
 
 Pharm::ScreeningDBAccessor& Pharm::ScreeningProcessorImpl::getDBAccessor() const
@@ -157,6 +162,16 @@ const Pharm::ScreeningProcessor::ScoringFunction& Pharm::ScreeningProcessorImpl:
     return scoringFunction;
 }
 
+void Pharm::ScreeningProcessorImpl::setNumThreads(std::size_t num_threads)
+{
+    numThreads = num_threads;
+}
+
+std::size_t Pharm::ScreeningProcessorImpl::getNumThreads() const
+{
+    return numThreads;
+}
+
 std::size_t Pharm::ScreeningProcessorImpl::searchDB(const FeatureContainer& query, std::size_t mol_start_idx, 
                                                     std::size_t mol_end_idx)
 {
@@ -164,6 +179,9 @@ std::size_t Pharm::ScreeningProcessorImpl::searchDB(const FeatureContainer& quer
 
     std::size_t num_pharm_entries = pharmIndices.size();
 
+    if (numThreads > 1 && num_pharm_entries > 0 && initWorkers())
+        return searchDBParallel();
+
     for (std::size_t i = 0; i <= num_pharm_entries; i++) {
         if (progressCallback && !progressCallback(i, num_pharm_entries))
             return numHits;
@@ -171,7 +189,7 @@ std::size_t Pharm::ScreeningProcessorImpl::searchDB(const FeatureContainer& quer
         if (reportMode == ScreeningProcessor::BEST_MATCHING_CONF && !std::isnan(bestConfAlmntScore) &&
             (i == num_pharm_entries || pharmIndices[i].second != bestConfAlmntMolIdx)) {
             
-            if (!reportHit(SearchHit(*parent, query, dbPharmacophore, dbMolecule, bestConfAlmntTransform,
+            if (!reportHit(SearchHit(*parent, *dbAccessor, query, dbPharmacophore, dbMolecule, bestConfAlmntTransform,
                                      bestConfAlmntPharmIdx, bestConfAlmntMolIdx, bestConfAlmntConfIdx),
                            bestConfAlmntScore))
                 return numHits;
@@ -207,7 +225,13 @@ void Pharm::ScreeningProcessorImpl::prepareDBSearch(const FeatureContainer& quer
                                                     std::size_t mol_end_idx)
 {
     initQueryData(query);
+    initSearchState();
+    initPharmIndexList(mol_start_idx, mol_end_idx);
+    filterPharmIndexList();
+}
 
+void Pharm::ScreeningProcessorImpl::initSearchState()
+{
     numHits = 0;
     loadedPharmIndex = dbAccessor->getNumPharmacophores();
     loadedMolIndex = dbAccessor->getNumMolecules();
@@ -218,8 +242,6 @@ void Pharm::ScreeningProcessorImpl::prepareDBSearch(const FeatureContainer& quer
 
     } else if (reportMode == ScreeningProcessor::BEST_MATCHING_CONF)
         bestConfAlmntScore = NAN_SCORE;
-
-    initPharmIndexList(mol_start_idx, mol_end_idx);
 }
 
 void Pharm::ScreeningProcessorImpl::initQueryData(const FeatureContainer& query)
@@ -335,6 +357,206 @@ void Pharm::ScreeningProcessorImpl::initPharmIndexList(std::size_t mol_start_idx
     std::sort(pharmIndices.begin(), pharmIndices.end(), IndexPair2ndCmpFunc());
 }
 
+void Pharm::ScreeningProcessorImpl::filterPharmIndexList()
+{
+    if (minNum2PointPharmMatches == 0 || pharmIndices.empty() || !dbAccessor->hasTwoPointPharmacophoreIndex())
+        return;
+
+    // count for each database pharmacophore the number of query two-point pharmacophores for which the
+    // index reports a potential match - pharmacophores with too few potential matches cannot pass
+    // check2PointPharmacophores() and thus do not need to be loaded at all
+
+    pharm2PointMatchCounts.assign(dbAccessor->getNumPharmacophores(), 0);
+
+    for (TwoPointPharmacophoreList::const_iterator it = query2PointPharmList.begin(), end = query2PointPharmList.end(); it != end; ++it) {
+        const QueryTwoPointPharmacophore& query_2pt_pharm = *it;
+
+        double min_dist = query_2pt_pharm.getFeatureDistance() - query_2pt_pharm.getFeature1Tolerance() 
+            - query_2pt_pharm.getFeature2Tolerance();
+        double max_dist = query_2pt_pharm.getFeatureDistance() + query_2pt_pharm.getFeature1Tolerance() 
+            + query_2pt_pharm.getFeature2Tolerance();
+
+        dbAccessor->getTwoPointPharmacophoreMatches(query_2pt_pharm.getFeature1Type(), query_2pt_pharm.getFeature2Type(),
+                                                    min_dist, max_dist, pharm2PointMatchSet);
+
+        for (Util::BitSet::size_type i = pharm2PointMatchSet.find_first(); i != Util::BitSet::npos; i = pharm2PointMatchSet.find_next(i))
+            if (i < pharm2PointMatchCounts.size())
+                pharm2PointMatchCounts[i]++;
+    }
+
+    pharmIndices.erase(std::remove_if(pharmIndices.begin(), pharmIndices.end(),
+                                      [this](const IndexPair& idx_pair) {
+                                          return (pharm2PointMatchCounts[idx_pair.first] < minNum2PointPharmMatches);
+                                      }),
+                       pharmIndices.end());
+}
+
+std::size_t Pharm::ScreeningProcessorImpl::searchDBParallel()
+{
+    ParallelSearchData data;
+
+    data.pharmIndices = &pharmIndices;
+    data.molEntryOffsets = &molEntryOffsets;
+    data.hitCallback = &hitCallback;
+    data.progressCallback = &progressCallback;
+    data.nextMolecule = 0;
+    data.abort = false;
+    data.numProcEntries = 0;
+
+    for (auto& worker : workers)
+        worker->prepareParallelSearch(*this, data);
+
+    parSearchData = &data;
+
+    std::vector<std::thread> threads;
+
+    try {
+        for (auto& worker : workers)
+            threads.emplace_back(&ScreeningProcessorImpl::searchMolecules, worker.get());
+
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(data.mutex);
+
+        data.exception = std::current_exception();
+        data.abort = true;
+    }
+
+    searchMolecules();
+
+    for (auto& thread : threads)
+        thread.join();
+
+    parSearchData = 0;
+
+    for (auto& worker : workers) {
+        worker->parSearchData = 0;
+        worker->scoringFunction = ScoringFunction();
+
+        numHits += worker->numHits;
+    }
+
+    if (data.exception)
+        std::rethrow_exception(data.exception);
+
+    return numHits;
+}
+
+bool Pharm::ScreeningProcessorImpl::initWorkers()
+{
+    molEntryOffsets.clear();
+
+    for (std::size_t i = 0, num_pharm_entries = pharmIndices.size(); i < num_pharm_entries; i++)
+        if (i == 0 || pharmIndices[i].second != pharmIndices[i - 1].second)
+            molEntryOffsets.push_back(i);
+
+    molEntryOffsets.push_back(pharmIndices.size());
+
+    // the calling thread takes part in the search
+
+    std::size_t num_workers = std::min(numThreads, molEntryOffsets.size() - 1) - 1;
+
+    if (!workers.empty() && workers.front()->dbAccessor->getDatabaseName() != dbAccessor->getDatabaseName())
+        workers.clear();
+
+    if (workers.size() > num_workers)
+        workers.resize(num_workers);
+
+    while (workers.size() < num_workers) {
+        DBAccessorPointer db_acc = dbAccessor->clone();
+
+        if (!db_acc) {    // accessor does not support cloning -> search single-threaded
+            workers.clear();
+            return false;
+        }
+
+        workers.emplace_back(new ScreeningProcessorImpl(*parent, *db_acc));
+        workers.back()->workerDBAccessor = db_acc;
+    }
+
+    return !workers.empty();
+}
+
+void Pharm::ScreeningProcessorImpl::prepareParallelSearch(const ScreeningProcessorImpl& master, ParallelSearchData& data)
+{
+    reportMode = master.reportMode;
+    maxOmittedFeatures = master.maxOmittedFeatures;
+    checkXVolumes = master.checkXVolumes;
+    bestAlignments = master.bestAlignments;
+    scoringFunction = master.scoringFunction;
+    parSearchData = &data;
+
+    initQueryData(*master.queryPharmacophore);
+    initSearchState();
+}
+
+void Pharm::ScreeningProcessorImpl::searchMolecules()
+{
+    ParallelSearchData& data = *parSearchData;
+    std::size_t num_mols = data.molEntryOffsets->size() - 1;
+    std::size_t num_pharm_entries = data.pharmIndices->size();
+
+    try {
+        while (!data.abort) {
+            std::size_t mol_idx = data.nextMolecule++;
+
+            if (mol_idx >= num_mols)
+                return;
+
+            std::size_t start_idx = (*data.molEntryOffsets)[mol_idx];
+            std::size_t end_idx = (*data.molEntryOffsets)[mol_idx + 1];
+
+            if (!screenMolecule(*data.pharmIndices, start_idx, end_idx))
+                return;
+
+            if (!*data.progressCallback)
+                continue;
+
+            std::lock_guard<std::mutex> lock(data.mutex);
+
+            data.numProcEntries += end_idx - start_idx;
+
+            if (!data.abort && !(*data.progressCallback)(data.numProcEntries, num_pharm_entries))
+                data.abort = true;
+        }
+
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(data.mutex);
+
+        if (!data.exception)
+            data.exception = std::current_exception();
+
+        data.abort = true;
+    }
+}
+
+bool Pharm::ScreeningProcessorImpl::screenMolecule(const IndexPairList& pharm_indices, std::size_t start_idx, std::size_t end_idx)
+{
+    for (std::size_t i = start_idx; i < end_idx; i++) {
+        std::size_t mol_idx = pharm_indices[i].second;
+
+        if (reportMode == ScreeningProcessor::FIRST_MATCHING_CONF && molHitSet.test(mol_idx)) 
+            break;
+
+        std::size_t pharm_idx = pharm_indices[i].first;
+
+        if (!checkFeatureCounts(pharm_idx))
+            continue;
+
+        if (!check2PointPharmacophores(pharm_idx))
+            continue;
+
+        if (!performAlignment(pharm_idx, mol_idx))
+            return false;
+    }
+
+    if (reportMode == ScreeningProcessor::BEST_MATCHING_CONF && !std::isnan(bestConfAlmntScore))
+        return reportHit(SearchHit(*parent, *dbAccessor, *queryPharmacophore, dbPharmacophore, dbMolecule, bestConfAlmntTransform,
+                                   bestConfAlmntPharmIdx, bestConfAlmntMolIdx, bestConfAlmntConfIdx),
+                         bestConfAlmntScore);
+
+    return true;
+}
+
 bool Pharm::ScreeningProcessorImpl::checkFeatureCounts(std::size_t pharm_idx) const
 {
     const FeatureTypeHistogram& db_ftr_cnts = dbAccessor->getFeatureCounts(pharm_idx);
@@ -429,7 +651,7 @@ bool Pharm::ScreeningProcessorImpl::performAlignment(std::size_t pharm_idx, std:
         if (!checkXVolumeClashes(mol_idx, conf_idx))
             continue;
 
-        SearchHit hit(*parent, *queryPharmacophore, dbPharmacophore, dbMolecule, 
+        SearchHit hit(*parent, *dbAccessor, *queryPharmacophore, dbPharmacophore, dbMolecule, 
                       pharmAlignment.getTransform(), pharm_idx, mol_idx, conf_idx);
         double score = calcScore(hit);
 
@@ -443,7 +665,7 @@ bool Pharm::ScreeningProcessorImpl::performAlignment(std::size_t pharm_idx, std:
     }
 
     if (!std::isnan(best_score))
-        return processHit(SearchHit(*parent, *queryPharmacophore, dbPharmacophore, dbMolecule, 
+        return processHit(SearchHit(*parent, *dbAccessor, *queryPharmacophore, dbPharmacophore, dbMolecule, 
                                     bestAlmntTransform, pharm_idx, mol_idx, conf_idx), best_score);
 
     return true;
@@ -691,6 +913,9 @@ bool Pharm::ScreeningProcessorImpl::reportHit(const SearchHit& hit, double score
     } else if (reportMode == ScreeningProcessor::BEST_MATCHING_CONF) 
         bestConfAlmntScore = NAN_SCORE;
 
+    if (parSearchData)
+        return reportHitSynchronized(hit, score);
+
     if (!hitCallback)
         return true;
 
@@ -700,6 +925,28 @@ bool Pharm::ScreeningProcessorImpl::reportHit(const SearchHit& hit, double score
     return hitCallback(hit, score);
 }
 
+bool Pharm::ScreeningProcessorImpl::reportHitSynchronized(const SearchHit& hit, double score)
+{
+    const HitCallbackFunction& callback = *parSearchData->hitCallback;
+
+    if (!callback)
+        return !parSearchData->abort;
+
+    loadMolecule(hit.getHitMoleculeIndex());
+    loadPharmacophore(hit.getHitPharmacophoreIndex());
+
+    std::lock_guard<std::mutex> lock(parSearchData->mutex);
+
+    if (parSearchData->abort)
+        return false;
+
+    if (callback(hit, score))
+        return true;
+
+    parSearchData->abort = true;
+    return false;
+}
+
 const Math::Vector3D& Pharm::ScreeningProcessorImpl::getFeatureCoordinates(const Feature& ftr)
 {
     if (&ftr.getPharmacophore() == queryPharmacophore)
@@ -28,10 +28,15 @@
 #include <vector>
 #include <utility>
 #include <unordered_map>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#include <exception>
 
 #include <boost/iterator/indirect_iterator.hpp>
 
 #include "CDPL/Pharm/ScreeningProcessor.hpp"
+#include "CDPL/Pharm/ScreeningDBAccessor.hpp"
 #include "CDPL/Pharm/PharmacophoreAlignment.hpp"
 #include "CDPL/Pharm/FeatureTypeHistogram.hpp"
 #include "CDPL/Pharm/BasicPharmacophore.hpp"
@@ -52,7 +57,6 @@ namespace CDPL
     namespace Pharm
     {
 
-        class ScreeningDBAccessor;
         class FeatureMapping;
 
         class ScreeningProcessorImpl
@@ -98,6 +102,10 @@ namespace CDPL
 
             const ScoringFunction& getScoringFunction() const;
 
+            void setNumThreads(std::size_t num_threads);
+
+            std::size_t getNumThreads() const;
+
             std::size_t searchDB(const FeatureContainer& query, std::size_t mol_start_idx, std::size_t mol_end_idx);
 
           private:
@@ -125,10 +133,38 @@ namespace CDPL
                 }
             };
 
+            typedef std::unique_ptr<ScreeningProcessorImpl>  ImplementationPointer;
+            typedef std::vector<ImplementationPointer>       ImplementationList;
+            typedef ScreeningDBAccessor::SharedPointer       DBAccessorPointer;
+
+            struct ParallelSearchData
+            {
+
+                const IndexPairList*            pharmIndices;
+                const IndexList*                molEntryOffsets;
+                const HitCallbackFunction*      hitCallback;
+                const ProgressCallbackFunction* progressCallback;
+                std::atomic<std::size_t>        nextMolecule;
+                std::atomic<bool>               abort;
+                std::mutex                      mutex;
+                std::size_t                     numProcEntries;
+                std::exception_ptr              exception;
+            };
+
             void prepareDBSearch(const FeatureContainer& query, std::size_t mol_start_idx, std::size_t mol_end_idx);
 
             void initQueryData(const FeatureContainer& query);
+            void initSearchState();
             void initPharmIndexList(std::size_t mol_start_idx, std::size_t mol_end_idx);
+            void filterPharmIndexList();
+
+            std::size_t searchDBParallel();
+
+            bool initWorkers();
+            void prepareParallelSearch(const ScreeningProcessorImpl& master, ParallelSearchData& data);
+
+            void searchMolecules();
+            bool screenMolecule(const IndexPairList& pharm_indices, std::size_t start_idx, std::size_t end_idx);
 
             void insertFeature(const Feature& ftr, FeatureMatrix& ftr_mtx) const;
 
@@ -151,6 +187,7 @@ namespace CDPL
 
             bool processHit(const SearchHit& hit, double score);
             bool reportHit(const SearchHit& hit, double score);
+            bool reportHitSynchronized(const SearchHit& hit, double score);
 
             ScreeningProcessor*               parent;
             ScreeningDBAccessor*              dbAccessor;
@@ -187,6 +224,8 @@ namespace CDPL
             TypeToFeatureListMap              dbFeaturesByType;
             bool                              initDBFeaturesByType;
             IndexPairList                     pharmIndices;
+            IndexList                         pharm2PointMatchCounts;
+            Util::BitSet                      pharm2PointMatchSet;
             Util::BitSet                      molHitSet;
             Util::BitSet                      mappedDBFeatures;
             std::size_t                       numHits;
@@ -198,6 +237,11 @@ namespace CDPL
             std::size_t                       bestConfAlmntConfIdx;
             std::size_t                       bestConfAlmntPharmIdx;
             double                            bestConfAlmntScore;
+            std::size_t                       numThreads;
+            ImplementationList                workers;
+            DBAccessorPointer                 workerDBAccessor;
+            IndexList                         molEntryOffsets;
+            ParallelSearchData*               parSearchData;
         };
     } // namespace Pharm
 } // namespace CDPL
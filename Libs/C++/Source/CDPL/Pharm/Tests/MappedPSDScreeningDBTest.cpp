@@ -0,0 +1,194 @@
+/* 
+ * MappedPSDScreeningDBTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstdlib>
+#include <fstream>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/Pharm/MappedPSDScreeningDBAccessor.hpp"
+#include "CDPL/Pharm/MappedPSDScreeningDBWriter.hpp"
+#include "CDPL/Pharm/PSDScreeningDBAccessor.hpp"
+#include "CDPL/Pharm/PSDScreeningDBCreator.hpp"
+#include "CDPL/Pharm/BasicPharmacophore.hpp"
+#include "CDPL/Pharm/FeatureTypeHistogram.hpp"
+#include "CDPL/Pharm/FeatureFunctions.hpp"
+#include "CDPL/Pharm/MoleculeFunctions.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/SDFMoleculeReader.hpp"
+#include "CDPL/Chem/AtomContainerFunctions.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Chem/Entity3DFunctions.hpp"
+#include "CDPL/Chem/Entity3DContainerFunctions.hpp"
+#include "CDPL/Math/VectorArray.hpp"
+#include "CDPL/Util/FileDataReader.hpp"
+#include "CDPL/Util/FileFunctions.hpp"
+#include "CDPL/Util/FileRemover.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+
+namespace
+{
+
+    void checkEqual(const CDPL::Pharm::ScreeningDBAccessor& db_acc1, const CDPL::Pharm::ScreeningDBAccessor& db_acc2)
+    {
+        using namespace CDPL;
+
+        BOOST_CHECK(db_acc1.getNumMolecules() == db_acc2.getNumMolecules());
+        BOOST_CHECK(db_acc1.getNumPharmacophores() == db_acc2.getNumPharmacophores());
+
+        Chem::BasicMolecule mol1, mol2;
+        Pharm::BasicPharmacophore pharm1, pharm2;
+
+        for (std::size_t i = 0, num_mols = db_acc1.getNumMolecules(); i < num_mols; i++) {
+            db_acc1.getMolecule(i, mol1);
+            db_acc2.getMolecule(i, mol2);
+
+            BOOST_CHECK(Chem::getName(mol1) == Chem::getName(mol2));
+            BOOST_CHECK(mol1.getNumAtoms() == mol2.getNumAtoms());
+            BOOST_CHECK(mol1.getNumBonds() == mol2.getNumBonds());
+            BOOST_CHECK(Chem::getNumConformations(mol1) == Chem::getNumConformations(mol2));
+
+            std::size_t num_pharms = db_acc1.getNumPharmacophores(i);
+
+            BOOST_CHECK(db_acc2.getNumPharmacophores(i) == num_pharms);
+
+            for (std::size_t j = 0; j < num_pharms; j++) {
+                db_acc1.getPharmacophore(i, j, pharm1);
+                db_acc2.getPharmacophore(i, j, pharm2);
+
+                BOOST_CHECK(pharm1.getNumFeatures() == pharm2.getNumFeatures());
+
+                for (std::size_t k = 0; k < pharm1.getNumFeatures(); k++) {
+                    BOOST_CHECK(Pharm::getType(pharm1.getFeature(k)) == Pharm::getType(pharm2.getFeature(k)));
+                    BOOST_CHECK(Chem::get3DCoordinates(pharm1.getFeature(k)) == Chem::get3DCoordinates(pharm2.getFeature(k)));
+                }
+
+                BOOST_CHECK(db_acc1.getFeatureCounts(i, j) == db_acc2.getFeatureCounts(i, j));
+            }
+        }
+
+        for (std::size_t i = 0, num_pharms = db_acc2.getNumPharmacophores(); i < num_pharms; i++) {
+            std::size_t mol_idx = db_acc2.getMoleculeIndex(i);
+            std::size_t conf_idx = db_acc2.getConformationIndex(i);
+
+            BOOST_CHECK(conf_idx < db_acc2.getNumPharmacophores(mol_idx));
+
+            db_acc2.getPharmacophore(i, pharm1);
+            db_acc2.getPharmacophore(mol_idx, conf_idx, pharm2);
+
+            BOOST_CHECK(pharm1.getNumFeatures() == pharm2.getNumFeatures());
+            BOOST_CHECK(db_acc2.getFeatureCounts(i) == db_acc1.getFeatureCounts(mol_idx, conf_idx));
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(MappedPSDScreeningDBTest)
+{
+    using namespace CDPL;
+    using namespace Pharm;
+
+    Util::FileRemover psd_file_rem(Util::genCheckedTempFilePath());
+    Util::FileRemover mpsd_file_rem(Util::genCheckedTempFilePath());
+    Util::FileDataReader<Chem::SDFMoleculeReader> mol_reader(std::string(std::getenv("CDPKIT_TEST_DATA_DIR")) + "/CDK2_actives.sdf");
+    Chem::BasicMolecule mol;
+    Math::Vector3DArray coords;
+
+    {
+        PSDScreeningDBCreator db_creator(psd_file_rem.getPath());
+
+        for (std::size_t i = 0; i < 30 && mol_reader.read(mol); i++) {
+            prepareForPharmacophoreGeneration(mol);
+            calcAtomCIPConfigurations(mol, false);
+            calcBondCIPConfigurations(mol, false);
+
+            get3DCoordinates(mol, coords);
+            clearConformations(mol);
+
+            // molecules get between one and three conformers
+
+            for (std::size_t j = 0; j <= i % 3; j++) {
+                addConformation(mol, coords);
+
+                for (std::size_t k = 0; k < coords.getSize(); k++)
+                    coords[k](1) += 3.0;
+            }
+
+            db_creator.process(mol);
+        }
+    }
+
+    PSDScreeningDBAccessor psd_acc(psd_file_rem.getPath());
+
+    BOOST_CHECK(psd_acc.getNumMolecules() > 20);
+
+    MappedPSDScreeningDBWriter db_writer;
+
+    BOOST_CHECK(!db_writer.isOpen());
+    BOOST_CHECK_THROW(db_writer.append(psd_acc), Base::IOError);
+
+    db_writer.open(mpsd_file_rem.getPath());
+
+    BOOST_CHECK(db_writer.isOpen());
+    BOOST_CHECK(db_writer.getDatabaseName() == mpsd_file_rem.getPath());
+    BOOST_CHECK(!db_writer.append(psd_acc, [](double) { return false; }));
+    BOOST_CHECK(db_writer.getNumMolecules() == 0);
+    BOOST_CHECK(db_writer.append(psd_acc));
+    BOOST_CHECK(db_writer.getNumMolecules() == psd_acc.getNumMolecules());
+    BOOST_CHECK(db_writer.getNumPharmacophores() == psd_acc.getNumPharmacophores());
+
+    db_writer.close();
+
+    BOOST_CHECK(!db_writer.isOpen());
+
+    MappedPSDScreeningDBAccessor mpsd_acc(mpsd_file_rem.getPath());
+
+    BOOST_CHECK(mpsd_acc.getDatabaseName() == mpsd_file_rem.getPath());
+
+    checkEqual(psd_acc, mpsd_acc);
+
+    ScreeningDBAccessor::SharedPointer mpsd_acc_clone = mpsd_acc.clone();
+
+    mpsd_acc.close();
+
+    BOOST_CHECK(mpsd_acc.getNumMolecules() == 0);
+    BOOST_CHECK(mpsd_acc_clone->getDatabaseName() == mpsd_file_rem.getPath());
+
+    checkEqual(psd_acc, *mpsd_acc_clone);
+
+    BOOST_CHECK_THROW(mpsd_acc_clone->getMolecule(psd_acc.getNumMolecules(), mol), Base::IndexError);
+    BOOST_CHECK_THROW(mpsd_acc.open(psd_file_rem.getPath()), Base::IOError);
+
+    // files of unexpected size must be rejected
+
+    {
+        std::ofstream os(mpsd_file_rem.getPath().c_str(), std::ios_base::out | std::ios_base::in | std::ios_base::binary);
+
+        os.seekp(0, std::ios_base::end);
+        os.put(0);
+    }
+
+    BOOST_CHECK_THROW(mpsd_acc.open(mpsd_file_rem.getPath()), Base::IOError);
+}
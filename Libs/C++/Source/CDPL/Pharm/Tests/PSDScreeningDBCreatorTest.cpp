@@ -0,0 +1,233 @@
+/* 
+ * PSDScreeningDBCreatorTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+
+#include <cstdlib>
+#include <vector>
+#include <set>
+#include <tuple>
+#include <thread>
+#include <atomic>
+#include <string>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/Pharm/PSDScreeningDBCreator.hpp"
+#include "CDPL/Pharm/PSDScreeningDBAccessor.hpp"
+#include "CDPL/Pharm/BasicPharmacophore.hpp"
+#include "CDPL/Pharm/FeatureTypeHistogram.hpp"
+#include "CDPL/Pharm/FeatureType.hpp"
+#include "CDPL/Pharm/MoleculeFunctions.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/SDFMoleculeReader.hpp"
+#include "CDPL/Chem/AtomContainerFunctions.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Util/FileDataReader.hpp"
+#include "CDPL/Util/FileFunctions.hpp"
+#include "CDPL/Util/FileRemover.hpp"
+#include "CDPL/Util/BitSet.hpp"
+
+
+namespace
+{
+
+    typedef std::vector<CDPL::Chem::BasicMolecule::SharedPointer>         MoleculeList;
+    typedef std::tuple<std::string, std::size_t, std::size_t, std::size_t> EntryInfo;
+    typedef std::multiset<EntryInfo>                                       EntryInfoSet;
+
+    void getEntryInfos(const CDPL::Pharm::ScreeningDBAccessor& db_acc, EntryInfoSet& infos)
+    {
+        using namespace CDPL;
+
+        Chem::BasicMolecule mol;
+        Pharm::BasicPharmacophore pharm;
+
+        infos.clear();
+
+        for (std::size_t i = 0, num_mols = db_acc.getNumMolecules(); i < num_mols; i++) {
+            db_acc.getMolecule(i, mol);
+
+            std::size_t num_pharms = db_acc.getNumPharmacophores(i);
+            std::size_t num_ftrs = 0;
+
+            for (std::size_t j = 0; j < num_pharms; j++) {
+                db_acc.getPharmacophore(i, j, pharm);
+
+                num_ftrs += pharm.getNumFeatures();
+
+                BOOST_CHECK(db_acc.getFeatureCounts(i, j).getSize() > 0);
+            }
+
+            infos.insert(EntryInfo(Chem::getName(mol), mol.getNumAtoms(), num_pharms, num_ftrs));
+        }
+    }
+
+    std::size_t processConcurrently(CDPL::Pharm::ScreeningDBCreator& db_creator, const MoleculeList& molecules, std::size_t num_dups)
+    {
+        // four threads process all molecules and a duplicate of every fourth molecule (up to num_dups) concurrently
+
+        std::atomic<std::size_t> next_mol_idx(0);
+        std::atomic<std::size_t> num_rejected(0);
+        std::vector<std::thread> threads;
+
+        for (std::size_t i = 0; i < 4; i++)
+            threads.emplace_back([&]() {
+                                     for (std::size_t j = next_mol_idx++; j < molecules.size() + num_dups; j = next_mol_idx++)
+                                         if (!db_creator.process(*molecules[j < molecules.size() ? j : (j - molecules.size()) * 4]))
+                                             num_rejected++;
+                                 });
+
+        for (auto& thread : threads)
+            thread.join();
+
+        return num_rejected;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(PSDScreeningDBCreatorMultiThreadingTest)
+{
+    using namespace CDPL;
+    using namespace Pharm;
+
+    Util::FileRemover db_file_rem(Util::genCheckedTempFilePath());
+    Util::FileRemover mt_db_file_rem(Util::genCheckedTempFilePath());
+    Util::FileDataReader<Chem::SDFMoleculeReader> mol_reader(std::string(std::getenv("CDPKIT_TEST_DATA_DIR")) + "/CDK2_actives.sdf");
+    MoleculeList molecules;
+
+    for (std::size_t i = 0; i < 40; i++) {
+        Chem::BasicMolecule::SharedPointer mol_ptr(new Chem::BasicMolecule());
+
+        if (!mol_reader.read(*mol_ptr))
+            break;
+
+        prepareForPharmacophoreGeneration(*mol_ptr);
+        calcAtomCIPConfigurations(*mol_ptr, false);
+        calcBondCIPConfigurations(*mol_ptr, false);
+
+        molecules.push_back(mol_ptr);
+    }
+
+    BOOST_CHECK(molecules.size() == 40);
+
+    {
+        PSDScreeningDBCreator db_creator;
+
+        db_creator.createTwoPointPharmacophoreIndex(true);
+        db_creator.open(db_file_rem.getPath());
+
+        for (auto& mol_ptr : molecules)
+            BOOST_CHECK(db_creator.process(*mol_ptr));
+    }
+
+    PSDScreeningDBCreator mt_db_creator;
+
+    BOOST_CHECK(!mt_db_creator.multiThreadingEnabled());
+
+    mt_db_creator.enableMultiThreading(true);
+
+    BOOST_CHECK(mt_db_creator.multiThreadingEnabled());
+
+    mt_db_creator.createTwoPointPharmacophoreIndex(true);
+    mt_db_creator.open(mt_db_file_rem.getPath());
+
+    BOOST_CHECK(processConcurrently(mt_db_creator, molecules, 0) == 0);
+
+    mt_db_creator.flush();
+
+    BOOST_CHECK(mt_db_creator.getNumProcessed() == molecules.size());
+    BOOST_CHECK(mt_db_creator.getNumInserted() == molecules.size());
+
+    mt_db_creator.close();
+
+    PSDScreeningDBAccessor db_acc(db_file_rem.getPath());
+    PSDScreeningDBAccessor mt_db_acc(mt_db_file_rem.getPath());
+
+    BOOST_CHECK(mt_db_acc.getNumMolecules() == db_acc.getNumMolecules());
+    BOOST_CHECK(mt_db_acc.getNumPharmacophores() == db_acc.getNumPharmacophores());
+    BOOST_CHECK(mt_db_acc.hasTwoPointPharmacophoreIndex());
+
+    EntryInfoSet infos, mt_infos;
+
+    getEntryInfos(db_acc, infos);
+    getEntryInfos(mt_db_acc, mt_infos);
+
+    BOOST_CHECK(infos == mt_infos);
+
+    Util::BitSet pharm_set, mt_pharm_set;
+
+    for (unsigned int type1 = FeatureType::HYDROPHOBIC; type1 <= FeatureType::H_BOND_ACCEPTOR; type1++) {
+        for (unsigned int type2 = type1; type2 <= FeatureType::H_BOND_ACCEPTOR; type2++) {
+            db_acc.getTwoPointPharmacophoreMatches(type1, type2, 2.0, 6.0, pharm_set);
+            mt_db_acc.getTwoPointPharmacophoreMatches(type1, type2, 2.0, 6.0, mt_pharm_set);
+
+            BOOST_CHECK(pharm_set.count() == mt_pharm_set.count());
+        }
+    }
+
+    db_acc.close();
+    mt_db_acc.close();
+
+    // the number of molecules rejected as duplicates must not depend on the processing order
+
+    std::size_t num_ref_ins = 0;
+
+    {
+        PSDScreeningDBCreator db_creator(db_file_rem.getPath(), ScreeningDBCreator::CREATE, false);
+
+        for (auto& mol_ptr : molecules)
+            db_creator.process(*mol_ptr);
+
+        for (std::size_t i = 0; i < molecules.size(); i += 4)
+            BOOST_CHECK(!db_creator.process(*molecules[i]));
+
+        num_ref_ins = db_creator.getNumInserted();
+    }
+
+    mt_db_creator.open(mt_db_file_rem.getPath(), ScreeningDBCreator::CREATE, false);
+
+    std::size_t num_rejected = processConcurrently(mt_db_creator, molecules, molecules.size() / 4);
+
+    mt_db_creator.flush();
+
+    BOOST_CHECK(mt_db_creator.getNumProcessed() == molecules.size() + molecules.size() / 4);
+    BOOST_CHECK(mt_db_creator.getNumRejected() == num_rejected);
+    BOOST_CHECK(mt_db_creator.getNumInserted() == num_ref_ins);
+
+    mt_db_creator.close();
+
+    // duplicates of already stored molecules must be rejected when appending
+
+    mt_db_creator.open(mt_db_file_rem.getPath(), ScreeningDBCreator::APPEND, false);
+
+    BOOST_CHECK(!mt_db_creator.process(*molecules[0]));
+    BOOST_CHECK(mt_db_creator.getNumRejected() == 1);
+
+    mt_db_creator.flush();
+    mt_db_creator.close();
+
+    mt_db_acc.open(mt_db_file_rem.getPath());
+
+    BOOST_CHECK(mt_db_acc.getNumMolecules() == num_ref_ins);
+}
@@ -0,0 +1,350 @@
+/* 
+ * ScreeningProcessorTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstdlib>
+#include <vector>
+#include <tuple>
+#include <algorithm>
+#include <thread>
+#include <atomic>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/Pharm/ScreeningProcessor.hpp"
+#include "CDPL/Pharm/PSDScreeningDBAccessor.hpp"
+#include "CDPL/Pharm/PSDScreeningDBCreator.hpp"
+#include "CDPL/Pharm/DefaultPharmacophoreGenerator.hpp"
+#include "CDPL/Pharm/BasicPharmacophore.hpp"
+#include "CDPL/Pharm/MoleculeFunctions.hpp"
+#include "CDPL/Pharm/FeatureFunctions.hpp"
+#include "CDPL/Pharm/FeatureContainerFunctions.hpp"
+#include "CDPL/Pharm/FeatureType.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/SDFMoleculeReader.hpp"
+#include "CDPL/Chem/AtomContainerFunctions.hpp"
+#include "CDPL/Chem/MolecularGraphFunctions.hpp"
+#include "CDPL/Chem/Entity3DContainerFunctions.hpp"
+#include "CDPL/Chem/Entity3DFunctions.hpp"
+#include "CDPL/Math/VectorArray.hpp"
+#include "CDPL/Math/Vector.hpp"
+#include "CDPL/Util/BitSet.hpp"
+#include "CDPL/Util/FileDataReader.hpp"
+#include "CDPL/Util/FileFunctions.hpp"
+#include "CDPL/Util/FileRemover.hpp"
+
+
+namespace
+{
+
+    typedef std::tuple<std::size_t, std::size_t, std::size_t, double> HitData;
+    typedef std::vector<HitData>                                      HitDataList;
+
+    HitDataList searchDB(CDPL::Pharm::ScreeningProcessor& proc, const CDPL::Pharm::FeatureContainer& query,
+                         std::size_t num_threads, std::size_t max_num_hits = 0)
+    {
+        using namespace CDPL;
+
+        HitDataList hits;
+        std::thread::id caller_id = std::this_thread::get_id();
+        std::atomic<bool> concurrent_call(false);
+        std::atomic<bool> in_callback(false);
+        std::size_t last_progress = 0;
+        std::size_t num_prog_entries = 0;
+        bool progress_ok = true;
+        bool accessor_ok = true;
+
+        proc.setNumThreads(num_threads);
+        proc.setHitCallback([&](const Pharm::ScreeningProcessor::SearchHit& hit, double score) -> bool {
+            if (in_callback.exchange(true))
+                concurrent_call = true;
+
+            if (&hit.getHitProvider() != &proc || (num_threads <= 1 && std::this_thread::get_id() != caller_id))
+                concurrent_call = true;
+
+            // in multithreaded searches the hit data stem from the database accessor of a search thread
+
+            if (num_threads <= 1 ? &hit.getDBAccessor() != &proc.getDBAccessor() :
+                hit.getDBAccessor().getNumPharmacophores() != proc.getDBAccessor().getNumPharmacophores())
+                accessor_ok = false;
+
+            hits.emplace_back(hit.getHitMoleculeIndex(), hit.getHitConformationIndex(), hit.getHitPharmacophoreIndex(), score);
+            in_callback = false;
+
+            return (max_num_hits == 0 || hits.size() < max_num_hits);
+        });
+        proc.setProgressCallback([&](std::size_t i, std::size_t num_entries) -> bool {
+            if (i < last_progress || i > num_entries)
+                progress_ok = false;
+
+            last_progress = i;
+            num_prog_entries = num_entries;
+            return true;
+        });
+
+        std::size_t num_hits = proc.searchDB(query);
+
+        BOOST_CHECK(!concurrent_call);
+        BOOST_CHECK(accessor_ok);
+        BOOST_CHECK(progress_ok);
+        BOOST_CHECK(num_prog_entries <= proc.getDBAccessor().getNumPharmacophores());
+        BOOST_CHECK(max_num_hits > 0 || last_progress == num_prog_entries);
+        BOOST_CHECK(max_num_hits > 0 || proc.getDBAccessor().hasTwoPointPharmacophoreIndex() ||
+                    last_progress == proc.getDBAccessor().getNumPharmacophores());
+        BOOST_CHECK(max_num_hits > 0 || num_hits == hits.size());
+
+        std::sort(hits.begin(), hits.end());
+
+        return hits;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(ScreeningProcessorTest)
+{
+    using namespace CDPL;
+    using namespace Pharm;
+
+    Util::FileRemover db_file_rem(Util::genCheckedTempFilePath());
+    Util::FileDataReader<Chem::SDFMoleculeReader> mol_reader(std::string(std::getenv("CDPKIT_TEST_DATA_DIR")) + "/CDK2_actives.sdf");
+    Chem::BasicMolecule mol;
+    BasicPharmacophore query;
+    Math::Vector3DArray coords;
+
+    {
+        PSDScreeningDBCreator db_creator(db_file_rem.getPath());
+
+        for (std::size_t i = 0; i < 60 && mol_reader.read(mol); i++) {
+            prepareForPharmacophoreGeneration(mol);
+            calcAtomCIPConfigurations(mol, false);
+            calcBondCIPConfigurations(mol, false);
+
+            if (i == 0) {
+                DefaultPharmacophoreGenerator(mol, query);
+                continue;
+            }
+
+            // two conformers per molecule that differ only in their location
+
+            get3DCoordinates(mol, coords);
+            clearConformations(mol);
+            addConformation(mol, coords);
+
+            for (std::size_t j = 0; j < coords.getSize(); j++)
+                coords[j](0) += 5.0;
+
+            addConformation(mol, coords);
+
+            BOOST_CHECK(db_creator.process(mol));
+        }
+    }
+
+    BOOST_CHECK(query.getNumFeatures() > 4);
+
+    PSDScreeningDBAccessor db_acc(db_file_rem.getPath());
+    ScreeningProcessor proc(db_acc);
+
+    BOOST_CHECK(db_acc.getNumMolecules() > 50);
+    BOOST_CHECK(db_acc.getNumPharmacophores() == db_acc.getNumMolecules() * 2);
+
+    ScreeningDBAccessor::SharedPointer db_acc_clone = db_acc.clone();
+
+    BOOST_CHECK(db_acc_clone->getDatabaseName() == db_acc.getDatabaseName());
+    BOOST_CHECK(db_acc_clone->getNumPharmacophores() == db_acc.getNumPharmacophores());
+
+    BOOST_CHECK(proc.getNumThreads() == 0);
+
+    proc.setMaxNumOmittedFeatures(query.getNumFeatures() - 3);
+
+    ScreeningProcessor::HitReportMode modes[] = {
+        ScreeningProcessor::FIRST_MATCHING_CONF, ScreeningProcessor::BEST_MATCHING_CONF, ScreeningProcessor::ALL_MATCHING_CONFS
+    };
+
+    for (auto mode : modes) {
+        proc.setHitReportMode(mode);
+
+        HitDataList ref_hits = searchDB(proc, query, 0);
+
+        BOOST_CHECK(!ref_hits.empty());
+
+        for (std::size_t num_threads = 2; num_threads <= 8; num_threads *= 2)
+            BOOST_CHECK(searchDB(proc, query, num_threads) == ref_hits);
+
+        BOOST_CHECK(searchDB(proc, query, 4, 3).size() == 3);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ScreeningProcessorTwoPointPharmacophoreIndexTest)
+{
+    using namespace CDPL;
+    using namespace Pharm;
+
+    Util::FileRemover db_file_rem(Util::genCheckedTempFilePath());
+    Util::FileRemover idx_db_file_rem(Util::genCheckedTempFilePath());
+    Util::FileDataReader<Chem::SDFMoleculeReader> mol_reader(std::string(std::getenv("CDPKIT_TEST_DATA_DIR")) + "/CDK2_actives.sdf");
+    Chem::BasicMolecule mol;
+    BasicPharmacophore query;
+
+    {
+        PSDScreeningDBCreator db_creator(db_file_rem.getPath());
+        PSDScreeningDBCreator idx_db_creator;
+
+        BOOST_CHECK(!idx_db_creator.twoPointPharmacophoreIndexCreated());
+
+        idx_db_creator.createTwoPointPharmacophoreIndex(true);
+
+        BOOST_CHECK(idx_db_creator.twoPointPharmacophoreIndexCreated());
+
+        idx_db_creator.open(idx_db_file_rem.getPath());
+
+        for (std::size_t i = 0; i < 40 && mol_reader.read(mol); i++) {
+            prepareForPharmacophoreGeneration(mol);
+            calcAtomCIPConfigurations(mol, false);
+            calcBondCIPConfigurations(mol, false);
+
+            if (i == 0) {
+                DefaultPharmacophoreGenerator(mol, query);
+                continue;
+            }
+
+            BOOST_CHECK(db_creator.process(mol));
+            BOOST_CHECK(idx_db_creator.process(mol));
+        }
+    }
+
+    BOOST_CHECK(query.getNumFeatures() > 4);
+
+    PSDScreeningDBAccessor db_acc(db_file_rem.getPath());
+    PSDScreeningDBAccessor idx_db_acc(idx_db_file_rem.getPath());
+
+    BOOST_CHECK(!db_acc.hasTwoPointPharmacophoreIndex());
+    BOOST_CHECK(idx_db_acc.hasTwoPointPharmacophoreIndex());
+    BOOST_CHECK(idx_db_acc.clone()->hasTwoPointPharmacophoreIndex());
+    BOOST_CHECK(idx_db_acc.getNumPharmacophores() == db_acc.getNumPharmacophores());
+
+    // the pharmacophores marked by the index must include all actually matching ones
+
+    std::size_t num_pharms = idx_db_acc.getNumPharmacophores();
+    std::vector<BasicPharmacophore> db_pharms(num_pharms);
+    Util::BitSet pharm_set;
+    std::size_t num_matches = 0;
+    std::size_t num_marked = 0;
+
+    for (std::size_t i = 0; i < num_pharms; i++)
+        idx_db_acc.getPharmacophore(i, db_pharms[i]);
+
+    for (unsigned int type1 = FeatureType::HYDROPHOBIC; type1 <= FeatureType::H_BOND_ACCEPTOR; type1++) {
+        for (unsigned int type2 = FeatureType::HYDROPHOBIC; type2 <= FeatureType::H_BOND_ACCEPTOR; type2++) {
+            for (double min_dist = 0.0; min_dist < 12.0; min_dist += 2.7) {
+                double max_dist = min_dist + 1.3;
+
+                db_acc.getTwoPointPharmacophoreMatches(type1, type2, min_dist, max_dist, pharm_set);
+
+                BOOST_CHECK(pharm_set.size() == num_pharms && pharm_set.all());
+
+                idx_db_acc.getTwoPointPharmacophoreMatches(type1, type2, min_dist, max_dist, pharm_set);
+
+                BOOST_CHECK(pharm_set.size() == num_pharms);
+
+                num_marked += pharm_set.count();
+
+                for (std::size_t i = 0; i < num_pharms; i++) {
+                    const BasicPharmacophore& pharm = db_pharms[i];
+                    bool match = false;
+
+                    for (std::size_t j = 0, num_ftrs = pharm.getNumFeatures(); j < num_ftrs && !match; j++) {
+                        for (std::size_t k = 0; k < num_ftrs && !match; k++) {
+                            if (j == k || getType(pharm.getFeature(j)) != type1 || getType(pharm.getFeature(k)) != type2)
+                                continue;
+
+                            double dist = Math::length(Chem::get3DCoordinates(pharm.getFeature(j)) - Chem::get3DCoordinates(pharm.getFeature(k)));
+
+                            match = (dist >= min_dist && dist <= max_dist);
+                        }
+                    }
+
+                    if (match) {
+                        num_matches++;
+
+                        BOOST_CHECK(pharm_set.test(i));
+                    }
+                }
+            }
+        }
+    }
+
+    BOOST_CHECK(num_matches > 0);
+    BOOST_CHECK(num_marked < num_pharms * 6 * 6 * 5);
+
+    // searches with and without the index must yield the same hits
+
+    ScreeningProcessor proc(db_acc);
+    ScreeningProcessor idx_proc(idx_db_acc);
+
+    ScreeningProcessor::HitReportMode modes[] = {
+        ScreeningProcessor::FIRST_MATCHING_CONF, ScreeningProcessor::BEST_MATCHING_CONF, ScreeningProcessor::ALL_MATCHING_CONFS
+    };
+
+    for (std::size_t max_om_ftrs = query.getNumFeatures() - 4; max_om_ftrs <= query.getNumFeatures() - 2; max_om_ftrs++) {
+        proc.setMaxNumOmittedFeatures(max_om_ftrs);
+        idx_proc.setMaxNumOmittedFeatures(max_om_ftrs);
+
+        for (auto mode : modes) {
+            proc.setHitReportMode(mode);
+            idx_proc.setHitReportMode(mode);
+
+            HitDataList ref_hits = searchDB(proc, query, 0);
+
+            BOOST_CHECK(searchDB(idx_proc, query, 0) == ref_hits);
+            BOOST_CHECK(searchDB(idx_proc, query, 4) == ref_hits);
+        }
+    }
+
+    // an index requested when appending to an existing database must cover the already stored entries
+
+    idx_db_acc.close();
+    db_acc.close();
+
+    {
+        PSDScreeningDBCreator db_creator;
+
+        db_creator.createTwoPointPharmacophoreIndex(true);
+        db_creator.open(db_file_rem.getPath(), ScreeningDBCreator::APPEND);
+    }
+
+    db_acc.open(db_file_rem.getPath());
+    idx_db_acc.open(idx_db_file_rem.getPath());
+
+    BOOST_CHECK(db_acc.hasTwoPointPharmacophoreIndex());
+
+    for (unsigned int type1 = FeatureType::HYDROPHOBIC; type1 <= FeatureType::H_BOND_ACCEPTOR; type1++) {
+        for (unsigned int type2 = FeatureType::HYDROPHOBIC; type2 <= FeatureType::H_BOND_ACCEPTOR; type2++) {
+            Util::BitSet idx_pharm_set;
+
+            idx_db_acc.getTwoPointPharmacophoreMatches(type1, type2, 3.0, 7.5, idx_pharm_set);
+            db_acc.getTwoPointPharmacophoreMatches(type1, type2, 3.0, 7.5, pharm_set);
+
+            BOOST_CHECK(pharm_set == idx_pharm_set);
+        }
+    }
+}
@@ -22,14 +22,10 @@
  */
 
 
-#ifndef _MSC_VER
-# pragma GCC diagnostic push
-# pragma GCC diagnostic ignored "-Wstrict-aliasing" // fastexp causes annoying aliasing warnings!
-#endif // !_MSC_VER
-
 #include "StaticInit.hpp"
 
 #include <cmath>
+#include <limits>
 #include <algorithm>
 #include <functional>
 
@@ -43,19 +39,12 @@
 #include "CDPL/Math/MatrixProxy.hpp"
 #include "CDPL/Math/AffineTransform.hpp"
 #include "CDPL/Math/Quaternion.hpp"
+#include "CDPL/Math/BFGSMinimizer.hpp"
 #include "CDPL/Base/Exceptions.hpp"
 
+#include "GaussianOverlapKernels.hpp"
 #include "Utilities.hpp"
 
-#if defined(__APPLE__) && defined(__clang__)
-# define exp_func(arg) std::exp(arg)
-#elif defined(_MSC_VER)
-# define exp_func(arg) std::exp(arg)
-#else
-# include "FastExp/fastexp.h"
-# define exp_func(arg) fastexp::IEEE<double, 3>::evaluate(arg)
-#endif
-
 
 using namespace CDPL;
 
@@ -109,9 +98,22 @@ namespace
     constexpr double QUATERNION_UNITY_DEVIATION_PENALTY_FACTOR = 10000.0;
     constexpr double BFGS_MINIMIZER_STEP_SIZE                  = 0.1;
     constexpr double BFGS_MINIMIZER_TOLERANCE                  = 0.5;
+
+    // empirical allowance for the approximations (fast exp, proximity check) made in overlap calculations - not a strict bound
+    constexpr double OVERLAP_BOUND_TOLERANCE_FACTOR            = 1.01;
 }
 
 
+struct Shape::FastGaussianShapeAlignment::OptimizationState
+{
+
+    typedef Math::BFGSMinimizer<QuaternionTransformation> Minimizer;
+
+    Minimizer   minimizer;
+    std::size_t startIndex;
+};
+
+
 constexpr double       Shape::FastGaussianShapeAlignment::DEF_OPTIMIZATION_STOP_GRADIENT;
 constexpr unsigned int Shape::FastGaussianShapeAlignment::DEF_RESULT_SELECTION_MODE;
 constexpr std::size_t  Shape::FastGaussianShapeAlignment::DEF_MAX_OPTIMIZATION_ITERATIONS;
@@ -122,40 +124,37 @@ constexpr double       Shape::FastGaussianShapeAlignment::DEF_MAX_RANDOM_TRANSLA
 
 Shape::FastGaussianShapeAlignment::FastGaussianShapeAlignment():
     perfAlignment(true), optOverlap(true), greedyOpt(false), maxNumOptIters(DEF_MAX_OPTIMIZATION_ITERATIONS), 
-    optStopGrad(DEF_OPTIMIZATION_STOP_GRADIENT), resultSelMode(DEF_RESULT_SELECTION_MODE), resultCmpFunc(&compareScore), 
+    optStopGrad(DEF_OPTIMIZATION_STOP_GRADIENT), pruneAligns(false), pruningScoreCutoff(std::numeric_limits<double>::quiet_NaN()),
+    numPerfAligns(0), numPrunedAligns(0), resultSelMode(DEF_RESULT_SELECTION_MODE), resultCmpFunc(&compareScore), 
     scoringFunc(&calcTotalOverlapTanimotoScore), currSetIndex(0), currShapeIndex(0),
     shapeCtrStarts(true), colCtrStarts(false), nonColCtrStarts(false), randomStarts(false),
     genForAlgdShape(false), genForRefShape(true), genForLargerShape(true),
     symThreshold(DEF_SYMMETRY_THRESHOLD), maxRandomTrans(DEF_MAX_RANDOM_TRANSLATION),
-    numRandomStarts(DEF_NUM_RANDOM_STARTS), numSubTransforms(0),
-    minimizer(std::bind(&FastGaussianShapeAlignment::calcAlignmentFunctionValue, this, std::placeholders::_1),
-              std::bind(&FastGaussianShapeAlignment::calcAlignmentFunctionGradient, this, std::placeholders::_1, std::placeholders::_2))
+    numRandomStarts(DEF_NUM_RANDOM_STARTS), numSubTransforms(0)
 {}
 
 Shape::FastGaussianShapeAlignment::FastGaussianShapeAlignment(const GaussianShape& ref_shape):
     perfAlignment(true), optOverlap(true), greedyOpt(false), maxNumOptIters(DEF_MAX_OPTIMIZATION_ITERATIONS), 
-    optStopGrad(DEF_OPTIMIZATION_STOP_GRADIENT), resultSelMode(DEF_RESULT_SELECTION_MODE), resultCmpFunc(&compareScore), 
+    optStopGrad(DEF_OPTIMIZATION_STOP_GRADIENT), pruneAligns(false), pruningScoreCutoff(std::numeric_limits<double>::quiet_NaN()),
+    numPerfAligns(0), numPrunedAligns(0), resultSelMode(DEF_RESULT_SELECTION_MODE), resultCmpFunc(&compareScore), 
     scoringFunc(&calcTotalOverlapTanimotoScore), currSetIndex(0), currShapeIndex(0),
     shapeCtrStarts(true), colCtrStarts(false), nonColCtrStarts(false), randomStarts(false),
     genForAlgdShape(false), genForRefShape(true), genForLargerShape(true),
     symThreshold(DEF_SYMMETRY_THRESHOLD), maxRandomTrans(DEF_MAX_RANDOM_TRANSLATION),
-    numRandomStarts(DEF_NUM_RANDOM_STARTS), numSubTransforms(0),
-    minimizer(std::bind(&FastGaussianShapeAlignment::calcAlignmentFunctionValue, this, std::placeholders::_1),
-              std::bind(&FastGaussianShapeAlignment::calcAlignmentFunctionGradient, this, std::placeholders::_1, std::placeholders::_2))
+    numRandomStarts(DEF_NUM_RANDOM_STARTS), numSubTransforms(0)
 {
     addReferenceShape(ref_shape);
 }
 
 Shape::FastGaussianShapeAlignment::FastGaussianShapeAlignment(const GaussianShapeSet& ref_shapes):
     perfAlignment(true), optOverlap(true), greedyOpt(false), maxNumOptIters(DEF_MAX_OPTIMIZATION_ITERATIONS), 
-    optStopGrad(DEF_OPTIMIZATION_STOP_GRADIENT), resultSelMode(DEF_RESULT_SELECTION_MODE), resultCmpFunc(&compareScore), 
+    optStopGrad(DEF_OPTIMIZATION_STOP_GRADIENT), pruneAligns(false), pruningScoreCutoff(std::numeric_limits<double>::quiet_NaN()),
+    numPerfAligns(0), numPrunedAligns(0), resultSelMode(DEF_RESULT_SELECTION_MODE), resultCmpFunc(&compareScore), 
     scoringFunc(&calcTotalOverlapTanimotoScore), currSetIndex(0), currShapeIndex(0),
     shapeCtrStarts(true), colCtrStarts(false), nonColCtrStarts(false), randomStarts(false),
     genForAlgdShape(false), genForRefShape(true), genForLargerShape(true),
     symThreshold(DEF_SYMMETRY_THRESHOLD), maxRandomTrans(DEF_MAX_RANDOM_TRANSLATION),
-    numRandomStarts(DEF_NUM_RANDOM_STARTS), numSubTransforms(0),
-    minimizer(std::bind(&FastGaussianShapeAlignment::calcAlignmentFunctionValue, this, std::placeholders::_1),
-              std::bind(&FastGaussianShapeAlignment::calcAlignmentFunctionGradient, this, std::placeholders::_1, std::placeholders::_2))
+    numRandomStarts(DEF_NUM_RANDOM_STARTS), numSubTransforms(0)
 {
     addReferenceShapes(ref_shapes);
 }
@@ -249,6 +248,26 @@ double Shape::FastGaussianShapeAlignment::getOptimizationStopGradient() const
     return optStopGrad;
 }
 
+void Shape::FastGaussianShapeAlignment::pruneAlignments(bool prune)
+{
+    pruneAligns = prune;
+}
+
+bool Shape::FastGaussianShapeAlignment::pruneAlignments() const
+{
+    return pruneAligns;
+}
+
+void Shape::FastGaussianShapeAlignment::setPruningScoreCutoff(double cutoff)
+{
+    pruningScoreCutoff = cutoff;
+}
+
+double Shape::FastGaussianShapeAlignment::getPruningScoreCutoff() const
+{
+    return pruningScoreCutoff;
+}
+
 void Shape::FastGaussianShapeAlignment::clearReferenceShapes()
 {
     refShapeData.clear();
@@ -409,6 +428,9 @@ bool Shape::FastGaussianShapeAlignment::align(const GaussianShape& shape)
     results.clear();
     resIndexMap.clear();
 
+    numPerfAligns = 0;
+    numPrunedAligns = 0;
+
     setupShapeData(shape, algdShapeData, false);
     prepareForAlignment();
     
@@ -423,6 +445,9 @@ bool Shape::FastGaussianShapeAlignment::align(const GaussianShapeSet& shapes)
     results.clear();
     resIndexMap.clear();
 
+    numPerfAligns = 0;
+    numPrunedAligns = 0;
+
     for (std::size_t i = 0, num_algd_shapes = shapes.getSize(), num_ref_shapes = refShapeData.size(); i < num_algd_shapes; i++) {
         if (shapes.getElement(i).getNumElements() == 0)
             continue;
@@ -437,6 +462,16 @@ bool Shape::FastGaussianShapeAlignment::align(const GaussianShapeSet& shapes)
     return !results.empty();
 }
 
+std::size_t Shape::FastGaussianShapeAlignment::getNumPerformedAlignments() const
+{
+    return numPerfAligns;
+}
+
+std::size_t Shape::FastGaussianShapeAlignment::getNumPrunedAlignments() const
+{
+    return numPrunedAligns;
+}
+
 std::size_t Shape::FastGaussianShapeAlignment::getNumResults() const
 {
     return results.size();
@@ -504,7 +539,14 @@ void Shape::FastGaussianShapeAlignment::alignAndProcessResults(std::size_t ref_i
 
     if (ref_data.elements.empty())
         return;
-    
+
+    if (pruneAligns && canPruneAlignment(ref_idx)) {
+        numPrunedAligns++;
+        return;
+    }
+
+    numPerfAligns++;
+
     AlignmentResult curr_res;
 
     if (!perfAlignment) {
@@ -518,35 +560,67 @@ void Shape::FastGaussianShapeAlignment::alignAndProcessResults(std::size_t ref_i
     if (!generateStartTransforms(ref_data))
         return;
 
-    currRefShapeIdx = ref_idx;
+    std::size_t num_starts = startTransforms.size();
+    std::size_t num_opts = 0;
 
-    QuaternionTransformation opt_xform;
-    QuaternionTransformation opt_xform_grad;
-
-    for (std::size_t i = 0, num_starts = startTransforms.size(); i < num_starts; ) {
-        if (optOverlap && greedyOpt) {
+    if (!optOverlap || greedyOpt) {
+        for (std::size_t i = 0; i < num_starts; ) {
+            std::size_t num_sub_starts = std::min(numSubTransforms, num_starts - i);
             std::size_t best_start_xform = 0;
             double highest_ovlp = 0.0;
-            
-            for (std::size_t j = 0; j < numSubTransforms && i < num_starts; j++, i++) {
-                quaternionToMatrix(startTransforms[i], xformMatrix);
-                transformAlignedShape();
 
-                double overlap = calcOverlap(ref_data, algdShapeData, false);
+            calcStartTransformOverlaps(ref_data, i, num_sub_starts);
 
-                if (j == 0 || overlap > highest_ovlp) {
+            for (std::size_t j = 0; j < num_sub_starts; j++, i++) {
+                if (j == 0 || batchOverlaps[j] > highest_ovlp) {
                     best_start_xform = i;
-                    highest_ovlp = overlap;
+                    highest_ovlp = batchOverlaps[j];
                 }
             }
 
-            opt_xform = startTransforms[best_start_xform];
+            if (!optOverlap) {
+                quaternionToMatrix(startTransforms[best_start_xform], xformMatrix);
+                transformAlignedShape();
+
+                curr_res.setOverlap(highest_ovlp);
+                curr_res.setColorOverlap(calcOverlap(ref_data, algdShapeData, true));
 
-            minimizer.setup(opt_xform, opt_xform_grad, BFGS_MINIMIZER_STEP_SIZE, BFGS_MINIMIZER_TOLERANCE);
-            minimizer.minimize(opt_xform, opt_xform_grad, maxNumOptIters, optStopGrad, -1.0, false);
-        
-            if (!std::isfinite(minimizer.getFunctionValue())) // sanity check 
+                processResult(curr_res, ref_idx, al_idx);
                 continue;
+            }
+
+            // the other start poses of the group are dominated by the one with the highest initial overlap and
+            // do not get optimized
+
+            if (optStates.size() == num_opts)
+                optStates.resize(num_opts + 1);
+
+            optStates[num_opts++].startIndex = best_start_xform;
+        }
+
+        if (!optOverlap)
+            return;
+
+    } else {
+        if (optStates.size() < num_starts)
+            optStates.resize(num_starts);
+
+        for ( ; num_opts < num_starts; num_opts++)
+            optStates[num_opts].startIndex = num_opts;
+    }
+
+    optimizeStartTransforms(ref_data, num_opts);
+
+    QuaternionTransformation opt_xform;
+
+    if (greedyOpt) {
+        for (std::size_t i = 0; i < num_opts; i++) {
+            const OptimizationState& opt_state = optStates[i];
+
+            if (!std::isfinite(opt_state.minimizer.getFunctionValue())) // sanity check 
+                continue;
+
+            opt_xform = opt_state.minimizer.getPosition();
 
             normalize(opt_xform);
             quaternionToMatrix(opt_xform, xformMatrix);
@@ -556,28 +630,24 @@ void Shape::FastGaussianShapeAlignment::alignAndProcessResults(std::size_t ref_i
             curr_res.setColorOverlap(calcOverlap(ref_data, algdShapeData, true));
 
             processResult(curr_res, ref_idx, al_idx);
-            continue;
         }
 
+        return;
+    }
+
+    for (std::size_t i = 0; i < num_starts; ) {
         bool have_sol = false;
 
         for (std::size_t j = 0; j < numSubTransforms && i < num_starts; j++, i++) {
-            if (!optOverlap) {
-                quaternionToMatrix(startTransforms[i], xformMatrix);
+            const OptimizationState& opt_state = optStates[i];
 
-            } else {
-                opt_xform = startTransforms[i];
+            if (!std::isfinite(opt_state.minimizer.getFunctionValue()))  // sanity check
+                continue;
 
-                minimizer.setup(opt_xform, opt_xform_grad, BFGS_MINIMIZER_STEP_SIZE, BFGS_MINIMIZER_TOLERANCE);
-                minimizer.minimize(opt_xform, opt_xform_grad, maxNumOptIters, optStopGrad, -1.0, false);
-        
-                if (!std::isfinite(minimizer.getFunctionValue()))  // sanity check
-                    continue;
-
-                normalize(opt_xform);
-                quaternionToMatrix(opt_xform, xformMatrix);
-            }
+            opt_xform = opt_state.minimizer.getPosition();
 
+            normalize(opt_xform);
+            quaternionToMatrix(opt_xform, xformMatrix);
             transformAlignedShape();
 
             double overlap = calcOverlap(ref_data, algdShapeData, false);
@@ -671,13 +741,60 @@ void Shape::FastGaussianShapeAlignment::processResult(AlignmentResult& res, std:
     results[out_res_idx] = res;
 }
 
+bool Shape::FastGaussianShapeAlignment::canPruneAlignment(std::size_t ref_idx)
+{
+    using namespace AlignmentResultSelectionMode;
+
+    const ShapeData& ref_data = refShapeData[ref_idx];
+    double ref_shape_self_ovlp = std::max(ref_data.selfOverlap - ref_data.colSelfOverlap, 0.0);
+    double al_shape_self_ovlp = std::max(algdShapeData.selfOverlap - algdShapeData.colSelfOverlap, 0.0);
+    double shape_ovlp_bound = std::sqrt(ref_shape_self_ovlp * al_shape_self_ovlp) * OVERLAP_BOUND_TOLERANCE_FACTOR;
+    double col_ovlp_bound = calcColorOverlapBound(ref_data, algdShapeData) * OVERLAP_BOUND_TOLERANCE_FACTOR;
+    
+    AlignmentResult bound_res;
+
+    bound_res.setOverlap(shape_ovlp_bound + col_ovlp_bound);
+    bound_res.setColorOverlap(col_ovlp_bound);
+    bound_res.setReferenceSelfOverlap(ref_data.selfOverlap);
+    bound_res.setReferenceColorSelfOverlap(ref_data.colSelfOverlap);
+    bound_res.setAlignedSelfOverlap(algdShapeData.selfOverlap);
+    bound_res.setAlignedColorSelfOverlap(algdShapeData.colSelfOverlap);
+    bound_res.setScore(scoringFunc(bound_res));
+
+    if (std::isnan(bound_res.getScore()))
+        return false;
+
+    if (bound_res.getScore() < pruningScoreCutoff)
+        return true;
+
+    ResultIndexMap::const_iterator it;
+    
+    switch (resultSelMode) {
+
+        case BEST_PER_REFERENCE_SHAPE:
+            it = resIndexMap.find(ResultID(ref_idx, 0));
+            break;
+
+        case BEST_PER_REFERENCE_SET:
+            it = resIndexMap.find(ResultID(ref_data.setIndex, 0));
+            break;
+
+        case BEST_OVERALL:
+            return (!results.empty() && !resultCmpFunc(bound_res, results[0]));
+
+        default:
+            return false;
+    }
+
+    return (it != resIndexMap.end() && !resultCmpFunc(bound_res, results[it->second]));
+}
+
 void Shape::FastGaussianShapeAlignment::setupShapeData(const GaussianShape& shape, ShapeData& data, bool ref)
 {
     std::size_t num_elem = shape.getNumElements();
 
     data.elements.resize(num_elem);
     data.colElemOffs = 0;
-    data.equalNonColDelta = true;
 
     if (ref) {
         data.setIndex = currSetIndex;
@@ -690,12 +807,7 @@ void Shape::FastGaussianShapeAlignment::setupShapeData(const GaussianShape& shap
         if (gs_elem.getColor() > 0)
             continue;
 
-        setupShapeDataElement(gs_elem, data.elements[data.colElemOffs]);
-
-        if (data.equalNonColDelta && data.colElemOffs > 0) 
-            data.equalNonColDelta = (data.elements[data.colElemOffs].delta == data.elements[data.colElemOffs - 1].delta);
-
-        data.colElemOffs++;
+        setupShapeDataElement(gs_elem, data.elements[data.colElemOffs++]);
     }
 
     for (std::size_t i = 0, j = data.colElemOffs; i < num_elem; i++) {
@@ -707,8 +819,10 @@ void Shape::FastGaussianShapeAlignment::setupShapeData(const GaussianShape& shap
         setupShapeDataElement(gs_elem, data.elements[j++]);
     }
 
+    setupPackedElementData(data);
+
     data.selfOverlap = calcOverlap(data, data, false);
-    data.colSelfOverlap = calcOverlap(data, data, true);
+    data.colSelfOverlap = calcColorSelfOverlaps(data);
 
     if (!perfAlignment) 
         return;
@@ -816,6 +930,8 @@ void Shape::FastGaussianShapeAlignment::setupShapeData(const GaussianShape& shap
 
         elem.center = tmp_vec;
     }
+
+    setupPackedElementData(data);
     
     if (ref) {
         xform_data[0][0] = x_axis(0);
@@ -843,6 +959,23 @@ void Shape::FastGaussianShapeAlignment::setupShapeData(const GaussianShape& shap
     data.symClass = perceiveSymmetryClass(moments, symThreshold);    
 }
 
+void Shape::FastGaussianShapeAlignment::setupPackedElementData(ShapeData& data) const
+{
+    std::size_t num_elem = data.elements.size();
+
+    initPackedElementData(data.packedElemData, data.colElemOffs);
+    initPackedElementData(data.packedColElemData, num_elem - data.colElemOffs);
+
+    for (std::size_t i = 0; i < num_elem; i++) {
+        const ShapeData::Element& elem = data.elements[i];
+
+        if (i < data.colElemOffs)
+            setPackedElement(data.packedElemData, i, elem.center, elem.radius, elem.delta, elem.weightFactor, elem.color);
+        else
+            setPackedElement(data.packedColElemData, i - data.colElemOffs, elem.center, elem.radius, elem.delta, elem.weightFactor, elem.color);
+    }
+}
+
 void Shape::FastGaussianShapeAlignment::setupShapeDataElement(const GaussianShape::Element& gs_elem, ShapeData::Element& sd_elem) const
 {
     sd_elem.center = gs_elem.getPosition();
@@ -862,7 +995,6 @@ void Shape::FastGaussianShapeAlignment::setupShapeDataElement(const GaussianShap
 void Shape::FastGaussianShapeAlignment::prepareForAlignment()
 {
     startPoseCoords.resize(algdShapeData.elements.size());
-    optPoseCoordsGrad.resize(startPoseCoords.getSize());
 
     for (std::size_t i = 0, num_algd_elem = startPoseCoords.size(); i < num_algd_elem; i++)
         startPoseCoords[i] = algdShapeData.elements[i].center;
@@ -932,12 +1064,15 @@ bool Shape::FastGaussianShapeAlignment::generateStartTransforms(const ShapeData&
 
 void Shape::FastGaussianShapeAlignment::generateTransformsForElementCenters(const ShapeData& data, unsigned int axes_swap_flags, bool ref_shape)
 {
+    // for the aligned shape the untransformed element centers have to be used since the current element centers
+    // reflect the last evaluated pose
+
     if (colCtrStarts && nonColCtrStarts) {
         for (std::size_t i = 0, num_elem = data.elements.size(); i < num_elem; i++) {
             if (ref_shape)
                 generateTransforms(data.elements[i].center, axes_swap_flags);
             else
-                generateTransforms(-data.elements[i].center, axes_swap_flags);
+                generateTransforms(-startPoseCoords[i], axes_swap_flags);
         }
 
     } else if (nonColCtrStarts) {
@@ -945,7 +1080,7 @@ void Shape::FastGaussianShapeAlignment::generateTransformsForElementCenters(cons
             if (ref_shape)
                 generateTransforms(data.elements[i].center, axes_swap_flags);
             else
-                generateTransforms(-data.elements[i].center, axes_swap_flags);
+                generateTransforms(-startPoseCoords[i], axes_swap_flags);
         }
 
     } else if (colCtrStarts) {
@@ -953,7 +1088,7 @@ void Shape::FastGaussianShapeAlignment::generateTransformsForElementCenters(cons
             if (ref_shape)
                 generateTransforms(data.elements[i].center, axes_swap_flags);
             else
-                generateTransforms(-data.elements[i].center, axes_swap_flags);
+                generateTransforms(-startPoseCoords[i], axes_swap_flags);
         }
     }
 }
@@ -1022,340 +1157,316 @@ void Shape::FastGaussianShapeAlignment::transformAlignedShape()
         transform(algdShapeData.elements[i].center.getData(), xformMatrix.getData(), startPoseCoords[i].getData());
 }
 
-double Shape::FastGaussianShapeAlignment::calcAlignmentFunctionValue(const QuaternionTransformation& xform_quat)
+void Shape::FastGaussianShapeAlignment::optimizeStartTransforms(const ShapeData& ref_data, std::size_t num_opts)
 {
-    QuaternionTransformation::ConstPointer xform_quat_data = xform_quat.getData();
-    QuaternionTransformation::Pointer norm_xform_quat_data = normXformQuat.getData();
+    // the optimizations of all start poses proceed in lockstep so that the function values and gradients requested
+    // by the individual minimizers can be calculated by batched overlap kernel invocations - the minimizer states are
+    // independent of each other and thus take exactly the same paths as in one-by-one optimization
 
-    double quat_norm_sqrd = xform_quat_data[0] * xform_quat_data[0] + xform_quat_data[1] * xform_quat_data[1] + 
-        xform_quat_data[2] * xform_quat_data[2] + xform_quat_data[3] * xform_quat_data[3];
-    double quat_non_unity_pen = 1.0 - quat_norm_sqrd;
+    activeOpts.clear();
 
-    quat_non_unity_pen *= 0.5 * QUATERNION_UNITY_DEVIATION_PENALTY_FACTOR * quat_non_unity_pen;
+    for (std::size_t i = 0; i < num_opts; i++) {
+        optStates[i].minimizer.start(startTransforms[optStates[i].startIndex], maxNumOptIters, optStopGrad, -1.0,
+                                     BFGS_MINIMIZER_STEP_SIZE, BFGS_MINIMIZER_TOLERANCE);
+        activeOpts.push_back(i);
+    }
 
-    double inv_quat_norm = 1.0 / std::sqrt(quat_norm_sqrd);
+    while (!activeOpts.empty()) {
+        std::size_t num_active = 0;
 
-    for (std::size_t i = 0; i < 4; i++)
-        norm_xform_quat_data[i] = xform_quat_data[i] * inv_quat_norm;
+        valueEvalOpts.clear();
+        gradEvalOpts.clear();
 
-    for (std::size_t i = 4; i < 7; i++)
-        norm_xform_quat_data[i] = xform_quat_data[i];
-        
-    quaternionToMatrix(normXformQuat, xformMatrix);
-    transformAlignedShape();
+        for (std::size_t i = 0, num_prev_active = activeOpts.size(); i < num_prev_active; i++) {
+            std::size_t opt_idx = activeOpts[i];
 
-    return (quat_non_unity_pen - calcOverlap(refShapeData[currRefShapeIdx], algdShapeData, false));
-}
+            switch (optStates[opt_idx].minimizer.advance()) {
 
-double Shape::FastGaussianShapeAlignment::calcAlignmentFunctionGradient(const QuaternionTransformation& xform_quat, QuaternionTransformation& xform_grad)
-{
-    xform_grad.clear();
+                case OptimizationState::Minimizer::VALUE_EVALUATION:
+                    valueEvalOpts.push_back(opt_idx);
+                    break;
 
-    QuaternionTransformation::ConstPointer xform_quat_data = xform_quat.getData();
-    QuaternionTransformation::Pointer grad_data = xform_grad.getData();
-    QuaternionTransformation::Pointer norm_xform_quat_data = normXformQuat.getData();
-    Math::Matrix4D::ConstArrayPointer xform_mtx_data = xformMatrix.getData();
+                case OptimizationState::Minimizer::GRADIENT_EVALUATION:
+                    gradEvalOpts.push_back(opt_idx);
+                    break;
 
-    double quat_norm_sqrd = xform_quat_data[0] * xform_quat_data[0] + xform_quat_data[1] * xform_quat_data[1] + 
-        xform_quat_data[2] * xform_quat_data[2] + xform_quat_data[3] * xform_quat_data[3];
-    double inv_quat_norm_sqrd = 1.0 / quat_norm_sqrd;
-    double inv_quat_norm = std::sqrt(inv_quat_norm_sqrd);
+                default:
+                    continue;
+            }
 
-    for (std::size_t i = 0; i < 4; i++)
-        norm_xform_quat_data[i] = xform_quat_data[i] * inv_quat_norm;
+            activeOpts[num_active++] = opt_idx;
+        }
 
-    for (std::size_t i = 4; i < 7; i++)
-        norm_xform_quat_data[i] = xform_quat_data[i];
-        
-    quaternionToMatrix(normXformQuat, xformMatrix);
-    transformAlignedShape();
+        activeOpts.resize(num_active);
 
-    double neg_overlap = -calcOverlapGradient(refShapeData[currRefShapeIdx], optPoseCoordsGrad);
+        calcAlignmentFunctionValues(ref_data);
+        calcAlignmentFunctionGradients(ref_data);
+    }
+}
 
-    double dq1[3][3] = { { xform_quat_data[0], -xform_quat_data[3],  xform_quat_data[2] },
-                         { xform_quat_data[3],  xform_quat_data[0], -xform_quat_data[1] },
-                         {-xform_quat_data[2],  xform_quat_data[1],  xform_quat_data[0] } };
+void Shape::FastGaussianShapeAlignment::calcAlignmentFunctionValues(const ShapeData& ref_data)
+{
+    std::size_t num_evals = valueEvalOpts.size();
 
-    double dq2[3][3] = { { xform_quat_data[1], -xform_quat_data[2],  xform_quat_data[3] },
-                         { xform_quat_data[2], -xform_quat_data[1], -xform_quat_data[0] },
-                         { xform_quat_data[3],  xform_quat_data[0], -xform_quat_data[1] } };
+    if (num_evals == 0)
+        return;
 
-    double dq3[3][3] = { {-xform_quat_data[2],  xform_quat_data[1],  xform_quat_data[0] },
-                         { xform_quat_data[1],  xform_quat_data[2],  xform_quat_data[3] },
-                         {-xform_quat_data[0],  xform_quat_data[3], -xform_quat_data[2] } };
+    calcOptimizationPoseCoordinates(false);
 
-    double dq4[3][3] = { {-xform_quat_data[3], -xform_quat_data[0],  xform_quat_data[1] },
-                         { xform_quat_data[0], -xform_quat_data[3],  xform_quat_data[2] },
-                         { xform_quat_data[1],  xform_quat_data[2],  xform_quat_data[3] } };
+    for (std::size_t i = 0, num_elem = algdShapeData.elements.size(); i < num_elem; i++) {
+        const ShapeData::Element& elem = algdShapeData.elements[i];
 
-    for (std::size_t i = 0; i < 3; i++)
-        for (std::size_t j = 0; j < 3; j++) {
-            dq1[i][j] = (dq1[i][j] - xform_mtx_data[i][j] * xform_quat_data[0]) * inv_quat_norm_sqrd;
-            dq2[i][j] = (dq2[i][j] - xform_mtx_data[i][j] * xform_quat_data[1]) * inv_quat_norm_sqrd;
-            dq3[i][j] = (dq3[i][j] - xform_mtx_data[i][j] * xform_quat_data[2]) * inv_quat_norm_sqrd;
-            dq4[i][j] = (dq4[i][j] - xform_mtx_data[i][j] * xform_quat_data[3]) * inv_quat_norm_sqrd;
-        }
-    
-    for (std::size_t i = 0, num_elem = startPoseCoords.getSize(); i < num_elem; i++) {
-        const Math::Vector3D::ConstPointer elem_pos = startPoseCoords[i].getData();
-        const Math::Vector3D::ConstPointer pos_grad = optPoseCoordsGrad[i].getData();
-        
-        grad_data[0] +=
-            pos_grad[0] * ( dq1[0][0] * elem_pos[0] + dq1[0][1] * elem_pos[1] + dq1[0][2] * elem_pos[2]) +
-            pos_grad[1] * ( dq1[1][0] * elem_pos[0] + dq1[1][1] * elem_pos[1] + dq1[1][2] * elem_pos[2]) +
-            pos_grad[2] * ( dq1[2][0] * elem_pos[0] + dq1[2][1] * elem_pos[1] + dq1[2][2] * elem_pos[2]);
-
-        grad_data[1] +=
-            pos_grad[0] * ( dq2[0][0] * elem_pos[0] + dq2[0][1] * elem_pos[1] + dq2[0][2] * elem_pos[2]) +
-            pos_grad[1] * ( dq2[1][0] * elem_pos[0] + dq2[1][1] * elem_pos[1] + dq2[1][2] * elem_pos[2]) +
-            pos_grad[2] * ( dq2[2][0] * elem_pos[0] + dq2[2][1] * elem_pos[1] + dq2[2][2] * elem_pos[2]);
-
-        grad_data[2] +=
-            pos_grad[0] * ( dq3[0][0] * elem_pos[0] + dq3[0][1] * elem_pos[1] + dq3[0][2] * elem_pos[2]) +
-            pos_grad[1] * ( dq3[1][0] * elem_pos[0] + dq3[1][1] * elem_pos[1] + dq3[1][2] * elem_pos[2]) +
-            pos_grad[2] * ( dq3[2][0] * elem_pos[0] + dq3[2][1] * elem_pos[1] + dq3[2][2] * elem_pos[2]);
-
-        grad_data[3] +=
-            pos_grad[0] * ( dq4[0][0] * elem_pos[0] + dq4[0][1] * elem_pos[1] + dq4[0][2] * elem_pos[2]) +
-            pos_grad[1] * ( dq4[1][0] * elem_pos[0] + dq4[1][1] * elem_pos[1] + dq4[1][2] * elem_pos[2]) +
-            pos_grad[2] * ( dq4[2][0] * elem_pos[0] + dq4[2][1] * elem_pos[1] + dq4[2][2] * elem_pos[2]);
-
-        grad_data[4] -= pos_grad[0];
-        grad_data[5] -= pos_grad[1];
-        grad_data[6] -= pos_grad[2];
+        calcPackedElementOverlaps(i < algdShapeData.colElemOffs ? ref_data.packedElemData : ref_data.packedColElemData,
+                                  &batchPoseCoords[i * num_evals * 3], num_evals, elem.radius, elem.delta, elem.weightFactor,
+                                  elem.color, true, RADIUS_SCALING_FACTOR, true, batchOverlaps.data());
     }
-    
-    double quat_non_unity_pen = 1.0 - quat_norm_sqrd;
-    double pen_grad_factor = QUATERNION_UNITY_DEVIATION_PENALTY_FACTOR * quat_non_unity_pen;
 
-    for (std::size_t i = 0; i < 4; i++)
-        grad_data[i] = -2.0 * (grad_data[i] + pen_grad_factor * xform_quat_data[i]);
-    
-    return (neg_overlap + 0.5 * pen_grad_factor * quat_non_unity_pen);
+    for (std::size_t i = 0; i < num_evals; i++) {
+        OptimizationState::Minimizer& minimizer = optStates[valueEvalOpts[i]].minimizer;
+        QuaternionTransformation::ConstPointer xform_quat_data = minimizer.getEvaluationPoint().getData();
+
+        double quat_norm_sqrd = xform_quat_data[0] * xform_quat_data[0] + xform_quat_data[1] * xform_quat_data[1] + 
+            xform_quat_data[2] * xform_quat_data[2] + xform_quat_data[3] * xform_quat_data[3];
+        double quat_non_unity_pen = 1.0 - quat_norm_sqrd;
+
+        quat_non_unity_pen *= 0.5 * QUATERNION_UNITY_DEVIATION_PENALTY_FACTOR * quat_non_unity_pen;
+
+        minimizer.setFunctionValue(quat_non_unity_pen - batchOverlaps[i]);
+    }
 }
 
-double Shape::FastGaussianShapeAlignment::calcOverlap(const ShapeData& ref_data, const ShapeData& ovl_data, bool color) const
+void Shape::FastGaussianShapeAlignment::calcAlignmentFunctionGradients(const ShapeData& ref_data)
 {
-    double overlap = 0.0;
+    std::size_t num_evals = gradEvalOpts.size();
 
-    if (!color) {
-        if (ref_data.equalNonColDelta && ovl_data.equalNonColDelta && ref_data.elements[0].delta == ovl_data.elements[0].delta) {
+    if (num_evals == 0)
+        return;
 
-            double max_dist = ref_data.elements[0].radius * 2.0 * RADIUS_SCALING_FACTOR;
-            double elem_delta = ref_data.elements[0].delta;
-            double delta_fact =  elem_delta * 0.5;
-            double delta = 2 * elem_delta;
-            double vol_factor = M_PI / delta;
+    calcOptimizationPoseCoordinates(true);
 
-            vol_factor *= std::sqrt(vol_factor) * ref_data.elements[0].weightFactor * ref_data.elements[0].weightFactor;
-            max_dist *= max_dist;
+    std::size_t num_elem = algdShapeData.elements.size();
 
-            for (std::size_t i = 0, num_ovl_elem = ovl_data.colElemOffs; i < num_ovl_elem; i++) {
-                const ShapeData::Element& elem1 = ovl_data.elements[i];
-                Math::Vector3D::ConstPointer elem1_ctr = elem1.center.getData();
+    batchPoseGrads.resize(num_elem * num_evals * 3);
 
-                for (std::size_t j = 0, num_ref_elem = ref_data.colElemOffs; j < num_ref_elem; j++) {
-                    const ShapeData::Element& elem2 = ref_data.elements[j];
-                    double sqrd_ctr_dist = calcSquaredDistance(elem1_ctr, elem2.center.getData());
+    for (std::size_t i = 0; i < num_elem; i++) {
+        const ShapeData::Element& elem = algdShapeData.elements[i];
 
-                    if (sqrd_ctr_dist > max_dist)
-                        continue;
+        calcPackedElementOverlapGradients(i < algdShapeData.colElemOffs ? ref_data.packedElemData : ref_data.packedColElemData,
+                                          &batchPoseCoords[i * num_evals * 3], num_evals, elem.radius, elem.delta, elem.weightFactor,
+                                          elem.color, true, RADIUS_SCALING_FACTOR, true, batchOverlaps.data(), &batchPoseGrads[i * num_evals * 3]);
+    }
 
-                    double prod_fact_exp = -delta_fact * sqrd_ctr_dist;
+    QuaternionTransformation xform_grad;
 
-                    overlap += exp_func(prod_fact_exp);
-                }
-            }
+    for (std::size_t k = 0; k < num_evals; k++) {
+        OptimizationState::Minimizer& minimizer = optStates[gradEvalOpts[k]].minimizer;
 
-            overlap *= vol_factor;
+        xform_grad.clear();
 
-        } else {
-            for (std::size_t i = 0, num_ovl_elem = ovl_data.colElemOffs; i < num_ovl_elem; i++) {
-                const ShapeData::Element& elem1 = ovl_data.elements[i];
-                Math::Vector3D::ConstPointer elem1_ctr = elem1.center.getData();
+        QuaternionTransformation::ConstPointer xform_quat_data = minimizer.getEvaluationPoint().getData();
+        QuaternionTransformation::Pointer grad_data = xform_grad.getData();
+        Math::Matrix4D::ConstArrayPointer xform_mtx_data = optXformMatrices[k].getData();
 
-                for (std::size_t j = 0, num_ref_elem = ref_data.colElemOffs; j < num_ref_elem; j++) {
-                    const ShapeData::Element& elem2 = ref_data.elements[j];
-                    double sqrd_ctr_dist = calcSquaredDistance(elem1_ctr, elem2.center.getData());
-                    double max_dist = (elem1.radius + elem2.radius) * RADIUS_SCALING_FACTOR;
+        double quat_norm_sqrd = xform_quat_data[0] * xform_quat_data[0] + xform_quat_data[1] * xform_quat_data[1] + 
+            xform_quat_data[2] * xform_quat_data[2] + xform_quat_data[3] * xform_quat_data[3];
+        double inv_quat_norm_sqrd = 1.0 / quat_norm_sqrd;
+        double neg_overlap = -batchOverlaps[k];
 
-                    if (sqrd_ctr_dist > (max_dist * max_dist))
-                        continue;
+        double dq1[3][3] = { { xform_quat_data[0], -xform_quat_data[3],  xform_quat_data[2] },
+                             { xform_quat_data[3],  xform_quat_data[0], -xform_quat_data[1] },
+                             {-xform_quat_data[2],  xform_quat_data[1],  xform_quat_data[0] } };
 
-                    double delta = elem1.delta + elem2.delta;
-                    double vol_factor = M_PI / delta;
-                    double prod_fact_exp = -elem1.delta * elem2.delta * sqrd_ctr_dist / delta;
+        double dq2[3][3] = { { xform_quat_data[1], -xform_quat_data[2],  xform_quat_data[3] },
+                             { xform_quat_data[2], -xform_quat_data[1], -xform_quat_data[0] },
+                             { xform_quat_data[3],  xform_quat_data[0], -xform_quat_data[1] } };
 
-                    overlap += elem1.weightFactor * elem2.weightFactor * vol_factor *
-                        std::sqrt(vol_factor) * exp_func(prod_fact_exp);
-                }
+        double dq3[3][3] = { {-xform_quat_data[2],  xform_quat_data[1],  xform_quat_data[0] },
+                             { xform_quat_data[1],  xform_quat_data[2],  xform_quat_data[3] },
+                             {-xform_quat_data[0],  xform_quat_data[3], -xform_quat_data[2] } };
+
+        double dq4[3][3] = { {-xform_quat_data[3], -xform_quat_data[0],  xform_quat_data[1] },
+                             { xform_quat_data[0], -xform_quat_data[3],  xform_quat_data[2] },
+                             { xform_quat_data[1],  xform_quat_data[2],  xform_quat_data[3] } };
+
+        for (std::size_t i = 0; i < 3; i++)
+            for (std::size_t j = 0; j < 3; j++) {
+                dq1[i][j] = (dq1[i][j] - xform_mtx_data[i][j] * xform_quat_data[0]) * inv_quat_norm_sqrd;
+                dq2[i][j] = (dq2[i][j] - xform_mtx_data[i][j] * xform_quat_data[1]) * inv_quat_norm_sqrd;
+                dq3[i][j] = (dq3[i][j] - xform_mtx_data[i][j] * xform_quat_data[2]) * inv_quat_norm_sqrd;
+                dq4[i][j] = (dq4[i][j] - xform_mtx_data[i][j] * xform_quat_data[3]) * inv_quat_norm_sqrd;
             }
+    
+        for (std::size_t i = 0; i < num_elem; i++) {
+            const Math::Vector3D::ConstPointer elem_pos = startPoseCoords[i].getData();
+            const double* pos_grad = &batchPoseGrads[(i * num_evals + k) * 3];
+        
+            grad_data[0] +=
+                pos_grad[0] * ( dq1[0][0] * elem_pos[0] + dq1[0][1] * elem_pos[1] + dq1[0][2] * elem_pos[2]) +
+                pos_grad[1] * ( dq1[1][0] * elem_pos[0] + dq1[1][1] * elem_pos[1] + dq1[1][2] * elem_pos[2]) +
+                pos_grad[2] * ( dq1[2][0] * elem_pos[0] + dq1[2][1] * elem_pos[1] + dq1[2][2] * elem_pos[2]);
+
+            grad_data[1] +=
+                pos_grad[0] * ( dq2[0][0] * elem_pos[0] + dq2[0][1] * elem_pos[1] + dq2[0][2] * elem_pos[2]) +
+                pos_grad[1] * ( dq2[1][0] * elem_pos[0] + dq2[1][1] * elem_pos[1] + dq2[1][2] * elem_pos[2]) +
+                pos_grad[2] * ( dq2[2][0] * elem_pos[0] + dq2[2][1] * elem_pos[1] + dq2[2][2] * elem_pos[2]);
+
+            grad_data[2] +=
+                pos_grad[0] * ( dq3[0][0] * elem_pos[0] + dq3[0][1] * elem_pos[1] + dq3[0][2] * elem_pos[2]) +
+                pos_grad[1] * ( dq3[1][0] * elem_pos[0] + dq3[1][1] * elem_pos[1] + dq3[1][2] * elem_pos[2]) +
+                pos_grad[2] * ( dq3[2][0] * elem_pos[0] + dq3[2][1] * elem_pos[1] + dq3[2][2] * elem_pos[2]);
+
+            grad_data[3] +=
+                pos_grad[0] * ( dq4[0][0] * elem_pos[0] + dq4[0][1] * elem_pos[1] + dq4[0][2] * elem_pos[2]) +
+                pos_grad[1] * ( dq4[1][0] * elem_pos[0] + dq4[1][1] * elem_pos[1] + dq4[1][2] * elem_pos[2]) +
+                pos_grad[2] * ( dq4[2][0] * elem_pos[0] + dq4[2][1] * elem_pos[1] + dq4[2][2] * elem_pos[2]);
+
+            grad_data[4] -= pos_grad[0];
+            grad_data[5] -= pos_grad[1];
+            grad_data[6] -= pos_grad[2];
         }
+    
+        double quat_non_unity_pen = 1.0 - quat_norm_sqrd;
+        double pen_grad_factor = QUATERNION_UNITY_DEVIATION_PENALTY_FACTOR * quat_non_unity_pen;
+
+        for (std::size_t i = 0; i < 4; i++)
+            grad_data[i] = -2.0 * (grad_data[i] + pen_grad_factor * xform_quat_data[i]);
+    
+        minimizer.setFunctionGradient(neg_overlap + 0.5 * pen_grad_factor * quat_non_unity_pen, xform_grad);
     }
+}
 
-    for (std::size_t i = ovl_data.colElemOffs, num_ovl_elem = ovl_data.elements.size(); i < num_ovl_elem; i++) {
-        const ShapeData::Element& elem1 = ovl_data.elements[i];
-        Math::Vector3D::ConstPointer elem1_ctr = elem1.center.getData();
+void Shape::FastGaussianShapeAlignment::calcOptimizationPoseCoordinates(bool grad_eval)
+{
+    const IndexArray& opt_indices = (grad_eval ? gradEvalOpts : valueEvalOpts);
+    std::size_t num_evals = opt_indices.size();
+    std::size_t num_elem = algdShapeData.elements.size();
+    QuaternionTransformation::Pointer norm_xform_quat_data = normXformQuat.getData();
 
-        for (std::size_t j = ref_data.colElemOffs, num_ref_elem = ref_data.elements.size(); j < num_ref_elem; j++) {
-            const ShapeData::Element& elem2 = ref_data.elements[j];
+    batchPoseCoords.resize(num_elem * num_evals * 3);
+    batchOverlaps.assign(num_evals, 0.0);
 
-            if (elem1.color != elem2.color)
-                continue;
-        
-            double sqrd_ctr_dist = calcSquaredDistance(elem1_ctr, elem2.center.getData());
-            double max_dist = (elem1.radius + elem2.radius) * RADIUS_SCALING_FACTOR;
+    if (optXformMatrices.size() < num_evals)
+        optXformMatrices.resize(num_evals);
 
-            if (sqrd_ctr_dist > (max_dist * max_dist))
-                continue;
+    for (std::size_t i = 0; i < num_evals; i++) {
+        QuaternionTransformation::ConstPointer xform_quat_data = optStates[opt_indices[i]].minimizer.getEvaluationPoint().getData();
 
-            double delta = elem1.delta + elem2.delta;
-            double vol_factor = M_PI / delta;
-            double prod_fact_exp = -elem1.delta * elem2.delta * sqrd_ctr_dist / delta;
+        double quat_norm_sqrd = xform_quat_data[0] * xform_quat_data[0] + xform_quat_data[1] * xform_quat_data[1] + 
+            xform_quat_data[2] * xform_quat_data[2] + xform_quat_data[3] * xform_quat_data[3];
+        double inv_quat_norm = (grad_eval ? std::sqrt(1.0 / quat_norm_sqrd) : 1.0 / std::sqrt(quat_norm_sqrd));
 
-            overlap += elem1.weightFactor * elem2.weightFactor * vol_factor *
-                std::sqrt(vol_factor) * exp_func(prod_fact_exp);
-        }
+        for (std::size_t j = 0; j < 4; j++)
+            norm_xform_quat_data[j] = xform_quat_data[j] * inv_quat_norm;
+
+        for (std::size_t j = 4; j < 7; j++)
+            norm_xform_quat_data[j] = xform_quat_data[j];
+
+        quaternionToMatrix(normXformQuat, optXformMatrices[i]);
+
+        for (std::size_t j = 0; j < num_elem; j++)
+            transform(&batchPoseCoords[(j * num_evals + i) * 3], optXformMatrices[i].getData(), startPoseCoords[j].getData());
     }
-        
-    return overlap;
 }
 
-double Shape::FastGaussianShapeAlignment::calcOverlapGradient(const ShapeData& ref_data, Math::Vector3DArray& grad) const
+double Shape::FastGaussianShapeAlignment::calcOverlap(const ShapeData& ref_data, const ShapeData& ovl_data, bool color) const
 {
-    Math::Vector3DArray::StorageType& grad_data = grad.getData();
-    Math::Vector3D inters_prod_ctr;
-    Math::Vector3D::Pointer inters_prod_ctr_data = inters_prod_ctr.getData();
     double overlap = 0.0;
 
-    if (ref_data.equalNonColDelta && algdShapeData.equalNonColDelta && ref_data.elements[0].delta == algdShapeData.elements[0].delta) {
-        double max_dist = ref_data.elements[0].radius * 2.0 * RADIUS_SCALING_FACTOR;
-        double elem_delta = ref_data.elements[0].delta;
-        double delta_fact =  elem_delta * 0.5;
-        double vol_factor = M_PI * 0.5 / elem_delta;
-
-        vol_factor *= std::sqrt(vol_factor) * ref_data.elements[0].weightFactor * ref_data.elements[0].weightFactor;
-        max_dist *= max_dist;
-
-        double grad_fact = -elem_delta * vol_factor;
-
-        for (std::size_t i = 0, num_ovl_elem = algdShapeData.colElemOffs; i < num_ovl_elem; i++) {
-            const ShapeData::Element& elem1 = algdShapeData.elements[i];
-            Math::Vector3D::ConstPointer elem1_ctr = elem1.center.getData();
-            Math::Vector3D::Pointer elem1_grad = grad_data[i].getData();
-
-            elem1_grad[0] = 0.0;
-            elem1_grad[1] = 0.0;
-            elem1_grad[2] = 0.0;
+    if (!color) {
+        for (std::size_t i = 0, num_ovl_elem = ovl_data.colElemOffs; i < num_ovl_elem; i++) {
+            const ShapeData::Element& elem = ovl_data.elements[i];
 
-            for (std::size_t j = 0, num_ref_elem = ref_data.colElemOffs; j < num_ref_elem; j++) {
-                const ShapeData::Element& elem2 = ref_data.elements[j];
-                Math::Vector3D::ConstPointer elem2_ctr = elem2.center.getData();
-                double sqrd_ctr_dist = calcSquaredDistance(elem1_ctr, elem2_ctr);
+            overlap += calcPackedElementOverlap(ref_data.packedElemData, elem.center.getData(), elem.radius, elem.delta,
+                                                elem.weightFactor, elem.color, true, RADIUS_SCALING_FACTOR, true);
+        }
+    }
 
-                if (sqrd_ctr_dist > max_dist)
-                    continue;
+    for (std::size_t i = ovl_data.colElemOffs, num_ovl_elem = ovl_data.elements.size(); i < num_ovl_elem; i++) {
+        const ShapeData::Element& elem = ovl_data.elements[i];
 
-                double prod_fact_exp = -delta_fact * sqrd_ctr_dist;
-                double overlap_contrib = exp_func(prod_fact_exp);
+        overlap += calcPackedElementOverlap(ref_data.packedColElemData, elem.center.getData(), elem.radius, elem.delta,
+                                            elem.weightFactor, elem.color, true, RADIUS_SCALING_FACTOR, true);
+    }
+        
+    return overlap;
+}
 
-                overlap += overlap_contrib;
-    
-                elem1_grad[0] += overlap_contrib * (elem1_ctr[0] - elem2_ctr[0]);
-                elem1_grad[1] += overlap_contrib * (elem1_ctr[1] - elem2_ctr[1]);
-                elem1_grad[2] += overlap_contrib * (elem1_ctr[2] - elem2_ctr[2]);
-            }
+void Shape::FastGaussianShapeAlignment::calcStartTransformOverlaps(const ShapeData& ref_data, std::size_t start_idx, std::size_t num_starts)
+{
+    std::size_t num_elem = algdShapeData.elements.size();
 
-            elem1_grad[0] *= grad_fact;
-            elem1_grad[1] *= grad_fact;
-            elem1_grad[2] *= grad_fact;
-        }
+    batchPoseCoords.resize(num_elem * num_starts * 3);
+    batchOverlaps.assign(num_starts, 0.0);
 
-        overlap *= vol_factor;
+    // element centers are stored element-major so that the overlaps of all start poses can be calculated
+    // with a single pass over the packed reference shape element data per aligned shape element
 
-    } else {
-        for (std::size_t i = 0, num_ovl_elem = algdShapeData.colElemOffs; i < num_ovl_elem; i++) {
-            const ShapeData::Element& elem1 = algdShapeData.elements[i];
-            Math::Vector3D::ConstPointer elem1_ctr = elem1.center.getData();
-            Math::Vector3D::Pointer elem1_grad = grad_data[i].getData();
-
-            elem1_grad[0] = 0.0;
-            elem1_grad[1] = 0.0;
-            elem1_grad[2] = 0.0;
-
-            for (std::size_t j = 0, num_ref_elem = ref_data.colElemOffs; j < num_ref_elem; j++) {
-                const ShapeData::Element& elem2 = ref_data.elements[j];
-                Math::Vector3D::ConstPointer elem2_ctr = elem2.center.getData();
-                double sqrd_ctr_dist = calcSquaredDistance(elem1_ctr, elem2_ctr);
-                double max_dist = (elem1.radius + elem2.radius) * RADIUS_SCALING_FACTOR;
-
-                if (sqrd_ctr_dist > (max_dist * max_dist))
-                    continue;
+    for (std::size_t i = 0; i < num_starts; i++) {
+        quaternionToMatrix(startTransforms[start_idx + i], xformMatrix);
 
-                double delta = elem1.delta + elem2.delta;
-                double vol_factor = M_PI / delta;
-                double prod_fact_exp = -elem1.delta * elem2.delta * sqrd_ctr_dist / delta;
-                double overlap_contrib = elem1.weightFactor * elem2.weightFactor * vol_factor *
-                    std::sqrt(vol_factor) * exp_func(prod_fact_exp);
+        for (std::size_t j = 0; j < num_elem; j++)
+            transform(&batchPoseCoords[(j * num_starts + i) * 3], xformMatrix.getData(), startPoseCoords[j].getData());
+    }
 
-                overlap += overlap_contrib;
+    for (std::size_t i = 0; i < num_elem; i++) {
+        const ShapeData::Element& elem = algdShapeData.elements[i];
 
-                inters_prod_ctr_data[0] = (elem1_ctr[0] * elem1.delta + elem2_ctr[0] * elem2.delta) / delta;
-                inters_prod_ctr_data[1] = (elem1_ctr[1] * elem1.delta + elem2_ctr[1] * elem2.delta) / delta;
-                inters_prod_ctr_data[2] = (elem1_ctr[2] * elem1.delta + elem2_ctr[2] * elem2.delta) / delta;
-            
-                double grad_factor = -elem1.delta * 2.0 * overlap_contrib;
-            
-                elem1_grad[0] += grad_factor * (elem1_ctr[0] - inters_prod_ctr_data[0]);
-                elem1_grad[1] += grad_factor * (elem1_ctr[1] - inters_prod_ctr_data[1]);
-                elem1_grad[2] += grad_factor * (elem1_ctr[2] - inters_prod_ctr_data[2]);
-            }
-        }
+        calcPackedElementOverlaps(i < algdShapeData.colElemOffs ? ref_data.packedElemData : ref_data.packedColElemData,
+                                  &batchPoseCoords[i * num_starts * 3], num_starts, elem.radius, elem.delta, elem.weightFactor,
+                                  elem.color, true, RADIUS_SCALING_FACTOR, true, batchOverlaps.data());
     }
+}
 
-    for (std::size_t i = algdShapeData.colElemOffs, num_ovl_elem = algdShapeData.elements.size(); i < num_ovl_elem; i++) {
-        const ShapeData::Element& elem1 = algdShapeData.elements[i];
-        Math::Vector3D::ConstPointer elem1_ctr = elem1.center.getData();
-        Math::Vector3D::Pointer elem1_grad = grad_data[i].getData();
+double Shape::FastGaussianShapeAlignment::calcColorSelfOverlaps(ShapeData& data) const
+{
+    double overlap = 0.0;
 
-        elem1_grad[0] = 0.0;
-        elem1_grad[1] = 0.0;
-        elem1_grad[2] = 0.0;
+    data.colSelfOverlaps.clear();
 
-        for (std::size_t j = ref_data.colElemOffs, num_ref_elem = ref_data.elements.size(); j < num_ref_elem; j++) {
-            const ShapeData::Element& elem2 = ref_data.elements[j];
+    for (std::size_t i = data.colElemOffs, num_elem = data.elements.size(); i < num_elem; i++) {
+        const ShapeData::Element& elem = data.elements[i];
+        double elem_ovlp = calcPackedElementOverlap(data.packedColElemData, elem.center.getData(), elem.radius, elem.delta,
+                                                    elem.weightFactor, elem.color, true, RADIUS_SCALING_FACTOR, true);
+        overlap += elem_ovlp;
+
+        ShapeData::ColorSelfOverlapArray::iterator it = std::find_if(data.colSelfOverlaps.begin(), data.colSelfOverlaps.end(),
+                                                                     [&](const std::pair<std::size_t, double>& entry) {
+                                                                         return (entry.first == elem.color);
+                                                                     });
+        if (it == data.colSelfOverlaps.end())
+            data.colSelfOverlaps.emplace_back(elem.color, elem_ovlp);
+        else
+            it->second += elem_ovlp;
+    }
 
-            if (elem2.color != elem1.color)
-                continue;
+    std::sort(data.colSelfOverlaps.begin(), data.colSelfOverlaps.end());
     
-            Math::Vector3D::ConstPointer elem2_ctr = elem2.center.getData();
-            double sqrd_ctr_dist = calcSquaredDistance(elem1_ctr, elem2_ctr);
-            double max_dist = (elem1.radius + elem2.radius) * RADIUS_SCALING_FACTOR;
+    return overlap;
+}
 
-            if (sqrd_ctr_dist > (max_dist * max_dist))
-                continue;
+double Shape::FastGaussianShapeAlignment::calcColorOverlapBound(const ShapeData& ref_data, const ShapeData& ovl_data) const
+{
+    // color elements only overlap with elements of the same color -> bound the overlap separately for each color
 
-            double delta = elem1.delta + elem2.delta;
-            double vol_factor = M_PI / delta;
-            double prod_fact_exp = -elem1.delta * elem2.delta * sqrd_ctr_dist / delta;
-            double overlap_contrib = elem1.weightFactor * elem2.weightFactor * vol_factor *
-                std::sqrt(vol_factor) * exp_func(prod_fact_exp);
+    double bound = 0.0;
 
-            overlap += overlap_contrib;
+    for (ShapeData::ColorSelfOverlapArray::const_iterator it1 = ref_data.colSelfOverlaps.begin(), end1 = ref_data.colSelfOverlaps.end(),
+             it2 = ovl_data.colSelfOverlaps.begin(), end2 = ovl_data.colSelfOverlaps.end(); it1 != end1 && it2 != end2; ) {
 
-            inters_prod_ctr_data[0] = (elem1_ctr[0] * elem1.delta + elem2_ctr[0] * elem2.delta) / delta;
-            inters_prod_ctr_data[1] = (elem1_ctr[1] * elem1.delta + elem2_ctr[1] * elem2.delta) / delta;
-            inters_prod_ctr_data[2] = (elem1_ctr[2] * elem1.delta + elem2_ctr[2] * elem2.delta) / delta;
+        if (it1->first < it2->first)
+            ++it1;
 
-            double grad_factor = -elem1.delta * 2.0 * overlap_contrib;
-            
-            elem1_grad[0] += grad_factor * (elem1_ctr[0] - inters_prod_ctr_data[0]);
-            elem1_grad[1] += grad_factor * (elem1_ctr[1] - inters_prod_ctr_data[1]);
-            elem1_grad[2] += grad_factor * (elem1_ctr[2] - inters_prod_ctr_data[2]);
+        else if (it2->first < it1->first)
+            ++it2;
+
+        else {
+            bound += std::sqrt(std::max(it1->second, 0.0) * std::max(it2->second, 0.0));
+            ++it1;
+            ++it2;
         }
     }
-    
-    return overlap;
+
+    return bound;
 }
 
 bool Shape::FastGaussianShapeAlignment::getResultIndex(const ResultID& res_id, std::size_t& res_idx)
@@ -1374,7 +1485,3 @@ bool Shape::FastGaussianShapeAlignment::getResultIndex(const ResultID& res_id, s
     res_idx = it->second;
     return false;
 }
-
-#ifndef _MSC_VER
-# pragma GCC diagnostic pop
-#endif // !_MSC_VER
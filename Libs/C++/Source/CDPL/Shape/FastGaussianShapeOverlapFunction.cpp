@@ -36,6 +36,7 @@
 
 #include "GaussianProductList.hpp"
 #include "GaussianProduct.hpp"
+#include "GaussianOverlapKernels.hpp"
 #include "Utilities.hpp"
 
 #if defined(__APPLE__) && defined(__clang__)
@@ -237,6 +238,9 @@ bool Shape::FastGaussianShapeOverlapFunction::checkShapeFuncsNotNull() const
 double Shape::FastGaussianShapeOverlapFunction::calcOverlap(const GaussianProductList* ref_prod_list, const GaussianProductList* ovl_prod_list, 
                                                             bool color) const
 {
+    if (usePackedElementData(ref_prod_list, ovl_prod_list, color))
+        return calcFirstOrderOverlap(ref_prod_list, ovl_prod_list, color);
+
     if (proximityOpt) {
         if (fastExpFunc)
             return calcOverlapFastExpProxCheck(ref_prod_list, ovl_prod_list, color);
@@ -249,6 +253,36 @@ double Shape::FastGaussianShapeOverlapFunction::calcOverlap(const GaussianProduc
     return calcOverlapExact(ref_prod_list, ovl_prod_list, color);
 }
 
+bool Shape::FastGaussianShapeOverlapFunction::usePackedElementData(const GaussianProductList* ref_prod_list, const GaussianProductList* ovl_prod_list,
+                                                                   bool color) const
+{
+    // custom color match or filter functions cannot be evaluated by the packed element overlap kernels
+
+    if (colorMatchFunc || (color && colorFilterFunc))
+        return false;
+    
+    return (ref_prod_list->getMaxOrder() == 1 && ovl_prod_list->getMaxOrder() == 1);
+}
+
+double Shape::FastGaussianShapeOverlapFunction::calcFirstOrderOverlap(const GaussianProductList* ref_prod_list, const GaussianProductList* ovl_prod_list,
+                                                                      bool color) const
+{
+    const std::vector<double>& ref_elem_data = ref_prod_list->getPackedElementData();
+    double overlap = 0.0;
+
+    for (GaussianProductList::ConstProductIterator p_it = ovl_prod_list->getProductsBegin(), p_end = ovl_prod_list->getProductsEnd(); p_it != p_end; ++p_it) {
+        const GaussianProduct* prod = *p_it;
+
+        if (color && prod->getColor() == 0)
+            continue;
+
+        overlap += calcPackedElementOverlap(ref_elem_data, prod->getCenter().getData(), prod->getRadius(), prod->getDelta(),
+                                            prod->getWeightFactor(), prod->getColor(), proximityOpt, radScalingFact, fastExpFunc);
+    }
+
+    return overlap;
+}
+
 double Shape::FastGaussianShapeOverlapFunction::calcOverlapExact(const GaussianProductList* ref_prod_list, const GaussianProductList* ovl_prod_list,
                                                                  bool color) const
 {
@@ -744,6 +778,9 @@ double Shape::FastGaussianShapeOverlapFunction::calcOverlapFastExpProxCheck(cons
 double Shape::FastGaussianShapeOverlapFunction::calcOverlap(const GaussianProductList* ref_prod_list, const GaussianProductList* ovl_prod_list,
                                                             const Math::Vector3DArray& coords, bool color) const
 {
+    if (usePackedElementData(ref_prod_list, ovl_prod_list, color))
+        return calcFirstOrderOverlap(ref_prod_list, ovl_prod_list, coords, color);
+
     if (proximityOpt) {
         if (fastExpFunc)
             return calcOverlapFastExpProxCheck(ref_prod_list, ovl_prod_list, coords, color);
@@ -756,6 +793,26 @@ double Shape::FastGaussianShapeOverlapFunction::calcOverlap(const GaussianProduc
     return calcOverlapExact(ref_prod_list, ovl_prod_list, coords, color);
 }
 
+double Shape::FastGaussianShapeOverlapFunction::calcFirstOrderOverlap(const GaussianProductList* ref_prod_list, const GaussianProductList* ovl_prod_list,
+                                                                      const Math::Vector3DArray& coords, bool color) const
+{
+    const Math::Vector3DArray::StorageType& coords_data = coords.getData();
+    const std::vector<double>& ref_elem_data = ref_prod_list->getPackedElementData();
+    double overlap = 0.0;
+
+    for (GaussianProductList::ConstProductIterator p_it = ovl_prod_list->getProductsBegin(), p_end = ovl_prod_list->getProductsEnd(); p_it != p_end; ++p_it) {
+        const GaussianProduct* prod = *p_it;
+
+        if (color && prod->getColor() == 0)
+            continue;
+
+        overlap += calcPackedElementOverlap(ref_elem_data, coords_data[prod->getIndex()].getData(), prod->getRadius(), prod->getDelta(),
+                                            prod->getWeightFactor(), prod->getColor(), proximityOpt, radScalingFact, fastExpFunc);
+    }
+
+    return overlap;
+}
+
 double Shape::FastGaussianShapeOverlapFunction::calcOverlapExact(const GaussianProductList* ref_prod_list, const GaussianProductList* ovl_prod_list,
                                                                  const Math::Vector3DArray& coords, bool color) const
 {
@@ -1319,6 +1376,9 @@ double Shape::FastGaussianShapeOverlapFunction::calcOverlapGradient(const Gaussi
 {
     grad.assign(ovl_prod_list->getNumShapeElements(), Math::Vector3D());
 
+    if (usePackedElementData(ref_prod_list, ovl_prod_list, false))
+        return calcFirstOrderOverlapGradient(ref_prod_list, ovl_prod_list, coords, grad);
+
     if (proximityOpt) {
         if (fastExpFunc)
             return calcOverlapGradientFastExpProxCheck(ref_prod_list, ovl_prod_list, coords, grad);
@@ -1331,6 +1391,26 @@ double Shape::FastGaussianShapeOverlapFunction::calcOverlapGradient(const Gaussi
     return calcOverlapGradientExact(ref_prod_list, ovl_prod_list, coords, grad);    
 }
 
+double Shape::FastGaussianShapeOverlapFunction::calcFirstOrderOverlapGradient(const GaussianProductList* ref_prod_list, const GaussianProductList* ovl_prod_list,
+                                                                              const Math::Vector3DArray& coords, Math::Vector3DArray& grad) const
+{
+    const Math::Vector3DArray::StorageType& coords_data = coords.getData();
+    Math::Vector3DArray::StorageType& grad_data = grad.getData();
+    const std::vector<double>& ref_elem_data = ref_prod_list->getPackedElementData();
+    double overlap = 0.0;
+
+    for (GaussianProductList::ConstProductIterator p_it = ovl_prod_list->getProductsBegin(), p_end = ovl_prod_list->getProductsEnd(); p_it != p_end; ++p_it) {
+        const GaussianProduct* prod = *p_it;
+        std::size_t prod_idx = prod->getIndex();
+
+        overlap += calcPackedElementOverlapGradient(ref_elem_data, coords_data[prod_idx].getData(), prod->getRadius(), prod->getDelta(),
+                                                    prod->getWeightFactor(), prod->getColor(), proximityOpt, radScalingFact, fastExpFunc,
+                                                    grad_data[prod_idx].getData());
+    }
+
+    return overlap;
+}
+
 double Shape::FastGaussianShapeOverlapFunction::calcOverlapGradientExact(const GaussianProductList* ref_prod_list, const GaussianProductList* ovl_prod_list,
                                                                          const Math::Vector3DArray& coords, Math::Vector3DArray& grad) const
 {
@@ -0,0 +1,1087 @@
+/* 
+ * GaussianOverlapKernels.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+#ifndef _MSC_VER
+# pragma GCC diagnostic push
+# pragma GCC diagnostic ignored "-Wstrict-aliasing" // fastexp causes annoying aliasing warnings!
+# pragma GCC diagnostic ignored "-Wuninitialized"   // false positives caused by _mm512_undefined_pd()
+# pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif // !_MSC_VER
+
+#include "StaticInit.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+#if defined(__APPLE__) && defined(__clang__)
+# define exp_func(arg) std::exp(arg)
+#elif defined(_MSC_VER)
+# define exp_func(arg) std::exp(arg)
+#else
+# include "FastExp/fastexp.h"
+# define exp_func(arg) fastexp::IEEE<double, 3>::evaluate(arg)
+# if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#  define CDPL_SHAPE_OVERLAP_KERNEL_X86_DISPATCH
+#  include <immintrin.h>
+# endif
+#endif
+
+#include "GaussianOverlapKernels.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+    enum
+    {
+
+        CTR_X_BLOCK,
+        CTR_Y_BLOCK,
+        CTR_Z_BLOCK,
+        RADIUS_BLOCK,
+        DELTA_BLOCK,
+        WEIGHT_BLOCK,
+        COLOR_BLOCK,
+        NUM_BLOCKS
+    };
+
+    constexpr std::size_t BLOCK_SIZE_MULTIPLE = 8;
+    constexpr double      NO_MATCH_COLOR      = -1.0;
+    constexpr double      UNSET_COMMON_DELTA  = -1.0;
+    constexpr double      NO_COMMON_DELTA     = 0.0;
+
+    // arguments below this value would underflow the exponent of the fast exponential function's result
+
+    constexpr double MIN_FAST_EXP_ARG = -708.0;
+
+    // upper limit for the number of positions processed by a single call of a batched overlap kernel
+
+    constexpr std::size_t MAX_BATCH_SIZE = 8;
+
+    typedef double (*OverlapFunction)(const double*, std::size_t, const double*, double, double, double, double, double, double*);
+    typedef void (*BatchOverlapFunction)(const double*, std::size_t, const double*, std::size_t, double, double, double, double, double, double*);
+    typedef void (*BatchGradientFunction)(const double*, std::size_t, const double*, std::size_t, double, double, double, double, double, double*, double*);
+
+    template <bool FAST_EXP>
+    inline double expFunc(double arg)
+    {
+        if (FAST_EXP)
+            return exp_func(std::max(arg, MIN_FAST_EXP_ARG));
+
+        return std::exp(arg);
+    }
+
+    template <bool PROX_CHECK, bool FAST_EXP, bool GRAD>
+    double calcOverlapPortable(const double* data, std::size_t blk_size, const double* ctr, double radius, double delta,
+                               double weight, double color, double rad_scaling, double* grad)
+    {
+        const double* ctr_x = data + CTR_X_BLOCK * blk_size;
+        const double* ctr_y = data + CTR_Y_BLOCK * blk_size;
+        const double* ctr_z = data + CTR_Z_BLOCK * blk_size;
+        const double* radii = data + RADIUS_BLOCK * blk_size;
+        const double* deltas = data + DELTA_BLOCK * blk_size;
+        const double* weights = data + WEIGHT_BLOCK * blk_size;
+        const double* colors = data + COLOR_BLOCK * blk_size;
+        const bool    common_delta = (data[NUM_BLOCKS * blk_size] == delta);
+        double overlap = 0.0;
+        double grad_x = 0.0;
+        double grad_y = 0.0;
+        double grad_z = 0.0;
+        double inv_sum_delta = 0.5 / delta;
+        double vol_factor = M_PI * 0.5 / delta;
+        double vol_factor_prod = vol_factor * std::sqrt(vol_factor);
+
+        radius *= rad_scaling;
+
+        for (std::size_t i = 0; i < blk_size; i++) {
+            if (colors[i] != color)
+                continue;
+
+            double dx = ctr[0] - ctr_x[i];
+            double dy = ctr[1] - ctr_y[i];
+            double dz = ctr[2] - ctr_z[i];
+            double sqrd_ctr_dist = dx * dx + dy * dy + dz * dz;
+
+            if (PROX_CHECK) {
+                double max_dist = radius + radii[i] * rad_scaling;
+
+                if (sqrd_ctr_dist > (max_dist * max_dist))
+                    continue;
+            }
+
+            if (!common_delta) {
+                inv_sum_delta = 1.0 / (delta + deltas[i]);
+                vol_factor = M_PI * inv_sum_delta;
+                vol_factor_prod = vol_factor * std::sqrt(vol_factor);
+            }
+
+            double contrib = weight * weights[i] * vol_factor_prod *
+                expFunc<FAST_EXP>(-delta * deltas[i] * sqrd_ctr_dist * inv_sum_delta);
+
+            overlap += contrib;
+
+            if (!GRAD)
+                continue;
+
+            // ctr minus the center of the product Gaussian equals (ctr - elem. center) * elem. delta / (delta + elem. delta)
+
+            double grad_factor = -delta * 2.0 * contrib * deltas[i] * inv_sum_delta;
+
+            grad_x += grad_factor * dx;
+            grad_y += grad_factor * dy;
+            grad_z += grad_factor * dz;
+        }
+
+        if (GRAD) {
+            grad[0] = grad_x;
+            grad[1] = grad_y;
+            grad[2] = grad_z;
+        }
+
+        return overlap;
+    }
+
+    template <bool PROX_CHECK, bool FAST_EXP>
+    void calcOverlapsPortable(const double* data, std::size_t blk_size, const double* ctrs, std::size_t num_ctrs, double radius,
+                              double delta, double weight, double color, double rad_scaling, double* overlaps)
+    {
+        for (std::size_t i = 0; i < num_ctrs; i++)
+            overlaps[i] += calcOverlapPortable<PROX_CHECK, FAST_EXP, false>(data, blk_size, ctrs + i * 3, radius, delta, weight,
+                                                                            color, rad_scaling, 0);
+    }
+
+    template <bool PROX_CHECK, bool FAST_EXP>
+    void calcOverlapGradientsPortable(const double* data, std::size_t blk_size, const double* ctrs, std::size_t num_ctrs, double radius,
+                                      double delta, double weight, double color, double rad_scaling, double* overlaps, double* grads)
+    {
+        for (std::size_t i = 0; i < num_ctrs; i++)
+            overlaps[i] += calcOverlapPortable<PROX_CHECK, FAST_EXP, true>(data, blk_size, ctrs + i * 3, radius, delta, weight,
+                                                                           color, rad_scaling, grads + i * 3);
+    }
+
+#ifdef CDPL_SHAPE_OVERLAP_KERNEL_X86_DISPATCH
+
+    // vectorized versions of fastexp::IEEE<double, 3>::evaluate(); the integer part of the scaled argument
+    // gets converted to a 64-bit integer by adding and subtracting the bit pattern of 1.5 * 2^52
+
+    constexpr double EXP_INT_CONV_MAGIC = 6755399441055744.0;
+
+    __attribute__((target("avx2")))
+    inline __m256d fastExp256(__m256d arg)
+    {
+        typedef fastexp::Data<double, 3> Coeffs;
+
+        const __m256d magic = _mm256_set1_pd(EXP_INT_CONV_MAGIC);
+
+        __m256d x = _mm256_mul_pd(_mm256_max_pd(arg, _mm256_set1_pd(MIN_FAST_EXP_ARG)), _mm256_set1_pd(fastexp::Info<double>::log2e));
+        __m256d xi = _mm256_floor_pd(x);
+        __m256d xf = _mm256_sub_pd(x, xi);
+        __m256d k = _mm256_set1_pd(Coeffs::coefficients[3]);
+
+        k = _mm256_add_pd(_mm256_mul_pd(k, xf), _mm256_set1_pd(Coeffs::coefficients[2]));
+        k = _mm256_add_pd(_mm256_mul_pd(k, xf), _mm256_set1_pd(Coeffs::coefficients[1]));
+        k = _mm256_add_pd(_mm256_mul_pd(k, xf), _mm256_set1_pd(Coeffs::coefficients[0]));
+        k = _mm256_add_pd(k, _mm256_set1_pd(1.0));
+
+        __m256i e = _mm256_sub_epi64(_mm256_castpd_si256(_mm256_add_pd(xi, magic)), _mm256_castpd_si256(magic));
+
+        return _mm256_castsi256_pd(_mm256_add_epi64(_mm256_castpd_si256(k), _mm256_slli_epi64(e, 52)));
+    }
+
+    __attribute__((target("avx2")))
+    inline double sumLanes(__m256d v)
+    {
+        __m128d sum = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+
+        return _mm_cvtsd_f64(_mm_add_sd(sum, _mm_unpackhi_pd(sum, sum)));
+    }
+
+    template <bool PROX_CHECK, bool GRAD>
+    __attribute__((target("avx2")))
+    double calcOverlapAVX2(const double* data, std::size_t blk_size, const double* ctr, double radius, double delta,
+                           double weight, double color, double rad_scaling, double* grad)
+    {
+        const double* ctr_x = data + CTR_X_BLOCK * blk_size;
+        const double* ctr_y = data + CTR_Y_BLOCK * blk_size;
+        const double* ctr_z = data + CTR_Z_BLOCK * blk_size;
+        const double* radii = data + RADIUS_BLOCK * blk_size;
+        const double* deltas = data + DELTA_BLOCK * blk_size;
+        const double* weights = data + WEIGHT_BLOCK * blk_size;
+        const double* colors = data + COLOR_BLOCK * blk_size;
+
+        const __m256d v_ctr_x = _mm256_set1_pd(ctr[0]);
+        const __m256d v_ctr_y = _mm256_set1_pd(ctr[1]);
+        const __m256d v_ctr_z = _mm256_set1_pd(ctr[2]);
+        const __m256d v_radius = _mm256_set1_pd(radius * rad_scaling);
+        const __m256d v_rad_scaling = _mm256_set1_pd(rad_scaling);
+        const __m256d v_delta = _mm256_set1_pd(delta);
+        const __m256d v_neg_delta = _mm256_set1_pd(-delta);
+        const __m256d v_weight = _mm256_set1_pd(weight);
+        const __m256d v_color = _mm256_set1_pd(color);
+        const __m256d v_pi = _mm256_set1_pd(M_PI);
+        const __m256d v_one = _mm256_set1_pd(1.0);
+        const __m256d v_grad_fact = _mm256_set1_pd(-delta * 2.0);
+        const bool    common_delta = (data[NUM_BLOCKS * blk_size] == delta);
+
+        __m256d inv_sum_delta = _mm256_set1_pd(0.5 / delta);
+        __m256d vol_factor_prod = _mm256_set1_pd(M_PI * 0.5 / delta * std::sqrt(M_PI * 0.5 / delta));
+
+        __m256d overlap = _mm256_setzero_pd();
+        __m256d grad_x = _mm256_setzero_pd();
+        __m256d grad_y = _mm256_setzero_pd();
+        __m256d grad_z = _mm256_setzero_pd();
+
+        for (std::size_t i = 0; i < blk_size; i += 4) {
+            __m256d mask = _mm256_cmp_pd(_mm256_loadu_pd(colors + i), v_color, _CMP_EQ_OQ);
+
+            if (_mm256_movemask_pd(mask) == 0)
+                continue;
+
+            __m256d elem_ctr_x = _mm256_loadu_pd(ctr_x + i);
+            __m256d elem_ctr_y = _mm256_loadu_pd(ctr_y + i);
+            __m256d elem_ctr_z = _mm256_loadu_pd(ctr_z + i);
+            __m256d dx = _mm256_sub_pd(v_ctr_x, elem_ctr_x);
+            __m256d dy = _mm256_sub_pd(v_ctr_y, elem_ctr_y);
+            __m256d dz = _mm256_sub_pd(v_ctr_z, elem_ctr_z);
+            __m256d sqrd_ctr_dist = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)), _mm256_mul_pd(dz, dz));
+
+            if (PROX_CHECK) {
+                __m256d max_dist = _mm256_add_pd(v_radius, _mm256_mul_pd(_mm256_loadu_pd(radii + i), v_rad_scaling));
+
+                mask = _mm256_and_pd(mask, _mm256_cmp_pd(sqrd_ctr_dist, _mm256_mul_pd(max_dist, max_dist), _CMP_LE_OQ));
+
+                if (_mm256_movemask_pd(mask) == 0)
+                    continue;
+            }
+
+            __m256d elem_delta = _mm256_loadu_pd(deltas + i);
+
+            if (!common_delta) {
+                inv_sum_delta = _mm256_div_pd(v_one, _mm256_add_pd(v_delta, elem_delta));
+
+                __m256d vol_factor = _mm256_mul_pd(v_pi, inv_sum_delta);
+
+                vol_factor_prod = _mm256_mul_pd(vol_factor, _mm256_sqrt_pd(vol_factor));
+            }
+
+            __m256d exp_arg = _mm256_mul_pd(_mm256_mul_pd(_mm256_mul_pd(v_neg_delta, elem_delta), sqrd_ctr_dist), inv_sum_delta);
+            __m256d contrib = _mm256_mul_pd(_mm256_mul_pd(v_weight, _mm256_loadu_pd(weights + i)), vol_factor_prod);
+
+            contrib = _mm256_and_pd(mask, _mm256_mul_pd(contrib, fastExp256(exp_arg)));
+            overlap = _mm256_add_pd(overlap, contrib);
+
+            if (!GRAD)
+                continue;
+
+            __m256d grad_factor = _mm256_mul_pd(_mm256_mul_pd(_mm256_mul_pd(v_grad_fact, contrib), elem_delta), inv_sum_delta);
+
+            grad_x = _mm256_add_pd(grad_x, _mm256_mul_pd(grad_factor, dx));
+            grad_y = _mm256_add_pd(grad_y, _mm256_mul_pd(grad_factor, dy));
+            grad_z = _mm256_add_pd(grad_z, _mm256_mul_pd(grad_factor, dz));
+        }
+
+        if (GRAD) {
+            grad[0] = sumLanes(grad_x);
+            grad[1] = sumLanes(grad_y);
+            grad[2] = sumLanes(grad_z);
+        }
+
+        return sumLanes(overlap);
+    }
+
+    // performs exactly the same floating point operations per position as calcOverlapAVX2<PROX_CHECK, false>() but
+    // loads the packed element data only once for all positions
+
+    template <bool PROX_CHECK>
+    __attribute__((target("avx2")))
+    void calcOverlapsAVX2(const double* data, std::size_t blk_size, const double* ctrs, std::size_t num_ctrs, double radius,
+                          double delta, double weight, double color, double rad_scaling, double* overlaps)
+    {
+        const double* ctr_x = data + CTR_X_BLOCK * blk_size;
+        const double* ctr_y = data + CTR_Y_BLOCK * blk_size;
+        const double* ctr_z = data + CTR_Z_BLOCK * blk_size;
+        const double* radii = data + RADIUS_BLOCK * blk_size;
+        const double* deltas = data + DELTA_BLOCK * blk_size;
+        const double* weights = data + WEIGHT_BLOCK * blk_size;
+        const double* colors = data + COLOR_BLOCK * blk_size;
+
+        const __m256d v_radius = _mm256_set1_pd(radius * rad_scaling);
+        const __m256d v_rad_scaling = _mm256_set1_pd(rad_scaling);
+        const __m256d v_delta = _mm256_set1_pd(delta);
+        const __m256d v_neg_delta = _mm256_set1_pd(-delta);
+        const __m256d v_weight = _mm256_set1_pd(weight);
+        const __m256d v_color = _mm256_set1_pd(color);
+        const __m256d v_pi = _mm256_set1_pd(M_PI);
+        const __m256d v_one = _mm256_set1_pd(1.0);
+        const bool    common_delta = (data[NUM_BLOCKS * blk_size] == delta);
+
+        __m256d inv_sum_delta = _mm256_set1_pd(0.5 / delta);
+        __m256d vol_factor_prod = _mm256_set1_pd(M_PI * 0.5 / delta * std::sqrt(M_PI * 0.5 / delta));
+        __m256d overlap[MAX_BATCH_SIZE];
+
+        for (std::size_t j = 0; j < num_ctrs; j++)
+            overlap[j] = _mm256_setzero_pd();
+
+        for (std::size_t i = 0; i < blk_size; i += 4) {
+            __m256d color_mask = _mm256_cmp_pd(_mm256_loadu_pd(colors + i), v_color, _CMP_EQ_OQ);
+
+            if (_mm256_movemask_pd(color_mask) == 0)
+                continue;
+
+            __m256d elem_ctr_x = _mm256_loadu_pd(ctr_x + i);
+            __m256d elem_ctr_y = _mm256_loadu_pd(ctr_y + i);
+            __m256d elem_ctr_z = _mm256_loadu_pd(ctr_z + i);
+            __m256d elem_delta = _mm256_loadu_pd(deltas + i);
+            __m256d sqrd_max_dist = _mm256_setzero_pd();
+
+            if (PROX_CHECK) {
+                __m256d max_dist = _mm256_add_pd(v_radius, _mm256_mul_pd(_mm256_loadu_pd(radii + i), v_rad_scaling));
+
+                sqrd_max_dist = _mm256_mul_pd(max_dist, max_dist);
+            }
+
+            if (!common_delta) {
+                inv_sum_delta = _mm256_div_pd(v_one, _mm256_add_pd(v_delta, elem_delta));
+
+                __m256d vol_factor = _mm256_mul_pd(v_pi, inv_sum_delta);
+
+                vol_factor_prod = _mm256_mul_pd(vol_factor, _mm256_sqrt_pd(vol_factor));
+            }
+
+            __m256d exp_fact = _mm256_mul_pd(v_neg_delta, elem_delta);
+            __m256d contrib_fact = _mm256_mul_pd(_mm256_mul_pd(v_weight, _mm256_loadu_pd(weights + i)), vol_factor_prod);
+
+            for (std::size_t j = 0; j < num_ctrs; j++) {
+                const double* ctr = ctrs + j * 3;
+
+                __m256d dx = _mm256_sub_pd(_mm256_set1_pd(ctr[0]), elem_ctr_x);
+                __m256d dy = _mm256_sub_pd(_mm256_set1_pd(ctr[1]), elem_ctr_y);
+                __m256d dz = _mm256_sub_pd(_mm256_set1_pd(ctr[2]), elem_ctr_z);
+                __m256d sqrd_ctr_dist = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)), _mm256_mul_pd(dz, dz));
+                __m256d mask = color_mask;
+
+                if (PROX_CHECK) {
+                    mask = _mm256_and_pd(mask, _mm256_cmp_pd(sqrd_ctr_dist, sqrd_max_dist, _CMP_LE_OQ));
+
+                    if (_mm256_movemask_pd(mask) == 0)
+                        continue;
+                }
+
+                __m256d exp_arg = _mm256_mul_pd(_mm256_mul_pd(exp_fact, sqrd_ctr_dist), inv_sum_delta);
+
+                overlap[j] = _mm256_add_pd(overlap[j], _mm256_and_pd(mask, _mm256_mul_pd(contrib_fact, fastExp256(exp_arg))));
+            }
+        }
+
+        for (std::size_t j = 0; j < num_ctrs; j++)
+            overlaps[j] += sumLanes(overlap[j]);
+    }
+
+    // performs exactly the same floating point operations per position as calcOverlapAVX2<PROX_CHECK, true>() but
+    // loads the packed element data only once for all positions
+
+    template <bool PROX_CHECK>
+    __attribute__((target("avx2")))
+    void calcOverlapGradientsAVX2(const double* data, std::size_t blk_size, const double* ctrs, std::size_t num_ctrs, double radius,
+                                  double delta, double weight, double color, double rad_scaling, double* overlaps, double* grads)
+    {
+        const double* ctr_x = data + CTR_X_BLOCK * blk_size;
+        const double* ctr_y = data + CTR_Y_BLOCK * blk_size;
+        const double* ctr_z = data + CTR_Z_BLOCK * blk_size;
+        const double* radii = data + RADIUS_BLOCK * blk_size;
+        const double* deltas = data + DELTA_BLOCK * blk_size;
+        const double* weights = data + WEIGHT_BLOCK * blk_size;
+        const double* colors = data + COLOR_BLOCK * blk_size;
+
+        const __m256d v_radius = _mm256_set1_pd(radius * rad_scaling);
+        const __m256d v_rad_scaling = _mm256_set1_pd(rad_scaling);
+        const __m256d v_delta = _mm256_set1_pd(delta);
+        const __m256d v_neg_delta = _mm256_set1_pd(-delta);
+        const __m256d v_weight = _mm256_set1_pd(weight);
+        const __m256d v_color = _mm256_set1_pd(color);
+        const __m256d v_pi = _mm256_set1_pd(M_PI);
+        const __m256d v_one = _mm256_set1_pd(1.0);
+        const __m256d v_grad_fact = _mm256_set1_pd(-delta * 2.0);
+        const bool    common_delta = (data[NUM_BLOCKS * blk_size] == delta);
+
+        __m256d inv_sum_delta = _mm256_set1_pd(0.5 / delta);
+        __m256d vol_factor_prod = _mm256_set1_pd(M_PI * 0.5 / delta * std::sqrt(M_PI * 0.5 / delta));
+        __m256d overlap[MAX_BATCH_SIZE];
+        __m256d grad_x[MAX_BATCH_SIZE];
+        __m256d grad_y[MAX_BATCH_SIZE];
+        __m256d grad_z[MAX_BATCH_SIZE];
+
+        for (std::size_t j = 0; j < num_ctrs; j++) {
+            overlap[j] = _mm256_setzero_pd();
+            grad_x[j] = _mm256_setzero_pd();
+            grad_y[j] = _mm256_setzero_pd();
+            grad_z[j] = _mm256_setzero_pd();
+        }
+
+        for (std::size_t i = 0; i < blk_size; i += 4) {
+            __m256d color_mask = _mm256_cmp_pd(_mm256_loadu_pd(colors + i), v_color, _CMP_EQ_OQ);
+
+            if (_mm256_movemask_pd(color_mask) == 0)
+                continue;
+
+            __m256d elem_ctr_x = _mm256_loadu_pd(ctr_x + i);
+            __m256d elem_ctr_y = _mm256_loadu_pd(ctr_y + i);
+            __m256d elem_ctr_z = _mm256_loadu_pd(ctr_z + i);
+            __m256d elem_delta = _mm256_loadu_pd(deltas + i);
+            __m256d sqrd_max_dist = _mm256_setzero_pd();
+
+            if (PROX_CHECK) {
+                __m256d max_dist = _mm256_add_pd(v_radius, _mm256_mul_pd(_mm256_loadu_pd(radii + i), v_rad_scaling));
+
+                sqrd_max_dist = _mm256_mul_pd(max_dist, max_dist);
+            }
+
+            if (!common_delta) {
+                inv_sum_delta = _mm256_div_pd(v_one, _mm256_add_pd(v_delta, elem_delta));
+
+                __m256d vol_factor = _mm256_mul_pd(v_pi, inv_sum_delta);
+
+                vol_factor_prod = _mm256_mul_pd(vol_factor, _mm256_sqrt_pd(vol_factor));
+            }
+
+            __m256d exp_fact = _mm256_mul_pd(v_neg_delta, elem_delta);
+            __m256d contrib_fact = _mm256_mul_pd(_mm256_mul_pd(v_weight, _mm256_loadu_pd(weights + i)), vol_factor_prod);
+
+            for (std::size_t j = 0; j < num_ctrs; j++) {
+                const double* ctr = ctrs + j * 3;
+
+                __m256d dx = _mm256_sub_pd(_mm256_set1_pd(ctr[0]), elem_ctr_x);
+                __m256d dy = _mm256_sub_pd(_mm256_set1_pd(ctr[1]), elem_ctr_y);
+                __m256d dz = _mm256_sub_pd(_mm256_set1_pd(ctr[2]), elem_ctr_z);
+                __m256d sqrd_ctr_dist = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)), _mm256_mul_pd(dz, dz));
+                __m256d mask = color_mask;
+
+                if (PROX_CHECK) {
+                    mask = _mm256_and_pd(mask, _mm256_cmp_pd(sqrd_ctr_dist, sqrd_max_dist, _CMP_LE_OQ));
+
+                    if (_mm256_movemask_pd(mask) == 0)
+                        continue;
+                }
+
+                __m256d exp_arg = _mm256_mul_pd(_mm256_mul_pd(exp_fact, sqrd_ctr_dist), inv_sum_delta);
+                __m256d contrib = _mm256_and_pd(mask, _mm256_mul_pd(contrib_fact, fastExp256(exp_arg)));
+
+                overlap[j] = _mm256_add_pd(overlap[j], contrib);
+
+                __m256d grad_factor = _mm256_mul_pd(_mm256_mul_pd(_mm256_mul_pd(v_grad_fact, contrib), elem_delta), inv_sum_delta);
+
+                grad_x[j] = _mm256_add_pd(grad_x[j], _mm256_mul_pd(grad_factor, dx));
+                grad_y[j] = _mm256_add_pd(grad_y[j], _mm256_mul_pd(grad_factor, dy));
+                grad_z[j] = _mm256_add_pd(grad_z[j], _mm256_mul_pd(grad_factor, dz));
+            }
+        }
+
+        for (std::size_t j = 0; j < num_ctrs; j++) {
+            overlaps[j] += sumLanes(overlap[j]);
+            grads[j * 3] = sumLanes(grad_x[j]);
+            grads[j * 3 + 1] = sumLanes(grad_y[j]);
+            grads[j * 3 + 2] = sumLanes(grad_z[j]);
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    inline __m512d fastExp512(__m512d arg)
+    {
+        typedef fastexp::Data<double, 3> Coeffs;
+
+        const __m512d magic = _mm512_set1_pd(EXP_INT_CONV_MAGIC);
+
+        __m512d x = _mm512_mul_pd(_mm512_max_pd(arg, _mm512_set1_pd(MIN_FAST_EXP_ARG)), _mm512_set1_pd(fastexp::Info<double>::log2e));
+        __m512d xi = _mm512_roundscale_pd(x, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+        __m512d xf = _mm512_sub_pd(x, xi);
+        __m512d k = _mm512_set1_pd(Coeffs::coefficients[3]);
+
+        k = _mm512_add_pd(_mm512_mul_pd(k, xf), _mm512_set1_pd(Coeffs::coefficients[2]));
+        k = _mm512_add_pd(_mm512_mul_pd(k, xf), _mm512_set1_pd(Coeffs::coefficients[1]));
+        k = _mm512_add_pd(_mm512_mul_pd(k, xf), _mm512_set1_pd(Coeffs::coefficients[0]));
+        k = _mm512_add_pd(k, _mm512_set1_pd(1.0));
+
+        __m512i e = _mm512_sub_epi64(_mm512_castpd_si512(_mm512_add_pd(xi, magic)), _mm512_castpd_si512(magic));
+
+        return _mm512_castsi512_pd(_mm512_add_epi64(_mm512_castpd_si512(k), _mm512_slli_epi64(e, 52)));
+    }
+
+    template <bool PROX_CHECK, bool GRAD>
+    __attribute__((target("avx512f")))
+    double calcOverlapAVX512(const double* data, std::size_t blk_size, const double* ctr, double radius, double delta,
+                             double weight, double color, double rad_scaling, double* grad)
+    {
+        const double* ctr_x = data + CTR_X_BLOCK * blk_size;
+        const double* ctr_y = data + CTR_Y_BLOCK * blk_size;
+        const double* ctr_z = data + CTR_Z_BLOCK * blk_size;
+        const double* radii = data + RADIUS_BLOCK * blk_size;
+        const double* deltas = data + DELTA_BLOCK * blk_size;
+        const double* weights = data + WEIGHT_BLOCK * blk_size;
+        const double* colors = data + COLOR_BLOCK * blk_size;
+
+        const __m512d v_ctr_x = _mm512_set1_pd(ctr[0]);
+        const __m512d v_ctr_y = _mm512_set1_pd(ctr[1]);
+        const __m512d v_ctr_z = _mm512_set1_pd(ctr[2]);
+        const __m512d v_radius = _mm512_set1_pd(radius * rad_scaling);
+        const __m512d v_rad_scaling = _mm512_set1_pd(rad_scaling);
+        const __m512d v_delta = _mm512_set1_pd(delta);
+        const __m512d v_neg_delta = _mm512_set1_pd(-delta);
+        const __m512d v_weight = _mm512_set1_pd(weight);
+        const __m512d v_color = _mm512_set1_pd(color);
+        const __m512d v_pi = _mm512_set1_pd(M_PI);
+        const __m512d v_one = _mm512_set1_pd(1.0);
+        const __m512d v_grad_fact = _mm512_set1_pd(-delta * 2.0);
+        const bool    common_delta = (data[NUM_BLOCKS * blk_size] == delta);
+
+        __m512d inv_sum_delta = _mm512_set1_pd(0.5 / delta);
+        __m512d vol_factor_prod = _mm512_set1_pd(M_PI * 0.5 / delta * std::sqrt(M_PI * 0.5 / delta));
+
+        __m512d overlap = _mm512_setzero_pd();
+        __m512d grad_x = _mm512_setzero_pd();
+        __m512d grad_y = _mm512_setzero_pd();
+        __m512d grad_z = _mm512_setzero_pd();
+
+        for (std::size_t i = 0; i < blk_size; i += 8) {
+            __mmask8 mask = _mm512_cmp_pd_mask(_mm512_loadu_pd(colors + i), v_color, _CMP_EQ_OQ);
+
+            if (!mask)
+                continue;
+
+            __m512d elem_ctr_x = _mm512_loadu_pd(ctr_x + i);
+            __m512d elem_ctr_y = _mm512_loadu_pd(ctr_y + i);
+            __m512d elem_ctr_z = _mm512_loadu_pd(ctr_z + i);
+            __m512d dx = _mm512_sub_pd(v_ctr_x, elem_ctr_x);
+            __m512d dy = _mm512_sub_pd(v_ctr_y, elem_ctr_y);
+            __m512d dz = _mm512_sub_pd(v_ctr_z, elem_ctr_z);
+            __m512d sqrd_ctr_dist = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy)), _mm512_mul_pd(dz, dz));
+
+            if (PROX_CHECK) {
+                __m512d max_dist = _mm512_add_pd(v_radius, _mm512_mul_pd(_mm512_loadu_pd(radii + i), v_rad_scaling));
+
+                mask = _mm512_mask_cmp_pd_mask(mask, sqrd_ctr_dist, _mm512_mul_pd(max_dist, max_dist), _CMP_LE_OQ);
+
+                if (!mask)
+                    continue;
+            }
+
+            __m512d elem_delta = _mm512_loadu_pd(deltas + i);
+
+            if (!common_delta) {
+                inv_sum_delta = _mm512_div_pd(v_one, _mm512_add_pd(v_delta, elem_delta));
+
+                __m512d vol_factor = _mm512_mul_pd(v_pi, inv_sum_delta);
+
+                vol_factor_prod = _mm512_mul_pd(vol_factor, _mm512_sqrt_pd(vol_factor));
+            }
+
+            __m512d exp_arg = _mm512_mul_pd(_mm512_mul_pd(_mm512_mul_pd(v_neg_delta, elem_delta), sqrd_ctr_dist), inv_sum_delta);
+            __m512d contrib = _mm512_mul_pd(_mm512_mul_pd(v_weight, _mm512_loadu_pd(weights + i)), vol_factor_prod);
+
+            contrib = _mm512_maskz_mov_pd(mask, _mm512_mul_pd(contrib, fastExp512(exp_arg)));
+            overlap = _mm512_add_pd(overlap, contrib);
+
+            if (!GRAD)
+                continue;
+
+            __m512d grad_factor = _mm512_mul_pd(_mm512_mul_pd(_mm512_mul_pd(v_grad_fact, contrib), elem_delta), inv_sum_delta);
+
+            grad_x = _mm512_add_pd(grad_x, _mm512_mul_pd(grad_factor, dx));
+            grad_y = _mm512_add_pd(grad_y, _mm512_mul_pd(grad_factor, dy));
+            grad_z = _mm512_add_pd(grad_z, _mm512_mul_pd(grad_factor, dz));
+        }
+
+        if (GRAD) {
+            grad[0] = _mm512_reduce_add_pd(grad_x);
+            grad[1] = _mm512_reduce_add_pd(grad_y);
+            grad[2] = _mm512_reduce_add_pd(grad_z);
+        }
+
+        return _mm512_reduce_add_pd(overlap);
+    }
+
+    // performs exactly the same floating point operations per position as calcOverlapAVX512<PROX_CHECK, false>() but
+    // loads the packed element data only once for all positions
+
+    template <bool PROX_CHECK>
+    __attribute__((target("avx512f")))
+    void calcOverlapsAVX512(const double* data, std::size_t blk_size, const double* ctrs, std::size_t num_ctrs, double radius,
+                            double delta, double weight, double color, double rad_scaling, double* overlaps)
+    {
+        const double* ctr_x = data + CTR_X_BLOCK * blk_size;
+        const double* ctr_y = data + CTR_Y_BLOCK * blk_size;
+        const double* ctr_z = data + CTR_Z_BLOCK * blk_size;
+        const double* radii = data + RADIUS_BLOCK * blk_size;
+        const double* deltas = data + DELTA_BLOCK * blk_size;
+        const double* weights = data + WEIGHT_BLOCK * blk_size;
+        const double* colors = data + COLOR_BLOCK * blk_size;
+
+        const __m512d v_radius = _mm512_set1_pd(radius * rad_scaling);
+        const __m512d v_rad_scaling = _mm512_set1_pd(rad_scaling);
+        const __m512d v_delta = _mm512_set1_pd(delta);
+        const __m512d v_neg_delta = _mm512_set1_pd(-delta);
+        const __m512d v_weight = _mm512_set1_pd(weight);
+        const __m512d v_color = _mm512_set1_pd(color);
+        const __m512d v_pi = _mm512_set1_pd(M_PI);
+        const __m512d v_one = _mm512_set1_pd(1.0);
+        const bool    common_delta = (data[NUM_BLOCKS * blk_size] == delta);
+
+        __m512d inv_sum_delta = _mm512_set1_pd(0.5 / delta);
+        __m512d vol_factor_prod = _mm512_set1_pd(M_PI * 0.5 / delta * std::sqrt(M_PI * 0.5 / delta));
+        __m512d overlap[MAX_BATCH_SIZE];
+
+        for (std::size_t j = 0; j < num_ctrs; j++)
+            overlap[j] = _mm512_setzero_pd();
+
+        for (std::size_t i = 0; i < blk_size; i += 8) {
+            __mmask8 color_mask = _mm512_cmp_pd_mask(_mm512_loadu_pd(colors + i), v_color, _CMP_EQ_OQ);
+
+            if (!color_mask)
+                continue;
+
+            __m512d elem_ctr_x = _mm512_loadu_pd(ctr_x + i);
+            __m512d elem_ctr_y = _mm512_loadu_pd(ctr_y + i);
+            __m512d elem_ctr_z = _mm512_loadu_pd(ctr_z + i);
+            __m512d elem_delta = _mm512_loadu_pd(deltas + i);
+            __m512d sqrd_max_dist = _mm512_setzero_pd();
+
+            if (PROX_CHECK) {
+                __m512d max_dist = _mm512_add_pd(v_radius, _mm512_mul_pd(_mm512_loadu_pd(radii + i), v_rad_scaling));
+
+                sqrd_max_dist = _mm512_mul_pd(max_dist, max_dist);
+            }
+
+            if (!common_delta) {
+                inv_sum_delta = _mm512_div_pd(v_one, _mm512_add_pd(v_delta, elem_delta));
+
+                __m512d vol_factor = _mm512_mul_pd(v_pi, inv_sum_delta);
+
+                vol_factor_prod = _mm512_mul_pd(vol_factor, _mm512_sqrt_pd(vol_factor));
+            }
+
+            __m512d exp_fact = _mm512_mul_pd(v_neg_delta, elem_delta);
+            __m512d contrib_fact = _mm512_mul_pd(_mm512_mul_pd(v_weight, _mm512_loadu_pd(weights + i)), vol_factor_prod);
+
+            for (std::size_t j = 0; j < num_ctrs; j++) {
+                const double* ctr = ctrs + j * 3;
+
+                __m512d dx = _mm512_sub_pd(_mm512_set1_pd(ctr[0]), elem_ctr_x);
+                __m512d dy = _mm512_sub_pd(_mm512_set1_pd(ctr[1]), elem_ctr_y);
+                __m512d dz = _mm512_sub_pd(_mm512_set1_pd(ctr[2]), elem_ctr_z);
+                __m512d sqrd_ctr_dist = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy)), _mm512_mul_pd(dz, dz));
+                __mmask8 mask = color_mask;
+
+                if (PROX_CHECK) {
+                    mask = _mm512_mask_cmp_pd_mask(mask, sqrd_ctr_dist, sqrd_max_dist, _CMP_LE_OQ);
+
+                    if (!mask)
+                        continue;
+                }
+
+                __m512d exp_arg = _mm512_mul_pd(_mm512_mul_pd(exp_fact, sqrd_ctr_dist), inv_sum_delta);
+
+                overlap[j] = _mm512_add_pd(overlap[j], _mm512_maskz_mov_pd(mask, _mm512_mul_pd(contrib_fact, fastExp512(exp_arg))));
+            }
+        }
+
+        for (std::size_t j = 0; j < num_ctrs; j++)
+            overlaps[j] += _mm512_reduce_add_pd(overlap[j]);
+    }
+
+    // performs exactly the same floating point operations per position as calcOverlapAVX512<PROX_CHECK, true>() but
+    // loads the packed element data only once for all positions
+
+    template <bool PROX_CHECK>
+    __attribute__((target("avx512f")))
+    void calcOverlapGradientsAVX512(const double* data, std::size_t blk_size, const double* ctrs, std::size_t num_ctrs, double radius,
+                                    double delta, double weight, double color, double rad_scaling, double* overlaps, double* grads)
+    {
+        const double* ctr_x = data + CTR_X_BLOCK * blk_size;
+        const double* ctr_y = data + CTR_Y_BLOCK * blk_size;
+        const double* ctr_z = data + CTR_Z_BLOCK * blk_size;
+        const double* radii = data + RADIUS_BLOCK * blk_size;
+        const double* deltas = data + DELTA_BLOCK * blk_size;
+        const double* weights = data + WEIGHT_BLOCK * blk_size;
+        const double* colors = data + COLOR_BLOCK * blk_size;
+
+        const __m512d v_radius = _mm512_set1_pd(radius * rad_scaling);
+        const __m512d v_rad_scaling = _mm512_set1_pd(rad_scaling);
+        const __m512d v_delta = _mm512_set1_pd(delta);
+        const __m512d v_neg_delta = _mm512_set1_pd(-delta);
+        const __m512d v_weight = _mm512_set1_pd(weight);
+        const __m512d v_color = _mm512_set1_pd(color);
+        const __m512d v_pi = _mm512_set1_pd(M_PI);
+        const __m512d v_one = _mm512_set1_pd(1.0);
+        const __m512d v_grad_fact = _mm512_set1_pd(-delta * 2.0);
+        const bool    common_delta = (data[NUM_BLOCKS * blk_size] == delta);
+
+        __m512d inv_sum_delta = _mm512_set1_pd(0.5 / delta);
+        __m512d vol_factor_prod = _mm512_set1_pd(M_PI * 0.5 / delta * std::sqrt(M_PI * 0.5 / delta));
+        __m512d overlap[MAX_BATCH_SIZE];
+        __m512d grad_x[MAX_BATCH_SIZE];
+        __m512d grad_y[MAX_BATCH_SIZE];
+        __m512d grad_z[MAX_BATCH_SIZE];
+
+        for (std::size_t j = 0; j < num_ctrs; j++) {
+            overlap[j] = _mm512_setzero_pd();
+            grad_x[j] = _mm512_setzero_pd();
+            grad_y[j] = _mm512_setzero_pd();
+            grad_z[j] = _mm512_setzero_pd();
+        }
+
+        for (std::size_t i = 0; i < blk_size; i += 8) {
+            __mmask8 color_mask = _mm512_cmp_pd_mask(_mm512_loadu_pd(colors + i), v_color, _CMP_EQ_OQ);
+
+            if (!color_mask)
+                continue;
+
+            __m512d elem_ctr_x = _mm512_loadu_pd(ctr_x + i);
+            __m512d elem_ctr_y = _mm512_loadu_pd(ctr_y + i);
+            __m512d elem_ctr_z = _mm512_loadu_pd(ctr_z + i);
+            __m512d elem_delta = _mm512_loadu_pd(deltas + i);
+            __m512d sqrd_max_dist = _mm512_setzero_pd();
+
+            if (PROX_CHECK) {
+                __m512d max_dist = _mm512_add_pd(v_radius, _mm512_mul_pd(_mm512_loadu_pd(radii + i), v_rad_scaling));
+
+                sqrd_max_dist = _mm512_mul_pd(max_dist, max_dist);
+            }
+
+            if (!common_delta) {
+                inv_sum_delta = _mm512_div_pd(v_one, _mm512_add_pd(v_delta, elem_delta));
+
+                __m512d vol_factor = _mm512_mul_pd(v_pi, inv_sum_delta);
+
+                vol_factor_prod = _mm512_mul_pd(vol_factor, _mm512_sqrt_pd(vol_factor));
+            }
+
+            __m512d exp_fact = _mm512_mul_pd(v_neg_delta, elem_delta);
+            __m512d contrib_fact = _mm512_mul_pd(_mm512_mul_pd(v_weight, _mm512_loadu_pd(weights + i)), vol_factor_prod);
+
+            for (std::size_t j = 0; j < num_ctrs; j++) {
+                const double* ctr = ctrs + j * 3;
+
+                __m512d dx = _mm512_sub_pd(_mm512_set1_pd(ctr[0]), elem_ctr_x);
+                __m512d dy = _mm512_sub_pd(_mm512_set1_pd(ctr[1]), elem_ctr_y);
+                __m512d dz = _mm512_sub_pd(_mm512_set1_pd(ctr[2]), elem_ctr_z);
+                __m512d sqrd_ctr_dist = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(dx, dx), _mm512_mul_pd(dy, dy)), _mm512_mul_pd(dz, dz));
+                __mmask8 mask = color_mask;
+
+                if (PROX_CHECK) {
+                    mask = _mm512_mask_cmp_pd_mask(mask, sqrd_ctr_dist, sqrd_max_dist, _CMP_LE_OQ);
+
+                    if (!mask)
+                        continue;
+                }
+
+                __m512d exp_arg = _mm512_mul_pd(_mm512_mul_pd(exp_fact, sqrd_ctr_dist), inv_sum_delta);
+                __m512d contrib = _mm512_maskz_mov_pd(mask, _mm512_mul_pd(contrib_fact, fastExp512(exp_arg)));
+
+                overlap[j] = _mm512_add_pd(overlap[j], contrib);
+
+                __m512d grad_factor = _mm512_mul_pd(_mm512_mul_pd(_mm512_mul_pd(v_grad_fact, contrib), elem_delta), inv_sum_delta);
+
+                grad_x[j] = _mm512_add_pd(grad_x[j], _mm512_mul_pd(grad_factor, dx));
+                grad_y[j] = _mm512_add_pd(grad_y[j], _mm512_mul_pd(grad_factor, dy));
+                grad_z[j] = _mm512_add_pd(grad_z[j], _mm512_mul_pd(grad_factor, dz));
+            }
+        }
+
+        for (std::size_t j = 0; j < num_ctrs; j++) {
+            overlaps[j] += _mm512_reduce_add_pd(overlap[j]);
+            grads[j * 3] = _mm512_reduce_add_pd(grad_x[j]);
+            grads[j * 3 + 1] = _mm512_reduce_add_pd(grad_y[j]);
+            grads[j * 3 + 2] = _mm512_reduce_add_pd(grad_z[j]);
+        }
+    }
+
+#endif // CDPL_SHAPE_OVERLAP_KERNEL_X86_DISPATCH
+
+    bool isImplSupported(Shape::PackedElementOverlapImpl impl)
+    {
+        switch (impl) {
+
+            case Shape::PORTABLE_OVERLAP_IMPL:
+                return true;
+#ifdef CDPL_SHAPE_OVERLAP_KERNEL_X86_DISPATCH
+            case Shape::AVX2_OVERLAP_IMPL:
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx2");
+
+            case Shape::AVX512_OVERLAP_IMPL:
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx512f");
+#endif
+            default:
+                return false;
+        }
+    }
+
+    Shape::PackedElementOverlapImpl getBestSupportedImpl()
+    {
+        if (isImplSupported(Shape::AVX512_OVERLAP_IMPL))
+            return Shape::AVX512_OVERLAP_IMPL;
+
+        if (isImplSupported(Shape::AVX2_OVERLAP_IMPL))
+            return Shape::AVX2_OVERLAP_IMPL;
+
+        return Shape::PORTABLE_OVERLAP_IMPL;
+    }
+
+    struct OverlapKernelImpl
+    {
+
+        OverlapKernelImpl(Shape::PackedElementOverlapImpl impl)
+        {
+            switch (impl) {
+#ifdef CDPL_SHAPE_OVERLAP_KERNEL_X86_DISPATCH
+                case Shape::AVX512_OVERLAP_IMPL:
+                    fastExpFuncs[0][0] = &calcOverlapAVX512<false, false>;
+                    fastExpFuncs[0][1] = &calcOverlapAVX512<false, true>;
+                    fastExpFuncs[1][0] = &calcOverlapAVX512<true, false>;
+                    fastExpFuncs[1][1] = &calcOverlapAVX512<true, true>;
+                    fastExpBatchFuncs[0] = &calcOverlapsAVX512<false>;
+                    fastExpBatchFuncs[1] = &calcOverlapsAVX512<true>;
+                    fastExpBatchGradFuncs[0] = &calcOverlapGradientsAVX512<false>;
+                    fastExpBatchGradFuncs[1] = &calcOverlapGradientsAVX512<true>;
+                    name               = "AVX-512";
+                    return;
+
+                case Shape::AVX2_OVERLAP_IMPL:
+                    fastExpFuncs[0][0] = &calcOverlapAVX2<false, false>;
+                    fastExpFuncs[0][1] = &calcOverlapAVX2<false, true>;
+                    fastExpFuncs[1][0] = &calcOverlapAVX2<true, false>;
+                    fastExpFuncs[1][1] = &calcOverlapAVX2<true, true>;
+                    fastExpBatchFuncs[0] = &calcOverlapsAVX2<false>;
+                    fastExpBatchFuncs[1] = &calcOverlapsAVX2<true>;
+                    fastExpBatchGradFuncs[0] = &calcOverlapGradientsAVX2<false>;
+                    fastExpBatchGradFuncs[1] = &calcOverlapGradientsAVX2<true>;
+                    name               = "AVX2";
+                    return;
+#endif
+                default:
+                    fastExpFuncs[0][0] = &calcOverlapPortable<false, true, false>;
+                    fastExpFuncs[0][1] = &calcOverlapPortable<false, true, true>;
+                    fastExpFuncs[1][0] = &calcOverlapPortable<true, true, false>;
+                    fastExpFuncs[1][1] = &calcOverlapPortable<true, true, true>;
+                    fastExpBatchFuncs[0] = &calcOverlapsPortable<false, true>;
+                    fastExpBatchFuncs[1] = &calcOverlapsPortable<true, true>;
+                    fastExpBatchGradFuncs[0] = &calcOverlapGradientsPortable<false, true>;
+                    fastExpBatchGradFuncs[1] = &calcOverlapGradientsPortable<true, true>;
+                    name               = "Portable";
+            }
+        }
+
+        OverlapFunction getFunction(bool prox_check, bool fast_exp, bool grad) const
+        {
+            if (fast_exp)
+                return fastExpFuncs[prox_check][grad];
+
+            // the exact exponential function is only available as scalar code
+
+            if (prox_check)
+                return (grad ? &calcOverlapPortable<true, false, true> : &calcOverlapPortable<true, false, false>);
+
+            return (grad ? &calcOverlapPortable<false, false, true> : &calcOverlapPortable<false, false, false>);
+        }
+
+        BatchOverlapFunction getBatchFunction(bool prox_check, bool fast_exp) const
+        {
+            if (fast_exp)
+                return fastExpBatchFuncs[prox_check];
+
+            return (prox_check ? &calcOverlapsPortable<true, false> : &calcOverlapsPortable<false, false>);
+        }
+
+        BatchGradientFunction getBatchGradientFunction(bool prox_check, bool fast_exp) const
+        {
+            if (fast_exp)
+                return fastExpBatchGradFuncs[prox_check];
+
+            return (prox_check ? &calcOverlapGradientsPortable<true, false> : &calcOverlapGradientsPortable<false, false>);
+        }
+
+        OverlapFunction       fastExpFuncs[2][2];
+        BatchOverlapFunction  fastExpBatchFuncs[2];
+        BatchGradientFunction fastExpBatchGradFuncs[2];
+        const char*           name;
+    };
+
+    const OverlapKernelImpl& getImpl()
+    {
+        static const OverlapKernelImpl impl(getBestSupportedImpl());
+
+        return impl;
+    }
+
+    const OverlapKernelImpl& getImpl(Shape::PackedElementOverlapImpl impl)
+    {
+        static const OverlapKernelImpl impls[] = {
+            OverlapKernelImpl(Shape::PORTABLE_OVERLAP_IMPL),
+            OverlapKernelImpl(Shape::AVX2_OVERLAP_IMPL),
+            OverlapKernelImpl(Shape::AVX512_OVERLAP_IMPL)
+        };
+
+        if (!isImplSupported(impl))
+            return impls[Shape::PORTABLE_OVERLAP_IMPL];
+
+        return impls[impl];
+    }
+
+    void calcOverlaps(const OverlapKernelImpl& impl, const std::vector<double>& data, const double* ctrs, std::size_t num_ctrs,
+                      double radius, double delta, double weight, std::size_t color, bool prox_check, double rad_scaling,
+                      bool fast_exp, double* overlaps)
+    {
+        if (data.size() == 1)
+            return;
+
+        BatchOverlapFunction func = impl.getBatchFunction(prox_check, fast_exp);
+        std::size_t blk_size = data.size() / NUM_BLOCKS;
+
+        for (std::size_t i = 0; i < num_ctrs; i += MAX_BATCH_SIZE)
+            func(data.data(), blk_size, ctrs + i * 3, std::min(num_ctrs - i, MAX_BATCH_SIZE), radius, delta, weight, color, rad_scaling,
+                 overlaps + i);
+    }
+
+    void calcOverlapGradients(const OverlapKernelImpl& impl, const std::vector<double>& data, const double* ctrs, std::size_t num_ctrs,
+                              double radius, double delta, double weight, std::size_t color, bool prox_check, double rad_scaling,
+                              bool fast_exp, double* overlaps, double* grads)
+    {
+        if (data.size() == 1) {
+            std::fill(grads, grads + num_ctrs * 3, 0.0);
+            return;
+        }
+
+        BatchGradientFunction func = impl.getBatchGradientFunction(prox_check, fast_exp);
+        std::size_t blk_size = data.size() / NUM_BLOCKS;
+
+        for (std::size_t i = 0; i < num_ctrs; i += MAX_BATCH_SIZE)
+            func(data.data(), blk_size, ctrs + i * 3, std::min(num_ctrs - i, MAX_BATCH_SIZE), radius, delta, weight, color, rad_scaling,
+                 overlaps + i, grads + i * 3);
+    }
+}
+
+
+void Shape::initPackedElementData(std::vector<double>& data, std::size_t num_elem)
+{
+    std::size_t blk_size = (num_elem + BLOCK_SIZE_MULTIPLE - 1) / BLOCK_SIZE_MULTIPLE * BLOCK_SIZE_MULTIPLE;
+
+    data.assign(blk_size * NUM_BLOCKS + 1, 0.0);
+
+    std::fill(data.begin() + DELTA_BLOCK * blk_size, data.begin() + (DELTA_BLOCK + 1) * blk_size, 1.0);
+    std::fill(data.begin() + COLOR_BLOCK * blk_size, data.end() - 1, NO_MATCH_COLOR);
+
+    data.back() = UNSET_COMMON_DELTA;
+}
+
+void Shape::setPackedElement(std::vector<double>& data, std::size_t idx, const Math::Vector3D& ctr, double radius,
+                             double delta, double weight, std::size_t color)
+{
+    std::size_t blk_size = data.size() / NUM_BLOCKS;
+    double* elem_data = &data[idx];
+    double& common_delta = data.back();
+
+    elem_data[CTR_X_BLOCK * blk_size] = ctr[0];
+    elem_data[CTR_Y_BLOCK * blk_size] = ctr[1];
+    elem_data[CTR_Z_BLOCK * blk_size] = ctr[2];
+    elem_data[RADIUS_BLOCK * blk_size] = radius;
+    elem_data[DELTA_BLOCK * blk_size] = delta;
+    elem_data[WEIGHT_BLOCK * blk_size] = weight;
+    elem_data[COLOR_BLOCK * blk_size] = color;
+
+    if (common_delta == UNSET_COMMON_DELTA)
+        common_delta = delta;
+
+    else if (common_delta != delta)
+        common_delta = NO_COMMON_DELTA;
+}
+
+double Shape::calcPackedElementOverlap(const std::vector<double>& data, const double* ctr, double radius, double delta,
+                                       double weight, std::size_t color, bool prox_check, double rad_scaling, bool fast_exp)
+{
+    if (data.size() == 1)
+        return 0.0;
+
+    return getImpl().getFunction(prox_check, fast_exp, false)(data.data(), data.size() / NUM_BLOCKS, ctr, radius, delta,
+                                                               weight, color, rad_scaling, 0);
+}
+
+double Shape::calcPackedElementOverlapGradient(const std::vector<double>& data, const double* ctr, double radius, double delta,
+                                               double weight, std::size_t color, bool prox_check, double rad_scaling, bool fast_exp,
+                                               double* grad)
+{
+    if (data.size() == 1) {
+        grad[0] = 0.0;
+        grad[1] = 0.0;
+        grad[2] = 0.0;
+        return 0.0;
+    }
+
+    return getImpl().getFunction(prox_check, fast_exp, true)(data.data(), data.size() / NUM_BLOCKS, ctr, radius, delta,
+                                                              weight, color, rad_scaling, grad);
+}
+
+void Shape::calcPackedElementOverlaps(const std::vector<double>& data, const double* ctrs, std::size_t num_ctrs, double radius,
+                                      double delta, double weight, std::size_t color, bool prox_check, double rad_scaling,
+                                      bool fast_exp, double* overlaps)
+{
+    calcOverlaps(getImpl(), data, ctrs, num_ctrs, radius, delta, weight, color, prox_check, rad_scaling, fast_exp, overlaps);
+}
+
+void Shape::calcPackedElementOverlaps(PackedElementOverlapImpl impl, const std::vector<double>& data, const double* ctrs,
+                                      std::size_t num_ctrs, double radius, double delta, double weight, std::size_t color,
+                                      bool prox_check, double rad_scaling, bool fast_exp, double* overlaps)
+{
+    calcOverlaps(getImpl(impl), data, ctrs, num_ctrs, radius, delta, weight, color, prox_check, rad_scaling, fast_exp, overlaps);
+}
+
+void Shape::calcPackedElementOverlapGradients(const std::vector<double>& data, const double* ctrs, std::size_t num_ctrs, double radius,
+                                              double delta, double weight, std::size_t color, bool prox_check, double rad_scaling,
+                                              bool fast_exp, double* overlaps, double* grads)
+{
+    calcOverlapGradients(getImpl(), data, ctrs, num_ctrs, radius, delta, weight, color, prox_check, rad_scaling, fast_exp, overlaps, grads);
+}
+
+void Shape::calcPackedElementOverlapGradients(PackedElementOverlapImpl impl, const std::vector<double>& data, const double* ctrs,
+                                              std::size_t num_ctrs, double radius, double delta, double weight, std::size_t color,
+                                              bool prox_check, double rad_scaling, bool fast_exp, double* overlaps, double* grads)
+{
+    calcOverlapGradients(getImpl(impl), data, ctrs, num_ctrs, radius, delta, weight, color, prox_check, rad_scaling, fast_exp,
+                         overlaps, grads);
+}
+
+bool Shape::isPackedElementOverlapImplSupported(PackedElementOverlapImpl impl)
+{
+    return isImplSupported(impl);
+}
+
+const char* Shape::getPackedElementOverlapImplName()
+{
+    return getImpl().name;
+}
+
+#ifndef _MSC_VER
+# pragma GCC diagnostic pop
+#endif // !_MSC_VER
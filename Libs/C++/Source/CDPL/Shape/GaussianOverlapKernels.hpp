@@ -0,0 +1,123 @@
+/* 
+ * GaussianOverlapKernels.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Overlap kernels operating on Gaussian shape elements stored in a packed structure-of-arrays layout.
+ */
+
+#ifndef CDPL_SHAPE_GAUSSIANOVERLAPKERNELS_HPP
+#define CDPL_SHAPE_GAUSSIANOVERLAPKERNELS_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "CDPL/Math/Vector.hpp"
+
+
+namespace CDPL
+{
+
+    namespace Shape
+    {
+
+        /*
+         * The packed element data consist of seven consecutive blocks (center x, y, z, radius, delta,
+         * weight factor and color) whose lengths are rounded up to a multiple of the widest supported SIMD
+         * register. Padding entries have a zero weight factor and a color that never matches. A trailing value
+         * records the delta shared by all elements (if any) which allows the kernels to hoist the calculation of
+         * the pair-dependent volume factors out of the inner loop.
+         */
+
+        void initPackedElementData(std::vector<double>& data, std::size_t num_elem);
+
+        void setPackedElement(std::vector<double>& data, std::size_t idx, const Math::Vector3D& ctr, double radius,
+                              double delta, double weight, std::size_t color);
+
+        /*
+         * Sums up the overlaps of the first-order Gaussian given by ctr, radius, delta, weight and color with
+         * all packed elements of the same color. If prox_check is true, element pairs whose center distance exceeds
+         * the sum of the radii scaled by rad_scaling are skipped. The fast exponential function implementation
+         * (and, depending on the capabilities of the executing CPU, AVX-512 or AVX2 code) is used if fast_exp is true.
+         */
+        double calcPackedElementOverlap(const std::vector<double>& data, const double* ctr, double radius, double delta,
+                                        double weight, std::size_t color, bool prox_check, double rad_scaling, bool fast_exp);
+
+        /*
+         * Like calcPackedElementOverlap() but additionally stores the gradient of the overlap with respect
+         * to ctr in grad[0..3).
+         */
+        double calcPackedElementOverlapGradient(const std::vector<double>& data, const double* ctr, double radius, double delta,
+                                                double weight, std::size_t color, bool prox_check, double rad_scaling, bool fast_exp,
+                                                double* grad);
+
+        /*
+         * Batched version of calcPackedElementOverlap() for num_ctrs alternative positions of the same Gaussian
+         * (ctrs[0..3 * num_ctrs)). The overlap obtained for position i gets added to overlaps[i]. The packed element
+         * data are loaded only once for (a group of) all positions, and the results are identical to those of
+         * separate calcPackedElementOverlap() calls.
+         */
+        void calcPackedElementOverlaps(const std::vector<double>& data, const double* ctrs, std::size_t num_ctrs, double radius,
+                                       double delta, double weight, std::size_t color, bool prox_check, double rad_scaling,
+                                       bool fast_exp, double* overlaps);
+
+        /*
+         * Batched version of calcPackedElementOverlapGradient(). The overlap obtained for position i gets added to
+         * overlaps[i] and the gradient is stored in grads[3 * i..3 * i + 3). As for calcPackedElementOverlaps(), the
+         * results are identical to those of separate calcPackedElementOverlapGradient() calls.
+         */
+        void calcPackedElementOverlapGradients(const std::vector<double>& data, const double* ctrs, std::size_t num_ctrs, double radius,
+                                               double delta, double weight, std::size_t color, bool prox_check, double rad_scaling,
+                                               bool fast_exp, double* overlaps, double* grads);
+
+        const char* getPackedElementOverlapImplName();
+
+        /*
+         * Identifiers of the available kernel implementations. The functions above always use the fastest
+         * implementation supported by the executing CPU - explicit selection is meant for testing purposes.
+         */
+        enum PackedElementOverlapImpl
+        {
+
+            PORTABLE_OVERLAP_IMPL,
+            AVX2_OVERLAP_IMPL,
+            AVX512_OVERLAP_IMPL
+        };
+
+        bool isPackedElementOverlapImplSupported(PackedElementOverlapImpl impl);
+
+        /*
+         * Like calcPackedElementOverlaps() and calcPackedElementOverlapGradients() but use the specified kernel
+         * implementation (the portable one if the executing CPU does not support it).
+         */
+        void calcPackedElementOverlaps(PackedElementOverlapImpl impl, const std::vector<double>& data, const double* ctrs,
+                                       std::size_t num_ctrs, double radius, double delta, double weight, std::size_t color,
+                                       bool prox_check, double rad_scaling, bool fast_exp, double* overlaps);
+
+        void calcPackedElementOverlapGradients(PackedElementOverlapImpl impl, const std::vector<double>& data, const double* ctrs,
+                                               std::size_t num_ctrs, double radius, double delta, double weight, std::size_t color,
+                                               bool prox_check, double rad_scaling, bool fast_exp, double* overlaps, double* grads);
+    } // namespace Shape
+} // namespace CDPL
+
+#endif // CDPL_SHAPE_GAUSSIANOVERLAPKERNELS_HPP
@@ -30,6 +30,7 @@
 
 #include "GaussianProductList.hpp"
 #include "GaussianProduct.hpp"
+#include "GaussianOverlapKernels.hpp"
 #include "Utilities.hpp"
 
 
@@ -134,7 +135,7 @@ void Shape::GaussianProductList::setup(const GaussianShape& shape)
     prodCache.putAll();
     
     volume = 0.0;
-    
+
     for (std::size_t i = 0; i < numElements; i++) {
         GaussianProduct* prod = prodCache.get();
 
@@ -146,6 +147,8 @@ void Shape::GaussianProductList::setup(const GaussianShape& shape)
         products.push_back(prod);
     }
 
+    updatePackedElementData();
+
     if (maxOrder == 1)
         return;
 
@@ -171,6 +174,17 @@ double Shape::GaussianProductList::getVolume() const
     return volume;
 }
 
+void Shape::GaussianProductList::updatePackedElementData()
+{
+    initPackedElementData(packedElemData, numElements);
+
+    for (std::size_t i = 0; i < numElements; i++) {
+        const GaussianProduct* prod = products[i];
+
+        setPackedElement(packedElemData, i, prod->getCenter(), prod->getRadius(), prod->getDelta(), prod->getWeightFactor(), prod->getColor());
+    }
+}
+
 void Shape::GaussianProductList::generateProducts(std::size_t elem_idx)
 {
     currProduct->addFactor(products[elem_idx]);
@@ -226,6 +240,7 @@ void Shape::GaussianProductList::copy(const GaussianProductList& prod_list)
     distCutoff = prod_list.distCutoff;
     volume = prod_list.volume;
     numElements = prod_list.numElements;
+    packedElemData = prod_list.packedElemData;
     
     products.clear();
     products.reserve(prod_list.products.size());
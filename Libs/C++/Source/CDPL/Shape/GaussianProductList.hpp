@@ -85,6 +85,10 @@ namespace CDPL
 
             double getVolume() const;
 
+            const std::vector<double>& getPackedElementData() const;
+
+            void updatePackedElementData();
+
           private:
             void generateProducts(std::size_t elem_idx);
 
@@ -104,6 +108,7 @@ namespace CDPL
             double               distCutoff;
             GaussianProduct*     currProduct;
             ProductList          products;
+            std::vector<double>  packedElemData;
             double               volume;
             std::size_t          numElements;
         };
@@ -123,6 +128,11 @@ namespace CDPL
     {
         return products.end();
     }
+
+    inline const std::vector<double>& Shape::GaussianProductList::getPackedElementData() const
+    {
+        return packedElemData;
+    }
 } // namespace CDPL
 
 #endif // CDPL_SHAPE_GAUSSIANPRODUCTLIST_HPP
@@ -0,0 +1,221 @@
+/* 
+ * GaussianShapeDatabase.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include <cstring>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include "CDPL/Shape/GaussianShapeDatabase.hpp"
+#include "CDPL/Shape/GaussianShape.hpp"
+#include "CDPL/Shape/GaussianShapeSet.hpp"
+#include "CDPL/Util/FileFunctions.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+#include "GaussianShapeDatabaseFormat.hpp"
+
+
+using namespace CDPL;
+
+namespace Format = Shape::GaussianShapeDatabaseFormat;
+
+
+Shape::GaussianShapeDatabase::GaussianShapeDatabase():
+    elementData(0), shapeOffsets(0), recordTable(0), nameData(0), numRecords(0), numShapes(0),
+    colorFtrType(ScreeningSettings::NO_FEATURES), allCarbon(false)
+{}
+
+Shape::GaussianShapeDatabase::~GaussianShapeDatabase()
+{}
+
+bool Shape::GaussianShapeDatabase::open(const std::string& path, std::uint64_t src_stamp)
+{
+    close();
+
+    if (!Util::fileExists(path))
+        return false;
+
+    try {
+        MappedFilePtr file(new MappedFile(path));
+
+        if (!file->is_open() || file->size() < sizeof(Format::Header))
+            return false;
+
+        Format::Header header;
+
+        std::memcpy(&header, file->data(), sizeof(Format::Header));
+
+        if (std::memcmp(header.fileID, Format::FILE_ID, sizeof(Format::FILE_ID)) != 0 || header.formatVersion != Format::FORMAT_VERSION ||
+            header.byteOrderMark != Format::BYTE_ORDER_MARK || header.sourceStamp != src_stamp)
+            return false;
+
+        std::size_t elem_data_size  = header.numElements * sizeof(Format::Element);
+        std::size_t shape_tab_size  = (header.numShapes + 1) * sizeof(std::uint64_t);
+        std::size_t rec_tab_size    = header.numRecords * Format::RECORD_SIZE * sizeof(std::uint64_t);
+
+        if (file->size() != sizeof(Format::Header) + elem_data_size + shape_tab_size + rec_tab_size + header.nameDataSize)
+            return false;
+
+        const char* data = file->data() + sizeof(Format::Header);
+        const std::uint64_t* shape_offs = reinterpret_cast<const std::uint64_t*>(data + elem_data_size);
+        const std::uint64_t* rec_tab = reinterpret_cast<const std::uint64_t*>(data + elem_data_size + shape_tab_size);
+
+        // sanity checks that make sure that later accesses stay within the mapped file
+        
+        if (shape_offs[header.numShapes] != header.numElements)
+            return false;
+
+        for (std::size_t i = 0; i < header.numShapes; i++)
+            if (shape_offs[i] > shape_offs[i + 1])
+                return false;
+
+        for (std::size_t i = 0; i < header.numRecords; i++) {
+            const std::uint64_t* rec = rec_tab + i * Format::RECORD_SIZE;
+            std::uint64_t next_first_shape = (i + 1 < header.numRecords ? rec[Format::RECORD_SIZE + Format::FIRST_SHAPE] : header.numShapes);
+
+            if (rec[Format::FIRST_SHAPE] > next_first_shape || rec[Format::NAME_OFFSET] + rec[Format::NAME_LENGTH] > header.nameDataSize)
+                return false;
+        }
+
+        mappedFile.swap(file);
+
+        elementData  = data;
+        shapeOffsets = shape_offs;
+        recordTable  = rec_tab;
+        nameData     = data + elem_data_size + shape_tab_size + rec_tab_size;
+        numRecords   = header.numRecords;
+        numShapes    = header.numShapes;
+        colorFtrType = ScreeningSettings::ColorFeatureType(header.colorFeatureType);
+        allCarbon    = header.allCarbon;
+
+        return true;
+
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+void Shape::GaussianShapeDatabase::close()
+{
+    mappedFile.reset();
+
+    elementData  = 0;
+    shapeOffsets = 0;
+    recordTable  = 0;
+    nameData     = 0;
+    numRecords   = 0;
+    numShapes    = 0;
+    colorFtrType = ScreeningSettings::NO_FEATURES;
+    allCarbon    = false;
+}
+
+bool Shape::GaussianShapeDatabase::isOpen() const
+{
+    return mappedFile.get();
+}
+
+Shape::ScreeningSettings::ColorFeatureType Shape::GaussianShapeDatabase::getColorFeatureType() const
+{
+    return colorFtrType;
+}
+
+bool Shape::GaussianShapeDatabase::allCarbonMode() const
+{
+    return allCarbon;
+}
+
+std::size_t Shape::GaussianShapeDatabase::getNumRecords() const
+{
+    return numRecords;
+}
+
+std::size_t Shape::GaussianShapeDatabase::getNumShapes() const
+{
+    return numShapes;
+}
+
+std::size_t Shape::GaussianShapeDatabase::getRecordIndex(std::size_t idx) const
+{
+    if (idx >= numRecords)
+        throw Base::IndexError("GaussianShapeDatabase: record index out of bounds");
+
+    return recordTable[idx * Format::RECORD_SIZE + Format::RECORD_INDEX];
+}
+
+std::string Shape::GaussianShapeDatabase::getName(std::size_t idx) const
+{
+    if (idx >= numRecords)
+        throw Base::IndexError("GaussianShapeDatabase: record index out of bounds");
+
+    const std::uint64_t* rec = recordTable + idx * Format::RECORD_SIZE;
+
+    return std::string(nameData + rec[Format::NAME_OFFSET], rec[Format::NAME_LENGTH]);
+}
+
+std::size_t Shape::GaussianShapeDatabase::getNumShapes(std::size_t idx) const
+{
+    if (idx >= numRecords)
+        throw Base::IndexError("GaussianShapeDatabase: record index out of bounds");
+
+    const std::uint64_t* rec = recordTable + idx * Format::RECORD_SIZE;
+
+    return ((idx + 1 < numRecords ? rec[Format::RECORD_SIZE + Format::FIRST_SHAPE] : numShapes) - rec[Format::FIRST_SHAPE]);
+}
+
+void Shape::GaussianShapeDatabase::getShape(std::size_t idx, std::size_t shape_idx, GaussianShape& shape) const
+{
+    if (shape_idx >= getNumShapes(idx))
+        throw Base::IndexError("GaussianShapeDatabase: shape index out of bounds");
+
+    shape_idx += recordTable[idx * Format::RECORD_SIZE + Format::FIRST_SHAPE];
+
+    const Format::Element* elem = reinterpret_cast<const Format::Element*>(elementData) + shapeOffsets[shape_idx];
+    const Format::Element* elem_end = reinterpret_cast<const Format::Element*>(elementData) + shapeOffsets[shape_idx + 1];
+    Math::Vector3D pos;
+
+    shape.clear();
+
+    for ( ; elem != elem_end; ++elem) {
+        pos[0] = elem->position[0];
+        pos[1] = elem->position[1];
+        pos[2] = elem->position[2];
+
+        shape.addElement(pos, elem->radius, elem->color, elem->hardness);
+    }
+}
+
+void Shape::GaussianShapeDatabase::getShapes(std::size_t idx, GaussianShapeSet& shapes) const
+{
+    std::size_t num_shapes = getNumShapes(idx);
+
+    shapes.clear();
+
+    for (std::size_t i = 0; i < num_shapes; i++) {
+        GaussianShape::SharedPointer shape_ptr(new GaussianShape());
+
+        getShape(idx, i, *shape_ptr);
+        shapes.addElement(shape_ptr);
+    }
+}
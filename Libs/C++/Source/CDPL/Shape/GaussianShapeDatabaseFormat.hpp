@@ -0,0 +1,89 @@
+/* 
+ * GaussianShapeDatabaseFormat.hpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+/**
+ * \file
+ * \brief Definition of the binary layout of shape database files.
+ */
+
+#ifndef CDPL_SHAPE_GAUSSIANSHAPEDATABASEFORMAT_HPP
+#define CDPL_SHAPE_GAUSSIANSHAPEDATABASEFORMAT_HPP
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace CDPL
+{
+
+    namespace Shape
+    {
+
+        namespace GaussianShapeDatabaseFormat
+        {
+
+            /*
+             * A database file consists of the header, the shape elements of all stored shapes, the shape table
+             * (numShapes + 1 offsets of the first element of each shape), the record table (RECORD_SIZE words per
+             * molecule record) and the concatenated, not null-terminated molecule names. All sections start at
+             * 8-byte aligned file offsets and the numbers are stored in native byte order.
+             */
+
+            const char          FILE_ID[8]      = { 'C', 'D', 'P', 'L', 'G', 'S', 'D', 'B' };
+            const std::uint32_t FORMAT_VERSION  = 1;
+            const std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+            struct Header
+            {
+
+                char          fileID[8];
+                std::uint32_t formatVersion;
+                std::uint32_t byteOrderMark;
+                std::uint64_t sourceStamp;
+                std::uint32_t colorFeatureType;
+                std::uint32_t allCarbon;
+                std::uint64_t numRecords;
+                std::uint64_t numShapes;
+                std::uint64_t numElements;
+                std::uint64_t nameDataSize;
+            };
+
+            struct Element
+            {
+
+                double        position[3];
+                double        radius;
+                double        hardness;
+                std::uint64_t color;
+            };
+
+            const std::size_t RECORD_INDEX = 0;
+            const std::size_t FIRST_SHAPE  = 1;
+            const std::size_t NAME_OFFSET  = 2;
+            const std::size_t NAME_LENGTH  = 3;
+            const std::size_t RECORD_SIZE  = 4;
+        } // namespace GaussianShapeDatabaseFormat
+    } // namespace Shape
+} // namespace CDPL
+
+#endif // CDPL_SHAPE_GAUSSIANSHAPEDATABASEFORMAT_HPP
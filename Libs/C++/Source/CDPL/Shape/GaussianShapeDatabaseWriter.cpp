@@ -0,0 +1,207 @@
+/* 
+ * GaussianShapeDatabaseWriter.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "StaticInit.hpp"
+
+#include <cstring>
+
+#include "CDPL/Shape/GaussianShapeDatabaseWriter.hpp"
+#include "CDPL/Shape/GaussianShapeSet.hpp"
+#include "CDPL/Util/FileFunctions.hpp"
+#include "CDPL/Util/FileRemover.hpp"
+
+#include "GaussianShapeDatabaseFormat.hpp"
+
+
+using namespace CDPL;
+
+namespace Format = Shape::GaussianShapeDatabaseFormat;
+
+
+Shape::GaussianShapeDatabaseWriter::GaussianShapeDatabaseWriter():
+    sourceStamp(0), colorFtrType(ScreeningSettings::NO_FEATURES), allCarbon(false), numElements(0)
+{}
+
+Shape::GaussianShapeDatabaseWriter::~GaussianShapeDatabaseWriter()
+{
+    discard();
+}
+
+bool Shape::GaussianShapeDatabaseWriter::open(const std::string& path, std::uint64_t src_stamp, ScreeningSettings::ColorFeatureType color_ftr_type, 
+                                              bool all_carbon)
+{
+    discard();
+
+    try {
+        std::string::size_type sep_pos = path.find_last_of("/\\");
+
+        tmpFileRemover.reset(new Util::FileRemover(Util::genCheckedTempFilePath(sep_pos == std::string::npos ? std::string(".") : path.substr(0, sep_pos + 1),
+                                                                                "%%%%-%%%%-%%%%-%%%%.tmp")));
+        outStream.open(tmpFileRemover->getPath().c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+
+        if (!outStream) {
+            discard();
+            return false;
+        }
+
+        // the header gets written on close() when all counts are known
+
+        Format::Header header;
+
+        std::memset(&header, 0, sizeof(Format::Header));
+
+        outStream.write(reinterpret_cast<const char*>(&header), sizeof(Format::Header));
+
+        if (!outStream) {
+            discard();
+            return false;
+        }
+
+        this->path   = path;
+        sourceStamp  = src_stamp;
+        colorFtrType = color_ftr_type;
+        allCarbon    = all_carbon;
+
+        return true;
+
+    } catch (const std::exception&) {
+        discard();
+        return false;
+    }
+}
+
+bool Shape::GaussianShapeDatabaseWriter::addRecord(std::size_t rec_idx, const std::string& name, const GaussianShapeSet& shapes)
+{
+    if (!isOpen())
+        return false;
+
+    Format::Element elem;
+
+    recordTable.push_back(rec_idx);
+    recordTable.push_back(shapeOffsets.size());
+    recordTable.push_back(nameData.size());
+    recordTable.push_back(name.size());
+
+    nameData.append(name);
+
+    for (GaussianShapeSet::ConstElementIterator it = shapes.getElementsBegin(), end = shapes.getElementsEnd(); it != end; ++it) {
+        const GaussianShape& shape = *it;
+
+        shapeOffsets.push_back(numElements);
+
+        for (GaussianShape::ConstElementIterator e_it = shape.getElementsBegin(), e_end = shape.getElementsEnd(); e_it != e_end; ++e_it) {
+            const GaussianShape::Element& shape_elem = *e_it;
+            const Math::Vector3D& pos = shape_elem.getPosition();
+
+            elem.position[0] = pos[0];
+            elem.position[1] = pos[1];
+            elem.position[2] = pos[2];
+            elem.radius      = shape_elem.getRadius();
+            elem.hardness    = shape_elem.getHardness();
+            elem.color       = shape_elem.getColor();
+
+            outStream.write(reinterpret_cast<const char*>(&elem), sizeof(Format::Element));
+        }
+
+        numElements += shape.getNumElements();
+    }
+
+    if (!outStream) {
+        discard();
+        return false;
+    }
+
+    return true;
+}
+
+std::size_t Shape::GaussianShapeDatabaseWriter::getNumRecords() const
+{
+    return (recordTable.size() / Format::RECORD_SIZE);
+}
+
+bool Shape::GaussianShapeDatabaseWriter::isOpen() const
+{
+    return tmpFileRemover.get();
+}
+
+bool Shape::GaussianShapeDatabaseWriter::close()
+{
+    if (!isOpen())
+        return false;
+
+    try {
+        Format::Header header;
+
+        std::memcpy(header.fileID, Format::FILE_ID, sizeof(Format::FILE_ID));
+
+        header.formatVersion    = Format::FORMAT_VERSION;
+        header.byteOrderMark    = Format::BYTE_ORDER_MARK;
+        header.sourceStamp      = sourceStamp;
+        header.colorFeatureType = colorFtrType;
+        header.allCarbon        = allCarbon;
+        header.numRecords       = getNumRecords();
+        header.numShapes        = shapeOffsets.size();
+        header.numElements      = numElements;
+        header.nameDataSize     = nameData.size();
+
+        shapeOffsets.push_back(numElements);
+
+        outStream.write(reinterpret_cast<const char*>(shapeOffsets.data()), std::streamsize(shapeOffsets.size() * sizeof(std::uint64_t)));
+        outStream.write(reinterpret_cast<const char*>(recordTable.data()), std::streamsize(recordTable.size() * sizeof(std::uint64_t)));
+        outStream.write(nameData.data(), std::streamsize(nameData.size()));
+        outStream.seekp(0);
+        outStream.write(reinterpret_cast<const char*>(&header), sizeof(Format::Header));
+        outStream.close();
+
+        if (!outStream || !Util::renameFile(tmpFileRemover->getPath(), path)) {
+            discard();
+            return false;
+        }
+
+        tmpFileRemover->release();
+        discard();
+
+        return true;
+
+    } catch (const std::exception&) {
+        discard();
+        return false;
+    }
+}
+
+void Shape::GaussianShapeDatabaseWriter::discard()
+{
+    if (outStream.is_open())
+        outStream.close();
+
+    outStream.clear();
+    tmpFileRemover.reset();
+
+    path.clear();
+    recordTable.clear();
+    shapeOffsets.clear();
+    nameData.clear();
+
+    numElements = 0;
+}
@@ -166,6 +166,8 @@ void Shape::GaussianShapeFunction::reset()
         else
             prod->init();
     }
+
+    prodList->updatePackedElementData();
 }
 
 void Shape::GaussianShapeFunction::transform(const Math::Matrix4D& xform) 
@@ -183,6 +185,8 @@ void Shape::GaussianShapeFunction::transform(const Math::Matrix4D& xform)
         else
             prod->init();
     }
+
+    prodList->updatePackedElementData();
 }
 
 const Math::Vector3D& Shape::GaussianShapeFunction::getElementPosition(std::size_t idx) const
@@ -27,6 +27,7 @@
 #include <cmath>
 
 #include "CDPL/Shape/ScreeningProcessor.hpp"
+#include "CDPL/Shape/GaussianShapeDatabase.hpp"
 #include "CDPL/Chem/MolecularGraph.hpp"
 #include "CDPL/Base/Exceptions.hpp"
 
@@ -44,7 +45,7 @@ namespace
 Shape::ScreeningProcessor::ScreeningProcessor():
     colorFtrType(ScreeningSettings::DEFAULT.getColorFeatureType()), 
     allCarbon(ScreeningSettings::DEFAULT.allCarbonMode()),
-    expChgPharmGen()
+    expChgPharmGen(), numPerfAligns(0), numPrunedAligns(0)
 {
     init();
 }
@@ -52,7 +53,7 @@ Shape::ScreeningProcessor::ScreeningProcessor():
 Shape::ScreeningProcessor::ScreeningProcessor(const Chem::MolecularGraph& query):
     colorFtrType(ScreeningSettings::DEFAULT.getColorFeatureType()), 
     allCarbon(ScreeningSettings::DEFAULT.allCarbonMode()),
-    expChgPharmGen()
+    expChgPharmGen(), numPerfAligns(0), numPrunedAligns(0)
 {
     init();
     addQuery(query);
@@ -71,6 +72,16 @@ const Shape::ScreeningProcessor::HitCallbackFunction& Shape::ScreeningProcessor:
     return hitCallback;
 }
 
+void Shape::ScreeningProcessor::setDatabaseHitCallback(const DatabaseHitCallbackFunction& func)
+{
+    dbHitCallback = func;
+}
+
+const Shape::ScreeningProcessor::DatabaseHitCallbackFunction& Shape::ScreeningProcessor::getDatabaseHitCallback() const
+{
+    return dbHitCallback;
+}
+
 const Shape::ScreeningSettings& Shape::ScreeningProcessor::getSettings() const
 {
     return settings;
@@ -124,56 +135,53 @@ bool Shape::ScreeningProcessor::process(const Chem::MolecularGraph& molgraph)
     applyShapeGenSettings(false);
     applyAlignmentSettings();
     
-    const GaussianShapeSet& shapes = shapeGen.generate(molgraph);
-    
-    if (shapes.isEmpty())
-        return false;
+    return processShapes(shapeGen.generate(molgraph),
+                         [&](const AlignmentResult& res) {
+                             if (hitCallback)
+                                 hitCallback(*queryList[res.getReferenceShapeSetIndex()], molgraph, res);
+                         });
+}
 
-    bool have_cutoff = std::isfinite(settings.getScoreCutoff());
+bool Shape::ScreeningProcessor::process(const GaussianShapeDatabase& db, std::size_t idx)
+{
+    if (db.getColorFeatureType() != settings.getColorFeatureType() || db.allCarbonMode() != settings.allCarbonMode())
+        throw Base::ValueError("ScreeningProcessor: shape generation settings of shape database do not match");
 
-    if (settings.singleConformerSearch()) {
-        bool success = false;
-        
-        for (std::size_t i = 0, num_confs = shapes.getSize(); i < num_confs; i++) {
-            const GaussianShape& shape = shapes[i];
+    applyShapeGenSettings(false);
+    applyAlignmentSettings();
 
-            if (!alignment.align(shape))
-                continue;
+    std::size_t num_shapes = db.getNumShapes(idx);
 
-            if (hitCallback) {
-                for (FastGaussianShapeAlignment::ResultIterator it = alignment.getResultsBegin(), end = alignment.getResultsEnd(); it != end; ++it) {
-                    AlignmentResult& res = *it;
+    for (std::size_t i = dbShapeCache.size(); i < num_shapes; i++)
+        dbShapeCache.push_back(GaussianShape::SharedPointer(new GaussianShape()));
 
-                    if (have_cutoff && res.getScore() < settings.getScoreCutoff())
-                        continue;
+    dbShapes.clear();
 
-                    res.setAlignedShapeIndex(i);
-                    
-                    hitCallback(*queryList[res.getReferenceShapeSetIndex()], molgraph, res);
-                }
-            }
-    
-            success = true;
-        }
-        
-        return success;
+    for (std::size_t i = 0; i < num_shapes; i++) {
+        db.getShape(idx, i, *dbShapeCache[i]);
+        dbShapes.addElement(dbShapeCache[i]);
     }
-    
-    if (!alignment.align(shapes)) 
-        return false;
 
-    if (hitCallback) {
-        for (FastGaussianShapeAlignment::ConstResultIterator it = alignment.getResultsBegin(), end = alignment.getResultsEnd(); it != end; ++it) {
-            const AlignmentResult& res = *it;
+    return processShapes(dbShapes,
+                         [&](const AlignmentResult& res) {
+                             if (dbHitCallback)
+                                 dbHitCallback(*queryList[res.getReferenceShapeSetIndex()], idx, res);
+                         });
+}
 
-            if (have_cutoff && res.getScore() < settings.getScoreCutoff())
-                continue;
+const Shape::GaussianShapeSet& Shape::ScreeningProcessor::getDatabaseMoleculeShapes() const
+{
+    return shapeGen.getShapes();
+}
 
-            hitCallback(*queryList[res.getReferenceShapeSetIndex()], molgraph, res);
-        }
-    }
+std::size_t Shape::ScreeningProcessor::getNumPerformedAlignments() const
+{
+    return numPerfAligns;
+}
 
-    return true;
+std::size_t Shape::ScreeningProcessor::getNumPrunedAlignments() const
+{
+    return numPrunedAligns;
 }
 
 void Shape::ScreeningProcessor::init()
@@ -237,6 +245,8 @@ void Shape::ScreeningProcessor::applyAlignmentSettings()
     alignment.setMaxNumOptimizationIterations(settings.getMaxNumOptimizationIterations());
     alignment.setOptimizationStopGradient(settings.getOptimizationStopGradient());
     alignment.setNumRandomStarts(settings.getNumRandomStarts());
+    alignment.pruneAlignments(settings.pruneAlignments());
+    alignment.setPruningScoreCutoff(settings.getScoreCutoff());
 
     if (settings.getAlignmentMode() == ScreeningSettings::NO_ALIGNMENT)
         alignment.performAlignment(false);
@@ -266,3 +276,76 @@ void Shape::ScreeningProcessor::applyAlignmentSettings()
             break;
     }
 }
+
+template <typename HitFunc>
+bool Shape::ScreeningProcessor::processShapes(const GaussianShapeSet& shapes, const HitFunc& hit_func)
+{
+    if (shapes.isEmpty())
+        return false;
+
+    bool have_cutoff = std::isfinite(settings.getScoreCutoff());
+
+    if (settings.singleConformerSearch()) {
+        bool success = false;
+        
+        for (std::size_t i = 0, num_confs = shapes.getSize(); i < num_confs; i++) {
+            const GaussianShape& shape = shapes[i];
+
+            if (!alignShapes(shape)) {
+                if (alignment.getNumPrunedAlignments() > 0) // no hits but not a failure
+                    success = true;
+
+                continue;
+            }
+
+            for (FastGaussianShapeAlignment::ResultIterator it = alignment.getResultsBegin(), end = alignment.getResultsEnd(); it != end; ++it) {
+                AlignmentResult& res = *it;
+
+                if (have_cutoff && res.getScore() < settings.getScoreCutoff())
+                    continue;
+
+                res.setAlignedShapeIndex(i);
+                    
+                hit_func(res);
+            }
+    
+            success = true;
+        }
+        
+        return success;
+    }
+    
+    if (!alignShapes(shapes)) 
+        return (alignment.getNumPrunedAlignments() > 0);
+
+    for (FastGaussianShapeAlignment::ConstResultIterator it = alignment.getResultsBegin(), end = alignment.getResultsEnd(); it != end; ++it) {
+        const AlignmentResult& res = *it;
+
+        if (have_cutoff && res.getScore() < settings.getScoreCutoff())
+            continue;
+
+        hit_func(res);
+    }
+
+    return true;
+}
+
+bool Shape::ScreeningProcessor::alignShapes(const GaussianShape& shape)
+{
+    bool have_results = alignment.align(shape);
+
+    numPerfAligns += alignment.getNumPerformedAlignments();
+    numPrunedAligns += alignment.getNumPrunedAlignments();
+
+    return have_results;
+}
+
+bool Shape::ScreeningProcessor::alignShapes(const GaussianShapeSet& shapes)
+{
+    bool have_results = alignment.align(shapes);
+
+    numPerfAligns += alignment.getNumPerformedAlignments();
+    numPrunedAligns += alignment.getNumPrunedAlignments();
+
+    return have_results;
+}
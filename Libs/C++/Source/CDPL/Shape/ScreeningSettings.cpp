@@ -38,7 +38,7 @@ constexpr double               Shape::ScreeningSettings::NO_CUTOFF;
 Shape::ScreeningSettings::ScreeningSettings():
     scoringFunc(&calcTanimotoComboScore), colorFtrType(PHARMACOPHORE_IMP_CHARGES), screeningMode(BEST_MATCH_PER_QUERY),
     almntMode(SHAPE_CENTROID), numRandomStarts(0), allCarbon(true), singleConfSearch(false), optOverlap(true), 
-    greedyOpt(true), numOptIter(20), optStopGrad(1.0), scoreCutoff(NO_CUTOFF)    
+    greedyOpt(true), numOptIter(20), optStopGrad(1.0), scoreCutoff(NO_CUTOFF), pruneAligns(false)
 {}
 
 void Shape::ScreeningSettings::setScoringFunction(const ScoringFunction& func)
@@ -131,6 +131,16 @@ bool Shape::ScreeningSettings::greedyOptimization() const
     return greedyOpt;
 }
 
+void Shape::ScreeningSettings::pruneAlignments(bool prune)
+{
+    pruneAligns = prune;
+}
+
+bool Shape::ScreeningSettings::pruneAlignments() const
+{
+    return pruneAligns;
+}
+
 void Shape::ScreeningSettings::setMaxNumOptimizationIterations(std::size_t max_iter)
 {
     numOptIter  = max_iter;
@@ -0,0 +1,208 @@
+/*
+ * GaussianOverlapKernelsTest.cpp
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cmath>
+#include <vector>
+
+#include <boost/test/auto_unit_test.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real.hpp>
+#include <boost/random/uniform_int.hpp>
+
+#include "CDPL/Math/Vector.hpp"
+
+#include "../GaussianOverlapKernels.hpp"
+
+
+namespace
+{
+
+    void initElementData(std::vector<double>& data, std::size_t num_elem, bool common_delta, boost::random::mt11213b& rand_engine)
+    {
+        using namespace CDPL;
+
+        boost::random::uniform_real_distribution<double> coord_dist(-8.0, 8.0);
+        boost::random::uniform_real_distribution<double> radius_dist(1.2, 2.0);
+        boost::random::uniform_int_distribution<std::size_t> color_dist(0, 2);
+
+        Shape::initPackedElementData(data, num_elem);
+
+        for (std::size_t i = 0; i < num_elem; i++) {
+            Math::Vector3D ctr;
+            double radius = radius_dist(rand_engine);
+
+            ctr[0] = coord_dist(rand_engine);
+            ctr[1] = coord_dist(rand_engine);
+            ctr[2] = coord_dist(rand_engine);
+
+            Shape::setPackedElement(data, i, ctr, radius, (common_delta ? 1.5 : 2.7 / (radius * radius)), 2.7,
+                                    color_dist(rand_engine));
+        }
+    }
+
+    void checkOverlap(double overlap, double ref_overlap, double rel_tol)
+    {
+        if (ref_overlap < 1.0e-12)
+            BOOST_CHECK_SMALL(overlap, 1.0e-12);
+        else
+            BOOST_CHECK_CLOSE(overlap, ref_overlap, rel_tol * 100.0);
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(GaussianOverlapKernelsTest)
+{
+    using namespace CDPL;
+    using namespace Shape;
+
+    boost::random::mt11213b rand_engine;
+    boost::random::uniform_real_distribution<double> coord_dist(-8.0, 8.0);
+
+    BOOST_CHECK(isPackedElementOverlapImplSupported(PORTABLE_OVERLAP_IMPL));
+
+    if (isPackedElementOverlapImplSupported(AVX512_OVERLAP_IMPL))
+        BOOST_TEST_MESSAGE("testing portable, AVX2 and AVX-512 overlap kernels");
+
+    else if (isPackedElementOverlapImplSupported(AVX2_OVERLAP_IMPL))
+        BOOST_TEST_MESSAGE("AVX-512 not supported by CPU - testing portable and AVX2 overlap kernels");
+
+    else
+        BOOST_TEST_MESSAGE("AVX2 and AVX-512 not supported by CPU - testing portable overlap kernels");
+
+    std::vector<double> data;
+    std::vector<double> ctrs;
+    std::vector<double> exact_overlaps;
+    std::vector<double> ref_overlaps;
+    std::vector<double> overlaps;
+    std::vector<double> ref_grads;
+    std::vector<double> grads;
+
+    // element counts not being a multiple of the SIMD register widths and position counts exceeding the
+    // kernel batch size check the handling of padding entries and batch splitting
+
+    for (std::size_t num_elem : { 1, 7, 16, 45 }) {
+        for (bool common_delta : { true, false }) {
+            initElementData(data, num_elem, common_delta, rand_engine);
+
+            for (std::size_t num_ctrs : { 1, 3, 8, 19 }) {
+                ctrs.resize(num_ctrs * 3);
+
+                for (std::size_t i = 0; i < ctrs.size(); i++)
+                    ctrs[i] = coord_dist(rand_engine);
+
+                for (std::size_t color = 0; color < 3; color++) {
+                    double delta = (common_delta ? 1.5 : 1.1);
+
+                    for (bool prox_check : { false, true }) {
+                        // reference: scalar code using the exact exponential function
+
+                        exact_overlaps.resize(num_ctrs);
+
+                        for (std::size_t i = 0; i < num_ctrs; i++)
+                            exact_overlaps[i] = calcPackedElementOverlap(data, &ctrs[i * 3], 1.6, delta, 2.7, color, prox_check, 1.4, false);
+
+                        for (bool fast_exp : { false, true }) {
+                            // the portable batched kernel evaluates the scalar single position code
+
+                            ref_overlaps.assign(num_ctrs, 0.0);
+
+                            calcPackedElementOverlaps(PORTABLE_OVERLAP_IMPL, data, ctrs.data(), num_ctrs, 1.6, delta, 2.7, color,
+                                                      prox_check, 1.4, fast_exp, ref_overlaps.data());
+
+                            for (std::size_t i = 0; i < num_ctrs; i++) {
+                                if (fast_exp)
+                                    checkOverlap(ref_overlaps[i], exact_overlaps[i], 1.0e-3);
+                                else
+                                    BOOST_CHECK(ref_overlaps[i] == exact_overlaps[i]);
+                            }
+
+                            for (PackedElementOverlapImpl impl : { AVX2_OVERLAP_IMPL, AVX512_OVERLAP_IMPL }) {
+                                overlaps.assign(num_ctrs, 0.0);
+
+                                calcPackedElementOverlaps(impl, data, ctrs.data(), num_ctrs, 1.6, delta, 2.7, color, prox_check,
+                                                          1.4, fast_exp, overlaps.data());
+
+                                // the SIMD kernels sum up the contributions in a different order
+
+                                for (std::size_t i = 0; i < num_ctrs; i++)
+                                    checkOverlap(overlaps[i], ref_overlaps[i], 1.0e-8);
+                            }
+
+                            // the batched kernel of the default implementation has to yield exactly the same results
+                            // as its single position counterpart
+
+                            overlaps.assign(num_ctrs, 0.0);
+
+                            calcPackedElementOverlaps(data, ctrs.data(), num_ctrs, 1.6, delta, 2.7, color, prox_check,
+                                                      1.4, fast_exp, overlaps.data());
+
+                            for (std::size_t i = 0; i < num_ctrs; i++)
+                                BOOST_CHECK(overlaps[i] == calcPackedElementOverlap(data, &ctrs[i * 3], 1.6, delta, 2.7, color,
+                                                                                    prox_check, 1.4, fast_exp));
+
+                            // gradients
+
+                            ref_overlaps.assign(num_ctrs, 0.0);
+                            ref_grads.resize(num_ctrs * 3);
+
+                            calcPackedElementOverlapGradients(PORTABLE_OVERLAP_IMPL, data, ctrs.data(), num_ctrs, 1.6, delta, 2.7, color,
+                                                              prox_check, 1.4, fast_exp, ref_overlaps.data(), ref_grads.data());
+
+                            for (std::size_t i = 0; i < num_ctrs; i++)
+                                checkOverlap(ref_overlaps[i], exact_overlaps[i], fast_exp ? 1.0e-3 : 1.0e-12);
+
+                            for (PackedElementOverlapImpl impl : { AVX2_OVERLAP_IMPL, AVX512_OVERLAP_IMPL }) {
+                                overlaps.assign(num_ctrs, 0.0);
+                                grads.resize(num_ctrs * 3);
+
+                                calcPackedElementOverlapGradients(impl, data, ctrs.data(), num_ctrs, 1.6, delta, 2.7, color, prox_check,
+                                                                  1.4, fast_exp, overlaps.data(), grads.data());
+
+                                for (std::size_t i = 0; i < num_ctrs; i++) {
+                                    checkOverlap(overlaps[i], ref_overlaps[i], 1.0e-8);
+
+                                    for (std::size_t j = 0; j < 3; j++)
+                                        BOOST_CHECK_SMALL(grads[i * 3 + j] - ref_grads[i * 3 + j], 1.0e-8 * (1.0 + ref_overlaps[i]));
+                                }
+                            }
+
+                            overlaps.assign(num_ctrs, 0.0);
+
+                            calcPackedElementOverlapGradients(data, ctrs.data(), num_ctrs, 1.6, delta, 2.7, color, prox_check,
+                                                              1.4, fast_exp, overlaps.data(), grads.data());
+
+                            for (std::size_t i = 0; i < num_ctrs; i++) {
+                                double grad[3];
+
+                                BOOST_CHECK(overlaps[i] == calcPackedElementOverlapGradient(data, &ctrs[i * 3], 1.6, delta, 2.7, color,
+                                                                                            prox_check, 1.4, fast_exp, grad));
+                                BOOST_CHECK(grads[i * 3] == grad[0] && grads[i * 3 + 1] == grad[1] && grads[i * 3 + 2] == grad[2]);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
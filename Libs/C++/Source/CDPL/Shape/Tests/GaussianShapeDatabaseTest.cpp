@@ -0,0 +1,175 @@
+/* 
+ * GaussianShapeDatabaseTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstdlib>
+#include <vector>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/Shape/GaussianShapeDatabase.hpp"
+#include "CDPL/Shape/GaussianShapeDatabaseWriter.hpp"
+#include "CDPL/Shape/GaussianShapeSet.hpp"
+#include "CDPL/Shape/ScreeningProcessor.hpp"
+#include "CDPL/Shape/AlignmentResult.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/SDFMoleculeReader.hpp"
+#include "CDPL/Util/FileDataReader.hpp"
+#include "CDPL/Util/FileFunctions.hpp"
+#include "CDPL/Util/FileRemover.hpp"
+#include "CDPL/Base/Exceptions.hpp"
+
+#include "TestData.hpp"
+
+
+namespace
+{
+
+    bool isEqual(const CDPL::Shape::GaussianShape& shape1, const CDPL::Shape::GaussianShape& shape2)
+    {
+        if (shape1.getNumElements() != shape2.getNumElements())
+            return false;
+
+        for (std::size_t i = 0; i < shape1.getNumElements(); i++) {
+            const CDPL::Shape::GaussianShape::Element& elem1 = shape1.getElement(i);
+            const CDPL::Shape::GaussianShape::Element& elem2 = shape2.getElement(i);
+
+            if (elem1.getPosition()(0) != elem2.getPosition()(0) || elem1.getPosition()(1) != elem2.getPosition()(1) ||
+                elem1.getPosition()(2) != elem2.getPosition()(2) || elem1.getRadius() != elem2.getRadius() ||
+                elem1.getHardness() != elem2.getHardness() || elem1.getColor() != elem2.getColor())
+                return false;
+        }
+
+        return true;
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(GaussianShapeDatabaseTest)
+{
+    using namespace CDPL;
+    using namespace Shape;
+
+    GaussianShapeSet shapes1;
+    GaussianShapeSet shapes2;
+
+    shapes1.addElement(GaussianShape::SharedPointer(new GaussianShape(*TestData::getShapeData("1dwc_MIT", 2.7))));
+    shapes1.addElement(GaussianShape::SharedPointer(new GaussianShape(*TestData::getShapeData("4phv_VAC", 2.6))));
+    shapes2.addElement(GaussianShape::SharedPointer(new GaussianShape(*TestData::getShapeData("1tmn_0ZN", 2.7))));
+
+    shapes1[1].getElement(0).setColor(3);
+
+    Util::FileRemover db_file_rem(Util::genCheckedTempFilePath());
+    GaussianShapeDatabaseWriter writer;
+
+    BOOST_CHECK(writer.open(db_file_rem.getPath(), 42, ScreeningSettings::PHARMACOPHORE_EXP_CHARGES, false));
+    BOOST_CHECK(writer.isOpen());
+    BOOST_CHECK(writer.addRecord(5, "Mol1", shapes1));
+    BOOST_CHECK(writer.addRecord(2, "", GaussianShapeSet()));
+    BOOST_CHECK(writer.addRecord(7, "Mol3", shapes2));
+    BOOST_CHECK(writer.getNumRecords() == 3);
+    BOOST_CHECK(writer.close());
+    BOOST_CHECK(!writer.isOpen());
+
+    GaussianShapeDatabase db;
+
+    BOOST_CHECK(!db.open(db_file_rem.getPath(), 43));
+    BOOST_CHECK(!db.isOpen());
+    BOOST_CHECK(db.open(db_file_rem.getPath(), 42));
+    BOOST_CHECK(db.isOpen());
+
+    BOOST_CHECK(db.getColorFeatureType() == ScreeningSettings::PHARMACOPHORE_EXP_CHARGES);
+    BOOST_CHECK(!db.allCarbonMode());
+    BOOST_CHECK(db.getNumRecords() == 3);
+    BOOST_CHECK(db.getNumShapes() == 3);
+
+    BOOST_CHECK(db.getRecordIndex(0) == 5);
+    BOOST_CHECK(db.getRecordIndex(1) == 2);
+    BOOST_CHECK(db.getRecordIndex(2) == 7);
+    BOOST_CHECK_THROW(db.getRecordIndex(3), Base::IndexError);
+
+    BOOST_CHECK(db.getName(0) == "Mol1");
+    BOOST_CHECK(db.getName(1) == "");
+    BOOST_CHECK(db.getName(2) == "Mol3");
+
+    BOOST_CHECK(db.getNumShapes(0) == 2);
+    BOOST_CHECK(db.getNumShapes(1) == 0);
+    BOOST_CHECK(db.getNumShapes(2) == 1);
+
+    GaussianShapeSet shapes;
+    GaussianShape shape;
+
+    db.getShapes(0, shapes);
+
+    BOOST_CHECK(shapes.getSize() == 2);
+    BOOST_CHECK(isEqual(shapes[0], shapes1[0]));
+    BOOST_CHECK(isEqual(shapes[1], shapes1[1]));
+
+    db.getShapes(1, shapes);
+
+    BOOST_CHECK(shapes.isEmpty());
+
+    db.getShape(2, 0, shape);
+
+    BOOST_CHECK(isEqual(shape, shapes2[0]));
+    BOOST_CHECK_THROW(db.getShape(2, 1, shape), Base::IndexError);
+
+    db.close();
+
+    BOOST_CHECK(!db.isOpen());
+
+// -- Screening of stored shapes --
+
+    Chem::BasicMolecule mol;
+
+    BOOST_CHECK(Util::FileDataReader<Chem::SDFMoleculeReader>(std::getenv("CDPKIT_TEST_DATA_DIR") + std::string("/1dwc_MIT.sdf")).read(mol));
+
+    ScreeningProcessor proc;
+    std::vector<double> mol_scores;
+    std::vector<double> db_scores;
+
+    proc.getSettings().setColorFeatureType(ScreeningSettings::NO_FEATURES);
+    proc.addQuery(mol);
+    proc.setHitCallback([&](const Chem::MolecularGraph&, const Chem::MolecularGraph&, const AlignmentResult& res) {
+                            mol_scores.push_back(res.getScore());
+                        });
+    proc.setDatabaseHitCallback([&](const Chem::MolecularGraph&, std::size_t idx, const AlignmentResult& res) {
+                                    BOOST_CHECK(idx == 0);
+                                    db_scores.push_back(res.getScore());
+                                });
+
+    BOOST_CHECK(proc.process(mol));
+    BOOST_CHECK(mol_scores.size() == 1);
+
+    BOOST_CHECK(writer.open(db_file_rem.getPath(), 0, ScreeningSettings::NO_FEATURES, true));
+    BOOST_CHECK(writer.addRecord(0, "1dwc_MIT", proc.getDatabaseMoleculeShapes()));
+    BOOST_CHECK(writer.close());
+    BOOST_CHECK(db.open(db_file_rem.getPath(), 0));
+
+    BOOST_CHECK(proc.process(db, 0));
+    BOOST_CHECK(db_scores == mol_scores);
+
+    proc.getSettings().allCarbonMode(false);
+
+    BOOST_CHECK_THROW(proc.process(db, 0), Base::ValueError);
+}
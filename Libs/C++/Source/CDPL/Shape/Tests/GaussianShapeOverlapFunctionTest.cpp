@@ -194,3 +194,106 @@ BOOST_AUTO_TEST_CASE(GaussianShapeOverlapFunctionTest)
 
     BOOST_CHECK_CLOSE(calcGradientRMS(overlap_grad), 2.659, 0.01);
 }
+
+BOOST_AUTO_TEST_CASE(FirstOrderGaussianShapeOverlapFunctionTest)
+{
+    using namespace CDPL;
+    using namespace Shape;
+
+    GaussianShape shape1(*TestData::getShapeData("1dwc_MIT", 2.7));
+    GaussianShape shape2(shape1);
+
+    // add a couple of color features on top of some atom centers
+
+    for (std::size_t i = 0, num_elem = shape1.getNumElements(); i < num_elem; i += 5)
+        shape1.addElement(shape1.getElement(i).getPosition(), 1.0, i % 3 + 1, 3.0);
+
+    for (std::size_t i = 0, num_elem = shape2.getNumElements(); i < num_elem; i += 4)
+        shape2.addElement(shape2.getElement(i).getPosition(), 1.0, i % 3 + 1, 3.0);
+
+    GaussianShapeFunction shape_func1, shape_func2;
+
+    shape_func1.setMaxOrder(1);
+    shape_func2.setMaxOrder(1);
+    shape_func1.setShape(shape1);
+    shape_func2.setShape(shape2);
+
+    Math::Vector3DArray trans_shape_elem_coords;
+
+    getCoordinates(shape2, trans_shape_elem_coords);
+
+    for (std::size_t i = 0; i < trans_shape_elem_coords.getSize(); i++) {
+        trans_shape_elem_coords[i][0] += 0.7;
+        trans_shape_elem_coords[i][1] -= 0.4;
+        trans_shape_elem_coords[i][2] += 1.1;
+    }
+
+    ExactGaussianShapeOverlapFunction exact_overlap_func(shape_func1, shape_func2);
+    FastGaussianShapeOverlapFunction packed_overlap_func(shape_func1, shape_func2);
+    FastGaussianShapeOverlapFunction scalar_overlap_func(shape_func1, shape_func2);
+
+    // the default color filter behavior, specified as a custom function, enforces the non-packed code path
+
+    scalar_overlap_func.setColorFilterFunction([](std::size_t color) { return (color != 0); });
+
+    Math::Vector3DArray packed_grad, scalar_grad, exact_grad;
+
+    for (int i = 0; i < 4; i++) {
+        bool prox_opt = (i & 1);
+        bool fast_exp = (i & 2);
+
+        packed_overlap_func.proximityOptimization(prox_opt);
+        packed_overlap_func.fastExpFunction(fast_exp);
+        scalar_overlap_func.proximityOptimization(prox_opt);
+        scalar_overlap_func.fastExpFunction(fast_exp);
+
+        for (int j = 0; j < 2; j++) {
+            bool ref = (j == 0);
+
+            BOOST_CHECK_CLOSE(packed_overlap_func.calcSelfOverlap(ref), scalar_overlap_func.calcSelfOverlap(ref), 1.0e-8);
+            BOOST_CHECK_CLOSE(packed_overlap_func.calcColorSelfOverlap(ref), scalar_overlap_func.calcColorSelfOverlap(ref), 1.0e-8);
+            BOOST_CHECK_CLOSE(packed_overlap_func.calcSelfOverlap(ref), exact_overlap_func.calcSelfOverlap(ref), 0.5);
+            BOOST_CHECK_CLOSE(packed_overlap_func.calcColorSelfOverlap(ref), exact_overlap_func.calcColorSelfOverlap(ref), 0.5);
+        }
+
+        BOOST_CHECK_CLOSE(packed_overlap_func.calcOverlap(), scalar_overlap_func.calcOverlap(), 1.0e-8);
+        BOOST_CHECK_CLOSE(packed_overlap_func.calcColorOverlap(), scalar_overlap_func.calcColorOverlap(), 1.0e-8);
+        BOOST_CHECK_CLOSE(packed_overlap_func.calcOverlap(trans_shape_elem_coords), scalar_overlap_func.calcOverlap(trans_shape_elem_coords), 1.0e-8);
+        BOOST_CHECK_CLOSE(packed_overlap_func.calcColorOverlap(trans_shape_elem_coords), scalar_overlap_func.calcColorOverlap(trans_shape_elem_coords), 1.0e-8);
+        BOOST_CHECK_CLOSE(packed_overlap_func.calcOverlap(trans_shape_elem_coords), exact_overlap_func.calcOverlap(trans_shape_elem_coords), 0.5);
+        BOOST_CHECK_CLOSE(packed_overlap_func.calcColorOverlap(trans_shape_elem_coords), exact_overlap_func.calcColorOverlap(trans_shape_elem_coords), 0.5);
+
+        // the gradient code paths of the scalar implementation ignore the color filter function and
+        // have to be enforced by a custom color match function
+
+        scalar_overlap_func.setColorMatchFunction([](std::size_t col1, std::size_t col2) { return (col1 == col2); });
+
+        BOOST_CHECK_CLOSE(packed_overlap_func.calcOverlapGradient(trans_shape_elem_coords, packed_grad),
+                          scalar_overlap_func.calcOverlapGradient(trans_shape_elem_coords, scalar_grad), 1.0e-8);
+        BOOST_CHECK_CLOSE(packed_overlap_func.calcOverlapGradient(trans_shape_elem_coords, packed_grad),
+                          exact_overlap_func.calcOverlapGradient(trans_shape_elem_coords, exact_grad), 0.5);
+
+        scalar_overlap_func.setColorMatchFunction(GaussianShapeOverlapFunction::ColorMatchFunction());
+
+        BOOST_CHECK_EQUAL(packed_grad.getSize(), scalar_grad.getSize());
+
+        for (std::size_t k = 0; k < packed_grad.getSize(); k++)
+            for (std::size_t l = 0; l < 3; l++) {
+                BOOST_CHECK_SMALL(packed_grad[k][l] - scalar_grad[k][l], 1.0e-9);
+                BOOST_CHECK_SMALL(packed_grad[k][l] - exact_grad[k][l], 0.05);
+            }
+    }
+
+    // the packed element data have to follow transformations of the shape functions
+
+    shape_func2.transform(Math::TranslationMatrix<double>(4, 0.7, -0.4, 1.1));
+
+    BOOST_CHECK_CLOSE(packed_overlap_func.calcOverlap(), scalar_overlap_func.calcOverlap(), 1.0e-8);
+    BOOST_CHECK_CLOSE(packed_overlap_func.calcOverlap(), packed_overlap_func.calcOverlap(trans_shape_elem_coords), 1.0e-8);
+    BOOST_CHECK_CLOSE(packed_overlap_func.calcOverlap(), exact_overlap_func.calcOverlap(), 0.5);
+
+    shape_func2.reset();
+
+    BOOST_CHECK_CLOSE(packed_overlap_func.calcOverlap(), scalar_overlap_func.calcOverlap(), 1.0e-8);
+    BOOST_CHECK_CLOSE(packed_overlap_func.calcOverlap(), exact_overlap_func.calcOverlap(), 0.5);
+}
@@ -0,0 +1,102 @@
+/* 
+ * ScreeningProcessorTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstdlib>
+#include <vector>
+#include <tuple>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/Shape/ScreeningProcessor.hpp"
+#include "CDPL/Shape/AlignmentResult.hpp"
+#include "CDPL/Chem/BasicMolecule.hpp"
+#include "CDPL/Chem/SDFMoleculeReader.hpp"
+#include "CDPL/Pharm/MoleculeFunctions.hpp"
+#include "CDPL/Util/FileDataReader.hpp"
+
+
+namespace
+{
+
+    typedef std::tuple<std::size_t, std::size_t, std::size_t, double> Hit;
+    typedef std::vector<Hit> HitList;
+
+    void screenMolecules(CDPL::Shape::ScreeningProcessor& proc, std::vector<CDPL::Chem::BasicMolecule>& mols, HitList& hits)
+    {
+        using namespace CDPL;
+        
+        for (std::size_t i = 0; i < mols.size(); i++) {
+            proc.setHitCallback([&](const Chem::MolecularGraph&, const Chem::MolecularGraph&, const Shape::AlignmentResult& res) {
+                                    hits.emplace_back(i, res.getReferenceShapeIndex(), res.getAlignedShapeIndex(), res.getScore());
+                                });
+
+            BOOST_CHECK(proc.process(mols[i]));
+        }
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(ScreeningProcessorAlignmentPruningTest)
+{
+    using namespace CDPL;
+    using namespace Shape;
+
+    Util::FileDataReader<Chem::SDFMoleculeReader> db_reader(std::getenv("CDPKIT_TEST_DATA_DIR") + std::string("/CDK2_actives.sdf"));
+    std::vector<Chem::BasicMolecule> db_mols(40);
+
+    for (std::size_t i = 0; i < db_mols.size(); i++) {
+        BOOST_CHECK(db_reader.read(db_mols[i]));
+
+        Pharm::prepareForPharmacophoreGeneration(db_mols[i]);
+    }
+
+    const Chem::BasicMolecule& query = db_mols[0];
+
+    for (int mode = ScreeningSettings::BEST_OVERALL_MATCH; mode <= ScreeningSettings::BEST_MATCH_PER_QUERY_CONF; mode++) {
+        ScreeningProcessor proc;
+        ScreeningProcessor pruning_proc;
+        HitList hits;
+        HitList pruning_hits;
+
+        proc.getSettings().setScreeningMode(ScreeningSettings::ScreeningMode(mode));
+        proc.getSettings().setScoreCutoff(1.8);
+        BOOST_CHECK(!proc.getSettings().pruneAlignments());
+
+        proc.addQuery(query);
+
+        pruning_proc.getSettings() = proc.getSettings();
+        pruning_proc.getSettings().pruneAlignments(true);
+        pruning_proc.addQuery(query);
+
+        screenMolecules(proc, db_mols, hits);
+        screenMolecules(pruning_proc, db_mols, pruning_hits);
+
+        BOOST_CHECK(!hits.empty());
+        BOOST_CHECK(hits == pruning_hits);
+
+        BOOST_CHECK(proc.getNumPrunedAlignments() == 0);
+        BOOST_CHECK(pruning_proc.getNumPrunedAlignments() > 0);
+        BOOST_CHECK(pruning_proc.getNumPerformedAlignments() + pruning_proc.getNumPrunedAlignments() == proc.getNumPerformedAlignments());
+    }
+}
@@ -114,3 +114,37 @@ bool Util::fileExists(const std::string& path)
 {
     return FILESYSTEM_NS::exists(path);
 }
+
+std::uint64_t Util::calcFileStamp(const std::string& path)
+{
+    namespace fsns = FILESYSTEM_NS;
+
+    try {
+        std::uint64_t size  = fsns::file_size(path);
+        std::uint64_t mtime = 
+#ifdef HAVE_CXX17_FILESYSTEM_SUPPORT
+            fsns::last_write_time(path).time_since_epoch().count();
+#else
+            fsns::last_write_time(path);
+#endif
+        std::uint64_t stamp = size;
+
+        stamp ^= mtime + 0x9e3779b97f4a7c15ULL + (stamp << 6) + (stamp >> 2);
+
+        return (stamp == 0 ? 1 : stamp);
+
+    } catch (const std::exception&) {
+        return 0;
+    }
+}
+
+bool Util::renameFile(const std::string& old_path, const std::string& new_path)
+{
+    try {
+        FILESYSTEM_NS::rename(old_path, new_path);
+        return true;
+
+    } catch (const std::exception&) {
+        return false;
+    }
+}
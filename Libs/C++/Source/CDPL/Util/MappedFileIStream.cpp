@@ -0,0 +1,254 @@
+/* 
+ * MappedFileIStream.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#if defined(unix) || defined(__unix__) || defined(__unix) || defined(__APPLE__)
+# include <sys/mman.h>
+# include <unistd.h>
+# define HAVE_POSIX_MADVISE
+#endif
+
+#include <algorithm>
+
+#ifdef HAVE_CXX17_FILESYSTEM_SUPPORT
+# include <filesystem>
+# define FILESYSTEM_NS std::filesystem
+#else
+# include <boost/filesystem.hpp>
+# define FILESYSTEM_NS boost::filesystem
+#endif
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include "CDPL/Util/MappedFileIStream.hpp"
+#include "CDPL/Util/FileFunctions.hpp"
+
+
+using namespace CDPL;
+
+
+constexpr std::size_t Util::MappedFileStreamBuffer::DEF_PREFETCH_SIZE;
+
+
+Util::MappedFileStreamBuffer::MappedFileStreamBuffer():
+    opened(false), prefetchSize(DEF_PREFETCH_SIZE), prefetchEnd(0)
+{}
+
+Util::MappedFileStreamBuffer::~MappedFileStreamBuffer()
+{}
+
+bool Util::MappedFileStreamBuffer::open(const std::string& path)
+{
+    close();
+
+    if (!fileExists(path))
+        return false;
+
+    try {
+        if (FILESYSTEM_NS::file_size(path) == 0) { // empty files cannot be mapped
+            opened = true;
+            return true;
+        }
+
+        MappedFilePtr file(new MappedFile(path));
+
+        if (!file->is_open())
+            return false;
+
+        mappedFile.swap(file);
+
+        char* data = const_cast<char*>(mappedFile->data());
+
+        setg(data, data, data + mappedFile->size());
+
+        opened = true;
+        prefetchAhead();
+
+        return true;
+
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+void Util::MappedFileStreamBuffer::close()
+{
+    setg(0, 0, 0);
+
+    mappedFile.reset();
+
+    opened      = false;
+    prefetchEnd = 0;
+}
+
+bool Util::MappedFileStreamBuffer::isOpen() const
+{
+    return opened;
+}
+
+const char* Util::MappedFileStreamBuffer::getData() const
+{
+    return eback();
+}
+
+std::size_t Util::MappedFileStreamBuffer::getSize() const
+{
+    return (egptr() - eback());
+}
+
+std::size_t Util::MappedFileStreamBuffer::getPosition() const
+{
+    return (gptr() - eback());
+}
+
+const char* Util::MappedFileStreamBuffer::consume(std::size_t num_bytes)
+{
+    if (std::size_t(egptr() - gptr()) < num_bytes)
+        return 0;
+
+    char* data = gptr();
+
+    setg(eback(), data + num_bytes, egptr());
+    prefetchAhead();
+
+    return data;
+}
+
+void Util::MappedFileStreamBuffer::prefetch(std::size_t pos, std::size_t num_bytes) const
+{
+#ifdef HAVE_POSIX_MADVISE
+    std::size_t size = getSize();
+
+    if (pos >= size || num_bytes == 0)
+        return;
+
+    std::size_t page_size = sysconf(_SC_PAGESIZE);
+    std::size_t start = pos - pos % page_size; // start address must be page-aligned
+    std::size_t end = std::min(size, pos + num_bytes);
+
+    posix_madvise(const_cast<char*>(eback()) + start, end - start, POSIX_MADV_WILLNEED);
+#endif
+}
+
+void Util::MappedFileStreamBuffer::setPrefetchSize(std::size_t size)
+{
+    prefetchSize = size;
+}
+
+std::size_t Util::MappedFileStreamBuffer::getPrefetchSize() const
+{
+    return prefetchSize;
+}
+
+Util::MappedFileStreamBuffer::pos_type
+Util::MappedFileStreamBuffer::seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+    switch (dir) {
+
+        case std::ios_base::beg:
+            return seekpos(pos_type(off), which);
+
+        case std::ios_base::cur:
+            return seekpos(pos_type(off_type(getPosition()) + off), which);
+
+        case std::ios_base::end:
+            return seekpos(pos_type(off_type(getSize()) + off), which);
+
+        default:
+            return pos_type(off_type(-1));
+    }
+}
+
+Util::MappedFileStreamBuffer::pos_type
+Util::MappedFileStreamBuffer::seekpos(pos_type pos, std::ios_base::openmode which)
+{
+    if (!(which & std::ios_base::in) || off_type(pos) < 0 || std::size_t(off_type(pos)) > getSize())
+        return pos_type(off_type(-1));
+
+    std::size_t new_pos = off_type(pos);
+
+    if (new_pos + prefetchSize < prefetchEnd || new_pos > prefetchEnd) // jump outside of the prefetched window
+        prefetchEnd = new_pos;
+
+    setg(eback(), eback() + new_pos, egptr());
+    prefetchAhead();
+
+    return pos;
+}
+
+std::streamsize Util::MappedFileStreamBuffer::showmanyc()
+{
+    return (gptr() < egptr() ? std::streamsize(egptr() - gptr()) : std::streamsize(-1));
+}
+
+void Util::MappedFileStreamBuffer::prefetchAhead()
+{
+    if (prefetchSize == 0)
+        return;
+
+    std::size_t pos = getPosition();
+
+    prefetchEnd = std::max(prefetchEnd, pos);
+
+    if (prefetchEnd - pos >= prefetchSize / 2 || prefetchEnd >= getSize())
+        return;
+
+    prefetch(prefetchEnd, prefetchSize);
+
+    prefetchEnd = std::min(getSize(), prefetchEnd + prefetchSize);
+}
+
+Util::MappedFileIStream::MappedFileIStream():
+    std::istream(&streamBuf)
+{}
+
+Util::MappedFileIStream::MappedFileIStream(const std::string& file_name, std::ios_base::openmode mode):
+    std::istream(&streamBuf)
+{
+    open(file_name, mode);
+}
+
+void Util::MappedFileIStream::open(const std::string& file_name, std::ios_base::openmode mode)
+{
+    if (!(mode & std::ios_base::in) || (mode & std::ios_base::out) || !streamBuf.open(file_name)) {
+        setstate(std::ios_base::failbit);
+        return;
+    }
+
+    clear();
+}
+
+void Util::MappedFileIStream::close()
+{
+    streamBuf.close();
+}
+
+bool Util::MappedFileIStream::is_open() const
+{
+    return streamBuf.isOpen();
+}
+
+Util::MappedFileStreamBuffer* Util::MappedFileIStream::rdbuf() const
+{
+    return &streamBuf;
+}
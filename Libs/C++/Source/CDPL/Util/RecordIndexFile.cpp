@@ -0,0 +1,164 @@
+/* 
+ * RecordIndexFile.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <cstring>
+#include <fstream>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include "CDPL/Util/RecordIndexFile.hpp"
+#include "CDPL/Util/FileFunctions.hpp"
+#include "CDPL/Util/FileRemover.hpp"
+
+
+using namespace CDPL;
+
+
+namespace
+{
+
+    const char          FILE_ID[8]       = { 'C', 'D', 'P', 'L', 'R', 'I', 'D', 'X' };
+    const std::uint32_t FORMAT_VERSION   = 2;
+    const std::uint32_t BYTE_ORDER_MARK  = 0x01020304;
+
+    struct Header
+    {
+
+        char          fileID[8];
+        std::uint32_t formatVersion;
+        std::uint32_t byteOrderMark;
+        std::uint64_t sourceStamp;
+        std::uint64_t layoutID;
+        std::uint64_t startPosition;
+        std::uint64_t numRecords;
+    };
+}
+
+
+Util::RecordIndexFile::RecordIndexFile():
+    positions(0), numRecords(0)
+{}
+
+Util::RecordIndexFile::~RecordIndexFile()
+{}
+
+bool Util::RecordIndexFile::open(const std::string& path, std::uint64_t src_stamp, std::uint64_t start_pos, std::uint64_t layout_id)
+{
+    close();
+
+    if (!fileExists(path))
+        return false;
+
+    try {
+        MappedFilePtr file(new MappedFile(path));
+
+        if (!file->is_open() || file->size() < sizeof(Header))
+            return false;
+
+        Header header;
+
+        std::memcpy(&header, file->data(), sizeof(Header));
+
+        if (std::memcmp(header.fileID, FILE_ID, sizeof(FILE_ID)) != 0 || header.formatVersion != FORMAT_VERSION ||
+            header.byteOrderMark != BYTE_ORDER_MARK || header.sourceStamp != src_stamp || header.layoutID != layout_id ||
+            header.startPosition != start_pos)
+            return false;
+
+        if (file->size() != sizeof(Header) + header.numRecords * sizeof(std::uint64_t))
+            return false;
+
+        mappedFile.swap(file);
+        
+        positions  = reinterpret_cast<const std::uint64_t*>(mappedFile->data() + sizeof(Header));
+        numRecords = header.numRecords;
+
+        return true;
+
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
+void Util::RecordIndexFile::close()
+{
+    mappedFile.reset();
+
+    positions  = 0;
+    numRecords = 0;
+}
+
+bool Util::RecordIndexFile::isOpen() const
+{
+    return mappedFile.get();
+}
+
+std::size_t Util::RecordIndexFile::getNumRecords() const
+{
+    return numRecords;
+}
+
+std::uint64_t Util::RecordIndexFile::getRecordPosition(std::size_t idx) const
+{
+    return positions[idx];
+}
+
+bool Util::RecordIndexFile::write(const std::string& path, std::uint64_t src_stamp, std::uint64_t start_pos,
+                                  const std::uint64_t* positions, std::size_t num_records, std::uint64_t layout_id)
+{
+    try {
+        std::string::size_type sep_pos = path.find_last_of("/\\");
+        FileRemover tmp_file_rem(genCheckedTempFilePath(sep_pos == std::string::npos ? std::string(".") : path.substr(0, sep_pos + 1),
+                                                        "%%%%-%%%%-%%%%-%%%%.tmp"));
+
+        std::ofstream os(tmp_file_rem.getPath().c_str(), std::ios_base::out | std::ios_base::trunc | std::ios_base::binary);
+
+        if (!os)
+            return false;
+
+        Header header;
+
+        std::memcpy(header.fileID, FILE_ID, sizeof(FILE_ID));
+
+        header.formatVersion = FORMAT_VERSION;
+        header.byteOrderMark = BYTE_ORDER_MARK;
+        header.sourceStamp   = src_stamp;
+        header.layoutID      = layout_id;
+        header.startPosition = start_pos;
+        header.numRecords    = num_records;
+
+        os.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        os.write(reinterpret_cast<const char*>(positions), std::streamsize(num_records * sizeof(std::uint64_t)));
+        os.close();
+
+        if (!os || !renameFile(tmp_file_rem.getPath(), path))
+            return false;
+
+        tmp_file_rem.release();
+
+        return true;
+
+    } catch (const std::exception&) {
+        return false;
+    }
+}
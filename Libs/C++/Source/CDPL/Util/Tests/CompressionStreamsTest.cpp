@@ -0,0 +1,157 @@
+/* 
+ * CompressionStreamsTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <string>
+#include <sstream>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/Util/CompressionStreams.hpp"
+
+
+namespace
+{
+
+    template <typename CompStream>
+    std::string compress(const std::string& data)
+    {
+        std::stringstream ss;
+
+        {
+            CompStream os(ss);
+
+            os << data;
+            os.close();
+        }
+
+        return ss.str();
+    }
+
+    std::string makeTestData(std::size_t num_lines)
+    {
+        std::ostringstream oss;
+
+        for (std::size_t i = 0; i < num_lines; i++)
+            oss << "Line#" << i << '\n';
+
+        return oss.str();
+    }
+
+    template <typename CompStream, typename DecompStream>
+    void checkStreaming(const std::string& data)
+    {
+        std::istringstream is(compress<CompStream>(data));
+        DecompStream       dis(is);
+
+        BOOST_CHECK(dis.good());
+        BOOST_CHECK(dis.isStreaming());
+
+        std::string line;
+        std::string line_after_peek;
+
+        for (std::size_t i = 0; std::getline(dis, line); i++) {
+            std::istream::pos_type pos = dis.tellg();
+
+            if (!std::getline(dis, line_after_peek))
+                break;
+
+            dis.seekg(pos);
+
+            BOOST_CHECK(dis.good());
+            BOOST_CHECK(dis.tellg() == pos);
+        }
+
+        BOOST_CHECK(dis.isStreaming());
+
+        dis.clear();
+        dis.seekg(0);
+
+        BOOST_CHECK(dis.good());
+
+        std::ostringstream oss;
+
+        oss << dis.rdbuf();
+
+        BOOST_CHECK(oss.str() == data);
+        BOOST_CHECK(dis.isStreaming() == (data.size() <= CDPL::Util::DecompressionStreamBuffer<CDPL::Util::GZIP>::HISTORY_SIZE));
+
+        dis.clear();
+        dis.seekg(0, std::ios_base::end);
+
+        BOOST_CHECK(dis.good());
+        BOOST_CHECK(!dis.isStreaming());
+        BOOST_CHECK(std::size_t(dis.tellg()) == data.size());
+
+        dis.seekg(data.size() / 2);
+
+        oss.str("");
+        oss << dis.rdbuf();
+
+        BOOST_CHECK(oss.str() == data.substr(data.size() / 2));
+    }
+}
+
+
+BOOST_AUTO_TEST_CASE(CompressionStreamsTest)
+{
+    using namespace CDPL;
+    using namespace Util;
+
+    std::string small_data = makeTestData(100);
+    std::string large_data = makeTestData(200000);
+
+    checkStreaming<GZipOStream, GZipIStream>(small_data);
+    checkStreaming<GZipOStream, GZipIStream>(large_data);
+    checkStreaming<BZip2OStream, BZip2IStream>(large_data);
+
+    // -------------
+
+    std::istringstream is(compress<GZipOStream>(large_data));
+    GZipIStream        dis(is);
+
+    dis.seekg(large_data.size() - 10);
+
+    BOOST_CHECK(dis.good());
+    BOOST_CHECK(dis.isStreaming());
+
+    std::string line;
+
+    BOOST_CHECK(std::getline(dis, line));
+    BOOST_CHECK(line + '\n' == large_data.substr(large_data.size() - 10));
+    BOOST_CHECK(!std::getline(dis, line));
+
+    // -------------
+
+    std::istringstream empty_is("");
+    GZipIStream        empty_dis(empty_is);
+
+    BOOST_CHECK(empty_dis.good());
+    BOOST_CHECK(!std::getline(empty_dis, line));
+
+    empty_dis.clear();
+    empty_dis.seekg(0, std::ios_base::end);
+
+    BOOST_CHECK(empty_dis.good());
+    BOOST_CHECK(empty_dis.tellg() == std::istream::pos_type(0));
+}
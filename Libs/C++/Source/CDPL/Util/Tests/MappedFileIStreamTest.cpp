@@ -0,0 +1,114 @@
+/* 
+ * MappedFileIStreamTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <string>
+#include <fstream>
+#include <cstring>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/Util/MappedFileIStream.hpp"
+#include "CDPL/Util/FileFunctions.hpp"
+#include "CDPL/Util/FileRemover.hpp"
+
+
+BOOST_AUTO_TEST_CASE(MappedFileIStreamTest)
+{
+    using namespace CDPL;
+    using namespace Util;
+
+    FileRemover       tmp_file(genCheckedTempFilePath());
+    const std::string data("Record#1 Record#2\nRecord#3 Record#4");
+
+    std::ofstream(tmp_file.getPath().c_str(), std::ios_base::out | std::ios_base::binary) << data;
+
+    MappedFileIStream is1(tmp_file.getPath() + ".missing");
+
+    BOOST_CHECK(!is1.good());
+    BOOST_CHECK(!is1.is_open());
+
+    MappedFileIStream is2(tmp_file.getPath());
+
+    BOOST_CHECK(is2.good());
+    BOOST_CHECK(is2.is_open());
+    BOOST_CHECK(is2.rdbuf()->getSize() == data.size());
+    BOOST_CHECK(std::memcmp(is2.rdbuf()->getData(), data.data(), data.size()) == 0);
+
+    std::string str;
+
+    BOOST_CHECK(is2 >> str);
+    BOOST_CHECK(str == "Record#1");
+    BOOST_CHECK(is2.tellg() == std::istream::pos_type(8));
+
+    BOOST_CHECK(std::getline(is2, str));
+    BOOST_CHECK(str == " Record#2");
+
+    BOOST_CHECK(is2.seekg(9));
+    BOOST_CHECK(is2 >> str);
+    BOOST_CHECK(str == "Record#2");
+
+    BOOST_CHECK(is2.seekg(-8, std::ios_base::end));
+    BOOST_CHECK(is2 >> str);
+    BOOST_CHECK(str == "Record#4");
+    BOOST_CHECK(is2.eof());
+
+    is2.clear();
+
+    BOOST_CHECK(is2.seekg(-17, std::ios_base::cur));
+    BOOST_CHECK(is2.rdbuf()->getPosition() == 18);
+
+    const char* rec_data = is2.rdbuf()->consume(8);
+
+    BOOST_CHECK(rec_data == is2.rdbuf()->getData() + 18);
+    BOOST_CHECK(std::string(rec_data, 8) == "Record#3");
+    BOOST_CHECK(is2.tellg() == std::istream::pos_type(26));
+
+    BOOST_CHECK(!is2.rdbuf()->consume(10));
+    BOOST_CHECK(is2.tellg() == std::istream::pos_type(26));
+
+    BOOST_CHECK(!is2.seekg(data.size() + 1));
+
+    is2.clear();
+    is2.rdbuf()->setPrefetchSize(0);
+
+    BOOST_CHECK(is2.rdbuf()->getPrefetchSize() == 0);
+    BOOST_CHECK(is2.seekg(0));
+    BOOST_CHECK(is2 >> str);
+    BOOST_CHECK(str == "Record#1");
+
+    is2.close();
+
+    BOOST_CHECK(!is2.is_open());
+    BOOST_CHECK(is2.rdbuf()->getSize() == 0);
+    BOOST_CHECK(!(is2 >> str));
+
+    std::ofstream(tmp_file.getPath().c_str(), std::ios_base::out | std::ios_base::trunc);
+
+    is2.open(tmp_file.getPath());
+
+    BOOST_CHECK(is2.good());
+    BOOST_CHECK(is2.is_open());
+    BOOST_CHECK(is2.rdbuf()->getSize() == 0);
+    BOOST_CHECK(!(is2 >> str));
+}
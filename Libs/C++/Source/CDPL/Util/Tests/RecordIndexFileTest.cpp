@@ -0,0 +1,204 @@
+/* 
+ * RecordIndexFileTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <string>
+#include <sstream>
+#include <cstdint>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/Util/RecordIndexFile.hpp"
+#include "CDPL/Util/StreamDataReader.hpp"
+#include "CDPL/Util/ControlParameterFunctions.hpp"
+#include "CDPL/Util/FileFunctions.hpp"
+#include "CDPL/Util/FileRemover.hpp"
+
+
+namespace
+{
+
+    class TestStringReader : public CDPL::Util::StreamDataReader<std::string, TestStringReader>
+    {
+
+      public:
+        TestStringReader(std::istream& is):
+            CDPL::Util::StreamDataReader<std::string, TestStringReader>(is), numSkipCalls(0) {}
+
+        std::size_t numSkipCalls;
+        std::string layoutSettings;
+
+      private:
+        friend class CDPL::Util::StreamDataReader<std::string, TestStringReader>;
+
+        bool readData(std::istream& is, std::string& str, bool)
+        {
+            if (moreData(is))
+                return bool(is >> str);
+
+            return false;
+        }
+
+        bool skipData(std::istream& is)
+        {
+            if (!moreData(is))
+                return false;
+
+            std::string sink;
+
+            numSkipCalls++;
+
+            return bool(is >> sink);
+        }
+
+        bool moreData(std::istream& is)
+        {
+            return bool(std::istream::sentry(is, false));
+        }
+
+        std::string getRecordLayoutSettings() const
+        {
+            return layoutSettings;
+        }
+    };
+}
+
+
+BOOST_AUTO_TEST_CASE(RecordIndexFileTest)
+{
+    using namespace CDPL;
+    using namespace Util;
+
+    FileRemover idx_file(genCheckedTempFilePath());
+    std::uint64_t positions[] = { 3, 17, 25, 1000000000000 };
+
+    BOOST_CHECK(RecordIndexFile::write(idx_file.getPath(), 12345, 3, positions, 4, 7));
+
+    RecordIndexFile file;
+
+    BOOST_CHECK(!file.isOpen());
+    BOOST_CHECK(file.getNumRecords() == 0);
+
+    BOOST_CHECK(!file.open(idx_file.getPath(), 12346, 3, 7));
+    BOOST_CHECK(!file.isOpen());
+
+    BOOST_CHECK(!file.open(idx_file.getPath(), 12345, 3, 8));
+    BOOST_CHECK(!file.isOpen());
+
+    BOOST_CHECK(!file.open(idx_file.getPath(), 12345, 0, 7));
+    BOOST_CHECK(!file.isOpen());
+
+    BOOST_CHECK(!file.open(idx_file.getPath() + ".missing", 12345, 3, 7));
+    BOOST_CHECK(!file.isOpen());
+
+    BOOST_CHECK(file.open(idx_file.getPath(), 12345, 3, 7));
+    BOOST_CHECK(file.isOpen());
+    BOOST_CHECK(file.getNumRecords() == 4);
+
+    for (std::size_t i = 0; i < 4; i++)
+        BOOST_CHECK(file.getRecordPosition(i) == positions[i]);
+
+    file.close();
+
+    BOOST_CHECK(!file.isOpen());
+    BOOST_CHECK(file.getNumRecords() == 0);
+
+    BOOST_CHECK(RecordIndexFile::write(idx_file.getPath(), 1, 0, nullptr, 0));
+    BOOST_CHECK(file.open(idx_file.getPath(), 1, 0));
+    BOOST_CHECK(file.getNumRecords() == 0);
+
+    // -------------
+
+    FileRemover        rdr_idx_file(genCheckedTempFilePath());
+    std::string        record;
+    std::istringstream is1("Record#1 Record#2 \nRecord#3 Record#4   ");
+    TestStringReader   reader1(is1);
+
+    reader1.setRecordIndexFile(rdr_idx_file.getPath(), 42);
+
+    BOOST_CHECK(reader1.getNumRecords() == 4);
+    BOOST_CHECK(!fileExists(rdr_idx_file.getPath()));
+
+    std::istringstream is2("Record#1 Record#2 \nRecord#3 Record#4   ");
+    TestStringReader   reader2(is2);
+
+    setUseRecordIndexFilesParameter(reader2, true);
+    reader2.setRecordIndexFile(rdr_idx_file.getPath(), 42);
+
+    BOOST_CHECK(reader2.getNumRecords() == 4);
+    BOOST_CHECK(reader2.numSkipCalls == 4);
+    BOOST_CHECK(fileExists(rdr_idx_file.getPath()));
+
+    std::istringstream is3("Record#1 Record#2 \nRecord#3 Record#4   ");
+    TestStringReader   reader3(is3);
+
+    setUseRecordIndexFilesParameter(reader3, true);
+    reader3.setRecordIndexFile(rdr_idx_file.getPath(), 42);
+
+    BOOST_CHECK(reader3.getNumRecords() == 4);
+    BOOST_CHECK(reader3.numSkipCalls == 0);
+
+    BOOST_CHECK(reader3.read(2, record));
+    BOOST_CHECK(record == "Record#3");
+
+    BOOST_CHECK(reader3.read(record));
+    BOOST_CHECK(record == "Record#4");
+    BOOST_CHECK(!reader3.read(record));
+
+    reader3.setRecordIndex(1);
+
+    BOOST_CHECK(reader3.read(record));
+    BOOST_CHECK(record == "Record#2");
+
+    std::istringstream is4("Record#1 Record#2 Record#3");
+    TestStringReader   reader4(is4);
+
+    setUseRecordIndexFilesParameter(reader4, true);
+    reader4.setRecordIndexFile(rdr_idx_file.getPath(), 43);
+
+    BOOST_CHECK(reader4.getNumRecords() == 3);
+    BOOST_CHECK(reader4.numSkipCalls == 3);
+
+    // index files written for different record layout settings must not be used
+
+    std::istringstream is5("Record#1 Record#2 \nRecord#3 Record#4   ");
+    TestStringReader   reader5(is5);
+
+    setUseRecordIndexFilesParameter(reader5, true);
+    reader5.setRecordIndexFile(rdr_idx_file.getPath(), 42);
+    reader5.layoutSettings = "merged";
+
+    BOOST_CHECK(reader5.getRecordLayoutID() != reader3.getRecordLayoutID());
+    BOOST_CHECK(reader5.getNumRecords() == 4);
+    BOOST_CHECK(reader5.numSkipCalls == 4);
+
+    std::istringstream is6("Record#1 Record#2 \nRecord#3 Record#4   ");
+    TestStringReader   reader6(is6);
+
+    setUseRecordIndexFilesParameter(reader6, true);
+    reader6.setRecordIndexFile(rdr_idx_file.getPath(), 42);
+    reader6.layoutSettings = "merged";
+
+    BOOST_CHECK(reader6.getNumRecords() == 4);
+    BOOST_CHECK(reader6.numSkipCalls == 0);
+}
@@ -0,0 +1,99 @@
+/* 
+ * ThreadPoolTest.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+
+#include <boost/test/auto_unit_test.hpp>
+
+#include "CDPL/Util/ThreadPool.hpp"
+
+
+BOOST_AUTO_TEST_CASE(ThreadPoolTest)
+{
+    using namespace CDPL;
+
+    Util::ThreadPool pool(3);
+
+    BOOST_CHECK(pool.getNumThreads() == 3);
+    BOOST_CHECK(pool.getNumIdleThreads() == 3);
+
+    std::mutex mutex;
+    std::condition_variable cond;
+    bool release = false;
+    std::atomic<std::size_t> num_started(0);
+    std::atomic<std::size_t> num_finished(0);
+
+    auto task = [&]() {
+        num_started++;
+
+        std::unique_lock<std::mutex> lock(mutex);
+
+        cond.wait(lock, [&]() { return release; });
+
+        num_finished++;
+    };
+
+    // tasks are not queued - submissions fail while all threads are busy
+
+    BOOST_CHECK(pool.tryExecute(task));
+    BOOST_CHECK(pool.tryExecute(task));
+    BOOST_CHECK(pool.tryExecute(task));
+    BOOST_CHECK(!pool.tryExecute(task));
+    BOOST_CHECK(pool.getNumIdleThreads() == 0);
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        release = true;
+    }
+
+    cond.notify_all();
+    pool.wait();
+
+    BOOST_CHECK(num_started == 3);
+    BOOST_CHECK(num_finished == 3);
+    BOOST_CHECK(pool.getNumIdleThreads() == 3);
+
+    // exceptions thrown by tasks must not affect the pool
+
+    BOOST_CHECK(pool.tryExecute([]() { throw 1; }));
+
+    pool.wait();
+
+    BOOST_CHECK(pool.tryExecute([&]() { num_finished++; }));
+
+    pool.wait();
+
+    BOOST_CHECK(num_finished == 4);
+    BOOST_CHECK(pool.getNumIdleThreads() == 3);
+
+    Util::ThreadPool empty_pool(0);
+
+    BOOST_CHECK(empty_pool.getNumThreads() == 0);
+    BOOST_CHECK(!empty_pool.tryExecute(task));
+
+    empty_pool.wait();
+}
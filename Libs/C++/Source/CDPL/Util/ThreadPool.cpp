@@ -0,0 +1,144 @@
+/* 
+ * ThreadPool.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include "CDPL/Util/ThreadPool.hpp"
+
+
+using namespace CDPL;
+
+
+Util::ThreadPool::ThreadPool(std::size_t num_threads):
+    numIdleThreads(0), terminate(false)
+{
+    try {
+        for (std::size_t i = 0; i < num_threads; i++) {
+            threads.emplace_back(&ThreadPool::runThread, this);
+
+            std::lock_guard<std::mutex> lock(mutex);
+
+            numIdleThreads++;
+        }
+
+    } catch (...) {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            terminate = true;
+        }
+
+        taskCondition.notify_all();
+
+        for (auto& thread : threads)
+            thread.join();
+
+        throw;
+    }
+}
+
+Util::ThreadPool::~ThreadPool()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        idleCondition.wait(lock, [this]() { return (numIdleThreads == threads.size()); });
+
+        terminate = true;
+    }
+
+    taskCondition.notify_all();
+
+    for (auto& thread : threads)
+        thread.join();
+}
+
+std::size_t Util::ThreadPool::getNumThreads() const
+{
+    return threads.size();
+}
+
+std::size_t Util::ThreadPool::getNumIdleThreads() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+
+    return numIdleThreads;
+}
+
+bool Util::ThreadPool::tryExecute(const Task& task)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (numIdleThreads == 0)
+            return false;
+
+        // the thread picking up the task counts as busy from now on
+        
+        pendingTasks.push_back(task);
+        numIdleThreads--;
+    }
+
+    taskCondition.notify_one();
+
+    return true;
+}
+
+void Util::ThreadPool::wait()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+
+    idleCondition.wait(lock, [this]() { return (numIdleThreads == threads.size()); });
+}
+
+void Util::ThreadPool::runThread()
+{
+    Task task;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            taskCondition.wait(lock, [this]() { return (terminate || !pendingTasks.empty()); });
+
+            if (pendingTasks.empty())
+                return;
+
+            task = std::move(pendingTasks.back());
+            pendingTasks.pop_back();
+        }
+
+        try {
+            task();
+
+        } catch (...) {}
+
+        task = Task();
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if (++numIdleThreads == threads.size())
+                idleCondition.notify_all();
+        }
+    }
+}
@@ -28,6 +28,7 @@
 #include "CDPL/Chem/CDFGZMoleculeReader.hpp"
 #include "CDPL/Chem/CDFBZ2MoleculeReader.hpp"
 #include "CDPL/Util/FileDataReader.hpp"
+#include "CDPL/Util/MappedFileIStream.hpp"
 
 #include "ClassExports.hpp"
 
@@ -42,7 +43,7 @@ void CDPLPythonChem::exportCDFMoleculeReader()
         .def(python::init<std::istream&>((python::arg("self"), python::arg("is")))
              [python::with_custodian_and_ward<1, 2>()]);
 
-    python::class_<Util::FileDataReader<Chem::CDFMoleculeReader>, python::bases<Base::DataReader<Chem::Molecule> >, 
+    python::class_<Util::FileDataReader<Chem::CDFMoleculeReader, Chem::Molecule, Util::MappedFileIStream>, python::bases<Base::DataReader<Chem::Molecule> >, 
         boost::noncopyable>("FileCDFMoleculeReader", python::no_init)
         .def(python::init<const std::string&, std::ios_base::openmode>(
                  (python::arg("self"), python::arg("file_name"), python::arg("mode") = std::ios_base::in | std::ios_base::binary)));
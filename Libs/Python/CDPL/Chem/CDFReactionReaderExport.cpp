@@ -28,6 +28,7 @@
 #include "CDPL/Chem/CDFGZReactionReader.hpp"
 #include "CDPL/Chem/CDFBZ2ReactionReader.hpp"
 #include "CDPL/Util/FileDataReader.hpp"
+#include "CDPL/Util/MappedFileIStream.hpp"
 
 #include "ClassExports.hpp"
 
@@ -42,7 +43,7 @@ void CDPLPythonChem::exportCDFReactionReader()
         .def(python::init<std::istream&>((python::arg("self"), python::arg("is")))
              [python::with_custodian_and_ward<1, 2>()]);
 
-    python::class_<Util::FileDataReader<Chem::CDFReactionReader>, python::bases<Base::DataReader<Chem::Reaction> >, 
+    python::class_<Util::FileDataReader<Chem::CDFReactionReader, Chem::Reaction, Util::MappedFileIStream>, python::bases<Base::DataReader<Chem::Reaction> >, 
         boost::noncopyable>("FileCDFReactionReader", python::no_init)
         .def(python::init<const std::string&, std::ios_base::openmode>(
                  (python::arg("self"), python::arg("file_name"), python::arg("mode") = std::ios_base::in | std::ios_base::binary)));
@@ -82,6 +82,7 @@ namespace CDPLPythonChem
     void exportMaxCommonBondSubstructureSearch();
     void exportAutomorphismGroupSearch();
     void exportMultiSubstructureSearch();
+    void exportSubstructureScreeningKeyGenerator();
     
     void exportReactor();
     void exportSubstructureEditor();
@@ -90,6 +90,7 @@ BOOST_PYTHON_MODULE(_chem)
     exportMaxCommonBondSubstructureSearch();
     exportAutomorphismGroupSearch();
     exportMultiSubstructureSearch();
+    exportSubstructureScreeningKeyGenerator();
     
     exportReactor();
     exportSubstructureEditor();
@@ -43,7 +43,11 @@ void CDPLPythonChem::exportMultiSubstructureSearch()
         .def("addSubstructure", &Chem::MultiSubstructureSearch::addSubstructure, (python::arg("self"), python::arg("molgraph")))
         .def("getNumSubstructures", &Chem::MultiSubstructureSearch::getNumSubstructures, python::arg("self"))
         .def("clear", &Chem::MultiSubstructureSearch::clear, python::arg("self"))
-        .def("matches", &Chem::MultiSubstructureSearch::matches, (python::arg("self"), python::arg("target")))
+        .def("matches", static_cast<bool (Chem::MultiSubstructureSearch::*)(const Chem::MolecularGraph&)>
+             (&Chem::MultiSubstructureSearch::matches), (python::arg("self"), python::arg("target")))
+        .def("matches", static_cast<bool (Chem::MultiSubstructureSearch::*)(const Chem::MolecularGraph&, const Util::BitSet&)>
+             (&Chem::MultiSubstructureSearch::matches), (python::arg("self"), python::arg("target"), python::arg("tgt_keys")))
+        .def("screen", &Chem::MultiSubstructureSearch::screen, (python::arg("self"), python::arg("tgt_keys")))
         .def("setup", &Chem::MultiSubstructureSearch::setup, (python::arg("self"), python::arg("expr") = ""))  
         .def("validate", &Chem::MultiSubstructureSearch::validate, (python::arg("self"), python::arg("expr"), python::arg("max_substr_id")))  
         .add_property("numSubstructures", &Chem::MultiSubstructureSearch::getNumSubstructures);
@@ -0,0 +1,56 @@
+/* 
+ * SubstructureScreeningKeyGeneratorExport.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <boost/python.hpp>
+
+#include "CDPL/Chem/SubstructureScreeningKeyGenerator.hpp"
+#include "CDPL/Chem/MolecularGraph.hpp"
+
+#include "Base/ObjectIdentityCheckVisitor.hpp"
+#include "Base/CopyAssOp.hpp"
+
+#include "ClassExports.hpp"
+
+
+void CDPLPythonChem::exportSubstructureScreeningKeyGenerator()
+{
+    using namespace boost;
+    using namespace CDPL;
+
+    python::class_<Chem::SubstructureScreeningKeyGenerator>("SubstructureScreeningKeyGenerator", python::no_init)
+        .def(python::init<const Chem::SubstructureScreeningKeyGenerator&>((python::arg("self"), python::arg("gen"))))
+        .def(python::init<std::size_t>((python::arg("self"), python::arg("num_bits") = Chem::SubstructureScreeningKeyGenerator::DEF_NUM_BITS)))
+        .def(CDPLPythonBase::ObjectIdentityCheckVisitor<Chem::SubstructureScreeningKeyGenerator>())
+        .def("assign", CDPLPythonBase::copyAssOp<Chem::SubstructureScreeningKeyGenerator>(), 
+             (python::arg("self"), python::arg("gen")), python::return_self<>())
+        .def("setNumBits", &Chem::SubstructureScreeningKeyGenerator::setNumBits, (python::arg("self"), python::arg("num_bits")))
+        .def("getNumBits", &Chem::SubstructureScreeningKeyGenerator::getNumBits, python::arg("self"))
+        .def("generate", static_cast<void (Chem::SubstructureScreeningKeyGenerator::*)(const Chem::MolecularGraph&, Util::BitSet&)>
+             (&Chem::SubstructureScreeningKeyGenerator::generate), (python::arg("self"), python::arg("molgraph"), python::arg("keys")))
+        .def("generateQueryKeys", &Chem::SubstructureScreeningKeyGenerator::generateQueryKeys,
+             (python::arg("self"), python::arg("molgraph"), python::arg("keys")))
+        .def_readonly("DEF_NUM_BITS", Chem::SubstructureScreeningKeyGenerator::DEF_NUM_BITS)
+        .add_property("numBits", &Chem::SubstructureScreeningKeyGenerator::getNumBits,
+                      &Chem::SubstructureScreeningKeyGenerator::setNumBits);
+}
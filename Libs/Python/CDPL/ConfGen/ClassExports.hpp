@@ -36,6 +36,7 @@ namespace CDPLPythonConfGen
     void exportCanonicalFragment();
     void exportFragmentLibraryEntry();
     void exportFragmentLibrary();
+    void exportFragmentConformerCache();
     void exportConformerData();
     void exportTorsionRule();
     void exportTorsionCategory();
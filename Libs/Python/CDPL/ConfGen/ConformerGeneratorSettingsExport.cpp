@@ -110,6 +110,10 @@ void CDPLPythonConfGen::exportConformerGeneratorSettings()
              (python::arg("self"), python::arg("strict")))
         .def("strictForceFieldParameterization", GetBoolFunc(&ConfGen::ConformerGeneratorSettings::strictForceFieldParameterization), 
              python::arg("self"))
+        .def("packedForceFieldEvaluation", SetBoolFunc(&ConfGen::ConformerGeneratorSettings::packedForceFieldEvaluation), 
+             (python::arg("self"), python::arg("packed")))
+        .def("packedForceFieldEvaluation", GetBoolFunc(&ConfGen::ConformerGeneratorSettings::packedForceFieldEvaluation), 
+             python::arg("self"))
         .def("setDielectricConstant", &ConfGen::ConformerGeneratorSettings::setDielectricConstant, 
              (python::arg("self"), python::arg("de_const")))
         .def("getDielectricConstant", &ConfGen::ConformerGeneratorSettings::getDielectricConstant, 
@@ -163,6 +167,10 @@ void CDPLPythonConfGen::exportConformerGeneratorSettings()
              (python::arg("self"), python::arg("max_size")))
         .def("getMacrocycleRotorBondCountThreshold", &ConfGen::ConformerGeneratorSettings::getMacrocycleRotorBondCountThreshold, 
              python::arg("self"))
+        .def("setNumThreads", &ConfGen::ConformerGeneratorSettings::setNumThreads, 
+             (python::arg("self"), python::arg("num_threads")))
+        .def("getNumThreads", &ConfGen::ConformerGeneratorSettings::getNumThreads, 
+             python::arg("self"))
         .def("getFragmentBuildSettings", 
              static_cast<ConfGen::FragmentConformerGeneratorSettings& (ConfGen::ConformerGeneratorSettings::*)()>
              (&ConfGen::ConformerGeneratorSettings::getFragmentBuildSettings),
@@ -203,6 +211,8 @@ void CDPLPythonConfGen::exportConformerGeneratorSettings()
                       &ConfGen::ConformerGeneratorSettings::setForceFieldTypeStochastic)
         .add_property("strictForceFieldParam", GetBoolFunc(&ConfGen::ConformerGeneratorSettings::strictForceFieldParameterization), 
                       SetBoolFunc(&ConfGen::ConformerGeneratorSettings::strictForceFieldParameterization))
+        .add_property("packedForceFieldEval", GetBoolFunc(&ConfGen::ConformerGeneratorSettings::packedForceFieldEvaluation), 
+                      SetBoolFunc(&ConfGen::ConformerGeneratorSettings::packedForceFieldEvaluation))
         .add_property("dielectricConstant", &ConfGen::ConformerGeneratorSettings::getDielectricConstant, 
                       &ConfGen::ConformerGeneratorSettings::setDielectricConstant)
         .add_property("distanceExponent", &ConfGen::ConformerGeneratorSettings::getDistanceExponent, 
@@ -223,6 +233,8 @@ void CDPLPythonConfGen::exportConformerGeneratorSettings()
                       &ConfGen::ConformerGeneratorSettings::setConvergenceCheckCycleSize)
         .add_property("macrocycleRotorBondCountThresh", &ConfGen::ConformerGeneratorSettings::getMacrocycleRotorBondCountThreshold, 
                       &ConfGen::ConformerGeneratorSettings::setMacrocycleRotorBondCountThreshold)
+        .add_property("numThreads", &ConfGen::ConformerGeneratorSettings::getNumThreads, 
+                      &ConfGen::ConformerGeneratorSettings::setNumThreads)
         .add_property("fragmentBuildSettings", 
                       python::make_function(static_cast<ConfGen::FragmentConformerGeneratorSettings& (ConfGen::ConformerGeneratorSettings::*)()>
                                             (&ConfGen::ConformerGeneratorSettings::getFragmentBuildSettings),
@@ -47,6 +47,8 @@ void CDPLPythonConfGen::exportDGStructureGenerator()
              (python::arg("self"), python::arg("gen")), python::return_self<>())
         .def("getExcludedHydrogenMask", &ConfGen::DGStructureGenerator::getExcludedHydrogenMask, python::arg("self"), 
              python::return_internal_reference<>())
+        .def("setRandomSeed", &ConfGen::DGStructureGenerator::setRandomSeed, (python::arg("self"), python::arg("seed")))
+        .def("getRandomSeed", &ConfGen::DGStructureGenerator::getRandomSeed, python::arg("self"))
         .def("setup", static_cast<void (ConfGen::DGStructureGenerator::*)(const Chem::MolecularGraph&)>
              (&ConfGen::DGStructureGenerator::setup), (python::arg("self"), python::arg("molgraph")))
         .def("setup", static_cast<void (ConfGen::DGStructureGenerator::*)(const Chem::MolecularGraph&, const ForceField::MMFF94InteractionData&)>
@@ -67,6 +69,7 @@ void CDPLPythonConfGen::exportDGStructureGenerator()
              python::arg("self"), python::return_internal_reference<>())
         .add_property("numAtomStereoCenters",  &ConfGen::DGStructureGenerator::getNumAtomStereoCenters)
         .add_property("numBondStereoCenters",  &ConfGen::DGStructureGenerator::getNumBondStereoCenters)
+        .add_property("randomSeed", &ConfGen::DGStructureGenerator::getRandomSeed, &ConfGen::DGStructureGenerator::setRandomSeed)
         .add_property("settings", 
                       python::make_function(static_cast<ConfGen::DGStructureGeneratorSettings& (ConfGen::DGStructureGenerator::*)()>
                                             (&ConfGen::DGStructureGenerator::getSettings),
@@ -0,0 +1,63 @@
+/* 
+ * FragmentConformerCacheExport.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <boost/python.hpp>
+
+#include "CDPL/ConfGen/FragmentConformerCache.hpp"
+
+#include "ClassExports.hpp"
+
+
+void CDPLPythonConfGen::exportFragmentConformerCache()
+{
+    using namespace boost;
+    using namespace CDPL;
+
+    python::scope scope = python::class_<ConfGen::FragmentConformerCache, boost::noncopyable>("FragmentConformerCache", python::no_init)
+        .def("setMemoryBudget", &ConfGen::FragmentConformerCache::setMemoryBudget, python::arg("num_bytes"))
+        .staticmethod("setMemoryBudget")
+        .def("getMemoryBudget", &ConfGen::FragmentConformerCache::getMemoryBudget)
+        .staticmethod("getMemoryBudget")
+        .def("getNumShards", &ConfGen::FragmentConformerCache::getNumShards)
+        .staticmethod("getNumShards")
+        .def("getStatistics", static_cast<ConfGen::FragmentConformerCache::Statistics (*)(std::size_t)>(
+                 &ConfGen::FragmentConformerCache::getStatistics), python::arg("idx"))
+        .def("getStatistics", static_cast<ConfGen::FragmentConformerCache::Statistics (*)()>(
+                 &ConfGen::FragmentConformerCache::getStatistics))
+        .staticmethod("getStatistics")
+        .def("clear", &ConfGen::FragmentConformerCache::clear)
+        .staticmethod("clear")
+        .def("load", &ConfGen::FragmentConformerCache::load, python::arg("is"))
+        .staticmethod("load")
+        .def("save", &ConfGen::FragmentConformerCache::save, python::arg("os"))
+        .staticmethod("save")
+        .def_readonly("DEF_MEMORY_BUDGET", ConfGen::FragmentConformerCache::DEF_MEMORY_BUDGET);
+
+    python::class_<ConfGen::FragmentConformerCache::Statistics>("Statistics", python::no_init)
+        .def_readonly("numEntries", &ConfGen::FragmentConformerCache::Statistics::numEntries)
+        .def_readonly("memoryUsage", &ConfGen::FragmentConformerCache::Statistics::memoryUsage)
+        .def_readonly("numHits", &ConfGen::FragmentConformerCache::Statistics::numHits)
+        .def_readonly("numMisses", &ConfGen::FragmentConformerCache::Statistics::numMisses)
+        .def_readonly("numEvictions", &ConfGen::FragmentConformerCache::Statistics::numEvictions);
+}
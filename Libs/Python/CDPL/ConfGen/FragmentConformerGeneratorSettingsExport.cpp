@@ -104,6 +104,10 @@ void CDPLPythonConfGen::exportFragmentConformerGeneratorSettings()
              (python::arg("self"), python::arg("strict")))
         .def("strictForceFieldParameterization", GetBoolFunc(&ConfGen::FragmentConformerGeneratorSettings::strictForceFieldParameterization), 
              python::arg("self"))
+        .def("packedForceFieldEvaluation", SetBoolFunc(&ConfGen::FragmentConformerGeneratorSettings::packedForceFieldEvaluation), 
+             (python::arg("self"), python::arg("packed")))
+        .def("packedForceFieldEvaluation", GetBoolFunc(&ConfGen::FragmentConformerGeneratorSettings::packedForceFieldEvaluation), 
+             python::arg("self"))
         .def("setDielectricConstant", &ConfGen::FragmentConformerGeneratorSettings::setDielectricConstant, 
              (python::arg("self"), python::arg("de_const")))
         .def("getDielectricConstant", &ConfGen::FragmentConformerGeneratorSettings::getDielectricConstant, 
@@ -149,6 +153,8 @@ void CDPLPythonConfGen::exportFragmentConformerGeneratorSettings()
                       &ConfGen::FragmentConformerGeneratorSettings::setForceFieldType)
         .add_property("strictForceFieldParam", GetBoolFunc(&ConfGen::FragmentConformerGeneratorSettings::strictForceFieldParameterization), 
                       SetBoolFunc(&ConfGen::FragmentConformerGeneratorSettings::strictForceFieldParameterization))
+        .add_property("packedForceFieldEval", GetBoolFunc(&ConfGen::FragmentConformerGeneratorSettings::packedForceFieldEvaluation), 
+                      SetBoolFunc(&ConfGen::FragmentConformerGeneratorSettings::packedForceFieldEvaluation))
         .add_property("dielectricConstant", &ConfGen::FragmentConformerGeneratorSettings::getDielectricConstant, 
                       &ConfGen::FragmentConformerGeneratorSettings::setDielectricConstant)
         .add_property("distanceExponent", &ConfGen::FragmentConformerGeneratorSettings::getDistanceExponent, 
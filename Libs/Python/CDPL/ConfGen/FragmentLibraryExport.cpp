@@ -76,6 +76,8 @@ void CDPLPythonConfGen::exportFragmentLibrary()
         .def("load", &ConfGen::FragmentLibrary::load, (python::arg("self"), python::arg("is"))) 
         .def("loadDefaults", &ConfGen::FragmentLibrary::loadDefaults, python::arg("self")) 
         .def("save", &ConfGen::FragmentLibrary::save, (python::arg("self"), python::arg("os"))) 
+        .def("saveIndexed", &ConfGen::FragmentLibrary::saveIndexed, (python::arg("self"), python::arg("os"))) 
+        .def("mapFile", &ConfGen::FragmentLibrary::mapFile, (python::arg("self"), python::arg("file_name"))) 
         .def("assign", CDPLPythonBase::copyAssOp<ConfGen::FragmentLibrary>(), 
              (python::arg("self"), python::arg("lib")), python::return_self<>())
         .add_property("numEntries", &ConfGen::FragmentLibrary::getNumEntries)
@@ -47,6 +47,7 @@ BOOST_PYTHON_MODULE(_confgen)
     exportCanonicalFragment();
     exportFragmentLibraryEntry();
     exportFragmentLibrary();
+    exportFragmentConformerCache();
     exportConformerData();
     exportTorsionRule();
     exportTorsionCategory();
@@ -74,6 +74,10 @@ void CDPLPythonConfGen::exportTorsionDriverSettings()
              (python::arg("self"), python::arg("strict")))
         .def("strictForceFieldParameterization", GetBoolFunc(&ConfGen::TorsionDriverSettings::strictForceFieldParameterization), 
              python::arg("self"))
+        .def("packedForceFieldEvaluation", SetBoolFunc(&ConfGen::TorsionDriverSettings::packedForceFieldEvaluation), 
+             (python::arg("self"), python::arg("packed")))
+        .def("packedForceFieldEvaluation", GetBoolFunc(&ConfGen::TorsionDriverSettings::packedForceFieldEvaluation), 
+             python::arg("self"))
         .def("setDielectricConstant", &ConfGen::TorsionDriverSettings::setDielectricConstant, 
              (python::arg("self"), python::arg("de_const")))
         .def("getDielectricConstant", &ConfGen::TorsionDriverSettings::getDielectricConstant, 
@@ -91,6 +95,8 @@ void CDPLPythonConfGen::exportTorsionDriverSettings()
                       &ConfGen::TorsionDriverSettings::setForceFieldType)
         .add_property("strictForceFieldParam", GetBoolFunc(&ConfGen::TorsionDriverSettings::strictForceFieldParameterization), 
                       SetBoolFunc(&ConfGen::TorsionDriverSettings::strictForceFieldParameterization))
+        .add_property("packedForceFieldEval", GetBoolFunc(&ConfGen::TorsionDriverSettings::packedForceFieldEvaluation), 
+                      SetBoolFunc(&ConfGen::TorsionDriverSettings::packedForceFieldEvaluation))
         .add_property("dielectricConstant", &ConfGen::TorsionDriverSettings::getDielectricConstant, 
                       &ConfGen::TorsionDriverSettings::setDielectricConstant)
         .add_property("distanceExponent", &ConfGen::TorsionDriverSettings::getDistanceExponent, 
@@ -31,6 +31,7 @@ namespace CDPLPythonDescr
 
     void exportSimilarityFunctors();
     void exportBulkSimilarityCalculator();
+    void exportFingerprintBulkSimilarityCalculator();
     void exportAutoCorrelation2DVectorCalculator();
     void exportAtomRDFCodeCalculator();
     void exportMoleculeRDFDescriptorCalculator();
@@ -0,0 +1,106 @@
+/* 
+ * FingerprintBulkSimilarityCalculatorExport.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+
+#include <boost/python.hpp>
+
+#include "CDPL/Descr/FingerprintBulkSimilarityCalculator.hpp"
+
+#include "Base/ObjectIdentityCheckVisitor.hpp"
+#include "Base/CopyAssOp.hpp"
+
+#include "ClassExports.hpp"
+
+
+namespace
+{
+
+    boost::python::tuple getResult(const CDPL::Descr::FingerprintBulkSimilarityCalculator& calc, std::size_t idx)
+    {
+        auto& res = calc.getResult(idx);
+
+        return boost::python::make_tuple(res.first, res.second);
+    }
+
+    CDPL::Util::BitSet getFingerprint(const CDPL::Descr::FingerprintBulkSimilarityCalculator& calc, std::size_t idx)
+    {
+        CDPL::Util::BitSet fp;
+
+        calc.getFingerprint(idx, fp);
+
+        return fp;
+    }
+}
+
+
+void CDPLPythonDescr::exportFingerprintBulkSimilarityCalculator()
+{
+    using namespace boost;
+    using namespace CDPL;
+
+    typedef Descr::FingerprintBulkSimilarityCalculator CalculatorType;
+
+    python::scope scope = python::class_<CalculatorType, CalculatorType::SharedPointer>("FingerprintBulkSimilarityCalculator", python::no_init)
+        .def(python::init<const CalculatorType&>((python::arg("self"), python::arg("calc"))))
+        .def(python::init<CalculatorType::SimilarityMeasure>((python::arg("self"), python::arg("measure") = CalculatorType::TANIMOTO)))
+        .def(CDPLPythonBase::ObjectIdentityCheckVisitor<CalculatorType>())
+        .def("assign", CDPLPythonBase::copyAssOp<CalculatorType>(),
+             (python::arg("self"), python::arg("calc")), python::return_self<>())
+        .def("setSimilarityMeasure", &CalculatorType::setSimilarityMeasure, (python::arg("self"), python::arg("measure")))
+        .def("getSimilarityMeasure", &CalculatorType::getSimilarityMeasure, python::arg("self"))
+        .def("setTverskyWeights", &CalculatorType::setTverskyWeights, (python::arg("self"), python::arg("alpha"), python::arg("beta")))
+        .def("getTverskyAlpha", &CalculatorType::getTverskyAlpha, python::arg("self"))
+        .def("getTverskyBeta", &CalculatorType::getTverskyBeta, python::arg("self"))
+        .def("clear", &CalculatorType::clear, python::arg("self"))
+        .def("getNumFingerprints", &CalculatorType::getNumFingerprints, python::arg("self"))
+        .def("getNumBits", &CalculatorType::getNumBits, python::arg("self"))
+        .def("addFingerprint", &CalculatorType::addFingerprint, (python::arg("self"), python::arg("fp")))
+        .def("getFingerprint", &getFingerprint, (python::arg("self"), python::arg("idx")))
+        .def("removeFingerprint", &CalculatorType::removeFingerprint, (python::arg("self"), python::arg("idx")))
+        .def("calculate", &CalculatorType::calculate,
+             (python::arg("self"), python::arg("fp"), python::arg("sort") = false, python::arg("sort_desc") = true))
+        .def("calculateTopN", &CalculatorType::calculateTopN,
+             (python::arg("self"), python::arg("fp"), python::arg("num_results")))
+        .def("calculateAboveThreshold", &CalculatorType::calculateAboveThreshold,
+             (python::arg("self"), python::arg("fp"), python::arg("threshold")))
+        .def("getNumResults", &CalculatorType::getNumResults, python::arg("self"))
+        .def("getResult", &getResult, (python::arg("self"), python::arg("idx")))
+        .def("getSimilarity", &CalculatorType::getSimilarity, (python::arg("self"), python::arg("idx")))
+        .def("getFingerprintIndex", &CalculatorType::getFingerprintIndex, (python::arg("self"), python::arg("idx")))
+        .def("__getitem__", &getResult, (python::arg("self"), python::arg("idx")))
+        .def("__len__", &CalculatorType::getNumResults, python::arg("self"))
+        .add_property("numFingerprints", &CalculatorType::getNumFingerprints)
+        .add_property("numBits", &CalculatorType::getNumBits)
+        .add_property("numResults", &CalculatorType::getNumResults)
+        .add_property("tverskyAlpha", &CalculatorType::getTverskyAlpha)
+        .add_property("tverskyBeta", &CalculatorType::getTverskyBeta)
+        .add_property("similarityMeasure", &CalculatorType::getSimilarityMeasure, &CalculatorType::setSimilarityMeasure);
+
+    python::enum_<CalculatorType::SimilarityMeasure>("SimilarityMeasure")
+        .value("TANIMOTO", CalculatorType::TANIMOTO)
+        .value("TVERSKY", CalculatorType::TVERSKY)
+        .value("COSINE", CalculatorType::COSINE)
+        .value("EUCLIDEAN", CalculatorType::EUCLIDEAN)
+        .export_values();
+}
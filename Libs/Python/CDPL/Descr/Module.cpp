@@ -36,6 +36,7 @@ BOOST_PYTHON_MODULE(_descr)
 
     exportSimilarityFunctors();
     exportBulkSimilarityCalculator();
+    exportFingerprintBulkSimilarityCalculator();
 
     exportAutoCorrelation2DVectorCalculator();
     exportAtomRDFCodeCalculator();
@@ -38,6 +38,9 @@ namespace CDPLPythonForceField
 
     void exportMMFF94EnergyCalculator();
     void exportMMFF94GradientCalculator();
+    void exportMMFF94PackedEnergyCalculator();
+    void exportMMFF94PackedGradientCalculator();
+    void exportNonbondedNeighborList();
 
     void exportMMFF94BondStretchingInteraction();
     void exportMMFF94AngleBendingInteraction();
@@ -24,6 +24,8 @@
 
 #include "CDPL/ForceField/MMFF94EnergyCalculator.hpp"
 #include "CDPL/ForceField/MMFF94GradientCalculator.hpp"
+#include "CDPL/ForceField/MMFF94PackedEnergyCalculator.hpp"
+#include "CDPL/ForceField/MMFF94PackedGradientCalculator.hpp"
 #include "CDPL/Math/BFGSMinimizer.hpp"
 
 #include "Base/GenericFromPythonConverter.hpp"
@@ -39,4 +41,8 @@ void CDPLPythonForceField::registerFromPythonConverters()
                                                Math::BFGSMinimizer<Math::Vector3DArray, double, double>::ObjectiveFunction, true>();
     CDPLPythonBase::GenericFromPythonConverter<ForceField::MMFF94GradientCalculator<double>&,
                                                Math::BFGSMinimizer<Math::Vector3DArray, double, double>::GradientFunction, true>();
+    CDPLPythonBase::GenericFromPythonConverter<ForceField::MMFF94PackedEnergyCalculator&,
+                                               Math::BFGSMinimizer<Math::Vector3DArray, double, double>::ObjectiveFunction, true>();
+    CDPLPythonBase::GenericFromPythonConverter<ForceField::MMFF94PackedGradientCalculator&,
+                                               Math::BFGSMinimizer<Math::Vector3DArray, double, double>::GradientFunction, true>();
 }
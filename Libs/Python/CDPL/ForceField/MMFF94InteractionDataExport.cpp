@@ -69,10 +69,19 @@ void CDPLPythonForceField::exportMMFF94InteractionData()
              static_cast<ForceField::MMFF94VanDerWaalsInteractionList& (ForceField::MMFF94InteractionData::*)()>(
                  &ForceField::MMFF94InteractionData::getVanDerWaalsInteractions), python::arg("self"),
              python::return_internal_reference<>())
+        .def("setNonbondedCutoff", &ForceField::MMFF94InteractionData::setNonbondedCutoff, 
+             (python::arg("self"), python::arg("cutoff")))
+        .def("getNonbondedCutoff", &ForceField::MMFF94InteractionData::getNonbondedCutoff, python::arg("self"))
+        .def("setNonbondedSwitchingWidth", &ForceField::MMFF94InteractionData::setNonbondedSwitchingWidth, 
+             (python::arg("self"), python::arg("width")))
+        .def("getNonbondedSwitchingWidth", &ForceField::MMFF94InteractionData::getNonbondedSwitchingWidth, python::arg("self"))
+        .def("getNonbondedDataVersion", &ForceField::MMFF94InteractionData::getNonbondedDataVersion, python::arg("self"))
         .def("assign", CDPLPythonBase::copyAssOp<ForceField::MMFF94InteractionData>(),
              (python::arg("self"), python::arg("ia_data")), python::return_self<>())
         .def("swap", &ForceField::MMFF94InteractionData::swap, (python::arg("self"), python::arg("ia_data")))
         .def(CDPLPythonBase::ObjectIdentityCheckVisitor<ForceField::MMFF94InteractionData>())
+        .def_readonly("NO_NONBONDED_CUTOFF", ForceField::MMFF94InteractionData::NO_NONBONDED_CUTOFF)
+        .def_readonly("DEF_NONBONDED_SWITCHING_WIDTH", ForceField::MMFF94InteractionData::DEF_NONBONDED_SWITCHING_WIDTH)
         .add_property("bondStretchingInteractions", 
                       python::make_function(static_cast<ForceField::MMFF94BondStretchingInteractionList& (ForceField::MMFF94InteractionData::*)()>(
                                                 &ForceField::MMFF94InteractionData::getBondStretchingInteractions), python::return_internal_reference<>()))
@@ -93,5 +102,10 @@ void CDPLPythonForceField::exportMMFF94InteractionData()
                                                 &ForceField::MMFF94InteractionData::getElectrostaticInteractions), python::return_internal_reference<>()))
         .add_property("vanDerWaalsInteractions", 
                       python::make_function(static_cast<ForceField::MMFF94VanDerWaalsInteractionList& (ForceField::MMFF94InteractionData::*)()>(
-                                                &ForceField::MMFF94InteractionData::getVanDerWaalsInteractions), python::return_internal_reference<>()));
+                                                &ForceField::MMFF94InteractionData::getVanDerWaalsInteractions), python::return_internal_reference<>()))
+        .add_property("nonbondedCutoff", &ForceField::MMFF94InteractionData::getNonbondedCutoff,
+                      &ForceField::MMFF94InteractionData::setNonbondedCutoff)
+        .add_property("nonbondedSwitchingWidth", &ForceField::MMFF94InteractionData::getNonbondedSwitchingWidth,
+                      &ForceField::MMFF94InteractionData::setNonbondedSwitchingWidth)
+        .add_property("nonbondedDataVersion", &ForceField::MMFF94InteractionData::getNonbondedDataVersion);
 }
@@ -96,11 +96,21 @@ void CDPLPythonForceField::exportMMFF94InteractionParameterizer()
              (python::arg("self"), python::arg("de_const")))
         .def("setDistanceExponent", &ForceField::MMFF94InteractionParameterizer::setDistanceExponent, 
              (python::arg("self"), python::arg("dist_expo")))
+        .def("setNonbondedCutoff", &ForceField::MMFF94InteractionParameterizer::setNonbondedCutoff, 
+             (python::arg("self"), python::arg("cutoff")))
+        .def("getNonbondedCutoff", &ForceField::MMFF94InteractionParameterizer::getNonbondedCutoff, python::arg("self"))
+        .def("setNonbondedSwitchingWidth", &ForceField::MMFF94InteractionParameterizer::setNonbondedSwitchingWidth, 
+             (python::arg("self"), python::arg("width")))
+        .def("getNonbondedSwitchingWidth", &ForceField::MMFF94InteractionParameterizer::getNonbondedSwitchingWidth, python::arg("self"))
         .def("setParameterSet", &ForceField::MMFF94InteractionParameterizer::setParameterSet, 
              (python::arg("self"), python::arg("param_set")))
         .def("assign", CDPLPythonBase::copyAssOp<ForceField::MMFF94InteractionParameterizer>(),
              (python::arg("self"), python::arg("parameterizer")), python::return_self<>())
         .def("parameterize", &ForceField::MMFF94InteractionParameterizer::parameterize, 
              (python::arg("self"), python::arg("molgraph"), python::arg("ia_data"), 
-              python::arg("ia_types") = ForceField::InteractionType::ALL, python::arg("strict") = true));
+              python::arg("ia_types") = ForceField::InteractionType::ALL, python::arg("strict") = true))
+        .add_property("nonbondedCutoff", &ForceField::MMFF94InteractionParameterizer::getNonbondedCutoff,
+                      &ForceField::MMFF94InteractionParameterizer::setNonbondedCutoff)
+        .add_property("nonbondedSwitchingWidth", &ForceField::MMFF94InteractionParameterizer::getNonbondedSwitchingWidth,
+                      &ForceField::MMFF94InteractionParameterizer::setNonbondedSwitchingWidth);
 }
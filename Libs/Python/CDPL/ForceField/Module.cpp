@@ -55,6 +55,9 @@ BOOST_PYTHON_MODULE(_forcefield)
 
     exportMMFF94EnergyCalculator();
     exportMMFF94GradientCalculator();
+    exportMMFF94PackedEnergyCalculator();
+    exportMMFF94PackedGradientCalculator();
+    exportNonbondedNeighborList();
 
     exportMMFF94BondStretchingInteraction();
     exportMMFF94AngleBendingInteraction();
@@ -0,0 +1,86 @@
+/* 
+ * NonbondedNeighborListExport.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <boost/python.hpp>
+
+#include "CDPL/ForceField/NonbondedNeighborList.hpp"
+#include "CDPL/ForceField/MMFF94ElectrostaticInteractionList.hpp"
+#include "CDPL/ForceField/MMFF94VanDerWaalsInteractionList.hpp"
+#include "CDPL/Math/VectorArray.hpp"
+
+#include "Base/ObjectIdentityCheckVisitor.hpp"
+#include "Base/CopyAssOp.hpp"
+
+#include "ClassExports.hpp"
+
+
+namespace
+{
+
+    template <typename InteractionList>
+    void setup(CDPL::ForceField::NonbondedNeighborList& nbr_list, const InteractionList& ia_list)
+    {
+        nbr_list.setup(ia_list.getElementsBegin(), ia_list.getElementsEnd());
+    }
+
+    boost::python::list getInteractionIndices(const CDPL::ForceField::NonbondedNeighborList& nbr_list)
+    {
+        boost::python::list indices;
+
+        for (auto idx : nbr_list.getInteractionIndices())
+            indices.append(idx);
+
+        return indices;
+    }
+}
+
+
+void CDPLPythonForceField::exportNonbondedNeighborList()
+{
+    using namespace boost;
+    using namespace CDPL;
+
+    python::class_<ForceField::NonbondedNeighborList>("NonbondedNeighborList", python::no_init)
+        .def(python::init<>(python::arg("self")))
+        .def(python::init<const ForceField::NonbondedNeighborList&>((python::arg("self"), python::arg("nbr_list"))))
+        .def(CDPLPythonBase::ObjectIdentityCheckVisitor<ForceField::NonbondedNeighborList>())
+        .def("assign", CDPLPythonBase::copyAssOp<ForceField::NonbondedNeighborList>(),
+             (python::arg("self"), python::arg("nbr_list")), python::return_self<>())
+        .def("setCutoff", &ForceField::NonbondedNeighborList::setCutoff, (python::arg("self"), python::arg("cutoff")))
+        .def("getCutoff", &ForceField::NonbondedNeighborList::getCutoff, python::arg("self"))
+        .def("setSkinDistance", &ForceField::NonbondedNeighborList::setSkinDistance, (python::arg("self"), python::arg("skin")))
+        .def("getSkinDistance", &ForceField::NonbondedNeighborList::getSkinDistance, python::arg("self"))
+        .def("setup", &setup<ForceField::MMFF94ElectrostaticInteractionList>, (python::arg("self"), python::arg("ia_list")))
+        .def("setup", &setup<ForceField::MMFF94VanDerWaalsInteractionList>, (python::arg("self"), python::arg("ia_list")))
+        .def("clear", &ForceField::NonbondedNeighborList::clear, python::arg("self"))
+        .def("getNumInteractions", &ForceField::NonbondedNeighborList::getNumInteractions, python::arg("self"))
+        .def("update", &ForceField::NonbondedNeighborList::update<Math::Vector3DArray>, (python::arg("self"), python::arg("coords")))
+        .def("getInteractionIndices", &getInteractionIndices, python::arg("self"))
+        .def_readonly("DEF_SKIN_DISTANCE", ForceField::NonbondedNeighborList::DEF_SKIN_DISTANCE)
+        .add_property("cutoff", &ForceField::NonbondedNeighborList::getCutoff, &ForceField::NonbondedNeighborList::setCutoff)
+        .add_property("skinDistance", &ForceField::NonbondedNeighborList::getSkinDistance, 
+                      &ForceField::NonbondedNeighborList::setSkinDistance)
+        .add_property("numInteractions", &ForceField::NonbondedNeighborList::getNumInteractions)
+        .add_property("interactionIndices", &getInteractionIndices);
+}
@@ -28,6 +28,7 @@
 #include "CDPL/Grid/CDFGZDRegularGridReader.hpp"
 #include "CDPL/Grid/CDFBZ2DRegularGridReader.hpp"
 #include "CDPL/Util/FileDataReader.hpp"
+#include "CDPL/Util/MappedFileIStream.hpp"
 
 #include "ClassExports.hpp"
 
@@ -42,7 +43,7 @@ void CDPLPythonGrid::exportCDFRegularGridReader()
         .def(python::init<std::istream&>((python::arg("self"), python::arg("is")))
              [python::with_custodian_and_ward<1, 2>()]);
 
-    python::class_<Util::FileDataReader<Grid::CDFDRegularGridReader>, python::bases<Base::DataReader<Grid::DRegularGrid> >, 
+    python::class_<Util::FileDataReader<Grid::CDFDRegularGridReader, Grid::DRegularGrid, Util::MappedFileIStream>, python::bases<Base::DataReader<Grid::DRegularGrid> >, 
         boost::noncopyable>("FileCDFDRegularGridReader", python::no_init)
         .def(python::init<const std::string&, std::ios_base::openmode>(
                  (python::arg("self"), python::arg("file_name"), python::arg("mode") = std::ios_base::in | std::ios_base::binary)));
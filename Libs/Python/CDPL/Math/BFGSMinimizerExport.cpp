@@ -57,10 +57,17 @@ namespace
                 .value("GNORM_REACHED", MinimizerType::GNORM_REACHED)
                 .value("DELTAF_REACHED", MinimizerType::DELTAF_REACHED)
                 .export_values();
+
+            python::enum_<typename MinimizerType::EvaluationRequest>("EvaluationRequest")
+                .value("NO_EVALUATION", MinimizerType::NO_EVALUATION)
+                .value("VALUE_EVALUATION", MinimizerType::VALUE_EVALUATION)
+                .value("GRADIENT_EVALUATION", MinimizerType::GRADIENT_EVALUATION)
+                .export_values();
             
             cl
                 .def(python::init<const typename MinimizerType::ObjectiveFunction&, const typename MinimizerType::GradientFunction&>(
                          (python::arg("self"), python::arg("func"), python::arg("grad_func"))))
+                .def(python::init<>(python::arg("self")))
                 .def(CDPLPythonBase::ObjectIdentityCheckVisitor<MinimizerType>())
                 .def("getGradientNorm", &MinimizerType::getGradientNorm, python::arg("self"))
                 .def("getFunctionDelta", &MinimizerType::getFunctionDelta, python::arg("self"))
@@ -74,11 +81,30 @@ namespace
                      (python::arg("self"), python::arg("x"), python::arg("g"), python::arg("step_size") = 0.001, 
                       python::arg("tol") = 0.15))
                 .def("iterate", &iterate, (python::arg("self"), python::arg("f"), python::arg("x"), python::arg("g")))
+                .def("start", &MinimizerType::start, 
+                     (python::arg("self"), python::arg("x"), python::arg("max_iter"), python::arg("g_norm"), 
+                      python::arg("delta_f"), python::arg("step_size") = 0.001, python::arg("tol") = 0.15))
+                .def("advance", &MinimizerType::advance, python::arg("self"))
+                .def("getEvaluationPoint", &MinimizerType::getEvaluationPoint, python::arg("self"),
+                     python::return_internal_reference<>())
+                .def("setFunctionValue", &MinimizerType::setFunctionValue, (python::arg("self"), python::arg("f")))
+                .def("setFunctionGradient", &MinimizerType::setFunctionGradient, 
+                     (python::arg("self"), python::arg("f"), python::arg("g")))
+                .def("getPosition", &MinimizerType::getPosition, python::arg("self"),
+                     python::return_internal_reference<>())
+                .def("getGradient", &MinimizerType::getGradient, python::arg("self"),
+                     python::return_internal_reference<>())
                 .add_property("gradientNorm", &MinimizerType::getGradientNorm)
                 .add_property("functionDelta", &MinimizerType::getFunctionDelta)
                 .add_property("functionValue", &MinimizerType::getFunctionValue)
                 .add_property("numIterations", &MinimizerType::getNumIterations)
-                .add_property("status", &MinimizerType::getStatus);
+                .add_property("status", &MinimizerType::getStatus)
+                .add_property("evaluationPoint", python::make_function(&MinimizerType::getEvaluationPoint,
+                                                                       python::return_internal_reference<>()))
+                .add_property("position", python::make_function(&MinimizerType::getPosition,
+                                                                python::return_internal_reference<>()))
+                .add_property("gradient", python::make_function(&MinimizerType::getGradient,
+                                                                python::return_internal_reference<>()));
         }
 
         static typename MinimizerType::Status minimize(MinimizerType& minimizer, ArrayType& x, ArrayType& g, 
@@ -28,6 +28,7 @@
 #include "CDPL/Pharm/CDFGZPharmacophoreReader.hpp"
 #include "CDPL/Pharm/CDFBZ2PharmacophoreReader.hpp"
 #include "CDPL/Util/FileDataReader.hpp"
+#include "CDPL/Util/MappedFileIStream.hpp"
 
 #include "ClassExports.hpp"
 
@@ -42,7 +43,7 @@ void CDPLPythonPharm::exportCDFPharmacophoreReader()
         .def(python::init<std::istream&>((python::arg("self"), python::arg("is")))
              [python::with_custodian_and_ward<1, 2>()]);
 
-    python::class_<Util::FileDataReader<Pharm::CDFPharmacophoreReader>, python::bases<Base::DataReader<Pharm::Pharmacophore> >, 
+    python::class_<Util::FileDataReader<Pharm::CDFPharmacophoreReader, Pharm::Pharmacophore, Util::MappedFileIStream>, python::bases<Base::DataReader<Pharm::Pharmacophore> >, 
         boost::noncopyable>("FileCDFPharmacophoreReader", python::no_init)
         .def(python::init<const std::string&, std::ios_base::openmode>(
                  (python::arg("self"), python::arg("file_name"), python::arg("mode") = std::ios_base::in | std::ios_base::binary)));
@@ -75,6 +75,8 @@ namespace CDPLPythonPharm
     void exportPSDMolecularGraphWriter();
     void exportPSDScreeningDBCreator();
     void exportPSDScreeningDBAccessor();
+    void exportMappedPSDScreeningDBAccessor();
+    void exportMappedPSDScreeningDBWriter();
 
     void exportFeatureGenerator();
     void exportPharmacophoreGenerator();
@@ -0,0 +1,60 @@
+/* 
+ * MappedPSDScreeningDBWriterExport.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <boost/python.hpp>
+
+#include "CDPL/Pharm/MappedPSDScreeningDBWriter.hpp"
+#include "CDPL/Pharm/ScreeningDBAccessor.hpp"
+
+#include "Base/ObjectIdentityCheckVisitor.hpp"
+
+#include "ClassExports.hpp"
+
+
+void CDPLPythonPharm::exportMappedPSDScreeningDBWriter()
+{
+    using namespace boost;
+    using namespace CDPL;
+
+    python::class_<Pharm::MappedPSDScreeningDBWriter, Pharm::MappedPSDScreeningDBWriter::SharedPointer,
+                   boost::noncopyable>("MappedPSDScreeningDBWriter", python::no_init)
+        .def(python::init<>(python::arg("self")))
+        .def(python::init<const std::string&>((python::arg("self"), python::arg("name"))))
+        .def(CDPLPythonBase::ObjectIdentityCheckVisitor<Pharm::MappedPSDScreeningDBWriter>())
+        .def("open", &Pharm::MappedPSDScreeningDBWriter::open, (python::arg("self"), python::arg("name")))
+        .def("append", &Pharm::MappedPSDScreeningDBWriter::append, 
+             (python::arg("self"), python::arg("db_acc"), 
+              python::arg("func") = Pharm::MappedPSDScreeningDBWriter::ProgressCallbackFunction()))
+        .def("close", &Pharm::MappedPSDScreeningDBWriter::close, python::arg("self"))
+        .def("discard", &Pharm::MappedPSDScreeningDBWriter::discard, python::arg("self"))
+        .def("isOpen", &Pharm::MappedPSDScreeningDBWriter::isOpen, python::arg("self"))
+        .def("getDatabaseName", &Pharm::MappedPSDScreeningDBWriter::getDatabaseName, python::arg("self"), 
+             python::return_value_policy<python::copy_const_reference>())
+        .def("getNumMolecules", &Pharm::MappedPSDScreeningDBWriter::getNumMolecules, python::arg("self"))
+        .def("getNumPharmacophores", &Pharm::MappedPSDScreeningDBWriter::getNumPharmacophores, python::arg("self"))
+        .add_property("databaseName", python::make_function(&Pharm::MappedPSDScreeningDBWriter::getDatabaseName,
+                                                            python::return_value_policy<python::copy_const_reference>()))
+        .add_property("numMolecules", &Pharm::MappedPSDScreeningDBWriter::getNumMolecules)
+        .add_property("numPharmacophores", &Pharm::MappedPSDScreeningDBWriter::getNumPharmacophores);
+}
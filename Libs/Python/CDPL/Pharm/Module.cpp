@@ -79,6 +79,8 @@ BOOST_PYTHON_MODULE(_pharm)
     exportPSDMolecularGraphWriter();
     exportPSDScreeningDBCreator();
     exportPSDScreeningDBAccessor();
+    exportMappedPSDScreeningDBAccessor();
+    exportMappedPSDScreeningDBWriter();
 
     exportFeatureGenerator();
     exportPharmacophoreGenerator();
@@ -40,5 +40,18 @@ void CDPLPythonPharm::exportPSDScreeningDBCreator()
         .def(python::init<>(python::arg("self")))
         .def(python::init<const std::string&, Pharm::ScreeningDBCreator::Mode, bool>
              ((python::arg("self"), python::arg("name"), python::arg("mode") = Pharm::ScreeningDBCreator::CREATE, 
-               python::arg("allow_dup_entries") = true)));
+               python::arg("allow_dup_entries") = true)))
+        .def("createTwoPointPharmacophoreIndex", &Pharm::PSDScreeningDBCreator::createTwoPointPharmacophoreIndex,
+             (python::arg("self"), python::arg("create")))
+        .def("twoPointPharmacophoreIndexCreated", &Pharm::PSDScreeningDBCreator::twoPointPharmacophoreIndexCreated,
+             python::arg("self"))
+        .def("enableMultiThreading", &Pharm::PSDScreeningDBCreator::enableMultiThreading,
+             (python::arg("self"), python::arg("enable")))
+        .def("multiThreadingEnabled", &Pharm::PSDScreeningDBCreator::multiThreadingEnabled,
+             python::arg("self"))
+        .def("flush", &Pharm::PSDScreeningDBCreator::flush, python::arg("self"))
+        .add_property("create2PointPharmIndex", &Pharm::PSDScreeningDBCreator::twoPointPharmacophoreIndexCreated,
+                      &Pharm::PSDScreeningDBCreator::createTwoPointPharmacophoreIndex)
+        .add_property("multiThreading", &Pharm::PSDScreeningDBCreator::multiThreadingEnabled,
+                      &Pharm::PSDScreeningDBCreator::enableMultiThreading);
 }
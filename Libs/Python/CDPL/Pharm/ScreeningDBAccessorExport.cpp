@@ -28,6 +28,7 @@
 #include "CDPL/Pharm/Pharmacophore.hpp"
 #include "CDPL/Pharm/FeatureTypeHistogram.hpp"
 #include "CDPL/Chem/Molecule.hpp"
+#include "CDPL/Util/BitSet.hpp"
 
 #include "Base/ObjectIdentityCheckVisitor.hpp"
 
@@ -97,6 +98,43 @@ namespace
         const CDPL::Pharm::FeatureTypeHistogram& getFeatureCounts(std::size_t mol_idx, std::size_t mol_conf_idx) const {
             return this->get_override("getFeatureCounts")(mol_idx, mol_conf_idx);
         }
+
+        bool hasTwoPointPharmacophoreIndex() const {
+            if (boost::python::override f = this->get_override("hasTwoPointPharmacophoreIndex"))
+                return f();
+
+            return CDPL::Pharm::ScreeningDBAccessor::hasTwoPointPharmacophoreIndex();
+        }
+
+        bool hasTwoPointPharmacophoreIndexDef() const {
+            return CDPL::Pharm::ScreeningDBAccessor::hasTwoPointPharmacophoreIndex();
+        }
+
+        void getTwoPointPharmacophoreMatches(unsigned int ftr1_type, unsigned int ftr2_type, double min_dist, double max_dist,
+                                             CDPL::Util::BitSet& pharm_set) const {
+            if (boost::python::override f = this->get_override("getTwoPointPharmacophoreMatches")) {
+                f(ftr1_type, ftr2_type, min_dist, max_dist, boost::ref(pharm_set));
+                return;
+            }
+
+            CDPL::Pharm::ScreeningDBAccessor::getTwoPointPharmacophoreMatches(ftr1_type, ftr2_type, min_dist, max_dist, pharm_set);
+        }
+
+        void getTwoPointPharmacophoreMatchesDef(unsigned int ftr1_type, unsigned int ftr2_type, double min_dist, double max_dist,
+                                                CDPL::Util::BitSet& pharm_set) const {
+            CDPL::Pharm::ScreeningDBAccessor::getTwoPointPharmacophoreMatches(ftr1_type, ftr2_type, min_dist, max_dist, pharm_set);
+        }
+
+        CDPL::Pharm::ScreeningDBAccessor::SharedPointer clone() const {
+            if (boost::python::override f = this->get_override("clone"))
+                return f();
+
+            return CDPL::Pharm::ScreeningDBAccessor::clone();
+        }
+
+        CDPL::Pharm::ScreeningDBAccessor::SharedPointer cloneDef() const {
+            return CDPL::Pharm::ScreeningDBAccessor::clone();
+        }
     };
 }
 
@@ -146,6 +184,13 @@ void CDPLPythonPharm::exportScreeningDBAccessor()
         .def("getFeatureCounts", python::pure_virtual(
                  static_cast<const Pharm::FeatureTypeHistogram& (Pharm::ScreeningDBAccessor::*)(std::size_t, std::size_t) const>(&Pharm::ScreeningDBAccessor::getFeatureCounts)),
              (python::arg("self"), python::arg("mol_idx"), python::arg("mol_conf_idx")), python::return_internal_reference<>())
+        .def("hasTwoPointPharmacophoreIndex", &Pharm::ScreeningDBAccessor::hasTwoPointPharmacophoreIndex,
+             &ScreeningDBAccessorWrapper::hasTwoPointPharmacophoreIndexDef, python::arg("self"))
+        .def("getTwoPointPharmacophoreMatches", &Pharm::ScreeningDBAccessor::getTwoPointPharmacophoreMatches,
+             &ScreeningDBAccessorWrapper::getTwoPointPharmacophoreMatchesDef,
+             (python::arg("self"), python::arg("ftr1_type"), python::arg("ftr2_type"), python::arg("min_dist"),
+              python::arg("max_dist"), python::arg("pharm_set")))
+        .def("clone", &Pharm::ScreeningDBAccessor::clone, &ScreeningDBAccessorWrapper::cloneDef, python::arg("self"))
         .add_property("databaseName", python::make_function(&Pharm::ScreeningDBAccessor::getDatabaseName,                                            
                                                             python::return_value_policy<python::copy_const_reference>()))
         .add_property("numMolecules", &Pharm::ScreeningDBAccessor::getNumMolecules)
@@ -22,11 +22,14 @@
  */
 
 
+#include <memory>
+
 #include <boost/python.hpp>
 
 #include "CDPL/Pharm/ScreeningProcessor.hpp"
 #include "CDPL/Pharm/ScreeningDBAccessor.hpp"
 #include "CDPL/Pharm/FeatureContainer.hpp"
+#include "CDPL/Pharm/PharmacophoreFitScreeningScore.hpp"
 #include "CDPL/Chem/Molecule.hpp"
 
 #include "Base/ObjectIdentityCheckVisitor.hpp"
@@ -35,6 +38,147 @@
 #include "ClassExports.hpp"
 
 
+namespace
+{
+
+    struct PythonErrorState
+    {
+
+        PythonErrorState():
+            type(0), value(0), traceback(0) {}
+
+        PyObject* type;
+        PyObject* value;
+        PyObject* traceback;
+    };
+
+    // Wraps a function that might call into Python so that it can be invoked from the
+    // worker threads of a multithreaded search while the GIL is released
+
+    template <typename ResType, typename... ArgTypes>
+    std::function<ResType(ArgTypes...)> makeGILSafe(const std::function<ResType(ArgTypes...)>& func, PythonErrorState& err_state)
+    {
+        typedef std::function<ResType(ArgTypes...)> FunctionType;
+
+        if (!func)
+            return func;
+
+        std::shared_ptr<FunctionType> func_ptr(new FunctionType(func));
+        PythonErrorState* err_state_ptr = &err_state;
+
+        return [func_ptr, err_state_ptr](ArgTypes... args) -> ResType {
+            PyGILState_STATE gil_state = PyGILState_Ensure();
+
+            try {
+                ResType res = (*func_ptr)(args...);
+
+                PyGILState_Release(gil_state);
+                return res;
+
+            } catch (const boost::python::error_already_set&) {
+                if (!err_state_ptr->type)
+                    PyErr_Fetch(&err_state_ptr->type, &err_state_ptr->value, &err_state_ptr->traceback);
+                else
+                    PyErr_Clear();
+
+                PyGILState_Release(gil_state);
+                throw;
+
+            } catch (...) {
+                PyGILState_Release(gil_state);
+                throw;
+            }
+        };
+    }
+
+    class MultiThreadedSearchGuard
+    {
+
+      public:
+        MultiThreadedSearchGuard(CDPL::Pharm::ScreeningProcessor& proc, PythonErrorState& err_state):
+            processor(proc), hitCallback(proc.getHitCallback()), progressCallback(proc.getProgressCallback()),
+            scoringFunction(proc.getScoringFunction())
+        {
+            proc.setHitCallback(makeGILSafe(hitCallback, err_state));
+            proc.setProgressCallback(makeGILSafe(progressCallback, err_state));
+
+            // native scoring functions do not need the GIL and must not get serialized
+
+            if (!scoringFunction.target<CDPL::Pharm::PharmacophoreFitScreeningScore>())
+                proc.setScoringFunction(makeGILSafe(scoringFunction, err_state));
+
+            threadState = PyEval_SaveThread();
+        }
+
+        ~MultiThreadedSearchGuard()
+        {
+            PyEval_RestoreThread(threadState);
+
+            processor.setHitCallback(hitCallback);
+            processor.setProgressCallback(progressCallback);
+            processor.setScoringFunction(scoringFunction);
+        }
+
+      private:
+        CDPL::Pharm::ScreeningProcessor&                           processor;
+        CDPL::Pharm::ScreeningProcessor::HitCallbackFunction      hitCallback;
+        CDPL::Pharm::ScreeningProcessor::ProgressCallbackFunction progressCallback;
+        CDPL::Pharm::ScreeningProcessor::ScoringFunction          scoringFunction;
+        PyThreadState*                                             threadState;
+    };
+
+    class SingleThreadedSearchGuard
+    {
+
+      public:
+        SingleThreadedSearchGuard(CDPL::Pharm::ScreeningProcessor& proc):
+            processor(proc), numThreads(proc.getNumThreads())
+        {
+            proc.setNumThreads(1);
+        }
+
+        ~SingleThreadedSearchGuard()
+        {
+            processor.setNumThreads(numThreads);
+        }
+
+      private:
+        CDPL::Pharm::ScreeningProcessor& processor;
+        std::size_t                      numThreads;
+    };
+
+    std::size_t searchDB(CDPL::Pharm::ScreeningProcessor& proc, const CDPL::Pharm::FeatureContainer& query,
+                         std::size_t mol_start_idx, std::size_t mol_end_idx)
+    {
+        if (proc.getNumThreads() <= 1)
+            return proc.searchDB(query, mol_start_idx, mol_end_idx);
+
+        // accessors implemented in Python (i.e. instances of the exported ScreeningDBAccessor wrapper class) would
+        // get cloned and called without holding the GIL
+
+        if (dynamic_cast<const boost::python::wrapper<CDPL::Pharm::ScreeningDBAccessor>*>(&proc.getDBAccessor())) {
+            SingleThreadedSearchGuard guard(proc);
+
+            return proc.searchDB(query, mol_start_idx, mol_end_idx);
+        }
+
+        PythonErrorState err_state;
+
+        try {
+            MultiThreadedSearchGuard guard(proc, err_state);
+
+            return proc.searchDB(query, mol_start_idx, mol_end_idx);
+
+        } catch (const boost::python::error_already_set&) {
+            if (err_state.type)
+                PyErr_Restore(err_state.type, err_state.value, err_state.traceback);
+
+            throw;
+        }
+    }
+} // namespace
+
+
 void CDPLPythonPharm::exportScreeningProcessor()
 {
     using namespace boost;
@@ -58,6 +202,12 @@ void CDPLPythonPharm::exportScreeningProcessor()
                   python::arg("xform"), python::arg("pharm_idx"), python::arg("mol_idx"), python::arg("conf_idx")))
              [python::with_custodian_and_ward<1, 2, python::with_custodian_and_ward<1, 3, python::with_custodian_and_ward<1, 4, 
               python::with_custodian_and_ward<1, 5, python::with_custodian_and_ward<1, 5> > > > >()])
+        .def(python::init<const Pharm::ScreeningProcessor&, const Pharm::ScreeningDBAccessor&, const Pharm::FeatureContainer&, const Pharm::FeatureContainer&,
+             const Chem::Molecule&, const Math::Matrix4D&, std::size_t, std::size_t, std::size_t>(
+                 (python::arg("self"), python::arg("hit_prov"), python::arg("db_acc"), python::arg("qry_pharm"), python::arg("hit_pharm"),
+                  python::arg("mol"), python::arg("xform"), python::arg("pharm_idx"), python::arg("mol_idx"), python::arg("conf_idx")))
+             [python::with_custodian_and_ward<1, 2, python::with_custodian_and_ward<1, 3, python::with_custodian_and_ward<1, 4, 
+              python::with_custodian_and_ward<1, 5, python::with_custodian_and_ward<1, 6, python::with_custodian_and_ward<1, 7> > > > > >()])
         .def(python::init<const Pharm::ScreeningProcessor::SearchHit&>((python::arg("self"), python::arg("hit")))
              [python::with_custodian_and_ward<1, 2>()])
         .def(CDPLPythonBase::ObjectIdentityCheckVisitor<Pharm::ScreeningProcessor::SearchHit>())    
@@ -66,6 +216,8 @@ void CDPLPythonPharm::exportScreeningProcessor()
              python::return_self<python::with_custodian_and_ward<1, 2> >())
         .def("getHitProvider", &Pharm::ScreeningProcessor::SearchHit::getHitProvider, python::arg("self"),
              python::return_internal_reference<>())
+        .def("getDBAccessor", &Pharm::ScreeningProcessor::SearchHit::getDBAccessor, python::arg("self"),
+             python::return_internal_reference<>())
         .def("getQueryPharmacophore", &Pharm::ScreeningProcessor::SearchHit::getQueryPharmacophore, python::arg("self"),
              python::return_internal_reference<>())
         .def("getHitPharmacophore", &Pharm::ScreeningProcessor::SearchHit::getHitPharmacophore, python::arg("self"),
@@ -80,6 +232,9 @@ void CDPLPythonPharm::exportScreeningProcessor()
         .add_property("hitProvider", 
                       python::make_function(&Pharm::ScreeningProcessor::SearchHit::getHitProvider,
                                             python::return_internal_reference<>()))
+        .add_property("dbAccessor", 
+                      python::make_function(&Pharm::ScreeningProcessor::SearchHit::getDBAccessor,
+                                            python::return_internal_reference<>()))
         .add_property("queryPharmacophore", 
                       python::make_function(&Pharm::ScreeningProcessor::SearchHit::getQueryPharmacophore,
                                             python::return_internal_reference<>()))
@@ -130,7 +285,10 @@ void CDPLPythonPharm::exportScreeningProcessor()
              (python::arg("self"), python::arg("func")))
         .def("getScoringFunction", &Pharm::ScreeningProcessor::getScoringFunction, 
              python::arg("self"), python::return_internal_reference<>())
-        .def("searchDB", &Pharm::ScreeningProcessor::searchDB, 
+        .def("setNumThreads", &Pharm::ScreeningProcessor::setNumThreads, 
+             (python::arg("self"), python::arg("num_threads")))
+        .def("getNumThreads", &Pharm::ScreeningProcessor::getNumThreads, python::arg("self"))
+        .def("searchDB", &searchDB, 
              (python::arg("self"), python::arg("query"), python::arg("mol_start_idx") = 0, python::arg("mol_end_idx") = 0))
         .add_property("dbAcccessor", python::make_function(&Pharm::ScreeningProcessor::getDBAccessor,
                                                            python::return_internal_reference<>()),
@@ -152,5 +310,7 @@ void CDPLPythonPharm::exportScreeningProcessor()
         .add_property("checkXVolumes", &Pharm::ScreeningProcessor::xVolumeClashesChecked,
                       &Pharm::ScreeningProcessor::checkXVolumeClashes)
         .add_property("bestAlignments", &Pharm::ScreeningProcessor::bestAlignmentsSeeked,
-                      &Pharm::ScreeningProcessor::seekBestAlignments);
+                      &Pharm::ScreeningProcessor::seekBestAlignments)
+        .add_property("numThreads", &Pharm::ScreeningProcessor::getNumThreads,
+                      &Pharm::ScreeningProcessor::setNumThreads);
 }
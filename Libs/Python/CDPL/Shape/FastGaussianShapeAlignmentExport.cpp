@@ -80,6 +80,14 @@ void CDPLPythonShape::exportFastGaussianShapeAlignment()
              (python::arg("self"), python::arg("greedy")))
         .def("greedyOptimization", GetBoolFunc(&Shape::FastGaussianShapeAlignment::greedyOptimization),
              python::arg("self"))
+        .def("pruneAlignments", SetBoolFunc(&Shape::FastGaussianShapeAlignment::pruneAlignments),
+             (python::arg("self"), python::arg("prune")))
+        .def("pruneAlignments", GetBoolFunc(&Shape::FastGaussianShapeAlignment::pruneAlignments),
+             python::arg("self"))
+        .def("setPruningScoreCutoff", &Shape::FastGaussianShapeAlignment::setPruningScoreCutoff,
+             (python::arg("self"), python::arg("cutoff")))
+        .def("getPruningScoreCutoff", &Shape::FastGaussianShapeAlignment::getPruningScoreCutoff,
+             python::arg("self"))
         .def("setSymmetryThreshold", &Shape::FastGaussianShapeAlignment::setSymmetryThreshold,
              (python::arg("self"), python::arg("thresh")))
         .def("getSymmetryThreshold", &Shape::FastGaussianShapeAlignment::getSymmetryThreshold, python::arg("self"))
@@ -131,6 +139,8 @@ void CDPLPythonShape::exportFastGaussianShapeAlignment()
              (python::arg("self"), python::arg("shape")))
         .def("align", static_cast<bool (Shape::FastGaussianShapeAlignment::*)(const Shape::GaussianShapeSet&)>(&Shape::FastGaussianShapeAlignment::align), 
              (python::arg("self"), python::arg("shapes")))
+        .def("getNumPerformedAlignments", &Shape::FastGaussianShapeAlignment::getNumPerformedAlignments, python::arg("self"))
+        .def("getNumPrunedAlignments", &Shape::FastGaussianShapeAlignment::getNumPrunedAlignments, python::arg("self"))
         .def("getNumResults", &Shape::FastGaussianShapeAlignment::getNumResults, python::arg("self"))
         .def("__len__", &Shape::FastGaussianShapeAlignment::getNumResults, python::arg("self"))
         .def("getResult", static_cast<Shape::AlignmentResult& (Shape::FastGaussianShapeAlignment::*)(std::size_t)>(&Shape::FastGaussianShapeAlignment::getResult),
@@ -162,6 +172,12 @@ void CDPLPythonShape::exportFastGaussianShapeAlignment()
                       SetBoolFunc(&Shape::FastGaussianShapeAlignment::optimizeOverlap))
         .add_property("greedyOpt", GetBoolFunc(&Shape::FastGaussianShapeAlignment::greedyOptimization),
                       SetBoolFunc(&Shape::FastGaussianShapeAlignment::greedyOptimization))
+        .add_property("pruneAligns", GetBoolFunc(&Shape::FastGaussianShapeAlignment::pruneAlignments),
+                      SetBoolFunc(&Shape::FastGaussianShapeAlignment::pruneAlignments))
+        .add_property("pruningScoreCutoff", &Shape::FastGaussianShapeAlignment::getPruningScoreCutoff,
+                      &Shape::FastGaussianShapeAlignment::setPruningScoreCutoff)
+        .add_property("numPerformedAlignments", &Shape::FastGaussianShapeAlignment::getNumPerformedAlignments)
+        .add_property("numPrunedAlignments", &Shape::FastGaussianShapeAlignment::getNumPrunedAlignments)
         .add_property("numReferenceShapes", &Shape::FastGaussianShapeAlignment::getNumReferenceShapes)    
         .add_property("symmetryThreshold", &Shape::FastGaussianShapeAlignment::getSymmetryThreshold,
                       &Shape::FastGaussianShapeAlignment::setSymmetryThreshold)
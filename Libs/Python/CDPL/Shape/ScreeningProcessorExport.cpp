@@ -60,6 +60,10 @@ void CDPLPythonShape::exportScreeningProcessor()
              (python::arg("self"), python::arg("idx")), python::return_internal_reference<>())
         .def("process", static_cast<bool (Shape::ScreeningProcessor::*)(const Chem::MolecularGraph&)>(&Shape::ScreeningProcessor::process), 
              (python::arg("self"), python::arg("molgraph")))
+        .def("getNumPerformedAlignments", &Shape::ScreeningProcessor::getNumPerformedAlignments,
+             python::arg("self"))
+        .def("getNumPrunedAlignments", &Shape::ScreeningProcessor::getNumPrunedAlignments,
+             python::arg("self"))
         .add_property("hitCallback", python::make_function(&Shape::ScreeningProcessor::getHitCallback,
                                                            python::return_internal_reference<>()),
                       &Shape::ScreeningProcessor::setHitCallback)
@@ -67,5 +71,7 @@ void CDPLPythonShape::exportScreeningProcessor()
                       python::make_function(static_cast<Shape::ScreeningSettings& (Shape::ScreeningProcessor::*)()>
                                             (&Shape::ScreeningProcessor::getSettings),
                                             python::return_internal_reference<>()))
-        .add_property("querySetSize", &Shape::ScreeningProcessor::getQuerySetSize);
+        .add_property("querySetSize", &Shape::ScreeningProcessor::getQuerySetSize)
+        .add_property("numPerformedAlignments", &Shape::ScreeningProcessor::getNumPerformedAlignments)
+        .add_property("numPrunedAlignments", &Shape::ScreeningProcessor::getNumPrunedAlignments);
 }
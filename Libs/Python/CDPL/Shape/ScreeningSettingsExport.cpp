@@ -94,6 +94,10 @@ void CDPLPythonShape::exportScreeningSettings()
              (python::arg("self"), python::arg("greedy")))
         .def("greedyOptimization", GetBoolFunc(&Shape::ScreeningSettings::greedyOptimization),
              python::arg("self"))
+        .def("pruneAlignments", SetBoolFunc(&Shape::ScreeningSettings::pruneAlignments),
+             (python::arg("self"), python::arg("prune")))
+        .def("pruneAlignments", GetBoolFunc(&Shape::ScreeningSettings::pruneAlignments),
+             python::arg("self"))
         .def_readonly("DEFAULT", Shape::ScreeningSettings::DEFAULT)
         .def_readonly("NO_CUTOFF", Shape::ScreeningSettings::NO_CUTOFF)
         .add_property("scoringFunction", python::make_function(&Shape::ScreeningSettings::getScoringFunction,
@@ -120,7 +124,9 @@ void CDPLPythonShape::exportScreeningSettings()
         .add_property("optOverlap", GetBoolFunc(&Shape::ScreeningSettings::optimizeOverlap),
                       SetBoolFunc(&Shape::ScreeningSettings::optimizeOverlap))
         .add_property("greedyOpt", GetBoolFunc(&Shape::ScreeningSettings::greedyOptimization),
-                      SetBoolFunc(&Shape::ScreeningSettings::greedyOptimization));
+                      SetBoolFunc(&Shape::ScreeningSettings::greedyOptimization))
+        .add_property("pruneAligns", GetBoolFunc(&Shape::ScreeningSettings::pruneAlignments),
+                      SetBoolFunc(&Shape::ScreeningSettings::pruneAlignments));
 
     python::enum_<Shape::ScreeningSettings::ScreeningMode>("ScreeningMode")
         .value("BEST_OVERALL_MATCH", Shape::ScreeningSettings::BEST_OVERALL_MATCH)
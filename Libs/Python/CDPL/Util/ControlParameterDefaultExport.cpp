@@ -0,0 +1,48 @@
+/* 
+ * ControlParameterDefaultExport.cpp 
+ *
+ * This file is part of the Chemical Data Processing Toolkit
+ *
+ * Copyright (C) 2003 Thomas Seidel <thomas.seidel@univie.ac.at>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this library; see the file COPYING. If not, write to
+ * the Free Software Foundation, Inc., 59 Temple Place - Suite 330,
+ * Boston, MA 02111-1307, USA.
+ */
+
+
+#include <boost/python.hpp>
+
+#include "CDPL/Util/ControlParameterDefault.hpp"
+
+#include "NamespaceExports.hpp"
+
+
+namespace 
+{
+
+    struct ControlParameterDefault {};
+}
+
+
+void CDPLPythonUtil::exportControlParameterDefaults()
+{
+    using namespace boost;
+    using namespace CDPL;
+
+    python::class_<ControlParameterDefault, boost::noncopyable>("ControlParameterDefault", python::no_init)
+        .def_readonly("USE_RECORD_INDEX_FILES", &Util::ControlParameterDefault::USE_RECORD_INDEX_FILES)
+        .def_readonly("NUM_READER_THREADS", &Util::ControlParameterDefault::NUM_READER_THREADS)
+        ;
+}
@@ -37,4 +37,6 @@ void CDPLPythonUtil::exportFileFunctions()
     python::def("genCheckedTempFilePath", &Util::genCheckedTempFilePath, (python::arg("dir") = "", python::arg("ptn") = "%%%%-%%%%-%%%%-%%%%"));
     python::def("checkIfSameFile", &Util::checkIfSameFile, (python::arg("path1"), python::arg("path2")));
     python::def("fileExists", &Util::fileExists, python::arg("path"));
+    python::def("calcFileStamp", &Util::calcFileStamp, python::arg("path"));
+    python::def("renameFile", &Util::renameFile, (python::arg("old_path"), python::arg("new_path")));
 }
@@ -31,6 +31,7 @@ namespace CDPLPythonUtil
 
     void exportFileFunctions();
     void exportSequenceFunctions();
+    void exportControlParameterFunctions();
 } // namespace CDPLPythonUtil
 
 #endif // CDPL_PYTHON_UTIL_FUNCTIONEXPORTS_HPP
@@ -24,6 +24,7 @@
 
 #include "Module.hpp"
 #include "ClassExports.hpp"
+#include "NamespaceExports.hpp"
 #include "FunctionExports.hpp"
 #include "ConverterRegistration.hpp"
 
@@ -40,8 +41,12 @@ BOOST_PYTHON_MODULE(_util)
     exportDGCoordinatesGenerator();
     exportCompressionStreams();
 
+    exportControlParameters();
+    exportControlParameterDefaults();
+
     exportFileFunctions();
     exportSequenceFunctions();
+    exportControlParameterFunctions();
     
     registerToPythonConverters();
     registerFromPythonConverters();